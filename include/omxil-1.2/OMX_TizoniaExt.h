@@ -82,6 +82,10 @@
 #define OMX_TizoniaIndexParamAudioIheartPlaylist     OMX_IndexVendorStartUnused + 26 /**< reference: OMX_TIZONIA_AUDIO_PARAM_IHEARTPLAYLISTTYPE */
 #define OMX_TizoniaIndexConfigPlaylistPosition       OMX_IndexVendorStartUnused + 27 /**< reference: OMX_TIZONIA_PLAYLISTPOSITIONTYPE */
 #define OMX_TizoniaIndexConfigPlaylistPrintAction    OMX_IndexVendorStartUnused + 28 /**< reference: OMX_TIZONIA_PLAYLISTPRINTACTIONTYPE */
+#define OMX_TizoniaIndexConfigEmptyTheseBuffers      OMX_IndexVendorStartUnused + 29 /**< reference: OMX_TIZONIA_BUFFERBATCHTYPE */
+#define OMX_TizoniaIndexConfigFillTheseBuffers       OMX_IndexVendorStartUnused + 30 /**< reference: OMX_TIZONIA_BUFFERBATCHTYPE */
+#define OMX_TizoniaIndexConfigPerfStats              OMX_IndexVendorStartUnused + 31 /**< reference: OMX_TIZONIA_PERFSTATSTYPE */
+#define OMX_TizoniaIndexConfigMemStats               OMX_IndexVendorStartUnused + 32 /**< reference: OMX_TIZONIA_MEMSTATSTYPE */
 
 /**
  * OMX_AUDIO_CODINGTYPE extensions
@@ -114,6 +118,142 @@ typedef struct OMX_TIZONIA_PARAM_BUFFER_PREANNOUNCEMENTSMODETYPE
   OMX_BOOL bEnabled;
 } OMX_TIZONIA_PARAM_BUFFER_PREANNOUNCEMENTSMODETYPE;
 
+/**
+ * The names of the batched buffer submission extensions.
+ */
+#define OMX_TIZONIA_INDEX_CONFIG_EMPTYTHESEBUFFERS     \
+  "OMX.Tizonia.index.config.emptythesebuffers"
+#define OMX_TIZONIA_INDEX_CONFIG_FILLTHESEBUFFERS      \
+  "OMX.Tizonia.index.config.fillthesebuffers"
+
+/**
+ * Extension to submit several buffers to a component in one call, e.g.:
+ *
+ *   OMX_SetConfig (hdl, OMX_TizoniaIndexConfigEmptyTheseBuffers, &batch);
+ *
+ * This has the same effect as calling OMX_EmptyThisBuffer (resp.
+ * OMX_FillThisBuffer) on each header of the array, in order, but the whole
+ * array is delivered to the component in a single request. The headers may
+ * belong to different ports. Like OMX_EmptyThisBuffer, the call does not
+ * block; the array itself (but not the headers) may be reused as soon as
+ * the call returns. Each header is returned through the usual
+ * EmptyBufferDone (resp. FillBufferDone) callback.
+ */
+typedef struct OMX_TIZONIA_BUFFERBATCHTYPE {
+    OMX_U32 nSize;
+    OMX_VERSIONTYPE nVersion;
+    OMX_U32 nBufferCount;                  /**< Number of headers in ppHeaders */
+    OMX_BUFFERHEADERTYPE ** ppHeaders;     /**< Headers to be submitted */
+} OMX_TIZONIA_BUFFERBATCHTYPE;
+
+/**
+ * The name of the performance counters extension.
+ */
+#define OMX_TIZONIA_INDEX_CONFIG_PERFSTATS             \
+  "OMX.Tizonia.index.config.perfstats"
+
+/**
+ * Groups of component messages, as reported in OMX_TIZONIA_PERFSTATSTYPE.
+ */
+typedef enum OMX_TIZONIA_PERFSTATSMSGCLASSTYPE {
+    OMX_TIZONIA_PerfStatsMsgCommand = 0,   /**< OMX_SendCommand */
+    OMX_TIZONIA_PerfStatsMsgParamConfig,   /**< Get/Set Parameter and Config,
+                                                GetExtensionIndex, GetState,
+                                                etc */
+    OMX_TIZONIA_PerfStatsMsgBuffer,        /**< OMX_EmptyThisBuffer,
+                                                OMX_FillThisBuffer, buffer
+                                                batches and tunneled buffer
+                                                returns */
+    OMX_TIZONIA_PerfStatsMsgBufferMgmt,    /**< Use/Allocate/FreeBuffer and
+                                                UseEGLImage */
+    OMX_TIZONIA_PerfStatsMsgEvent,         /**< i/o, timer, stat and
+                                                pluggable events */
+    OMX_TIZONIA_PerfStatsMsgOther,         /**< Initialisation, tunnel
+                                                requests, registrations,
+                                                etc */
+    OMX_TIZONIA_PerfStatsMsgMax
+} OMX_TIZONIA_PERFSTATSMSGCLASSTYPE;
+
+/**
+ * Extension to retrieve a component's performance counters, e.g.:
+ *
+ *   OMX_GetConfig (hdl, OMX_TizoniaIndexConfigPerfStats, &stats);
+ *
+ * The counters are always on and accumulate from the moment the component
+ * is created. The buffer counters refer to the port given in nPortIndex, or
+ * to the sum of all the ports when nPortIndex is OMX_ALL; the rest are
+ * component-wide. Setting this config (the contents of the structure are
+ * ignored, except for nPortIndex) resets all the counters to zero.
+ */
+typedef struct OMX_TIZONIA_PERFSTATSTYPE {
+    OMX_U32 nSize;
+    OMX_VERSIONTYPE nVersion;
+    OMX_U32 nPortIndex;                    /**< A port index, or OMX_ALL */
+    OMX_U64 nMessages[OMX_TIZONIA_PerfStatsMsgMax]; /**< Messages dispatched
+                                                         by the component's
+                                                         scheduler, by
+                                                         group */
+    OMX_U32 nMailboxHighWater;             /**< Max number of messages seen
+                                                waiting in the scheduler's
+                                                queue */
+    OMX_U64 nTicks;                        /**< Turns given to the
+                                                component's servants */
+    OMX_U64 nBuffersClaimed;               /**< Buffers claimed by the
+                                                processor */
+    OMX_U64 nBuffersReleased;              /**< Buffers released by the
+                                                processor */
+    OMX_U64 nBytes;                        /**< Bytes in the buffers
+                                                claimed on input ports and
+                                                released on output ports */
+    OMX_U64 nTransferAndProcessCalls;      /**< Kernel
+                                                transfer_and_process calls */
+    OMX_U64 nTransferAndProcessNs;         /**< Time spent in them, in
+                                                nanoseconds */
+    OMX_U64 nBuffersReadyCalls;            /**< Processor buffers_ready
+                                                calls */
+    OMX_U64 nBuffersReadyNs;               /**< Time spent in them, in
+                                                nanoseconds */
+    OMX_U64 nMsgPoolHits;                  /**< Scheduler messages taken
+                                                from the message pool */
+    OMX_U64 nMsgPoolMisses;                /**< Scheduler messages
+                                                allocated from the heap
+                                                because the pool was
+                                                empty */
+} OMX_TIZONIA_PERFSTATSTYPE;
+
+/**
+ * The name of the memory counters extension.
+ */
+#define OMX_TIZONIA_INDEX_CONFIG_MEMSTATS              \
+  "OMX.Tizonia.index.config.memstats"
+
+/**
+ * Extension to retrieve a component's memory counters, e.g.:
+ *
+ *   OMX_GetConfig (hdl, OMX_TizoniaIndexConfigMemStats, &stats);
+ *
+ * The counters cover the heap memory allocated with the Tizonia platform
+ * allocator (tiz_mem_alloc and friends) on the component's behalf, i.e. by
+ * its scheduler thread, from the moment the component is created. Memory
+ * stays charged to the component until it is released, whoever releases it.
+ *
+ * Setting this config sets the component's limit (nBytesLimit; zero means no
+ * limit), and resets the allocation, release and failure counters, and the
+ * peak. Once the limit is reached, the component's allocations fail (and the
+ * component typically reports OMX_ErrorInsufficientResources).
+ */
+typedef struct OMX_TIZONIA_MEMSTATSTYPE {
+    OMX_U32 nSize;
+    OMX_VERSIONTYPE nVersion;
+    OMX_U64 nBytesInUse;                   /**< Bytes currently allocated */
+    OMX_U64 nBytesPeak;                    /**< Max value of nBytesInUse */
+    OMX_U64 nAllocations;                  /**< Allocations so far */
+    OMX_U64 nFrees;                        /**< Releases so far */
+    OMX_U64 nFailures;                     /**< Allocations refused because
+                                                of the limit */
+    OMX_U64 nBytesLimit;                   /**< Zero means no limit */
+} OMX_TIZONIA_MEMSTATSTYPE;
+
 /**
  * Extension to jump to another track in a playlist,
  * an absolute position relative to the beginning of
@@ -1445,6 +1445,65 @@ start_core (void)
   return OMX_ErrorNone;
 }
 
+static void
+start_tracer (void)
+{
+  const char * p_file = tiz_rcfile_get_value ("ilcore", "trace-file");
+  if (p_file && strlen (p_file) > 0)
+    {
+      const char * p_capacity
+        = tiz_rcfile_get_value ("ilcore", "trace-events-per-thread");
+      (void) tiz_tracer_start (p_capacity ? strtoul (p_capacity, NULL, 10) : 0);
+    }
+}
+
+static void
+stop_tracer (void)
+{
+  if (tiz_tracer_enabled ())
+    {
+      const char * p_file = tiz_rcfile_get_value ("ilcore", "trace-file");
+      tiz_tracer_stop ();
+      if (p_file && strlen (p_file) > 0)
+        {
+          (void) tiz_tracer_dump (p_file, NULL);
+        }
+    }
+}
+
+static void
+start_async_log (void)
+{
+  const char * p_async = tiz_rcfile_get_value ("ilcore", "log-async");
+  if (p_async && 0 == strncmp (p_async, "true", 4))
+    {
+      const char * p_records
+        = tiz_rcfile_get_value ("ilcore", "log-async-records-per-thread");
+      const char * p_overflow
+        = tiz_rcfile_get_value ("ilcore", "log-async-overflow");
+      (void) tiz_log_async_start (
+        p_records ? strtoul (p_records, NULL, 10) : 0,
+        (p_overflow && 0 == strncmp (p_overflow, "block", 5))
+          ? TIZ_LOG_OVERFLOW_BLOCK
+          : TIZ_LOG_OVERFLOW_DROP);
+    }
+}
+
+static void
+stop_async_log (void)
+{
+  if (tiz_log_async_enabled ())
+    {
+      unsigned long long written = 0;
+      unsigned long long dropped = 0;
+      tiz_log_async_stats (&written, &dropped);
+      TIZ_LOG (TIZ_PRIORITY_NOTICE,
+               "async log: [%llu] records written - [%llu] dropped", written,
+               dropped);
+      (void) tiz_log_async_stop ();
+    }
+}
+
 static tiz_core_msg_t *
 init_core_message (tiz_core_msg_class_t a_msg_class)
 {
@@ -1611,6 +1670,9 @@ OMX_Init (void)
       tiz_log_init ();
     }
 
+  start_async_log ();
+  start_tracer ();
+
   if (OMX_ErrorNone != (rc = start_core ()))
     {
       TIZ_LOG (TIZ_PRIORITY_ERROR, "[%s] : Error starting core",
@@ -1651,6 +1713,12 @@ OMX_Deinit (void)
   tiz_mem_free (pg_core);
   pg_core = NULL;
 
+  /* The components, and their buffers, are gone by now */
+  tiz_bufpool_trim ();
+
+  stop_tracer ();
+  stop_async_log ();
+
   (void) tiz_log_deinit ();
 
   return OMX_ErrorNone;
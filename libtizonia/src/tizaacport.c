@@ -113,7 +113,7 @@ static void *
 aacport_ctor (void * ap_obj, va_list * app)
 {
   tiz_aacport_t * p_obj
-    = super_ctor (typeOf (ap_obj, "tizaacport"), ap_obj, app);
+    = super_ctor (TIZ_TYPE_OF (ap_obj, "tizaacport"), ap_obj, app);
   tiz_port_t * p_base = ap_obj;
   OMX_AUDIO_PARAM_AACPROFILETYPE * p_aacmode = NULL;
   tiz_port_register_index (p_obj, OMX_IndexParamAudioAac);
@@ -136,7 +136,7 @@ aacport_ctor (void * ap_obj, va_list * app)
 static void *
 aacport_dtor (void * ap_obj)
 {
-  return super_dtor (typeOf (ap_obj, "tizaacport"), ap_obj);
+  return super_dtor (TIZ_TYPE_OF (ap_obj, "tizaacport"), ap_obj);
 }
 
 /*
@@ -168,7 +168,7 @@ aacport_GetParameter (const void * ap_obj, OMX_HANDLETYPE ap_hdl,
       default:
         {
           /* Try the parent's indexes */
-          rc = super_GetParameter (typeOf (ap_obj, "tizaacport"), ap_obj,
+          rc = super_GetParameter (TIZ_TYPE_OF (ap_obj, "tizaacport"), ap_obj,
                                    ap_hdl, a_index, ap_struct);
         }
     };
@@ -253,7 +253,7 @@ aacport_SetParameter (const void * ap_obj, OMX_HANDLETYPE ap_hdl,
       default:
         {
           /* Try the parent's indexes */
-          rc = super_SetParameter (typeOf (ap_obj, "tizaacport"), ap_obj,
+          rc = super_SetParameter (TIZ_TYPE_OF (ap_obj, "tizaacport"), ap_obj,
                                    ap_hdl, a_index, ap_struct);
         }
     };
@@ -527,7 +527,7 @@ static void *
 aacport_class_ctor (void * ap_obj, va_list * app)
 {
   /* NOTE: Class methods might be added in the future. None for now. */
-  return super_ctor (typeOf (ap_obj, "tizaacport_class"), ap_obj, app);
+  return super_ctor (TIZ_TYPE_OF (ap_obj, "tizaacport_class"), ap_obj, app);
 }
 
 /*
@@ -537,7 +537,7 @@ aacport_class_ctor (void * ap_obj, va_list * app)
 void *
 tiz_aacport_class_init (void * ap_tos, void * ap_hdl)
 {
-  void * tizaudioport = tiz_get_type (ap_hdl, "tizaudioport");
+  void * tizaudioport = TIZ_GET_TYPE (ap_hdl, "tizaudioport");
   void * tizaacport_class = factory_new
     /* TIZ_CLASS_COMMENT: class type, class name, parent, size */
     (classOf (tizaudioport), "tizaacport_class", classOf (tizaudioport),
@@ -554,8 +554,8 @@ tiz_aacport_class_init (void * ap_tos, void * ap_hdl)
 void *
 tiz_aacport_init (void * ap_tos, void * ap_hdl)
 {
-  void * tizaudioport = tiz_get_type (ap_hdl, "tizaudioport");
-  void * tizaacport_class = tiz_get_type (ap_hdl, "tizaacport_class");
+  void * tizaudioport = TIZ_GET_TYPE (ap_hdl, "tizaudioport");
+  void * tizaacport_class = TIZ_GET_TYPE (ap_hdl, "tizaacport_class");
   TIZ_LOG_CLASS (tizaacport_class);
   void * tizaacport = factory_new
     /* TIZ_CLASS_COMMENT: class type, class name, parent, size */
@@ -50,13 +50,13 @@
 static void *
 api_ctor (void * ap_obj, va_list * app)
 {
-  return super_ctor (typeOf (ap_obj, "tizapi"), ap_obj, app);
+  return super_ctor (TIZ_TYPE_OF (ap_obj, "tizapi"), ap_obj, app);
 }
 
 static void *
 api_dtor (void * ap_obj)
 {
-  return super_dtor (typeOf (ap_obj, "tizapi"), ap_obj);
+  return super_dtor (TIZ_TYPE_OF (ap_obj, "tizapi"), ap_obj);
 }
 
 static OMX_ERRORTYPE
@@ -569,7 +569,7 @@ static void *
 api_class_ctor (void * ap_obj, va_list * app)
 {
   tiz_api_class_t * p_obj
-    = super_ctor (typeOf (ap_obj, "tizapi_class"), ap_obj, app);
+    = super_ctor (TIZ_TYPE_OF (ap_obj, "tizapi_class"), ap_obj, app);
   typedef void (*voidf) ();
   voidf selector = NULL;
   va_list ap;
@@ -667,7 +667,7 @@ api_class_ctor (void * ap_obj, va_list * app)
 void *
 tiz_api_class_init (void * ap_tos, void * ap_hdl)
 {
-  void * tizobject = tiz_get_type (ap_hdl, "tizobject");
+  void * tizobject = TIZ_GET_TYPE (ap_hdl, "tizobject");
   void * tizapi_class = factory_new
     /* TIZ_CLASS_COMMENT: class type, class name, parent, size */
     (classOf (tizobject), "tizapi_class", classOf (tizobject),
@@ -684,8 +684,8 @@ tiz_api_class_init (void * ap_tos, void * ap_hdl)
 void *
 tiz_api_init (void * ap_tos, void * ap_hdl)
 {
-  void * tizobject = tiz_get_type (ap_hdl, "tizobject");
-  void * tizapi_class = tiz_get_type (ap_hdl, "tizapi_class");
+  void * tizobject = TIZ_GET_TYPE (ap_hdl, "tizobject");
+  void * tizapi_class = TIZ_GET_TYPE (ap_hdl, "tizapi_class");
   TIZ_LOG_CLASS (tizapi_class);
   void * tizapi
     = factory_new (tizapi_class, "tizapi", tizobject, sizeof (tiz_api_t),
@@ -93,7 +93,7 @@ static void *
 audioport_ctor (void * ap_obj, va_list * app)
 {
   tiz_audioport_t * p_obj
-    = super_ctor (typeOf (ap_obj, "tizaudioport"), ap_obj, app);
+    = super_ctor (TIZ_TYPE_OF (ap_obj, "tizaudioport"), ap_obj, app);
   OMX_AUDIO_CODINGTYPE * p_encodings = NULL;
 
   assert (p_obj);
@@ -134,7 +134,7 @@ audioport_dtor (void * ap_obj)
   assert (p_obj);
   tiz_vector_clear (p_obj->p_encodings_);
   tiz_vector_destroy (p_obj->p_encodings_);
-  return super_dtor (typeOf (ap_obj, "tizaudioport"), ap_obj);
+  return super_dtor (TIZ_TYPE_OF (ap_obj, "tizaudioport"), ap_obj);
 }
 
 /*
@@ -175,8 +175,8 @@ audioport_GetParameter (const void * ap_obj, OMX_HANDLETYPE ap_hdl,
       default:
         {
           /* Try the parent's indexes */
-          return super_GetParameter (typeOf (ap_obj, "tizaudioport"), ap_obj,
-                                     ap_hdl, a_index, ap_struct);
+          return super_GetParameter (TIZ_TYPE_OF (ap_obj, "tizaudioport"),
+                                     ap_obj, ap_hdl, a_index, ap_struct);
         }
     };
 
@@ -212,7 +212,7 @@ audioport_SetParameter (const void * ap_obj, OMX_HANDLETYPE ap_hdl,
       default:
         {
           /* Try the parent's indexes */
-          rc = super_SetParameter (typeOf (ap_obj, "tizaudioport"), ap_obj,
+          rc = super_SetParameter (TIZ_TYPE_OF (ap_obj, "tizaudioport"), ap_obj,
                                    ap_hdl, a_index, ap_struct);
         }
         break;
@@ -252,7 +252,7 @@ static void *
 audioport_class_ctor (void * ap_obj, va_list * app)
 {
   /* NOTE: Class methods might be added in the future. None for now. */
-  return super_ctor (typeOf (ap_obj, "tizaudioport_class"), ap_obj, app);
+  return super_ctor (TIZ_TYPE_OF (ap_obj, "tizaudioport_class"), ap_obj, app);
 }
 
 /*
@@ -262,7 +262,7 @@ audioport_class_ctor (void * ap_obj, va_list * app)
 void *
 tiz_audioport_class_init (void * ap_tos, void * ap_hdl)
 {
-  void * tizport = tiz_get_type (ap_hdl, "tizport");
+  void * tizport = TIZ_GET_TYPE (ap_hdl, "tizport");
   void * tizaudioport_class = factory_new
     /* TIZ_CLASS_COMMENT: class type, class name, parent, size */
     (classOf (tizport), "tizaudioport_class", classOf (tizport),
@@ -279,8 +279,8 @@ tiz_audioport_class_init (void * ap_tos, void * ap_hdl)
 void *
 tiz_audioport_init (void * ap_tos, void * ap_hdl)
 {
-  void * tizport = tiz_get_type (ap_hdl, "tizport");
-  void * tizaudioport_class = tiz_get_type (ap_hdl, "tizaudioport_class");
+  void * tizport = TIZ_GET_TYPE (ap_hdl, "tizport");
+  void * tizaudioport_class = TIZ_GET_TYPE (ap_hdl, "tizaudioport_class");
   void * tizaudioport = factory_new
     /* TIZ_CLASS_COMMENT: class type, class name, parent, size */
     (tizaudioport_class, "tizaudioport", tizport, sizeof (tiz_audioport_t),
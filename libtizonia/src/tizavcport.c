@@ -51,7 +51,7 @@ static void *
 avcport_ctor (void * ap_obj, va_list * app)
 {
   tiz_avcport_t * p_obj
-    = super_ctor (typeOf (ap_obj, "tizavcport"), ap_obj, app);
+    = super_ctor (TIZ_TYPE_OF (ap_obj, "tizavcport"), ap_obj, app);
   tiz_port_t * p_base = ap_obj;
   OMX_VIDEO_PARAM_AVCTYPE * p_avctype = NULL;
   OMX_VIDEO_AVCLEVELTYPE * p_levels = NULL;
@@ -143,7 +143,7 @@ avcport_dtor (void * ap_obj)
   tiz_avcport_t * p_obj = ap_obj;
   tiz_vector_clear (p_obj->p_levels_);
   tiz_vector_destroy (p_obj->p_levels_);
-  return super_dtor (typeOf (ap_obj, "tizavcport"), ap_obj);
+  return super_dtor (TIZ_TYPE_OF (ap_obj, "tizavcport"), ap_obj);
 }
 
 /*
@@ -231,7 +231,7 @@ avcport_GetParameter (const void * ap_obj, OMX_HANDLETYPE ap_hdl,
       default:
         {
           /* Try the parent's indexes */
-          return super_GetParameter (typeOf (ap_obj, "tizavcport"), ap_obj,
+          return super_GetParameter (TIZ_TYPE_OF (ap_obj, "tizavcport"), ap_obj,
                                      ap_hdl, a_index, ap_struct);
         }
     };
@@ -366,7 +366,7 @@ avcport_SetParameter (const void * ap_obj, OMX_HANDLETYPE ap_hdl,
       default:
         {
           /* Try the parent's indexes */
-          return super_SetParameter (typeOf (ap_obj, "tizavcport"), ap_obj,
+          return super_SetParameter (TIZ_TYPE_OF (ap_obj, "tizavcport"), ap_obj,
                                      ap_hdl, a_index, ap_struct);
         }
     };
@@ -423,8 +423,8 @@ avcport_GetConfig (const void * ap_obj, OMX_HANDLETYPE ap_hdl,
       default:
         {
           /* Try the parent's indexes */
-          return super_GetConfig (typeOf (ap_obj, "tizavcport"), ap_obj, ap_hdl,
-                                  a_index, ap_struct);
+          return super_GetConfig (TIZ_TYPE_OF (ap_obj, "tizavcport"), ap_obj,
+                                  ap_hdl, a_index, ap_struct);
         }
     };
 
@@ -480,8 +480,8 @@ avcport_SetConfig (const void * ap_obj, OMX_HANDLETYPE ap_hdl,
       default:
         {
           /* Try the parent's indexes */
-          return super_SetConfig (typeOf (ap_obj, "tizavcport"), ap_obj, ap_hdl,
-                                  a_index, ap_struct);
+          return super_SetConfig (TIZ_TYPE_OF (ap_obj, "tizavcport"), ap_obj,
+                                  ap_hdl, a_index, ap_struct);
         }
     };
 
@@ -533,7 +533,7 @@ static void *
 avcport_class_ctor (void * ap_obj, va_list * app)
 {
   /* NOTE: Class methods might be added in the future. None for now. */
-  return super_ctor (typeOf (ap_obj, "tizavcport_class"), ap_obj, app);
+  return super_ctor (TIZ_TYPE_OF (ap_obj, "tizavcport_class"), ap_obj, app);
 }
 
 /*
@@ -543,7 +543,7 @@ avcport_class_ctor (void * ap_obj, va_list * app)
 void *
 tiz_avcport_class_init (void * ap_tos, void * ap_hdl)
 {
-  void * tizvideoport = tiz_get_type (ap_hdl, "tizvideoport");
+  void * tizvideoport = TIZ_GET_TYPE (ap_hdl, "tizvideoport");
   void * tizavcport_class = factory_new
     /* TIZ_CLASS_COMMENT: class type, class name, parent, size */
     (classOf (tizvideoport), "tizavcport_class", classOf (tizvideoport),
@@ -560,8 +560,8 @@ tiz_avcport_class_init (void * ap_tos, void * ap_hdl)
 void *
 tiz_avcport_init (void * ap_tos, void * ap_hdl)
 {
-  void * tizvideoport = tiz_get_type (ap_hdl, "tizvideoport");
-  void * tizavcport_class = tiz_get_type (ap_hdl, "tizavcport_class");
+  void * tizvideoport = TIZ_GET_TYPE (ap_hdl, "tizvideoport");
+  void * tizavcport_class = TIZ_GET_TYPE (ap_hdl, "tizavcport_class");
   TIZ_LOG_CLASS (tizavcport_class);
   void * tizavcport = factory_new
     /* TIZ_CLASS_COMMENT: class type, class name, parent, size */
@@ -71,7 +71,8 @@ binaryport_ctor (void * ap_obj, va_list * app)
 
   /* Now give the original to the base class */
   if (NULL
-      == (p_obj = super_ctor (typeOf (ap_obj, "tizbinaryport"), ap_obj, app)))
+      == (p_obj = super_ctor (TIZ_TYPE_OF (ap_obj, "tizbinaryport"), ap_obj,
+                              app)))
     {
       return NULL;
     }
@@ -91,7 +92,8 @@ binaryport_ctor (void * ap_obj, va_list * app)
             tiz_port_register_index (p_obj, OMX_IndexParamAudioPortFormat));
 
           p_obj->p_port_
-            = factory_new (typeOf (ap_obj, "tizaudioport"), p_opts, &encodings);
+            = factory_new (TIZ_TYPE_OF (ap_obj, "tizaudioport"), p_opts,
+                           &encodings);
           if (NULL == p_obj->p_port_)
             {
               return NULL;
@@ -124,8 +126,8 @@ binaryport_ctor (void * ap_obj, va_list * app)
           tiz_check_omx_ret_null (
             tiz_port_register_index (p_obj, OMX_IndexParamVideoPortFormat));
 
-          p_obj->p_port_ = factory_new (typeOf (ap_obj, "tizvideoport"), p_opts,
-                                        &portdef, &encodings, &formats);
+          p_obj->p_port_ = factory_new (TIZ_TYPE_OF (ap_obj, "tizvideoport"),
+                                        p_opts, &portdef, &encodings, &formats);
           if (NULL == p_obj->p_port_)
             {
               return NULL;
@@ -156,8 +158,8 @@ binaryport_ctor (void * ap_obj, va_list * app)
           tiz_check_omx_ret_null (
             tiz_port_register_index (p_obj, OMX_IndexParamImagePortFormat));
 
-          p_obj->p_port_ = factory_new (typeOf (ap_obj, "tizimageport"), p_opts,
-                                        &portdef, &encodings, &formats);
+          p_obj->p_port_ = factory_new (TIZ_TYPE_OF (ap_obj, "tizimageport"),
+                                        p_opts, &portdef, &encodings, &formats);
           if (NULL == p_obj->p_port_)
             {
               return NULL;
@@ -174,7 +176,8 @@ binaryport_ctor (void * ap_obj, va_list * app)
             tiz_port_register_index (p_obj, OMX_IndexParamOtherPortFormat));
 
           p_obj->p_port_
-            = factory_new (typeOf (ap_obj, "tizotherport"), p_opts, &formats);
+            = factory_new (TIZ_TYPE_OF (ap_obj, "tizotherport"), p_opts,
+                           &formats);
           if (NULL == p_obj->p_port_)
             {
               return NULL;
@@ -197,7 +200,7 @@ binaryport_dtor (void * ap_obj)
   tiz_binaryport_t * p_obj = ap_obj;
   assert (p_obj);
   factory_delete (p_obj->p_port_);
-  return super_dtor (typeOf (ap_obj, "tizbinaryport"), ap_obj);
+  return super_dtor (TIZ_TYPE_OF (ap_obj, "tizbinaryport"), ap_obj);
 }
 
 /*
@@ -236,8 +239,8 @@ binaryport_GetParameter (const void * ap_obj, OMX_HANDLETYPE ap_hdl,
       default:
         {
           /* Delegate to the base port */
-          rc = super_GetParameter (typeOf (ap_obj, "tizbinaryport"), ap_obj,
-                                   ap_hdl, a_index, ap_struct);
+          rc = super_GetParameter (TIZ_TYPE_OF (ap_obj, "tizbinaryport"),
+                                   ap_obj, ap_hdl, a_index, ap_struct);
         }
     };
 
@@ -277,8 +280,8 @@ binaryport_SetParameter (const void * ap_obj, OMX_HANDLETYPE ap_hdl,
       default:
         {
           /* Delegate to the base port */
-          rc = super_SetParameter (typeOf (ap_obj, "tizbinaryport"), ap_obj,
-                                   ap_hdl, a_index, ap_struct);
+          rc = super_SetParameter (TIZ_TYPE_OF (ap_obj, "tizbinaryport"),
+                                   ap_obj, ap_hdl, a_index, ap_struct);
         }
     };
 
@@ -325,7 +328,7 @@ static void *
 binaryport_class_ctor (void * ap_obj, va_list * app)
 {
   /* NOTE: Class methods might be added in the future. None for now. */
-  return super_ctor (typeOf (ap_obj, "tizbinaryport_class"), ap_obj, app);
+  return super_ctor (TIZ_TYPE_OF (ap_obj, "tizbinaryport_class"), ap_obj, app);
 }
 
 /*
@@ -335,7 +338,7 @@ binaryport_class_ctor (void * ap_obj, va_list * app)
 void *
 tiz_binaryport_class_init (void * ap_tos, void * ap_hdl)
 {
-  void * tizport = tiz_get_type (ap_hdl, "tizport");
+  void * tizport = TIZ_GET_TYPE (ap_hdl, "tizport");
   void * tizbinaryport_class = factory_new
     /* TIZ_CLASS_COMMENT: class type, class name, parent, size */
     (classOf (tizport), "tizbinaryport_class", classOf (tizport),
@@ -352,8 +355,8 @@ tiz_binaryport_class_init (void * ap_tos, void * ap_hdl)
 void *
 tiz_binaryport_init (void * ap_tos, void * ap_hdl)
 {
-  void * tizport = tiz_get_type (ap_hdl, "tizport");
-  void * tizbinaryport_class = tiz_get_type (ap_hdl, "tizbinaryport_class");
+  void * tizport = TIZ_GET_TYPE (ap_hdl, "tizport");
+  void * tizbinaryport_class = TIZ_GET_TYPE (ap_hdl, "tizbinaryport_class");
   TIZ_LOG_CLASS (tizbinaryport_class);
   void * tizbinaryport = factory_new
     /* TIZ_CLASS_COMMENT: class type, class name, parent, size */
@@ -85,7 +85,7 @@ static void *
 configport_ctor (void * ap_obj, va_list * app)
 {
   tiz_configport_t * p_obj
-    = super_ctor (typeOf (ap_obj, "tizconfigport"), ap_obj, app);
+    = super_ctor (TIZ_TYPE_OF (ap_obj, "tizconfigport"), ap_obj, app);
   tiz_port_t * p_base = ap_obj;
   size_t str_len = 0;
 
@@ -180,7 +180,7 @@ configport_dtor (void * ap_obj)
   clear_metadata_lst (p_obj);
   tiz_vector_destroy (p_obj->p_metadata_lst_);
   p_obj->p_metadata_lst_ = NULL;
-  return super_dtor (typeOf (ap_obj, "tizconfigport"), ap_obj);
+  return super_dtor (TIZ_TYPE_OF (ap_obj, "tizconfigport"), ap_obj);
 }
 
 /*
@@ -514,7 +514,7 @@ static void *
 configport_class_ctor (void * ap_obj, va_list * app)
 {
   tiz_configport_class_t * p_obj
-    = super_ctor (typeOf (ap_obj, "tizconfigport_class"), ap_obj, app);
+    = super_ctor (TIZ_TYPE_OF (ap_obj, "tizconfigport_class"), ap_obj, app);
   typedef void (*voidf) ();
   voidf selector = NULL;
   va_list ap;
@@ -548,7 +548,7 @@ configport_class_ctor (void * ap_obj, va_list * app)
 void *
 tiz_configport_class_init (void * ap_tos, void * ap_hdl)
 {
-  void * tizport = tiz_get_type (ap_hdl, "tizport");
+  void * tizport = TIZ_GET_TYPE (ap_hdl, "tizport");
   void * tizconfigport_class = factory_new
     /* TIZ_CLASS_COMMENT: class type, class name, parent, size */
     (classOf (tizport), "tizconfigport_class", classOf (tizport),
@@ -565,8 +565,8 @@ tiz_configport_class_init (void * ap_tos, void * ap_hdl)
 void *
 tiz_configport_init (void * ap_tos, void * ap_hdl)
 {
-  void * tizport = tiz_get_type (ap_hdl, "tizport");
-  void * tizconfigport_class = tiz_get_type (ap_hdl, "tizconfigport_class");
+  void * tizport = TIZ_GET_TYPE (ap_hdl, "tizport");
+  void * tizconfigport_class = TIZ_GET_TYPE (ap_hdl, "tizconfigport_class");
   TIZ_LOG_CLASS (tizconfigport_class);
   void * tizconfigport = factory_new
     /* TIZ_CLASS_COMMENT: class type, class name, parent, size */
@@ -51,7 +51,7 @@ static void *
 demuxer_cfgport_ctor (void * ap_obj, va_list * app)
 {
   tiz_demuxercfgport_t * p_obj
-    = super_ctor (typeOf (ap_obj, "tizdemuxercfgport"), ap_obj, app);
+    = super_ctor (TIZ_TYPE_OF (ap_obj, "tizdemuxercfgport"), ap_obj, app);
 
   /* In addition to the indexes registered by the parent class, register here
      the demuxer-specific ones */
@@ -66,7 +66,7 @@ demuxer_cfgport_ctor (void * ap_obj, va_list * app)
 static void *
 demuxer_cfgport_dtor (void * ap_obj)
 {
-  return super_dtor (typeOf (ap_obj, "tizdemuxercfgport"), ap_obj);
+  return super_dtor (TIZ_TYPE_OF (ap_obj, "tizdemuxercfgport"), ap_obj);
 }
 
 /*
@@ -106,8 +106,8 @@ demuxer_cfgport_GetConfig (const void * ap_obj, OMX_HANDLETYPE ap_hdl,
       default:
         {
           /* Delegate to the base port */
-          rc = super_GetConfig (typeOf (ap_obj, "tizdemuxercfgport"), ap_obj,
-                                ap_hdl, a_index, ap_struct);
+          rc = super_GetConfig (TIZ_TYPE_OF (ap_obj, "tizdemuxercfgport"),
+                                ap_obj, ap_hdl, a_index, ap_struct);
         }
     };
 
@@ -147,8 +147,8 @@ demuxer_cfgport_SetConfig (const void * ap_obj, OMX_HANDLETYPE ap_hdl,
       default:
         {
           /* Delegate to the base port */
-          rc = super_SetConfig (typeOf (ap_obj, "tizdemuxercfgport"), ap_obj,
-                                ap_hdl, a_index, ap_struct);
+          rc = super_SetConfig (TIZ_TYPE_OF (ap_obj, "tizdemuxercfgport"),
+                                ap_obj, ap_hdl, a_index, ap_struct);
         }
     };
 
@@ -163,7 +163,8 @@ static void *
 demuxercfgport_class_ctor (void * ap_obj, va_list * app)
 {
   /* NOTE: Class methods might be added in the future. None for now. */
-  return super_ctor (typeOf (ap_obj, "tizdemuxercfgport_class"), ap_obj, app);
+  return super_ctor (TIZ_TYPE_OF (ap_obj, "tizdemuxercfgport_class"), ap_obj,
+                     app);
 }
 
 /*
@@ -173,7 +174,7 @@ demuxercfgport_class_ctor (void * ap_obj, va_list * app)
 void *
 tiz_demuxercfgport_class_init (void * ap_tos, void * ap_hdl)
 {
-  void * tizuricfgport = tiz_get_type (ap_hdl, "tizuricfgport");
+  void * tizuricfgport = TIZ_GET_TYPE (ap_hdl, "tizuricfgport");
   void * tizdemuxercfgport_class = factory_new
     /* TIZ_CLASS_COMMENT: class type, class name, parent, size */
     (classOf (tizuricfgport), "tizdemuxercfgport_class",
@@ -190,9 +191,9 @@ tiz_demuxercfgport_class_init (void * ap_tos, void * ap_hdl)
 void *
 tiz_demuxercfgport_init (void * ap_tos, void * ap_hdl)
 {
-  void * tizuricfgport = tiz_get_type (ap_hdl, "tizuricfgport");
+  void * tizuricfgport = TIZ_GET_TYPE (ap_hdl, "tizuricfgport");
   void * tizdemuxercfgport_class
-    = tiz_get_type (ap_hdl, "tizdemuxercfgport_class");
+    = TIZ_GET_TYPE (ap_hdl, "tizdemuxercfgport_class");
   TIZ_LOG_CLASS (tizdemuxercfgport_class);
   void * tizdemuxercfgport = factory_new
     /* TIZ_CLASS_COMMENT: class type, class name, parent, size */
@@ -204,7 +204,8 @@ demuxerport_ctor (void * ap_obj, va_list * app)
   va_copy (app_copy, *app);
 
   /* Now give the original to the base class */
-  if ((p_obj = super_ctor (typeOf (ap_obj, "tizdemuxerport"), ap_obj, app)))
+  if ((p_obj = super_ctor (TIZ_TYPE_OF (ap_obj, "tizdemuxerport"), ap_obj,
+                           app)))
     {
       /* Register the demuxer-specific indexes  */
       tiz_check_omx_ret_null (
@@ -230,7 +231,7 @@ demuxerport_ctor (void * ap_obj, va_list * app)
               assert (p_encodings);
 
               p_obj->p_port_
-                = factory_new (typeOf (ap_obj, "tizaudioport"), p_opts,
+                = factory_new (TIZ_TYPE_OF (ap_obj, "tizaudioport"), p_opts,
                                p_encodings);
               if (!p_obj->p_port_)
                 {
@@ -263,8 +264,8 @@ demuxerport_ctor (void * ap_obj, va_list * app)
               assert (p_formats);
 
               if (NULL == (p_obj->p_port_ = factory_new (
-                             typeOf (ap_obj, "tizvideoport"), p_opts, p_portdef,
-                             p_encodings, p_formats)))
+                             TIZ_TYPE_OF (ap_obj, "tizvideoport"), p_opts,
+                             p_portdef, p_encodings, p_formats)))
                 {
                   return NULL;
                 }
@@ -286,7 +287,7 @@ demuxerport_dtor (void * ap_obj)
   tiz_demuxerport_t * p_obj = ap_obj;
   assert (p_obj);
   factory_delete (p_obj->p_port_);
-  return super_dtor (typeOf (ap_obj, "tizdemuxerport"), ap_obj);
+  return super_dtor (TIZ_TYPE_OF (ap_obj, "tizdemuxerport"), ap_obj);
 }
 
 /*
@@ -341,8 +342,8 @@ demuxerport_GetParameter (const void * ap_obj, OMX_HANDLETYPE ap_hdl,
       default:
         {
           /* Delegate to the base port */
-          return super_GetParameter (typeOf (ap_obj, "tizdemuxerport"), ap_obj,
-                                     ap_hdl, a_index, ap_struct);
+          return super_GetParameter (TIZ_TYPE_OF (ap_obj, "tizdemuxerport"),
+                                     ap_obj, ap_hdl, a_index, ap_struct);
         }
     };
 
@@ -409,8 +410,8 @@ demuxerport_SetParameter (const void * ap_obj, OMX_HANDLETYPE ap_hdl,
         {
           /* Delegate to the base port */
           TIZ_DEBUG(ap_hdl, "delegating to base port");
-          return super_SetParameter (typeOf (ap_obj, "tizdemuxerport"), ap_obj,
-                                     ap_hdl, a_index, ap_struct);
+          return super_SetParameter (TIZ_TYPE_OF (ap_obj, "tizdemuxerport"),
+                                     ap_obj, ap_hdl, a_index, ap_struct);
         }
     };
 
@@ -448,7 +449,7 @@ demuxerport_GetConfig (const void * ap_obj, OMX_HANDLETYPE ap_hdl,
       default:
         {
           /* Try the parent's indexes */
-          rc = super_GetConfig (typeOf (ap_obj, "tizdemuxerport"), ap_obj,
+          rc = super_GetConfig (TIZ_TYPE_OF (ap_obj, "tizdemuxerport"), ap_obj,
                                 ap_hdl, a_index, ap_struct);
         }
     };
@@ -487,7 +488,7 @@ demuxerport_SetConfig (const void * ap_obj, OMX_HANDLETYPE ap_hdl,
       default:
         {
           /* Try the parent's indexes */
-          rc = super_SetConfig (typeOf (ap_obj, "tizdemuxerport"), ap_obj,
+          rc = super_SetConfig (TIZ_TYPE_OF (ap_obj, "tizdemuxerport"), ap_obj,
                                 ap_hdl, a_index, ap_struct);
         }
     };
@@ -582,7 +583,7 @@ static void *
 demuxerport_class_ctor (void * ap_obj, va_list * app)
 {
   /* NOTE: Class methods might be added in the future. None for now. */
-  return super_ctor (typeOf (ap_obj, "tizdemuxerport_class"), ap_obj, app);
+  return super_ctor (TIZ_TYPE_OF (ap_obj, "tizdemuxerport_class"), ap_obj, app);
 }
 
 /*
@@ -592,7 +593,7 @@ demuxerport_class_ctor (void * ap_obj, va_list * app)
 void *
 tiz_demuxerport_class_init (void * ap_tos, void * ap_hdl)
 {
-  void * tizport = tiz_get_type (ap_hdl, "tizport");
+  void * tizport = TIZ_GET_TYPE (ap_hdl, "tizport");
   void * tizdemuxerport_class = factory_new
     /* TIZ_CLASS_COMMENT: class type, class name, parent, size */
     (classOf (tizport), "tizdemuxerport_class", classOf (tizport),
@@ -609,8 +610,8 @@ tiz_demuxerport_class_init (void * ap_tos, void * ap_hdl)
 void *
 tiz_demuxerport_init (void * ap_tos, void * ap_hdl)
 {
-  void * tizport = tiz_get_type (ap_hdl, "tizport");
-  void * tizdemuxerport_class = tiz_get_type (ap_hdl, "tizdemuxerport_class");
+  void * tizport = TIZ_GET_TYPE (ap_hdl, "tizport");
+  void * tizdemuxerport_class = TIZ_GET_TYPE (ap_hdl, "tizdemuxerport_class");
   TIZ_LOG_CLASS (tizdemuxerport_class);
   void * tizdemuxerport = factory_new
     /* TIZ_CLASS_COMMENT: class type, class name, parent, size */
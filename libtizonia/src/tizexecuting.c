@@ -52,14 +52,14 @@ static void *
 executing_ctor (void * ap_obj, va_list * app)
 {
   tiz_executing_t * p_obj
-    = super_ctor (typeOf (ap_obj, "tizexecuting"), ap_obj, app);
+    = super_ctor (TIZ_TYPE_OF (ap_obj, "tizexecuting"), ap_obj, app);
   return p_obj;
 }
 
 static void *
 executing_dtor (void * ap_obj)
 {
-  return super_dtor (typeOf (ap_obj, "tizexecuting"), ap_obj);
+  return super_dtor (TIZ_TYPE_OF (ap_obj, "tizexecuting"), ap_obj);
 }
 
 static OMX_ERRORTYPE
@@ -231,8 +231,9 @@ executing_state_set (const void * ap_obj, OMX_HANDLETYPE ap_hdl,
       }
     }
 
-  return tiz_state_super_state_set (typeOf (ap_obj, "tizexecuting"), ap_obj,
-                                    ap_hdl, a_cmd, a_param1, ap_cmd_data);
+  return tiz_state_super_state_set (TIZ_TYPE_OF (ap_obj, "tizexecuting"),
+                                    ap_obj, ap_hdl, a_cmd, a_param1,
+                                    ap_cmd_data);
 }
 
 static OMX_ERRORTYPE
@@ -257,7 +258,7 @@ executing_trans_complete (const void * ap_obj, OMX_PTR ap_servant,
              tiz_fsm_state_to_str ((tiz_fsm_state_id_t) a_new_state));
   assert (OMX_StateExecuting == a_new_state || OMX_StatePause == a_new_state
           || OMX_StateIdle == a_new_state);
-  return tiz_state_super_trans_complete (typeOf (ap_obj, "tizexecuting"),
+  return tiz_state_super_trans_complete (TIZ_TYPE_OF (ap_obj, "tizexecuting"),
                                          ap_obj, ap_servant, a_new_state);
 }
 
@@ -269,7 +270,7 @@ static void *
 executing_class_ctor (void * ap_obj, va_list * app)
 {
   /* NOTE: Class methods might be added in the future. None for now. */
-  return super_ctor (typeOf (ap_obj, "tizexecuting_class"), ap_obj, app);
+  return super_ctor (TIZ_TYPE_OF (ap_obj, "tizexecuting_class"), ap_obj, app);
 }
 
 /*
@@ -279,7 +280,7 @@ executing_class_ctor (void * ap_obj, va_list * app)
 void *
 tiz_executing_class_init (void * ap_tos, void * ap_hdl)
 {
-  void * tizstate = tiz_get_type (ap_hdl, "tizstate");
+  void * tizstate = TIZ_GET_TYPE (ap_hdl, "tizstate");
   void * tizexecuting_class
     = factory_new (classOf (tizstate), "tizexecuting_class", classOf (tizstate),
                    sizeof (tiz_executing_class_t), ap_tos, ap_hdl, ctor,
@@ -290,8 +291,8 @@ tiz_executing_class_init (void * ap_tos, void * ap_hdl)
 void *
 tiz_executing_init (void * ap_tos, void * ap_hdl)
 {
-  void * tizstate = tiz_get_type (ap_hdl, "tizstate");
-  void * tizexecuting_class = tiz_get_type (ap_hdl, "tizexecuting_class");
+  void * tizstate = TIZ_GET_TYPE (ap_hdl, "tizstate");
+  void * tizexecuting_class = TIZ_GET_TYPE (ap_hdl, "tizexecuting_class");
   TIZ_LOG_CLASS (tizexecuting_class);
   void * tizexecuting = factory_new (
     tizexecuting_class, "tizexecuting", tizstate, sizeof (tiz_executing_t),
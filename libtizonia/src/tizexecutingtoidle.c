@@ -48,14 +48,14 @@ static void *
 executingtoidle_ctor (void * ap_obj, va_list * app)
 {
   tiz_executingtoidle_t * p_obj
-    = super_ctor (typeOf (ap_obj, "tizexecutingtoidle"), ap_obj, app);
+    = super_ctor (TIZ_TYPE_OF (ap_obj, "tizexecutingtoidle"), ap_obj, app);
   return p_obj;
 }
 
 static void *
 executingtoidle_dtor (void * ap_obj)
 {
-  return super_dtor (typeOf (ap_obj, "tizexecutingtoidle"), ap_obj);
+  return super_dtor (TIZ_TYPE_OF (ap_obj, "tizexecutingtoidle"), ap_obj);
 }
 
 static OMX_ERRORTYPE
@@ -106,8 +106,9 @@ executingtoidle_trans_complete (const void * ap_obj, OMX_PTR ap_servant,
         OMX_TIZONIA_PORTSTATUS_AWAITBUFFERSRETURN);
     }
 
-  return tiz_state_super_trans_complete (typeOf (ap_obj, "tizexecutingtoidle"),
-                                         ap_obj, ap_servant, a_new_state);
+  return tiz_state_super_trans_complete (
+    TIZ_TYPE_OF (ap_obj, "tizexecutingtoidle"), ap_obj, ap_servant,
+    a_new_state);
 }
 
 static OMX_ERRORTYPE
@@ -128,8 +129,8 @@ executingtoidle_tunneled_ports_status_update (void * ap_obj)
          * 'tiz_state_state_set' function of the tiz_state_t base class (note
          * we are passing 'tizidle' as 1st parameter */
         TIZ_TRACE (p_hdl, "kernel may initiate exe to idle");
-        return tiz_state_super_state_set (typeOf (ap_obj, "tizidle"), ap_obj,
-                                          p_hdl, OMX_CommandStateSet,
+        return tiz_state_super_state_set (TIZ_TYPE_OF (ap_obj, "tizidle"),
+                                          ap_obj, p_hdl, OMX_CommandStateSet,
                                           OMX_StateIdle, NULL);
       }
   }
@@ -145,7 +146,8 @@ static void *
 executingtoidle_class_ctor (void * ap_obj, va_list * app)
 {
   /* NOTE: Class methods might be added in the future. None for now. */
-  return super_ctor (typeOf (ap_obj, "tizexecutingtoidle_class"), ap_obj, app);
+  return super_ctor (TIZ_TYPE_OF (ap_obj, "tizexecutingtoidle_class"), ap_obj,
+                     app);
 }
 
 /*
@@ -155,7 +157,7 @@ executingtoidle_class_ctor (void * ap_obj, va_list * app)
 void *
 tiz_executingtoidle_class_init (void * ap_tos, void * ap_hdl)
 {
-  void * tizexecuting = tiz_get_type (ap_hdl, "tizexecuting");
+  void * tizexecuting = TIZ_GET_TYPE (ap_hdl, "tizexecuting");
   void * tizexecutingtoidle_class
     = factory_new (classOf (tizexecuting), "tizexecutingtoidle_class",
                    classOf (tizexecuting), sizeof (tiz_executingtoidle_class_t),
@@ -166,9 +168,9 @@ tiz_executingtoidle_class_init (void * ap_tos, void * ap_hdl)
 void *
 tiz_executingtoidle_init (void * ap_tos, void * ap_hdl)
 {
-  void * tizexecuting = tiz_get_type (ap_hdl, "tizexecuting");
+  void * tizexecuting = TIZ_GET_TYPE (ap_hdl, "tizexecuting");
   void * tizexecutingtoidle_class
-    = tiz_get_type (ap_hdl, "tizexecutingtoidle_class");
+    = TIZ_GET_TYPE (ap_hdl, "tizexecutingtoidle_class");
   TIZ_LOG_CLASS (tizexecutingtoidle_class);
   void * tizexecutingtoidle = factory_new (
     tizexecutingtoidle_class, "tizexecutingtoidle", tizexecuting,
@@ -93,7 +93,7 @@ static void *
 filter_prc_ctor (void * ap_obj, va_list * app)
 {
   tiz_filter_prc_t * p_prc
-    = super_ctor (typeOf (ap_obj, "tizfilterprc"), ap_obj, app);
+    = super_ctor (TIZ_TYPE_OF (ap_obj, "tizfilterprc"), ap_obj, app);
   assert (p_prc);
 
   tiz_check_omx_ret_null (
@@ -128,7 +128,7 @@ filter_prc_dtor (void * ap_obj)
   tiz_vector_destroy (p_prc->p_disabled_flags_);
   tiz_vector_clear (p_prc->p_hdrs_);
   tiz_vector_destroy (p_prc->p_hdrs_);
-  return super_dtor (typeOf (ap_obj, "tizfilterprc"), ap_obj);
+  return super_dtor (TIZ_TYPE_OF (ap_obj, "tizfilterprc"), ap_obj);
 }
 
 static OMX_BUFFERHEADERTYPE **
@@ -439,7 +439,7 @@ static void *
 filter_prc_class_ctor (void * ap_obj, va_list * app)
 {
   tiz_filter_prc_class_t * p_obj
-    = super_ctor (typeOf (ap_obj, "tizfilterprc_class"), ap_obj, app);
+    = super_ctor (TIZ_TYPE_OF (ap_obj, "tizfilterprc_class"), ap_obj, app);
   typedef void (*voidf) ();
   voidf selector = NULL;
   va_list ap;
@@ -513,7 +513,7 @@ filter_prc_class_ctor (void * ap_obj, va_list * app)
 void *
 tiz_filter_prc_class_init (void * ap_tos, void * ap_hdl)
 {
-  void * tizprc = tiz_get_type (ap_hdl, "tizprc");
+  void * tizprc = TIZ_GET_TYPE (ap_hdl, "tizprc");
   void * tizfilterprc_class = factory_new
     /* TIZ_CLASS_COMMENT: class type, class name, parent, size */
     (classOf (tizprc), "tizfilterprc_class", classOf (tizprc),
@@ -530,8 +530,8 @@ tiz_filter_prc_class_init (void * ap_tos, void * ap_hdl)
 void *
 tiz_filter_prc_init (void * ap_tos, void * ap_hdl)
 {
-  void * tizprc = tiz_get_type (ap_hdl, "tizprc");
-  void * tizfilterprc_class = tiz_get_type (ap_hdl, "tizfilterprc_class");
+  void * tizprc = TIZ_GET_TYPE (ap_hdl, "tizprc");
+  void * tizfilterprc_class = TIZ_GET_TYPE (ap_hdl, "tizfilterprc_class");
   TIZ_LOG_CLASS (tizfilterprc_class);
   void * filterprc = factory_new
     /* TIZ_CLASS_COMMENT: class type, class name, parent, size */
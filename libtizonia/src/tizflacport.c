@@ -51,7 +51,7 @@ static void *
 flacport_ctor (void * ap_obj, va_list * app)
 {
   tiz_flacport_t * p_obj
-    = super_ctor (typeOf (ap_obj, "tizflacport"), ap_obj, app);
+    = super_ctor (TIZ_TYPE_OF (ap_obj, "tizflacport"), ap_obj, app);
   tiz_port_t * p_base = ap_obj;
   OMX_TIZONIA_AUDIO_PARAM_FLACTYPE * p_flactype = NULL;
   tiz_port_register_index (p_obj, OMX_TizoniaIndexParamAudioFlac);
@@ -75,7 +75,7 @@ flacport_ctor (void * ap_obj, va_list * app)
 static void *
 flacport_dtor (void * ap_obj)
 {
-  return super_dtor (typeOf (ap_obj, "tizflacport"), ap_obj);
+  return super_dtor (TIZ_TYPE_OF (ap_obj, "tizflacport"), ap_obj);
 }
 
 /*
@@ -101,8 +101,8 @@ flacport_GetParameter (const void * ap_obj, OMX_HANDLETYPE ap_hdl,
   else
     {
       /* Try the parent's indexes */
-      return super_GetParameter (typeOf (ap_obj, "tizflacport"), ap_obj, ap_hdl,
-                                 a_index, ap_struct);
+      return super_GetParameter (TIZ_TYPE_OF (ap_obj, "tizflacport"), ap_obj,
+                                 ap_hdl, a_index, ap_struct);
     }
 
   return OMX_ErrorNone;
@@ -166,8 +166,8 @@ flacport_SetParameter (const void * ap_obj, OMX_HANDLETYPE ap_hdl,
   else
     {
       /* Try the parent's indexes */
-      return super_SetParameter (typeOf (ap_obj, "tizflacport"), ap_obj, ap_hdl,
-                                 a_index, ap_struct);
+      return super_SetParameter (TIZ_TYPE_OF (ap_obj, "tizflacport"), ap_obj,
+                                 ap_hdl, a_index, ap_struct);
     }
 
   return OMX_ErrorNone;
@@ -411,7 +411,7 @@ static void *
 flacport_class_ctor (void * ap_obj, va_list * app)
 {
   /* NOTE: Class methods might be added in the future. None for now. */
-  return super_ctor (typeOf (ap_obj, "tizflacport_class"), ap_obj, app);
+  return super_ctor (TIZ_TYPE_OF (ap_obj, "tizflacport_class"), ap_obj, app);
 }
 
 /*
@@ -421,7 +421,7 @@ flacport_class_ctor (void * ap_obj, va_list * app)
 void *
 tiz_flacport_class_init (void * ap_tos, void * ap_hdl)
 {
-  void * tizaudioport = tiz_get_type (ap_hdl, "tizaudioport");
+  void * tizaudioport = TIZ_GET_TYPE (ap_hdl, "tizaudioport");
   void * tizflacport_class = factory_new
     /* TIZ_CLASS_COMMENT: class type, class name, parent, size */
     (classOf (tizaudioport), "tizflacport_class", classOf (tizaudioport),
@@ -438,8 +438,8 @@ tiz_flacport_class_init (void * ap_tos, void * ap_hdl)
 void *
 tiz_flacport_init (void * ap_tos, void * ap_hdl)
 {
-  void * tizaudioport = tiz_get_type (ap_hdl, "tizaudioport");
-  void * tizflacport_class = tiz_get_type (ap_hdl, "tizflacport_class");
+  void * tizaudioport = TIZ_GET_TYPE (ap_hdl, "tizaudioport");
+  void * tizflacport_class = TIZ_GET_TYPE (ap_hdl, "tizflacport_class");
   TIZ_LOG_CLASS (tizflacport_class);
   void * tizflacport = factory_new
     /* TIZ_CLASS_COMMENT: class type, class name, parent, size */
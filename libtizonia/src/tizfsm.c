@@ -38,6 +38,7 @@
 #include "tizport.h"
 #include "tizport-macros.h"
 #include "tizutils.h"
+#include "tizprobe.h"
 
 #include "tizplatform.h"
 
@@ -498,7 +499,7 @@ static void *
 fsm_ctor (void * ap_obj, va_list * app)
 {
   OMX_U32 i;
-  tiz_fsm_t * p_obj = super_ctor (typeOf (ap_obj, "tizfsm"), ap_obj, app);
+  tiz_fsm_t * p_obj = super_ctor (TIZ_TYPE_OF (ap_obj, "tizfsm"), ap_obj, app);
 
   for (i = 0; i < EStateMax; ++i)
     {
@@ -507,25 +508,25 @@ fsm_ctor (void * ap_obj, va_list * app)
 
   /* Add the standard states... */
   p_obj->p_states_[EStateLoaded]
-    = factory_new (typeOf (ap_obj, "tizloaded"), p_obj);
+    = factory_new (TIZ_TYPE_OF (ap_obj, "tizloaded"), p_obj);
   p_obj->p_states_[EStateIdle]
-    = factory_new (typeOf (ap_obj, "tizidle"), p_obj);
+    = factory_new (TIZ_TYPE_OF (ap_obj, "tizidle"), p_obj);
   p_obj->p_states_[EStateExecuting]
-    = factory_new (typeOf (ap_obj, "tizexecuting"), p_obj);
+    = factory_new (TIZ_TYPE_OF (ap_obj, "tizexecuting"), p_obj);
   p_obj->p_states_[EStatePause]
-    = factory_new (typeOf (ap_obj, "tizpause"), p_obj);
+    = factory_new (TIZ_TYPE_OF (ap_obj, "tizpause"), p_obj);
   p_obj->p_states_[EStateWaitForResources]
-    = factory_new (typeOf (ap_obj, "tizwaitforresources"), p_obj);
+    = factory_new (TIZ_TYPE_OF (ap_obj, "tizwaitforresources"), p_obj);
   p_obj->p_states_[ESubStateLoadedToIdle]
-    = factory_new (typeOf (ap_obj, "tizloadedtoidle"), p_obj);
+    = factory_new (TIZ_TYPE_OF (ap_obj, "tizloadedtoidle"), p_obj);
   p_obj->p_states_[ESubStateIdleToLoaded]
-    = factory_new (typeOf (ap_obj, "tizidletoloaded"), p_obj);
+    = factory_new (TIZ_TYPE_OF (ap_obj, "tizidletoloaded"), p_obj);
   p_obj->p_states_[ESubStateIdleToExecuting]
-    = factory_new (typeOf (ap_obj, "tizidletoexecuting"), p_obj);
+    = factory_new (TIZ_TYPE_OF (ap_obj, "tizidletoexecuting"), p_obj);
   p_obj->p_states_[ESubStateExecutingToIdle]
-    = factory_new (typeOf (ap_obj, "tizexecutingtoidle"), p_obj);
+    = factory_new (TIZ_TYPE_OF (ap_obj, "tizexecutingtoidle"), p_obj);
   p_obj->p_states_[ESubStatePauseToIdle]
-    = factory_new (typeOf (ap_obj, "tizpausetoidle"), p_obj);
+    = factory_new (TIZ_TYPE_OF (ap_obj, "tizpausetoidle"), p_obj);
 
   /* TODO : Check p_states_ pointers  */
 
@@ -554,7 +555,7 @@ fsm_dtor (void * ap_obj)
       p_obj->p_states_[i] = NULL;
     }
 
-  return super_dtor (typeOf (ap_obj, "tizfsm"), ap_obj);
+  return super_dtor (TIZ_TYPE_OF (ap_obj, "tizfsm"), ap_obj);
 }
 
 static OMX_ERRORTYPE
@@ -1015,6 +1016,8 @@ fsm_set_state (const void * ap_obj, tiz_fsm_state_id_t a_new_state,
                  tiz_fsm_state_to_str (a_new_state),
                  tiz_fsm_state_to_str (a_canceled_substate));
 
+      TIZ_PROBE3 (fsm__transition, handleOf (p_obj), p_obj->cur_state_id_,
+                  a_new_state);
       p_obj->cur_state_id_ = a_new_state;
       p_obj->p_current_state_ = p_obj->p_states_[a_new_state];
 
@@ -1243,7 +1246,7 @@ static void *
 fsm_class_ctor (void * ap_obj, va_list * app)
 {
   tiz_fsm_class_t * p_obj
-    = super_ctor (typeOf (ap_obj, "tizfsm_class"), ap_obj, app);
+    = super_ctor (TIZ_TYPE_OF (ap_obj, "tizfsm_class"), ap_obj, app);
   typedef void (*voidf) ();
   voidf selector = NULL;
   va_list ap;
@@ -1290,7 +1293,7 @@ fsm_class_ctor (void * ap_obj, va_list * app)
 void *
 tiz_fsm_class_init (void * ap_tos, void * ap_hdl)
 {
-  void * tizsrv = tiz_get_type (ap_hdl, "tizsrv");
+  void * tizsrv = TIZ_GET_TYPE (ap_hdl, "tizsrv");
   void * tizfsm_class = factory_new
     /* TIZ_CLASS_COMMENT: class type, class name, parent, size */
     (classOf (tizsrv), "tizfsm_class", classOf (tizsrv),
@@ -1307,8 +1310,8 @@ tiz_fsm_class_init (void * ap_tos, void * ap_hdl)
 void *
 tiz_fsm_init (void * ap_tos, void * ap_hdl)
 {
-  void * tizsrv = tiz_get_type (ap_hdl, "tizsrv");
-  void * tizfsm_class = tiz_get_type (ap_hdl, "tizfsm_class");
+  void * tizsrv = TIZ_GET_TYPE (ap_hdl, "tizsrv");
+  void * tizfsm_class = TIZ_GET_TYPE (ap_hdl, "tizfsm_class");
   TIZ_LOG_CLASS (tizfsm_class);
   void * tizfsm = factory_new
     /* TIZ_CLASS_COMMENT: class type, class name, parent, size */
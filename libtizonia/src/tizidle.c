@@ -51,14 +51,15 @@
 static void *
 idle_ctor (void * ap_obj, va_list * app)
 {
-  tiz_idle_t * p_obj = super_ctor (typeOf (ap_obj, "tizidle"), ap_obj, app);
+  tiz_idle_t * p_obj = super_ctor (TIZ_TYPE_OF (ap_obj, "tizidle"), ap_obj,
+                                   app);
   return p_obj;
 }
 
 static void *
 idle_dtor (void * ap_obj)
 {
-  return super_dtor (typeOf (ap_obj, "tizidle"), ap_obj);
+  return super_dtor (TIZ_TYPE_OF (ap_obj, "tizidle"), ap_obj);
 }
 
 static OMX_ERRORTYPE
@@ -258,8 +259,8 @@ idle_state_set (const void * ap_obj, OMX_HANDLETYPE ap_hdl,
         }
     }
 
-  return tiz_state_super_state_set (typeOf (ap_obj, "tizidle"), ap_obj, ap_hdl,
-                                    a_cmd, a_param1, ap_cmd_data);
+  return tiz_state_super_state_set (TIZ_TYPE_OF (ap_obj, "tizidle"), ap_obj,
+                                    ap_hdl, a_cmd, a_param1, ap_cmd_data);
 }
 
 /*
@@ -270,7 +271,7 @@ static void *
 idle_class_ctor (void * ap_obj, va_list * app)
 {
   /* NOTE: Class methods might be added in the future. None for now. */
-  return super_ctor (typeOf (ap_obj, "tizidle_class"), ap_obj, app);
+  return super_ctor (TIZ_TYPE_OF (ap_obj, "tizidle_class"), ap_obj, app);
 }
 
 /*
@@ -280,7 +281,7 @@ idle_class_ctor (void * ap_obj, va_list * app)
 void *
 tiz_idle_class_init (void * ap_tos, void * ap_hdl)
 {
-  void * tizstate = tiz_get_type (ap_hdl, "tizstate");
+  void * tizstate = TIZ_GET_TYPE (ap_hdl, "tizstate");
   void * tizidle_class = factory_new (
     classOf (tizstate), "tizidle_class", classOf (tizstate),
     sizeof (tiz_idle_class_t), ap_tos, ap_hdl, ctor, idle_class_ctor, 0);
@@ -290,8 +291,8 @@ tiz_idle_class_init (void * ap_tos, void * ap_hdl)
 void *
 tiz_idle_init (void * ap_tos, void * ap_hdl)
 {
-  void * tizstate = tiz_get_type (ap_hdl, "tizstate");
-  void * tizidle_class = tiz_get_type (ap_hdl, "tizidle_class");
+  void * tizstate = TIZ_GET_TYPE (ap_hdl, "tizstate");
+  void * tizidle_class = TIZ_GET_TYPE (ap_hdl, "tizidle_class");
   TIZ_LOG_CLASS (tizidle_class);
   void * tizidle = factory_new (
     tizidle_class, "tizidle", tizstate, sizeof (tiz_idle_t), ap_tos, ap_hdl,
@@ -48,14 +48,14 @@ static void *
 idletoexecuting_ctor (void * ap_obj, va_list * app)
 {
   tiz_idletoexecuting_t * p_obj
-    = super_ctor (typeOf (ap_obj, "tizidletoexecuting"), ap_obj, app);
+    = super_ctor (TIZ_TYPE_OF (ap_obj, "tizidletoexecuting"), ap_obj, app);
   return p_obj;
 }
 
 static void *
 idletoexecuting_dtor (void * ap_obj)
 {
-  return super_dtor (typeOf (ap_obj, "tizidletoexecuting"), ap_obj);
+  return super_dtor (TIZ_TYPE_OF (ap_obj, "tizidletoexecuting"), ap_obj);
 }
 
 /*
@@ -135,8 +135,9 @@ idletoexecuting_trans_complete (const void * ap_obj, OMX_PTR ap_servant,
   /* NOTE: Resetting of the OMX_PORTSTATUS_ACCEPTBUFFEREXCHANGE flag takes
      place in the tiz_state base class */
 
-  return tiz_state_super_trans_complete (typeOf (ap_obj, "tizidletoexecuting"),
-                                         ap_obj, ap_servant, a_new_state);
+  return tiz_state_super_trans_complete (
+    TIZ_TYPE_OF (ap_obj, "tizidletoexecuting"), ap_obj, ap_servant,
+    a_new_state);
 }
 
 static OMX_ERRORTYPE
@@ -156,8 +157,8 @@ idletoexecuting_tunneled_ports_status_update (void * ap_obj)
          * 'tiz_state_state_set' function of the tiz_state_t base class (note
          * we are passing 'tizidle' as 1st parameter */
         TIZ_TRACE (p_hdl, "kernel ready to exchange buffers");
-        return tiz_state_super_state_set (typeOf (ap_obj, "tizidle"), ap_obj,
-                                          p_hdl, OMX_CommandStateSet,
+        return tiz_state_super_state_set (TIZ_TYPE_OF (ap_obj, "tizidle"),
+                                          ap_obj, p_hdl, OMX_CommandStateSet,
                                           OMX_StateExecuting, NULL);
       }
   }
@@ -173,7 +174,8 @@ static void *
 idletoexecuting_class_ctor (void * ap_obj, va_list * app)
 {
   /* NOTE: Class methods might be added in the future. None for now. */
-  return super_ctor (typeOf (ap_obj, "tizidletoexecuting_class"), ap_obj, app);
+  return super_ctor (TIZ_TYPE_OF (ap_obj, "tizidletoexecuting_class"), ap_obj,
+                     app);
 }
 
 /*
@@ -183,7 +185,7 @@ idletoexecuting_class_ctor (void * ap_obj, va_list * app)
 void *
 tiz_idletoexecuting_class_init (void * ap_tos, void * ap_hdl)
 {
-  void * tizidle = tiz_get_type (ap_hdl, "tizidle");
+  void * tizidle = TIZ_GET_TYPE (ap_hdl, "tizidle");
   void * tizidletoexecuting_class
     = factory_new (classOf (tizidle), "tizidletoexecuting_class",
                    classOf (tizidle), sizeof (tiz_idletoexecuting_class_t),
@@ -194,9 +196,9 @@ tiz_idletoexecuting_class_init (void * ap_tos, void * ap_hdl)
 void *
 tiz_idletoexecuting_init (void * ap_tos, void * ap_hdl)
 {
-  void * tizidle = tiz_get_type (ap_hdl, "tizidle");
+  void * tizidle = TIZ_GET_TYPE (ap_hdl, "tizidle");
   void * tizidletoexecuting_class
-    = tiz_get_type (ap_hdl, "tizidletoexecuting_class");
+    = TIZ_GET_TYPE (ap_hdl, "tizidletoexecuting_class");
   TIZ_LOG_CLASS (tizidletoexecuting_class);
   void * tizidletoexecuting = factory_new (
     tizidletoexecuting_class, "tizidletoexecuting", tizidle,
@@ -47,14 +47,14 @@ static void *
 idletoloaded_ctor (void * ap_obj, va_list * app)
 {
   tiz_idletoloaded_t * p_obj
-    = super_ctor (typeOf (ap_obj, "tizidletoloaded"), ap_obj, app);
+    = super_ctor (TIZ_TYPE_OF (ap_obj, "tizidletoloaded"), ap_obj, app);
   return p_obj;
 }
 
 static void *
 idletoloaded_dtor (void * ap_obj)
 {
-  return super_dtor (typeOf (ap_obj, "tizidletoloaded"), ap_obj);
+  return super_dtor (TIZ_TYPE_OF (ap_obj, "tizidletoloaded"), ap_obj);
 }
 
 /*
@@ -126,8 +126,8 @@ idletoloaded_trans_complete (const void * ap_obj, OMX_PTR ap_servant,
   TIZ_TRACE (handleOf (ap_servant), "Trans complete to state [%s]...",
              tiz_fsm_state_to_str ((tiz_fsm_state_id_t) a_new_state));
   assert (OMX_StateLoaded == a_new_state);
-  return tiz_state_super_trans_complete (typeOf (ap_obj, "tizidletoloaded"),
-                                         ap_obj, ap_servant, a_new_state);
+  return tiz_state_super_trans_complete (
+    TIZ_TYPE_OF (ap_obj, "tizidletoloaded"), ap_obj, ap_servant, a_new_state);
 }
 
 /*
@@ -138,7 +138,8 @@ static void *
 idletoloaded_class_ctor (void * ap_obj, va_list * app)
 {
   /* NOTE: Class methods might be added in the future. None for now. */
-  return super_ctor (typeOf (ap_obj, "tizidletoloaded_class"), ap_obj, app);
+  return super_ctor (TIZ_TYPE_OF (ap_obj, "tizidletoloaded_class"), ap_obj,
+                     app);
 }
 
 /*
@@ -148,7 +149,7 @@ idletoloaded_class_ctor (void * ap_obj, va_list * app)
 void *
 tiz_idletoloaded_class_init (void * ap_tos, void * ap_hdl)
 {
-  void * tizidle = tiz_get_type (ap_hdl, "tizidle");
+  void * tizidle = TIZ_GET_TYPE (ap_hdl, "tizidle");
   void * tizidletoloaded_class
     = factory_new (classOf (tizidle), "tizidletoloaded_class",
                    classOf (tizidle), sizeof (tiz_idletoloaded_class_t), ap_tos,
@@ -159,8 +160,8 @@ tiz_idletoloaded_class_init (void * ap_tos, void * ap_hdl)
 void *
 tiz_idletoloaded_init (void * ap_tos, void * ap_hdl)
 {
-  void * tizidle = tiz_get_type (ap_hdl, "tizidle");
-  void * tizidletoloaded_class = tiz_get_type (ap_hdl, "tizidletoloaded_class");
+  void * tizidle = TIZ_GET_TYPE (ap_hdl, "tizidle");
+  void * tizidletoloaded_class = TIZ_GET_TYPE (ap_hdl, "tizidletoloaded_class");
   TIZ_LOG_CLASS (tizidletoloaded_class);
   void * tizidletoloaded = factory_new (
     tizidletoloaded_class, "tizidletoloaded", tizidle,
@@ -51,7 +51,7 @@ static void *
 imageport_ctor (void * ap_obj, va_list * app)
 {
   tiz_imageport_t * p_obj
-    = super_ctor (typeOf (ap_obj, "tizimageport"), ap_obj, app);
+    = super_ctor (TIZ_TYPE_OF (ap_obj, "tizimageport"), ap_obj, app);
   OMX_IMAGE_PORTDEFINITIONTYPE * p_portdef = NULL;
   OMX_IMAGE_CODINGTYPE * p_encodings = NULL;
   OMX_COLOR_FORMATTYPE * p_formats = NULL;
@@ -121,7 +121,7 @@ imageport_dtor (void * ap_obj)
   tiz_vector_clear (p_obj->p_color_formats_);
   tiz_vector_destroy (p_obj->p_color_formats_);
 
-  return super_dtor (typeOf (ap_obj, "tizimageport"), ap_obj);
+  return super_dtor (TIZ_TYPE_OF (ap_obj, "tizimageport"), ap_obj);
 }
 
 /*
@@ -181,8 +181,8 @@ imageport_GetParameter (const void * ap_obj, OMX_HANDLETYPE ap_hdl,
       default:
         {
           /* Try the parent's indexes */
-          return super_GetParameter (typeOf (ap_obj, "tizimageport"), ap_obj,
-                                     ap_hdl, a_index, ap_struct);
+          return super_GetParameter (TIZ_TYPE_OF (ap_obj, "tizimageport"),
+                                     ap_obj, ap_hdl, a_index, ap_struct);
         }
     };
 
@@ -268,8 +268,8 @@ imageport_SetParameter (const void * ap_obj, OMX_HANDLETYPE ap_hdl,
       default:
         {
           /* Try the parent's indexes */
-          return super_SetParameter (typeOf (ap_obj, "tizimageport"), ap_obj,
-                                     ap_hdl, a_index, ap_struct);
+          return super_SetParameter (TIZ_TYPE_OF (ap_obj, "tizimageport"),
+                                     ap_obj, ap_hdl, a_index, ap_struct);
         }
     };
 
@@ -284,7 +284,7 @@ static void *
 imageport_class_ctor (void * ap_obj, va_list * app)
 {
   /* NOTE: Class methods might be added in the future. None for now. */
-  return super_ctor (typeOf (ap_obj, "tizimageport_class"), ap_obj, app);
+  return super_ctor (TIZ_TYPE_OF (ap_obj, "tizimageport_class"), ap_obj, app);
 }
 
 /*
@@ -294,7 +294,7 @@ imageport_class_ctor (void * ap_obj, va_list * app)
 void *
 tiz_imageport_class_init (void * ap_tos, void * ap_hdl)
 {
-  void * tizport = tiz_get_type (ap_hdl, "tizport");
+  void * tizport = TIZ_GET_TYPE (ap_hdl, "tizport");
   void * tizimageport_class = factory_new
     /* TIZ_CLASS_COMMENT: class type, class name, parent, size */
     (classOf (tizport), "tizimageport_class", classOf (tizport),
@@ -311,8 +311,8 @@ tiz_imageport_class_init (void * ap_tos, void * ap_hdl)
 void *
 tiz_imageport_init (void * ap_tos, void * ap_hdl)
 {
-  void * tizport = tiz_get_type (ap_hdl, "tizport");
-  void * tizimageport_class = tiz_get_type (ap_hdl, "tizimageport_class");
+  void * tizport = TIZ_GET_TYPE (ap_hdl, "tizport");
+  void * tizimageport_class = TIZ_GET_TYPE (ap_hdl, "tizimageport_class");
   TIZ_LOG_CLASS (tizimageport_class);
   void * tizimageport = factory_new
     /* TIZ_CLASS_COMMENT: class type, class name, parent, size */
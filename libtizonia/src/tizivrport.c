@@ -51,7 +51,7 @@ static void *
 ivrport_ctor (void * ap_obj, va_list * app)
 {
   tiz_ivrport_t * p_obj
-    = super_ctor (typeOf (ap_obj, "tizivrport"), ap_obj, app);
+    = super_ctor (TIZ_TYPE_OF (ap_obj, "tizivrport"), ap_obj, app);
   tiz_port_t * p_base = ap_obj;
 
   tiz_port_register_index (p_obj, OMX_IndexConfigCommonRotate);
@@ -100,7 +100,7 @@ ivrport_ctor (void * ap_obj, va_list * app)
 static void *
 ivrport_dtor (void * ap_obj)
 {
-  return super_dtor (typeOf (ap_obj, "tizivrport"), ap_obj);
+  return super_dtor (TIZ_TYPE_OF (ap_obj, "tizivrport"), ap_obj);
 }
 
 /*
@@ -161,8 +161,8 @@ ivrport_GetConfig (const void * ap_obj, OMX_HANDLETYPE ap_hdl,
       default:
         {
           /* Try the parent's indexes */
-          return super_GetConfig (typeOf (ap_obj, "tizivrport"), ap_obj, ap_hdl,
-                                  a_index, ap_struct);
+          return super_GetConfig (TIZ_TYPE_OF (ap_obj, "tizivrport"), ap_obj,
+                                  ap_hdl, a_index, ap_struct);
         }
     };
 
@@ -227,8 +227,8 @@ ivrport_SetConfig (const void * ap_obj, OMX_HANDLETYPE ap_hdl,
       default:
         {
           /* Try the parent's indexes */
-          return super_SetConfig (typeOf (ap_obj, "tizivrport"), ap_obj, ap_hdl,
-                                  a_index, ap_struct);
+          return super_SetConfig (TIZ_TYPE_OF (ap_obj, "tizivrport"), ap_obj,
+                                  ap_hdl, a_index, ap_struct);
         }
     };
 
@@ -270,7 +270,7 @@ static void *
 ivrport_class_ctor (void * ap_obj, va_list * app)
 {
   /* NOTE: Class methods might be added in the future. None for now. */
-  return super_ctor (typeOf (ap_obj, "tizivrport_class"), ap_obj, app);
+  return super_ctor (TIZ_TYPE_OF (ap_obj, "tizivrport_class"), ap_obj, app);
 }
 
 /*
@@ -280,7 +280,7 @@ ivrport_class_ctor (void * ap_obj, va_list * app)
 void *
 tiz_ivrport_class_init (void * ap_tos, void * ap_hdl)
 {
-  void * tizvideoport = tiz_get_type (ap_hdl, "tizvideoport");
+  void * tizvideoport = TIZ_GET_TYPE (ap_hdl, "tizvideoport");
   void * tizivrport_class = factory_new
     /* TIZ_CLASS_COMMENT: class type, class name, parent, size */
     (classOf (tizvideoport), "tizivrport_class", classOf (tizvideoport),
@@ -297,8 +297,8 @@ tiz_ivrport_class_init (void * ap_tos, void * ap_hdl)
 void *
 tiz_ivrport_init (void * ap_tos, void * ap_hdl)
 {
-  void * tizvideoport = tiz_get_type (ap_hdl, "tizvideoport");
-  void * tizivrport_class = tiz_get_type (ap_hdl, "tizivrport_class");
+  void * tizvideoport = TIZ_GET_TYPE (ap_hdl, "tizvideoport");
+  void * tizivrport_class = TIZ_GET_TYPE (ap_hdl, "tizivrport_class");
   TIZ_LOG_CLASS (tizivrport_class);
   void * tizivrport = factory_new
     /* TIZ_CLASS_COMMENT: class type, class name, parent, size */
@@ -41,6 +41,7 @@
 #include "tizconfigport.h"
 #include "tizport-macros.h"
 #include "tizutils.h"
+#include "tizprobe.h"
 
 #include "tizkernel.h"
 #include "tizkernel_decls.h"
@@ -127,9 +128,13 @@ init_ports_and_lists (void * ap_obj)
   tiz_check_omx_ret_oom (
     tiz_vector_init (&(p_obj->p_ports_), sizeof (OMX_PTR)));
   tiz_check_omx_ret_oom (
-    tiz_vector_init (&(p_obj->p_ingress_), sizeof (tiz_vector_t *)));
+    tiz_vector_init (&(p_obj->p_ingress_), sizeof (tiz_ring_t *)));
   tiz_check_omx_ret_oom (
-    tiz_vector_init (&(p_obj->p_egress_), sizeof (tiz_vector_t *)));
+    tiz_vector_init (&(p_obj->p_egress_), sizeof (tiz_ring_t *)));
+
+  tiz_check_omx_ret_oom (tiz_hmap_init (&(p_obj->p_index_map_), 32, NULL));
+  tiz_check_omx_ret_oom (
+    tiz_vector_init (&(p_obj->p_stats_), sizeof (tiz_krn_port_stats_t)));
 
   p_obj->p_cport_ = NULL;
   p_obj->p_proc_ = NULL;
@@ -147,6 +152,8 @@ init_ports_and_lists (void * ap_obj)
   p_obj->accept_use_buffer_notified_ = false;
   p_obj->accept_buffer_exchange_notified_ = false;
   p_obj->may_transition_exe2idle_notified_ = false;
+  p_obj->tap_calls_ = 0;
+  p_obj->tap_ns_ = 0;
 
   return OMX_ErrorNone;
 }
@@ -156,7 +163,7 @@ deinit_ports_and_lists (void * ap_obj)
 {
   tiz_krn_t * p_obj = ap_obj;
   OMX_PTR * pp_port = NULL;
-  tiz_vector_t * p_list = NULL;
+  tiz_ring_t * p_list = NULL;
 
   /* delete the config port */
   factory_delete (p_obj->p_cport_);
@@ -176,9 +183,8 @@ deinit_ports_and_lists (void * ap_obj)
   /* delete the ingress and egress lists */
   while (tiz_vector_length (p_obj->p_ingress_) > 0)
     {
-      p_list = *(tiz_vector_t **) tiz_vector_back (p_obj->p_ingress_);
-      tiz_vector_clear (p_list);
-      tiz_vector_destroy (p_list);
+      p_list = *(tiz_ring_t **) tiz_vector_back (p_obj->p_ingress_);
+      tiz_ring_destroy (p_list);
       tiz_vector_pop_back (p_obj->p_ingress_);
     }
   tiz_vector_destroy (p_obj->p_ingress_);
@@ -186,13 +192,18 @@ deinit_ports_and_lists (void * ap_obj)
 
   while (tiz_vector_length (p_obj->p_egress_) > 0)
     {
-      p_list = *(tiz_vector_t **) tiz_vector_back (p_obj->p_egress_);
-      tiz_vector_clear (p_list);
-      tiz_vector_destroy (p_list);
+      p_list = *(tiz_ring_t **) tiz_vector_back (p_obj->p_egress_);
+      tiz_ring_destroy (p_list);
       tiz_vector_pop_back (p_obj->p_egress_);
     }
   tiz_vector_destroy (p_obj->p_egress_);
   p_obj->p_egress_ = NULL;
+
+  tiz_hmap_destroy (p_obj->p_index_map_);
+  p_obj->p_index_map_ = NULL;
+
+  tiz_vector_destroy (p_obj->p_stats_);
+  p_obj->p_stats_ = NULL;
 }
 
 static OMX_ERRORTYPE
@@ -252,7 +263,7 @@ apply_slaving_behaviour (const tiz_krn_t * ap_krn, OMX_HANDLETYPE ap_hdl,
 static void *
 krn_ctor (void * ap_obj, va_list * app)
 {
-  tiz_krn_t * p_obj = super_ctor (typeOf (ap_obj, "tizkrn"), ap_obj, app);
+  tiz_krn_t * p_obj = super_ctor (TIZ_TYPE_OF (ap_obj, "tizkrn"), ap_obj, app);
   tiz_check_omx_ret_null (init_ports_and_lists (p_obj));
   return p_obj;
 }
@@ -261,7 +272,7 @@ static void *
 krn_dtor (void * ap_obj)
 {
   deinit_ports_and_lists (ap_obj);
-  return super_dtor (typeOf (ap_obj, "tizkrn"), ap_obj);
+  return super_dtor (TIZ_TYPE_OF (ap_obj, "tizkrn"), ap_obj);
 }
 
 /*
@@ -672,6 +683,11 @@ krn_UseBuffer (const void * ap_obj, OMX_HANDLETYPE ap_hdl,
         return rc;
       }
 
+    if (TIZ_PORT_IS_POPULATED (p_port))
+      {
+        tiz_check_omx (reserve_buflsts (p_obj, a_pid));
+      }
+
     if (was_being_enabled && TIZ_PORT_IS_POPULATED (p_port))
       {
         tiz_check_omx (
@@ -737,6 +753,11 @@ krn_UseEGLImage (const void * ap_obj, OMX_HANDLETYPE ap_hdl,
         return rc;
       }
 
+    if (TIZ_PORT_IS_POPULATED (p_port))
+      {
+        tiz_check_omx (reserve_buflsts (p_obj, a_pid));
+      }
+
     if (was_being_enabled && TIZ_PORT_IS_POPULATED (p_port))
       {
         tiz_check_omx (
@@ -805,6 +826,11 @@ krn_AllocateBuffer (const void * ap_obj, OMX_HANDLETYPE ap_hdl,
         return rc;
       }
 
+    if (TIZ_PORT_IS_POPULATED (p_port))
+      {
+        tiz_check_omx (reserve_buflsts (p_obj, a_pid));
+      }
+
     if (was_being_enabled && TIZ_PORT_IS_POPULATED (p_port))
       {
         tiz_check_omx (
@@ -1014,6 +1040,8 @@ krn_allocate_resources (void * ap_obj, OMX_U32 a_pid)
               return rc;
             }
 
+          tiz_check_omx (reserve_buflsts (p_obj, pid));
+
           if (being_enabled && TIZ_PORT_IS_POPULATED_AND_ENABLED (p_port))
             {
               tiz_check_omx (
@@ -1118,10 +1146,12 @@ static OMX_ERRORTYPE
 krn_transfer_and_process (void * ap_obj, OMX_U32 a_pid)
 {
   tiz_krn_t * p_obj = ap_obj;
+  OMX_ERRORTYPE rc = OMX_ErrorNone;
   OMX_S32 nports = 0;
   OMX_PTR p_port = NULL;
   OMX_U32 pid = 0;
   OMX_S32 i = 0;
+  OMX_U64 start = 0;
 
   assert (ap_obj);
   nports = tiz_vector_length (p_obj->p_ports_);
@@ -1133,6 +1163,8 @@ krn_transfer_and_process (void * ap_obj, OMX_U32 a_pid)
       return OMX_ErrorBadPortIndex;
     }
 
+  start = tiz_monotonic_ns ();
+
   do
     {
       pid = ((OMX_ALL != a_pid) ? a_pid : i);
@@ -1142,13 +1174,18 @@ krn_transfer_and_process (void * ap_obj, OMX_U32 a_pid)
        * port isn't tunneled, or is disabled, etc. */
       tiz_port_update_tunneled_status (p_port,
                                        OMX_PORTSTATUS_ACCEPTBUFFEREXCHANGE);
-      tiz_check_omx (flush_egress (p_obj, pid, OMX_FALSE));
-      tiz_check_omx (propagate_ingress (p_obj, pid));
+      if (OMX_ErrorNone == (rc = flush_egress (p_obj, pid, OMX_FALSE)))
+        {
+          rc = propagate_ingress (p_obj, pid);
+        }
       i++;
     }
-  while (OMX_ALL == a_pid && i < nports);
+  while (OMX_ErrorNone == rc && OMX_ALL == a_pid && i < nports);
 
-  return OMX_ErrorNone;
+  p_obj->tap_calls_++;
+  p_obj->tap_ns_ += tiz_monotonic_ns () - start;
+
+  return rc;
 }
 
 static OMX_ERRORTYPE
@@ -1292,18 +1329,21 @@ krn_register_port (void * ap_obj, OMX_PTR ap_port, const bool ais_config)
     }
 
   {
-    /* Create the corresponding ingress and egress lists */
-    tiz_vector_t * p_in_list = NULL;
-    tiz_vector_t * p_out_list = NULL;
+    /* Create the corresponding ingress and egress lists; these are sized
+       when the port gets populated (see reserve_buflsts) */
+    tiz_ring_t * p_in_list = NULL;
+    tiz_ring_t * p_out_list = NULL;
     OMX_U32 pid = 0;
-    tiz_check_omx (
-      tiz_vector_init (&(p_in_list), sizeof (OMX_BUFFERHEADERTYPE *)));
+    tiz_check_omx (tiz_ring_init (&(p_in_list), 0));
     assert (p_in_list);
-    tiz_check_omx (
-      tiz_vector_init (&(p_out_list), sizeof (OMX_BUFFERHEADERTYPE *)));
+    tiz_check_omx (tiz_ring_init (&(p_out_list), 0));
     assert (p_out_list);
     tiz_check_omx (tiz_vector_push_back (p_obj->p_ingress_, &p_in_list));
     tiz_check_omx (tiz_vector_push_back (p_obj->p_egress_, &p_out_list));
+    {
+      const tiz_krn_port_stats_t stats = {0, 0, 0};
+      tiz_check_omx (tiz_vector_push_back (p_obj->p_stats_, (OMX_PTR) &stats));
+    }
 
     pid = tiz_vector_length (p_obj->p_ports_);
     tiz_port_set_index (ap_port, pid);
@@ -1408,19 +1448,60 @@ tiz_krn_get_port (const void * ap_obj, const OMX_U32 a_pid)
   return class->get_port (ap_obj, a_pid);
 }
 
+static tiz_krn_index_owner_t
+find_index_owner (const tiz_krn_t * ap_krn, const OMX_INDEXTYPE a_index)
+{
+  OMX_S32 i = 0;
+  OMX_S32 num_ports = 0;
+
+  if (OMX_ErrorNone == tiz_port_find_index (ap_krn->p_cport_, a_index))
+    {
+      return ETIZKrnIndexOwnerConfigPort;
+    }
+
+  num_ports = tiz_vector_length (ap_krn->p_ports_);
+  for (i = 0; i < num_ports; ++i)
+    {
+      if (OMX_ErrorNone == tiz_port_find_index (get_port (ap_krn, i), a_index))
+        {
+          return ETIZKrnIndexOwnerPortIndexInStruct;
+        }
+    }
+
+  return ETIZKrnIndexOwnerNone;
+}
+
 OMX_ERRORTYPE
 krn_find_managing_port (const tiz_krn_t * ap_krn, const OMX_INDEXTYPE a_index,
                         const OMX_PTR ap_struct, OMX_PTR * app_port)
 {
-  OMX_ERRORTYPE rc = OMX_ErrorUnsupportedIndex;
-  OMX_PTR * pp_port = NULL;
-  OMX_U32 * p_port_index;
+  OMX_ERRORTYPE rc = OMX_ErrorNone;
+  tiz_krn_index_owner_t owner = ETIZKrnIndexOwnerNone;
+  OMX_U32 pid = 0;
 
   assert (ap_krn);
   assert (app_port);
   assert (ap_struct);
 
-  if (OMX_ErrorNone == tiz_port_find_index (ap_krn->p_cport_, a_index))
+  /* Indexes are resolved once, by scanning the ports, and then remembered;
+     ports only ever add indexes, so a resolution never becomes stale */
+  owner = (tiz_krn_index_owner_t) (uintptr_t) tiz_hmap_find (
+    ap_krn->p_index_map_, a_index);
+  if (ETIZKrnIndexOwnerNone == owner)
+    {
+      owner = find_index_owner (ap_krn, a_index);
+      if (ETIZKrnIndexOwnerNone == owner)
+        {
+          TIZ_TRACE (handleOf (ap_krn),
+                     "[%s] : Could not find the managing port...",
+                     tiz_idx_to_str (a_index));
+          return OMX_ErrorUnsupportedIndex;
+        }
+      tiz_check_omx (tiz_hmap_insert (ap_krn->p_index_map_, a_index,
+                                      (OMX_PTR) (uintptr_t) owner));
+    }
+
+  if (ETIZKrnIndexOwnerConfigPort == owner)
     {
       *app_port = ap_krn->p_cport_;
       TIZ_TRACE (handleOf (ap_krn),
@@ -1429,46 +1510,19 @@ krn_find_managing_port (const tiz_krn_t * ap_krn, const OMX_INDEXTYPE a_index,
                  tiz_idx_to_str (a_index));
       return OMX_ErrorNone;
     }
-  else
-    {
-      OMX_S32 i = 0;
-      OMX_S32 num_ports = tiz_vector_length (ap_krn->p_ports_);
-      for (i = 0; i < num_ports; ++i)
-        {
-          pp_port = tiz_vector_at (ap_krn->p_ports_, i);
-          if (OMX_ErrorNone == tiz_port_find_index (*pp_port, a_index))
-            {
-              rc = OMX_ErrorNone;
-              break;
-            }
-        }
-
-      if (OMX_ErrorNone == rc)
-        {
-          /* Now we retrieve the port index from the struct. */
-          /* TODO: This is not the best way to do this */
-          p_port_index = (OMX_U32 *) ap_struct
-                         + sizeof (OMX_U32) / sizeof (OMX_U32)
-                         + sizeof (OMX_VERSIONTYPE) / sizeof (OMX_U32);
-
-          if (OMX_ErrorNone != (rc = check_pid (ap_krn, *p_port_index)))
-            {
-              return rc;
-            }
-
-          TIZ_TRACE (handleOf (ap_krn), "[%s] : Found in port index [%d]...",
-                     tiz_idx_to_str (a_index), *p_port_index);
 
-          pp_port = tiz_vector_at (ap_krn->p_ports_, *p_port_index);
-          *app_port = *pp_port;
-          return rc;
-        }
+  /* All the per-port structures start with nSize, nVersion and nPortIndex */
+  pid = ((const OMX_PARAM_U32TYPE *) ap_struct)->nPortIndex;
+  if (OMX_ErrorNone != (rc = check_pid (ap_krn, pid)))
+    {
+      return rc;
     }
 
-  TIZ_TRACE (handleOf (ap_krn), "[%s] : Could not find the managing port...",
-             tiz_idx_to_str (a_index));
+  TIZ_TRACE (handleOf (ap_krn), "[%s] : Found in port index [%d]...",
+             tiz_idx_to_str (a_index), pid);
 
-  return rc;
+  *app_port = get_port (ap_krn, pid);
+  return OMX_ErrorNone;
 }
 
 OMX_ERRORTYPE
@@ -1589,7 +1643,7 @@ krn_select (const void * ap_obj, const OMX_U32 a_nports, tiz_pd_set_t * ap_set)
   const tiz_krn_t * p_obj = ap_obj;
   OMX_S32 i = 0;
   OMX_S32 nports = 0;
-  tiz_vector_t * p_list = NULL;
+  tiz_ring_t * p_list = NULL;
 
   assert (ap_obj);
   assert (ap_set);
@@ -1605,7 +1659,7 @@ krn_select (const void * ap_obj, const OMX_U32 a_nports, tiz_pd_set_t * ap_set)
   for (i = 0; i < nports; ++i)
     {
       p_list = get_ingress_lst (p_obj, i);
-      if (tiz_vector_length (p_list) > 0)
+      if (tiz_ring_length (p_list) > 0)
         {
           TIZ_PD_SET (i, ap_set);
         }
@@ -1639,7 +1693,7 @@ krn_claim_buffer (const void * ap_obj, const OMX_U32 a_pid, const OMX_U32 a_pos,
   tiz_krn_t * p_obj = (tiz_krn_t *) ap_obj;
   OMX_ERRORTYPE rc = OMX_ErrorNone;
   OMX_BUFFERHEADERTYPE * p_hdr = NULL;
-  tiz_vector_t * p_list = NULL;
+  tiz_ring_t * p_list = NULL;
   OMX_PTR p_port = NULL;
 
   assert (ap_obj);
@@ -1665,10 +1719,10 @@ krn_claim_buffer (const void * ap_obj, const OMX_U32 a_pid, const OMX_U32 a_pos,
   p_list = get_ingress_lst (p_obj, a_pid);
 
   /* Ingress list's size shall not be larger than the port's buffer count */
-  assert (tiz_vector_length (p_list) <= tiz_port_buffer_count (p_port));
+  assert (tiz_ring_length (p_list) <= tiz_port_buffer_count (p_port));
 
   /* Only try to retrieve the buffer if that position exists in the list */
-  if (a_pos < tiz_vector_length (p_list))
+  if (a_pos < tiz_ring_length (p_list))
     {
       OMX_DIRTYPE pdir = OMX_DirMax;
 
@@ -1679,7 +1733,7 @@ krn_claim_buffer (const void * ap_obj, const OMX_U32 a_pid, const OMX_U32 a_pos,
       TIZ_TRACE (handleOf (p_obj),
                  "port's [%d] HEADER [%p] BUFFER [%p] ingress "
                  "list length [%d]...",
-                 a_pid, p_hdr, p_hdr->pBuffer, tiz_vector_length (p_list));
+                 a_pid, p_hdr, p_hdr->pBuffer, tiz_ring_length (p_list));
 
       pdir = tiz_port_dir (p_port);
 
@@ -1700,11 +1754,24 @@ krn_claim_buffer (const void * ap_obj, const OMX_U32 a_pid, const OMX_U32 a_pos,
         }
 
       /* ... and delete it from the list */
-      tiz_vector_erase (p_list, a_pos, 1);
+      tiz_ring_erase (p_list, a_pos);
 
       /* Now increment by one the claimed buffers count on this port */
       (void) TIZ_PORT_INC_CLAIMED_COUNT (p_port);
 
+      {
+        tiz_krn_port_stats_t * p_stats = get_port_stats (p_obj, a_pid);
+        p_stats->claimed++;
+        if (OMX_DirInput == pdir)
+          {
+            p_stats->bytes += p_hdr->nFilledLen;
+          }
+      }
+
+      tiz_tracer_instant ("buffer", "claim", (uintptr_t) p_hdr, a_pid);
+      TIZ_PROBE4 (buffer__claim, handleOf (p_obj), a_pid, p_hdr,
+                  p_hdr->nFilledLen);
+
       /* ...and if its an input buffer, mark the header, if any marks
        * available... */
       if (OMX_DirInput == pdir)
@@ -1763,7 +1830,7 @@ krn_release_buffer (const void * ap_obj, const OMX_U32 a_pid,
                     OMX_BUFFERHEADERTYPE * ap_hdr)
 {
   tiz_krn_t * p_obj = (tiz_krn_t *) ap_obj;
-  tiz_vector_t * p_list = NULL;
+  tiz_ring_t * p_list = NULL;
   OMX_PTR p_port = NULL;
 
   assert (ap_obj);
@@ -1786,9 +1853,22 @@ krn_release_buffer (const void * ap_obj, const OMX_U32 a_pid,
   p_list = get_egress_lst (p_obj, a_pid);
 
   TIZ_TRACE (handleOf (p_obj), "HEADER [%p] pid [%d] egress length [%d]...",
-             ap_hdr, a_pid, tiz_vector_length (p_list));
+             ap_hdr, a_pid, tiz_ring_length (p_list));
+
+  assert (tiz_ring_length (p_list) < tiz_port_buffer_count (p_port));
+
+  {
+    tiz_krn_port_stats_t * p_stats = get_port_stats (p_obj, a_pid);
+    p_stats->released++;
+    if (OMX_DirOutput == tiz_port_dir (p_port))
+      {
+        p_stats->bytes += ap_hdr->nFilledLen;
+      }
+  }
 
-  assert (tiz_vector_length (p_list) < tiz_port_buffer_count (p_port));
+  tiz_tracer_instant ("buffer", "release", (uintptr_t) ap_hdr, a_pid);
+  TIZ_PROBE4 (buffer__release, handleOf (p_obj), a_pid, ap_hdr,
+              ap_hdr->nFilledLen);
 
   return enqueue_callback_msg (p_obj, ap_hdr, a_pid, tiz_port_dir (p_port));
 }
@@ -2118,6 +2198,63 @@ tiz_krn_clear_metadata (void * ap_obj)
   return class->clear_metadata (ap_obj);
 }
 
+OMX_ERRORTYPE
+tiz_krn_get_perf_stats (const void * ap_obj,
+                        OMX_TIZONIA_PERFSTATSTYPE * ap_stats)
+{
+  const tiz_krn_t * p_obj = ap_obj;
+  OMX_S32 nports = 0;
+  OMX_S32 i = 0;
+
+  assert (p_obj);
+  assert (ap_stats);
+
+  nports = tiz_vector_length (p_obj->p_stats_);
+  if (OMX_ALL != ap_stats->nPortIndex
+      && check_pid (p_obj, ap_stats->nPortIndex) != OMX_ErrorNone)
+    {
+      return OMX_ErrorBadPortIndex;
+    }
+
+  for (i = 0; i < nports; ++i)
+    {
+      if (OMX_ALL == ap_stats->nPortIndex
+          || ap_stats->nPortIndex == (OMX_U32) i)
+        {
+          const tiz_krn_port_stats_t * p_stats = get_port_stats (p_obj, i);
+          ap_stats->nBuffersClaimed += p_stats->claimed;
+          ap_stats->nBuffersReleased += p_stats->released;
+          ap_stats->nBytes += p_stats->bytes;
+        }
+    }
+
+  ap_stats->nTransferAndProcessCalls += p_obj->tap_calls_;
+  ap_stats->nTransferAndProcessNs += p_obj->tap_ns_;
+
+  return OMX_ErrorNone;
+}
+
+void
+tiz_krn_reset_perf_stats (void * ap_obj)
+{
+  tiz_krn_t * p_obj = ap_obj;
+  OMX_S32 nports = 0;
+  OMX_S32 i = 0;
+
+  assert (p_obj);
+
+  nports = tiz_vector_length (p_obj->p_stats_);
+  for (i = 0; i < nports; ++i)
+    {
+      tiz_krn_port_stats_t * p_stats = get_port_stats (p_obj, i);
+      p_stats->claimed = 0;
+      p_stats->released = 0;
+      p_stats->bytes = 0;
+    }
+  p_obj->tap_calls_ = 0;
+  p_obj->tap_ns_ = 0;
+}
+
 static OMX_ERRORTYPE
 krn_store_metadata (void * ap_obj,
                     const OMX_CONFIG_METADATAITEMTYPE * ap_meta_item)
@@ -2212,7 +2349,7 @@ static void *
 krn_class_ctor (void * ap_obj, va_list * app)
 {
   tiz_krn_class_t * p_obj
-    = super_ctor (typeOf (ap_obj, "tizkrn_class"), ap_obj, app);
+    = super_ctor (TIZ_TYPE_OF (ap_obj, "tizkrn_class"), ap_obj, app);
   typedef void (*voidf) ();
   voidf selector = NULL;
   va_list ap;
@@ -2298,7 +2435,7 @@ krn_class_ctor (void * ap_obj, va_list * app)
 void *
 tiz_krn_class_init (void * ap_tos, void * ap_hdl)
 {
-  void * tizsrv = tiz_get_type (ap_hdl, "tizsrv");
+  void * tizsrv = TIZ_GET_TYPE (ap_hdl, "tizsrv");
   void * tizkrn_class = factory_new
     /* TIZ_CLASS_COMMENT: class type, class name, parent, size */
     (classOf (tizsrv), "tizkrn_class", classOf (tizsrv),
@@ -2315,8 +2452,8 @@ tiz_krn_class_init (void * ap_tos, void * ap_hdl)
 void *
 tiz_krn_init (void * ap_tos, void * ap_hdl)
 {
-  void * tizsrv = tiz_get_type (ap_hdl, "tizsrv");
-  void * tizkrn_class = tiz_get_type (ap_hdl, "tizkrn_class");
+  void * tizsrv = TIZ_GET_TYPE (ap_hdl, "tizsrv");
+  void * tizkrn_class = TIZ_GET_TYPE (ap_hdl, "tizkrn_class");
   TIZ_LOG_CLASS (tizkrn_class);
   void * tizkrn = factory_new
     /* TIZ_CLASS_COMMENT: class type, class name, parent, size */
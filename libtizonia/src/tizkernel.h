@@ -44,6 +44,7 @@ extern "C" {
 
 #include <OMX_Core.h>
 #include <OMX_Component.h>
+#include <OMX_TizoniaExt.h>
 
 #include "tizutils.h"
 
@@ -142,6 +143,32 @@ OMX_ERRORTYPE
 tiz_krn_SetConfig_internal (const void * ap_obj, OMX_HANDLETYPE ap_hdl,
                             OMX_INDEXTYPE a_index, OMX_PTR ap_struct);
 
+/**
+ * Add the kernel's performance counters (buffers claimed and released, bytes
+ * processed, time spent in transfer_and_process) to a stats structure.
+ *
+ * @ingroup tizkernel
+ *
+ * @param ap_obj The 'kernel' servant object.
+ * @param ap_stats The structure to be updated. Its nPortIndex selects the
+ * port whose buffer counters are added, or all of them if OMX_ALL.
+ * @return OMX_ErrorNone on success, OMX_ErrorBadPortIndex if nPortIndex does
+ * not name a port.
+ */
+OMX_ERRORTYPE
+tiz_krn_get_perf_stats (const void * ap_obj,
+                        OMX_TIZONIA_PERFSTATSTYPE * ap_stats);
+
+/**
+ * Reset the kernel's performance counters.
+ *
+ * @ingroup tizkernel
+ *
+ * @param ap_obj The 'kernel' servant object.
+ */
+void
+tiz_krn_reset_perf_stats (void * ap_obj);
+
 #define TIZ_KRN_MAY_INIT_ALLOC_PHASE(_p) \
   tiz_krn_get_restriction_status (_p, ETIZKrnMayInitiateAllocPhase)
 
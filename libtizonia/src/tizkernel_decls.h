@@ -105,6 +105,24 @@ struct tiz_krn_msg_str
   OMX_STRING str;
 };
 
+/* Value type of the kernel's index map: which port manages an index */
+typedef enum tiz_krn_index_owner tiz_krn_index_owner_t;
+enum tiz_krn_index_owner
+{
+  ETIZKrnIndexOwnerNone = 0,
+  ETIZKrnIndexOwnerConfigPort,
+  ETIZKrnIndexOwnerPortIndexInStruct /* the port named by nPortIndex */
+};
+
+/* Per-port performance counters */
+typedef struct tiz_krn_port_stats tiz_krn_port_stats_t;
+struct tiz_krn_port_stats
+{
+  OMX_U64 claimed;
+  OMX_U64 released;
+  OMX_U64 bytes; /* claimed on input ports, released on output ports */
+};
+
 typedef struct tiz_krn tiz_krn_t;
 struct tiz_krn
 {
@@ -115,6 +133,10 @@ struct tiz_krn
   tiz_vector_t * p_egress_;
   OMX_PTR p_cport_;
   OMX_PTR p_proc_;
+  tiz_hmap_t * p_index_map_;
+  tiz_vector_t * p_stats_; /* one tiz_krn_port_stats_t per port */
+  OMX_U64 tap_calls_;
+  OMX_U64 tap_ns_;
   bool eos_;
   tiz_rm_t rm_;
   tiz_rm_proxy_callbacks_t rm_cbacks_;
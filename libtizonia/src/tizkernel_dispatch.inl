@@ -538,7 +538,7 @@ static OMX_ERRORTYPE dispatch_cb (void *ap_obj, OMX_PTR ap_msg)
   tiz_krn_msg_t *p_msg = ap_msg;
   tiz_krn_msg_callback_t *p_msg_cb = NULL;
   tiz_fsm_state_id_t now = (tiz_fsm_state_id_t)OMX_StateMax;
-  tiz_vector_t *p_egress_lst = NULL;
+  tiz_ring_t *p_egress_lst = NULL;
   OMX_PTR p_port = NULL;
   OMX_S32 claimed_count = 0;
   OMX_HANDLETYPE p_hdl = NULL;
@@ -585,7 +585,7 @@ static OMX_ERRORTYPE dispatch_cb (void *ap_obj, OMX_PTR ap_msg)
         {
           /* ...add the header to the egress list... */
           if (OMX_ErrorNone
-              != (rc = tiz_vector_push_back (p_egress_lst, &p_hdr)))
+              != (rc = tiz_ring_push_back (p_egress_lst, p_hdr)))
             {
               TIZ_ERROR (p_hdl,
                          "[%s] : Could not add HEADER [%p] "
@@ -611,7 +611,7 @@ static OMX_ERRORTYPE dispatch_cb (void *ap_obj, OMX_PTR ap_msg)
     }
 
   /* ...add the header to the egress list... */
-  if (OMX_ErrorNone != (rc = tiz_vector_push_back (p_egress_lst, &p_hdr)))
+  if (OMX_ErrorNone != (rc = tiz_ring_push_back (p_egress_lst, p_hdr)))
     {
       TIZ_ERROR (p_hdl,
                  "[%s] : Could not add header [%p] to "
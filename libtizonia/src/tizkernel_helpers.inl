@@ -94,26 +94,36 @@ static void preemption_complete (OMX_U32 rid, OMX_PTR ap_data)
   deliver_pluggable_event (rid, ap_data);
 }
 
-static inline tiz_vector_t *get_ingress_lst (const tiz_krn_t *ap_obj,
-                                             OMX_U32 a_pid)
+static inline tiz_ring_t *get_ingress_lst (const tiz_krn_t *ap_obj,
+                                           OMX_U32 a_pid)
 {
-  tiz_vector_t *p_list = NULL;
+  tiz_ring_t **pp_list = NULL;
   assert (ap_obj);
   /* Grab the port's ingress list */
-  p_list = tiz_vector_at (ap_obj->p_ingress_, a_pid);
-  assert (p_list && *(tiz_vector_t **)p_list);
-  return (*(tiz_vector_t **)p_list);
+  pp_list = tiz_vector_at (ap_obj->p_ingress_, a_pid);
+  assert (pp_list && *pp_list);
+  return *pp_list;
 }
 
-static inline tiz_vector_t *get_egress_lst (const tiz_krn_t *ap_obj,
-                                            OMX_U32 a_pid)
+static inline tiz_ring_t *get_egress_lst (const tiz_krn_t *ap_obj,
+                                          OMX_U32 a_pid)
 {
-  tiz_vector_t *p_list = NULL;
+  tiz_ring_t **pp_list = NULL;
   assert (ap_obj);
   /* Grab the port's egress list */
-  p_list = tiz_vector_at (ap_obj->p_egress_, a_pid);
-  assert (p_list && *(tiz_vector_t **)p_list);
-  return (*(tiz_vector_t **)p_list);
+  pp_list = tiz_vector_at (ap_obj->p_egress_, a_pid);
+  assert (pp_list && *pp_list);
+  return *pp_list;
+}
+
+static inline tiz_krn_port_stats_t *get_port_stats (const tiz_krn_t *ap_obj,
+                                                    OMX_U32 a_pid)
+{
+  tiz_krn_port_stats_t *p_stats = NULL;
+  assert (ap_obj);
+  p_stats = tiz_vector_at (ap_obj->p_stats_, a_pid);
+  assert (p_stats);
+  return p_stats;
 }
 
 static inline OMX_PTR get_port (const tiz_krn_t *ap_obj, const OMX_U32 a_pid)
@@ -126,71 +136,58 @@ static inline OMX_PTR get_port (const tiz_krn_t *ap_obj, const OMX_U32 a_pid)
   return *pp_port;
 }
 
-static inline OMX_BUFFERHEADERTYPE *get_header (const tiz_vector_t *ap_list,
+static inline OMX_BUFFERHEADERTYPE *get_header (const tiz_ring_t *ap_list,
                                                 OMX_U32 a_index)
 {
-  OMX_BUFFERHEADERTYPE **pp_hdr = NULL;
+  OMX_BUFFERHEADERTYPE *p_hdr = NULL;
   assert (ap_list);
-  assert (a_index < tiz_vector_length (ap_list));
+  assert (a_index < tiz_ring_length (ap_list));
   /* Retrieve the header... */
-  pp_hdr = tiz_vector_at (ap_list, a_index);
-  assert (pp_hdr && *pp_hdr);
-  return *pp_hdr;
+  p_hdr = tiz_ring_at (ap_list, a_index);
+  assert (p_hdr);
+  return p_hdr;
 }
 
 static OMX_S32 move_to_ingress (void *ap_obj, OMX_U32 a_pid)
 {
-
   tiz_krn_t *p_obj = ap_obj;
-  tiz_vector_t *p_elist = NULL;
-  tiz_vector_t *p_ilist = NULL;
-  const OMX_S32 nports = tiz_vector_length (p_obj->p_ports_);
-  OMX_ERRORTYPE rc = OMX_ErrorNone;
+  tiz_ring_t *p_elist = NULL;
+  tiz_ring_t *p_ilist = NULL;
 
-  assert (a_pid < nports);
+  assert (a_pid < tiz_vector_length (p_obj->p_ports_));
 
-  p_elist = tiz_vector_at (p_obj->p_egress_, a_pid);
-  p_ilist = tiz_vector_at (p_obj->p_ingress_, a_pid);
-  assert (p_elist && *(tiz_vector_t **)p_elist);
-  p_elist = *(tiz_vector_t **)p_elist;
-  assert (p_ilist && *(tiz_vector_t **)p_elist);
-  p_ilist = *(tiz_vector_t **)p_ilist;
-  rc = tiz_vector_append (p_ilist, p_elist);
-  tiz_vector_clear (p_elist);
+  p_elist = get_egress_lst (p_obj, a_pid);
+  p_ilist = get_ingress_lst (p_obj, a_pid);
 
-  if (OMX_ErrorNone != rc)
+  if (OMX_ErrorNone != tiz_ring_append (p_ilist, p_elist))
     {
+      tiz_ring_clear (p_elist);
       return -1;
     }
+  tiz_ring_clear (p_elist);
 
-  return tiz_vector_length (p_ilist);
+  return tiz_ring_length (p_ilist);
 }
 
 static OMX_S32 move_to_egress (void *ap_obj, OMX_U32 a_pid)
 {
   tiz_krn_t *p_obj = ap_obj;
-  const OMX_S32 nports = tiz_vector_length (p_obj->p_ports_);
-  tiz_vector_t *p_elist = NULL;
-  tiz_vector_t *p_ilist = NULL;
-  OMX_ERRORTYPE rc = OMX_ErrorNone;
+  tiz_ring_t *p_elist = NULL;
+  tiz_ring_t *p_ilist = NULL;
 
-  assert (a_pid < nports);
+  assert (a_pid < tiz_vector_length (p_obj->p_ports_));
 
-  p_elist = tiz_vector_at (p_obj->p_egress_, a_pid);
-  p_ilist = tiz_vector_at (p_obj->p_ingress_, a_pid);
-  assert (p_elist && *(tiz_vector_t **)p_elist);
-  p_elist = *(tiz_vector_t **)p_elist;
-  assert (p_ilist && *(tiz_vector_t **)p_ilist);
-  p_ilist = *(tiz_vector_t **)p_ilist;
-  rc = tiz_vector_append (p_elist, p_ilist);
-  tiz_vector_clear (p_ilist);
+  p_elist = get_egress_lst (p_obj, a_pid);
+  p_ilist = get_ingress_lst (p_obj, a_pid);
 
-  if (OMX_ErrorNone != rc)
+  if (OMX_ErrorNone != tiz_ring_append (p_elist, p_ilist))
     {
+      tiz_ring_clear (p_ilist);
       return -1;
     }
+  tiz_ring_clear (p_ilist);
 
-  return tiz_vector_length (p_elist);
+  return tiz_ring_length (p_elist);
 }
 
 static OMX_S32 add_to_buflst (void *ap_obj, tiz_vector_t *ap_dst2darr,
@@ -198,7 +195,7 @@ static OMX_S32 add_to_buflst (void *ap_obj, tiz_vector_t *ap_dst2darr,
                               const void *ap_port)
 {
   const tiz_krn_t *p_obj = ap_obj;
-  tiz_vector_t *p_list = NULL;
+  tiz_ring_t **pp_list = NULL;
   const OMX_U32 pid = tiz_port_index (ap_port);
 
   assert (ap_obj);
@@ -206,46 +203,45 @@ static OMX_S32 add_to_buflst (void *ap_obj, tiz_vector_t *ap_dst2darr,
   assert (ap_hdr);
   assert (tiz_vector_length (ap_dst2darr) >= pid);
 
-  p_list = tiz_vector_at (ap_dst2darr, pid);
-  assert (p_list && *(tiz_vector_t **)p_list);
-  p_list = *(tiz_vector_t **)p_list;
+  pp_list = tiz_vector_at (ap_dst2darr, pid);
+  assert (pp_list && *pp_list);
 
   TIZ_TRACE (handleOf (p_obj),
              "HEADER [%p] BUFFER [%p] PID [%d] "
              "list size [%d] buf count [%d]",
-             ap_hdr, ap_hdr->pBuffer, pid, tiz_vector_length (p_list),
+             ap_hdr, ap_hdr->pBuffer, pid, tiz_ring_length (*pp_list),
              tiz_port_buffer_count (ap_port));
 
-  assert (tiz_vector_length (p_list) < tiz_port_buffer_count (ap_port));
+  assert (tiz_ring_length (*pp_list) < tiz_port_buffer_count (ap_port));
 
-  if (OMX_ErrorNone != tiz_vector_push_back (p_list, &ap_hdr))
+  if (OMX_ErrorNone
+      != tiz_ring_push_back (*pp_list, (OMX_BUFFERHEADERTYPE *)ap_hdr))
     {
       return -1;
     }
   else
     {
-      assert (tiz_vector_length (p_list) <= tiz_port_buffer_count (ap_port));
-      return tiz_vector_length (p_list);
+      assert (tiz_ring_length (*pp_list) <= tiz_port_buffer_count (ap_port));
+      return tiz_ring_length (*pp_list);
     }
 }
 
 static OMX_S32 clear_hdr_contents (tiz_vector_t *ap_hdr_lst, OMX_U32 a_pid)
 {
-  tiz_vector_t *p_list = NULL;
+  tiz_ring_t **pp_list = NULL;
   OMX_BUFFERHEADERTYPE *p_hdr = NULL;
   OMX_S32 i, hdr_count = 0;
 
   assert (ap_hdr_lst);
   assert (tiz_vector_length (ap_hdr_lst) >= a_pid);
 
-  p_list = tiz_vector_at (ap_hdr_lst, a_pid);
-  assert (p_list && *(tiz_vector_t **)p_list);
-  p_list = *(tiz_vector_t **)p_list;
+  pp_list = tiz_vector_at (ap_hdr_lst, a_pid);
+  assert (pp_list && *pp_list);
 
-  hdr_count = tiz_vector_length (p_list);
+  hdr_count = tiz_ring_length (*pp_list);
   for (i = 0; i < hdr_count; ++i)
     {
-      p_hdr = get_header (p_list, i);
+      p_hdr = get_header (*pp_list, i);
       tiz_clear_header (p_hdr);
     }
 
@@ -256,25 +252,42 @@ static OMX_ERRORTYPE append_buflsts (tiz_vector_t *ap_dst2darr,
                                      const tiz_vector_t *ap_srclst,
                                      OMX_U32 a_pid)
 {
-  tiz_vector_t *p_list = NULL;
+  tiz_ring_t **pp_list = NULL;
+  OMX_S32 i = 0;
+  OMX_S32 nhdrs = 0;
   assert (ap_dst2darr);
   assert (ap_srclst);
   assert (tiz_vector_length (ap_dst2darr) >= a_pid);
 
-  p_list = tiz_vector_at (ap_dst2darr, a_pid);
-  assert (p_list && *(tiz_vector_t **)p_list);
-  p_list = *(tiz_vector_t **)p_list;
+  pp_list = tiz_vector_at (ap_dst2darr, a_pid);
+  assert (pp_list && *pp_list);
 
   /* Make sure the list is empty, before appending anything */
-  tiz_vector_clear (p_list);
+  tiz_ring_clear (*pp_list);
 
-  return tiz_vector_append (p_list, ap_srclst);
+  nhdrs = tiz_vector_length (ap_srclst);
+  tiz_check_omx (tiz_ring_reserve (*pp_list, nhdrs));
+  for (i = 0; i < nhdrs; ++i)
+    {
+      tiz_check_omx (tiz_ring_push_back (
+        *pp_list, *(OMX_BUFFERHEADERTYPE **)tiz_vector_at (ap_srclst, i)));
+    }
+
+  return OMX_ErrorNone;
+}
+
+/* Give the port's ingress and egress lists room for all of the port's
+   buffers, so that claiming and releasing never allocate */
+static OMX_ERRORTYPE reserve_buflsts (tiz_krn_t *ap_obj, OMX_U32 a_pid)
+{
+  const OMX_S32 nbufs = tiz_port_buffer_count (get_port (ap_obj, a_pid));
+  tiz_check_omx (tiz_ring_reserve (get_ingress_lst (ap_obj, a_pid), nbufs));
+  return tiz_ring_reserve (get_egress_lst (ap_obj, a_pid), nbufs);
 }
 
 static void clear_hdr_lsts (void *ap_obj, const OMX_U32 a_pid)
 {
   tiz_krn_t *p_obj = ap_obj;
-  tiz_vector_t *p_list = NULL;
   OMX_S32 i = 0;
   OMX_U32 pid = 0;
   OMX_S32 nports = 0;
@@ -286,15 +299,8 @@ static void clear_hdr_lsts (void *ap_obj, const OMX_U32 a_pid)
     {
       pid = ((OMX_ALL != a_pid) ? a_pid : i);
 
-      p_list = tiz_vector_at (p_obj->p_ingress_, pid);
-      assert (p_list && *(tiz_vector_t **)p_list);
-      p_list = *(tiz_vector_t **)p_list;
-      tiz_vector_clear (p_list);
-
-      p_list = tiz_vector_at (p_obj->p_egress_, pid);
-      assert (p_list && *(tiz_vector_t **)p_list);
-      p_list = *(tiz_vector_t **)p_list;
-      tiz_vector_clear (p_list);
+      tiz_ring_clear (get_ingress_lst (p_obj, pid));
+      tiz_ring_clear (get_egress_lst (p_obj, pid));
 
       ++i;
     }
@@ -343,7 +349,7 @@ static OMX_ERRORTYPE propagate_ingress (void *ap_obj, OMX_U32 a_pid)
 {
   tiz_krn_t *p_obj = ap_obj;
   void *p_prc = NULL;
-  tiz_vector_t *p_list = NULL;
+  tiz_ring_t *p_list = NULL;
   OMX_PTR p_port = NULL;
   OMX_BUFFERHEADERTYPE *p_hdr = NULL;
   OMX_S32 i = 0;
@@ -370,9 +376,9 @@ static OMX_ERRORTYPE propagate_ingress (void *ap_obj, OMX_U32 a_pid)
       /* Grab the port's ingress list */
       p_list = get_ingress_lst (p_obj, pid);
       TIZ_TRACE (handleOf (p_obj), "port [%d]'s ingress list length [%d]...",
-                 pid, tiz_vector_length (p_list));
+                 pid, tiz_ring_length (p_list));
 
-      nbufs = tiz_vector_length (p_list);
+      nbufs = tiz_ring_length (p_list);
       for (j = 0; j < nbufs; ++j)
         {
           /* Retrieve the header... */
@@ -579,7 +585,7 @@ static OMX_ERRORTYPE flush_egress (void *ap_obj, const OMX_U32 a_pid,
                                    const OMX_BOOL a_clear)
 {
   tiz_krn_t *p_obj = ap_obj;
-  tiz_vector_t *p_list = NULL;
+  tiz_ring_t *p_list = NULL;
   OMX_PTR p_port = NULL;
   OMX_BUFFERHEADERTYPE *p_hdr = NULL;
   OMX_S32 i = 0;
@@ -609,9 +615,9 @@ static OMX_ERRORTYPE flush_egress (void *ap_obj, const OMX_U32 a_pid,
       TIZ_TRACE (p_hdl,
                  "pid [%d] loop index=[%d] egress length [%d] "
                  "- p_thdl [%p]...",
-                 pid, i, tiz_vector_length (p_list), p_thdl);
+                 pid, i, tiz_ring_length (p_list), p_thdl);
 
-      while (tiz_vector_length (p_list) > 0)
+      while (tiz_ring_length (p_list) > 0)
         {
           /* Retrieve the header... */
           p_hdr = get_header (p_list, 0);
@@ -675,7 +681,7 @@ static OMX_ERRORTYPE flush_egress (void *ap_obj, const OMX_U32 a_pid,
             tiz_srv_issue_buf_callback ((OMX_PTR)ap_obj, p_hdr, pid, pdir,
                                         p_thdl);
             /* ... and delete it from the list. */
-            tiz_vector_erase (p_list, 0, 1);
+            tiz_ring_erase (p_list, 0);
           }
         }
       ++i;
@@ -1238,7 +1244,7 @@ static bool all_buffers_returned (void *ap_obj)
   tiz_krn_t *p_obj = ap_obj;
   OMX_S32 nports = 0;
   OMX_PTR p_port = NULL;
-  tiz_vector_t *p_list = NULL;
+  tiz_ring_t *p_list = NULL;
   OMX_U32 i;
   OMX_S32 nbuf = 0, nbufin = 0;
 
@@ -1260,7 +1266,7 @@ static bool all_buffers_returned (void *ap_obj)
         {
           p_list = get_ingress_lst (p_obj, i);
 
-          if ((nbufin = tiz_vector_length (p_list)) != nbuf)
+          if ((nbufin = tiz_ring_length (p_list)) != nbuf)
             {
               int j = 0;
               OMX_BUFFERHEADERTYPE *p_hdr = NULL;
@@ -51,14 +51,15 @@
 static void *
 loaded_ctor (void * ap_obj, va_list * app)
 {
-  tiz_loaded_t * p_obj = super_ctor (typeOf (ap_obj, "tizloaded"), ap_obj, app);
+  tiz_loaded_t * p_obj = super_ctor (TIZ_TYPE_OF (ap_obj, "tizloaded"), ap_obj,
+                                     app);
   return p_obj;
 }
 
 static void *
 loaded_dtor (void * ap_obj)
 {
-  return super_dtor (typeOf (ap_obj, "tizloaded"), ap_obj);
+  return super_dtor (TIZ_TYPE_OF (ap_obj, "tizloaded"), ap_obj);
 }
 
 static OMX_ERRORTYPE
@@ -197,7 +198,7 @@ loaded_state_set (const void * ap_obj, OMX_HANDLETYPE ap_hdl,
     }
 
   /* IL resource allocation takes place now */
-  return tiz_state_super_state_set (typeOf (ap_obj, "tizloaded"), ap_obj,
+  return tiz_state_super_state_set (TIZ_TYPE_OF (ap_obj, "tizloaded"), ap_obj,
                                     ap_hdl, a_cmd, a_param1, ap_cmd_data);
 }
 
@@ -209,8 +210,8 @@ loaded_trans_complete (const void * ap_obj, OMX_PTR ap_servant,
              tiz_fsm_state_to_str ((tiz_fsm_state_id_t) a_new_state));
   assert (OMX_StateWaitForResources == a_new_state
           || OMX_StateIdle == a_new_state);
-  return tiz_state_super_trans_complete (typeOf (ap_obj, "tizloaded"), ap_obj,
-                                         ap_servant, a_new_state);
+  return tiz_state_super_trans_complete (TIZ_TYPE_OF (ap_obj, "tizloaded"),
+                                         ap_obj, ap_servant, a_new_state);
 }
 
 /*
@@ -221,7 +222,7 @@ static void *
 loaded_class_ctor (void * ap_obj, va_list * app)
 {
   /* NOTE: Class methods might be added in the future. None for now. */
-  return super_ctor (typeOf (ap_obj, "tizloaded_class"), ap_obj, app);
+  return super_ctor (TIZ_TYPE_OF (ap_obj, "tizloaded_class"), ap_obj, app);
 }
 
 /*
@@ -231,7 +232,7 @@ loaded_class_ctor (void * ap_obj, va_list * app)
 void *
 tiz_loaded_class_init (void * ap_tos, void * ap_hdl)
 {
-  void * tizstate = tiz_get_type (ap_hdl, "tizstate");
+  void * tizstate = TIZ_GET_TYPE (ap_hdl, "tizstate");
   void * tizloaded_class = factory_new (
     classOf (tizstate), "tizloaded_class", classOf (tizstate),
     sizeof (tiz_loaded_class_t), ap_tos, ap_hdl, ctor, loaded_class_ctor, 0);
@@ -241,8 +242,8 @@ tiz_loaded_class_init (void * ap_tos, void * ap_hdl)
 void *
 tiz_loaded_init (void * ap_tos, void * ap_hdl)
 {
-  void * tizstate = tiz_get_type (ap_hdl, "tizstate");
-  void * tizloaded_class = tiz_get_type (ap_hdl, "tizloaded_class");
+  void * tizstate = TIZ_GET_TYPE (ap_hdl, "tizstate");
+  void * tizloaded_class = TIZ_GET_TYPE (ap_hdl, "tizloaded_class");
   TIZ_LOG_CLASS (tizloaded_class);
   void * tizloaded = factory_new (
     tizloaded_class, "tizloaded", tizstate, sizeof (tiz_loaded_t), ap_tos,
@@ -49,14 +49,14 @@ static void *
 loadedtoidle_ctor (void * ap_obj, va_list * app)
 {
   tiz_loadedtoidle_t * p_obj
-    = super_ctor (typeOf (ap_obj, "tizloadedtoidle"), ap_obj, app);
+    = super_ctor (TIZ_TYPE_OF (ap_obj, "tizloadedtoidle"), ap_obj, app);
   return p_obj;
 }
 
 static void *
 loadedtoidle_dtor (void * ap_obj)
 {
-  return super_dtor (typeOf (ap_obj, "tizloadedtoidle"), ap_obj);
+  return super_dtor (TIZ_TYPE_OF (ap_obj, "tizloadedtoidle"), ap_obj);
 }
 
 static OMX_ERRORTYPE
@@ -67,8 +67,8 @@ loadedtoidle_SetParameter (const void * ap_obj, OMX_HANDLETYPE ap_hdl,
   /* until the first OMX_UseBuffer call is received */
   TIZ_TRACE (ap_hdl, "[%s]", tiz_idx_to_str (a_index));
 
-  return super_SetParameter (typeOf (ap_obj, "tizloadedtoidle"), ap_obj, ap_hdl,
-                             a_index, ap_struct);
+  return super_SetParameter (TIZ_TYPE_OF (ap_obj, "tizloadedtoidle"), ap_obj,
+                             ap_hdl, a_index, ap_struct);
 }
 
 static OMX_ERRORTYPE
@@ -162,7 +162,7 @@ loadedtoidle_state_set (const void * ap_obj, OMX_HANDLETYPE ap_hdl,
   /* NOTE: This will call the 'tiz_state_state_set' function and not
    * 'tizloaded_state_set' (we are passing 'tizloaded' as the 1st
    * parameter  */
-  return tiz_state_super_state_set (typeOf (ap_obj, "tizloaded"), ap_obj,
+  return tiz_state_super_state_set (TIZ_TYPE_OF (ap_obj, "tizloaded"), ap_obj,
                                     ap_hdl, a_cmd, a_param1, ap_cmd_data);
 }
 
@@ -187,8 +187,8 @@ loadedtoidle_trans_complete (const void * ap_obj, OMX_PTR ap_servant,
                                            OMX_PORTSTATUS_ACCEPTUSEBUFFER);
     }
 
-  return tiz_state_super_trans_complete (typeOf (ap_obj, "tizloadedtoidle"),
-                                         ap_obj, ap_servant, a_new_state);
+  return tiz_state_super_trans_complete (
+    TIZ_TYPE_OF (ap_obj, "tizloadedtoidle"), ap_obj, ap_servant, a_new_state);
 }
 
 static OMX_ERRORTYPE
@@ -209,8 +209,8 @@ loadedtoidle_tunneled_ports_status_update (void * ap_obj)
          * will take place now */
         /* NOTE: This will call the 'tiz_state_state_set' function of the base
          * class (we are passing 'tizloaded' as the 1st parameter */
-        return tiz_state_super_state_set (typeOf (ap_obj, "tizloaded"), ap_obj,
-                                          p_hdl, OMX_CommandStateSet,
+        return tiz_state_super_state_set (TIZ_TYPE_OF (ap_obj, "tizloaded"),
+                                          ap_obj, p_hdl, OMX_CommandStateSet,
                                           OMX_StateIdle, NULL);
       }
   }
@@ -226,7 +226,8 @@ static void *
 loadedtoidle_class_ctor (void * ap_obj, va_list * app)
 {
   /* NOTE: Class methods might be added in the future. None for now. */
-  return super_ctor (typeOf (ap_obj, "tizloadedtoidle_class"), ap_obj, app);
+  return super_ctor (TIZ_TYPE_OF (ap_obj, "tizloadedtoidle_class"), ap_obj,
+                     app);
 }
 
 /*
@@ -236,7 +237,7 @@ loadedtoidle_class_ctor (void * ap_obj, va_list * app)
 void *
 tiz_loadedtoidle_class_init (void * ap_tos, void * ap_hdl)
 {
-  void * tizloaded = tiz_get_type (ap_hdl, "tizloaded");
+  void * tizloaded = TIZ_GET_TYPE (ap_hdl, "tizloaded");
   void * tizloadedtoidle_class
     = factory_new (classOf (tizloaded), "tizloadedtoidle_class",
                    classOf (tizloaded), sizeof (tiz_loadedtoidle_class_t),
@@ -247,8 +248,8 @@ tiz_loadedtoidle_class_init (void * ap_tos, void * ap_hdl)
 void *
 tiz_loadedtoidle_init (void * ap_tos, void * ap_hdl)
 {
-  void * tizloaded = tiz_get_type (ap_hdl, "tizloaded");
-  void * tizloadedtoidle_class = tiz_get_type (ap_hdl, "tizloadedtoidle_class");
+  void * tizloaded = TIZ_GET_TYPE (ap_hdl, "tizloaded");
+  void * tizloadedtoidle_class = TIZ_GET_TYPE (ap_hdl, "tizloadedtoidle_class");
   TIZ_LOG_CLASS (tizloadedtoidle_class);
   void * tizloadedtoidle = factory_new (
     tizloadedtoidle_class, "tizloadedtoidle", tizloaded,
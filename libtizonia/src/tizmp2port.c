@@ -104,7 +104,7 @@ static void *
 mp2port_ctor (void * ap_obj, va_list * app)
 {
   tiz_mp2port_t * p_obj
-    = super_ctor (typeOf (ap_obj, "tizmp2port"), ap_obj, app);
+    = super_ctor (TIZ_TYPE_OF (ap_obj, "tizmp2port"), ap_obj, app);
   tiz_port_t * p_base = ap_obj;
   OMX_TIZONIA_AUDIO_PARAM_MP2TYPE * p_mp2mode = NULL;
   tiz_port_register_index (p_obj, OMX_TizoniaIndexParamAudioMp2);
@@ -127,7 +127,7 @@ mp2port_ctor (void * ap_obj, va_list * app)
 static void *
 mp2port_dtor (void * ap_obj)
 {
-  return super_dtor (typeOf (ap_obj, "tizmp2port"), ap_obj);
+  return super_dtor (TIZ_TYPE_OF (ap_obj, "tizmp2port"), ap_obj);
 }
 
 /*
@@ -159,8 +159,8 @@ mp2port_GetParameter (const void * ap_obj, OMX_HANDLETYPE ap_hdl,
           else
             {
               /* Try the parent's indexes */
-              rc = super_GetParameter (typeOf (ap_obj, "tizmp2port"), ap_obj,
-                                       ap_hdl, a_index, ap_struct);
+              rc = super_GetParameter (TIZ_TYPE_OF (ap_obj, "tizmp2port"),
+                                       ap_obj, ap_hdl, a_index, ap_struct);
             }
         }
     };
@@ -215,8 +215,8 @@ mp2port_SetParameter (const void * ap_obj, OMX_HANDLETYPE ap_hdl,
           else
             {
               /* Try the parent's indexes */
-              rc = super_SetParameter (typeOf (ap_obj, "tizmp2port"), ap_obj,
-                                       ap_hdl, a_index, ap_struct);
+              rc = super_SetParameter (TIZ_TYPE_OF (ap_obj, "tizmp2port"),
+                                       ap_obj, ap_hdl, a_index, ap_struct);
             }
         }
         break;
@@ -495,7 +495,7 @@ static void *
 mp2port_class_ctor (void * ap_obj, va_list * app)
 {
   /* NOTE: Class methods might be added in the future. None for now. */
-  return super_ctor (typeOf (ap_obj, "tizmp2port_class"), ap_obj, app);
+  return super_ctor (TIZ_TYPE_OF (ap_obj, "tizmp2port_class"), ap_obj, app);
 }
 
 /*
@@ -505,7 +505,7 @@ mp2port_class_ctor (void * ap_obj, va_list * app)
 void *
 tiz_mp2port_class_init (void * ap_tos, void * ap_hdl)
 {
-  void * tizaudioport = tiz_get_type (ap_hdl, "tizaudioport");
+  void * tizaudioport = TIZ_GET_TYPE (ap_hdl, "tizaudioport");
   void * tizmp2port_class = factory_new
     /* TIZ_CLASS_COMMENT: class type, class name, parent, size */
     (classOf (tizaudioport), "tizmp2port_class", classOf (tizaudioport),
@@ -522,8 +522,8 @@ tiz_mp2port_class_init (void * ap_tos, void * ap_hdl)
 void *
 tiz_mp2port_init (void * ap_tos, void * ap_hdl)
 {
-  void * tizaudioport = tiz_get_type (ap_hdl, "tizaudioport");
-  void * tizmp2port_class = tiz_get_type (ap_hdl, "tizmp2port_class");
+  void * tizaudioport = TIZ_GET_TYPE (ap_hdl, "tizaudioport");
+  void * tizmp2port_class = TIZ_GET_TYPE (ap_hdl, "tizmp2port_class");
   TIZ_LOG_CLASS (tizmp2port_class);
   void * tizmp2port = factory_new
     /* TIZ_CLASS_COMMENT: class type, class name, parent, size */
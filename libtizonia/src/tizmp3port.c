@@ -105,7 +105,7 @@ static void *
 mp3port_ctor (void * ap_obj, va_list * app)
 {
   tiz_mp3port_t * p_obj
-    = super_ctor (typeOf (ap_obj, "tizmp3port"), ap_obj, app);
+    = super_ctor (TIZ_TYPE_OF (ap_obj, "tizmp3port"), ap_obj, app);
   tiz_port_t * p_base = ap_obj;
   OMX_AUDIO_PARAM_MP3TYPE * p_mp3mode = NULL;
   tiz_port_register_index (p_obj, OMX_IndexParamAudioMp3);
@@ -128,7 +128,7 @@ mp3port_ctor (void * ap_obj, va_list * app)
 static void *
 mp3port_dtor (void * ap_obj)
 {
-  return super_dtor (typeOf (ap_obj, "tizmp3port"), ap_obj);
+  return super_dtor (TIZ_TYPE_OF (ap_obj, "tizmp3port"), ap_obj);
 }
 
 /*
@@ -160,7 +160,7 @@ mp3port_GetParameter (const void * ap_obj, OMX_HANDLETYPE ap_hdl,
       default:
         {
           /* Try the parent's indexes */
-          rc = super_GetParameter (typeOf (ap_obj, "tizmp3port"), ap_obj,
+          rc = super_GetParameter (TIZ_TYPE_OF (ap_obj, "tizmp3port"), ap_obj,
                                    ap_hdl, a_index, ap_struct);
         }
     };
@@ -216,7 +216,7 @@ mp3port_SetParameter (const void * ap_obj, OMX_HANDLETYPE ap_hdl,
       default:
         {
           /* Try the parent's indexes */
-          rc = super_SetParameter (typeOf (ap_obj, "tizmp3port"), ap_obj,
+          rc = super_SetParameter (TIZ_TYPE_OF (ap_obj, "tizmp3port"), ap_obj,
                                    ap_hdl, a_index, ap_struct);
         }
     };
@@ -489,7 +489,7 @@ static void *
 mp3port_class_ctor (void * ap_obj, va_list * app)
 {
   /* NOTE: Class methods might be added in the future. None for now. */
-  return super_ctor (typeOf (ap_obj, "tizmp3port_class"), ap_obj, app);
+  return super_ctor (TIZ_TYPE_OF (ap_obj, "tizmp3port_class"), ap_obj, app);
 }
 
 /*
@@ -499,7 +499,7 @@ mp3port_class_ctor (void * ap_obj, va_list * app)
 void *
 tiz_mp3port_class_init (void * ap_tos, void * ap_hdl)
 {
-  void * tizaudioport = tiz_get_type (ap_hdl, "tizaudioport");
+  void * tizaudioport = TIZ_GET_TYPE (ap_hdl, "tizaudioport");
   void * tizmp3port_class = factory_new
     /* TIZ_CLASS_COMMENT: class type, class name, parent, size */
     (classOf (tizaudioport), "tizmp3port_class", classOf (tizaudioport),
@@ -516,8 +516,8 @@ tiz_mp3port_class_init (void * ap_tos, void * ap_hdl)
 void *
 tiz_mp3port_init (void * ap_tos, void * ap_hdl)
 {
-  void * tizaudioport = tiz_get_type (ap_hdl, "tizaudioport");
-  void * tizmp3port_class = tiz_get_type (ap_hdl, "tizmp3port_class");
+  void * tizaudioport = TIZ_GET_TYPE (ap_hdl, "tizaudioport");
+  void * tizmp3port_class = TIZ_GET_TYPE (ap_hdl, "tizmp3port_class");
   TIZ_LOG_CLASS (tizmp3port_class);
   void * tizmp3port = factory_new
     /* TIZ_CLASS_COMMENT: class type, class name, parent, size */
@@ -52,7 +52,7 @@ static void *
 mp4port_ctor (void * ap_obj, va_list * app)
 {
   tiz_mp4port_t * p_obj
-    = super_ctor (typeOf (ap_obj, "tizmp4port"), ap_obj, app);
+    = super_ctor (TIZ_TYPE_OF (ap_obj, "tizmp4port"), ap_obj, app);
   assert (p_obj);
 
   tiz_check_omx_ret_null (
@@ -66,7 +66,7 @@ mp4port_dtor (void * ap_obj)
 {
   tiz_mp4port_t * p_obj = ap_obj;
   assert (p_obj);
-  return super_dtor (typeOf (ap_obj, "tizmp4port"), ap_obj);
+  return super_dtor (TIZ_TYPE_OF (ap_obj, "tizmp4port"), ap_obj);
 }
 
 /*
@@ -118,8 +118,8 @@ mp4port_GetParameter (const void * ap_obj, OMX_HANDLETYPE ap_hdl,
       default:
         {
           /* Delegate to the base port */
-          return super_GetParameter (typeOf (ap_obj, "tizdemuxerport"), ap_obj,
-                                     ap_hdl, a_index, ap_struct);
+          return super_GetParameter (TIZ_TYPE_OF (ap_obj, "tizdemuxerport"),
+                                     ap_obj, ap_hdl, a_index, ap_struct);
         }
     };
 
@@ -151,7 +151,7 @@ mp4port_SetParameter (const void * ap_obj, OMX_HANDLETYPE ap_hdl,
       default:
         {
           /* Try the parent's indexes */
-          rc = super_SetParameter (typeOf (ap_obj, "tizmp4port"), ap_obj,
+          rc = super_SetParameter (TIZ_TYPE_OF (ap_obj, "tizmp4port"), ap_obj,
                                    ap_hdl, a_index, ap_struct);
         }
     };
@@ -210,7 +210,7 @@ static void *
 tiz_mp4port_class_ctor (void * ap_obj, va_list * app)
 {
   /* NOTE: Class methods might be added in the future. None for now. */
-  return super_ctor (typeOf (ap_obj, "tizmp4port_class"), ap_obj, app);
+  return super_ctor (TIZ_TYPE_OF (ap_obj, "tizmp4port_class"), ap_obj, app);
 }
 
 /*
@@ -220,7 +220,7 @@ tiz_mp4port_class_ctor (void * ap_obj, va_list * app)
 void *
 tiz_mp4port_class_init (void * ap_tos, void * ap_hdl)
 {
-  void * tizport = tiz_get_type (ap_hdl, "tizport");
+  void * tizport = TIZ_GET_TYPE (ap_hdl, "tizport");
   void * tizmp4port_class = factory_new
     /* TIZ_CLASS_COMMENT: class type, class name, parent, size */
     (classOf (tizport), "tizmp4port_class", classOf (tizport),
@@ -237,8 +237,8 @@ tiz_mp4port_class_init (void * ap_tos, void * ap_hdl)
 void *
 tiz_mp4port_init (void * ap_tos, void * ap_hdl)
 {
-  void * tizport = tiz_get_type (ap_hdl, "tizport");
-  void * tizmp4port_class = tiz_get_type (ap_hdl, "tizmp4port_class");
+  void * tizport = TIZ_GET_TYPE (ap_hdl, "tizport");
+  void * tizmp4port_class = TIZ_GET_TYPE (ap_hdl, "tizmp4port_class");
   TIZ_LOG_CLASS (tizmp4port_class);
   void * tizmp4port = factory_new
     /* TIZ_CLASS_COMMENT: class type, class name, parent, size */
@@ -82,7 +82,7 @@ alloc_pcm_port (tiz_muxerport_t * ap_obj, tiz_port_options_t * ap_opts,
   TIZ_TRACE (handleOf (ap_obj), "p_volume->sVolume.nValue [%d]",
              p_volume->sVolume.nValue);
 
-  return factory_new (typeOf (ap_obj, "tizpcmport"), ap_opts, a_encodings,
+  return factory_new (TIZ_TYPE_OF (ap_obj, "tizpcmport"), ap_opts, a_encodings,
                       p_pcmmode, p_volume, p_mute);
 }
 
@@ -106,7 +106,7 @@ alloc_opus_port (tiz_muxerport_t * ap_obj, tiz_port_options_t * ap_opts,
   p_opusmode = va_arg (*ap_args, OMX_TIZONIA_AUDIO_PARAM_OPUSTYPE *);
   assert (p_opusmode);
 
-  return factory_new (typeOf (ap_obj, "tizopusport"), ap_opts, a_encodings,
+  return factory_new (TIZ_TYPE_OF (ap_obj, "tizopusport"), ap_opts, a_encodings,
                       p_opusmode);
 }
 
@@ -130,7 +130,7 @@ muxerport_ctor (void * ap_obj, va_list * app)
   va_copy (app_copy, *app);
 
   /* Now give the original to the base class */
-  if ((p_obj = super_ctor (typeOf (ap_obj, "tizmuxerport"), ap_obj, app)))
+  if ((p_obj = super_ctor (TIZ_TYPE_OF (ap_obj, "tizmuxerport"), ap_obj, app)))
     {
 
       /* Grab the port options structure (mandatory argument) */
@@ -200,7 +200,7 @@ muxerport_ctor (void * ap_obj, va_list * app)
               assert (p_formats);
 
               if (!(p_obj->p_port_
-                    = factory_new (typeOf (ap_obj, "tizvideoport"), p_opts,
+                    = factory_new (TIZ_TYPE_OF (ap_obj, "tizvideoport"), p_opts,
                                    p_portdef, p_encodings, p_formats)))
                 {
                   return NULL;
@@ -223,7 +223,7 @@ muxerport_dtor (void * ap_obj)
   tiz_muxerport_t * p_obj = ap_obj;
   assert (p_obj);
   factory_delete (p_obj->p_port_);
-  return super_dtor (typeOf (ap_obj, "tizmuxerport"), ap_obj);
+  return super_dtor (TIZ_TYPE_OF (ap_obj, "tizmuxerport"), ap_obj);
 }
 
 /*
@@ -274,8 +274,8 @@ muxerport_GetParameter (const void * ap_obj, OMX_HANDLETYPE ap_hdl,
             }
 
           /* Delegate to the base port */
-          return super_GetParameter (typeOf (ap_obj, "tizmuxerport"), ap_obj,
-                                     ap_hdl, a_index, ap_struct);
+          return super_GetParameter (TIZ_TYPE_OF (ap_obj, "tizmuxerport"),
+                                     ap_obj, ap_hdl, a_index, ap_struct);
         }
     };
 
@@ -329,8 +329,8 @@ muxerport_SetParameter (const void * ap_obj, OMX_HANDLETYPE ap_hdl,
             }
 
           /* Delegate to the base port */
-          return super_SetParameter (typeOf (ap_obj, "tizmuxerport"), ap_obj,
-                                     ap_hdl, a_index, ap_struct);
+          return super_SetParameter (TIZ_TYPE_OF (ap_obj, "tizmuxerport"),
+                                     ap_obj, ap_hdl, a_index, ap_struct);
         }
     };
 
@@ -368,8 +368,8 @@ muxerport_GetConfig (const void * ap_obj, OMX_HANDLETYPE ap_hdl,
       default:
         {
           /* Try the parent's indexes */
-          rc = super_GetConfig (typeOf (ap_obj, "tizmuxerport"), ap_obj, ap_hdl,
-                                a_index, ap_struct);
+          rc = super_GetConfig (TIZ_TYPE_OF (ap_obj, "tizmuxerport"), ap_obj,
+                                ap_hdl, a_index, ap_struct);
         }
     };
 
@@ -407,8 +407,8 @@ muxerport_SetConfig (const void * ap_obj, OMX_HANDLETYPE ap_hdl,
       default:
         {
           /* Try the parent's indexes */
-          rc = super_SetConfig (typeOf (ap_obj, "tizmuxerport"), ap_obj, ap_hdl,
-                                a_index, ap_struct);
+          rc = super_SetConfig (TIZ_TYPE_OF (ap_obj, "tizmuxerport"), ap_obj,
+                                ap_hdl, a_index, ap_struct);
         }
     };
 
@@ -439,7 +439,7 @@ static void *
 muxerport_class_ctor (void * ap_obj, va_list * app)
 {
   /* NOTE: Class methods might be added in the future. None for now. */
-  return super_ctor (typeOf (ap_obj, "tizmuxerport_class"), ap_obj, app);
+  return super_ctor (TIZ_TYPE_OF (ap_obj, "tizmuxerport_class"), ap_obj, app);
 }
 
 /*
@@ -449,7 +449,7 @@ muxerport_class_ctor (void * ap_obj, va_list * app)
 void *
 tiz_muxerport_class_init (void * ap_tos, void * ap_hdl)
 {
-  void * tizport = tiz_get_type (ap_hdl, "tizport");
+  void * tizport = TIZ_GET_TYPE (ap_hdl, "tizport");
   void * tizmuxerport_class = factory_new
     /* TIZ_CLASS_COMMENT: class type, class name, parent, size */
     (classOf (tizport), "tizmuxerport_class", classOf (tizport),
@@ -466,8 +466,8 @@ tiz_muxerport_class_init (void * ap_tos, void * ap_hdl)
 void *
 tiz_muxerport_init (void * ap_tos, void * ap_hdl)
 {
-  void * tizport = tiz_get_type (ap_hdl, "tizport");
-  void * tizmuxerport_class = tiz_get_type (ap_hdl, "tizmuxerport_class");
+  void * tizport = TIZ_GET_TYPE (ap_hdl, "tizport");
+  void * tizmuxerport_class = TIZ_GET_TYPE (ap_hdl, "tizmuxerport_class");
   TIZ_LOG_CLASS (tizmuxerport_class);
   void * tizmuxerport = factory_new
     /* TIZ_CLASS_COMMENT: class type, class name, parent, size */
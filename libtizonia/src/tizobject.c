@@ -83,9 +83,15 @@ handleOf (const void * ap_obj)
 
 const void *
 typeOf (const void * ap_obj, const char * ap_type_name)
+{
+  return typeOfId (ap_obj, tiz_os_type_id (ap_type_name));
+}
+
+const void *
+typeOfId (const void * ap_obj, const tiz_os_type_id_t a_type_id)
 {
   const tiz_class_t * p_class = classOf (ap_obj);
-  return tiz_os_get_type (p_class->tos, ap_type_name);
+  return tiz_os_get_type_by_id (p_class->tos, a_type_id);
 }
 
 void
@@ -94,8 +100,10 @@ print_class (const void * ap_class, const char * file, int line,
 {
   const tiz_class_t * p_class = ap_class;
   assert (p_class);
+  /* Shared metaclasses don't belong to any component */
   tiz_log (file, line, func, TIZ_LOG_CATEGORY_NAME, TIZ_PRIORITY_TRACE,
-           TIZ_CNAME (p_class->hdl), TIZ_CBUF (p_class->hdl),
+           p_class->hdl ? TIZ_CNAME (p_class->hdl) : NULL,
+           p_class->hdl ? TIZ_CBUF (p_class->hdl) : NULL,
            "[%p] - name [%s] - super [%p] - super name [%s] - "
            "size [%d] - tos [%p] - hdl [%p]",
            p_class, p_class->name, p_class->super, p_class->super->name,
@@ -261,7 +269,7 @@ tiz_class_init (void * ap_tos, void * ap_hdl)
 void *
 tiz_object_init (void * ap_tos, void * ap_hdl)
 {
-  tiz_class_t * tizclass = tiz_get_type (ap_hdl, "tizclass");
+  tiz_class_t * tizclass = TIZ_GET_TYPE (ap_hdl, "tizclass");
   TIZ_LOG_CLASS (tizclass);
   tiz_class_t * tizobject = tiz_mem_calloc (1, sizeof (tiz_class_t));
   const size_t super_offset = offsetof (tiz_class_t, super);
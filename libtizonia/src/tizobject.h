@@ -26,6 +26,8 @@ extern "C" {
 
 #include <OMX_Types.h>
 
+#include "tizobjsys.h"
+
 #include <stdarg.h>
 #include <stddef.h>
 #include <stdio.h>
@@ -50,6 +52,13 @@ const OMX_HANDLETYPE
 handleOf (const void * ap_obj);
 const void *
 typeOf (const void * ap_obj, const char * ap_class_name);
+const void *
+typeOfId (const void * ap_obj, const tiz_os_type_id_t a_type_id);
+
+/* Same as typeOf, for a string literal class name. The name is interned once
+   per call site (see TIZ_OS_TYPE_ID). */
+#define TIZ_TYPE_OF(ap_obj, ap_class_name) \
+  typeOfId ((ap_obj), TIZ_OS_TYPE_ID (ap_class_name))
 
 void *
 ctor (void * p_obj, va_list * app);
@@ -31,6 +31,8 @@
 #endif
 
 #include <assert.h>
+#include <pthread.h>
+#include <stdlib.h>
 #include <string.h>
 
 #include <tizplatform.h>
@@ -86,9 +88,15 @@
 #define TIZ_LOG_CATEGORY_NAME "tiz.tizonia.objsys"
 #endif
 
+/* Registered types are kept in an array indexed by the interned type id. In
+   shared mode, the built-in metaclasses are looked up in 'p_shared'
+   instead. */
 struct tiz_os
 {
-  tiz_map_t * p_map;
+  void ** pp_types;
+  OMX_S32 capacity;
+  OMX_S32 ntypes;
+  const tiz_os_t * p_shared;
   OMX_HANDLETYPE p_hdl;
   tiz_soa_t * p_soa;
 };
@@ -377,65 +385,133 @@ os_free (tiz_soa_t * p_soa, void * ap_addr)
   p_soa ? tiz_soa_free (p_soa, ap_addr) : tiz_mem_free (ap_addr);
 }
 
-static char *
-os_strndup (tiz_soa_t * p_soa, const char * s, size_t n)
+/* Process-wide table of interned type names. The base and additional types
+   take the ids given by tiz_os_type_to_str_tbl; any other type name (i.e.
+   those registered by component plugins) is appended to this table the first
+   time it is seen. Interned names are never removed, so their ids remain valid
+   for the lifetime of the process */
+static pthread_mutex_t g_os_names_mutex = PTHREAD_MUTEX_INITIALIZER;
+static char ** gpp_os_names = NULL;
+static OMX_S32 g_os_nnames = 0;
+static OMX_S32 g_os_names_capacity = 0;
+
+static inline OMX_S32
+os_builtin_type_count (void)
 {
-  char * result;
-  size_t len = strlen (s);
+  return (OMX_S32) (sizeof (tiz_os_type_to_str_tbl)
+                    / sizeof (tiz_os_type_str_t));
+}
 
-  assert (p_soa);
+static tiz_os_type_id_t
+os_intern_name (const char * a_type_name)
+{
+  const OMX_S32 nbuiltins = os_builtin_type_count ();
+  tiz_os_type_id_t id = TIZ_OS_TYPE_ID_INVALID;
+  OMX_S32 i = 0;
 
-  if (n < len)
+  for (i = 0; i < nbuiltins; ++i)
     {
-      len = n;
+      if (0 == strncmp (a_type_name, tiz_os_type_to_str_tbl[i].str,
+                        OMX_MAX_STRINGNAME_SIZE))
+        {
+          return i;
+        }
     }
 
-  if (NULL == (result = (char *) os_calloc (p_soa, len + 1)))
+  (void) pthread_mutex_lock (&g_os_names_mutex);
+  for (i = 0; i < g_os_nnames; ++i)
     {
-      return NULL;
+      if (0 == strncmp (a_type_name, gpp_os_names[i], OMX_MAX_STRINGNAME_SIZE))
+        {
+          id = nbuiltins + i;
+          break;
+        }
     }
 
-  result[len] = '\0';
-  return (char *) memcpy (result, s, len);
-}
+  if (TIZ_OS_TYPE_ID_INVALID == id)
+    {
+      char * p_name = NULL;
+      if (g_os_nnames == g_os_names_capacity)
+        {
+          const OMX_S32 capacity = MAX (16, g_os_names_capacity * 2);
+          char ** pp_names
+            = tiz_mem_realloc (gpp_os_names, capacity * sizeof (char *));
+          if (pp_names)
+            {
+              gpp_os_names = pp_names;
+              g_os_names_capacity = capacity;
+            }
+        }
+      if (g_os_nnames < g_os_names_capacity
+          && (p_name = strndup (a_type_name, OMX_MAX_STRINGNAME_SIZE)))
+        {
+          gpp_os_names[g_os_nnames] = p_name;
+          id = nbuiltins + g_os_nnames++;
+        }
+    }
+  (void) pthread_mutex_unlock (&g_os_names_mutex);
 
-static OMX_S32
-os_map_compare_func (OMX_PTR ap_key1, OMX_PTR ap_key2)
-{
-  return strncmp ((const char *) ap_key1, (const char *) ap_key2,
-                  OMX_MAX_STRINGNAME_SIZE);
+  return id;
 }
 
-static void
-os_map_free_func (OMX_PTR ap_key, OMX_PTR ap_value)
-{
-  /* Don't bother deleting the keys here as they are allocated from the chunk
-     of memory provided by the small object allocator, which gets released when
-     the component is deinited. */
-  tiz_mem_free (ap_value);
-}
+/* Process-wide, read-only table of built-in types ('shared' mode, see
+   component-class-table in tizonia.conf) */
+static pthread_mutex_t g_os_shared_mutex = PTHREAD_MUTEX_INITIALIZER;
+static tiz_os_t * gp_os_shared = NULL;
+static int g_os_shared_mode = -1;
 
-#ifdef _DEBUG
-static OMX_S32
-print_function (OMX_PTR ap_key, OMX_PTR ap_value, OMX_PTR ap_arg)
+static void __attribute__ ((destructor)) os_names_unload (void)
 {
-  const char * name = ap_key;
-  tiz_os_t * p_os = ap_arg;
-  TIZ_TRACE (p_os->p_hdl, "type [%s]->[%p]", name, ap_value);
-  return 0;
+  OMX_S32 i = 0;
+
+  tiz_os_destroy (gp_os_shared);
+  gp_os_shared = NULL;
+
+  for (i = 0; i < g_os_nnames; ++i)
+    {
+      free (gpp_os_names[i]);
+    }
+  tiz_mem_free (gpp_os_names);
+  gpp_os_names = NULL;
+  g_os_nnames = 0;
+  g_os_names_capacity = 0;
 }
-#endif
 
 static void
 print_types (const tiz_os_t * ap_os)
 {
 #ifdef _DEBUG
+  OMX_S32 i = 0;
   assert (ap_os);
-  assert (ap_os->p_map);
-  tiz_map_for_each (ap_os->p_map, print_function, (tiz_os_t *) ap_os);
+  for (i = 0; i < ap_os->capacity; ++i)
+    {
+      if (ap_os->pp_types[i])
+        {
+          TIZ_TRACE (ap_os->p_hdl, "type #[%d]->[%p] nameOf [%s]", i,
+                     ap_os->pp_types[i], nameOf (ap_os->pp_types[i]));
+        }
+    }
 #endif
 }
 
+static OMX_ERRORTYPE
+os_reserve (tiz_os_t * ap_os, const tiz_os_type_id_t a_type_id)
+{
+  assert (ap_os);
+  if (a_type_id >= ap_os->capacity)
+    {
+      const OMX_S32 capacity = MAX (a_type_id + 1, ap_os->capacity * 2);
+      void ** pp_types
+        = tiz_mem_realloc (ap_os->pp_types, capacity * sizeof (void *));
+      tiz_check_null_ret_oom (pp_types);
+      memset (pp_types + ap_os->capacity, 0,
+              (capacity - ap_os->capacity) * sizeof (void *));
+      ap_os->pp_types = pp_types;
+      ap_os->capacity = capacity;
+    }
+  return OMX_ErrorNone;
+}
+
 static OMX_ERRORTYPE
 os_register_type (tiz_os_t * ap_os, const tiz_os_type_init_f a_type_init_f,
                   const char * a_type_name, const OMX_S32 a_type_id)
@@ -444,12 +520,21 @@ os_register_type (tiz_os_t * ap_os, const tiz_os_type_init_f a_type_init_f,
   void * p_obj = NULL;
 
   assert (ap_os);
-  assert (ap_os->p_map);
   assert (a_type_init_f);
   assert (a_type_name);
   assert (strnlen (a_type_name, OMX_MAX_STRINGNAME_SIZE)
           < OMX_MAX_STRINGNAME_SIZE);
-  assert (a_type_id >= 0);
+
+  if (a_type_id < 0)
+    {
+      return OMX_ErrorInsufficientResources;
+    }
+
+  tiz_check_omx (os_reserve (ap_os, a_type_id));
+  if (ap_os->pp_types[a_type_id])
+    {
+      return OMX_ErrorBadParameter;
+    }
 
   /* Call the type init function */
   p_obj = a_type_init_f (ap_os, ap_os->p_hdl);
@@ -461,9 +546,9 @@ os_register_type (tiz_os_t * ap_os, const tiz_os_type_init_f a_type_init_f,
                  "Registering type #[%d] : [%s] -> [%p] "
                  "nameOf [%s]",
                  a_type_id, a_type_name, p_obj, nameOf (p_obj));
-      rc = tiz_map_insert (ap_os->p_map, os_strndup (ap_os->p_soa, a_type_name,
-                                                     OMX_MAX_STRINGNAME_SIZE),
-                           p_obj, (OMX_U32 *) (&a_type_id));
+      ap_os->pp_types[a_type_id] = p_obj;
+      ap_os->ntypes++;
+      rc = OMX_ErrorNone;
     }
 
   /*   print_types (ap_os); */
@@ -471,21 +556,48 @@ os_register_type (tiz_os_t * ap_os, const tiz_os_type_init_f a_type_init_f,
   return rc;
 }
 
+/* In 'shared' mode, only the metaclasses (the "..._class" types and the
+   tizclass/tizobject roots) are built once per process. The classes that
+   get instantiated record the handle of the component they belong to, so
+   they are still built per instance. */
+static bool
+os_is_shared_type (const tiz_os_type_id_t a_type_id)
+{
+  const char * p_name = NULL;
+  size_t len = 0;
+
+  if (a_type_id < 0 || a_type_id >= os_builtin_type_count ())
+    {
+      return false;
+    }
+  if (a_type_id <= ETIZObject)
+    {
+      return true;
+    }
+  p_name = tiz_os_type_to_str_tbl[a_type_id].str;
+  len = strlen (p_name);
+  return (len > 6 && 0 == strcmp (p_name + len - 6, "_class"));
+}
+
 static OMX_ERRORTYPE
 register_base_types (tiz_os_t * ap_os)
 {
   OMX_ERRORTYPE rc = OMX_ErrorNone;
-  const OMX_S32 count
-    = sizeof (tiz_os_type_to_str_tbl) / sizeof (tiz_os_type_str_t);
   OMX_S32 type_id = 0;
   OMX_S32 last_element = 0;
 
   assert (ap_os);
-  assert (count >= TIZ_OS_BASE_TYPE_END);
+  assert (os_builtin_type_count () >= TIZ_OS_BASE_TYPE_END);
   last_element = TIZ_OS_BASE_TYPE_END;
 
   for (type_id = 0; type_id <= last_element && OMX_ErrorNone == rc; ++type_id)
     {
+      if (ap_os->pp_types[type_id]
+          || (ap_os->p_shared && os_is_shared_type (type_id)))
+        {
+          /* Shared, or already built along with the shared table */
+          continue;
+        }
       TIZ_TRACE (ap_os->p_hdl, "Registering type [%s]...",
                  tiz_os_type_to_str_tbl[type_id].str);
       rc = os_register_type (ap_os, tiz_os_type_to_fnt_tbl[type_id],
@@ -494,6 +606,106 @@ register_base_types (tiz_os_t * ap_os)
   return rc;
 }
 
+static bool
+os_shared_mode (void)
+{
+  /* Called with g_os_shared_mutex held */
+  if (g_os_shared_mode < 0)
+    {
+      const char * p_mode
+        = tiz_rcfile_get_value ("ilcore", "component-class-table");
+      g_os_shared_mode = (p_mode && 0 == strncmp (p_mode, "shared", 6));
+    }
+  return g_os_shared_mode;
+}
+
+static size_t
+os_freeze (tiz_os_t * ap_os)
+{
+  size_t nbytes = 0;
+  OMX_S32 i = 0;
+
+  /* The shared metaclasses must not refer to the component that happened to
+     build them */
+  for (i = 0; i < ap_os->capacity; ++i)
+    {
+      tiz_class_t * p_class = ap_os->pp_types[i];
+      if (p_class)
+        {
+          nbytes += sizeOf (p_class);
+          p_class->hdl = NULL;
+        }
+    }
+  ap_os->p_hdl = NULL;
+  return nbytes;
+}
+
+static OMX_ERRORTYPE
+build_shared_types (tiz_os_t * ap_os)
+{
+  OMX_ERRORTYPE rc = OMX_ErrorNone;
+  const OMX_S32 count = os_builtin_type_count ();
+  tiz_os_t * p_shared = NULL;
+  OMX_S32 type_id = 0;
+  size_t nbytes = 0;
+
+  assert (ap_os);
+
+  tiz_check_omx (tiz_os_init (&p_shared, ap_os->p_hdl, NULL));
+
+  /* The class init functions look up their super classes through the
+     component handle, i.e. through ap_os. The base classes the metaclasses
+     depend on are built in ap_os along the way. */
+  ap_os->p_shared = p_shared;
+
+  for (type_id = 0; type_id < count && OMX_ErrorNone == rc; ++type_id)
+    {
+      tiz_os_t * p_os = os_is_shared_type (type_id) ? p_shared : ap_os;
+      if (type_id > TIZ_OS_BASE_TYPE_END && p_os == ap_os)
+        {
+          continue;
+        }
+      if (!p_os->pp_types[type_id])
+        {
+          rc = os_register_type (p_os, tiz_os_type_to_fnt_tbl[type_id],
+                                 tiz_os_type_to_str_tbl[type_id].str, type_id);
+        }
+    }
+
+  if (OMX_ErrorNone != rc)
+    {
+      ap_os->p_shared = NULL;
+      tiz_os_destroy (p_shared);
+      return rc;
+    }
+
+  nbytes = os_freeze (p_shared);
+  TIZ_LOG (TIZ_PRIORITY_NOTICE,
+           "Built the shared class table: [%d] types - "
+           "[%lu] bytes saved per component instance",
+           p_shared->ntypes, (unsigned long) nbytes);
+  gp_os_shared = p_shared;
+  return OMX_ErrorNone;
+}
+
+static OMX_ERRORTYPE
+attach_shared_types (tiz_os_t * ap_os)
+{
+  OMX_ERRORTYPE rc = OMX_ErrorNone;
+  assert (ap_os);
+  (void) pthread_mutex_lock (&g_os_shared_mutex);
+  if (gp_os_shared)
+    {
+      ap_os->p_shared = gp_os_shared;
+    }
+  else
+    {
+      rc = build_shared_types (ap_os);
+    }
+  (void) pthread_mutex_unlock (&g_os_shared_mutex);
+  return rc;
+}
+
 OMX_ERRORTYPE
 tiz_os_init (tiz_os_t ** app_os, const OMX_HANDLETYPE ap_hdl,
              tiz_soa_t * ap_soa)
@@ -512,8 +724,7 @@ tiz_os_init (tiz_os_t ** app_os, const OMX_HANDLETYPE ap_hdl,
 
   assert (p_os);
 
-  if (OMX_ErrorNone != tiz_map_init (&(p_os->p_map), os_map_compare_func,
-                                     os_map_free_func, NULL))
+  if (OMX_ErrorNone != os_reserve (p_os, os_builtin_type_count () - 1))
     {
       os_free (ap_soa, p_os);
       p_os = NULL;
@@ -533,11 +744,12 @@ tiz_os_destroy (tiz_os_t * ap_os)
 {
   if (ap_os)
     {
-      while (!tiz_map_empty (ap_os->p_map))
+      OMX_S32 i = 0;
+      for (i = 0; i < ap_os->capacity; ++i)
         {
-          tiz_map_erase_at (ap_os->p_map, 0);
-        };
-      tiz_map_destroy (ap_os->p_map);
+          tiz_mem_free (ap_os->pp_types[i]);
+        }
+      tiz_mem_free (ap_os->pp_types);
       os_free (ap_os->p_soa, ap_os);
     }
 }
@@ -547,65 +759,85 @@ tiz_os_register_type (tiz_os_t * ap_os, const tiz_os_type_init_f a_type_init_f,
                       const OMX_STRING a_type_name)
 {
   assert (ap_os);
+  assert (a_type_name);
   return os_register_type (ap_os, a_type_init_f, a_type_name,
-                           tiz_map_size (ap_os->p_map));
+                           os_intern_name (a_type_name));
 }
 
 OMX_ERRORTYPE
 tiz_os_register_base_types (tiz_os_t * ap_os)
 {
-  assert (ap_os);
-  return register_base_types (ap_os);
-}
-
-static OMX_ERRORTYPE
-register_additional_type (tiz_os_t * ap_os, const char * a_type_name)
-{
-  OMX_ERRORTYPE rc = OMX_ErrorNone;
-  const OMX_S32 count
-    = sizeof (tiz_os_type_to_str_tbl) / sizeof (tiz_os_type_str_t);
-  OMX_S32 type_id = TIZ_OS_BASE_TYPE_END + 1;
+  bool shared = false;
 
   assert (ap_os);
 
-  for (; type_id < count && OMX_ErrorNone == rc; ++type_id)
+  (void) pthread_mutex_lock (&g_os_shared_mutex);
+  shared = os_shared_mode ();
+  (void) pthread_mutex_unlock (&g_os_shared_mutex);
+
+  if (shared)
     {
-      if (0 == strncmp (a_type_name, tiz_os_type_to_str_tbl[type_id].str,
-                        OMX_MAX_STRINGNAME_SIZE))
-        {
-          TIZ_TRACE (ap_os->p_hdl, "Registering additional type [%s]...",
-                     a_type_name);
-          rc = os_register_type (ap_os, tiz_os_type_to_fnt_tbl[type_id],
-                                 a_type_name, type_id);
-          break;
-        }
+      tiz_check_omx (attach_shared_types (ap_os));
     }
-  return rc;
+  return register_base_types (ap_os);
+}
+
+tiz_os_type_id_t
+tiz_os_type_id (const char * a_type_name)
+{
+  assert (a_type_name);
+  return os_intern_name (a_type_name);
 }
 
 void *
-tiz_os_get_type (const tiz_os_t * ap_os, const char * a_type_name)
+tiz_os_get_type_by_id (const tiz_os_t * ap_os,
+                       const tiz_os_type_id_t a_type_id)
 {
   void * res = NULL;
   assert (ap_os);
-  assert (ap_os->p_map);
-  assert (a_type_name);
-  res = tiz_map_find (ap_os->p_map, (OMX_PTR) a_type_name);
-  TIZ_TRACE (ap_os->p_hdl, "Get type [%s]->[%p] - total types [%d]",
-             a_type_name, res, tiz_map_size (ap_os->p_map));
-  if (!res)
+  assert (a_type_id >= 0);
+  if (a_type_id < ap_os->capacity)
+    {
+      res = ap_os->pp_types[a_type_id];
+    }
+  if (!res && ap_os->p_shared && a_type_id < ap_os->p_shared->capacity)
+    {
+      res = ap_os->p_shared->pp_types[a_type_id];
+    }
+  if (!res && a_type_id > TIZ_OS_BASE_TYPE_END
+      && a_type_id < os_builtin_type_count () && ap_os != gp_os_shared)
     {
+      /* Additional types are registered the first time they are needed. A
+         metaclass can only be missing here while the shared table is being
+         built; it goes into that table. */
+      tiz_os_t * p_os = (ap_os->p_shared && os_is_shared_type (a_type_id))
+                          ? (tiz_os_t *) ap_os->p_shared
+                          : (tiz_os_t *) ap_os;
+      TIZ_TRACE (ap_os->p_hdl, "Registering additional type [%s]...",
+                 tiz_os_type_to_str_tbl[a_type_id].str);
       if (OMX_ErrorNone
-          == register_additional_type ((tiz_os_t *) ap_os, a_type_name))
+          == os_register_type (p_os, tiz_os_type_to_fnt_tbl[a_type_id],
+                               tiz_os_type_to_str_tbl[a_type_id].str,
+                               a_type_id))
         {
-          print_types (ap_os);
-          res = tiz_map_find (ap_os->p_map, (OMX_PTR) a_type_name);
+          print_types (p_os);
+          res = p_os->pp_types[a_type_id];
         }
     }
   assert (res);
   return res;
 }
 
+void *
+tiz_os_get_type (const tiz_os_t * ap_os, const char * a_type_name)
+{
+  assert (ap_os);
+  assert (a_type_name);
+  TIZ_TRACE (ap_os->p_hdl, "Get type [%s] - total types [%d]", a_type_name,
+             ap_os->ntypes);
+  return tiz_os_get_type_by_id (ap_os, os_intern_name (a_type_name));
+}
+
 void *
 tiz_os_calloc (const tiz_os_t * ap_os, size_t a_size)
 {
@@ -42,6 +42,29 @@ typedef struct tiz_os tiz_os_t;
 
 typedef void * (*tiz_os_type_init_f) (void * ap_tos, void * ap_hdl);
 
+/* Interned type id. A type name maps to the same id in every component
+   instance of the process. */
+typedef OMX_S32 tiz_os_type_id_t;
+
+#define TIZ_OS_TYPE_ID_INVALID (-1)
+
+/* Intern a string literal type name once per call site. The id is cached in
+   a static variable, so after the first call the lookup costs a single
+   load. */
+#define TIZ_OS_TYPE_ID(a_type_name)                                     \
+  (__extension__ ({                                                     \
+    static tiz_os_type_id_t tiz_os_cached_id_ = TIZ_OS_TYPE_ID_INVALID; \
+    tiz_os_type_id_t tiz_os_id_                                         \
+      = __atomic_load_n (&tiz_os_cached_id_, __ATOMIC_RELAXED);         \
+    if (tiz_os_id_ < 0)                                                 \
+      {                                                                 \
+        tiz_os_id_ = tiz_os_type_id ("" a_type_name "");                \
+        __atomic_store_n (&tiz_os_cached_id_, tiz_os_id_,               \
+                          __ATOMIC_RELAXED);                            \
+      }                                                                 \
+    tiz_os_id_;                                                         \
+  }))
+
 OMX_ERRORTYPE
 tiz_os_init (tiz_os_t ** app_os, const OMX_HANDLETYPE ap_hdl,
              tiz_soa_t * ap_soa);
@@ -56,9 +79,20 @@ OMX_ERRORTYPE
 tiz_os_register_type (tiz_os_t * ap_os, const tiz_os_type_init_f a_type_init_f,
                       const OMX_STRING a_type_name);
 
+tiz_os_type_id_t
+tiz_os_type_id (const char * a_type_name);
+
+void *
+tiz_os_get_type_by_id (const tiz_os_t * ap_os,
+                       const tiz_os_type_id_t a_type_id);
+
 void *
 tiz_os_get_type (const tiz_os_t * ap_os, const char * a_type_name);
 
+/* Same as tiz_os_get_type, for a string literal type name. */
+#define TIZ_OS_GET_TYPE(ap_os, a_type_name) \
+  tiz_os_get_type_by_id ((ap_os), TIZ_OS_TYPE_ID (a_type_name))
+
 void *
 tiz_os_calloc (const tiz_os_t * ap_os, size_t a_size);
 void
@@ -52,7 +52,7 @@ static void *
 oggport_ctor (void * ap_obj, va_list * app)
 {
   tiz_oggport_t * p_obj
-    = super_ctor (typeOf (ap_obj, "tizoggport"), ap_obj, app);
+    = super_ctor (TIZ_TYPE_OF (ap_obj, "tizoggport"), ap_obj, app);
   assert (p_obj);
 
   tiz_check_omx_ret_null (
@@ -66,7 +66,7 @@ oggport_dtor (void * ap_obj)
 {
   tiz_oggport_t * p_obj = ap_obj;
   assert (p_obj);
-  return super_dtor (typeOf (ap_obj, "tizoggport"), ap_obj);
+  return super_dtor (TIZ_TYPE_OF (ap_obj, "tizoggport"), ap_obj);
 }
 
 /*
@@ -118,8 +118,8 @@ oggport_GetParameter (const void * ap_obj, OMX_HANDLETYPE ap_hdl,
       default:
         {
           /* Delegate to the base port */
-          return super_GetParameter (typeOf (ap_obj, "tizdemuxerport"), ap_obj,
-                                     ap_hdl, a_index, ap_struct);
+          return super_GetParameter (TIZ_TYPE_OF (ap_obj, "tizdemuxerport"),
+                                     ap_obj, ap_hdl, a_index, ap_struct);
         }
     };
 
@@ -151,7 +151,7 @@ oggport_SetParameter (const void * ap_obj, OMX_HANDLETYPE ap_hdl,
       default:
         {
           /* Try the parent's indexes */
-          rc = super_SetParameter (typeOf (ap_obj, "tizoggport"), ap_obj,
+          rc = super_SetParameter (TIZ_TYPE_OF (ap_obj, "tizoggport"), ap_obj,
                                    ap_hdl, a_index, ap_struct);
         }
     };
@@ -188,7 +188,7 @@ static void *
 tiz_oggport_class_ctor (void * ap_obj, va_list * app)
 {
   /* NOTE: Class methods might be added in the future. None for now. */
-  return super_ctor (typeOf (ap_obj, "tizoggport_class"), ap_obj, app);
+  return super_ctor (TIZ_TYPE_OF (ap_obj, "tizoggport_class"), ap_obj, app);
 }
 
 /*
@@ -198,7 +198,7 @@ tiz_oggport_class_ctor (void * ap_obj, va_list * app)
 void *
 tiz_oggport_class_init (void * ap_tos, void * ap_hdl)
 {
-  void * tizport = tiz_get_type (ap_hdl, "tizport");
+  void * tizport = TIZ_GET_TYPE (ap_hdl, "tizport");
   void * tizoggport_class = factory_new
     /* TIZ_CLASS_COMMENT: class type, class name, parent, size */
     (classOf (tizport), "tizoggport_class", classOf (tizport),
@@ -215,8 +215,8 @@ tiz_oggport_class_init (void * ap_tos, void * ap_hdl)
 void *
 tiz_oggport_init (void * ap_tos, void * ap_hdl)
 {
-  void * tizport = tiz_get_type (ap_hdl, "tizport");
-  void * tizoggport_class = tiz_get_type (ap_hdl, "tizoggport_class");
+  void * tizport = TIZ_GET_TYPE (ap_hdl, "tizport");
+  void * tizoggport_class = TIZ_GET_TYPE (ap_hdl, "tizoggport_class");
   TIZ_LOG_CLASS (tizoggport_class);
   void * tizoggport = factory_new
     /* TIZ_CLASS_COMMENT: class type, class name, parent, size */
@@ -51,7 +51,7 @@ static void *
 opusport_ctor (void * ap_obj, va_list * app)
 {
   tiz_opusport_t * p_obj
-    = super_ctor (typeOf (ap_obj, "tizopusport"), ap_obj, app);
+    = super_ctor (TIZ_TYPE_OF (ap_obj, "tizopusport"), ap_obj, app);
   tiz_port_t * p_base = ap_obj;
   OMX_TIZONIA_AUDIO_PARAM_OPUSTYPE * p_opusmode = NULL;
 
@@ -78,7 +78,7 @@ opusport_ctor (void * ap_obj, va_list * app)
 static void *
 opusport_dtor (void * ap_obj)
 {
-  return super_dtor (typeOf (ap_obj, "tizopusport"), ap_obj);
+  return super_dtor (TIZ_TYPE_OF (ap_obj, "tizopusport"), ap_obj);
 }
 
 /*
@@ -104,8 +104,8 @@ opusport_GetParameter (const void * ap_obj, OMX_HANDLETYPE ap_hdl,
   else
     {
       /* Try the parent's indexes */
-      return super_GetParameter (typeOf (ap_obj, "tizopusport"), ap_obj, ap_hdl,
-                                 a_index, ap_struct);
+      return super_GetParameter (TIZ_TYPE_OF (ap_obj, "tizopusport"), ap_obj,
+                                 ap_hdl, a_index, ap_struct);
     }
 
   return OMX_ErrorNone;
@@ -183,8 +183,8 @@ opusport_SetParameter (const void * ap_obj, OMX_HANDLETYPE ap_hdl,
   else
     {
       /* Try the parent's indexes */
-      return super_SetParameter (typeOf (ap_obj, "tizopusport"), ap_obj, ap_hdl,
-                                 a_index, ap_struct);
+      return super_SetParameter (TIZ_TYPE_OF (ap_obj, "tizopusport"), ap_obj,
+                                 ap_hdl, a_index, ap_struct);
     }
 
   return OMX_ErrorNone;
@@ -391,7 +391,7 @@ static void *
 opusport_class_ctor (void * ap_obj, va_list * app)
 {
   /* NOTE: Class methods might be added in the future. None for now. */
-  return super_ctor (typeOf (ap_obj, "tizopusport_class"), ap_obj, app);
+  return super_ctor (TIZ_TYPE_OF (ap_obj, "tizopusport_class"), ap_obj, app);
 }
 
 /*
@@ -401,7 +401,7 @@ opusport_class_ctor (void * ap_obj, va_list * app)
 void *
 tiz_opusport_class_init (void * ap_tos, void * ap_hdl)
 {
-  void * tizaudioport = tiz_get_type (ap_hdl, "tizaudioport");
+  void * tizaudioport = TIZ_GET_TYPE (ap_hdl, "tizaudioport");
   void * tizopusport_class = factory_new
     /* TIZ_CLASS_COMMENT: class type, class name, parent, size */
     (classOf (tizaudioport), "tizopusport_class", classOf (tizaudioport),
@@ -418,8 +418,8 @@ tiz_opusport_class_init (void * ap_tos, void * ap_hdl)
 void *
 tiz_opusport_init (void * ap_tos, void * ap_hdl)
 {
-  void * tizaudioport = tiz_get_type (ap_hdl, "tizaudioport");
-  void * tizopusport_class = tiz_get_type (ap_hdl, "tizopusport_class");
+  void * tizaudioport = TIZ_GET_TYPE (ap_hdl, "tizaudioport");
+  void * tizopusport_class = TIZ_GET_TYPE (ap_hdl, "tizopusport_class");
   TIZ_LOG_CLASS (tizopusport_class);
   void * tizopusport = factory_new
     /* TIZ_CLASS_COMMENT: class type, class name, parent, size */
@@ -51,7 +51,7 @@ static void *
 otherport_ctor (void * ap_obj, va_list * app)
 {
   tiz_otherport_t * p_obj
-    = super_ctor (typeOf (ap_obj, "tizotherport"), ap_obj, app);
+    = super_ctor (TIZ_TYPE_OF (ap_obj, "tizotherport"), ap_obj, app);
   OMX_OTHER_FORMATTYPE * p_formats = NULL;
 
   tiz_port_register_index (p_obj, OMX_IndexParamOtherPortFormat);
@@ -86,7 +86,7 @@ otherport_dtor (void * ap_obj)
   tiz_vector_clear (p_obj->p_formats_);
   tiz_vector_destroy (p_obj->p_formats_);
 
-  return super_dtor (typeOf (ap_obj, "tizotherport"), ap_obj);
+  return super_dtor (TIZ_TYPE_OF (ap_obj, "tizotherport"), ap_obj);
 }
 
 /*
@@ -125,8 +125,8 @@ otherport_GetParameter (const void * ap_obj, OMX_HANDLETYPE ap_hdl,
       default:
         {
           /* Try the parent's indexes */
-          return super_GetParameter (typeOf (ap_obj, "tizotherport"), ap_obj,
-                                     ap_hdl, a_index, ap_struct);
+          return super_GetParameter (TIZ_TYPE_OF (ap_obj, "tizotherport"),
+                                     ap_obj, ap_hdl, a_index, ap_struct);
         }
     };
 
@@ -182,8 +182,8 @@ otherport_SetParameter (const void * ap_obj, OMX_HANDLETYPE ap_hdl,
       default:
         {
           /* Try the parent's indexes */
-          return super_SetParameter (typeOf (ap_obj, "tizotherport"), ap_obj,
-                                     ap_hdl, a_index, ap_struct);
+          return super_SetParameter (TIZ_TYPE_OF (ap_obj, "tizotherport"),
+                                     ap_obj, ap_hdl, a_index, ap_struct);
         }
     };
 
@@ -198,7 +198,7 @@ static void *
 otherport_class_ctor (void * ap_obj, va_list * app)
 {
   /* NOTE: Class methods might be added in the future. None for now. */
-  return super_ctor (typeOf (ap_obj, "tizotherport_class"), ap_obj, app);
+  return super_ctor (TIZ_TYPE_OF (ap_obj, "tizotherport_class"), ap_obj, app);
 }
 
 /*
@@ -208,7 +208,7 @@ otherport_class_ctor (void * ap_obj, va_list * app)
 void *
 tiz_otherport_class_init (void * ap_tos, void * ap_hdl)
 {
-  void * tizport = tiz_get_type (ap_hdl, "tizport");
+  void * tizport = TIZ_GET_TYPE (ap_hdl, "tizport");
   void * tizotherport_class = factory_new
     /* TIZ_CLASS_COMMENT: class type, class name, parent, size */
     (classOf (tizport), "tizotherport_class", classOf (tizport),
@@ -225,8 +225,8 @@ tiz_otherport_class_init (void * ap_tos, void * ap_hdl)
 void *
 tiz_otherport_init (void * ap_tos, void * ap_hdl)
 {
-  void * tizport = tiz_get_type (ap_hdl, "tizport");
-  void * tizotherport_class = tiz_get_type (ap_hdl, "tizotherport_class");
+  void * tizport = TIZ_GET_TYPE (ap_hdl, "tizport");
+  void * tizotherport_class = TIZ_GET_TYPE (ap_hdl, "tizotherport_class");
   TIZ_LOG_CLASS (tizotherport_class);
   void * tizotherport = factory_new
     /* TIZ_CLASS_COMMENT: class type, class name, parent, size */
@@ -50,14 +50,15 @@
 static void *
 pause_ctor (void * ap_obj, va_list * app)
 {
-  tiz_pause_t * p_obj = super_ctor (typeOf (ap_obj, "tizpause"), ap_obj, app);
+  tiz_pause_t * p_obj = super_ctor (TIZ_TYPE_OF (ap_obj, "tizpause"), ap_obj,
+                                    app);
   return p_obj;
 }
 
 static void *
 pause_dtor (void * ap_obj)
 {
-  return super_dtor (typeOf (ap_obj, "tizpause"), ap_obj);
+  return super_dtor (TIZ_TYPE_OF (ap_obj, "tizpause"), ap_obj);
 }
 
 static OMX_ERRORTYPE
@@ -214,8 +215,8 @@ pause_state_set (const void * ap_obj, OMX_HANDLETYPE ap_hdl,
       }
     }
 
-  return tiz_state_super_state_set (typeOf (ap_obj, "tizpause"), ap_obj, ap_hdl,
-                                    a_cmd, a_param1, ap_cmd_data);
+  return tiz_state_super_state_set (TIZ_TYPE_OF (ap_obj, "tizpause"), ap_obj,
+                                    ap_hdl, a_cmd, a_param1, ap_cmd_data);
 }
 
 static OMX_ERRORTYPE
@@ -236,8 +237,8 @@ pause_trans_complete (const void * ap_obj, OMX_PTR ap_servant,
              tiz_fsm_state_to_str ((tiz_fsm_state_id_t) a_new_state));
   assert (OMX_StatePause == a_new_state || OMX_StateIdle == a_new_state
           || OMX_StateExecuting == a_new_state);
-  return tiz_state_super_trans_complete (typeOf (ap_obj, "tizpause"), ap_obj,
-                                         ap_servant, a_new_state);
+  return tiz_state_super_trans_complete (TIZ_TYPE_OF (ap_obj, "tizpause"),
+                                         ap_obj, ap_servant, a_new_state);
 }
 
 /*
@@ -248,7 +249,7 @@ static void *
 pause_class_ctor (void * ap_obj, va_list * app)
 {
   /* NOTE: Class methods might be added in the future. None for now. */
-  return super_ctor (typeOf (ap_obj, "tizpause_class"), ap_obj, app);
+  return super_ctor (TIZ_TYPE_OF (ap_obj, "tizpause_class"), ap_obj, app);
 }
 
 /*
@@ -258,7 +259,7 @@ pause_class_ctor (void * ap_obj, va_list * app)
 void *
 tiz_pause_class_init (void * ap_tos, void * ap_hdl)
 {
-  void * tizstate = tiz_get_type (ap_hdl, "tizstate");
+  void * tizstate = TIZ_GET_TYPE (ap_hdl, "tizstate");
   void * tizpause_class = factory_new (
     classOf (tizstate), "tizpause_class", classOf (tizstate),
     sizeof (tiz_pause_class_t), ap_tos, ap_hdl, ctor, pause_class_ctor, 0);
@@ -268,8 +269,8 @@ tiz_pause_class_init (void * ap_tos, void * ap_hdl)
 void *
 tiz_pause_init (void * ap_tos, void * ap_hdl)
 {
-  void * tizstate = tiz_get_type (ap_hdl, "tizstate");
-  void * tizpause_class = tiz_get_type (ap_hdl, "tizpause_class");
+  void * tizstate = TIZ_GET_TYPE (ap_hdl, "tizstate");
+  void * tizpause_class = TIZ_GET_TYPE (ap_hdl, "tizpause_class");
   TIZ_LOG_CLASS (tizpause_class);
   void * tizpause = factory_new (
     tizpause_class, "tizpause", tizstate, sizeof (tiz_pause_t), ap_tos, ap_hdl,
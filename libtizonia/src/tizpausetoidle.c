@@ -49,14 +49,14 @@ static void *
 pausetoidle_ctor (void * ap_obj, va_list * app)
 {
   tiz_pausetoidle_t * p_obj
-    = super_ctor (typeOf (ap_obj, "tizpausetoidle"), ap_obj, app);
+    = super_ctor (TIZ_TYPE_OF (ap_obj, "tizpausetoidle"), ap_obj, app);
   return p_obj;
 }
 
 static void *
 pausetoidle_dtor (void * ap_obj)
 {
-  return super_dtor (typeOf (ap_obj, "tizpausetoidle"), ap_obj);
+  return super_dtor (TIZ_TYPE_OF (ap_obj, "tizpausetoidle"), ap_obj);
 }
 
 static OMX_ERRORTYPE
@@ -103,7 +103,7 @@ pausetoidle_trans_complete (const void * ap_obj, OMX_PTR ap_servant,
         OMX_TIZONIA_PORTSTATUS_AWAITBUFFERSRETURN);
     }
 
-  return tiz_state_super_trans_complete (typeOf (ap_obj, "tizpausetoidle"),
+  return tiz_state_super_trans_complete (TIZ_TYPE_OF (ap_obj, "tizpausetoidle"),
                                          ap_obj, ap_servant, a_new_state);
 }
 
@@ -125,8 +125,8 @@ pausetoidle_tunneled_ports_status_update (void * ap_obj)
          * 'tiz_state_state_set' function of the tiz_state_t base class (note
          * we are passing 'tizidle' as 1st parameter */
         TIZ_TRACE (p_hdl, "kernel may initiate pause to idle");
-        return tiz_state_super_state_set (typeOf (ap_obj, "tizidle"), ap_obj,
-                                          p_hdl, OMX_CommandStateSet,
+        return tiz_state_super_state_set (TIZ_TYPE_OF (ap_obj, "tizidle"),
+                                          ap_obj, p_hdl, OMX_CommandStateSet,
                                           OMX_StateIdle, NULL);
       }
   }
@@ -142,7 +142,7 @@ static void *
 pausetoidle_class_ctor (void * ap_obj, va_list * app)
 {
   /* NOTE: Class methods might be added in the future. None for now. */
-  return super_ctor (typeOf (ap_obj, "tizpausetoidle_class"), ap_obj, app);
+  return super_ctor (TIZ_TYPE_OF (ap_obj, "tizpausetoidle_class"), ap_obj, app);
 }
 
 /*
@@ -152,7 +152,7 @@ pausetoidle_class_ctor (void * ap_obj, va_list * app)
 void *
 tiz_pausetoidle_class_init (void * ap_tos, void * ap_hdl)
 {
-  void * tizpause = tiz_get_type (ap_hdl, "tizpause");
+  void * tizpause = TIZ_GET_TYPE (ap_hdl, "tizpause");
   void * tizpausetoidle_class
     = factory_new (classOf (tizpause), "tizpausetoidle_class",
                    classOf (tizpause), sizeof (tiz_pausetoidle_class_t), ap_tos,
@@ -162,8 +162,8 @@ tiz_pausetoidle_class_init (void * ap_tos, void * ap_hdl)
 void *
 tiz_pausetoidle_init (void * ap_tos, void * ap_hdl)
 {
-  void * tizpause = tiz_get_type (ap_hdl, "tizpause");
-  void * tizpausetoidle_class = tiz_get_type (ap_hdl, "tizpausetoidle_class");
+  void * tizpause = TIZ_GET_TYPE (ap_hdl, "tizpause");
+  void * tizpausetoidle_class = TIZ_GET_TYPE (ap_hdl, "tizpausetoidle_class");
   TIZ_LOG_CLASS (tizpausetoidle_class);
   void * tizpausetoidle = factory_new (
     tizpausetoidle_class, "tizpausetoidle", tizpause,
@@ -128,7 +128,7 @@ pcmport_SetParameter_common (const void * ap_obj, OMX_HANDLETYPE ap_hdl,
       default:
         {
           /* Try the parent's indexes */
-          return super_SetParameter (typeOf (ap_obj, "tizpcmport"), ap_obj,
+          return super_SetParameter (TIZ_TYPE_OF (ap_obj, "tizpcmport"), ap_obj,
                                      ap_hdl, a_index, ap_struct);
         }
     };
@@ -144,7 +144,7 @@ static void *
 pcmport_ctor (void * ap_obj, va_list * app)
 {
   tiz_pcmport_t * p_obj
-    = super_ctor (typeOf (ap_obj, "tizpcmport"), ap_obj, app);
+    = super_ctor (TIZ_TYPE_OF (ap_obj, "tizpcmport"), ap_obj, app);
   tiz_port_t * p_base = ap_obj;
   OMX_AUDIO_PARAM_PCMMODETYPE * p_pcmmode = NULL;
   OMX_AUDIO_CONFIG_VOLUMETYPE * p_volume = NULL;
@@ -201,7 +201,7 @@ pcmport_ctor (void * ap_obj, va_list * app)
 static void *
 pcmport_dtor (void * ap_obj)
 {
-  return super_dtor (typeOf (ap_obj, "tizpcmport"), ap_obj);
+  return super_dtor (TIZ_TYPE_OF (ap_obj, "tizpcmport"), ap_obj);
 }
 
 /*
@@ -236,7 +236,7 @@ pcmport_GetParameter (const void * ap_obj, OMX_HANDLETYPE ap_hdl,
       default:
         {
           /* Try the parent's indexes */
-          return super_GetParameter (typeOf (ap_obj, "tizpcmport"), ap_obj,
+          return super_GetParameter (TIZ_TYPE_OF (ap_obj, "tizpcmport"), ap_obj,
                                      ap_hdl, a_index, ap_struct);
         }
     };
@@ -288,7 +288,7 @@ pcmport_SetParameter (const void * ap_obj, OMX_HANDLETYPE ap_hdl,
       default:
         {
           /* Try the parent's indexes */
-          rc = super_SetParameter (typeOf (ap_obj, "tizpcmport"), ap_obj,
+          rc = super_SetParameter (TIZ_TYPE_OF (ap_obj, "tizpcmport"), ap_obj,
                                    ap_hdl, a_index, ap_struct);
         }
     };
@@ -326,8 +326,8 @@ pcmport_GetConfig (const void * ap_obj, OMX_HANDLETYPE ap_hdl,
       default:
         {
           /* Try the parent's indexes */
-          return super_GetConfig (typeOf (ap_obj, "tizpcmport"), ap_obj, ap_hdl,
-                                  a_index, ap_struct);
+          return super_GetConfig (TIZ_TYPE_OF (ap_obj, "tizpcmport"), ap_obj,
+                                  ap_hdl, a_index, ap_struct);
         }
     };
 
@@ -383,8 +383,8 @@ pcmport_SetConfig (const void * ap_obj, OMX_HANDLETYPE ap_hdl,
       default:
         {
           /* Try the parent's indexes */
-          rc = super_SetConfig (typeOf (ap_obj, "tizpcmport"), ap_obj, ap_hdl,
-                                a_index, ap_struct);
+          rc = super_SetConfig (TIZ_TYPE_OF (ap_obj, "tizpcmport"), ap_obj,
+                                ap_hdl, a_index, ap_struct);
         }
         break;
     };
@@ -414,7 +414,7 @@ pcmport_SetParameter_internal (const void * ap_obj, OMX_HANDLETYPE ap_hdl,
       default:
         {
           /* Try the parent's indexes */
-          rc = super_SetParameter (typeOf (ap_obj, "tizpcmport"), ap_obj,
+          rc = super_SetParameter (TIZ_TYPE_OF (ap_obj, "tizpcmport"), ap_obj,
                                    ap_hdl, a_index, ap_struct);
         }
         break;
@@ -706,7 +706,7 @@ static void *
 pcmport_class_ctor (void * ap_obj, va_list * app)
 {
   /* NOTE: Class methods might be added in the future. None for now. */
-  return super_ctor (typeOf (ap_obj, "tizpcmport_class"), ap_obj, app);
+  return super_ctor (TIZ_TYPE_OF (ap_obj, "tizpcmport_class"), ap_obj, app);
 }
 
 /*
@@ -716,7 +716,7 @@ pcmport_class_ctor (void * ap_obj, va_list * app)
 void *
 tiz_pcmport_class_init (void * ap_tos, void * ap_hdl)
 {
-  void * tizaudioport = tiz_get_type (ap_hdl, "tizaudioport");
+  void * tizaudioport = TIZ_GET_TYPE (ap_hdl, "tizaudioport");
   void * tizpcmport_class = factory_new
     /* TIZ_CLASS_COMMENT: class type, class name, parent, size */
     (classOf (tizaudioport), "tizpcmport_class", classOf (tizaudioport),
@@ -733,8 +733,8 @@ tiz_pcmport_class_init (void * ap_tos, void * ap_hdl)
 void *
 tiz_pcmport_init (void * ap_tos, void * ap_hdl)
 {
-  void * tizaudioport = tiz_get_type (ap_hdl, "tizaudioport");
-  void * tizpcmport_class = tiz_get_type (ap_hdl, "tizpcmport_class");
+  void * tizaudioport = TIZ_GET_TYPE (ap_hdl, "tizaudioport");
+  void * tizpcmport_class = TIZ_GET_TYPE (ap_hdl, "tizpcmport_class");
   TIZ_LOG_CLASS (tizpcmport_class);
   void * tizpcmport = factory_new
     /* TIZ_CLASS_COMMENT: class type, class name, parent, size */
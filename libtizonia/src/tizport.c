@@ -43,6 +43,7 @@
 #include "tizport-macros.h"
 #include "tizport.h"
 #include "tizport_decls.h"
+#include "tizprobe.h"
 
 #ifdef TIZ_LOG_CATEGORY_NAME
 #undef TIZ_LOG_CATEGORY_NAME
@@ -170,7 +171,7 @@ default_alloc_hook (OMX_U32 * ap_size, OMX_PTR * app_port_priv, void * ap_args)
 {
   OMX_U8 * p = NULL;
   assert (ap_size && *ap_size > 0);
-  p = tiz_mem_calloc ((size_t) *ap_size, sizeof (OMX_U8));
+  p = tiz_bufpool_alloc ((size_t) *ap_size);
   return p;
 }
 
@@ -178,7 +179,7 @@ static void
 default_free_hook (OMX_PTR ap_buf, OMX_PTR ap_port_priv, void * ap_args)
 {
   assert (ap_buf);
-  tiz_mem_free (ap_buf);
+  tiz_bufpool_free (ap_buf);
 }
 
 static OMX_ERRORTYPE
@@ -308,7 +309,8 @@ unregister_header (const void * ap_obj, OMX_S32 hdr_pos)
 static void *
 port_ctor (void * ap_obj, va_list * app)
 {
-  tiz_port_t * p_obj = super_ctor (typeOf (ap_obj, "tizport"), ap_obj, app);
+  tiz_port_t * p_obj = super_ctor (TIZ_TYPE_OF (ap_obj, "tizport"), ap_obj,
+                                   app);
   tiz_port_options_t * p_opts = NULL;
   OMX_BOOL supplier = OMX_FALSE;
   OMX_INDEXTYPE id1 = OMX_IndexParamPortDefinition;
@@ -434,7 +436,7 @@ port_dtor (void * ap_obj)
   tiz_vector_clear (p_obj->p_marks_);
   tiz_vector_destroy (p_obj->p_marks_);
 
-  return super_dtor (typeOf (ap_obj, "tizport"), ap_obj);
+  return super_dtor (TIZ_TYPE_OF (ap_obj, "tizport"), ap_obj);
 }
 
 /*
@@ -1767,8 +1769,14 @@ OMX_ERRORTYPE
 tiz_port_populate (const void * ap_obj)
 {
   const tiz_port_class_t * class = classOf (ap_obj);
+  const tiz_port_t * p_obj = ap_obj;
+  OMX_ERRORTYPE rc = OMX_ErrorNone;
   assert (class->populate);
-  return class->populate (ap_obj);
+  TIZ_PROBE2 (port__populate__start, handleOf (ap_obj), p_obj->pid_);
+  rc = class->populate (ap_obj);
+  TIZ_PROBE4 (port__populate__done, handleOf (ap_obj), p_obj->pid_,
+              tiz_vector_length (p_obj->p_hdrs_info_), rc);
+  return rc;
 }
 
 OMX_ERRORTYPE
@@ -2327,7 +2335,7 @@ static void *
 port_class_ctor (void * ap_obj, va_list * app)
 {
   tiz_port_class_t * p_obj
-    = super_ctor (typeOf (ap_obj, "tizport_class"), ap_obj, app);
+    = super_ctor (TIZ_TYPE_OF (ap_obj, "tizport_class"), ap_obj, app);
   typedef void (*voidf) ();
   voidf selector = NULL;
   va_list ap;
@@ -2480,7 +2488,7 @@ port_class_ctor (void * ap_obj, va_list * app)
 void *
 tiz_port_class_init (void * ap_tos, void * ap_hdl)
 {
-  void * tizapi = tiz_get_type (ap_hdl, "tizapi");
+  void * tizapi = TIZ_GET_TYPE (ap_hdl, "tizapi");
   void * tizport_class = factory_new
     /* TIZ_CLASS_COMMENT: class type, class name, parent, size */
     (classOf (tizapi), "tizport_class", classOf (tizapi),
@@ -2497,8 +2505,8 @@ tiz_port_class_init (void * ap_tos, void * ap_hdl)
 void *
 tiz_port_init (void * ap_tos, void * ap_hdl)
 {
-  void * tizapi = tiz_get_type (ap_hdl, "tizapi");
-  void * tizport_class = tiz_get_type (ap_hdl, "tizport_class");
+  void * tizapi = TIZ_GET_TYPE (ap_hdl, "tizapi");
+  void * tizport_class = TIZ_GET_TYPE (ap_hdl, "tizport_class");
   TIZ_LOG_CLASS (tizport_class);
   void * tizport = factory_new
     /* TIZ_CLASS_COMMENT: class type, class name, parent, size */
@@ -299,8 +299,11 @@ dispatch_br (void * ap_obj, OMX_PTR ap_msg)
       && ESubStatePauseToIdle != now && !TIZ_PORT_IS_DISABLED (p_port)
       && !TIZ_PORT_IS_BEING_DISABLED (p_port))
     {
+      const OMX_U64 start = tiz_monotonic_ns ();
       TIZ_TRACE (p_msg->p_hdl, "p_msg_br->p_buffer [%p] ", p_msg_br->p_buffer);
       rc = tiz_prc_buffers_ready (p_obj);
+      p_obj->br_calls_++;
+      p_obj->br_ns_ += tiz_monotonic_ns () - start;
     }
 
   return rc;
@@ -537,13 +540,16 @@ remove_buffer_from_servant_queue (OMX_PTR ap_elem, OMX_S32 a_data1,
 static void *
 prc_ctor (void * ap_obj, va_list * app)
 {
-  return super_ctor (typeOf (ap_obj, "tizprc"), ap_obj, app);
+  tiz_prc_t * p_obj = super_ctor (TIZ_TYPE_OF (ap_obj, "tizprc"), ap_obj, app);
+  p_obj->br_calls_ = 0;
+  p_obj->br_ns_ = 0;
+  return p_obj;
 }
 
 static void *
 prc_dtor (void * ap_obj)
 {
-  return super_dtor (typeOf (ap_obj, "tizprc"), ap_obj);
+  return super_dtor (TIZ_TYPE_OF (ap_obj, "tizprc"), ap_obj);
 }
 
 /*
@@ -631,7 +637,7 @@ prc_remove_from_queue (const void * ap_obj, tiz_pq_func_f apf_func,
   tiz_srv_t * p_obj = (tiz_srv_t *) ap_obj;
   /* Actual implementation is in the parent class */
   /* Replace dummy parameters apf_func and a_data1 */
-  tiz_srv_super_remove_from_queue (typeOf (ap_obj, "tizprc"), p_obj,
+  tiz_srv_super_remove_from_queue (TIZ_TYPE_OF (ap_obj, "tizprc"), p_obj,
                                    &remove_buffer_from_servant_queue,
                                    ETIZPrcMsgBuffersReady, ap_data2);
 }
@@ -816,6 +822,27 @@ tiz_prc_config_change (const void * ap_obj, OMX_U32 a_pid,
   return class->config_change (ap_obj, a_pid, a_config_idx);
 }
 
+OMX_ERRORTYPE
+tiz_prc_get_perf_stats (const void * ap_obj,
+                        OMX_TIZONIA_PERFSTATSTYPE * ap_stats)
+{
+  const tiz_prc_t * p_obj = ap_obj;
+  assert (p_obj);
+  assert (ap_stats);
+  ap_stats->nBuffersReadyCalls += p_obj->br_calls_;
+  ap_stats->nBuffersReadyNs += p_obj->br_ns_;
+  return OMX_ErrorNone;
+}
+
+void
+tiz_prc_reset_perf_stats (void * ap_obj)
+{
+  tiz_prc_t * p_obj = ap_obj;
+  assert (p_obj);
+  p_obj->br_calls_ = 0;
+  p_obj->br_ns_ = 0;
+}
+
 /*
  * tizprc_class
  */
@@ -824,7 +851,7 @@ static void *
 prc_class_ctor (void * ap_obj, va_list * app)
 {
   tiz_prc_class_t * p_obj
-    = super_ctor (typeOf (ap_obj, "tizprc_class"), ap_obj, app);
+    = super_ctor (TIZ_TYPE_OF (ap_obj, "tizprc_class"), ap_obj, app);
   typedef void (*voidf) ();
   voidf selector = NULL;
   va_list ap;
@@ -878,7 +905,7 @@ prc_class_ctor (void * ap_obj, va_list * app)
 void *
 tiz_prc_class_init (void * ap_tos, void * ap_hdl)
 {
-  void * tizsrv = tiz_get_type (ap_hdl, "tizsrv");
+  void * tizsrv = TIZ_GET_TYPE (ap_hdl, "tizsrv");
   void * tizprc_class = factory_new
     /* TIZ_CLASS_COMMENT: class type, class name, parent, size */
     (classOf (tizsrv), "tizprc_class", classOf (tizsrv),
@@ -895,8 +922,8 @@ tiz_prc_class_init (void * ap_tos, void * ap_hdl)
 void *
 tiz_prc_init (void * ap_tos, void * ap_hdl)
 {
-  void * tizsrv = tiz_get_type (ap_hdl, "tizsrv");
-  void * tizprc_class = tiz_get_type (ap_hdl, "tizprc_class");
+  void * tizsrv = TIZ_GET_TYPE (ap_hdl, "tizsrv");
+  void * tizprc_class = TIZ_GET_TYPE (ap_hdl, "tizprc_class");
   TIZ_LOG_CLASS (tizprc_class);
   void * tizprc = factory_new
     /* TIZ_CLASS_COMMENT: class type, class name, parent, size */
@@ -39,6 +39,7 @@ extern "C" {
  * @ingroup libtizonia
  */
 
+#include <OMX_TizoniaExt.h>
 #include <tizplatform.h>
 
 void *
@@ -61,6 +62,13 @@ tiz_prc_port_enable (const void * ap_obj, OMX_U32 a_pid);
 OMX_ERRORTYPE
 tiz_prc_config_change (const void * ap_obj, OMX_U32 a_pid,
                        OMX_INDEXTYPE a_config_idx);
+
+OMX_ERRORTYPE
+tiz_prc_get_perf_stats (const void * ap_obj,
+                        OMX_TIZONIA_PERFSTATSTYPE * ap_stats);
+void
+tiz_prc_reset_perf_stats (void * ap_obj);
+
 #ifdef __cplusplus
 }
 #endif
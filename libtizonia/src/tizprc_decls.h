@@ -43,6 +43,8 @@ struct tiz_prc
 {
   /* Object */
   const tiz_srv_t _;
+  OMX_U64 br_calls_;
+  OMX_U64 br_ns_;
 };
 
 OMX_ERRORTYPE
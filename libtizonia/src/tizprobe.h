@@ -0,0 +1,97 @@
+/**
+ * Copyright (C) 2011-2020 Aratelia Limited - Juan A. Rubio and contributors
+ *
+ * This file is part of Tizonia
+ *
+ * Tizonia is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Tizonia is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Tizonia.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file   tizprobe.h
+ * @author Juan A. Rubio <juan.rubio@aratelia.com>
+ *
+ * @brief  Tizonia OpenMAX IL - Static tracepoints (USDT)
+ *
+ * Statically-defined tracepoints on the IL hot paths. When <sys/sdt.h> is
+ * available, each probe is a single nop instruction plus an ELF note; tools
+ * like bpftrace, perf or SystemTap can attach to it at run time. Otherwise,
+ * or when TIZ_DISABLE_PROBES is defined, the probes compile to nothing and
+ * their arguments are not evaluated.
+ *
+ * This header is installed for plugins to use, so it does not rely on
+ * config.h: the header is looked for with __has_include. HAVE_SYS_SDT_H is
+ * only consulted by compilers that lack __has_include.
+ *
+ * All the probes belong to the 'tizonia' provider. The first argument is
+ * always the component handle:
+ *
+ * - sched__dispatch__start (hdl, msg class)
+ * - sched__dispatch__done (hdl, msg class, OMX_ERRORTYPE)
+ * - servant__tick__start (hdl, servant)
+ * - servant__tick__done (hdl, servant, number of ticks)
+ * - buffer__claim (hdl, pid, header, nFilledLen)
+ * - buffer__release (hdl, pid, header, nFilledLen)
+ * - port__populate__start (hdl, pid)
+ * - port__populate__done (hdl, pid, number of buffers, OMX_ERRORTYPE)
+ * - fsm__transition (hdl, old state, new state)
+ * - render__start (hdl, header, number of bytes to render)
+ * - render__done (hdl, header, OMX_ERRORTYPE)
+ *
+ * E.g., time from claim to release of every buffer, per component:
+ *
+ *   bpftrace -e 'usdt:/usr/lib/libtizonia.so.0:tizonia:buffer__claim
+ *     { @t[arg2] = nsecs; }
+ *   usdt:/usr/lib/libtizonia.so.0:tizonia:buffer__release /@t[arg2]/
+ *     { @us[arg0] = hist((nsecs - @t[arg2]) / 1000); delete(@t[arg2]); }'
+ *
+ */
+
+#ifndef TIZPROBE_H
+#define TIZPROBE_H
+
+#if !defined(TIZ_DISABLE_PROBES)
+#if defined(__has_include)
+#if __has_include(<sys/sdt.h>)
+#define TIZ_PROBES_ENABLED 1
+#endif
+#elif defined(HAVE_SYS_SDT_H)
+#define TIZ_PROBES_ENABLED 1
+#endif
+#endif
+
+#ifdef TIZ_PROBES_ENABLED
+
+#include <sys/sdt.h>
+
+#define TIZ_PROBE1(name, a1) DTRACE_PROBE1 (tizonia, name, a1)
+#define TIZ_PROBE2(name, a1, a2) DTRACE_PROBE2 (tizonia, name, a1, a2)
+#define TIZ_PROBE3(name, a1, a2, a3) DTRACE_PROBE3 (tizonia, name, a1, a2, a3)
+#define TIZ_PROBE4(name, a1, a2, a3, a4) \
+  DTRACE_PROBE4 (tizonia, name, a1, a2, a3, a4)
+
+#else
+
+/* The arguments are operands of sizeof, so they are type-checked but never
+   evaluated. */
+#define TIZ_PROBE1(name, a1) ((void) sizeof (a1))
+#define TIZ_PROBE2(name, a1, a2) ((void) sizeof (a1), (void) sizeof (a2))
+#define TIZ_PROBE3(name, a1, a2, a3) \
+  ((void) sizeof (a1), (void) sizeof (a2), (void) sizeof (a3))
+#define TIZ_PROBE4(name, a1, a2, a3, a4)                     \
+  ((void) sizeof (a1), (void) sizeof (a2), (void) sizeof (a3), \
+   (void) sizeof (a4))
+
+#endif
+
+#endif /* TIZPROBE_H */
@@ -31,7 +31,10 @@
 #endif
 
 #include <assert.h>
+#include <stdlib.h>
 #include <string.h>
+#include <pthread.h>
+#include <time.h>
 
 #include <OMX_Core.h>
 #include <OMX_Component.h>
@@ -47,6 +50,7 @@
 #include "tizport.h"
 #include "tizobjsys.h"
 #include "tizscheduler.h"
+#include "tizprobe.h"
 
 #ifdef TIZ_LOG_CATEGORY_NAME
 #undef TIZ_LOG_CATEGORY_NAME
@@ -54,7 +58,15 @@
 #endif
 
 #define SCHED_OMX_DEFAULT_ROLE "default"
-#define SCHED_QUEUE_MAX_ITEMS 30
+#define SCHED_QUEUE_MAX_ITEMS 32
+#define SCHED_MSG_POOL_CHUNK_ITEMS 32
+#define SCHED_MSG_POOL_MAX_CHUNKS 32
+#define SCHED_WPOOL_THREAD_NAME "tizschedpool"
+#define SCHED_WPOOL_MAX_MSGS_PER_RUN 64
+#define SCHED_TUNNEL_RING_SIZE 64 /* must be a power of two */
+#define SCHED_CACHE_LINE_SIZE 64
+#define SCHED_TICK_BUDGET_DEFAULT 16
+#define SCHED_TICK_USEC_DEFAULT 2000
 
 #ifndef S_SPLINT_S
 #define TIZ_COMP_INIT_MSG(hdl, msg, msgtype)         \
@@ -102,11 +114,22 @@ enum tiz_sched_state
   ETIZSchedStateRolesRegistered,
 };
 
+/* Only used in worker pool mode (see the 'component-scheduler' key in
+   tizonia.conf) */
+typedef enum tiz_sched_run_state tiz_sched_run_state_t;
+enum tiz_sched_run_state
+{
+  ETIZSchedRunIdle = 0,
+  ETIZSchedRunQueued,
+  ETIZSchedRunRunning,
+  ETIZSchedRunRunningNotified,
+};
+
 typedef struct tiz_role_info tiz_role_info_t;
 struct tiz_role_info
 {
   tiz_role_factory_t * p_rf;
-  tiz_map_t * p_role_eglimage_hooks_map;
+  tiz_hmap_t * p_role_eglimage_hooks_map;
 };
 
 typedef struct tiz_srv_group tiz_srv_group_t;
@@ -117,33 +140,36 @@ struct tiz_srv_group
   void * p_prc;
   tiz_role_info_t ** p_role_list;
   OMX_U32 nroles;
-  tiz_map_t * p_alloc_hooks_map;
-  tiz_map_t * p_eglimage_hooks_map;
+  tiz_hmap_t * p_alloc_hooks_map;
+  tiz_hmap_t * p_eglimage_hooks_map;
   OMX_COMPONENTTYPE * p_hdl;
 };
 
-typedef struct tiz_scheduler tiz_scheduler_t;
-struct tiz_scheduler
+/* Scheduler messages are recycled through a per-scheduler pool. The pool is a
+   set of fixed-size chunks of message slots, and the free slots are linked in
+   a lock-free (Treiber) stack, so that client threads and the scheduler thread
+   can take and return messages without locking. The stack head packs an ABA
+   tag (upper 32 bits) and the index + 1 of the top slot (lower 32 bits, 0
+   meaning empty). */
+typedef struct tiz_sched_msg_slot tiz_sched_msg_slot_t;
+
+typedef struct tiz_sched_msg_pool tiz_sched_msg_pool_t;
+struct tiz_sched_msg_pool
 {
-  /* TODO: Reconsider the implementation of the buffer for the component's
-     name */
-  char cname[OMX_MAX_STRINGNAME_SIZE + 4096];
-  tiz_thread_t thread;
-  OMX_S32 thread_id;
-  tiz_mutex_t mutex;
-  tiz_sem_t sem;
-  tiz_queue_t * p_queue;
-  tiz_soa_t * p_soa;
-  tiz_os_t * p_objsys;
-  OMX_S32 error;
-  tiz_srv_group_t child;
-  tiz_sched_state_t state;
-  OMX_PTR
-  appdata; /* For use during setting of the component callbacks, not owned */
-  OMX_CALLBACKTYPE *
-    cbacks; /* For use during setting of the component callbacks, not owned */
+  tiz_sched_msg_slot_t * p_chunks[SCHED_MSG_POOL_MAX_CHUNKS];
+  OMX_U32 nchunks;
+  uint64_t head;
+  OMX_U32 hits;
+  OMX_U32 misses;
 };
 
+/* Buffer headers returned by a tunneled Tizonia component living in the same
+   process are handed over to the peer through a single-producer,
+   single-consumer ring per peer port, instead of one ETB/FTB message per
+   header. The producer only posts a ETIZSchedMsgTunnelBuffers message when it
+   finds the ring 'idle', i.e. when the consumer has already drained it. */
+typedef struct tiz_sched_tunnel_ring tiz_sched_tunnel_ring_t;
+
 typedef enum tiz_sched_msg_class tiz_sched_msg_class_t;
 enum tiz_sched_msg_class
 {
@@ -175,9 +201,47 @@ enum tiz_sched_msg_class
   ETIZSchedMsgEvIo,
   ETIZSchedMsgEvTimer,
   ETIZSchedMsgEvStat,
+  ETIZSchedMsgTunnelBuffers,
+  ETIZSchedMsgBufferBatch,
   ETIZSchedMsgMax,
 };
 
+typedef struct tiz_scheduler tiz_scheduler_t;
+struct tiz_scheduler
+{
+  /* TODO: Reconsider the implementation of the buffer for the component's
+     name */
+  char cname[OMX_MAX_STRINGNAME_SIZE + 4096];
+  tiz_thread_t thread;
+  OMX_S32 thread_id;
+  tiz_mutex_t mutex;
+  tiz_sem_t sem;
+  tiz_mpscq_t * p_queue;
+  tiz_sched_msg_pool_t msg_pool;
+  tiz_wpool_t * p_wpool; /* NULL in thread-per-component mode */
+  OMX_U32 run_state;     /* A tiz_sched_run_state_t (worker pool mode) */
+  OMX_U32 exited;        /* Set once the last run has finished (idem) */
+  tiz_mutex_t exit_mutex; /* Protects 'exited' (idem) */
+  tiz_cond_t exit_cond;  /* Signalled when 'exited' is set (idem) */
+  tiz_sched_tunnel_ring_t * p_rings[TIZ_COMP_MAX_PORTS]; /* Created lazily */
+  OMX_U32 tick_budget; /* Max messages per kernel/processor turn */
+  OMX_U32 tick_usec;   /* Max duration of a turn, 0 means no limit */
+  OMX_U64 nmsgs[ETIZSchedMsgMax]; /* Performance counters */
+  OMX_U32 mailbox_hwm;
+  OMX_U64 nticks;
+  tiz_mem_account_t * p_mem_account; /* Charged with what the scheduler's
+                                        thread allocates */
+  tiz_soa_t * p_soa;
+  tiz_os_t * p_objsys;
+  OMX_S32 error;
+  tiz_srv_group_t child;
+  tiz_sched_state_t state;
+  OMX_PTR
+  appdata; /* For use during setting of the component callbacks, not owned */
+  OMX_CALLBACKTYPE *
+    cbacks; /* For use during setting of the component callbacks, not owned */
+};
+
 typedef struct tiz_sched_msg_getcomponentversion
   tiz_sched_msg_getcomponentversion_t;
 struct tiz_sched_msg_getcomponentversion
@@ -349,6 +413,20 @@ struct tiz_sched_msg_ev_stat
   int events;
 };
 
+typedef struct tiz_sched_msg_tunnelbuffers tiz_sched_msg_tunnelbuffers_t;
+struct tiz_sched_msg_tunnelbuffers
+{
+  OMX_U32 pid;
+};
+
+typedef struct tiz_sched_msg_bufferbatch tiz_sched_msg_bufferbatch_t;
+struct tiz_sched_msg_bufferbatch
+{
+  OMX_BUFFERHEADERTYPE ** pp_hdrs; /* Owned by the message */
+  OMX_U32 nhdrs;
+  OMX_BOOL fill; /* OMX_TRUE for FillThisBuffer, OMX_FALSE for Empty */
+};
+
 typedef struct tiz_sched_msg tiz_sched_msg_t;
 struct tiz_sched_msg
 {
@@ -356,6 +434,7 @@ struct tiz_sched_msg
   OMX_BOOL will_block;
   OMX_BOOL may_block;
   tiz_sched_msg_class_t class;
+  OMX_U32 pool_slot; /* index + 1 of the pool slot, 0 if heap-allocated */
   union
   {
     tiz_sched_msg_getcomponentversion_t gcv;
@@ -380,9 +459,36 @@ struct tiz_sched_msg
     tiz_sched_msg_ev_io_t eio;
     tiz_sched_msg_ev_timer_t etmr;
     tiz_sched_msg_ev_stat_t estat;
+    tiz_sched_msg_tunnelbuffers_t tb;
+    tiz_sched_msg_bufferbatch_t bb;
   };
 };
 
+struct tiz_sched_msg_slot
+{
+  tiz_sched_msg_t msg;
+  uint32_t next; /* index + 1 of the next free slot, 0 if none */
+};
+
+/* Messages with this pool slot are owned by a tunnel ring: there is only ever
+   one of them outstanding per ring, and it is never released */
+#define SCHED_MSG_RING_OWNED ((OMX_U32) -1)
+
+struct tiz_sched_tunnel_ring
+{
+  OMX_BUFFERHEADERTYPE * p_hdrs[SCHED_TUNNEL_RING_SIZE];
+  OMX_U32 pid;
+  OMX_DIRTYPE dir;        /* Direction of the port that owns the ring */
+  tiz_sched_msg_t wakeup; /* The TunnelBuffers message, preallocated so that
+                             waking up the consumer can't fail */
+  char pad0[SCHED_CACHE_LINE_SIZE];
+  uint32_t head; /* Consumer side */
+  char pad1[SCHED_CACHE_LINE_SIZE - sizeof (uint32_t)];
+  uint32_t tail; /* Producer side */
+  uint32_t idle; /* 1 when no TunnelBuffers message is outstanding */
+  char pad2[SCHED_CACHE_LINE_SIZE - 2 * sizeof (uint32_t)];
+};
+
 /* Forward declarations */
 static OMX_ERRORTYPE
 do_init (tiz_scheduler_t *, tiz_sched_state_t *, tiz_sched_msg_t *);
@@ -440,6 +546,10 @@ static OMX_ERRORTYPE
 do_etmr (tiz_scheduler_t *, tiz_sched_state_t *, tiz_sched_msg_t *);
 static OMX_ERRORTYPE
 do_estat (tiz_scheduler_t *, tiz_sched_state_t *, tiz_sched_msg_t *);
+static OMX_ERRORTYPE
+do_tb (tiz_scheduler_t *, tiz_sched_state_t *, tiz_sched_msg_t *);
+static OMX_ERRORTYPE
+do_bb (tiz_scheduler_t *, tiz_sched_state_t *, tiz_sched_msg_t *);
 
 static OMX_ERRORTYPE
 init_servants (tiz_scheduler_t *, tiz_sched_msg_t *);
@@ -453,10 +563,14 @@ static OMX_ERRORTYPE
 start_scheduler (tiz_scheduler_t *);
 static void
 delete_scheduler (tiz_scheduler_t *);
+static void
+delete_tunnel_rings (tiz_scheduler_t *);
+static void
+il_sched_task_func (OMX_PTR);
 static OMX_ERRORTYPE
 restore_hooks (tiz_scheduler_t * ap_sched, const OMX_U32 a_role_pos);
 static void
-delete_hooks (tiz_scheduler_t * ap_sched, tiz_map_t * ap_map);
+delete_hooks (tiz_scheduler_t * ap_sched, tiz_hmap_t * ap_map);
 
 typedef OMX_ERRORTYPE (*tiz_sched_msg_dispatch_f) (tiz_scheduler_t * ap_sched,
                                                    tiz_sched_state_t * ap_state,
@@ -466,6 +580,7 @@ static const tiz_sched_msg_dispatch_f tiz_sched_msg_to_fnt_tbl[] = {
   do_sconfig, do_gei,    do_gs,    do_tr,   do_ub,     do_ab,     do_fb,
   do_etb,     do_ftb,    do_scbs,  do_uei,  do_cre,    do_plgevt, do_rr,
   do_rt,      do_rph,    do_reh,   do_rreh, do_eio,    do_etmr,   do_estat,
+  do_tb,      do_bb,
 };
 
 static OMX_BOOL
@@ -509,6 +624,8 @@ static tiz_sched_msg_str_t tiz_sched_msg_to_str_tbl[] = {
   {ETIZSchedMsgEvIo, "{ETIZSchedMsgEvIo,"},
   {ETIZSchedMsgEvTimer, "ETIZSchedMsgEvTimer"},
   {ETIZSchedMsgEvStat, "ETIZSchedMsgEvStat"},
+  {ETIZSchedMsgTunnelBuffers, "ETIZSchedMsgTunnelBuffers"},
+  {ETIZSchedMsgBufferBatch, "ETIZSchedMsgBufferBatch"},
   {ETIZSchedMsgMax, "ETIZSchedMsgMax"},
 };
 
@@ -569,9 +686,46 @@ static OMX_BOOL tiz_sched_blocking_apis_tbl[] = {
   OMX_FALSE,    /* ETIZSchedMsgEvIo */
   OMX_FALSE,    /* ETIZSchedMsgEvTimer */
   OMX_FALSE,    /* ETIZSchedMsgEvStat */
+  OMX_FALSE,    /* ETIZSchedMsgTunnelBuffers */
+  OMX_FALSE,    /* ETIZSchedMsgBufferBatch */
   OMX_BOOL_MAX, /* ETIZSchedMsgMax */
 };
 
+/* The group each message class is reported under in
+   OMX_TIZONIA_PERFSTATSTYPE */
+static const OMX_TIZONIA_PERFSTATSMSGCLASSTYPE tiz_sched_msg_to_perf_tbl[] = {
+  OMX_TIZONIA_PerfStatsMsgOther,       /* ETIZSchedMsgComponentInit */
+  OMX_TIZONIA_PerfStatsMsgOther,       /* ETIZSchedMsgComponentDeInit */
+  OMX_TIZONIA_PerfStatsMsgParamConfig, /* ETIZSchedMsgGetComponentVersion */
+  OMX_TIZONIA_PerfStatsMsgCommand,     /* ETIZSchedMsgSendCommand */
+  OMX_TIZONIA_PerfStatsMsgParamConfig, /* ETIZSchedMsgGetParameter */
+  OMX_TIZONIA_PerfStatsMsgParamConfig, /* ETIZSchedMsgSetParameter */
+  OMX_TIZONIA_PerfStatsMsgParamConfig, /* ETIZSchedMsgGetConfig */
+  OMX_TIZONIA_PerfStatsMsgParamConfig, /* ETIZSchedMsgSetConfig */
+  OMX_TIZONIA_PerfStatsMsgParamConfig, /* ETIZSchedMsgGetExtensionIndex */
+  OMX_TIZONIA_PerfStatsMsgParamConfig, /* ETIZSchedMsgGetState */
+  OMX_TIZONIA_PerfStatsMsgOther,       /* ETIZSchedMsgComponentTunnelRequest */
+  OMX_TIZONIA_PerfStatsMsgBufferMgmt,  /* ETIZSchedMsgUseBuffer */
+  OMX_TIZONIA_PerfStatsMsgBufferMgmt,  /* ETIZSchedMsgAllocateBuffer */
+  OMX_TIZONIA_PerfStatsMsgBufferMgmt,  /* ETIZSchedMsgFreeBuffer */
+  OMX_TIZONIA_PerfStatsMsgBuffer,      /* ETIZSchedMsgEmptyThisBuffer */
+  OMX_TIZONIA_PerfStatsMsgBuffer,      /* ETIZSchedMsgFillThisBuffer */
+  OMX_TIZONIA_PerfStatsMsgOther,       /* ETIZSchedMsgSetCallbacks */
+  OMX_TIZONIA_PerfStatsMsgBufferMgmt,  /* ETIZSchedMsgUseEGLImage */
+  OMX_TIZONIA_PerfStatsMsgParamConfig, /* ETIZSchedMsgComponentRoleEnum */
+  OMX_TIZONIA_PerfStatsMsgEvent,       /* ETIZSchedMsgPluggableEvent */
+  OMX_TIZONIA_PerfStatsMsgOther,       /* ETIZSchedMsgRegisterRoles */
+  OMX_TIZONIA_PerfStatsMsgOther,       /* ETIZSchedMsgRegisterTypes */
+  OMX_TIZONIA_PerfStatsMsgOther,       /* ETIZSchedMsgRegisterPortHooks */
+  OMX_TIZONIA_PerfStatsMsgOther,       /* ETIZSchedMsgRegisterEglImageHook */
+  OMX_TIZONIA_PerfStatsMsgOther, /* ETIZSchedMsgRegisterRoleEglImageHook */
+  OMX_TIZONIA_PerfStatsMsgEvent,       /* ETIZSchedMsgEvIo */
+  OMX_TIZONIA_PerfStatsMsgEvent,       /* ETIZSchedMsgEvTimer */
+  OMX_TIZONIA_PerfStatsMsgEvent,       /* ETIZSchedMsgEvStat */
+  OMX_TIZONIA_PerfStatsMsgBuffer,      /* ETIZSchedMsgTunnelBuffers */
+  OMX_TIZONIA_PerfStatsMsgBuffer,      /* ETIZSchedMsgBufferBatch */
+};
+
 static inline tiz_scheduler_t *
 get_sched (const OMX_HANDLETYPE ap_hdl)
 {
@@ -579,6 +733,287 @@ get_sched (const OMX_HANDLETYPE ap_hdl)
   return ((OMX_COMPONENTTYPE *) ap_hdl)->pComponentPrivate;
 }
 
+/* Process-wide worker pool, only instantiated when tizonia.conf selects the
+   'pool' scheduler mode. The pool is created along with the first scheduler
+   that uses it and destroyed along with the last one, so that its workers
+   never outlive the components (they are gone by the time OMX_Deinit is
+   called). */
+static pthread_mutex_t g_sched_wpool_mutex = PTHREAD_MUTEX_INITIALIZER;
+static tiz_wpool_t * gp_sched_wpool = NULL;
+static OMX_U32 g_sched_wpool_users = 0;
+static OMX_BOOL g_sched_wpool_atfork = OMX_FALSE;
+
+static void
+child_sched_wpool_reset (void)
+{
+  /* The pool's threads do not survive a fork; let the child process create
+     its own pool. The parent's schedulers are left holding the old one, which
+     release_sched_wpool ignores. */
+  pthread_mutex_t mutex = PTHREAD_MUTEX_INITIALIZER;
+  memcpy (&g_sched_wpool_mutex, &mutex, sizeof (g_sched_wpool_mutex));
+  gp_sched_wpool = NULL;
+  g_sched_wpool_users = 0;
+}
+
+/* TIZONIA_COMPONENT_SCHEDULER, when set, takes precedence over the
+   'component-scheduler' key. It is read whenever the pool is about to be
+   created, i.e. when the first component of the process is instantiated. */
+static void
+init_sched_wpool (void)
+{
+  const char * p_mode = getenv ("TIZONIA_COMPONENT_SCHEDULER");
+  const char * p_workers
+    = tiz_rcfile_get_value ("ilcore", "component-scheduler-workers");
+  OMX_U32 nworkers = 0;
+
+  if (!p_mode || !*p_mode)
+    {
+      p_mode = tiz_rcfile_get_value ("ilcore", "component-scheduler");
+    }
+
+  if (!p_mode || 0 != strncmp (p_mode, "pool", 4))
+    {
+      /* Default: one thread per component */
+      return;
+    }
+
+  if (p_workers)
+    {
+      nworkers = (OMX_U32) strtoul (p_workers, NULL, 10);
+    }
+
+  if (!g_sched_wpool_atfork)
+    {
+      (void) pthread_atfork (NULL, NULL, child_sched_wpool_reset);
+      g_sched_wpool_atfork = OMX_TRUE;
+    }
+
+  if (OMX_ErrorNone
+      != tiz_wpool_init (&gp_sched_wpool, nworkers, SCHED_WPOOL_THREAD_NAME))
+    {
+      TIZ_LOG (TIZ_PRIORITY_ERROR,
+               "[OMX_ErrorInsufficientResources] : "
+               "Could not create the scheduler worker pool; using one thread "
+               "per component.");
+      gp_sched_wpool = NULL;
+    }
+  else
+    {
+      TIZ_LOG (TIZ_PRIORITY_NOTICE,
+               "Component schedulers run on a shared worker pool "
+               "(workers [%lu])",
+               (unsigned long) tiz_wpool_nthreads (gp_sched_wpool));
+    }
+}
+
+static void
+read_tick_budget (tiz_scheduler_t * ap_sched)
+{
+  const char * p_budget
+    = tiz_rcfile_get_value ("ilcore", "component-scheduler-batch");
+  const char * p_usec
+    = tiz_rcfile_get_value ("ilcore", "component-scheduler-batch-usec");
+
+  assert (ap_sched);
+
+  ap_sched->tick_budget = SCHED_TICK_BUDGET_DEFAULT;
+  ap_sched->tick_usec = SCHED_TICK_USEC_DEFAULT;
+
+  if (p_budget)
+    {
+      ap_sched->tick_budget = MAX (1, (OMX_U32) strtoul (p_budget, NULL, 10));
+    }
+  if (p_usec)
+    {
+      ap_sched->tick_usec = (OMX_U32) strtoul (p_usec, NULL, 10);
+    }
+}
+
+static tiz_wpool_t *
+acquire_sched_wpool (void)
+{
+  tiz_wpool_t * p_wpool = NULL;
+  (void) pthread_mutex_lock (&g_sched_wpool_mutex);
+  if (!gp_sched_wpool)
+    {
+      init_sched_wpool ();
+    }
+  if ((p_wpool = gp_sched_wpool))
+    {
+      g_sched_wpool_users++;
+    }
+  (void) pthread_mutex_unlock (&g_sched_wpool_mutex);
+  return p_wpool;
+}
+
+static void
+release_sched_wpool (tiz_wpool_t * ap_wpool)
+{
+  tiz_wpool_t * p_unused = NULL;
+  assert (ap_wpool);
+  (void) pthread_mutex_lock (&g_sched_wpool_mutex);
+  if (ap_wpool == gp_sched_wpool && 0 == --g_sched_wpool_users)
+    {
+      p_unused = gp_sched_wpool;
+      gp_sched_wpool = NULL;
+    }
+  (void) pthread_mutex_unlock (&g_sched_wpool_mutex);
+  /* The last component is gone, so this can't be one of the pool's
+     workers */
+  tiz_wpool_destroy (p_unused);
+}
+
+static inline tiz_sched_msg_slot_t *
+msg_pool_slot (const tiz_sched_msg_pool_t * ap_pool, const uint32_t a_idx)
+{
+  assert (ap_pool);
+  assert (a_idx / SCHED_MSG_POOL_CHUNK_ITEMS < ap_pool->nchunks);
+  return &(ap_pool->p_chunks[a_idx / SCHED_MSG_POOL_CHUNK_ITEMS]
+                            [a_idx % SCHED_MSG_POOL_CHUNK_ITEMS]);
+}
+
+static void
+msg_pool_push (tiz_sched_msg_pool_t * ap_pool, const uint32_t a_idx)
+{
+  tiz_sched_msg_slot_t * p_slot = msg_pool_slot (ap_pool, a_idx);
+  uint64_t old_head = __atomic_load_n (&(ap_pool->head), __ATOMIC_RELAXED);
+  uint64_t new_head = 0;
+  do
+    {
+      __atomic_store_n (&(p_slot->next), (uint32_t) old_head,
+                        __ATOMIC_RELAXED);
+      new_head = (((old_head >> 32) + 1) << 32) | (uint64_t) (a_idx + 1);
+    }
+  while (!__atomic_compare_exchange_n (&(ap_pool->head), &old_head, new_head,
+                                       1, __ATOMIC_RELEASE,
+                                       __ATOMIC_RELAXED));
+}
+
+static tiz_sched_msg_slot_t *
+msg_pool_pop (tiz_sched_msg_pool_t * ap_pool, uint32_t * ap_idx)
+{
+  uint64_t old_head = __atomic_load_n (&(ap_pool->head), __ATOMIC_ACQUIRE);
+  uint64_t new_head = 0;
+  uint32_t top = 0;
+  assert (ap_idx);
+  do
+    {
+      top = (uint32_t) old_head;
+      if (0 == top)
+        {
+          return NULL;
+        }
+      new_head
+        = (((old_head >> 32) + 1) << 32)
+          | (uint64_t) __atomic_load_n (&(msg_pool_slot (ap_pool, top - 1)->next),
+                                        __ATOMIC_RELAXED);
+    }
+  while (!__atomic_compare_exchange_n (&(ap_pool->head), &old_head, new_head,
+                                       1, __ATOMIC_ACQUIRE,
+                                       __ATOMIC_ACQUIRE));
+  *ap_idx = top - 1;
+  return msg_pool_slot (ap_pool, top - 1);
+}
+
+/* Grows the pool so that it can hold at least a_nmsgs messages. This is only
+   called before the scheduler thread is started or from the scheduler thread
+   itself, so the chunk table never has concurrent writers. */
+static void
+msg_pool_reserve (tiz_scheduler_t * ap_sched, const OMX_U32 a_nmsgs)
+{
+  tiz_sched_msg_pool_t * p_pool = NULL;
+  tiz_sched_msg_slot_t * p_chunk = NULL;
+  uint32_t base = 0;
+  uint32_t i = 0;
+
+  assert (ap_sched);
+  p_pool = &(ap_sched->msg_pool);
+
+  while (p_pool->nchunks * SCHED_MSG_POOL_CHUNK_ITEMS < a_nmsgs
+         && p_pool->nchunks < SCHED_MSG_POOL_MAX_CHUNKS)
+    {
+      if (!(p_chunk = tiz_mem_calloc (SCHED_MSG_POOL_CHUNK_ITEMS,
+                                      sizeof (tiz_sched_msg_slot_t))))
+        {
+          /* Not fatal, messages will be allocated from the heap */
+          break;
+        }
+      base = p_pool->nchunks * SCHED_MSG_POOL_CHUNK_ITEMS;
+      p_pool->p_chunks[p_pool->nchunks++] = p_chunk;
+      for (i = 0; i < SCHED_MSG_POOL_CHUNK_ITEMS; ++i)
+        {
+          msg_pool_push (p_pool, base + i);
+        }
+    }
+
+  TIZ_TRACE (ap_sched->child.p_hdl,
+             "msg pool : requested [%u] capacity [%u] hits [%u] misses [%u]",
+             a_nmsgs, p_pool->nchunks * SCHED_MSG_POOL_CHUNK_ITEMS,
+             __atomic_load_n (&(p_pool->hits), __ATOMIC_RELAXED),
+             __atomic_load_n (&(p_pool->misses), __ATOMIC_RELAXED));
+}
+
+static void
+msg_pool_destroy (tiz_scheduler_t * ap_sched)
+{
+  tiz_sched_msg_pool_t * p_pool = NULL;
+  OMX_U32 i = 0;
+
+  assert (ap_sched);
+  p_pool = &(ap_sched->msg_pool);
+
+  TIZ_DEBUG (ap_sched->child.p_hdl,
+             "msg pool : capacity [%u] hits [%u] misses [%u]",
+             p_pool->nchunks * SCHED_MSG_POOL_CHUNK_ITEMS, p_pool->hits,
+             p_pool->misses);
+
+  for (i = 0; i < p_pool->nchunks; ++i)
+    {
+      tiz_mem_free (p_pool->p_chunks[i]);
+      p_pool->p_chunks[i] = NULL;
+    }
+  p_pool->nchunks = 0;
+  p_pool->head = 0;
+}
+
+static OMX_U32
+count_port_buffers (tiz_scheduler_t * ap_sched)
+{
+  OMX_PTR p_port = NULL;
+  OMX_U32 nbuffers = 0;
+  OMX_U32 pid = 0;
+
+  assert (ap_sched);
+  assert (ap_sched->child.p_ker);
+
+  while ((p_port = tiz_krn_get_port (ap_sched->child.p_ker, pid++)))
+    {
+      nbuffers += tiz_port_buffer_count (p_port);
+    }
+
+  return nbuffers;
+}
+
+static void
+release_scheduler_message (tiz_scheduler_t * ap_sched, tiz_sched_msg_t * ap_msg)
+{
+  assert (ap_sched);
+  assert (ap_msg);
+
+  if (SCHED_MSG_RING_OWNED == ap_msg->pool_slot)
+    {
+      return;
+    }
+  if (ap_msg->pool_slot > 0)
+    {
+      msg_pool_push (&(ap_sched->msg_pool), ap_msg->pool_slot - 1);
+    }
+  else
+    {
+      tiz_mem_free (ap_msg);
+    }
+}
+
 static void
 delete_roles (tiz_scheduler_t * ap_sched)
 {
@@ -665,32 +1100,17 @@ store_roles (tiz_scheduler_t * ap_sched,
   return rc;
 }
 
-static OMX_S32
-hook_map_compare_func (OMX_PTR ap_key1, OMX_PTR ap_key2)
-{
-  return (*((OMX_U32 *) ap_key1) < *((OMX_U32 *) ap_key2));
-}
-
 static void
-hook_map_free_func (OMX_PTR ap_key, OMX_PTR ap_value)
+hook_map_free_func (uintptr_t a_pid, OMX_PTR ap_value)
 {
-  tiz_mem_free (ap_key);
   tiz_mem_free (ap_value);
 }
 
 static void
-delete_hooks (tiz_scheduler_t * ap_sched, tiz_map_t * ap_map)
+delete_hooks (tiz_scheduler_t * ap_sched, tiz_hmap_t * ap_map)
 {
   assert (ap_sched);
-
-  if (ap_map)
-    {
-      while (!tiz_map_empty (ap_map))
-        {
-          tiz_map_erase_at (ap_map, 0);
-        }
-      tiz_map_destroy (ap_map);
-    }
+  tiz_hmap_destroy (ap_map);
 }
 
 static void
@@ -719,11 +1139,11 @@ eglimage_hook_copy (void * ap_dst, void * ap_src)
 }
 
 static OMX_ERRORTYPE
-store_hooks (tiz_map_t ** app_map, OMX_U32 a_pid, const void * ap_hooks,
+store_hooks (tiz_hmap_t ** app_map, OMX_U32 a_pid, const void * ap_hooks,
              size_t a_hook_struct_size, hook_copy_f a_copy_func)
 {
   OMX_ERRORTYPE rc = OMX_ErrorNone;
-  tiz_map_t * p_map = NULL;
+  tiz_hmap_t * p_map = NULL;
 
   assert (app_map);
   assert (ap_hooks);
@@ -733,8 +1153,7 @@ store_hooks (tiz_map_t ** app_map, OMX_U32 a_pid, const void * ap_hooks,
 
   if (!p_map)
     {
-      if (OMX_ErrorNone != tiz_map_init (&p_map, hook_map_compare_func,
-                                         hook_map_free_func, NULL))
+      if (OMX_ErrorNone != tiz_hmap_init (&p_map, 0, hook_map_free_func))
         {
           return OMX_ErrorInsufficientResources;
         }
@@ -742,37 +1161,110 @@ store_hooks (tiz_map_t ** app_map, OMX_U32 a_pid, const void * ap_hooks,
       *app_map = p_map;
     }
 
-  {
-    if (!tiz_map_find (p_map, &a_pid))
-      {
-        OMX_U32 * p_key = (OMX_U32 *) tiz_mem_alloc (sizeof (OMX_U32));
-        void * p_hook = tiz_mem_alloc (a_hook_struct_size);
-        if (p_hook && p_key)
-          {
-            OMX_U32 index = tiz_map_size (p_map);
-            *p_key = a_pid;
-            a_copy_func (p_hook, (void *) ap_hooks);
-            rc = tiz_map_insert (p_map, p_key, p_hook, &index);
-          }
-        else
-          {
-            tiz_mem_free (p_key);
-            tiz_mem_free (p_hook);
-            p_hook = NULL;
-          }
-      }
-  }
+  if (!tiz_hmap_contains (p_map, a_pid))
+    {
+      void * p_hook = NULL;
+      tiz_check_null_ret_oom ((p_hook = tiz_mem_alloc (a_hook_struct_size)));
+      a_copy_func (p_hook, (void *) ap_hooks);
+      if (OMX_ErrorNone != (rc = tiz_hmap_insert (p_map, a_pid, p_hook)))
+        {
+          tiz_mem_free (p_hook);
+        }
+    }
   return rc;
 }
 
+/* Worker pool mode: makes sure that the scheduler gets (re-)queued in the
+   pool, or that its current run goes round once more, after a message has
+   been posted to its mailbox */
+static void
+notify_scheduler (tiz_scheduler_t * ap_sched)
+{
+  OMX_U32 state = 0;
+
+  assert (ap_sched);
+  assert (ap_sched->p_wpool);
+
+  state = __atomic_load_n (&(ap_sched->run_state), __ATOMIC_SEQ_CST);
+  for (;;)
+    {
+      if (ETIZSchedRunIdle == state)
+        {
+          if (__atomic_compare_exchange_n (
+                &(ap_sched->run_state), &state, ETIZSchedRunQueued, 0,
+                __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST))
+            {
+              if (OMX_ErrorNone
+                  != tiz_wpool_submit (ap_sched->p_wpool, il_sched_task_func,
+                                       ap_sched))
+                {
+                  TIZ_ERROR (ap_sched->child.p_hdl,
+                             "[OMX_ErrorInsufficientResources] : "
+                             "Could not queue the scheduler in the pool");
+                }
+              return;
+            }
+        }
+      else if (ETIZSchedRunRunning == state)
+        {
+          if (__atomic_compare_exchange_n (
+                &(ap_sched->run_state), &state, ETIZSchedRunRunningNotified,
+                0, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST))
+            {
+              return;
+            }
+        }
+      else
+        {
+          /* Already queued, or already due to go round once more */
+          return;
+        }
+    }
+}
+
+static inline OMX_ERRORTYPE
+post_msg (tiz_scheduler_t * ap_sched, tiz_sched_msg_t * ap_msg)
+{
+  assert (ap_msg);
+  assert (ap_sched);
+
+  if (!ap_sched->p_wpool)
+    {
+      return tiz_mpscq_send (ap_sched->p_queue, ap_msg);
+    }
+
+  if (OMX_ErrorNoMore == tiz_mpscq_try_send (ap_sched->p_queue, ap_msg))
+    {
+      /* The mailbox is full; this may be a pool worker that is about to
+         block */
+      notify_scheduler (ap_sched);
+      tiz_wpool_blocking_begin (ap_sched->p_wpool);
+      (void) tiz_mpscq_send (ap_sched->p_queue, ap_msg);
+      tiz_wpool_blocking_end (ap_sched->p_wpool);
+    }
+  notify_scheduler (ap_sched);
+
+  return OMX_ErrorNone;
+}
+
 static inline OMX_ERRORTYPE
 send_msg_blocking (tiz_scheduler_t * ap_sched, tiz_sched_msg_t * ap_msg)
 {
+  OMX_ERRORTYPE rc = OMX_ErrorNone;
   assert (ap_msg);
   assert (ap_sched);
   ap_msg->will_block = OMX_TRUE;
-  tiz_check_omx_ret_oom (tiz_queue_send (ap_sched->p_queue, ap_msg));
-  tiz_check_omx_ret_oom (tiz_sem_wait (&(ap_sched->sem)));
+  tiz_check_omx_ret_oom (post_msg (ap_sched, ap_msg));
+  if (ap_sched->p_wpool)
+    {
+      tiz_wpool_blocking_begin (ap_sched->p_wpool);
+    }
+  rc = tiz_sem_wait (&(ap_sched->sem));
+  if (ap_sched->p_wpool)
+    {
+      tiz_wpool_blocking_end (ap_sched->p_wpool);
+    }
+  tiz_check_omx_ret_oom (rc);
   return ap_sched->error;
 }
 
@@ -782,7 +1274,7 @@ send_msg_non_blocking (tiz_scheduler_t * ap_sched, tiz_sched_msg_t * ap_msg)
   assert (ap_msg);
   assert (ap_sched);
   ap_msg->will_block = OMX_FALSE;
-  return tiz_queue_send (ap_sched->p_queue, ap_msg);
+  return post_msg (ap_sched, ap_msg);
 }
 
 static inline OMX_ERRORTYPE
@@ -794,7 +1286,8 @@ send_msg (tiz_scheduler_t * ap_sched, tiz_sched_msg_t * ap_msg)
   assert (ap_sched);
   assert (ap_msg);
 
-  if (tid == ap_sched->thread_id && ap_msg->class != ETIZSchedMsgPluggableEvent)
+  if (tid == __atomic_load_n (&(ap_sched->thread_id), __ATOMIC_RELAXED)
+      && ap_msg->class != ETIZSchedMsgPluggableEvent)
     {
       TIZ_WARN (ap_sched->child.p_hdl,
                 "WARNING: (API %s called from IL callback context...)",
@@ -873,6 +1366,109 @@ do_scmd (tiz_scheduler_t * ap_sched, tiz_sched_state_t * ap_state,
                               p_msg_sc->p_cmd_data);
 }
 
+static OMX_ERRORTYPE
+get_perf_stats (tiz_scheduler_t * ap_sched,
+                OMX_TIZONIA_PERFSTATSTYPE * ap_stats)
+{
+  OMX_TIZONIA_PERFSTATSTYPE stats;
+  OMX_S32 i = 0;
+
+  assert (ap_sched);
+  assert (ap_stats);
+
+  if (ap_stats->nSize < sizeof (OMX_TIZONIA_PERFSTATSTYPE))
+    {
+      return OMX_ErrorBadParameter;
+    }
+
+  memset (&stats, 0, sizeof (stats));
+  stats.nSize = ap_stats->nSize;
+  stats.nVersion = ap_stats->nVersion;
+  stats.nPortIndex = ap_stats->nPortIndex;
+
+  for (i = 0; i < ETIZSchedMsgMax; ++i)
+    {
+      stats.nMessages[tiz_sched_msg_to_perf_tbl[i]] += ap_sched->nmsgs[i];
+    }
+  stats.nMailboxHighWater = ap_sched->mailbox_hwm;
+  stats.nTicks = ap_sched->nticks;
+  stats.nMsgPoolHits
+    = __atomic_load_n (&(ap_sched->msg_pool.hits), __ATOMIC_RELAXED);
+  stats.nMsgPoolMisses
+    = __atomic_load_n (&(ap_sched->msg_pool.misses), __ATOMIC_RELAXED);
+
+  if (ap_sched->child.p_ker)
+    {
+      tiz_check_omx (tiz_krn_get_perf_stats (ap_sched->child.p_ker, &stats));
+    }
+  if (ap_sched->child.p_prc)
+    {
+      tiz_check_omx (tiz_prc_get_perf_stats (ap_sched->child.p_prc, &stats));
+    }
+
+  *ap_stats = stats;
+  return OMX_ErrorNone;
+}
+
+static OMX_ERRORTYPE
+get_mem_stats (tiz_scheduler_t * ap_sched, OMX_TIZONIA_MEMSTATSTYPE * ap_stats)
+{
+  tiz_mem_account_info_t info;
+
+  assert (ap_sched);
+  assert (ap_stats);
+
+  if (ap_stats->nSize < sizeof (OMX_TIZONIA_MEMSTATSTYPE))
+    {
+      return OMX_ErrorBadParameter;
+    }
+
+  tiz_mem_account_info (ap_sched->p_mem_account, &info);
+  ap_stats->nBytesInUse = info.bytes;
+  ap_stats->nBytesPeak = info.peak_bytes;
+  ap_stats->nAllocations = info.allocs;
+  ap_stats->nFrees = info.frees;
+  ap_stats->nFailures = info.failures;
+  ap_stats->nBytesLimit = info.limit;
+  return OMX_ErrorNone;
+}
+
+static OMX_ERRORTYPE
+set_mem_stats (tiz_scheduler_t * ap_sched,
+               const OMX_TIZONIA_MEMSTATSTYPE * ap_stats)
+{
+  assert (ap_sched);
+  assert (ap_stats);
+
+  if (ap_stats->nSize < sizeof (OMX_TIZONIA_MEMSTATSTYPE))
+    {
+      return OMX_ErrorBadParameter;
+    }
+
+  tiz_mem_account_set_limit (ap_sched->p_mem_account, ap_stats->nBytesLimit);
+  tiz_mem_account_reset (ap_sched->p_mem_account);
+  return OMX_ErrorNone;
+}
+
+static void
+reset_perf_stats (tiz_scheduler_t * ap_sched)
+{
+  assert (ap_sched);
+  memset (ap_sched->nmsgs, 0, sizeof (ap_sched->nmsgs));
+  ap_sched->mailbox_hwm = 0;
+  ap_sched->nticks = 0;
+  __atomic_store_n (&(ap_sched->msg_pool.hits), 0, __ATOMIC_RELAXED);
+  __atomic_store_n (&(ap_sched->msg_pool.misses), 0, __ATOMIC_RELAXED);
+  if (ap_sched->child.p_ker)
+    {
+      tiz_krn_reset_perf_stats (ap_sched->child.p_ker);
+    }
+  if (ap_sched->child.p_prc)
+    {
+      tiz_prc_reset_perf_stats (ap_sched->child.p_prc);
+    }
+}
+
 static OMX_ERRORTYPE
 do_gparam (tiz_scheduler_t * ap_sched, tiz_sched_state_t * ap_state,
            tiz_sched_msg_t * ap_msg)
@@ -1005,6 +1601,14 @@ do_sparam (tiz_scheduler_t * ap_sched, tiz_sched_state_t * ap_state,
                                  p_msg_gparam->index, p_msg_gparam->p_struct);
     }
 
+  if (OMX_ErrorNone == rc
+      && OMX_IndexParamPortDefinition == p_msg_gparam->index)
+    {
+      /* Buffer counts may have changed */
+      msg_pool_reserve (ap_sched, SCHED_QUEUE_MAX_ITEMS
+                                    + count_port_buffers (ap_sched));
+    }
+
   return rc;
 }
 
@@ -1020,6 +1624,15 @@ do_gconfig (tiz_scheduler_t * ap_sched, tiz_sched_state_t * ap_state,
   p_msg_gconfig = &(ap_msg->sgpc);
   assert (p_msg_gconfig);
 
+  if (OMX_TizoniaIndexConfigPerfStats == p_msg_gconfig->index)
+    {
+      return get_perf_stats (ap_sched, p_msg_gconfig->p_struct);
+    }
+  if (OMX_TizoniaIndexConfigMemStats == p_msg_gconfig->index)
+    {
+      return get_mem_stats (ap_sched, p_msg_gconfig->p_struct);
+    }
+
   return tiz_api_GetConfig (ap_sched->child.p_fsm, ap_msg->p_hdl,
                             p_msg_gconfig->index, p_msg_gconfig->p_struct);
 }
@@ -1037,8 +1650,19 @@ do_sconfig (tiz_scheduler_t * ap_sched, tiz_sched_state_t * ap_state,
   p_msg_sconfig = &(ap_msg->sgpc);
   assert (p_msg_sconfig);
 
-  rc = tiz_api_SetConfig (ap_sched->child.p_fsm, ap_msg->p_hdl,
-                          p_msg_sconfig->index, p_msg_sconfig->p_struct);
+  if (OMX_TizoniaIndexConfigPerfStats == p_msg_sconfig->index)
+    {
+      reset_perf_stats (ap_sched);
+    }
+  else if (OMX_TizoniaIndexConfigMemStats == p_msg_sconfig->index)
+    {
+      rc = set_mem_stats (ap_sched, p_msg_sconfig->p_struct);
+    }
+  else
+    {
+      rc = tiz_api_SetConfig (ap_sched->child.p_fsm, ap_msg->p_hdl,
+                              p_msg_sconfig->index, p_msg_sconfig->p_struct);
+    }
 
   /* Now have to delete the config struct, if api has been called
      non-blocking */
@@ -1624,37 +2248,118 @@ do_eio (tiz_scheduler_t * ap_sched, tiz_sched_state_t * ap_state,
 }
 
 static OMX_ERRORTYPE
-do_etmr (tiz_scheduler_t * ap_sched, tiz_sched_state_t * ap_state,
-         tiz_sched_msg_t * ap_msg)
+do_etmr (tiz_scheduler_t * ap_sched, tiz_sched_state_t * ap_state,
+         tiz_sched_msg_t * ap_msg)
+{
+  tiz_sched_msg_ev_timer_t * p_msg_etmr = NULL;
+
+  assert (ap_sched);
+  assert (ap_msg);
+  assert (ap_state && ETIZSchedStateStarted == *ap_state);
+
+  p_msg_etmr = &(ap_msg->etmr);
+  assert (p_msg_etmr);
+
+  return tiz_srv_event_timer (p_msg_etmr->p_arg, p_msg_etmr->p_ev_timer,
+                              p_msg_etmr->id);
+}
+
+static OMX_ERRORTYPE
+do_estat (tiz_scheduler_t * ap_sched, tiz_sched_state_t * ap_state,
+          tiz_sched_msg_t * ap_msg)
+{
+  tiz_sched_msg_ev_stat_t * p_msg_estat = NULL;
+
+  assert (ap_sched);
+  assert (ap_msg);
+  assert (ap_state && ETIZSchedStateStarted == *ap_state);
+
+  p_msg_estat = &(ap_msg->estat);
+  assert (p_msg_estat);
+
+  return tiz_srv_event_stat (p_msg_estat->p_arg, p_msg_estat->p_ev_stat,
+                             p_msg_estat->id, p_msg_estat->events);
+}
+
+static OMX_ERRORTYPE
+do_tb (tiz_scheduler_t * ap_sched, tiz_sched_state_t * ap_state,
+       tiz_sched_msg_t * ap_msg)
 {
-  tiz_sched_msg_ev_timer_t * p_msg_etmr = NULL;
+  tiz_sched_msg_tunnelbuffers_t * p_msg_tb = NULL;
+  tiz_sched_tunnel_ring_t * p_ring = NULL;
+  OMX_BUFFERHEADERTYPE * p_hdr = NULL;
+  OMX_ERRORTYPE rc = OMX_ErrorNone;
+  uint32_t head = 0;
 
   assert (ap_sched);
   assert (ap_msg);
   assert (ap_state && ETIZSchedStateStarted == *ap_state);
 
-  p_msg_etmr = &(ap_msg->etmr);
-  assert (p_msg_etmr);
+  p_msg_tb = &(ap_msg->tb);
+  assert (p_msg_tb);
+  assert (p_msg_tb->pid < TIZ_COMP_MAX_PORTS);
+  p_ring = ap_sched->p_rings[p_msg_tb->pid];
+  assert (p_ring);
 
-  return tiz_srv_event_timer (p_msg_etmr->p_arg, p_msg_etmr->p_ev_timer,
-                              p_msg_etmr->id);
+  head = p_ring->head;
+  do
+    {
+      while (head != __atomic_load_n (&(p_ring->tail), __ATOMIC_ACQUIRE))
+        {
+          p_hdr = p_ring->p_hdrs[head & (SCHED_TUNNEL_RING_SIZE - 1)];
+          __atomic_store_n (&(p_ring->head), ++head, __ATOMIC_RELEASE);
+          tiz_tracer_flow_end ("buffer", "tunnel", (uintptr_t) p_hdr);
+          rc = (OMX_DirInput == p_ring->dir
+                  ? tiz_api_EmptyThisBuffer (ap_sched->child.p_fsm,
+                                             ap_sched->child.p_hdl, p_hdr)
+                  : tiz_api_FillThisBuffer (ap_sched->child.p_fsm,
+                                            ap_sched->child.p_hdl, p_hdr));
+        }
+      /* Go idle, unless the producer has pushed more headers in the
+         meantime and nobody else has claimed them */
+      __atomic_store_n (&(p_ring->idle), 1, __ATOMIC_SEQ_CST);
+    }
+  while (head != __atomic_load_n (&(p_ring->tail), __ATOMIC_SEQ_CST)
+         && 1 == __atomic_exchange_n (&(p_ring->idle), 0, __ATOMIC_SEQ_CST));
+
+  return rc;
 }
 
 static OMX_ERRORTYPE
-do_estat (tiz_scheduler_t * ap_sched, tiz_sched_state_t * ap_state,
-          tiz_sched_msg_t * ap_msg)
+do_bb (tiz_scheduler_t * ap_sched, tiz_sched_state_t * ap_state,
+       tiz_sched_msg_t * ap_msg)
 {
-  tiz_sched_msg_ev_stat_t * p_msg_estat = NULL;
+  tiz_sched_msg_bufferbatch_t * p_msg_bb = NULL;
+  OMX_ERRORTYPE rc = OMX_ErrorNone;
+  OMX_U32 i = 0;
 
   assert (ap_sched);
   assert (ap_msg);
   assert (ap_state && ETIZSchedStateStarted == *ap_state);
 
-  p_msg_estat = &(ap_msg->estat);
-  assert (p_msg_estat);
+  p_msg_bb = &(ap_msg->bb);
+  assert (p_msg_bb);
+  assert (p_msg_bb->pp_hdrs);
 
-  return tiz_srv_event_stat (p_msg_estat->p_arg, p_msg_estat->p_ev_stat,
-                             p_msg_estat->id, p_msg_estat->events);
+  /* Every header is delivered, even if an earlier one was rejected */
+  for (i = 0; i < p_msg_bb->nhdrs; ++i)
+    {
+      const OMX_ERRORTYPE hdr_rc
+        = (OMX_TRUE == p_msg_bb->fill
+             ? tiz_api_FillThisBuffer (ap_sched->child.p_fsm, ap_msg->p_hdl,
+                                       p_msg_bb->pp_hdrs[i])
+             : tiz_api_EmptyThisBuffer (ap_sched->child.p_fsm, ap_msg->p_hdl,
+                                        p_msg_bb->pp_hdrs[i]));
+      if (OMX_ErrorNone == rc)
+        {
+          rc = hdr_rc;
+        }
+    }
+
+  tiz_mem_free (p_msg_bb->pp_hdrs);
+  p_msg_bb->pp_hdrs = NULL;
+
+  return rc;
 }
 
 /* NOTE: Start ignoring splint warnings in this section of code */
@@ -1663,13 +2368,35 @@ static inline tiz_sched_msg_t *
 init_scheduler_message (OMX_HANDLETYPE ap_hdl,
                         tiz_sched_msg_class_t a_msg_class)
 {
+  tiz_scheduler_t * p_sched = NULL;
+  tiz_sched_msg_slot_t * p_slot = NULL;
   tiz_sched_msg_t * p_msg = NULL;
+  uint32_t idx = 0;
 
   assert (ap_hdl);
   assert (a_msg_class < ETIZSchedMsgMax);
 
-  if (!(p_msg
-        = (tiz_sched_msg_t *) tiz_mem_calloc (1, sizeof (tiz_sched_msg_t))))
+  p_sched = get_sched (ap_hdl);
+  assert (p_sched);
+
+  if ((p_slot = msg_pool_pop (&(p_sched->msg_pool), &idx)))
+    {
+      p_msg = &(p_slot->msg);
+      memset (p_msg, 0, sizeof (tiz_sched_msg_t));
+      p_msg->pool_slot = idx + 1;
+      (void) __atomic_add_fetch (&(p_sched->msg_pool.hits), 1,
+                                 __ATOMIC_RELAXED);
+    }
+  else if ((p_msg = (tiz_sched_msg_t *) tiz_mem_calloc (
+              1, sizeof (tiz_sched_msg_t))))
+    {
+      (void) __atomic_add_fetch (&(p_sched->msg_pool.misses), 1,
+                                 __ATOMIC_RELAXED);
+      TIZ_TRACE (ap_hdl, "msg pool exhausted : [%s] allocated from the heap",
+                 tiz_sched_msg_to_str (a_msg_class));
+    }
+
+  if (!p_msg)
     {
       TIZ_ERROR (ap_hdl,
                  "[OMX_ErrorInsufficientResources] : "
@@ -1689,6 +2416,31 @@ init_scheduler_message (OMX_HANDLETYPE ap_hdl,
 /*@end@*/
 /* NOTE: Stop ignoring splint warnings in this section  */
 
+static void
+configure_event_loop (const OMX_HANDLETYPE ap_hdl, const char * ap_cname)
+{
+  const char * p_shard = NULL;
+  char fqd_key[OMX_MAX_STRINGNAME_SIZE];
+
+  /* OMX.component.name.event_loop */
+  (void) snprintf (fqd_key, OMX_MAX_STRINGNAME_SIZE, "%s.event_loop",
+                   ap_cname);
+  p_shard = tiz_rcfile_get_value ("plugins", fqd_key);
+
+  if (p_shard)
+    {
+      /* Otherwise, the event loop is picked from a hash of the handle */
+      const OMX_U32 shard = strtoul (p_shard, NULL, 10);
+      if (OMX_ErrorNone != tiz_event_loop_bind (ap_hdl, shard))
+        {
+          TIZ_LOG (TIZ_PRIORITY_WARN,
+                   "[%s] : Could not bind to event loop [%u] (of %u)",
+                   ap_cname, (unsigned int) shard,
+                   (unsigned int) tiz_event_loop_shards ());
+        }
+    }
+}
+
 static OMX_ERRORTYPE
 configure_port_preannouncements (tiz_scheduler_t * ap_sched,
                                  OMX_HANDLETYPE ap_hdl, OMX_PTR p_port)
@@ -1760,6 +2512,7 @@ sched_ComponentDeInit (OMX_HANDLETYPE ap_hdl)
   assert (p_msg);
   rc = send_msg (p_sched, p_msg);
   delete_scheduler (p_sched);
+  tiz_event_loop_unbind (ap_hdl);
   return rc;
 }
 
@@ -1918,6 +2671,68 @@ sched_GetConfig (OMX_HANDLETYPE ap_hdl, OMX_INDEXTYPE a_index,
   return send_msg (p_sched, p_msg);
 }
 
+static OMX_ERRORTYPE
+sched_buffer_batch (OMX_HANDLETYPE ap_hdl, const OMX_BOOL a_fill,
+                    const OMX_TIZONIA_BUFFERBATCHTYPE * ap_batch)
+{
+  tiz_sched_msg_t * p_msg = NULL;
+  tiz_sched_msg_bufferbatch_t * p_msg_bb = NULL;
+  tiz_scheduler_t * p_sched = NULL;
+  OMX_U32 i = 0;
+
+  assert (ap_hdl);
+  assert (ap_batch);
+
+  if (ap_batch->nSize < sizeof (OMX_TIZONIA_BUFFERBATCHTYPE)
+      || (ap_batch->nBufferCount > 0 && !ap_batch->ppHeaders))
+    {
+      TIZ_ERROR (ap_hdl, "[OMX_ErrorBadParameter] : (Malformed buffer batch)");
+      return OMX_ErrorBadParameter;
+    }
+
+  for (i = 0; i < ap_batch->nBufferCount; ++i)
+    {
+      if (!ap_batch->ppHeaders[i])
+        {
+          TIZ_ERROR (ap_hdl,
+                     "[OMX_ErrorBadParameter] : "
+                     "(Null header at batch position [%u])",
+                     i);
+          return OMX_ErrorBadParameter;
+        }
+    }
+
+  if (0 == ap_batch->nBufferCount)
+    {
+      return OMX_ErrorNone;
+    }
+
+  p_sched = get_sched (ap_hdl);
+
+  TIZ_COMP_INIT_MSG_OOM (ap_hdl, p_msg, ETIZSchedMsgBufferBatch);
+
+  assert (p_msg);
+  p_msg_bb = &(p_msg->bb);
+  assert (p_msg_bb);
+
+  /* The caller may reuse its array as soon as this function returns */
+  if (!(p_msg_bb->pp_hdrs = tiz_mem_alloc (ap_batch->nBufferCount
+                                           * sizeof (OMX_BUFFERHEADERTYPE *))))
+    {
+      release_scheduler_message (p_sched, p_msg);
+      TIZ_ERROR (ap_hdl,
+                 "[OMX_ErrorInsufficientResources] : "
+                 "(While allocating memory for buffer batch)");
+      return OMX_ErrorInsufficientResources;
+    }
+  memcpy (p_msg_bb->pp_hdrs, ap_batch->ppHeaders,
+          ap_batch->nBufferCount * sizeof (OMX_BUFFERHEADERTYPE *));
+  p_msg_bb->nhdrs = ap_batch->nBufferCount;
+  p_msg_bb->fill = a_fill;
+
+  return send_msg (p_sched, p_msg);
+}
+
 static OMX_ERRORTYPE
 sched_SetConfig (OMX_HANDLETYPE ap_hdl, OMX_INDEXTYPE a_index,
                  OMX_PTR ap_struct)
@@ -1934,6 +2749,18 @@ sched_SetConfig (OMX_HANDLETYPE ap_hdl, OMX_INDEXTYPE a_index,
       return OMX_ErrorBadParameter;
     }
 
+  /* Batched buffer submissions are handled here, without a round trip
+     through the kernel's config port */
+  if (OMX_TizoniaIndexConfigEmptyTheseBuffers == a_index
+      || OMX_TizoniaIndexConfigFillTheseBuffers == a_index)
+    {
+      return sched_buffer_batch (
+        ap_hdl,
+        (OMX_TizoniaIndexConfigFillTheseBuffers == a_index ? OMX_TRUE
+                                                           : OMX_FALSE),
+        ap_struct);
+    }
+
   p_sched = get_sched (ap_hdl);
 
   TIZ_COMP_INIT_MSG_OOM (ap_hdl, p_msg, ETIZSchedMsgSetConfig);
@@ -1948,7 +2775,7 @@ sched_SetConfig (OMX_HANDLETYPE ap_hdl, OMX_INDEXTYPE a_index,
       if (!(p_msg_sconf->p_struct
             = tiz_mem_calloc (1, (*(OMX_U32 *) ap_struct))))
         {
-          tiz_mem_free (p_msg);
+          release_scheduler_message (p_sched, p_msg);
           TIZ_ERROR (ap_hdl,
                      "[OMX_ErrorInsufficientResources] : "
                      "(While allocating memory for config struct)");
@@ -1983,6 +2810,31 @@ sched_GetExtensionIndex (OMX_HANDLETYPE ap_hdl, OMX_STRING ap_param_name,
       return OMX_ErrorBadParameter;
     }
 
+  if (0 == strncmp (ap_param_name, OMX_TIZONIA_INDEX_CONFIG_EMPTYTHESEBUFFERS,
+                    OMX_MAX_STRINGNAME_SIZE))
+    {
+      *ap_index_type = OMX_TizoniaIndexConfigEmptyTheseBuffers;
+      return OMX_ErrorNone;
+    }
+  if (0 == strncmp (ap_param_name, OMX_TIZONIA_INDEX_CONFIG_FILLTHESEBUFFERS,
+                    OMX_MAX_STRINGNAME_SIZE))
+    {
+      *ap_index_type = OMX_TizoniaIndexConfigFillTheseBuffers;
+      return OMX_ErrorNone;
+    }
+  if (0 == strncmp (ap_param_name, OMX_TIZONIA_INDEX_CONFIG_PERFSTATS,
+                    OMX_MAX_STRINGNAME_SIZE))
+    {
+      *ap_index_type = OMX_TizoniaIndexConfigPerfStats;
+      return OMX_ErrorNone;
+    }
+  if (0 == strncmp (ap_param_name, OMX_TIZONIA_INDEX_CONFIG_MEMSTATS,
+                    OMX_MAX_STRINGNAME_SIZE))
+    {
+      *ap_index_type = OMX_TizoniaIndexConfigMemStats;
+      return OMX_ErrorNone;
+    }
+
   p_sched = get_sched (ap_hdl);
 
   TIZ_COMP_INIT_MSG_OOM (ap_hdl, p_msg, ETIZSchedMsgGetExtensionIndex);
@@ -2306,6 +3158,8 @@ static OMX_BOOL
 dispatch_msg (tiz_scheduler_t * ap_sched, tiz_sched_state_t * ap_state,
               tiz_sched_msg_t * ap_msg)
 {
+  const OMX_U64 start = tiz_tracer_enabled () ? tiz_monotonic_ns () : 0;
+  const tiz_sched_msg_class_t class = ap_msg->class;
   OMX_BOOL signal_client = OMX_FALSE;
   OMX_ERRORTYPE rc = OMX_ErrorNone;
 
@@ -2319,16 +3173,80 @@ dispatch_msg (tiz_scheduler_t * ap_sched, tiz_sched_state_t * ap_state,
 
   signal_client = ap_msg->will_block;
 
+  {
+    /* This message has already been taken off the queue */
+    const OMX_U32 depth = tiz_mpscq_length (ap_sched->p_queue) + 1;
+    ap_sched->nmsgs[ap_msg->class]++;
+    ap_sched->mailbox_hwm = MAX (ap_sched->mailbox_hwm, depth);
+  }
+
+  TIZ_PROBE2 (sched__dispatch__start, ap_sched->child.p_hdl, class);
   rc = tiz_sched_msg_to_fnt_tbl[ap_msg->class](ap_sched, ap_state, ap_msg);
+  TIZ_PROBE3 (sched__dispatch__done, ap_sched->child.p_hdl, class, rc);
 
   /* Return error to client */
   ap_sched->error = rc;
 
-  tiz_mem_free (ap_msg);
+  release_scheduler_message (ap_sched, ap_msg);
+
+  if (start)
+    {
+      tiz_tracer_complete ("sched", tiz_sched_msg_to_str (class), start,
+                           (uintptr_t) ap_sched->child.p_hdl, rc);
+    }
 
   return signal_client;
 }
 
+static inline uint64_t
+now_usec (void)
+{
+  struct timespec ts;
+  (void) clock_gettime (CLOCK_MONOTONIC, &ts);
+  return (uint64_t) ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+/* Give a servant a turn of up to 'tick_budget' messages. The turn ends early
+   as soon as new scheduler messages arrive (e.g. an IL command), or when it
+   has lasted longer than 'tick_usec' */
+static OMX_ERRORTYPE
+tick_servant (tiz_scheduler_t * ap_sched, void * ap_srv)
+{
+  const OMX_U32 budget
+    = __atomic_load_n (&(ap_sched->tick_budget), __ATOMIC_RELAXED);
+  const OMX_U32 usec
+    = __atomic_load_n (&(ap_sched->tick_usec), __ATOMIC_RELAXED);
+  const uint64_t deadline = (budget > 1 && usec > 0) ? now_usec () + usec : 0;
+  const OMX_U64 start = tiz_tracer_enabled () ? tiz_monotonic_ns () : 0;
+  OMX_ERRORTYPE rc = OMX_ErrorNone;
+  OMX_U32 nticks = 0;
+
+  assert (ap_sched);
+  assert (ap_srv);
+
+  TIZ_PROBE2 (servant__tick__start, ap_sched->child.p_hdl, ap_srv);
+  do
+    {
+      rc = tiz_srv_tick (ap_srv);
+      ap_sched->nticks++;
+      nticks++;
+    }
+  while (OMX_ErrorNone == rc && nticks < budget && tiz_srv_is_ready (ap_srv)
+         && 0 == tiz_mpscq_length (ap_sched->p_queue)
+         && (!deadline || now_usec () < deadline));
+  TIZ_PROBE3 (servant__tick__done, ap_sched->child.p_hdl, ap_srv, nticks);
+
+  if (start)
+    {
+      tiz_tracer_complete ("sched",
+                           ap_srv == ap_sched->child.p_ker ? "kernel tick"
+                                                           : "processor tick",
+                           start, (uintptr_t) ap_sched->child.p_hdl, nticks);
+    }
+
+  return rc;
+}
+
 static void
 schedule_servants (tiz_scheduler_t * ap_sched, const tiz_sched_state_t ap_state)
 {
@@ -2358,23 +3276,35 @@ schedule_servants (tiz_scheduler_t * ap_sched, const tiz_sched_state_t ap_state)
       p_ready = NULL;
       if (tiz_srv_is_ready (ap_sched->child.p_fsm))
         {
+          const OMX_U64 start
+            = tiz_tracer_enabled () ? tiz_monotonic_ns () : 0;
           p_ready = ap_sched->child.p_fsm;
+          TIZ_PROBE2 (servant__tick__start, ap_sched->child.p_hdl, p_ready);
           rc = tiz_srv_tick (p_ready);
+          ap_sched->nticks++;
+          TIZ_PROBE3 (servant__tick__done, ap_sched->child.p_hdl, p_ready, 1);
+          if (start)
+            {
+              tiz_tracer_complete ("sched", "fsm tick", start,
+                                   (uintptr_t) ap_sched->child.p_hdl, 1);
+            }
         }
 
+      /* The fsm handles one command at a time; the kernel and the processor
+         (i.e. buffer traffic) may process a batch of messages */
       if (OMX_ErrorNone == rc && tiz_srv_is_ready (ap_sched->child.p_ker))
         {
           p_ready = ap_sched->child.p_ker;
-          rc = tiz_srv_tick (p_ready);
+          rc = tick_servant (ap_sched, p_ready);
         }
 
       if (OMX_ErrorNone == rc && tiz_srv_is_ready (ap_sched->child.p_prc))
         {
           p_ready = ap_sched->child.p_prc;
-          rc = tiz_srv_tick (p_ready);
+          rc = tick_servant (ap_sched, p_ready);
         }
 
-      if (tiz_queue_length (ap_sched->p_queue) > 0)
+      if (tiz_mpscq_length (ap_sched->p_queue) > 0)
         {
           break;
         }
@@ -2399,11 +3329,12 @@ il_sched_thread_func (void * p_arg)
   assert (p_sched);
 
   p_sched->thread_id = tiz_thread_id ();
+  (void) tiz_mem_account_swap (p_sched->p_mem_account);
   tiz_check_omx_ret_null (tiz_sem_post (&(p_sched->sem)));
 
   for (;;)
     {
-      tiz_check_omx_ret_null (tiz_queue_receive (p_sched->p_queue, &p_data));
+      tiz_check_omx_ret_null (tiz_mpscq_receive (p_sched->p_queue, &p_data));
 
       assert (p_data);
       signal_client
@@ -2425,11 +3356,110 @@ il_sched_thread_func (void * p_arg)
   return NULL;
 }
 
+/* Worker pool mode: the equivalent of il_sched_thread_func. Each run drains
+   the mailbox (up to SCHED_WPOOL_MAX_MSGS_PER_RUN messages, so that a busy
+   component does not hog a worker) and gives the pool back the worker when
+   there is nothing left to do. */
+static void
+il_sched_task_func (OMX_PTR ap_arg)
+{
+  tiz_scheduler_t * p_sched = (tiz_scheduler_t *) (ap_arg);
+  const OMX_S32 tid = tiz_thread_id ();
+  OMX_PTR p_data = NULL;
+  OMX_BOOL signal_client = OMX_FALSE;
+  OMX_U32 nmsgs = 0;
+  OMX_U32 state = ETIZSchedRunRunning;
+  tiz_mem_account_t * p_worker_account = NULL;
+
+  assert (p_sched);
+
+  /* The worker is lent to the component for this run */
+  p_worker_account = tiz_mem_account_swap (p_sched->p_mem_account);
+
+  __atomic_store_n (&(p_sched->run_state), ETIZSchedRunRunning,
+                    __ATOMIC_SEQ_CST);
+  __atomic_store_n (&(p_sched->thread_id), tid, __ATOMIC_RELAXED);
+
+  for (;;)
+    {
+      while (nmsgs < SCHED_WPOOL_MAX_MSGS_PER_RUN
+             && OMX_ErrorNone
+                  == tiz_mpscq_try_receive (p_sched->p_queue, &p_data))
+        {
+          assert (p_data);
+          ++nmsgs;
+          signal_client = dispatch_msg (p_sched, &(p_sched->state),
+                                        (tiz_sched_msg_t *) p_data);
+
+          if (ETIZSchedStateStopped == p_sched->state)
+            {
+              __atomic_store_n (&(p_sched->thread_id), 0, __ATOMIC_RELAXED);
+              if (OMX_TRUE == signal_client)
+                {
+                  (void) tiz_sem_post (&(p_sched->sem));
+                }
+              (void) tiz_mem_account_swap (p_worker_account);
+              /* This must be the last access to the scheduler's data; see
+                 delete_scheduler */
+              (void) tiz_mutex_lock (&(p_sched->exit_mutex));
+              p_sched->exited = 1;
+              (void) tiz_cond_signal (&(p_sched->exit_cond));
+              (void) tiz_mutex_unlock (&(p_sched->exit_mutex));
+              return;
+            }
+
+          if (OMX_TRUE == signal_client)
+            {
+              (void) tiz_sem_post (&(p_sched->sem));
+            }
+
+          schedule_servants (p_sched, p_sched->state);
+        }
+
+      __atomic_store_n (&(p_sched->thread_id), 0, __ATOMIC_RELAXED);
+
+      if (nmsgs >= SCHED_WPOOL_MAX_MSGS_PER_RUN)
+        {
+          /* Let other components run; come back later */
+          (void) tiz_mem_account_swap (p_worker_account);
+          __atomic_store_n (&(p_sched->run_state), ETIZSchedRunQueued,
+                            __ATOMIC_SEQ_CST);
+          (void) tiz_wpool_submit (p_sched->p_wpool, il_sched_task_func,
+                                   p_sched);
+          return;
+        }
+
+      state = ETIZSchedRunRunning;
+      (void) tiz_mem_account_swap (p_worker_account);
+      if (__atomic_compare_exchange_n (&(p_sched->run_state), &state,
+                                       ETIZSchedRunIdle, 0, __ATOMIC_SEQ_CST,
+                                       __ATOMIC_SEQ_CST))
+        {
+          return;
+        }
+
+      /* Something was posted while we were draining the mailbox */
+      assert (ETIZSchedRunRunningNotified == state);
+      __atomic_store_n (&(p_sched->run_state), ETIZSchedRunRunning,
+                        __ATOMIC_SEQ_CST);
+      __atomic_store_n (&(p_sched->thread_id), tid, __ATOMIC_RELAXED);
+      (void) tiz_mem_account_swap (p_sched->p_mem_account);
+    }
+}
+
 static OMX_ERRORTYPE
 start_scheduler (tiz_scheduler_t * ap_sched)
 {
   assert (ap_sched);
 
+  if (ap_sched->p_wpool)
+    {
+      /* Nothing to start; the scheduler is queued in the pool whenever a
+         message is posted to its mailbox */
+      ap_sched->run_state = ETIZSchedRunIdle;
+      return OMX_ErrorNone;
+    }
+
   /* Create scheduler thread */
   tiz_check_omx_ret_oom (tiz_mutex_lock (&(ap_sched->mutex)));
   tiz_check_omx_ret_oom (tiz_thread_create (&(ap_sched->thread), 0, 0,
@@ -2446,16 +3476,38 @@ delete_scheduler (tiz_scheduler_t * ap_sched)
 {
   OMX_PTR p_result = NULL;
   assert (ap_sched);
-  (void) tiz_thread_join (&(ap_sched->thread), &p_result);
+  if (ap_sched->p_wpool)
+    {
+      /* The worker that processed ComponentDeInit may still be on its way
+         out of il_sched_task_func */
+      (void) tiz_mutex_lock (&(ap_sched->exit_mutex));
+      while (!ap_sched->exited)
+        {
+          (void) tiz_cond_wait (&(ap_sched->exit_cond),
+                                &(ap_sched->exit_mutex));
+        }
+      (void) tiz_mutex_unlock (&(ap_sched->exit_mutex));
+      release_sched_wpool (ap_sched->p_wpool);
+      ap_sched->p_wpool = NULL;
+    }
+  else
+    {
+      (void) tiz_thread_join (&(ap_sched->thread), &p_result);
+    }
   delete_roles (ap_sched);
   delete_hooks (ap_sched, ap_sched->child.p_alloc_hooks_map);
   ap_sched->child.p_alloc_hooks_map = NULL;
   delete_hooks (ap_sched, ap_sched->child.p_eglimage_hooks_map);
   ap_sched->child.p_eglimage_hooks_map = NULL;
+  (void) tiz_cond_destroy (&(ap_sched->exit_cond));
+  (void) tiz_mutex_destroy (&(ap_sched->exit_mutex));
   (void) tiz_mutex_destroy (&(ap_sched->mutex));
   (void) tiz_sem_destroy (&(ap_sched->sem));
-  tiz_queue_destroy (ap_sched->p_queue);
+  tiz_mpscq_destroy (ap_sched->p_queue);
   ap_sched->p_queue = NULL;
+  msg_pool_destroy (ap_sched);
+  delete_tunnel_rings (ap_sched);
+  tiz_mem_account_destroy (ap_sched->p_mem_account);
   tiz_mem_free (ap_sched);
 }
 
@@ -2476,9 +3528,12 @@ instantiate_scheduler (OMX_HANDLETYPE ap_hdl, const char * ap_cname)
     }
 
   tiz_check_omx_ret_null (tiz_mutex_init (&(p_sched->mutex)));
+  tiz_check_omx_ret_null (tiz_mutex_init (&(p_sched->exit_mutex)));
+  tiz_check_omx_ret_null (tiz_cond_init (&(p_sched->exit_cond)));
   tiz_check_omx_ret_null (tiz_sem_init (&(p_sched->sem), 0));
   tiz_check_omx_ret_null (
-    tiz_queue_init (&(p_sched->p_queue), SCHED_QUEUE_MAX_ITEMS));
+    tiz_mpscq_init (&(p_sched->p_queue), SCHED_QUEUE_MAX_ITEMS));
+  tiz_check_omx_ret_null (tiz_mem_account_init (&(p_sched->p_mem_account)));
 
   p_sched->child.p_fsm = NULL;
   p_sched->child.p_ker = NULL;
@@ -2492,6 +3547,10 @@ instantiate_scheduler (OMX_HANDLETYPE ap_hdl, const char * ap_cname)
   p_sched->state = ETIZSchedStateStarting;
   p_sched->appdata = NULL;
   p_sched->cbacks = NULL;
+  p_sched->p_wpool = acquire_sched_wpool ();
+  p_sched->run_state = ETIZSchedRunIdle;
+  p_sched->exited = 0;
+  read_tick_budget (p_sched);
 
   len = strnlen (ap_cname, OMX_MAX_STRINGNAME_SIZE - 1);
   strncpy (p_sched->cname, ap_cname, len);
@@ -2499,6 +3558,10 @@ instantiate_scheduler (OMX_HANDLETYPE ap_hdl, const char * ap_cname)
 
   ((OMX_COMPONENTTYPE *) ap_hdl)->pComponentPrivate = p_sched;
 
+  /* Enough messages to fill the queue; this grows once the ports and their
+     buffer counts are known */
+  msg_pool_reserve (p_sched, SCHED_QUEUE_MAX_ITEMS);
+
   return p_sched;
 }
 
@@ -2550,7 +3613,12 @@ init_servants (tiz_scheduler_t * ap_sched, tiz_sched_msg_t * ap_msg)
   assert (ap_sched);
   assert (ap_msg);
 
-  tiz_check_omx_ret_oom (set_thread_name (ap_sched));
+  if (!ap_sched->p_wpool)
+    {
+      /* Pool workers are shared by many components; leave their names
+         alone */
+      tiz_check_omx_ret_oom (set_thread_name (ap_sched));
+    }
 
   p_hdl = ap_sched->child.p_hdl;
 
@@ -2591,7 +3659,7 @@ init_servants (tiz_scheduler_t * ap_sched, tiz_sched_msg_t * ap_msg)
   tiz_check_omx_ret_oom (tiz_os_register_base_types (ap_sched->p_objsys));
 
   /* Init the FSM */
-  ap_sched->child.p_fsm = factory_new (tiz_get_type (p_hdl, "tizfsm"));
+  ap_sched->child.p_fsm = factory_new (TIZ_GET_TYPE (p_hdl, "tizfsm"));
   if (!ap_sched->child.p_fsm)
     {
       TIZ_LOG (TIZ_PRIORITY_ERROR,
@@ -2601,7 +3669,7 @@ init_servants (tiz_scheduler_t * ap_sched, tiz_sched_msg_t * ap_msg)
     }
 
   /* Init the kernel */
-  ap_sched->child.p_ker = factory_new (tiz_get_type (p_hdl, "tizkrn"));
+  ap_sched->child.p_ker = factory_new (TIZ_GET_TYPE (p_hdl, "tizkrn"));
   if (!ap_sched->child.p_ker)
     {
       TIZ_LOG (TIZ_PRIORITY_ERROR,
@@ -2696,69 +3764,76 @@ init_and_register_role (tiz_scheduler_t * ap_sched, const OMX_U32 a_role_pos)
       tiz_check_omx_ret_oom (tiz_srv_set_allocator (p_proc, ap_sched->p_soa));
     }
 
+  if (OMX_ErrorNone == rc)
+    {
+      /* Every buffer may be in flight as an ETB/FTB message */
+      msg_pool_reserve (ap_sched, SCHED_QUEUE_MAX_ITEMS
+                                    + count_port_buffers (ap_sched));
+    }
+
   return rc;
 }
 
-static OMX_S32
-restore_alloc_hooks (OMX_PTR ap_key, OMX_PTR ap_value, OMX_PTR ap_arg)
+static OMX_ERRORTYPE
+restore_alloc_hooks (tiz_scheduler_t * ap_sched, tiz_hmap_t * ap_map)
 {
-  tiz_scheduler_t * p_sched = ap_arg;
-  tiz_alloc_hooks_t * p_hooks = NULL;
-  tiz_alloc_hooks_t * p_old_hooks = NULL;
+  tiz_hmap_iter_t iter;
+  OMX_PTR p_value = NULL;
 
-  assert (ap_arg);
-  assert (ap_value);
-
-  p_hooks = (tiz_alloc_hooks_t *) ap_value;
+  assert (ap_sched);
+  assert (ap_map);
 
-  {
-    tiz_sched_msg_t * p_msg = NULL;
-    tiz_sched_msg_regphooks_t * p_msg_rph = NULL;
-
-    TIZ_COMP_INIT_MSG_OOM (p_sched->child.p_hdl, p_msg,
-                           ETIZSchedMsgRegisterPortHooks);
-
-    assert (p_msg);
-    p_msg_rph = &(p_msg->rph);
-    assert (p_msg_rph);
-    p_msg_rph->p_hooks = p_hooks;
-    p_msg_rph->p_old_hooks = p_old_hooks;
-    p_msg->will_block = OMX_FALSE;
-    (void) dispatch_msg (p_sched, &(p_sched->state), p_msg);
-    TIZ_DEBUG (p_sched->child.p_hdl, "p_sched->error [%s]",
-               tiz_err_to_str (p_sched->error));
-  }
-  return 0;
+  tiz_hmap_iter_init (ap_map, &iter);
+  while (tiz_hmap_iter_next (&iter, NULL, &p_value))
+    {
+      tiz_sched_msg_t * p_msg = NULL;
+      tiz_sched_msg_regphooks_t * p_msg_rph = NULL;
+
+      TIZ_COMP_INIT_MSG_OOM (ap_sched->child.p_hdl, p_msg,
+                             ETIZSchedMsgRegisterPortHooks);
+
+      assert (p_msg);
+      p_msg_rph = &(p_msg->rph);
+      assert (p_msg_rph);
+      p_msg_rph->p_hooks = (tiz_alloc_hooks_t *) p_value;
+      p_msg_rph->p_old_hooks = NULL;
+      p_msg->will_block = OMX_FALSE;
+      (void) dispatch_msg (ap_sched, &(ap_sched->state), p_msg);
+      TIZ_DEBUG (ap_sched->child.p_hdl, "p_sched->error [%s]",
+                 tiz_err_to_str (ap_sched->error));
+    }
+  return OMX_ErrorNone;
 }
 
-static OMX_S32
-restore_eglimage_hooks (OMX_PTR ap_key, OMX_PTR ap_value, OMX_PTR ap_arg)
+static OMX_ERRORTYPE
+restore_eglimage_hooks (tiz_scheduler_t * ap_sched, tiz_hmap_t * ap_map)
 {
-  tiz_scheduler_t * p_sched = ap_arg;
-  tiz_eglimage_hook_t * p_hook = NULL;
+  tiz_hmap_iter_t iter;
+  uintptr_t pid = 0;
+  OMX_PTR p_value = NULL;
 
-  assert (ap_arg);
-  assert (ap_value);
-
-  p_hook = (tiz_eglimage_hook_t *) ap_value;
+  assert (ap_sched);
+  assert (ap_map);
 
-  {
-    tiz_sched_msg_t * p_msg = NULL;
-    tiz_sched_msg_regeglhook_t * p_msg_reh = NULL;
-
-    TIZ_COMP_INIT_MSG_OOM (p_sched->child.p_hdl, p_msg,
-                           ETIZSchedMsgRegisterEglImageHook);
-
-    assert (p_msg);
-    p_msg_reh = &(p_msg->reh);
-    assert (p_msg_reh);
-    p_msg_reh->p_hook = p_hook;
-    p_msg->will_block = OMX_FALSE;
-    (void) dispatch_msg (p_sched, &(p_sched->state), p_msg);
-    TIZ_DEBUG (p_sched->child.p_hdl, "pid %u p_sched->error [%s]",
-               *((OMX_U32 *) ap_key), tiz_err_to_str (p_sched->error));
-  }
-  return 0;
+  tiz_hmap_iter_init (ap_map, &iter);
+  while (tiz_hmap_iter_next (&iter, &pid, &p_value))
+    {
+      tiz_sched_msg_t * p_msg = NULL;
+      tiz_sched_msg_regeglhook_t * p_msg_reh = NULL;
+
+      TIZ_COMP_INIT_MSG_OOM (ap_sched->child.p_hdl, p_msg,
+                             ETIZSchedMsgRegisterEglImageHook);
+
+      assert (p_msg);
+      p_msg_reh = &(p_msg->reh);
+      assert (p_msg_reh);
+      p_msg_reh->p_hook = (tiz_eglimage_hook_t *) p_value;
+      p_msg->will_block = OMX_FALSE;
+      (void) dispatch_msg (ap_sched, &(ap_sched->state), p_msg);
+      TIZ_DEBUG (ap_sched->child.p_hdl, "pid %u p_sched->error [%s]",
+                 (OMX_U32) pid, tiz_err_to_str (ap_sched->error));
+    }
+  return OMX_ErrorNone;
 }
 
 static OMX_ERRORTYPE
@@ -2770,15 +3845,15 @@ restore_hooks (tiz_scheduler_t * ap_sched, const OMX_U32 a_role_pos)
 
   if (ap_sched->child.p_alloc_hooks_map)
     {
-      tiz_map_for_each (ap_sched->child.p_alloc_hooks_map, restore_alloc_hooks,
-                        (tiz_scheduler_t *) ap_sched);
+      tiz_check_omx (
+        restore_alloc_hooks (ap_sched, ap_sched->child.p_alloc_hooks_map));
     }
 
   /* Restore the 'global' egl hooks, if they exist... */
   if (ap_sched->child.p_eglimage_hooks_map)
     {
-      tiz_map_for_each (ap_sched->child.p_eglimage_hooks_map,
-                        restore_eglimage_hooks, (tiz_scheduler_t *) ap_sched);
+      rc = restore_eglimage_hooks (ap_sched,
+                                   ap_sched->child.p_eglimage_hooks_map);
     }
   else
     {
@@ -2794,9 +3869,8 @@ restore_hooks (tiz_scheduler_t * ap_sched, const OMX_U32 a_role_pos)
               TIZ_DEBUG (ap_sched->child.p_hdl,
                          "restoring per-role egl hooks [%s] - [%s]",
                          ap_sched->cname, p_rnfo->p_rf->role);
-              tiz_map_for_each (p_rnfo->p_role_eglimage_hooks_map,
-                                restore_eglimage_hooks,
-                                (tiz_scheduler_t *) ap_sched);
+              rc = restore_eglimage_hooks (ap_sched,
+                                           p_rnfo->p_role_eglimage_hooks_map);
             }
         }
     }
@@ -2835,6 +3909,8 @@ tiz_comp_init (const OMX_HANDLETYPE ap_hdl, const char * ap_cname)
       return OMX_ErrorInsufficientResources;
     }
 
+  configure_event_loop (ap_hdl, ap_cname);
+
   tiz_check_omx_ret_oom (start_scheduler (p_sched));
 
   TIZ_COMP_INIT_MSG_OOM (ap_hdl, p_msg, ETIZSchedMsgComponentInit);
@@ -3039,12 +4115,142 @@ tiz_comp_event_stat (const OMX_HANDLETYPE ap_hdl, tiz_event_stat_t * ap_ev_stat,
   (void) send_msg (get_sched (ap_hdl), p_msg);
 }
 
+static tiz_sched_tunnel_ring_t *
+get_tunnel_ring (tiz_scheduler_t * ap_sched, const OMX_U32 a_pid,
+                 const OMX_DIRTYPE a_dir)
+{
+  tiz_sched_tunnel_ring_t * p_ring = NULL;
+  tiz_sched_tunnel_ring_t * p_expected = NULL;
+
+  assert (ap_sched);
+  assert (a_pid < TIZ_COMP_MAX_PORTS);
+
+  p_ring = __atomic_load_n (&(ap_sched->p_rings[a_pid]), __ATOMIC_ACQUIRE);
+  if (!p_ring)
+    {
+      /* There is at most one producer per ring, but be safe anyway */
+      if (!(p_ring = tiz_mem_calloc (1, sizeof (tiz_sched_tunnel_ring_t))))
+        {
+          return NULL;
+        }
+      p_ring->pid = a_pid;
+      p_ring->dir = a_dir;
+      p_ring->wakeup.p_hdl = ap_sched->child.p_hdl;
+      p_ring->wakeup.class = ETIZSchedMsgTunnelBuffers;
+      p_ring->wakeup.will_block
+        = tiz_sched_blocking_apis_tbl[ETIZSchedMsgTunnelBuffers];
+      p_ring->wakeup.pool_slot = SCHED_MSG_RING_OWNED;
+      p_ring->wakeup.tb.pid = a_pid;
+      p_ring->idle = 1;
+      if (!__atomic_compare_exchange_n (&(ap_sched->p_rings[a_pid]),
+                                        &p_expected, p_ring, 0,
+                                        __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE))
+        {
+          tiz_mem_free (p_ring);
+          p_ring = p_expected;
+        }
+    }
+  return p_ring;
+}
+
+static void
+delete_tunnel_rings (tiz_scheduler_t * ap_sched)
+{
+  OMX_U32 i = 0;
+  assert (ap_sched);
+  for (i = 0; i < TIZ_COMP_MAX_PORTS; ++i)
+    {
+      tiz_mem_free (ap_sched->p_rings[i]);
+      ap_sched->p_rings[i] = NULL;
+    }
+}
+
+OMX_ERRORTYPE
+tiz_comp_tunnel_buffer (const OMX_HANDLETYPE ap_hdl, const OMX_U32 a_pid,
+                        const OMX_DIRTYPE a_dir, OMX_HANDLETYPE ap_peer,
+                        OMX_BUFFERHEADERTYPE * ap_hdr)
+{
+  tiz_scheduler_t * p_peer_sched = NULL;
+  tiz_sched_tunnel_ring_t * p_ring = NULL;
+  OMX_PTR p_port = NULL;
+  OMX_U32 peer_pid = 0;
+  uint32_t tail = 0;
+
+  assert (ap_hdl);
+  assert (ap_peer);
+  assert (ap_hdr);
+
+  /* Only when the peer is another component driven by this very library */
+  if (ap_peer == ap_hdl
+      || ((OMX_COMPONENTTYPE *) ap_peer)->EmptyThisBuffer
+           != sched_EmptyThisBuffer)
+    {
+      return OMX_ErrorNotImplemented;
+    }
+
+  /* A ring large enough for all the buffers of the tunnel never overflows,
+     so headers can't overtake each other via the regular path */
+  p_port = tiz_krn_get_port (tiz_get_krn (ap_hdl), a_pid);
+  if (!p_port || tiz_port_buffer_count (p_port) > SCHED_TUNNEL_RING_SIZE)
+    {
+      return OMX_ErrorNotImplemented;
+    }
+
+  /* Our input port returns buffers to the peer's output port and
+     vice-versa */
+  peer_pid = (OMX_DirInput == a_dir ? ap_hdr->nOutputPortIndex
+                                    : ap_hdr->nInputPortIndex);
+  if (peer_pid >= TIZ_COMP_MAX_PORTS)
+    {
+      return OMX_ErrorNotImplemented;
+    }
+
+  p_peer_sched = get_sched (ap_peer);
+  tiz_check_null_ret_oom (
+    (p_ring = get_tunnel_ring (p_peer_sched, peer_pid,
+                               OMX_DirInput == a_dir ? OMX_DirOutput
+                                                     : OMX_DirInput)));
+
+  tail = p_ring->tail;
+  if (tail - __atomic_load_n (&(p_ring->head), __ATOMIC_ACQUIRE)
+      >= SCHED_TUNNEL_RING_SIZE)
+    {
+      return OMX_ErrorNoMore;
+    }
+
+  p_ring->p_hdrs[tail & (SCHED_TUNNEL_RING_SIZE - 1)] = ap_hdr;
+  __atomic_store_n (&(p_ring->tail), tail + 1, __ATOMIC_SEQ_CST);
+
+  /* Once the header is in the ring, the caller must not fall back to the
+     regular path, or the peer would get it twice. So the wake-up can't fail:
+     whoever takes the ring out of 'idle' posts the ring's own message (only
+     one can be outstanding), and posting waits for room in the mailbox. */
+  if (1 == __atomic_exchange_n (&(p_ring->idle), 0, __ATOMIC_SEQ_CST))
+    {
+      (void) send_msg (p_peer_sched, &(p_ring->wakeup));
+    }
+
+  return OMX_ErrorNone;
+}
+
+void
+tiz_comp_set_tick_budget (const OMX_HANDLETYPE ap_hdl, const OMX_U32 a_nmsgs,
+                          const OMX_U32 a_usec)
+{
+  tiz_scheduler_t * p_sched = get_sched (ap_hdl);
+  assert (p_sched);
+  __atomic_store_n (&(p_sched->tick_budget), MAX (1, a_nmsgs),
+                    __ATOMIC_RELAXED);
+  __atomic_store_n (&(p_sched->tick_usec), a_usec, __ATOMIC_RELAXED);
+}
+
 size_t
 tiz_comp_event_queue_unused_spaces (const OMX_HANDLETYPE ap_hdl)
 {
   tiz_scheduler_t * p_sched = get_sched (ap_hdl);
   assert (p_sched);
-  return SCHED_QUEUE_MAX_ITEMS - tiz_queue_length (p_sched->p_queue);
+  return tiz_mpscq_capacity (p_sched->p_queue)
+         - tiz_mpscq_length (p_sched->p_queue);
 }
 
 void *
@@ -3079,8 +4285,15 @@ tiz_get_prc (const OMX_HANDLETYPE ap_hdl)
 
 void *
 tiz_get_type (const OMX_HANDLETYPE ap_hdl, const char * ap_type_name)
+{
+  return tiz_get_type_by_id (ap_hdl, tiz_os_type_id (ap_type_name));
+}
+
+void *
+tiz_get_type_by_id (const OMX_HANDLETYPE ap_hdl,
+                    const tiz_os_type_id_t a_type_id)
 {
   tiz_scheduler_t * p_sched = get_sched (ap_hdl);
   assert (p_sched);
-  return tiz_os_get_type (p_sched->p_objsys, ap_type_name);
+  return tiz_os_get_type_by_id (p_sched->p_objsys, a_type_id);
 }
@@ -57,6 +57,8 @@ extern "C" {
 
 #include <tizplatform.h>
 
+#include "tizobjsys.h"
+
 /**
  * Maximum number of OpenMAX IL ports that may be registered with a Tizonia
  * component.
@@ -403,6 +405,47 @@ void
 tiz_comp_event_stat (const OMX_HANDLETYPE ap_hdl, tiz_event_stat_t * ap_ev_stat,
                      void * ap_arg, const uint32_t a_id, const int a_events);
 
+/**
+ * Hand a buffer header over to a tunneled peer component that lives in the
+ * same process and is also driven by this library, without going through
+ * the peer's OMX_EmptyThisBuffer or OMX_FillThisBuffer. Headers are queued
+ * on a per-port ring and the peer is only woken up when its ring goes from
+ * empty to non-empty.
+ *
+ * @ingroup tizscheduler
+ *
+ * @param ap_hdl The OpenMAX IL handle of the component returning the buffer.
+ * @param a_pid The index of the local port the header belongs to.
+ * @param a_dir The direction of the local port.
+ * @param ap_peer The OpenMAX IL handle of the tunneled component.
+ * @param ap_hdr The buffer header.
+ * @return OMX_ErrorNone once the header has been queued (it then belongs to
+ * the peer, even if it could not be woken up yet). Any other value means
+ * that the header was not queued, and must be delivered through the standard
+ * IL API instead.
+ */
+OMX_ERRORTYPE
+tiz_comp_tunnel_buffer (const OMX_HANDLETYPE ap_hdl, const OMX_U32 a_pid,
+                        const OMX_DIRTYPE a_dir, OMX_HANDLETYPE ap_peer,
+                        OMX_BUFFERHEADERTYPE * ap_hdr);
+
+/**
+ * Set how many queued messages the component's kernel and processor servants
+ * may process in one go, before the scheduler looks at its own queue again.
+ * The defaults come from the 'component-scheduler-batch' and
+ * 'component-scheduler-batch-usec' keys in tizonia.conf.
+ *
+ * @ingroup tizscheduler
+ *
+ * @param ap_hdl The OpenMAX IL handle.
+ * @param a_nmsgs Maximum number of messages per turn (1 disables batching).
+ * @param a_usec Maximum duration of a turn in microseconds (0 means no
+ * limit).
+ */
+void
+tiz_comp_set_tick_budget (const OMX_HANDLETYPE ap_hdl, const OMX_U32 a_nmsgs,
+                          const OMX_U32 a_usec);
+
 /**
  * Retrieve the current maximum number of items that could be insterted into the queue.
  * @ingroup tizscheduler
@@ -459,6 +502,22 @@ tiz_get_sched (const OMX_HANDLETYPE ap_hdl);
 void *
 tiz_get_type (const OMX_HANDLETYPE ap_hdl, const char * ap_type_name);
 
+/**
+ * Retrieve a component's registered type / class, using an interned type id
+ * (see TIZ_OS_TYPE_ID).
+ * @ingroup tizscheduler
+ * @param ap_hdl The OpenMAX IL handle.
+ * @return A registered type.
+ */
+void *
+tiz_get_type_by_id (const OMX_HANDLETYPE ap_hdl,
+                    const tiz_os_type_id_t a_type_id);
+
+/* Same as tiz_get_type, for a string literal type name. The name is interned
+   once per call site (see TIZ_OS_TYPE_ID). */
+#define TIZ_GET_TYPE(ap_hdl, ap_type_name) \
+  tiz_get_type_by_id ((ap_hdl), TIZ_OS_TYPE_ID (ap_type_name))
+
 #ifdef __cplusplus
 }
 #endif
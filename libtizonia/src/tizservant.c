@@ -31,6 +31,7 @@
 #endif
 
 #include <assert.h>
+#include <stdlib.h>
 
 #include "tizutils.h"
 #include "tizservant.h"
@@ -41,12 +42,7 @@
 #define TIZ_LOG_CATEGORY_NAME "tiz.tizonia.servant"
 #endif
 
-typedef struct tiz_srv_watcher_id tiz_srv_watcher_id_t;
-struct tiz_srv_watcher_id
-{
-  tiz_srv_t * p_srv;
-  uint32_t id;
-};
+#define SRV_TIMER_SLACK_MS_DEFAULT 1
 
 static OMX_S32
 pqueue_cmp (OMX_PTR ap_left, OMX_PTR ap_right)
@@ -56,54 +52,28 @@ pqueue_cmp (OMX_PTR ap_left, OMX_PTR ap_right)
   return 1;
 }
 
-static OMX_S32
-watchers_map_compare_func (OMX_PTR ap_key1, OMX_PTR ap_key2)
-{
-  assert (ap_key1);
-  assert (ap_key2);
-  return (ap_key1 == ap_key2) ? 0 : ((ap_key1 < ap_key2) ? -1 : 1);
-}
-
-static void
-watchers_map_free_func (OMX_PTR ap_key, OMX_PTR ap_value)
-{
-  tiz_srv_watcher_id_t * p_id = (tiz_srv_watcher_id_t *) ap_value;
-  tiz_srv_t * p_srv = p_id->p_srv;
-  uint32_t id = p_id->id;
-  assert (p_id);
-  assert (p_srv);
-  TIZ_TRACE (handleOf (p_srv), "Deleting watcher id [%d]", id);
-  tiz_soa_free (p_srv->p_soa_, p_id);
-}
-
 static void
 destroy_watchers_map (tiz_srv_t * ap_srv)
 {
   assert (ap_srv);
-  if (ap_srv->p_watchers_)
-    {
-      while (!tiz_map_empty (ap_srv->p_watchers_))
-        {
-          tiz_map_erase_at (ap_srv->p_watchers_, 0);
-        };
-      tiz_map_destroy (ap_srv->p_watchers_);
-      ap_srv->p_watchers_ = NULL;
-    }
+  tiz_hmap_destroy (ap_srv->p_watchers_);
+  ap_srv->p_watchers_ = NULL;
 }
 
 static inline bool
 is_watcher_active (tiz_srv_t * ap_srv, void * ap_watcher, uint32_t * ap_id)
 {
   bool rc = false;
-  tiz_srv_watcher_id_t * p_id = NULL;
   assert (ap_srv);
   if (ap_srv->p_watchers_ && ap_watcher)
     {
-      p_id = tiz_map_find (ap_srv->p_watchers_, ap_watcher);
-      rc = p_id ? true : false;
+      /* The watcher id is stored inline as the map value */
+      rc = tiz_hmap_contains (ap_srv->p_watchers_, (uintptr_t) ap_watcher);
       if (ap_id)
         {
-          *ap_id = p_id ? p_id->id : 0;
+          *ap_id = rc ? (uint32_t) (uintptr_t) tiz_hmap_find (
+                          ap_srv->p_watchers_, (uintptr_t) ap_watcher)
+                      : 0;
         }
     }
   return rc;
@@ -117,7 +87,7 @@ watcher_count (const void * ap_obj)
   assert (p_srv);
   if (p_srv->p_watchers_)
     {
-      count = tiz_map_size (p_srv->p_watchers_);
+      count = tiz_hmap_size (p_srv->p_watchers_);
     }
   return count;
 }
@@ -129,7 +99,7 @@ watcher_count (const void * ap_obj)
 static void *
 srv_ctor (void * ap_obj, va_list * app)
 {
-  tiz_srv_t * p_srv = super_ctor (typeOf (ap_obj, "tizsrv"), ap_obj, app);
+  tiz_srv_t * p_srv = super_ctor (TIZ_TYPE_OF (ap_obj, "tizsrv"), ap_obj, app);
   /* NOTE: The priority queue is initialised only when the allocator is set via
    * set_allocator */
   p_srv->p_pq_ = NULL;
@@ -168,7 +138,7 @@ srv_dtor (void * ap_obj)
       tiz_pqueue_destroy (p_srv->p_pq_);
     }
 
-  return super_dtor (typeOf (ap_obj, "tizsrv"), ap_obj);
+  return super_dtor (TIZ_TYPE_OF (ap_obj, "tizsrv"), ap_obj);
 }
 
 static OMX_ERRORTYPE
@@ -612,7 +582,23 @@ srv_issue_buf_callback (const void * ap_obj, OMX_BUFFERHEADERTYPE * p_hdr,
   assert (p_srv->p_cbacks_->EventHandler);
   if (ap_tcomp)
     {
-      if (OMX_DirInput == dir)
+      /* The header moves on to the tunneled component, which ends the flow
+         when its scheduler picks it up from the tunnel ring. If the header
+         has to go through OMX_EmptyThisBuffer or OMX_FillThisBuffer
+         instead, the flow ends here. */
+      tiz_tracer_flow_begin ("buffer", "tunnel", (uintptr_t) p_hdr);
+      if (OMX_ErrorNone
+          == tiz_comp_tunnel_buffer (handleOf (ap_obj), pid, dir, ap_tcomp,
+                                     p_hdr))
+        {
+          TIZ_DEBUG (handleOf (ap_obj),
+                     "[%s] : HEADER [%p] BUFFER [%p] [F(%d):A(%d)] [w:%d] [%s]",
+                     OMX_DirInput == dir ? "FillThisBuffer (direct)"
+                                         : "EmptyThisBuffer (direct)",
+                     p_hdr, p_hdr->pBuffer, p_hdr->nFilledLen, p_hdr->nAllocLen,
+                     watcher_count (ap_obj), TIZ_CNAME (ap_tcomp));
+        }
+      else if (OMX_DirInput == dir)
         {
           TIZ_DEBUG (handleOf (ap_obj),
                      "[OMX_FillThisBuffer] : "
@@ -620,6 +606,7 @@ srv_issue_buf_callback (const void * ap_obj, OMX_BUFFERHEADERTYPE * p_hdr,
                      p_hdr, p_hdr->pBuffer, p_hdr->nFilledLen, p_hdr->nAllocLen,
                      watcher_count (ap_obj), TIZ_CNAME (ap_tcomp));
           (void) OMX_FillThisBuffer (ap_tcomp, p_hdr);
+          tiz_tracer_flow_end ("buffer", "tunnel", (uintptr_t) p_hdr);
         }
       else
         {
@@ -629,6 +616,7 @@ srv_issue_buf_callback (const void * ap_obj, OMX_BUFFERHEADERTYPE * p_hdr,
                      p_hdr, p_hdr->pBuffer, p_hdr->nFilledLen, p_hdr->nAllocLen,
                      watcher_count (ap_obj), TIZ_CNAME (ap_tcomp));
           (void) OMX_EmptyThisBuffer (ap_tcomp, p_hdr);
+          tiz_tracer_flow_end ("buffer", "tunnel", (uintptr_t) p_hdr);
         }
     }
 
@@ -716,9 +704,7 @@ srv_io_watcher_init (void * ap_obj, tiz_event_io_t ** app_ev_io, int a_fd,
   /* We lazily initialise the watchers map */
   if (!p_srv->p_watchers_)
     {
-      tiz_check_omx (tiz_map_init (&(p_srv->p_watchers_),
-                                   watchers_map_compare_func,
-                                   watchers_map_free_func, p_srv->p_soa_));
+      tiz_check_omx (tiz_hmap_init (&(p_srv->p_watchers_), 0, NULL));
     }
   tiz_check_omx (
     tiz_event_io_init (app_ev_io, handleOf (p_srv), tiz_comp_event_io, p_srv));
@@ -749,22 +735,13 @@ srv_io_watcher_start (void * ap_obj, tiz_event_io_t * ap_ev_io)
 
   if (!is_watcher_active (p_srv, ap_ev_io, &id))
     {
-      tiz_srv_watcher_id_t * p_id
-        = tiz_soa_calloc (p_srv->p_soa_, sizeof (tiz_srv_watcher_id_t));
-      if (p_id)
-        {
-          OMX_U32 index = 0;
-          p_id->p_srv = p_srv;
-          p_id->id = p_srv->watcher_id_++;
-          id = p_id->id;
-          index = tiz_map_size (p_srv->p_watchers_);
-          tiz_check_omx (
-            tiz_map_insert (p_srv->p_watchers_, ap_ev_io, p_id, &index));
-          rc = tiz_event_io_start (ap_ev_io, id);
-          TIZ_TRACE (handleOf (ap_obj),
-                     "started io watcher id [%d] active watchers [%d]", id,
-                     watcher_count (p_srv));
-        }
+      id = p_srv->watcher_id_++;
+      tiz_check_omx (tiz_hmap_insert (p_srv->p_watchers_, (uintptr_t) ap_ev_io,
+                                      (OMX_PTR) (uintptr_t) id));
+      rc = tiz_event_io_start (ap_ev_io, id);
+      TIZ_TRACE (handleOf (ap_obj),
+                 "started io watcher id [%d] active watchers [%d]", id,
+                 watcher_count (p_srv));
     }
   return rc;
 }
@@ -789,7 +766,7 @@ srv_io_watcher_stop (void * ap_obj, tiz_event_io_t * ap_ev_io)
   if (is_watcher_active (p_srv, ap_ev_io, &id))
     {
       rc = tiz_event_io_stop (ap_ev_io);
-      tiz_map_erase (p_srv->p_watchers_, ap_ev_io);
+      tiz_hmap_erase (p_srv->p_watchers_, (uintptr_t) ap_ev_io);
       TIZ_TRACE (handleOf (ap_obj),
                  "stopped watcher id [%d] active watchers [%d]", id,
                  watcher_count (p_srv));
@@ -831,10 +808,20 @@ tiz_srv_io_watcher_destroy (void * ap_obj, tiz_event_io_t * ap_ev_io)
   class->io_watcher_destroy (ap_obj, ap_ev_io);
 }
 
+static double
+timer_slack (void)
+{
+  const char * p_slack = tiz_rcfile_get_value ("ilcore", "timer-slack-ms");
+  const unsigned long slack_ms
+    = p_slack ? strtoul (p_slack, NULL, 10) : SRV_TIMER_SLACK_MS_DEFAULT;
+  return slack_ms / 1000.;
+}
+
 static OMX_ERRORTYPE
 srv_timer_watcher_init (void * ap_obj, tiz_event_timer_t ** app_ev_timer)
 {
   tiz_srv_t * p_srv = ap_obj;
+  OMX_ERRORTYPE rc = OMX_ErrorNone;
 
   assert (p_srv);
   assert (app_ev_timer);
@@ -842,13 +829,21 @@ srv_timer_watcher_init (void * ap_obj, tiz_event_timer_t ** app_ev_timer)
   /* We lazily initialise the watchers map */
   if (!p_srv->p_watchers_)
     {
-      tiz_check_omx (tiz_map_init (&(p_srv->p_watchers_),
-                                   watchers_map_compare_func,
-                                   watchers_map_free_func, p_srv->p_soa_));
+      tiz_check_omx (tiz_hmap_init (&(p_srv->p_watchers_), 0, NULL));
     }
 
-  return tiz_event_timer_init (app_ev_timer, handleOf (p_srv),
-                               tiz_comp_event_timer, p_srv);
+  tiz_check_omx (tiz_event_timer_init (app_ev_timer, handleOf (p_srv),
+                                       tiz_comp_event_timer, p_srv));
+
+  /* Servant timers are coalesced in the event loop's timer wheel, unless the
+     slack has been configured to zero */
+  if (OMX_ErrorNone
+      != (rc = tiz_event_timer_set_slack (*app_ev_timer, timer_slack ())))
+    {
+      tiz_event_timer_destroy (*app_ev_timer);
+      *app_ev_timer = NULL;
+    }
+  return rc;
 }
 
 OMX_ERRORTYPE
@@ -873,23 +868,15 @@ srv_timer_watcher_start (void * ap_obj, tiz_event_timer_t * ap_ev_timer,
 
   if (!is_watcher_active (p_srv, ap_ev_timer, &id))
     {
-      tiz_srv_watcher_id_t * p_id
-        = tiz_soa_calloc (p_srv->p_soa_, sizeof (tiz_srv_watcher_id_t));
-      if (p_id)
-        {
-          OMX_U32 index = 0;
-          p_id->p_srv = p_srv;
-          p_id->id = p_srv->watcher_id_++;
-          id = p_id->id;
-          tiz_event_timer_set (ap_ev_timer, a_after, a_repeat);
-          index = tiz_map_size (p_srv->p_watchers_);
-          tiz_check_omx (
-            tiz_map_insert (p_srv->p_watchers_, ap_ev_timer, p_id, &index));
-          rc = tiz_event_timer_start (ap_ev_timer, id);
-          TIZ_TRACE (handleOf (ap_obj),
-                     "started timer watcher id [%d] active watchers [%d]", id,
-                     watcher_count (p_srv));
-        }
+      id = p_srv->watcher_id_++;
+      tiz_event_timer_set (ap_ev_timer, a_after, a_repeat);
+      tiz_check_omx (tiz_hmap_insert (p_srv->p_watchers_,
+                                      (uintptr_t) ap_ev_timer,
+                                      (OMX_PTR) (uintptr_t) id));
+      rc = tiz_event_timer_start (ap_ev_timer, id);
+      TIZ_TRACE (handleOf (ap_obj),
+                 "started timer watcher id [%d] active watchers [%d]", id,
+                 watcher_count (p_srv));
     }
   return rc;
 }
@@ -908,7 +895,6 @@ srv_timer_watcher_restart (void * ap_obj, tiz_event_timer_t * ap_ev_timer)
 {
   tiz_srv_t * p_srv = ap_obj;
   OMX_ERRORTYPE rc = OMX_ErrorNone;
-  tiz_srv_watcher_id_t * p_id = NULL;
   uint32_t id = 0;
 
   assert (p_srv);
@@ -917,24 +903,16 @@ srv_timer_watcher_restart (void * ap_obj, tiz_event_timer_t * ap_ev_timer)
 
   if (is_watcher_active (p_srv, ap_ev_timer, &id))
     {
-      tiz_map_erase (p_srv->p_watchers_, ap_ev_timer);
+      tiz_hmap_erase (p_srv->p_watchers_, (uintptr_t) ap_ev_timer);
     }
 
-  p_id = tiz_soa_calloc (p_srv->p_soa_, sizeof (tiz_srv_watcher_id_t));
-  if (p_id)
-    {
-      OMX_U32 index = 0;
-      p_id->p_srv = p_srv;
-      p_id->id = p_srv->watcher_id_++;
-      id = p_id->id;
-      index = tiz_map_size (p_srv->p_watchers_);
-      tiz_check_omx (
-        tiz_map_insert (p_srv->p_watchers_, ap_ev_timer, p_id, &index));
-      rc = tiz_event_timer_restart (ap_ev_timer, id);
-      TIZ_TRACE (handleOf (ap_obj),
-                 "restarted io watcher id [%d] active watchers [%d]", id,
-                 watcher_count (p_srv));
-    }
+  id = p_srv->watcher_id_++;
+  tiz_check_omx (tiz_hmap_insert (p_srv->p_watchers_, (uintptr_t) ap_ev_timer,
+                                  (OMX_PTR) (uintptr_t) id));
+  rc = tiz_event_timer_restart (ap_ev_timer, id);
+  TIZ_TRACE (handleOf (ap_obj),
+             "restarted io watcher id [%d] active watchers [%d]", id,
+             watcher_count (p_srv));
 
   return rc;
 }
@@ -959,7 +937,7 @@ srv_timer_watcher_stop (void * ap_obj, tiz_event_timer_t * ap_ev_timer)
   if (is_watcher_active (p_srv, ap_ev_timer, &id))
     {
       rc = tiz_event_timer_stop (ap_ev_timer);
-      tiz_map_erase (p_srv->p_watchers_, ap_ev_timer);
+      tiz_hmap_erase (p_srv->p_watchers_, (uintptr_t) ap_ev_timer);
       TIZ_TRACE (handleOf (ap_obj),
                  "stopped timer watcher id [%d] active watchers [%d]", id,
                  watcher_count (p_srv));
@@ -1014,7 +992,7 @@ srv_event_io (void * ap_obj, tiz_event_io_t * ap_ev_io, const uint32_t a_id,
       /* Remove from the map if it is level-triggered */
       if (tiz_event_io_is_level_triggered (ap_ev_io))
         {
-          tiz_map_erase (p_srv->p_watchers_, ap_ev_io);
+          tiz_hmap_erase (p_srv->p_watchers_, (uintptr_t) ap_ev_io);
           TIZ_TRACE (handleOf (ap_obj),
                      "stopped io watcher id [%d] active watchers [%d]", id,
                      watcher_count (p_srv));
@@ -1053,7 +1031,7 @@ srv_event_timer (void * ap_obj, tiz_event_timer_t * ap_ev_timer,
       /* Remove from the map if it is non-repeat */
       if (!tiz_event_timer_is_repeat (ap_ev_timer))
         {
-          tiz_map_erase (p_srv->p_watchers_, ap_ev_timer);
+          tiz_hmap_erase (p_srv->p_watchers_, (uintptr_t) ap_ev_timer);
           TIZ_TRACE (handleOf (ap_obj),
                      "stopped timer watcher id [%d] active watchers [%d]", id,
                      watcher_count (p_srv));
@@ -1148,7 +1126,7 @@ static void *
 srv_class_ctor (void * ap_obj, va_list * app)
 {
   tiz_srv_class_t * p_srv
-    = super_ctor (typeOf (ap_obj, "tizsrv_class"), ap_obj, app);
+    = super_ctor (TIZ_TYPE_OF (ap_obj, "tizsrv_class"), ap_obj, app);
   typedef void (*voidf) ();
   voidf selector = NULL;
   va_list ap;
@@ -1322,7 +1300,7 @@ srv_class_ctor (void * ap_obj, va_list * app)
 void *
 tiz_srv_class_init (void * ap_tos, void * ap_hdl)
 {
-  void * tizapi = tiz_get_type (ap_hdl, "tizapi");
+  void * tizapi = TIZ_GET_TYPE (ap_hdl, "tizapi");
   void * tizsrv_class = factory_new
     /* TIZ_CLASS_COMMENT: class type, class name, parent, size */
     (classOf (tizapi), "tizsrv_class", classOf (tizapi),
@@ -1339,8 +1317,8 @@ tiz_srv_class_init (void * ap_tos, void * ap_hdl)
 void *
 tiz_srv_init (void * ap_tos, void * ap_hdl)
 {
-  void * tizapi = tiz_get_type (ap_hdl, "tizapi");
-  void * tizsrv_class = tiz_get_type (ap_hdl, "tizsrv_class");
+  void * tizapi = TIZ_GET_TYPE (ap_hdl, "tizapi");
+  void * tizsrv_class = TIZ_GET_TYPE (ap_hdl, "tizsrv_class");
   TIZ_LOG_CLASS (tizsrv_class);
   void * tizsrv = factory_new
     /* TIZ_CLASS_COMMENT: class type, class name, parent, size */
@@ -43,7 +43,7 @@ struct tiz_srv
   const tiz_api_t _;
   tiz_pqueue_t * p_pq_;
   tiz_soa_t * p_soa_; /* Not owned */
-  tiz_map_t * p_watchers_;
+  tiz_hmap_t * p_watchers_; /* watcher -> watcher id */
   uint32_t watcher_id_;
   OMX_PTR p_appdata_;
   OMX_CALLBACKTYPE * p_cbacks_;
@@ -51,7 +51,8 @@
 static void *
 state_ctor (void * ap_obj, va_list * app)
 {
-  tiz_state_t * p_obj = super_ctor (typeOf (ap_obj, "tizstate"), ap_obj, app);
+  tiz_state_t * p_obj = super_ctor (TIZ_TYPE_OF (ap_obj, "tizstate"), ap_obj,
+                                    app);
   p_obj->p_fsm_ = va_arg (*app, void *);
   p_obj->servants_count_ = 0;
   return p_obj;
@@ -60,7 +61,7 @@ state_ctor (void * ap_obj, va_list * app)
 static void *
 state_dtor (void * ap_obj)
 {
-  return super_dtor (typeOf (ap_obj, "tizstate"), ap_obj);
+  return super_dtor (TIZ_TYPE_OF (ap_obj, "tizstate"), ap_obj);
 }
 
 /*
@@ -400,7 +401,7 @@ static void *
 state_class_ctor (void * ap_obj, va_list * app)
 {
   tiz_state_class_t * p_obj
-    = super_ctor (typeOf (ap_obj, "tizstate_class"), ap_obj, app);
+    = super_ctor (TIZ_TYPE_OF (ap_obj, "tizstate_class"), ap_obj, app);
   typedef void (*voidf) ();
   voidf selector = NULL;
   va_list ap;
@@ -450,7 +451,7 @@ state_class_ctor (void * ap_obj, va_list * app)
 void *
 tiz_state_class_init (void * ap_tos, void * ap_hdl)
 {
-  void * tizapi = tiz_get_type (ap_hdl, "tizapi");
+  void * tizapi = TIZ_GET_TYPE (ap_hdl, "tizapi");
   void * tizstate_class = factory_new
     /* TIZ_CLASS_COMMENT: class type, class name, parent, size */
     (classOf (tizapi), "tizstate_class", classOf (tizapi),
@@ -467,8 +468,8 @@ tiz_state_class_init (void * ap_tos, void * ap_hdl)
 void *
 tiz_state_init (void * ap_tos, void * ap_hdl)
 {
-  void * tizapi = tiz_get_type (ap_hdl, "tizapi");
-  void * tizstate_class = tiz_get_type (ap_hdl, "tizstate_class");
+  void * tizapi = TIZ_GET_TYPE (ap_hdl, "tizapi");
+  void * tizstate_class = TIZ_GET_TYPE (ap_hdl, "tizstate_class");
   TIZ_LOG_CLASS (tizstate_class);
   void * tizstate = factory_new
     /* TIZ_CLASS_COMMENT: class type, class name, parent, size */
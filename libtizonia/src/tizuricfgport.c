@@ -84,7 +84,7 @@ static void *
 uri_cfgport_ctor (void * ap_obj, va_list * app)
 {
   tiz_uricfgport_t * p_obj
-    = super_ctor (typeOf (ap_obj, "tizuricfgport"), ap_obj, app);
+    = super_ctor (TIZ_TYPE_OF (ap_obj, "tizuricfgport"), ap_obj, app);
   p_obj->p_uri_ = retrieve_default_uri_from_config (p_obj);
 
   /* In addition to the indexes registered by the parent class, register here
@@ -100,7 +100,7 @@ uri_cfgport_dtor (void * ap_obj)
 {
   tiz_uricfgport_t * p_obj = ap_obj;
   tiz_mem_free (p_obj->p_uri_);
-  return super_dtor (typeOf (ap_obj, "tizuricfgport"), ap_obj);
+  return super_dtor (TIZ_TYPE_OF (ap_obj, "tizuricfgport"), ap_obj);
 }
 
 /*
@@ -158,8 +158,8 @@ uri_cfgport_GetParameter (const void * ap_obj, OMX_HANDLETYPE ap_hdl,
       default:
         {
           /* Delegate to the base port */
-          rc = super_GetParameter (typeOf (ap_obj, "tizuricfgport"), ap_obj,
-                                   ap_hdl, a_index, ap_struct);
+          rc = super_GetParameter (TIZ_TYPE_OF (ap_obj, "tizuricfgport"),
+                                   ap_obj, ap_hdl, a_index, ap_struct);
         }
     };
 
@@ -207,8 +207,8 @@ uri_cfgport_SetParameter (const void * ap_obj, OMX_HANDLETYPE ap_hdl,
       default:
         {
           /* Delegate to the base port */
-          rc = super_SetParameter (typeOf (ap_obj, "tizuricfgport"), ap_obj,
-                                   ap_hdl, a_index, ap_struct);
+          rc = super_SetParameter (TIZ_TYPE_OF (ap_obj, "tizuricfgport"),
+                                   ap_obj, ap_hdl, a_index, ap_struct);
         }
     };
 
@@ -223,7 +223,7 @@ static void *
 uricfgport_class_ctor (void * ap_obj, va_list * app)
 {
   /* NOTE: Class methods might be added in the future. None for now. */
-  return super_ctor (typeOf (ap_obj, "tizuricfgport_class"), ap_obj, app);
+  return super_ctor (TIZ_TYPE_OF (ap_obj, "tizuricfgport_class"), ap_obj, app);
 }
 
 /*
@@ -233,7 +233,7 @@ uricfgport_class_ctor (void * ap_obj, va_list * app)
 void *
 tiz_uricfgport_class_init (void * ap_tos, void * ap_hdl)
 {
-  void * tizconfigport = tiz_get_type (ap_hdl, "tizconfigport");
+  void * tizconfigport = TIZ_GET_TYPE (ap_hdl, "tizconfigport");
   void * tizuricfgport_class = factory_new
     /* TIZ_CLASS_COMMENT: class type, class name, parent, size */
     (classOf (tizconfigport), "tizuricfgport_class", classOf (tizconfigport),
@@ -250,8 +250,8 @@ tiz_uricfgport_class_init (void * ap_tos, void * ap_hdl)
 void *
 tiz_uricfgport_init (void * ap_tos, void * ap_hdl)
 {
-  void * tizconfigport = tiz_get_type (ap_hdl, "tizconfigport");
-  void * tizuricfgport_class = tiz_get_type (ap_hdl, "tizuricfgport_class");
+  void * tizconfigport = TIZ_GET_TYPE (ap_hdl, "tizconfigport");
+  void * tizuricfgport_class = TIZ_GET_TYPE (ap_hdl, "tizuricfgport_class");
   TIZ_LOG_CLASS (tizuricfgport_class);
   void * tizuricfgport = factory_new
     /* TIZ_CLASS_COMMENT: class type, class name, parent, size */
@@ -131,7 +131,7 @@ videoport_SetParameter_common (const void * ap_obj, OMX_HANDLETYPE ap_hdl,
       default:
         {
           /* Try the parent's indexes */
-          rc = super_SetParameter (typeOf (ap_obj, "tizvideoport"), ap_obj,
+          rc = super_SetParameter (TIZ_TYPE_OF (ap_obj, "tizvideoport"), ap_obj,
                                    ap_hdl, a_index, ap_struct);
         }
     };
@@ -231,7 +231,7 @@ static void *
 videoport_ctor (void * ap_obj, va_list * app)
 {
   tiz_videoport_t * p_obj
-    = super_ctor (typeOf (ap_obj, "tizvideoport"), ap_obj, app);
+    = super_ctor (TIZ_TYPE_OF (ap_obj, "tizvideoport"), ap_obj, app);
   OMX_VIDEO_PORTDEFINITIONTYPE * p_portdef = NULL;
   OMX_VIDEO_CODINGTYPE * p_encodings = NULL;
   OMX_COLOR_FORMATTYPE * p_formats = NULL;
@@ -308,7 +308,7 @@ videoport_dtor (void * ap_obj)
   tiz_vector_clear (p_obj->p_color_formats_);
   tiz_vector_destroy (p_obj->p_color_formats_);
 
-  return super_dtor (typeOf (ap_obj, "tizvideoport"), ap_obj);
+  return super_dtor (TIZ_TYPE_OF (ap_obj, "tizvideoport"), ap_obj);
 }
 
 /*
@@ -369,8 +369,8 @@ videoport_GetParameter (const void * ap_obj, OMX_HANDLETYPE ap_hdl,
       default:
         {
           /* Try the parent's indexes */
-          return super_GetParameter (typeOf (ap_obj, "tizvideoport"), ap_obj,
-                                     ap_hdl, a_index, ap_struct);
+          return super_GetParameter (TIZ_TYPE_OF (ap_obj, "tizvideoport"),
+                                     ap_obj, ap_hdl, a_index, ap_struct);
         }
     };
 
@@ -585,7 +585,7 @@ videoport_SetParameter_internal (const void * ap_obj, OMX_HANDLETYPE ap_hdl,
     default:
       {
         /* Try the parent's indexes */
-        rc = super_SetParameter (typeOf (ap_obj, "tizvideoport"), ap_obj,
+        rc = super_SetParameter (TIZ_TYPE_OF (ap_obj, "tizvideoport"), ap_obj,
                                  ap_hdl, a_index, ap_struct);
       }
       break;
@@ -601,7 +601,7 @@ static void *
 videoport_class_ctor (void * ap_obj, va_list * app)
 {
   /* NOTE: Class methods might be added in the future. None for now. */
-  return super_ctor (typeOf (ap_obj, "tizvideoport_class"), ap_obj, app);
+  return super_ctor (TIZ_TYPE_OF (ap_obj, "tizvideoport_class"), ap_obj, app);
 }
 
 /*
@@ -611,7 +611,7 @@ videoport_class_ctor (void * ap_obj, va_list * app)
 void *
 tiz_videoport_class_init (void * ap_tos, void * ap_hdl)
 {
-  void * tizport = tiz_get_type (ap_hdl, "tizport");
+  void * tizport = TIZ_GET_TYPE (ap_hdl, "tizport");
   void * tizvideoport_class = factory_new
     /* TIZ_CLASS_COMMENT: class type, class name, parent, size */
     (classOf (tizport), "tizvideoport_class", classOf (tizport),
@@ -628,8 +628,8 @@ tiz_videoport_class_init (void * ap_tos, void * ap_hdl)
 void *
 tiz_videoport_init (void * ap_tos, void * ap_hdl)
 {
-  void * tizport = tiz_get_type (ap_hdl, "tizport");
-  void * tizvideoport_class = tiz_get_type (ap_hdl, "tizvideoport_class");
+  void * tizport = TIZ_GET_TYPE (ap_hdl, "tizport");
+  void * tizvideoport_class = TIZ_GET_TYPE (ap_hdl, "tizvideoport_class");
   TIZ_LOG_CLASS (tizvideoport_class);
   void * tizvideoport = factory_new
     /* TIZ_CLASS_COMMENT: class type, class name, parent, size */
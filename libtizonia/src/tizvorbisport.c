@@ -51,7 +51,7 @@ static void *
 vorbisport_ctor (void * ap_obj, va_list * app)
 {
   tiz_vorbisport_t * p_obj
-    = super_ctor (typeOf (ap_obj, "tizvorbisport"), ap_obj, app);
+    = super_ctor (TIZ_TYPE_OF (ap_obj, "tizvorbisport"), ap_obj, app);
   tiz_port_t * p_base = ap_obj;
   OMX_AUDIO_PARAM_VORBISTYPE * p_vorbismode = NULL;
   tiz_port_register_index (p_obj, OMX_IndexParamAudioVorbis);
@@ -74,7 +74,7 @@ vorbisport_ctor (void * ap_obj, va_list * app)
 static void *
 vorbisport_dtor (void * ap_obj)
 {
-  return super_dtor (typeOf (ap_obj, "tizvorbisport"), ap_obj);
+  return super_dtor (TIZ_TYPE_OF (ap_obj, "tizvorbisport"), ap_obj);
 }
 
 /*
@@ -103,8 +103,8 @@ vorbisport_GetParameter (const void * ap_obj, OMX_HANDLETYPE ap_hdl,
       default:
         {
           /* Try the parent's indexes */
-          return super_GetParameter (typeOf (ap_obj, "tizvorbisport"), ap_obj,
-                                     ap_hdl, a_index, ap_struct);
+          return super_GetParameter (TIZ_TYPE_OF (ap_obj, "tizvorbisport"),
+                                     ap_obj, ap_hdl, a_index, ap_struct);
         }
     };
 
@@ -190,8 +190,8 @@ vorbisport_SetParameter (const void * ap_obj, OMX_HANDLETYPE ap_hdl,
       default:
         {
           /* Try the parent's indexes */
-          return super_SetParameter (typeOf (ap_obj, "tizvorbisport"), ap_obj,
-                                     ap_hdl, a_index, ap_struct);
+          return super_SetParameter (TIZ_TYPE_OF (ap_obj, "tizvorbisport"),
+                                     ap_obj, ap_hdl, a_index, ap_struct);
         }
     };
 
@@ -435,7 +435,7 @@ static void *
 vorbisport_class_ctor (void * ap_obj, va_list * app)
 {
   /* NOTE: Class methods might be added in the future. None for now. */
-  return super_ctor (typeOf (ap_obj, "tizvorbisport_class"), ap_obj, app);
+  return super_ctor (TIZ_TYPE_OF (ap_obj, "tizvorbisport_class"), ap_obj, app);
 }
 
 /*
@@ -445,7 +445,7 @@ vorbisport_class_ctor (void * ap_obj, va_list * app)
 void *
 tiz_vorbisport_class_init (void * ap_tos, void * ap_hdl)
 {
-  void * tizaudioport = tiz_get_type (ap_hdl, "tizaudioport");
+  void * tizaudioport = TIZ_GET_TYPE (ap_hdl, "tizaudioport");
   void * tizvorbisport_class = factory_new
     /* TIZ_CLASS_COMMENT: class type, class name, parent, size */
     (classOf (tizaudioport), "tizvorbisport_class", classOf (tizaudioport),
@@ -462,8 +462,8 @@ tiz_vorbisport_class_init (void * ap_tos, void * ap_hdl)
 void *
 tiz_vorbisport_init (void * ap_tos, void * ap_hdl)
 {
-  void * tizaudioport = tiz_get_type (ap_hdl, "tizaudioport");
-  void * tizvorbisport_class = tiz_get_type (ap_hdl, "tizvorbisport_class");
+  void * tizaudioport = TIZ_GET_TYPE (ap_hdl, "tizaudioport");
+  void * tizvorbisport_class = TIZ_GET_TYPE (ap_hdl, "tizvorbisport_class");
   TIZ_LOG_CLASS (tizvorbisport_class);
   void * tizvorbisport = factory_new
     /* TIZ_CLASS_COMMENT: class type, class name, parent, size */
@@ -51,7 +51,7 @@ static void *
 vp8port_ctor (void * ap_obj, va_list * app)
 {
   tiz_vp8port_t * p_obj
-    = super_ctor (typeOf (ap_obj, "tizvp8port"), ap_obj, app);
+    = super_ctor (TIZ_TYPE_OF (ap_obj, "tizvp8port"), ap_obj, app);
   tiz_port_t * p_base = ap_obj;
   OMX_VIDEO_PARAM_VP8TYPE * p_vp8type = NULL;
   OMX_VIDEO_VP8LEVELTYPE * p_levels = NULL;
@@ -131,7 +131,7 @@ vp8port_dtor (void * ap_obj)
   tiz_vp8port_t * p_obj = ap_obj;
   tiz_vector_clear (p_obj->p_levels_);
   tiz_vector_destroy (p_obj->p_levels_);
-  return super_dtor (typeOf (ap_obj, "tizvp8port"), ap_obj);
+  return super_dtor (TIZ_TYPE_OF (ap_obj, "tizvp8port"), ap_obj);
 }
 
 /*
@@ -210,7 +210,7 @@ vp8port_GetParameter (const void * ap_obj, OMX_HANDLETYPE ap_hdl,
       default:
         {
           /* Try the parent's indexes */
-          return super_GetParameter (typeOf (ap_obj, "tizvp8port"), ap_obj,
+          return super_GetParameter (TIZ_TYPE_OF (ap_obj, "tizvp8port"), ap_obj,
                                      ap_hdl, a_index, ap_struct);
         }
     };
@@ -331,7 +331,7 @@ vp8port_SetParameter (const void * ap_obj, OMX_HANDLETYPE ap_hdl,
       default:
         {
           /* Try the parent's indexes */
-          return super_SetParameter (typeOf (ap_obj, "tizvp8port"), ap_obj,
+          return super_SetParameter (TIZ_TYPE_OF (ap_obj, "tizvp8port"), ap_obj,
                                      ap_hdl, a_index, ap_struct);
         }
     };
@@ -388,8 +388,8 @@ vp8port_GetConfig (const void * ap_obj, OMX_HANDLETYPE ap_hdl,
       default:
         {
           /* Try the parent's indexes */
-          return super_GetConfig (typeOf (ap_obj, "tizvp8port"), ap_obj, ap_hdl,
-                                  a_index, ap_struct);
+          return super_GetConfig (TIZ_TYPE_OF (ap_obj, "tizvp8port"), ap_obj,
+                                  ap_hdl, a_index, ap_struct);
         }
     };
 
@@ -445,8 +445,8 @@ vp8port_SetConfig (const void * ap_obj, OMX_HANDLETYPE ap_hdl,
       default:
         {
           /* Try the parent's indexes */
-          return super_SetConfig (typeOf (ap_obj, "tizvp8port"), ap_obj, ap_hdl,
-                                  a_index, ap_struct);
+          return super_SetConfig (TIZ_TYPE_OF (ap_obj, "tizvp8port"), ap_obj,
+                                  ap_hdl, a_index, ap_struct);
         }
     };
 
@@ -498,7 +498,7 @@ static void *
 vp8port_class_ctor (void * ap_obj, va_list * app)
 {
   /* NOTE: Class methods might be added in the future. None for now. */
-  return super_ctor (typeOf (ap_obj, "tizvp8port_class"), ap_obj, app);
+  return super_ctor (TIZ_TYPE_OF (ap_obj, "tizvp8port_class"), ap_obj, app);
 }
 
 /*
@@ -508,7 +508,7 @@ vp8port_class_ctor (void * ap_obj, va_list * app)
 void *
 tiz_vp8port_class_init (void * ap_tos, void * ap_hdl)
 {
-  void * tizvideoport = tiz_get_type (ap_hdl, "tizvideoport");
+  void * tizvideoport = TIZ_GET_TYPE (ap_hdl, "tizvideoport");
   void * tizvp8port_class = factory_new
     /* TIZ_CLASS_COMMENT: class type, class name, parent, size */
     (classOf (tizvideoport), "tizvp8port_class", classOf (tizvideoport),
@@ -525,8 +525,8 @@ tiz_vp8port_class_init (void * ap_tos, void * ap_hdl)
 void *
 tiz_vp8port_init (void * ap_tos, void * ap_hdl)
 {
-  void * tizvideoport = tiz_get_type (ap_hdl, "tizvideoport");
-  void * tizvp8port_class = tiz_get_type (ap_hdl, "tizvp8port_class");
+  void * tizvideoport = TIZ_GET_TYPE (ap_hdl, "tizvideoport");
+  void * tizvp8port_class = TIZ_GET_TYPE (ap_hdl, "tizvp8port_class");
   TIZ_LOG_CLASS (tizvp8port_class);
   void * tizvp8port = factory_new
     /* TIZ_CLASS_COMMENT: class type, class name, parent, size */
@@ -50,14 +50,14 @@ static void *
 waitforresources_ctor (void * ap_obj, va_list * app)
 {
   tiz_waitforresources_t * p_obj
-    = super_ctor (typeOf (ap_obj, "tizwaitforresources"), ap_obj, app);
+    = super_ctor (TIZ_TYPE_OF (ap_obj, "tizwaitforresources"), ap_obj, app);
   return p_obj;
 }
 
 static void *
 waitforresources_dtor (void * ap_obj)
 {
-  return super_dtor (typeOf (ap_obj, "tizwaitforresources"), ap_obj);
+  return super_dtor (TIZ_TYPE_OF (ap_obj, "tizwaitforresources"), ap_obj);
 }
 
 static OMX_ERRORTYPE
@@ -179,8 +179,9 @@ waitforresources_trans_complete (const void * ap_obj, OMX_PTR ap_servant,
              tiz_fsm_state_to_str ((tiz_fsm_state_id_t) a_new_state));
   assert (OMX_StateWaitForResources == a_new_state
           || OMX_StateLoaded == a_new_state);
-  return tiz_state_super_trans_complete (typeOf (ap_obj, "tizwaitforresources"),
-                                         ap_obj, ap_servant, a_new_state);
+  return tiz_state_super_trans_complete (
+    TIZ_TYPE_OF (ap_obj, "tizwaitforresources"), ap_obj, ap_servant,
+    a_new_state);
 }
 
 /*
@@ -191,7 +192,8 @@ static void *
 waitforresources_class_ctor (void * ap_obj, va_list * app)
 {
   /* NOTE: Class methods might be added in the future. None for now. */
-  return super_ctor (typeOf (ap_obj, "tizwaitforresources_class"), ap_obj, app);
+  return super_ctor (TIZ_TYPE_OF (ap_obj, "tizwaitforresources_class"), ap_obj,
+                     app);
 }
 
 /*
@@ -201,7 +203,7 @@ waitforresources_class_ctor (void * ap_obj, va_list * app)
 void *
 tiz_waitforresources_class_init (void * ap_tos, void * ap_hdl)
 {
-  void * tizstate = tiz_get_type (ap_hdl, "tizstate");
+  void * tizstate = TIZ_GET_TYPE (ap_hdl, "tizstate");
   void * tizwaitforresources_class
     = factory_new (classOf (tizstate), "tizwaitforresources_class",
                    classOf (tizstate), sizeof (tiz_waitforresources_class_t),
@@ -212,9 +214,9 @@ tiz_waitforresources_class_init (void * ap_tos, void * ap_hdl)
 void *
 tiz_waitforresources_init (void * ap_tos, void * ap_hdl)
 {
-  void * tizstate = tiz_get_type (ap_hdl, "tizstate");
+  void * tizstate = TIZ_GET_TYPE (ap_hdl, "tizstate");
   void * tizwaitforresources_class
-    = tiz_get_type (ap_hdl, "tizwaitforresources_class");
+    = TIZ_GET_TYPE (ap_hdl, "tizwaitforresources_class");
   TIZ_LOG_CLASS (tizwaitforresources_class);
   void * tizwaitforresources = factory_new (
     tizwaitforresources_class, "tizwaitforresources", tizstate,
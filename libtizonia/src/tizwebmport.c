@@ -52,7 +52,7 @@ static void *
 webmport_ctor (void * ap_obj, va_list * app)
 {
   tiz_webmport_t * p_obj
-    = super_ctor (typeOf (ap_obj, "tizwebmport"), ap_obj, app);
+    = super_ctor (TIZ_TYPE_OF (ap_obj, "tizwebmport"), ap_obj, app);
   assert (p_obj);
 
   tiz_check_omx_ret_null (
@@ -66,7 +66,7 @@ webmport_dtor (void * ap_obj)
 {
   tiz_webmport_t * p_obj = ap_obj;
   assert (p_obj);
-  return super_dtor (typeOf (ap_obj, "tizwebmport"), ap_obj);
+  return super_dtor (TIZ_TYPE_OF (ap_obj, "tizwebmport"), ap_obj);
 }
 
 /*
@@ -118,8 +118,8 @@ webmport_GetParameter (const void * ap_obj, OMX_HANDLETYPE ap_hdl,
       default:
         {
           /* Delegate to the base port */
-          return super_GetParameter (typeOf (ap_obj, "tizdemuxerport"), ap_obj,
-                                     ap_hdl, a_index, ap_struct);
+          return super_GetParameter (TIZ_TYPE_OF (ap_obj, "tizdemuxerport"),
+                                     ap_obj, ap_hdl, a_index, ap_struct);
         }
     };
 
@@ -151,7 +151,7 @@ webmport_SetParameter (const void * ap_obj, OMX_HANDLETYPE ap_hdl,
       default:
         {
           /* Try the parent's indexes */
-          rc = super_SetParameter (typeOf (ap_obj, "tizwebmport"), ap_obj,
+          rc = super_SetParameter (TIZ_TYPE_OF (ap_obj, "tizwebmport"), ap_obj,
                                    ap_hdl, a_index, ap_struct);
         }
     };
@@ -210,7 +210,7 @@ static void *
 tiz_webmport_class_ctor (void * ap_obj, va_list * app)
 {
   /* NOTE: Class methods might be added in the future. None for now. */
-  return super_ctor (typeOf (ap_obj, "tizwebmport_class"), ap_obj, app);
+  return super_ctor (TIZ_TYPE_OF (ap_obj, "tizwebmport_class"), ap_obj, app);
 }
 
 /*
@@ -220,7 +220,7 @@ tiz_webmport_class_ctor (void * ap_obj, va_list * app)
 void *
 tiz_webmport_class_init (void * ap_tos, void * ap_hdl)
 {
-  void * tizport = tiz_get_type (ap_hdl, "tizport");
+  void * tizport = TIZ_GET_TYPE (ap_hdl, "tizport");
   void * tizwebmport_class = factory_new
     /* TIZ_CLASS_COMMENT: class type, class name, parent, size */
     (classOf (tizport), "tizwebmport_class", classOf (tizport),
@@ -237,8 +237,8 @@ tiz_webmport_class_init (void * ap_tos, void * ap_hdl)
 void *
 tiz_webmport_init (void * ap_tos, void * ap_hdl)
 {
-  void * tizport = tiz_get_type (ap_hdl, "tizport");
-  void * tizwebmport_class = tiz_get_type (ap_hdl, "tizwebmport_class");
+  void * tizport = TIZ_GET_TYPE (ap_hdl, "tizport");
+  void * tizwebmport_class = TIZ_GET_TYPE (ap_hdl, "tizwebmport_class");
   TIZ_LOG_CLASS (tizwebmport_class);
   void * tizwebmport = factory_new
     /* TIZ_CLASS_COMMENT: class type, class name, parent, size */
@@ -143,14 +143,14 @@ instantiate_pcm_port (OMX_HANDLETYPE ap_hdl)
   mute.nPortIndex        = 0;
   mute.bMute             = OMX_FALSE;
 
-  return factory_new (tiz_get_type (ap_hdl, "tizpcmport"), &port_opts,
+  return factory_new (TIZ_GET_TYPE (ap_hdl, "tizpcmport"), &port_opts,
                       &encodings, &pcmmode, &volume, &mute);
 }
 
 static OMX_PTR
 instantiate_config_port (OMX_HANDLETYPE ap_hdl)
 {
-  return factory_new (tiz_get_type (ap_hdl, "tizconfigport"),
+  return factory_new (TIZ_GET_TYPE (ap_hdl, "tizconfigport"),
                       NULL,   /* this port does not take options */
                       TC_COMPONENT_NAME, tc_comp_version);
 }
@@ -158,7 +158,7 @@ instantiate_config_port (OMX_HANDLETYPE ap_hdl)
 static OMX_PTR
 instantiate_processor (OMX_HANDLETYPE ap_hdl)
 {
-  return factory_new (tiz_get_type (ap_hdl, "tiztcprc"));
+  return factory_new (TIZ_GET_TYPE (ap_hdl, "tiztcprc"));
 }
 
 OMX_ERRORTYPE
@@ -51,14 +51,15 @@
 static void *
 tcprc_ctor (void *ap_obj, va_list * app)
 {
-  tiz_tcprc_t *p_obj = super_ctor (typeOf (ap_obj, "tiztcprc"), ap_obj, app);
+  tiz_tcprc_t *p_obj = super_ctor (TIZ_TYPE_OF (ap_obj, "tiztcprc"), ap_obj,
+                                   app);
   return p_obj;
 }
 
 static void *
 tcprc_dtor (void *ap_obj)
 {
-  return super_dtor (typeOf (ap_obj, "tiztcprc"), ap_obj);
+  return super_dtor (TIZ_TYPE_OF (ap_obj, "tiztcprc"), ap_obj);
 }
 
 static OMX_ERRORTYPE
@@ -138,7 +139,7 @@ static void *
 tcprc_class_ctor (void *ap_obj, va_list * app)
 {
   /* NOTE: Class methods might be added in the future. None for now. */
-  return super_ctor (typeOf (ap_obj, "tiztcprc_class"), ap_obj, app);
+  return super_ctor (TIZ_TYPE_OF (ap_obj, "tiztcprc_class"), ap_obj, app);
 }
 
 /*
@@ -148,7 +149,7 @@ tcprc_class_ctor (void *ap_obj, va_list * app)
 void *
 tiz_tcprc_class_init (void * ap_tos, void * ap_hdl)
 {
-  void * tizprc = tiz_get_type (ap_hdl, "tizprc");
+  void * tizprc = TIZ_GET_TYPE (ap_hdl, "tizprc");
   void * tiztcprc_class = factory_new (classOf (tizprc),
                                          "tiztcprc_class",
                                          classOf (tizprc),
@@ -161,8 +162,8 @@ tiz_tcprc_class_init (void * ap_tos, void * ap_hdl)
 void *
 tiz_tcprc_init (void * ap_tos, void * ap_hdl)
 {
-  void * tizprc = tiz_get_type (ap_hdl, "tizprc");
-  void * tiztcprc_class = tiz_get_type (ap_hdl, "tiztcprc_class");
+  void * tizprc = TIZ_GET_TYPE (ap_hdl, "tizprc");
+  void * tiztcprc_class = TIZ_GET_TYPE (ap_hdl, "tiztcprc_class");
   TIZ_LOG_CLASS (tiztcprc_class);
   void * tiztcprc =
     factory_new
@@ -33,13 +33,16 @@
 #include <stdlib.h>
 #include <stdbool.h>
 #include <stdio.h>
+#include <string.h>
 #include <unistd.h>
 #include <sys/time.h>
 #include <check.h>
 #include <sys/types.h>
+#include <sys/prctl.h>
 #include <signal.h>
 #include <assert.h>
 #include <limits.h>
+#include <time.h>
 
 #include <OMX_Component.h>
 #include <OMX_TizoniaExt.h>
@@ -2021,6 +2024,713 @@ START_TEST (test_tizonia_command_cancellation_disabled_to_enabled_with_tunneled_
 }
 END_TEST
 
+/* Buffers cycled through the test component's input port for each batch
+   budget under test */
+#define BATCH_BENCH_BUFFER_COUNT 16
+#define BATCH_BENCH_BUFFER_ROUNDS 100000
+
+/* The number of bytes the perf stats test says an EGLImage holds */
+#define PERF_STATS_FILLED_LEN 4096
+
+/* The benchmarks are not part of 'make check'; they are only run when
+   TIZONIA_CHECK_BENCH is set in the environment (see 'make bench') */
+#define CHECK_BENCH_ENV "TIZONIA_CHECK_BENCH"
+
+static bool
+check_bench_enabled (void)
+{
+  const char *p_env = getenv (CHECK_BENCH_ENV);
+  return p_env && *p_env && 0 != strcmp (p_env, "0");
+}
+
+/* Seconds elapsed since ap_start (from CLOCK_MONOTONIC) */
+static double
+check_bench_elapsed_s (const struct timespec *ap_start)
+{
+  struct timespec now;
+  (void) clock_gettime (CLOCK_MONOTONIC, &now);
+  return (now.tv_sec - ap_start->tv_sec)
+         + (now.tv_nsec - ap_start->tv_nsec) / 1e9;
+}
+
+typedef struct check_batch_bench_context check_batch_bench_context_t;
+struct check_batch_bench_context
+{
+  cc_ctx_t ctx; /* Must be the first member; see check_EventHandler */
+  tiz_queue_t *p_returned;
+  OMX_U8 eglimages[BATCH_BENCH_BUFFER_COUNT]; /* Opaque EGLImage handles */
+};
+
+static OMX_ERRORTYPE
+check_batch_bench_EmptyBufferDone (OMX_HANDLETYPE ap_hdl,
+                                   OMX_PTR ap_app_data,
+                                   OMX_BUFFERHEADERTYPE * ap_buf)
+{
+  check_batch_bench_context_t *p_bench = ap_app_data;
+  assert (p_bench);
+  return tiz_queue_send (p_bench->p_returned, ap_buf);
+}
+
+static OMX_CALLBACKTYPE _check_batch_bench_cbacks = {
+  check_EventHandler,
+  check_batch_bench_EmptyBufferDone,
+  check_FillBufferDone
+};
+
+/* On the way to OMX_StateIdle, the port is populated with buffers of
+   a_buf_size bytes, or with EGLImages when a_buf_size is 0. The test
+   component's processor only accepts the latter. */
+static void
+check_batch_bench_transition (check_batch_bench_context_t *ap_bench,
+                              OMX_HANDLETYPE ap_hdl, OMX_STATETYPE a_state,
+                              OMX_BUFFERHEADERTYPE **app_hdrs,
+                              OMX_U32 a_nbufs, OMX_U32 a_buf_size)
+{
+  check_common_context_t *p_ctx = ap_bench->ctx;
+  OMX_BOOL timedout = OMX_FALSE;
+  OMX_U32 i;
+
+  fail_if (OMX_ErrorNone != _ctx_reset (&ap_bench->ctx));
+  fail_if (OMX_ErrorNone
+           != OMX_SendCommand (ap_hdl, OMX_CommandStateSet, a_state, NULL));
+
+  for (i = 0; i < a_nbufs; ++i)
+    {
+      if (OMX_StateIdle == a_state && 0 == a_buf_size)
+        {
+          fail_if (OMX_ErrorNone
+                   != OMX_UseEGLImage (ap_hdl, &app_hdrs[i], 0, NULL,
+                                       &(ap_bench->eglimages[i])));
+        }
+      else if (OMX_StateIdle == a_state)
+        {
+          fail_if (OMX_ErrorNone
+                   != OMX_AllocateBuffer (ap_hdl, &app_hdrs[i], 0, 0,
+                                          a_buf_size));
+        }
+      else
+        {
+          fail_if (OMX_ErrorNone != OMX_FreeBuffer (ap_hdl, 0, app_hdrs[i]));
+        }
+    }
+
+  fail_if (OMX_ErrorNone
+           != _ctx_wait (&ap_bench->ctx, TIMEOUT_EXPECTING_SUCCESS,
+                         &timedout));
+  fail_if (OMX_TRUE == timedout);
+  fail_if (a_state != p_ctx->state);
+}
+
+/* Returns the number of buffers per second that went through the
+   component */
+static double
+check_batch_bench_run (check_batch_bench_context_t *ap_bench,
+                       OMX_HANDLETYPE ap_hdl, OMX_BUFFERHEADERTYPE **app_hdrs,
+                       OMX_U32 a_nbufs)
+{
+  struct timespec start;
+  OMX_U32 issued = 0;
+  OMX_U32 returned = 0;
+  double elapsed = 0;
+
+  (void) clock_gettime (CLOCK_MONOTONIC, &start);
+
+  for (issued = 0; issued < a_nbufs; ++issued)
+    {
+      app_hdrs[issued]->nFilledLen = app_hdrs[issued]->nAllocLen;
+      fail_if (OMX_ErrorNone != OMX_EmptyThisBuffer (ap_hdl, app_hdrs[issued]));
+    }
+
+  while (returned < BATCH_BENCH_BUFFER_ROUNDS)
+    {
+      OMX_PTR p_hdr = NULL;
+      fail_if (OMX_ErrorNone
+               != tiz_queue_receive (ap_bench->p_returned, &p_hdr));
+      ++returned;
+      if (issued < BATCH_BENCH_BUFFER_ROUNDS)
+        {
+          ((OMX_BUFFERHEADERTYPE *) p_hdr)->nFilledLen
+            = ((OMX_BUFFERHEADERTYPE *) p_hdr)->nAllocLen;
+          fail_if (OMX_ErrorNone != OMX_EmptyThisBuffer (ap_hdl, p_hdr));
+          ++issued;
+        }
+    }
+
+  elapsed = check_bench_elapsed_s (&start);
+
+  return BATCH_BENCH_BUFFER_ROUNDS / elapsed;
+}
+
+START_TEST (test_tizonia_batched_ticks_benchmark)
+{
+  OMX_HANDLETYPE p_hdl = 0;
+  check_batch_bench_context_t bench;
+  OMX_PARAM_PORTDEFINITIONTYPE port_def;
+  OMX_BUFFERHEADERTYPE *hdrs[BATCH_BENCH_BUFFER_COUNT];
+  const OMX_U32 budgets[] = {1, 16};
+  double rates[2];
+  OMX_U32 i;
+
+  fail_if (OMX_ErrorNone != _ctx_init (&bench.ctx));
+  fail_if (OMX_ErrorNone
+           != tiz_queue_init (&bench.p_returned, BATCH_BENCH_BUFFER_COUNT));
+
+  fail_if (OMX_ErrorNone != OMX_Init ());
+  fail_if (OMX_ErrorNone
+           != OMX_GetHandle (&p_hdl, COMPONENT_NAME, &bench,
+                             &_check_batch_bench_cbacks));
+
+  port_def.nSize = sizeof (OMX_PARAM_PORTDEFINITIONTYPE);
+  port_def.nVersion.nVersion = OMX_VERSION;
+  port_def.nPortIndex = 0;
+  fail_if (OMX_ErrorNone
+           != OMX_GetParameter (p_hdl, OMX_IndexParamPortDefinition,
+                                &port_def));
+  port_def.nBufferCountActual = BATCH_BENCH_BUFFER_COUNT;
+  fail_if (OMX_ErrorNone
+           != OMX_SetParameter (p_hdl, OMX_IndexParamPortDefinition,
+                                &port_def));
+
+  check_batch_bench_transition (&bench, p_hdl, OMX_StateIdle, hdrs,
+                                BATCH_BENCH_BUFFER_COUNT, 0);
+  check_batch_bench_transition (&bench, p_hdl, OMX_StateExecuting, hdrs, 0,
+                                0);
+
+  for (i = 0; i < 2; ++i)
+    {
+      tiz_comp_set_tick_budget (p_hdl, budgets[i], 0);
+      rates[i] = check_batch_bench_run (&bench, p_hdl, hdrs,
+                                        BATCH_BENCH_BUFFER_COUNT);
+    }
+
+  printf ("[%d buffers, %d rounds] batch 1: %.0f bufs/s - batch %u: "
+          "%.0f bufs/s (%+.1f%%)\n",
+          BATCH_BENCH_BUFFER_COUNT, BATCH_BENCH_BUFFER_ROUNDS, rates[0],
+          (unsigned int) budgets[1], rates[1],
+          (rates[1] - rates[0]) * 100 / rates[0]);
+
+  check_batch_bench_transition (&bench, p_hdl, OMX_StateIdle, hdrs, 0, 0);
+  check_batch_bench_transition (&bench, p_hdl, OMX_StateLoaded, hdrs,
+                                BATCH_BENCH_BUFFER_COUNT, 0);
+
+  fail_if (OMX_ErrorNone != OMX_FreeHandle (p_hdl));
+  fail_if (OMX_ErrorNone != OMX_Deinit ());
+
+  tiz_queue_destroy (bench.p_returned);
+  _ctx_destroy (&bench.ctx);
+}
+END_TEST
+
+/* Like check_batch_bench_run, but buffers are submitted a_batch at a time
+   through the OMX_TizoniaIndexConfigEmptyTheseBuffers extension */
+static double
+check_batch_bench_run_batched (check_batch_bench_context_t *ap_bench,
+                               OMX_HANDLETYPE ap_hdl, OMX_INDEXTYPE a_index,
+                               OMX_BUFFERHEADERTYPE **app_hdrs,
+                               OMX_U32 a_nbufs, OMX_U32 a_batch)
+{
+  struct timespec start;
+  OMX_BUFFERHEADERTYPE *pending[BATCH_BENCH_BUFFER_COUNT];
+  OMX_TIZONIA_BUFFERBATCHTYPE batch;
+  OMX_U32 npending = 0;
+  OMX_U32 issued = 0;
+  OMX_U32 returned = 0;
+  OMX_U32 i = 0;
+  double elapsed = 0;
+
+  assert (a_batch <= a_nbufs);
+
+  batch.nSize = sizeof (OMX_TIZONIA_BUFFERBATCHTYPE);
+  batch.nVersion.nVersion = OMX_VERSION;
+  batch.ppHeaders = pending;
+
+  (void) clock_gettime (CLOCK_MONOTONIC, &start);
+
+  for (i = 0; i < a_nbufs; ++i)
+    {
+      app_hdrs[i]->nFilledLen = app_hdrs[i]->nAllocLen;
+      pending[i] = app_hdrs[i];
+    }
+  batch.nBufferCount = a_nbufs;
+  fail_if (OMX_ErrorNone != OMX_SetConfig (ap_hdl, a_index, &batch));
+  issued = a_nbufs;
+
+  while (returned < BATCH_BENCH_BUFFER_ROUNDS)
+    {
+      OMX_PTR p_hdr = NULL;
+      fail_if (OMX_ErrorNone
+               != tiz_queue_receive (ap_bench->p_returned, &p_hdr));
+      ++returned;
+      if (issued < BATCH_BENCH_BUFFER_ROUNDS)
+        {
+          ((OMX_BUFFERHEADERTYPE *) p_hdr)->nFilledLen
+            = ((OMX_BUFFERHEADERTYPE *) p_hdr)->nAllocLen;
+          pending[npending++] = p_hdr;
+          ++issued;
+          if (npending == a_batch || issued == BATCH_BENCH_BUFFER_ROUNDS)
+            {
+              batch.nBufferCount = npending;
+              fail_if (OMX_ErrorNone
+                       != OMX_SetConfig (ap_hdl, a_index, &batch));
+              npending = 0;
+            }
+        }
+    }
+
+  elapsed = check_bench_elapsed_s (&start);
+
+  return BATCH_BENCH_BUFFER_ROUNDS / elapsed;
+}
+
+START_TEST (test_tizonia_buffer_batch_extension)
+{
+  OMX_HANDLETYPE p_hdl = 0;
+  check_batch_bench_context_t bench;
+  OMX_PARAM_PORTDEFINITIONTYPE port_def;
+  OMX_BUFFERHEADERTYPE *hdrs[BATCH_BENCH_BUFFER_COUNT];
+  OMX_TIZONIA_BUFFERBATCHTYPE batch;
+  OMX_INDEXTYPE etb_index = OMX_IndexMax;
+  OMX_INDEXTYPE ftb_index = OMX_IndexMax;
+
+  fail_if (OMX_ErrorNone != _ctx_init (&bench.ctx));
+  fail_if (OMX_ErrorNone
+           != tiz_queue_init (&bench.p_returned, BATCH_BENCH_BUFFER_COUNT));
+
+  fail_if (OMX_ErrorNone != OMX_Init ());
+  fail_if (OMX_ErrorNone
+           != OMX_GetHandle (&p_hdl, COMPONENT_NAME, &bench,
+                             &_check_batch_bench_cbacks));
+
+  fail_if (OMX_ErrorNone
+           != OMX_GetExtensionIndex (
+                p_hdl, OMX_TIZONIA_INDEX_CONFIG_EMPTYTHESEBUFFERS,
+                &etb_index));
+  fail_if (OMX_TizoniaIndexConfigEmptyTheseBuffers != etb_index);
+  fail_if (OMX_ErrorNone
+           != OMX_GetExtensionIndex (
+                p_hdl, OMX_TIZONIA_INDEX_CONFIG_FILLTHESEBUFFERS,
+                &ftb_index));
+  fail_if (OMX_TizoniaIndexConfigFillTheseBuffers != ftb_index);
+
+  /* Malformed batches are rejected straight away */
+  batch.nSize = sizeof (OMX_TIZONIA_BUFFERBATCHTYPE);
+  batch.nVersion.nVersion = OMX_VERSION;
+  batch.nBufferCount = 1;
+  batch.ppHeaders = NULL;
+  fail_if (OMX_ErrorBadParameter != OMX_SetConfig (p_hdl, etb_index, &batch));
+
+  port_def.nSize = sizeof (OMX_PARAM_PORTDEFINITIONTYPE);
+  port_def.nVersion.nVersion = OMX_VERSION;
+  port_def.nPortIndex = 0;
+  fail_if (OMX_ErrorNone
+           != OMX_GetParameter (p_hdl, OMX_IndexParamPortDefinition,
+                                &port_def));
+  port_def.nBufferCountActual = BATCH_BENCH_BUFFER_COUNT;
+  fail_if (OMX_ErrorNone
+           != OMX_SetParameter (p_hdl, OMX_IndexParamPortDefinition,
+                                &port_def));
+
+  check_batch_bench_transition (&bench, p_hdl, OMX_StateIdle, hdrs,
+                                BATCH_BENCH_BUFFER_COUNT, 0);
+  check_batch_bench_transition (&bench, p_hdl, OMX_StateExecuting, hdrs, 0,
+                                0);
+
+  /* Every buffer submitted in a batch comes back */
+  (void) check_batch_bench_run_batched (&bench, p_hdl, etb_index, hdrs,
+                                        BATCH_BENCH_BUFFER_COUNT,
+                                        BATCH_BENCH_BUFFER_COUNT / 2);
+
+  check_batch_bench_transition (&bench, p_hdl, OMX_StateIdle, hdrs, 0, 0);
+  check_batch_bench_transition (&bench, p_hdl, OMX_StateLoaded, hdrs,
+                                BATCH_BENCH_BUFFER_COUNT, 0);
+
+  fail_if (OMX_ErrorNone != OMX_FreeHandle (p_hdl));
+  fail_if (OMX_ErrorNone != OMX_Deinit ());
+
+  tiz_queue_destroy (bench.p_returned);
+  _ctx_destroy (&bench.ctx);
+}
+END_TEST
+
+START_TEST (test_tizonia_buffer_batch_benchmark)
+{
+  OMX_HANDLETYPE p_hdl = 0;
+  check_batch_bench_context_t bench;
+  OMX_PARAM_PORTDEFINITIONTYPE port_def;
+  OMX_BUFFERHEADERTYPE *hdrs[BATCH_BENCH_BUFFER_COUNT];
+  OMX_INDEXTYPE etb_index = OMX_IndexMax;
+  double single_rate = 0;
+  double batch_rate = 0;
+
+  fail_if (OMX_ErrorNone != _ctx_init (&bench.ctx));
+  fail_if (OMX_ErrorNone
+           != tiz_queue_init (&bench.p_returned, BATCH_BENCH_BUFFER_COUNT));
+
+  fail_if (OMX_ErrorNone != OMX_Init ());
+  fail_if (OMX_ErrorNone
+           != OMX_GetHandle (&p_hdl, COMPONENT_NAME, &bench,
+                             &_check_batch_bench_cbacks));
+
+  fail_if (OMX_ErrorNone
+           != OMX_GetExtensionIndex (
+                p_hdl, OMX_TIZONIA_INDEX_CONFIG_EMPTYTHESEBUFFERS,
+                &etb_index));
+
+  port_def.nSize = sizeof (OMX_PARAM_PORTDEFINITIONTYPE);
+  port_def.nVersion.nVersion = OMX_VERSION;
+  port_def.nPortIndex = 0;
+  fail_if (OMX_ErrorNone
+           != OMX_GetParameter (p_hdl, OMX_IndexParamPortDefinition,
+                                &port_def));
+  port_def.nBufferCountActual = BATCH_BENCH_BUFFER_COUNT;
+  fail_if (OMX_ErrorNone
+           != OMX_SetParameter (p_hdl, OMX_IndexParamPortDefinition,
+                                &port_def));
+
+  check_batch_bench_transition (&bench, p_hdl, OMX_StateIdle, hdrs,
+                                BATCH_BENCH_BUFFER_COUNT, 0);
+  check_batch_bench_transition (&bench, p_hdl, OMX_StateExecuting, hdrs, 0,
+                                0);
+
+  single_rate = check_batch_bench_run (&bench, p_hdl, hdrs,
+                                       BATCH_BENCH_BUFFER_COUNT);
+  batch_rate = check_batch_bench_run_batched (
+    &bench, p_hdl, etb_index, hdrs, BATCH_BENCH_BUFFER_COUNT,
+    BATCH_BENCH_BUFFER_COUNT / 2);
+
+  printf ("[%d buffers, %d rounds] EmptyThisBuffer: %.0f bufs/s - "
+          "EmptyTheseBuffers (%d per call): %.0f bufs/s (%+.1f%%)\n",
+          BATCH_BENCH_BUFFER_COUNT, BATCH_BENCH_BUFFER_ROUNDS, single_rate,
+          BATCH_BENCH_BUFFER_COUNT / 2, batch_rate,
+          (batch_rate - single_rate) * 100 / single_rate);
+
+  check_batch_bench_transition (&bench, p_hdl, OMX_StateIdle, hdrs, 0, 0);
+  check_batch_bench_transition (&bench, p_hdl, OMX_StateLoaded, hdrs,
+                                BATCH_BENCH_BUFFER_COUNT, 0);
+
+  fail_if (OMX_ErrorNone != OMX_FreeHandle (p_hdl));
+  fail_if (OMX_ErrorNone != OMX_Deinit ());
+
+  tiz_queue_destroy (bench.p_returned);
+  _ctx_destroy (&bench.ctx);
+}
+END_TEST
+
+START_TEST (test_tizonia_perf_stats_extension)
+{
+  OMX_HANDLETYPE p_hdl = 0;
+  check_batch_bench_context_t bench;
+  OMX_PARAM_PORTDEFINITIONTYPE port_def;
+  OMX_BUFFERHEADERTYPE *hdrs[BATCH_BENCH_BUFFER_COUNT];
+  OMX_TIZONIA_PERFSTATSTYPE stats;
+  OMX_INDEXTYPE stats_index = OMX_IndexMax;
+
+  fail_if (OMX_ErrorNone != _ctx_init (&bench.ctx));
+  fail_if (OMX_ErrorNone
+           != tiz_queue_init (&bench.p_returned, BATCH_BENCH_BUFFER_COUNT));
+
+  fail_if (OMX_ErrorNone != OMX_Init ());
+  fail_if (OMX_ErrorNone
+           != OMX_GetHandle (&p_hdl, COMPONENT_NAME, &bench,
+                             &_check_batch_bench_cbacks));
+
+  fail_if (OMX_ErrorNone
+           != OMX_GetExtensionIndex (p_hdl, OMX_TIZONIA_INDEX_CONFIG_PERFSTATS,
+                                     &stats_index));
+  fail_if (OMX_TizoniaIndexConfigPerfStats != stats_index);
+
+  port_def.nSize = sizeof (OMX_PARAM_PORTDEFINITIONTYPE);
+  port_def.nVersion.nVersion = OMX_VERSION;
+  port_def.nPortIndex = 0;
+  fail_if (OMX_ErrorNone
+           != OMX_GetParameter (p_hdl, OMX_IndexParamPortDefinition,
+                                &port_def));
+  port_def.nBufferCountActual = BATCH_BENCH_BUFFER_COUNT;
+  fail_if (OMX_ErrorNone
+           != OMX_SetParameter (p_hdl, OMX_IndexParamPortDefinition,
+                                &port_def));
+
+  check_batch_bench_transition (&bench, p_hdl, OMX_StateIdle, hdrs,
+                                BATCH_BENCH_BUFFER_COUNT, 0);
+  check_batch_bench_transition (&bench, p_hdl, OMX_StateExecuting, hdrs, 0,
+                                0);
+
+  (void) check_batch_bench_run (&bench, p_hdl, hdrs,
+                                BATCH_BENCH_BUFFER_COUNT);
+
+  stats.nSize = sizeof (OMX_TIZONIA_PERFSTATSTYPE);
+  stats.nVersion.nVersion = OMX_VERSION;
+  stats.nPortIndex = 1;
+  fail_if (OMX_ErrorBadPortIndex
+           != OMX_GetConfig (p_hdl, OMX_TizoniaIndexConfigPerfStats, &stats));
+
+  stats.nPortIndex = 0;
+  fail_if (OMX_ErrorNone
+           != OMX_GetConfig (p_hdl, OMX_TizoniaIndexConfigPerfStats, &stats));
+
+  fail_if (stats.nMessages[OMX_TIZONIA_PerfStatsMsgCommand] < 2);
+  fail_if (0 == stats.nMsgPoolHits);
+  fail_if (stats.nMessages[OMX_TIZONIA_PerfStatsMsgBufferMgmt]
+           < BATCH_BENCH_BUFFER_COUNT);
+  fail_if (stats.nMessages[OMX_TIZONIA_PerfStatsMsgBuffer]
+           < BATCH_BENCH_BUFFER_ROUNDS);
+  fail_if (stats.nMailboxHighWater < 1);
+  fail_if (stats.nTicks < stats.nMessages[OMX_TIZONIA_PerfStatsMsgBuffer]);
+  fail_if (stats.nBuffersClaimed < BATCH_BENCH_BUFFER_ROUNDS);
+  fail_if (stats.nBuffersReleased < BATCH_BENCH_BUFFER_ROUNDS);
+  /* The run left nFilledLen at nAllocLen, which is 0 for an EGLImage */
+  fail_if (0 != stats.nBytes);
+  fail_if (0 == stats.nTransferAndProcessCalls);
+  fail_if (0 == stats.nBuffersReadyCalls);
+
+  /* Setting the config resets the counters */
+  fail_if (OMX_ErrorNone
+           != OMX_SetConfig (p_hdl, OMX_TizoniaIndexConfigPerfStats, &stats));
+  stats.nPortIndex = OMX_ALL;
+  fail_if (OMX_ErrorNone
+           != OMX_GetConfig (p_hdl, OMX_TizoniaIndexConfigPerfStats, &stats));
+  fail_if (0 != stats.nMessages[OMX_TIZONIA_PerfStatsMsgBuffer]);
+  fail_if (0 != stats.nBuffersClaimed);
+  fail_if (0 != stats.nBuffersReadyCalls);
+
+  /* The bytes that the client says an EGLImage holds are counted when the
+     input buffer is claimed */
+  hdrs[0]->nFilledLen = PERF_STATS_FILLED_LEN;
+  fail_if (OMX_ErrorNone != OMX_EmptyThisBuffer (p_hdl, hdrs[0]));
+  {
+    OMX_PTR p_hdr = NULL;
+    fail_if (OMX_ErrorNone != tiz_queue_receive (bench.p_returned, &p_hdr));
+    fail_if (hdrs[0] != p_hdr);
+  }
+  stats.nPortIndex = 0;
+  fail_if (OMX_ErrorNone
+           != OMX_GetConfig (p_hdl, OMX_TizoniaIndexConfigPerfStats, &stats));
+  fail_if (1 != stats.nBuffersClaimed);
+  fail_if (PERF_STATS_FILLED_LEN != stats.nBytes);
+
+  check_batch_bench_transition (&bench, p_hdl, OMX_StateIdle, hdrs, 0, 0);
+  check_batch_bench_transition (&bench, p_hdl, OMX_StateLoaded, hdrs,
+                                BATCH_BENCH_BUFFER_COUNT, 0);
+
+  fail_if (OMX_ErrorNone != OMX_FreeHandle (p_hdl));
+  fail_if (OMX_ErrorNone != OMX_Deinit ());
+
+  tiz_queue_destroy (bench.p_returned);
+  _ctx_destroy (&bench.ctx);
+}
+END_TEST
+
+START_TEST (test_tizonia_mem_stats_extension)
+{
+  OMX_HANDLETYPE p_hdl = 0;
+  check_batch_bench_context_t bench;
+  OMX_PARAM_PORTDEFINITIONTYPE port_def;
+  OMX_BUFFERHEADERTYPE *hdrs[BATCH_BENCH_BUFFER_COUNT];
+  OMX_TIZONIA_MEMSTATSTYPE stats;
+  OMX_INDEXTYPE stats_index = OMX_IndexMax;
+  OMX_U64 loaded_bytes = 0;
+  OMX_BOOL timedout = OMX_FALSE;
+  OMX_U32 i = 0;
+
+  fail_if (OMX_ErrorNone != _ctx_init (&bench.ctx));
+  fail_if (OMX_ErrorNone
+           != tiz_queue_init (&bench.p_returned, BATCH_BENCH_BUFFER_COUNT));
+
+  fail_if (OMX_ErrorNone != OMX_Init ());
+  fail_if (OMX_ErrorNone
+           != OMX_GetHandle (&p_hdl, COMPONENT_NAME, &bench,
+                             &_check_batch_bench_cbacks));
+
+  fail_if (OMX_ErrorNone
+           != OMX_GetExtensionIndex (p_hdl, OMX_TIZONIA_INDEX_CONFIG_MEMSTATS,
+                                     &stats_index));
+  fail_if (OMX_TizoniaIndexConfigMemStats != stats_index);
+
+  /* The component's initialisation is on its account */
+  stats.nSize = sizeof (OMX_TIZONIA_MEMSTATSTYPE);
+  stats.nVersion.nVersion = OMX_VERSION;
+  fail_if (OMX_ErrorNone
+           != OMX_GetConfig (p_hdl, OMX_TizoniaIndexConfigMemStats, &stats));
+  fail_if (0 == stats.nAllocations);
+  fail_if (0 == stats.nBytesInUse);
+  fail_if (stats.nBytesPeak < stats.nBytesInUse);
+  fail_if (0 != stats.nFailures);
+  fail_if (0 != stats.nBytesLimit);
+  loaded_bytes = stats.nBytesInUse;
+
+  port_def.nSize = sizeof (OMX_PARAM_PORTDEFINITIONTYPE);
+  port_def.nVersion.nVersion = OMX_VERSION;
+  port_def.nPortIndex = 0;
+  fail_if (OMX_ErrorNone
+           != OMX_GetParameter (p_hdl, OMX_IndexParamPortDefinition,
+                                &port_def));
+  port_def.nBufferCountActual = BATCH_BENCH_BUFFER_COUNT;
+  fail_if (OMX_ErrorNone
+           != OMX_SetParameter (p_hdl, OMX_IndexParamPortDefinition,
+                                &port_def));
+
+  /* So are the buffers it allocates */
+  check_batch_bench_transition (&bench, p_hdl, OMX_StateIdle, hdrs,
+                                BATCH_BENCH_BUFFER_COUNT,
+                                port_def.nBufferSize);
+  fail_if (OMX_ErrorNone
+           != OMX_GetConfig (p_hdl, OMX_TizoniaIndexConfigMemStats, &stats));
+  fail_if (stats.nBytesInUse
+           < loaded_bytes
+               + (OMX_U64) BATCH_BENCH_BUFFER_COUNT * port_def.nBufferSize);
+
+  check_batch_bench_transition (&bench, p_hdl, OMX_StateLoaded, hdrs,
+                                BATCH_BENCH_BUFFER_COUNT, 0);
+  fail_if (OMX_ErrorNone
+           != OMX_GetConfig (p_hdl, OMX_TizoniaIndexConfigMemStats, &stats));
+  fail_if (stats.nBytesInUse
+           >= loaded_bytes
+                + (OMX_U64) BATCH_BENCH_BUFFER_COUNT * port_def.nBufferSize);
+  fail_if (0 == stats.nFrees);
+
+  /* Setting the config sets the limit and resets the counters */
+  stats.nBytesLimit = stats.nBytesInUse + port_def.nBufferSize / 2;
+  fail_if (OMX_ErrorNone
+           != OMX_SetConfig (p_hdl, OMX_TizoniaIndexConfigMemStats, &stats));
+  fail_if (OMX_ErrorNone
+           != OMX_GetConfig (p_hdl, OMX_TizoniaIndexConfigMemStats, &stats));
+  fail_if (0 != stats.nAllocations);
+  fail_if (0 != stats.nFrees);
+  fail_if (stats.nBytesInUse + port_def.nBufferSize / 2 != stats.nBytesLimit);
+
+  /* Past the limit, the component runs out of memory... */
+  fail_if (OMX_ErrorNone != _ctx_reset (&bench.ctx));
+  fail_if (OMX_ErrorNone
+           != OMX_SendCommand (p_hdl, OMX_CommandStateSet, OMX_StateIdle,
+                               NULL));
+  fail_if (OMX_ErrorInsufficientResources
+           != OMX_AllocateBuffer (p_hdl, &hdrs[0], 0, 0,
+                                  port_def.nBufferSize));
+  fail_if (OMX_ErrorNone
+           != OMX_GetConfig (p_hdl, OMX_TizoniaIndexConfigMemStats, &stats));
+  fail_if (0 == stats.nFailures);
+
+  /* ...until the limit is lifted */
+  stats.nBytesLimit = 0;
+  fail_if (OMX_ErrorNone
+           != OMX_SetConfig (p_hdl, OMX_TizoniaIndexConfigMemStats, &stats));
+  for (i = 0; i < BATCH_BENCH_BUFFER_COUNT; ++i)
+    {
+      fail_if (OMX_ErrorNone
+               != OMX_AllocateBuffer (p_hdl, &hdrs[i], 0, 0,
+                                      port_def.nBufferSize));
+    }
+  fail_if (OMX_ErrorNone
+           != _ctx_wait (&bench.ctx, TIMEOUT_EXPECTING_SUCCESS, &timedout));
+  fail_if (OMX_TRUE == timedout);
+  fail_if (OMX_StateIdle != ((check_common_context_t *) bench.ctx)->state);
+
+  check_batch_bench_transition (&bench, p_hdl, OMX_StateLoaded, hdrs,
+                                BATCH_BENCH_BUFFER_COUNT, 0);
+
+  fail_if (OMX_ErrorNone != OMX_FreeHandle (p_hdl));
+  fail_if (OMX_ErrorNone != OMX_Deinit ());
+
+  tiz_queue_destroy (bench.p_returned);
+  _ctx_destroy (&bench.ctx);
+}
+END_TEST
+
+/* The name of the scheduler's worker threads in 'pool' mode */
+#define POOL_SCHED_THREAD_NAME "tizschedpool"
+
+typedef struct check_pool_sched_context check_pool_sched_context_t;
+struct check_pool_sched_context
+{
+  check_batch_bench_context_t bench; /* Must be the first member */
+  OMX_U32 returned;
+  OMX_U32 off_pool; /* Buffers returned from some other thread */
+};
+
+static OMX_ERRORTYPE
+check_pool_sched_EmptyBufferDone (OMX_HANDLETYPE ap_hdl,
+                                  OMX_PTR ap_app_data,
+                                  OMX_BUFFERHEADERTYPE * ap_buf)
+{
+  check_pool_sched_context_t *p_pool = ap_app_data;
+  char name[16] = "";
+  assert (p_pool);
+  (void) prctl (PR_GET_NAME, name);
+  if (0 != strncmp (name, POOL_SCHED_THREAD_NAME,
+                    strlen (POOL_SCHED_THREAD_NAME)))
+    {
+      (void) __atomic_add_fetch (&(p_pool->off_pool), 1, __ATOMIC_RELAXED);
+    }
+  (void) __atomic_add_fetch (&(p_pool->returned), 1, __ATOMIC_RELAXED);
+  return check_batch_bench_EmptyBufferDone (ap_hdl, &(p_pool->bench), ap_buf);
+}
+
+static OMX_CALLBACKTYPE _check_pool_sched_cbacks = {
+  check_EventHandler,
+  check_pool_sched_EmptyBufferDone,
+  check_FillBufferDone
+};
+
+START_TEST (test_tizonia_pool_scheduler)
+{
+  OMX_HANDLETYPE p_hdl = 0;
+  check_pool_sched_context_t pool;
+  OMX_PARAM_PORTDEFINITIONTYPE port_def;
+  OMX_BUFFERHEADERTYPE *hdrs[BATCH_BENCH_BUFFER_COUNT];
+
+  /* The pool is created with the first component of the process (the test
+     runs in a process of its own) */
+  fail_if (0 != setenv ("TIZONIA_COMPONENT_SCHEDULER", "pool", 1));
+
+  pool.returned = 0;
+  pool.off_pool = 0;
+  fail_if (OMX_ErrorNone != _ctx_init (&pool.bench.ctx));
+  fail_if (OMX_ErrorNone
+           != tiz_queue_init (&pool.bench.p_returned,
+                              BATCH_BENCH_BUFFER_COUNT));
+
+  fail_if (OMX_ErrorNone != OMX_Init ());
+  fail_if (OMX_ErrorNone
+           != OMX_GetHandle (&p_hdl, COMPONENT_NAME, &pool,
+                             &_check_pool_sched_cbacks));
+
+  port_def.nSize = sizeof (OMX_PARAM_PORTDEFINITIONTYPE);
+  port_def.nVersion.nVersion = OMX_VERSION;
+  port_def.nPortIndex = 0;
+  fail_if (OMX_ErrorNone
+           != OMX_GetParameter (p_hdl, OMX_IndexParamPortDefinition,
+                                &port_def));
+  port_def.nBufferCountActual = BATCH_BENCH_BUFFER_COUNT;
+  fail_if (OMX_ErrorNone
+           != OMX_SetParameter (p_hdl, OMX_IndexParamPortDefinition,
+                                &port_def));
+
+  check_batch_bench_transition (&pool.bench, p_hdl, OMX_StateIdle, hdrs,
+                                BATCH_BENCH_BUFFER_COUNT, 0);
+  check_batch_bench_transition (&pool.bench, p_hdl, OMX_StateExecuting, hdrs,
+                                0, 0);
+
+  /* Every buffer comes back, and from one of the pool's workers */
+  (void) check_batch_bench_run (&pool.bench, p_hdl, hdrs,
+                                BATCH_BENCH_BUFFER_COUNT);
+  fail_if (BATCH_BENCH_BUFFER_ROUNDS
+           != __atomic_load_n (&pool.returned, __ATOMIC_RELAXED));
+  fail_if (0 != __atomic_load_n (&pool.off_pool, __ATOMIC_RELAXED));
+
+  check_batch_bench_transition (&pool.bench, p_hdl, OMX_StateIdle, hdrs, 0,
+                                0);
+  check_batch_bench_transition (&pool.bench, p_hdl, OMX_StateLoaded, hdrs,
+                                BATCH_BENCH_BUFFER_COUNT, 0);
+
+  fail_if (OMX_ErrorNone != OMX_FreeHandle (p_hdl));
+  fail_if (OMX_ErrorNone != OMX_Deinit ());
+
+  tiz_queue_destroy (pool.bench.p_returned);
+  _ctx_destroy (&pool.bench.ctx);
+  (void) unsetenv ("TIZONIA_COMPONENT_SCHEDULER");
+}
+END_TEST
+
 Suite *
 tiz_suite (void)
 {
@@ -2061,6 +2771,10 @@ tiz_suite (void)
   /*                   test_tizonia_command_cancellation_loaded_to_idle_with_tunneled_supplied_buffers); */
   tcase_add_test (tc_tizonia,
                   test_tizonia_command_cancellation_loaded_to_idle_no_buffers_port_disabled_unblocks_transition);
+  tcase_add_test (tc_tizonia, test_tizonia_buffer_batch_extension);
+  tcase_add_test (tc_tizonia, test_tizonia_perf_stats_extension);
+  tcase_add_test (tc_tizonia, test_tizonia_mem_stats_extension);
+  tcase_add_test (tc_tizonia, test_tizonia_pool_scheduler);
   /* TEST DISABLED */
   /*   tcase_add_test (tc_tizonia, */
   /*                   test_tizonia_command_cancellation_loaded_to_idle_with_buffers_port_disabled_cant_unblock_transition); */
@@ -2076,6 +2790,23 @@ tiz_suite (void)
   return s;
 }
 
+Suite *
+tiz_bench_suite (void)
+{
+  TCase *tc_bench;
+  Suite *s = suite_create ("libtizonia benchmarks");
+
+  /* benchmarks; these only run when TIZONIA_CHECK_BENCH is set */
+  tc_bench = tcase_create ("bench");
+  tcase_add_unchecked_fixture (tc_bench, setup, teardown);
+  tcase_set_timeout (tc_bench, 0);
+  tcase_add_test (tc_bench, test_tizonia_batched_ticks_benchmark);
+  tcase_add_test (tc_bench, test_tizonia_buffer_batch_benchmark);
+  suite_add_tcase (s, tc_bench);
+
+  return s;
+}
+
 int
 main (void)
 {
@@ -2086,6 +2817,11 @@ main (void)
 
   TIZ_LOG (TIZ_PRIORITY_TRACE, "Tizonia OpenMAX IL - libtizonia unit tests");
 
+  if (check_bench_enabled ())
+    {
+      srunner_add_suite (sr, tiz_bench_suite ());
+    }
+
   srunner_run_all (sr, CK_VERBOSE);
   number_failed = srunner_ntests_failed (sr);
   srunner_free (sr);
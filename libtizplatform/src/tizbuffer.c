@@ -30,10 +30,17 @@
 #include <config.h>
 #endif
 
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
 #include <assert.h>
+#include <stdbool.h>
 #include <stdlib.h>
 #include <string.h>
 #include <limits.h>
+#include <unistd.h>
+#include <sys/mman.h>
 
 #include "tizmem.h"
 #include "tizlog.h"
@@ -52,6 +59,12 @@ struct tiz_buffer
   int filled_len;
   int offset;
   int seek_mode;
+  int init_len;
+  int max_len;
+  /* In TIZ_BUFFER_RING mode, the store is mapped twice in a row, so that the
+     data is always contiguous, wherever it wraps around */
+  bool mirrored;
+  tiz_mem_account_t * p_account;
 };
 
 static long
@@ -61,6 +74,135 @@ abs_of (const long v)
   return (v + mask) ^ mask;
 }
 
+static inline bool
+is_consistent (const tiz_buffer_t * ap_buf)
+{
+  return ap_buf->mirrored ? (ap_buf->offset < ap_buf->alloc_len
+                             && ap_buf->filled_len <= ap_buf->alloc_len)
+                          : ap_buf->alloc_len
+                              >= (ap_buf->offset + ap_buf->filled_len);
+}
+
+static inline size_t
+page_size (void)
+{
+  static size_t page_sz = 0;
+  if (!page_sz)
+    {
+      const long sz = sysconf (_SC_PAGESIZE);
+      page_sz = sz > 0 ? (size_t) sz : 4096;
+    }
+  return page_sz;
+}
+
+static unsigned char *
+map_mirrored_store (const size_t a_nbytes)
+{
+  unsigned char * p_store = NULL;
+#ifdef MFD_CLOEXEC
+  const int fd = memfd_create ("tizbuffer", MFD_CLOEXEC);
+
+  if (fd < 0)
+    {
+      return NULL;
+    }
+
+  if (0 == ftruncate (fd, a_nbytes))
+    {
+      /* Reserve twice the size, then map the same pages on both halves */
+      p_store = mmap (NULL, 2 * a_nbytes, PROT_NONE,
+                      MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+      if (MAP_FAILED == p_store)
+        {
+          p_store = NULL;
+        }
+      else if (MAP_FAILED
+                 == mmap (p_store, a_nbytes, PROT_READ | PROT_WRITE,
+                          MAP_SHARED | MAP_FIXED, fd, 0)
+               || MAP_FAILED
+                    == mmap (p_store + a_nbytes, a_nbytes,
+                             PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED,
+                             fd, 0))
+        {
+          (void) munmap (p_store, 2 * a_nbytes);
+          p_store = NULL;
+        }
+    }
+  (void) close (fd);
+#endif
+  return p_store;
+}
+
+static inline void
+free_store (tiz_buffer_t * ap_buf)
+{
+  assert (ap_buf);
+  if (ap_buf->mirrored)
+    {
+      (void) munmap (ap_buf->p_store, 2 * (size_t) ap_buf->alloc_len);
+      if (ap_buf->p_account)
+        {
+          tiz_mem_account_discharge (ap_buf->p_account, ap_buf->alloc_len);
+        }
+    }
+  else
+    {
+      tiz_mem_free (ap_buf->p_store);
+    }
+  ap_buf->p_store = NULL;
+  ap_buf->mirrored = false;
+  ap_buf->p_account = NULL;
+}
+
+/* Move the data to a new store of a_nbytes (dropping any data behind the
+   position marker, except in seekable mode) */
+static bool
+replace_store (tiz_buffer_t * ap_buf, const size_t a_nbytes,
+               const bool a_mirrored)
+{
+  const int keep = ap_buf->seek_mode == TIZ_BUFFER_SEEKABLE ? ap_buf->offset
+                                                           : 0;
+  tiz_mem_account_t * p_account = NULL;
+  unsigned char * p_store = NULL;
+
+  assert (a_nbytes >= (size_t) (keep + ap_buf->filled_len));
+
+  if (a_mirrored)
+    {
+      p_account = tiz_mem_account_current ();
+      if (p_account && !tiz_mem_account_charge (p_account, a_nbytes))
+        {
+          return false;
+        }
+      if (!(p_store = map_mirrored_store (a_nbytes)) && p_account)
+        {
+          tiz_mem_account_discharge (p_account, a_nbytes);
+        }
+    }
+  else
+    {
+      p_store = tiz_mem_alloc (a_nbytes);
+    }
+
+  if (!p_store)
+    {
+      return false;
+    }
+
+  if (ap_buf->p_store)
+    {
+      memcpy (p_store, ap_buf->p_store + ap_buf->offset - keep,
+              keep + ap_buf->filled_len);
+      free_store (ap_buf);
+    }
+  ap_buf->p_store = p_store;
+  ap_buf->alloc_len = a_nbytes;
+  ap_buf->offset = keep;
+  ap_buf->mirrored = a_mirrored;
+  ap_buf->p_account = p_account;
+  return true;
+}
+
 static inline void *
 alloc_data_store (tiz_buffer_t * ap_buf, const size_t nbytes)
 {
@@ -73,6 +215,7 @@ alloc_data_store (tiz_buffer_t * ap_buf, const size_t nbytes)
       if (ap_buf->p_store)
         {
           ap_buf->alloc_len = nbytes;
+          ap_buf->init_len = nbytes;
           ap_buf->filled_len = 0;
           ap_buf->offset = 0;
           ap_buf->seek_mode = TIZ_BUFFER_NON_SEEKABLE;
@@ -89,8 +232,7 @@ dealloc_data_store (
 {
   if (ap_buf)
     {
-      tiz_mem_free (ap_buf->p_store);
-      ap_buf->p_store = NULL;
+      free_store (ap_buf);
       ap_buf->alloc_len = 0;
       ap_buf->filled_len = 0;
       ap_buf->offset = 0;
@@ -98,6 +240,30 @@ dealloc_data_store (
     }
 }
 
+/* The store size to hold a_need bytes: the current size doubled as needed,
+   up to the maximum capacity */
+static size_t
+grown_size (const tiz_buffer_t * ap_buf, const size_t a_need)
+{
+  size_t len = ap_buf->alloc_len;
+  while (len < a_need)
+    {
+      len *= 2;
+    }
+  if (ap_buf->max_len > 0 && len > (size_t) ap_buf->max_len)
+    {
+      len = MAX ((size_t) ap_buf->max_len, (size_t) ap_buf->alloc_len);
+    }
+  if (ap_buf->mirrored)
+    {
+      /* Whole pages only */
+      const size_t rounded = len & ~(page_size () - 1);
+      len = rounded > (size_t) ap_buf->alloc_len ? rounded
+                                                 : (size_t) ap_buf->alloc_len;
+    }
+  return len;
+}
+
 OMX_ERRORTYPE
 tiz_buffer_init (/*@null@ */ tiz_buffer_ptr_t * app_buf, const size_t a_nbytes)
 {
@@ -150,10 +316,29 @@ tiz_buffer_seek_mode (tiz_buffer_t * ap_buf, const int a_seek_mode)
 {
   int old_val = -1;
   if (a_seek_mode == TIZ_BUFFER_SEEKABLE
-      || a_seek_mode == TIZ_BUFFER_NON_SEEKABLE)
+      || a_seek_mode == TIZ_BUFFER_NON_SEEKABLE
+      || a_seek_mode == TIZ_BUFFER_RING)
     {
       assert (ap_buf);
       old_val = ap_buf->seek_mode;
+      if (a_seek_mode == TIZ_BUFFER_RING && !ap_buf->mirrored)
+        {
+          /* Without a mirrored mapping, this behaves like
+             TIZ_BUFFER_NON_SEEKABLE */
+          const size_t pg = page_size ();
+          ap_buf->seek_mode = TIZ_BUFFER_NON_SEEKABLE;
+          (void) replace_store (
+            ap_buf,
+            (MAX (ap_buf->alloc_len, ap_buf->filled_len) + pg - 1) & ~(pg - 1),
+            true);
+        }
+      else if (a_seek_mode != TIZ_BUFFER_RING && ap_buf->mirrored)
+        {
+          if (!replace_store (ap_buf, ap_buf->alloc_len, false))
+            {
+              return -1;
+            }
+        }
       ap_buf->seek_mode = a_seek_mode;
     }
   return old_val;
@@ -166,37 +351,57 @@ tiz_buffer_push (tiz_buffer_t * ap_buf, const void * ap_data,
   OMX_U32 nbytes_to_copy = 0;
 
   assert (ap_buf);
-  assert (ap_buf->alloc_len >= (ap_buf->offset + ap_buf->filled_len));
+  assert (is_consistent (ap_buf));
 
   if (ap_data && a_nbytes > 0)
     {
       size_t avail = 0;
 
-      if (ap_buf->seek_mode == TIZ_BUFFER_NON_SEEKABLE
-          && ap_buf->offset > 0)
+      if (ap_buf->mirrored)
         {
-          memmove (ap_buf->p_store, (ap_buf->p_store + ap_buf->offset),
-                   ap_buf->filled_len);
-          ap_buf->offset = 0;
+          avail = ap_buf->alloc_len - ap_buf->filled_len;
+        }
+      else
+        {
+          avail = ap_buf->alloc_len - (ap_buf->offset + ap_buf->filled_len);
+          if (ap_buf->seek_mode != TIZ_BUFFER_SEEKABLE && a_nbytes > avail
+              && ap_buf->offset > 0)
+            {
+              /* Only compact when there is no room left at the back */
+              memmove (ap_buf->p_store, (ap_buf->p_store + ap_buf->offset),
+                       ap_buf->filled_len);
+              ap_buf->offset = 0;
+              avail = ap_buf->alloc_len - ap_buf->filled_len;
+            }
         }
-
-      avail = ap_buf->alloc_len - (ap_buf->offset + ap_buf->filled_len);
 
       if (a_nbytes > avail)
         {
           /* need to re-alloc */
-          OMX_U8 * p_new_store = NULL;
-          size_t need = ap_buf->alloc_len * 2;
-          p_new_store = tiz_mem_realloc (ap_buf->p_store, need);
-          if (p_new_store)
+          const size_t need = ap_buf->alloc_len + (a_nbytes - avail);
+          const size_t len = grown_size (ap_buf, need);
+          if (len > (size_t) ap_buf->alloc_len)
             {
-              ap_buf->p_store = p_new_store;
-              ap_buf->alloc_len = need;
-              avail = ap_buf->alloc_len - (ap_buf->offset + ap_buf->filled_len);
+              if (ap_buf->mirrored)
+                {
+                  (void) replace_store (ap_buf, len, true);
+                }
+              else
+                {
+                  OMX_U8 * p_new_store = tiz_mem_realloc (ap_buf->p_store, len);
+                  if (p_new_store)
+                    {
+                      ap_buf->p_store = p_new_store;
+                      ap_buf->alloc_len = len;
+                    }
+                }
+              avail = ap_buf->alloc_len - ap_buf->filled_len
+                      - (ap_buf->mirrored ? 0 : ap_buf->offset);
             }
         }
       nbytes_to_copy = MIN (avail, a_nbytes);
-      memcpy (ap_buf->p_store + ap_buf->offset + ap_buf->filled_len, ap_data, nbytes_to_copy);
+      memcpy (ap_buf->p_store + ap_buf->offset + ap_buf->filled_len, ap_data,
+              nbytes_to_copy);
       ap_buf->filled_len += nbytes_to_copy;
     }
   return nbytes_to_copy;
@@ -206,7 +411,7 @@ int
 tiz_buffer_available (const tiz_buffer_t * ap_buf)
 {
   assert (ap_buf);
-  assert (ap_buf->alloc_len >= (ap_buf->offset + ap_buf->filled_len));
+  assert (is_consistent (ap_buf));
   return ap_buf->filled_len;
 }
 
@@ -214,15 +419,22 @@ int
 tiz_buffer_offset (const tiz_buffer_t * ap_buf)
 {
   assert (ap_buf);
-  assert (ap_buf->alloc_len >= (ap_buf->offset + ap_buf->filled_len));
+  assert (is_consistent (ap_buf));
   return ap_buf->offset;
 }
 
+int
+tiz_buffer_capacity (const tiz_buffer_t * ap_buf)
+{
+  assert (ap_buf);
+  return ap_buf->alloc_len;
+}
+
 void *
 tiz_buffer_get (const tiz_buffer_t * ap_buf)
 {
   assert (ap_buf);
-  assert (ap_buf->alloc_len >= (ap_buf->offset + ap_buf->filled_len));
+  assert (is_consistent (ap_buf));
   return (ap_buf->p_store + ap_buf->offset);
 }
 
@@ -236,6 +448,17 @@ tiz_buffer_advance (tiz_buffer_t * ap_buf, const int nbytes)
       min_nbytes = MIN (nbytes, tiz_buffer_available (ap_buf));
       ap_buf->offset += min_nbytes;
       ap_buf->filled_len -= min_nbytes;
+      if (ap_buf->mirrored)
+        {
+          if (0 == ap_buf->filled_len)
+            {
+              ap_buf->offset = 0;
+            }
+          else if (ap_buf->offset >= ap_buf->alloc_len)
+            {
+              ap_buf->offset -= ap_buf->alloc_len;
+            }
+        }
     }
   return min_nbytes;
 }
@@ -244,10 +467,22 @@ int
 tiz_buffer_seek (tiz_buffer_t * ap_buf, const long offset, const int whence)
 {
   int rc = -1;
+  int total = 0;
   assert (ap_buf);
-  assert (ap_buf->alloc_len >= (ap_buf->offset + ap_buf->filled_len));
+  assert (is_consistent (ap_buf));
 
-  int total = ap_buf->offset + ap_buf->filled_len;
+  if (ap_buf->seek_mode == TIZ_BUFFER_RING)
+    {
+      /* The data behind the position marker is gone */
+      if (whence == TIZ_BUFFER_SEEK_CUR && offset >= 0)
+        {
+          (void) tiz_buffer_advance (ap_buf, MIN (offset, INT_MAX));
+          rc = 0;
+        }
+      return rc;
+    }
+
+  total = ap_buf->offset + ap_buf->filled_len;
   if (whence == TIZ_BUFFER_SEEK_SET)
     {
       ap_buf->offset = MIN (offset, total);
@@ -291,3 +526,35 @@ tiz_buffer_clear (tiz_buffer_t * ap_buf)
       ap_buf->filled_len = 0;
     }
 }
+
+void
+tiz_buffer_set_max_capacity (tiz_buffer_t * ap_buf, const size_t a_nbytes)
+{
+  assert (ap_buf);
+  ap_buf->max_len = MIN (a_nbytes, INT_MAX);
+}
+
+int
+tiz_buffer_shrink_to_fit (tiz_buffer_t * ap_buf)
+{
+  size_t len = 0;
+
+  assert (ap_buf);
+  assert (is_consistent (ap_buf));
+
+  len = (ap_buf->seek_mode == TIZ_BUFFER_SEEKABLE ? ap_buf->offset : 0)
+        + ap_buf->filled_len;
+  len = MAX (len, (size_t) ap_buf->init_len);
+  if (ap_buf->mirrored)
+    {
+      const size_t pg = page_size ();
+      len = (len + pg - 1) & ~(pg - 1);
+    }
+
+  if (len < (size_t) ap_buf->alloc_len
+      && !replace_store (ap_buf, len, ap_buf->mirrored))
+    {
+      return -1;
+    }
+  return 0;
+}
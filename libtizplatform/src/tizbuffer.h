@@ -52,6 +52,12 @@ extern "C" {
 #define TIZ_BUFFER_SEEKABLE \
   1 /** Data pushed on to the buffer is only discarded explicitely when
         'tiz_clear_buffer' is used. */
+#define TIZ_BUFFER_RING \
+  2 /** Like TIZ_BUFFER_NON_SEEKABLE, but the data store is a circular buffer
+        mapped twice in a row, so that the data is never moved around, and
+        yet always contiguous. Only forward seeks (TIZ_BUFFER_SEEK_CUR) are
+        possible. Where this mapping is not available, this behaves like
+        TIZ_BUFFER_NON_SEEKABLE. */
 
 /* The possibilities for the third argument to 'tiz_buffer_seek'.
    These values should not be changed.  */
@@ -142,6 +148,16 @@ tiz_buffer_available (const tiz_buffer_t * ap_buf);
 int
 tiz_buffer_offset (const tiz_buffer_t * ap_buf);
 
+/**
+ * @brief Retrieve the size of the data store.
+ *
+ * @ingroup tizbuffer
+ * @param ap_buf The dynamic buffer handle.
+ * @return The number of bytes the buffer can hold without growing.
+ */
+int
+tiz_buffer_capacity (const tiz_buffer_t * ap_buf);
+
 /**
  * @brief Retrieve the current position in the buffer where data can be read
  * from.
@@ -190,6 +206,34 @@ int
 tiz_buffer_seek (tiz_buffer_t * ap_buf, const long a_offset,
                  const int a_whence);
 
+/**
+ * @brief Limit the size of the data store.
+ *
+ * The data store grows (doubling its size) when data is pushed that does not
+ * fit in it, but never beyond this limit; tiz_buffer_push then stores only
+ * what fits.
+ *
+ * @ingroup tizbuffer
+ * @param ap_buf The dynamic buffer handle.
+ * @param a_nbytes The maximum size of the data store, or 0 (the default) for
+ * no limit. A store that is already larger does not shrink.
+ */
+void
+tiz_buffer_set_max_capacity (tiz_buffer_t * ap_buf, const size_t a_nbytes);
+
+/**
+ * @brief Shrink the data store to the data it holds.
+ *
+ * The store is never made smaller than its size at tiz_buffer_init.
+ *
+ * @ingroup tizbuffer
+ * @param ap_buf The dynamic buffer handle.
+ * @return 0 on success, -1 if a new store could not be allocated (the buffer
+ * is then left unchanged).
+ */
+int
+tiz_buffer_shrink_to_fit (tiz_buffer_t * ap_buf);
+
 #ifdef __cplusplus
 }
 #endif
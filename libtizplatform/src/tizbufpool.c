@@ -0,0 +1,665 @@
+/**
+ * Copyright (C) 2011-2020 Aratelia Limited - Juan A. Rubio and contributors
+ *
+ * This file is part of Tizonia
+ *
+ * Tizonia is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Tizonia is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Tizonia.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/**
+ * @file   tizbufpool.c
+ * @author Juan A. Rubio <juan.rubio@aratelia.com>
+ *
+ * @brief  Tizonia Platform - Buffer pool
+ *
+ *
+ */
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <assert.h>
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+
+#include "tizplatform.h"
+
+#ifdef TIZ_LOG_CATEGORY_NAME
+#undef TIZ_LOG_CATEGORY_NAME
+#define TIZ_LOG_CATEGORY_NAME "tiz.platform.bufpool"
+#endif
+
+#define BUFPOOL_PAGE_SZ 4096
+#define BUFPOOL_HUGE_PAGE_SZ (2 * 1024 * 1024)
+/* Smaller buffers come from the C library, larger ones are mapped */
+#define BUFPOOL_MAP_THRESHOLD (128 * 1024)
+/* With huge pages, buffers within these sizes are carved out of huge page
+   blocks ('slabs') */
+#define BUFPOOL_MIN_CARVED_SZ BUFPOOL_PAGE_SZ
+#define BUFPOOL_MAX_CARVED_SZ (BUFPOOL_HUGE_PAGE_SZ / 2)
+#define BUFPOOL_DEFAULT_CACHE_MB 8
+
+#define BUFPOOL_ROUND_UP(sz, align) (((sz) + (align) -1) & ~((size_t) (align) -1))
+
+typedef struct bufpool_slab slab_t;
+typedef struct bufpool_block block_t;
+typedef struct bufpool_bin bin_t;
+
+struct bufpool_block
+{
+  uint8_t * p_data;
+  size_t size;     /* the size class */
+  size_t map_sz;   /* mapped bytes, if the block was mapped on its own */
+  bool huge;       /* idem, and with huge pages */
+  slab_t * p_slab; /* if the block was carved out of a slab */
+  tiz_mem_account_t * p_account; /* while the block is in use */
+  bool dirty;                    /* it has been used */
+  block_t * p_next_free;
+};
+
+struct bufpool_slab
+{
+  uint8_t * p_base;
+  size_t size;
+  uint32_t nblocks;
+  uint32_t nfree;
+  slab_t * p_next;
+  block_t blocks[];
+};
+
+struct bufpool_bin
+{
+  size_t size;
+  block_t * p_free;
+  bin_t * p_next;
+};
+
+typedef struct bufpool bufpool_t;
+struct bufpool
+{
+  pthread_mutex_t mutex;
+  tiz_hmap_t * p_blocks; /* all the blocks, by address */
+  bin_t * p_bins;
+  slab_t * p_slabs;
+  tiz_bufpool_hugepages_t hugepages;
+  size_t cache_max;
+  bool hugetlb_failed;
+  tiz_bufpool_info_t info;
+};
+
+static pthread_once_t g_bufpool_once = PTHREAD_ONCE_INIT;
+static bufpool_t g_bufpool = {PTHREAD_MUTEX_INITIALIZER};
+
+static tiz_bufpool_hugepages_t
+read_hugepages (void)
+{
+  const char * p_value
+    = tiz_rcfile_get_value ("ilcore", "buffer-pool-hugepages");
+
+  if (p_value && 0 == strncmp (p_value, "transparent", 12))
+    {
+      return ETIZBufpoolHugepagesTransparent;
+    }
+  if (p_value && 0 == strncmp (p_value, "explicit", 9))
+    {
+      return ETIZBufpoolHugepagesExplicit;
+    }
+  return ETIZBufpoolHugepagesNone;
+}
+
+static size_t
+read_cache_max (void)
+{
+  const char * p_value
+    = tiz_rcfile_get_value ("ilcore", "buffer-pool-cache-mb");
+  const long mb = p_value ? strtol (p_value, NULL, 10)
+                          : BUFPOOL_DEFAULT_CACHE_MB;
+  return mb > 0 ? (size_t) mb * 1024 * 1024 : 0;
+}
+
+static void
+init_bufpool (void)
+{
+  bufpool_t * p_pool = &g_bufpool;
+  /* The pool's own bookkeeping is nobody's */
+  tiz_mem_account_t * p_prev = tiz_mem_account_swap (NULL);
+
+  p_pool->hugepages = read_hugepages ();
+  p_pool->cache_max = read_cache_max ();
+  if (OMX_ErrorNone != tiz_hmap_init (&(p_pool->p_blocks), 64, NULL))
+    {
+      p_pool->p_blocks = NULL;
+    }
+
+  (void) tiz_mem_account_swap (p_prev);
+}
+
+static inline bufpool_t *
+get_bufpool (void)
+{
+  (void) pthread_once (&g_bufpool_once, init_bufpool);
+  return g_bufpool.p_blocks ? &g_bufpool : NULL;
+}
+
+static inline bool
+is_carved (const bufpool_t * ap_pool, const size_t a_class_sz)
+{
+  return ETIZBufpoolHugepagesNone != ap_pool->hugepages
+         && a_class_sz >= BUFPOOL_MIN_CARVED_SZ
+         && a_class_sz <= BUFPOOL_MAX_CARVED_SZ;
+}
+
+static size_t
+get_class_size (const bufpool_t * ap_pool, const size_t a_size)
+{
+  const size_t size = a_size ? a_size : 1;
+
+  if (ETIZBufpoolHugepagesNone != ap_pool->hugepages
+      && size > BUFPOOL_MAX_CARVED_SZ)
+    {
+      return BUFPOOL_ROUND_UP (size, BUFPOOL_HUGE_PAGE_SZ);
+    }
+  if (size >= BUFPOOL_MAP_THRESHOLD
+      || (ETIZBufpoolHugepagesNone != ap_pool->hugepages
+          && size >= BUFPOOL_MIN_CARVED_SZ))
+    {
+      return BUFPOOL_ROUND_UP (size, BUFPOOL_PAGE_SZ);
+    }
+  return BUFPOOL_ROUND_UP (size, TIZ_BUFPOOL_ALIGN);
+}
+
+static bin_t *
+find_bin (bufpool_t * ap_pool, const size_t a_class_sz, const bool a_create)
+{
+  bin_t * p_bin = NULL;
+
+  for (p_bin = ap_pool->p_bins; p_bin; p_bin = p_bin->p_next)
+    {
+      if (p_bin->size == a_class_sz)
+        {
+          return p_bin;
+        }
+    }
+
+  if (a_create && (p_bin = tiz_mem_calloc (1, sizeof (bin_t))))
+    {
+      p_bin->size = a_class_sz;
+      p_bin->p_next = ap_pool->p_bins;
+      ap_pool->p_bins = p_bin;
+    }
+  return p_bin;
+}
+
+/* Map a_size bytes, with huge pages if requested; a_size is then a multiple
+   of the huge page size */
+static uint8_t *
+map_memory (bufpool_t * ap_pool, const size_t a_size, const bool a_huge)
+{
+  uint8_t * p_map = NULL;
+  uint8_t * p_aligned = NULL;
+
+#ifdef MAP_HUGETLB
+  if (a_huge && ETIZBufpoolHugepagesExplicit == ap_pool->hugepages
+      && !ap_pool->hugetlb_failed)
+    {
+      p_map = mmap (NULL, a_size, PROT_READ | PROT_WRITE,
+                    MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+      if (MAP_FAILED != p_map)
+        {
+          return p_map;
+        }
+      ap_pool->hugetlb_failed = true;
+      TIZ_LOG (TIZ_PRIORITY_NOTICE,
+               "No huge pages available; using transparent huge pages");
+    }
+#endif
+
+  if (!a_huge)
+    {
+      p_map = mmap (NULL, a_size, PROT_READ | PROT_WRITE,
+                    MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+      return MAP_FAILED != p_map ? p_map : NULL;
+    }
+
+  /* Align the block on a huge page boundary, so that the kernel may back it
+     with huge pages */
+  p_map = mmap (NULL, a_size + BUFPOOL_HUGE_PAGE_SZ, PROT_READ | PROT_WRITE,
+                MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (MAP_FAILED == p_map)
+    {
+      return NULL;
+    }
+  p_aligned = (uint8_t *) BUFPOOL_ROUND_UP ((uintptr_t) p_map,
+                                            BUFPOOL_HUGE_PAGE_SZ);
+  if (p_aligned > p_map)
+    {
+      (void) munmap (p_map, p_aligned - p_map);
+    }
+  (void) munmap (p_aligned + a_size,
+                 (p_map + a_size + BUFPOOL_HUGE_PAGE_SZ) - (p_aligned + a_size));
+#ifdef MADV_HUGEPAGE
+  (void) madvise (p_aligned, a_size, MADV_HUGEPAGE);
+#endif
+  return p_aligned;
+}
+
+static void
+release_slab (bufpool_t * ap_pool, slab_t * ap_slab)
+{
+  bin_t * p_bin = find_bin (ap_pool, ap_slab->blocks[0].size, false);
+  block_t ** pp_block = NULL;
+  slab_t ** pp_slab = NULL;
+  uint32_t i = 0;
+
+  assert (p_bin);
+  assert (ap_slab->nfree == ap_slab->nblocks);
+
+  /* All its blocks are in the bin */
+  for (pp_block = &(p_bin->p_free); *pp_block;)
+    {
+      if ((*pp_block)->p_slab == ap_slab)
+        {
+          *pp_block = (*pp_block)->p_next_free;
+        }
+      else
+        {
+          pp_block = &((*pp_block)->p_next_free);
+        }
+    }
+
+  for (i = 0; i < ap_slab->nblocks; ++i)
+    {
+      tiz_hmap_erase (ap_pool->p_blocks,
+                      (uintptr_t) ap_slab->blocks[i].p_data);
+    }
+  ap_pool->info.cached -= ap_slab->nblocks;
+  ap_pool->info.cached_bytes -= ap_slab->nblocks * ap_slab->blocks[0].size;
+  ap_pool->info.huge_bytes -= ap_slab->size;
+
+  for (pp_slab = &(ap_pool->p_slabs); *pp_slab != ap_slab;
+       pp_slab = &((*pp_slab)->p_next))
+    {
+    }
+  *pp_slab = ap_slab->p_next;
+
+  (void) munmap (ap_slab->p_base, ap_slab->size);
+  tiz_mem_free (ap_slab);
+}
+
+static void
+release_block (bufpool_t * ap_pool, block_t * ap_block)
+{
+  assert (!ap_block->p_slab);
+
+  tiz_hmap_erase (ap_pool->p_blocks, (uintptr_t) ap_block->p_data);
+  if (ap_block->map_sz)
+    {
+      (void) munmap (ap_block->p_data, ap_block->map_sz);
+      if (ap_block->huge)
+        {
+          ap_pool->info.huge_bytes -= ap_block->map_sz;
+        }
+    }
+  else
+    {
+      free (ap_block->p_data);
+    }
+  tiz_mem_free (ap_block);
+}
+
+/* Release the slabs none of whose blocks are in use, while the cache is
+   over its limit (or all of them) */
+static void
+release_free_slabs (bufpool_t * ap_pool, const bool a_all)
+{
+  slab_t * p_slab = ap_pool->p_slabs;
+
+  while (p_slab && (a_all || ap_pool->info.cached_bytes > ap_pool->cache_max))
+    {
+      slab_t * p_next = p_slab->p_next;
+      if (p_slab->nfree == p_slab->nblocks)
+        {
+          release_slab (ap_pool, p_slab);
+        }
+      p_slab = p_next;
+    }
+}
+
+/* Carve a new slab into blocks, keep all but one in the bin, and return
+   that one */
+static block_t *
+new_slab_block (bufpool_t * ap_pool, bin_t * ap_bin)
+{
+  const uint32_t nblocks = BUFPOOL_HUGE_PAGE_SZ / ap_bin->size;
+  slab_t * p_slab = NULL;
+  uint32_t i = 0;
+
+  if (!(p_slab = tiz_mem_calloc (1, sizeof (slab_t)
+                                      + nblocks * sizeof (block_t))))
+    {
+      return NULL;
+    }
+
+  if (!(p_slab->p_base
+        = map_memory (ap_pool, BUFPOOL_HUGE_PAGE_SZ, true)))
+    {
+      tiz_mem_free (p_slab);
+      return NULL;
+    }
+
+  p_slab->size = BUFPOOL_HUGE_PAGE_SZ;
+  p_slab->nblocks = nblocks;
+  for (i = 0; i < nblocks; ++i)
+    {
+      block_t * p_block = &(p_slab->blocks[i]);
+      p_block->p_data = p_slab->p_base + i * ap_bin->size;
+      p_block->size = ap_bin->size;
+      p_block->p_slab = p_slab;
+      if (OMX_ErrorNone
+          != tiz_hmap_insert (ap_pool->p_blocks, (uintptr_t) p_block->p_data,
+                              p_block))
+        {
+          while (i-- > 0)
+            {
+              tiz_hmap_erase (ap_pool->p_blocks,
+                              (uintptr_t) p_slab->blocks[i].p_data);
+            }
+          (void) munmap (p_slab->p_base, p_slab->size);
+          tiz_mem_free (p_slab);
+          return NULL;
+        }
+    }
+
+  p_slab->p_next = ap_pool->p_slabs;
+  ap_pool->p_slabs = p_slab;
+  ap_pool->info.huge_bytes += p_slab->size;
+
+  for (i = 1; i < nblocks; ++i)
+    {
+      p_slab->blocks[i].p_next_free = ap_bin->p_free;
+      ap_bin->p_free = &(p_slab->blocks[i]);
+    }
+  p_slab->nfree = nblocks - 1;
+  ap_pool->info.cached += nblocks - 1;
+  ap_pool->info.cached_bytes += (nblocks - 1) * ap_bin->size;
+
+  return &(p_slab->blocks[0]);
+}
+
+static block_t *
+new_block (bufpool_t * ap_pool, bin_t * ap_bin)
+{
+  const size_t size = ap_bin->size;
+  block_t * p_block = NULL;
+
+  if (is_carved (ap_pool, size))
+    {
+      return new_slab_block (ap_pool, ap_bin);
+    }
+
+  if (!(p_block = tiz_mem_calloc (1, sizeof (block_t))))
+    {
+      return NULL;
+    }
+
+  p_block->size = size;
+  if (size >= BUFPOOL_MAP_THRESHOLD)
+    {
+      p_block->huge = ETIZBufpoolHugepagesNone != ap_pool->hugepages;
+      p_block->map_sz = size;
+      p_block->p_data = map_memory (ap_pool, size, p_block->huge);
+    }
+  else if (0 == posix_memalign ((void **) &(p_block->p_data),
+                                TIZ_BUFPOOL_ALIGN, size))
+    {
+      (void) memset (p_block->p_data, 0, size);
+    }
+
+  if (!p_block->p_data
+      || OMX_ErrorNone
+           != tiz_hmap_insert (ap_pool->p_blocks, (uintptr_t) p_block->p_data,
+                               p_block))
+    {
+      if (p_block->p_data)
+        {
+          p_block->map_sz ? (void) munmap (p_block->p_data, p_block->map_sz)
+                          : free (p_block->p_data);
+        }
+      tiz_mem_free (p_block);
+      return NULL;
+    }
+
+  if (p_block->huge)
+    {
+      ap_pool->info.huge_bytes += p_block->map_sz;
+    }
+  return p_block;
+}
+
+OMX_ERRORTYPE
+tiz_bufpool_configure (const tiz_bufpool_hugepages_t a_hugepages,
+                       const size_t a_cache_max)
+{
+  bufpool_t * p_pool = get_bufpool ();
+
+  tiz_check_null_ret_oom (p_pool);
+  if (a_hugepages >= ETIZBufpoolHugepagesMax)
+    {
+      return OMX_ErrorBadParameter;
+    }
+
+  (void) pthread_mutex_lock (&(p_pool->mutex));
+  p_pool->hugepages = a_hugepages;
+  p_pool->cache_max = a_cache_max;
+  p_pool->hugetlb_failed = false;
+  (void) pthread_mutex_unlock (&(p_pool->mutex));
+
+  return OMX_ErrorNone;
+}
+
+/*@null@ */ void *
+tiz_bufpool_alloc (const size_t a_size)
+{
+  bufpool_t * p_pool = get_bufpool ();
+  tiz_mem_account_t * p_account = tiz_mem_account_current ();
+  tiz_mem_account_t * p_prev = NULL;
+  block_t * p_block = NULL;
+  bin_t * p_bin = NULL;
+  size_t class_sz = 0;
+  bool charged = false;
+
+  if (!p_pool)
+    {
+      return NULL;
+    }
+
+  p_prev = tiz_mem_account_swap (NULL);
+  (void) pthread_mutex_lock (&(p_pool->mutex));
+
+  class_sz = get_class_size (p_pool, a_size);
+  charged = p_account && tiz_mem_account_charge (p_account, class_sz);
+  if ((!p_account || charged)
+      && (p_bin = find_bin (p_pool, class_sz, true)))
+    {
+      if ((p_block = p_bin->p_free))
+        {
+          p_bin->p_free = p_block->p_next_free;
+          p_pool->info.cached--;
+          p_pool->info.cached_bytes -= class_sz;
+          p_pool->info.hits++;
+          if (p_block->p_slab)
+            {
+              p_block->p_slab->nfree--;
+            }
+        }
+      else if ((p_block = new_block (p_pool, p_bin)))
+        {
+          p_pool->info.misses++;
+        }
+    }
+
+  if (p_block)
+    {
+      p_block->p_account = p_account;
+      p_block->p_next_free = NULL;
+      p_pool->info.buffers++;
+      p_pool->info.bytes += class_sz;
+    }
+  else if (charged)
+    {
+      /* The charge went through, but not the allocation */
+      tiz_mem_account_discharge (p_account, class_sz);
+    }
+
+  (void) pthread_mutex_unlock (&(p_pool->mutex));
+  (void) tiz_mem_account_swap (p_prev);
+
+  if (!p_block)
+    {
+      return NULL;
+    }
+
+  if (p_block->dirty)
+    {
+      (void) memset (p_block->p_data, 0, a_size);
+      p_block->dirty = false;
+    }
+  return p_block->p_data;
+}
+
+void
+tiz_bufpool_free (/*@null@ */ void * ap_buf)
+{
+  bufpool_t * p_pool = get_bufpool ();
+  tiz_mem_account_t * p_account = NULL;
+  tiz_mem_account_t * p_prev = NULL;
+  block_t * p_block = NULL;
+  bin_t * p_bin = NULL;
+  size_t size = 0;
+
+  if (!ap_buf || !p_pool)
+    {
+      return;
+    }
+
+  p_prev = tiz_mem_account_swap (NULL);
+  (void) pthread_mutex_lock (&(p_pool->mutex));
+
+  p_block = tiz_hmap_find (p_pool->p_blocks, (uintptr_t) ap_buf);
+  assert (p_block);
+  assert (!p_block->dirty);
+
+  if (p_block)
+    {
+      size = p_block->size;
+      p_account = p_block->p_account;
+      p_block->p_account = NULL;
+      p_block->dirty = true;
+      p_pool->info.buffers--;
+      p_pool->info.bytes -= size;
+
+      /* Slab blocks can only go back to the system with their whole slab */
+      if ((p_block->p_slab
+           || p_pool->info.cached_bytes + size <= p_pool->cache_max)
+          && (p_bin = find_bin (p_pool, size, false)))
+        {
+          p_block->p_next_free = p_bin->p_free;
+          p_bin->p_free = p_block;
+          p_pool->info.cached++;
+          p_pool->info.cached_bytes += size;
+          if (p_block->p_slab)
+            {
+              p_block->p_slab->nfree++;
+              release_free_slabs (p_pool, false);
+            }
+        }
+      else
+        {
+          release_block (p_pool, p_block);
+        }
+    }
+  else
+    {
+      TIZ_LOG (TIZ_PRIORITY_ERROR, "Unknown buffer [%p]", ap_buf);
+    }
+
+  (void) pthread_mutex_unlock (&(p_pool->mutex));
+  (void) tiz_mem_account_swap (p_prev);
+
+  if (p_account)
+    {
+      tiz_mem_account_discharge (p_account, size);
+    }
+}
+
+void
+tiz_bufpool_trim (void)
+{
+  bufpool_t * p_pool = get_bufpool ();
+  tiz_mem_account_t * p_prev = NULL;
+  bin_t * p_bin = NULL;
+
+  if (!p_pool)
+    {
+      return;
+    }
+
+  p_prev = tiz_mem_account_swap (NULL);
+  (void) pthread_mutex_lock (&(p_pool->mutex));
+
+  for (p_bin = p_pool->p_bins; p_bin; p_bin = p_bin->p_next)
+    {
+      block_t ** pp_block = &(p_bin->p_free);
+      while (*pp_block)
+        {
+          block_t * p_block = *pp_block;
+          if (p_block->p_slab)
+            {
+              pp_block = &(p_block->p_next_free);
+            }
+          else
+            {
+              *pp_block = p_block->p_next_free;
+              p_pool->info.cached--;
+              p_pool->info.cached_bytes -= p_block->size;
+              release_block (p_pool, p_block);
+            }
+        }
+    }
+  release_free_slabs (p_pool, true);
+
+  (void) pthread_mutex_unlock (&(p_pool->mutex));
+  (void) tiz_mem_account_swap (p_prev);
+}
+
+void
+tiz_bufpool_info (tiz_bufpool_info_t * ap_info)
+{
+  bufpool_t * p_pool = get_bufpool ();
+
+  assert (ap_info);
+
+  (void) memset (ap_info, 0, sizeof (tiz_bufpool_info_t));
+  if (p_pool)
+    {
+      (void) pthread_mutex_lock (&(p_pool->mutex));
+      *ap_info = p_pool->info;
+      (void) pthread_mutex_unlock (&(p_pool->mutex));
+    }
+}
@@ -0,0 +1,114 @@
+/**
+ * Copyright (C) 2011-2020 Aratelia Limited - Juan A. Rubio and contributors
+ *
+ * This file is part of Tizonia
+ *
+ * Tizonia is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Tizonia is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Tizonia.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/**
+ * @file   tizbufpool.h
+ * @author Juan A. Rubio <juan.rubio@aratelia.com>
+ *
+ * @brief  Tizonia Platform - Buffer pool
+ *
+ *
+ */
+
+#ifndef TIZBUFPOOL_H
+#define TIZBUFPOOL_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <OMX_Types.h>
+#include <OMX_Core.h>
+
+/* A process-wide pool of large, cache-line aligned buffers (e.g. the
+   components' port buffers). Released buffers are kept, up to some total
+   size, and handed out again to requests of the same size, so that the
+   ports' buffers survive their reconfigurations without going back to the
+   system. The pool is thread-safe. Buffers are charged to the calling
+   thread's memory account (see tizmem.h), like memory from tiz_mem_alloc.
+
+   It is configured in the [ilcore] section of the rc file:
+   - buffer-pool-cache-mb: the most memory (in MiB) kept in released buffers
+     (8 by default, enough for the buffers of a typical audio graph; 0
+     disables the reuse of buffers).
+   - buffer-pool-hugepages: 'none' (default), 'transparent' or 'explicit'.
+     With huge pages, buffers of up to 1 MiB are carved out of 2 MiB blocks
+     of memory of their own size, which the kernel may back with a
+     transparent huge page, or which are mapped from the huge page pool
+     (hugetlbfs; this falls back to transparent huge pages if the pool is
+     empty). Larger buffers are rounded up to a multiple of 2 MiB. */
+
+#define TIZ_BUFPOOL_ALIGN 64
+
+typedef enum tiz_bufpool_hugepages tiz_bufpool_hugepages_t;
+enum tiz_bufpool_hugepages
+{
+  ETIZBufpoolHugepagesNone = 0,
+  ETIZBufpoolHugepagesTransparent,
+  ETIZBufpoolHugepagesExplicit,
+  ETIZBufpoolHugepagesMax
+};
+
+/* Override the rc file's settings. This only affects the memory obtained
+   from the system from now on. */
+OMX_ERRORTYPE
+tiz_bufpool_configure (const tiz_bufpool_hugepages_t a_hugepages,
+                       const size_t a_cache_max);
+
+/* A buffer of at least a_size bytes, aligned on TIZ_BUFPOOL_ALIGN, and
+   zero-filled */
+/*@null@ */ void *
+tiz_bufpool_alloc (const size_t a_size);
+
+/* ap_buf must come from tiz_bufpool_alloc (or be NULL) */
+void
+tiz_bufpool_free (/*@null@ */ void * ap_buf);
+
+/* Give the memory of the buffers that are not in use back to the system */
+void
+tiz_bufpool_trim (void);
+
+typedef struct tiz_bufpool_info tiz_bufpool_info_t;
+struct tiz_bufpool_info
+{
+  /* Buffers in use, and their size */
+  uint32_t buffers;
+  size_t bytes;
+  /* Buffers released and kept for reuse, and their size */
+  uint32_t cached;
+  size_t cached_bytes;
+  /* Memory obtained from the system in huge page blocks */
+  size_t huge_bytes;
+  /* Allocations served from the cache, and from the system */
+  uint64_t hits;
+  uint64_t misses;
+};
+
+void
+tiz_bufpool_info (tiz_bufpool_info_t * ap_info);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TIZBUFPOOL_H */
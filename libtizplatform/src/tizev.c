@@ -23,6 +23,51 @@
  *
  * @brief Tizonia Platform - Event loop, async io and timers
  *
+ * The watchers are served by one or more event loops (the 'shards'), each
+ * one running on its own thread. The number of shards is read from the
+ * 'event-loops' key in the rc file (default: 1). A watcher is assigned to a
+ * shard when it is initialised, based on its owner (the ap_arg0 argument,
+ * usually the component handle): either the shard the owner has been bound
+ * to with tiz_event_loop_bind, or a hash of the owner otherwise. All the
+ * watchers of a given owner are therefore served by the same thread.
+ *
+ * Start, stop and destroy requests are queued to the watcher's shard, which
+ * is then woken up. Requests issued from the shard's own thread (i.e. from
+ * inside a watcher callback) run directly, unless there are requests queued
+ * already, so that their order is preserved.
+ *
+ * Other threads don't take the shard's mutex for this: each one writes its
+ * requests to a ring of its own (one per thread and shard), and only the
+ * first request since the shard's last wakeup sends it an async
+ * notification (an eventfd write). The shard moves the contents of all the
+ * rings into its priority queue in one go, under its mutex. A ring that is
+ * full is drained by its producer instead, with the mutex held. Whenever a
+ * drain finds a destroy request, the rings are swept once more before the
+ * queue is processed, so that any request issued before the destroy (from
+ * whatever thread) is purged with it rather than left behind.
+ *
+ * Each watcher also records the state last requested through the API. A
+ * start on a watcher that is already started, or a stop on one that is
+ * already stopped, doesn't reach the shard at all; and the shard ignores the
+ * start requests that have been overtaken by a later stop.
+ *
+ * Timers that have been given some slack are kept in the shard's timer wheel
+ * instead, which a single libev timer (the 'wheel watcher') drives. These
+ * timers are started and stopped directly, under the shard's mutex; the
+ * shard is only woken up when the wheel watcher needs to be re-armed
+ * earlier. Their destruction is still queued, so that it never races with
+ * their callback.
+ *
+ * Async io requests (tiz_event_aio_*) are served by the shard too. When
+ * built with liburing, each shard owns an io_uring instance: requests are
+ * queued to the ring under the shard's mutex and submitted right away,
+ * except those issued while the shard is reaping completions, which are
+ * submitted together once it is done. The ring's descriptor is watched like
+ * any other, so completions wake the shard up. Without liburing (or if the
+ * ring can't be set up), requests are queued to the shard, whose thread
+ * performs them, waiting on an io watcher if the descriptor is not ready
+ * yet. Either way, a request is only released from the shard's thread, so
+ * that it never races with its callback.
  *
  */
 
@@ -34,7 +79,15 @@
 #include <stdlib.h>
 #include <string.h>
 #include <assert.h>
+#include <errno.h>
 #include <pthread.h>
+#include <unistd.h>
+#include <time.h>
+#include <sys/socket.h>
+
+#ifdef HAVE_LIBURING
+#include <liburing.h>
+#endif
 
 #include "tizplatform.h"
 #include "tizplatform_internal.h"
@@ -57,6 +110,9 @@
 #define EV_PREPARE_ENABLE 0
 #define EV_FORK_ENABLE 0
 #define EV_VERIFY 1
+#ifdef __linux__
+#define EV_USE_EVENTFD 1
+#endif
 #include "ev/ev.c"
 #endif
 
@@ -66,10 +122,26 @@
 #endif
 
 #define TIZ_EVENT_LOOP_THREAD_NAME "evloop"
+#define TIZ_EVENT_LOOP_MAX_SHARDS 64
+#define TIZ_EVENT_WHEEL_TICK_NS 1000000
+#define TIZ_EVENT_URING_ENTRIES 256
+#define TIZ_EVENT_URING_DRAIN_TRIES 1000 /* of 1 ms each */
+#define TIZ_EVENT_RING_SIZE 256 /* requests; must be a power of two */
+#define TIZ_EVENT_DEQUEUE_BATCH 16 /* requests removed per queue walk */
+
+typedef struct tiz_event_loop tiz_event_loop_t;
+
+typedef struct tiz_event_request_state tiz_event_request_state_t;
+struct tiz_event_request_state
+{
+  int requested; /* 1 if the last request was a start, 0 if a stop */
+  int npending;  /* requests not processed yet, in the rings or the queue */
+};
 
 struct tiz_event_io
 {
   ev_io io;
+  tiz_event_loop_t * p_lp;
   tiz_event_io_cb_f pf_cback;
   void * p_arg0;
   void * p_arg1;
@@ -77,29 +149,73 @@ struct tiz_event_io
   uint32_t id;
   int fd;
   bool started;
+  tiz_event_request_state_t req;
 };
 
 struct tiz_event_timer
 {
   ev_timer timer;
+  tiz_event_loop_t * p_lp;
   tiz_event_timer_cb_f pf_cback;
   void * p_arg0;
   void * p_arg1;
   bool once;
   uint32_t id;
   bool started;
+  tiz_event_request_state_t req;
+  /* Only used by timers with slack, which live in the loop's wheel */
+  tiz_twheel_timer_t * p_wheel_timer;
+  OMX_U64 slack_ns;
+  OMX_U64 after_ns;
+  OMX_U64 repeat_ns;
+  OMX_U64 due_ns;
+  tiz_event_timer_t * p_next_fired;
+  bool fired;
 };
 
 struct tiz_event_stat
 {
   ev_stat stat;
+  tiz_event_loop_t * p_lp;
   tiz_event_stat_cb_f pf_cback;
   void * p_arg0;
   void * p_arg1;
   uint32_t id;
   bool started;
+  tiz_event_request_state_t req;
+};
+
+typedef enum tiz_event_aio_state tiz_event_aio_state_t;
+enum tiz_event_aio_state
+{
+  ETIZEventAioStateIdle = 0,
+  ETIZEventAioStateQueued,  /* in the loop's aio list, to be performed */
+  ETIZEventAioStateWaiting, /* waiting for the descriptor to be ready */
+  ETIZEventAioStateInFlight /* submitted to the ring */
 };
 
+struct tiz_event_aio
+{
+  ev_io io; /* Only used while waiting for the descriptor */
+  tiz_event_loop_t * p_lp;
+  tiz_event_aio_cb_f pf_cback;
+  void * p_arg0;
+  void * p_arg1;
+  uint32_t id;
+  tiz_event_aio_op_t op;
+  int fd;
+  void * p_buf;
+  size_t len;
+  OMX_S64 offset;
+  /* Protected by the loop's mutex */
+  tiz_event_aio_state_t state;
+  bool destroyed;
+  bool listed; /* in the loop's aio list */
+  tiz_event_aio_t * p_next;
+};
+
+typedef struct tiz_event_ring tiz_event_ring_t;
+
 typedef enum tiz_event_loop_state tiz_event_loop_state_t;
 enum tiz_event_loop_state
 {
@@ -110,7 +226,6 @@ enum tiz_event_loop_state
   ETIZEventLoopStateStopped
 };
 
-typedef struct tiz_event_loop tiz_event_loop_t;
 struct tiz_event_loop
 {
   tiz_thread_t thread;
@@ -121,11 +236,62 @@ struct tiz_event_loop
   ev_async * p_async_watcher;
   struct ev_loop * p_loop;
   tiz_event_loop_state_t state;
-  tiz_rcfile_t * p_rcfile;
+  OMX_U32 shard;
+  char name[16];
+  /* The other threads' request rings. The list, and the rings' heads, are
+     protected by the mutex */
+  tiz_event_ring_t * p_rings;
+  int nqueued; /* requests written to the rings since the last drain */
+  /* The timers with slack; protected by the mutex */
+  tiz_twheel_t * p_wheel;
+  ev_timer wheel_watcher;
+  OMX_U64 wheel_deadline_ns; /* when the wheel watcher is due */
+  bool wheel_rearm;          /* the wheel watcher is due too late */
+  tiz_event_timer_t * p_fired_head; /* expired, callback pending */
+  tiz_event_timer_t * p_fired_tail;
+  /* The async io requests; protected by the mutex */
+  tiz_event_aio_t * p_aio_head; /* to be performed or released */
+  tiz_event_aio_t * p_aio_tail;
+#ifdef HAVE_LIBURING
+  struct io_uring ring;
+  bool uring;             /* the ring is in use */
+  ev_io uring_watcher;    /* the ring's completions */
+  bool uring_reaping;     /* submissions wait until the completions are done */
+  OMX_U32 uring_pending;  /* requests queued to the ring, not submitted */
+  OMX_U32 uring_inflight; /* requests the ring has not completed yet */
+#endif
+};
+
+typedef struct tiz_event_loop_binding tiz_event_loop_binding_t;
+struct tiz_event_loop_binding
+{
+  const void * p_owner;
+  OMX_U32 shard;
+};
+
+typedef struct tiz_event_shards tiz_event_shards_t;
+struct tiz_event_shards
+{
+  tiz_event_loop_t * loops[TIZ_EVENT_LOOP_MAX_SHARDS];
+  OMX_U32 nloops;
+  pthread_mutex_t mutex; /* Protects the bindings */
+  tiz_event_loop_binding_t * p_bindings;
+  OMX_U32 nbindings;
+  OMX_U32 capacity;
 };
 
+/* The primary loop (shard 0), which also owns the rc file */
 static pthread_once_t g_event_loop_once = PTHREAD_ONCE_INIT;
 static tiz_event_loop_t * gp_event_loop = NULL;
+static tiz_rcfile_t * gp_rcfile = NULL;
+
+/* The rest of the shards, started once the rc file has been loaded */
+static pthread_once_t g_event_shards_once = PTHREAD_ONCE_INIT;
+static tiz_event_shards_t g_event_shards
+  = {{NULL}, 0, PTHREAD_MUTEX_INITIALIZER, NULL, 0, 0};
+
+/* The shard served by the current thread, if any */
+static __thread tiz_event_loop_t * tp_event_loop = NULL;
 
 typedef enum tiz_event_loop_msg_class tiz_event_loop_msg_class_t;
 enum tiz_event_loop_msg_class
@@ -168,6 +334,18 @@ struct tiz_event_loop_msg_stat
 };
 
 typedef struct tiz_event_loop_msg tiz_event_loop_msg_t;
+
+/* The requests that refer to a watcher being destroyed. The dequeue
+   functions only collect them; they are released once they are off the
+   queue */
+typedef struct tiz_event_loop_dequeue tiz_event_loop_dequeue_t;
+struct tiz_event_loop_dequeue
+{
+  void * p_watcher;
+  tiz_event_loop_msg_t * p_msgs[TIZ_EVENT_DEQUEUE_BATCH];
+  OMX_U32 nmsgs;
+};
+
 struct tiz_event_loop_msg
 {
   tiz_event_loop_msg_class_t class;
@@ -180,30 +358,47 @@ struct tiz_event_loop_msg
   };
 };
 
+/* A single-producer ring of requests, from one thread to one loop */
+struct tiz_event_ring
+{
+  tiz_event_loop_msg_t msgs[TIZ_EVENT_RING_SIZE];
+  uint32_t head; /* next request to drain; moved with the loop's mutex held */
+  uint32_t tail; /* next free slot; only moved by the producer */
+  tiz_event_loop_t * p_lp;
+  tiz_event_ring_t * p_next;
+  int refs;      /* the producer thread, and the loop */
+  bool orphaned; /* the producer thread is done with it */
+};
+
+/* The calling thread's rings, one per loop */
+static pthread_once_t g_event_ring_key_once = PTHREAD_ONCE_INIT;
+static pthread_key_t g_event_ring_key;
+static __thread tiz_event_ring_t * tp_event_rings[TIZ_EVENT_LOOP_MAX_SHARDS];
+
 /* Forward declarations */
 static OMX_ERRORTYPE
-do_io_start (tiz_event_loop_msg_t *);
+do_io_start (tiz_event_loop_t *, tiz_event_loop_msg_t *);
 static OMX_ERRORTYPE
-do_io_stop (tiz_event_loop_msg_t *);
+do_io_stop (tiz_event_loop_t *, tiz_event_loop_msg_t *);
 static OMX_ERRORTYPE
-do_io_destroy (tiz_event_loop_msg_t *);
+do_io_destroy (tiz_event_loop_t *, tiz_event_loop_msg_t *);
 static OMX_ERRORTYPE
-do_timer_start (tiz_event_loop_msg_t *);
+do_timer_start (tiz_event_loop_t *, tiz_event_loop_msg_t *);
 static OMX_ERRORTYPE
-do_timer_restart (tiz_event_loop_msg_t *);
+do_timer_restart (tiz_event_loop_t *, tiz_event_loop_msg_t *);
 static OMX_ERRORTYPE
-do_timer_stop (tiz_event_loop_msg_t *);
+do_timer_stop (tiz_event_loop_t *, tiz_event_loop_msg_t *);
 static OMX_ERRORTYPE
-do_timer_destroy (tiz_event_loop_msg_t *);
+do_timer_destroy (tiz_event_loop_t *, tiz_event_loop_msg_t *);
 static OMX_ERRORTYPE
-do_stat_start (tiz_event_loop_msg_t *);
+do_stat_start (tiz_event_loop_t *, tiz_event_loop_msg_t *);
 static OMX_ERRORTYPE
-do_stat_stop (tiz_event_loop_msg_t *);
+do_stat_stop (tiz_event_loop_t *, tiz_event_loop_msg_t *);
 static OMX_ERRORTYPE
-do_stat_destroy (tiz_event_loop_msg_t *);
+do_stat_destroy (tiz_event_loop_t *, tiz_event_loop_msg_t *);
 
 typedef OMX_ERRORTYPE (*tiz_event_loop_msg_dispatch_f) (
-  tiz_event_loop_msg_t * ap_msg);
+  tiz_event_loop_t * ap_lp, tiz_event_loop_msg_t * ap_msg);
 static const tiz_event_loop_msg_dispatch_f tiz_event_loop_msg_to_fnt_tbl[] = {
   do_io_start,
   do_io_stop,
@@ -221,7 +416,7 @@ static const tiz_event_loop_msg_dispatch_f tiz_event_loop_msg_to_fnt_tbl[] = {
 };
 
 static void
-dispatch_msg (tiz_event_loop_msg_t * ap_msg);
+dispatch_msg (tiz_event_loop_t * ap_lp, tiz_event_loop_msg_t * ap_msg);
 
 typedef struct tiz_event_loop_msg_str tiz_event_loop_msg_str_t;
 struct tiz_event_loop_msg_str
@@ -327,317 +522,776 @@ init_event_loop_msg (tiz_event_loop_t * ap_event_loop,
 /*@end@*/
 /* NOTE: Stop ignoring splint warnings in this section  */
 
-static OMX_ERRORTYPE
-enqueue_io_msg (tiz_event_io_t * ap_ev_io, const uint32_t a_id,
-                const tiz_event_loop_msg_class_t a_class)
+static inline bool
+dispatch_inline (const tiz_event_loop_t * ap_lp)
 {
-  OMX_ERRORTYPE rc = OMX_ErrorUndefined;
-  tiz_event_loop_msg_t * p_msg = NULL;
-  tiz_event_loop_msg_io_t * p_msg_io = NULL;
-
-  assert (ap_ev_io);
-  assert (ETIZEventLoopMsgIoStart == a_class
-          || ETIZEventLoopMsgIoStop == a_class
-          || ETIZEventLoopMsgIoDestroy == a_class);
-
-  tiz_check_omx (tiz_mutex_lock (&(gp_event_loop->mutex)));
-  tiz_goto_end_on_null (
-    (p_msg = init_event_loop_msg (gp_event_loop, (a_class))),
-    "Failed to initialise the event loop");
+  /* Must be called with the loop's mutex held. Requests from the loop's own
+     thread need not wait for a wakeup, as long as they don't overtake any
+     requests that are already in the queue */
+  return (tp_event_loop == ap_lp && ETIZEventLoopStateStarted == ap_lp->state
+          && 0 == tiz_pqueue_length (ap_lp->p_pq));
+}
 
-  assert (p_msg);
-  p_msg_io = &(p_msg->io);
-  p_msg_io->p_ev_io = ap_ev_io;
-  p_msg_io->id = a_id;
-  tiz_goto_end_on_omx_err (
-    (rc = tiz_pqueue_send (gp_event_loop->p_pq, p_msg, p_msg->priority)),
-    "Failed to insert into the queue");
-  tiz_check_omx (tiz_mutex_unlock (&(gp_event_loop->mutex)));
-  ev_async_send (gp_event_loop->p_loop, gp_event_loop->p_async_watcher);
+static void
+unlink_fired_timer (tiz_event_loop_t * ap_lp, tiz_event_timer_t * ap_ev_timer)
+{
+  if (ap_ev_timer->fired)
+    {
+      tiz_event_timer_t ** pp_link = &(ap_lp->p_fired_head);
+      tiz_event_timer_t * p_prev = NULL;
+      while (*pp_link != ap_ev_timer)
+        {
+          p_prev = *pp_link;
+          pp_link = &((*pp_link)->p_next_fired);
+        }
+      *pp_link = ap_ev_timer->p_next_fired;
+      if (ap_lp->p_fired_tail == ap_ev_timer)
+        {
+          ap_lp->p_fired_tail = p_prev;
+        }
+      ap_ev_timer->p_next_fired = NULL;
+      ap_ev_timer->fired = false;
+    }
+}
 
-  /* All good */
-  rc = OMX_ErrorNone;
+/* Called from the loop's thread, with the loop's mutex held */
+static void
+arm_wheel_watcher (tiz_event_loop_t * ap_lp)
+{
+  OMX_U64 expiry_ns = 0;
 
- end:
+  ev_timer_stop (ap_lp->p_loop, &(ap_lp->wheel_watcher));
+  ap_lp->wheel_deadline_ns = UINT64_MAX;
+  ap_lp->wheel_rearm = false;
 
-  if (OMX_ErrorNone != rc)
+  if (tiz_twheel_next_expiry (ap_lp->p_wheel, &expiry_ns))
     {
-      tiz_check_omx (tiz_mutex_unlock (&(gp_event_loop->mutex)));
+      const OMX_U64 now_ns = tiz_monotonic_ns ();
+      ev_now_update (ap_lp->p_loop);
+      ev_timer_set (&(ap_lp->wheel_watcher),
+                    expiry_ns > now_ns ? (expiry_ns - now_ns) / 1e9 : 0., 0.);
+      ev_timer_start (ap_lp->p_loop, &(ap_lp->wheel_watcher));
+      ap_lp->wheel_deadline_ns = expiry_ns;
     }
-
-  return OMX_ErrorNone;
 }
 
+/* Starts (or stops) a timer with slack; these are not queued to the loop */
 static OMX_ERRORTYPE
-enqueue_timer_msg (tiz_event_timer_t * ap_ev_timer, const uint32_t a_id,
-                   const tiz_event_loop_msg_class_t a_class)
+start_wheel_timer (tiz_event_timer_t * ap_ev_timer, const uint32_t a_id,
+                   const bool a_restart)
 {
-  OMX_ERRORTYPE rc = OMX_ErrorUndefined;
-  tiz_event_loop_msg_t * p_msg = NULL;
-  tiz_event_loop_msg_timer_t * p_msg_timer = NULL;
+  tiz_event_loop_t * p_lp = ap_ev_timer->p_lp;
+  bool wake_up = false;
 
-  assert (ap_ev_timer);
-  assert (ETIZEventLoopMsgTimerStart == a_class
-          || ETIZEventLoopMsgTimerStop == a_class
-          || ETIZEventLoopMsgTimerRestart == a_class
-          || ETIZEventLoopMsgTimerDestroy == a_class);
+  assert (p_lp);
+  assert (ap_ev_timer->p_wheel_timer);
 
-  tiz_check_omx (tiz_mutex_lock (&(gp_event_loop->mutex)));
-  tiz_goto_end_on_null (
-    (p_msg = init_event_loop_msg (gp_event_loop, (a_class))),
-    "Failed to initialise the event loop");
+  tiz_check_omx (tiz_mutex_lock (&(p_lp->mutex)));
 
-  assert (p_msg);
-  p_msg_timer = &(p_msg->timer);
-  p_msg_timer->p_ev_timer = ap_ev_timer;
-  p_msg_timer->id = a_id;
-  tiz_goto_end_on_omx_err (
-    (rc = tiz_pqueue_send (gp_event_loop->p_pq, p_msg, p_msg->priority)),
-    "Failed to insert into the queue");
-  tiz_check_omx (tiz_mutex_unlock (&(gp_event_loop->mutex)));
-  ev_async_send (gp_event_loop->p_loop, gp_event_loop->p_async_watcher);
+  /* A pending notification is superseded */
+  unlink_fired_timer (p_lp, ap_ev_timer);
+  __atomic_store_n (&(ap_ev_timer->id), a_id, __ATOMIC_SEQ_CST);
 
-  /* All good */
-  rc = OMX_ErrorNone;
+  if (a_restart && 0 == ap_ev_timer->repeat_ns)
+    {
+      /* Same as ev_timer_again: a non-repeating timer is just stopped */
+      tiz_twheel_timer_stop (ap_ev_timer->p_wheel_timer);
+      ap_ev_timer->started = false;
+    }
+  else
+    {
+      OMX_U64 expiry_ns = 0;
+      ap_ev_timer->due_ns
+        = tiz_monotonic_ns ()
+          + (a_restart ? ap_ev_timer->repeat_ns : ap_ev_timer->after_ns);
+      expiry_ns = tiz_twheel_timer_start (ap_ev_timer->p_wheel_timer,
+                                          ap_ev_timer->due_ns,
+                                          ap_ev_timer->slack_ns);
+      ap_ev_timer->started = true;
+
+      if (expiry_ns < p_lp->wheel_deadline_ns)
+        {
+          if (tp_event_loop == p_lp)
+            {
+              arm_wheel_watcher (p_lp);
+            }
+          else if (ETIZEventLoopStateStarted == p_lp->state)
+            {
+              p_lp->wheel_deadline_ns = expiry_ns;
+              p_lp->wheel_rearm = true;
+              wake_up = true;
+            }
+        }
+    }
 
- end:
+  tiz_check_omx (tiz_mutex_unlock (&(p_lp->mutex)));
 
-  if (OMX_ErrorNone != rc)
+  if (wake_up)
     {
-      tiz_check_omx (tiz_mutex_unlock (&(gp_event_loop->mutex)));
+      ev_async_send (p_lp->p_loop, p_lp->p_async_watcher);
     }
 
-  return rc;
+  return OMX_ErrorNone;
 }
 
 static OMX_ERRORTYPE
-enqueue_stat_msg (tiz_event_stat_t * ap_ev_stat, const uint32_t a_id,
-                  const tiz_event_loop_msg_class_t a_class)
+stop_wheel_timer (tiz_event_timer_t * ap_ev_timer)
 {
-  OMX_ERRORTYPE rc = OMX_ErrorUndefined;
-  tiz_event_loop_msg_t * p_msg = NULL;
-  tiz_event_loop_msg_stat_t * p_msg_stat = NULL;
-
-  assert (ap_ev_stat);
-  assert (ETIZEventLoopMsgStatStart == a_class
-          || ETIZEventLoopMsgStatStop == a_class
-          || ETIZEventLoopMsgStatDestroy == a_class);
-
-  tiz_check_omx (tiz_mutex_lock (&(gp_event_loop->mutex)));
-  tiz_goto_end_on_null ((p_msg = init_event_loop_msg (gp_event_loop, (a_class))),
-                        "Failed to initialise the event loop");
+  tiz_event_loop_t * p_lp = ap_ev_timer->p_lp;
 
-  assert (p_msg);
-  p_msg_stat = &(p_msg->stat);
-  p_msg_stat->p_ev_stat = ap_ev_stat;
-  p_msg_stat->id = a_id;
-  tiz_goto_end_on_omx_err (
-    (rc = tiz_pqueue_send (gp_event_loop->p_pq, p_msg, p_msg->priority)),
-    "Failed to insert into the queue");
-  tiz_check_omx (tiz_mutex_unlock (&(gp_event_loop->mutex)));
-  ev_async_send (gp_event_loop->p_loop, gp_event_loop->p_async_watcher);
+  assert (p_lp);
+  assert (ap_ev_timer->p_wheel_timer);
 
-  /* All good */
-  rc = OMX_ErrorNone;
+  /* The wheel watcher is left alone; it finds nothing to do if this was the
+     earliest timer */
+  tiz_check_omx (tiz_mutex_lock (&(p_lp->mutex)));
+  tiz_twheel_timer_stop (ap_ev_timer->p_wheel_timer);
+  unlink_fired_timer (p_lp, ap_ev_timer);
+  ap_ev_timer->started = false;
+  tiz_check_omx (tiz_mutex_unlock (&(p_lp->mutex)));
 
- end:
+  return OMX_ErrorNone;
+}
 
-  if (OMX_ErrorNone != rc)
+static void
+release_ring (tiz_event_ring_t * ap_ring)
+{
+  if (0 == __atomic_sub_fetch (&(ap_ring->refs), 1, __ATOMIC_ACQ_REL))
     {
-      tiz_check_omx (tiz_mutex_unlock (&(gp_event_loop->mutex)));
+      tiz_mem_free (ap_ring);
     }
-
-  return OMX_ErrorNone;
 }
 
 static void
-dispatch_msg (tiz_event_loop_msg_t * ap_msg)
+orphan_rings (void * ap_rings)
 {
-  assert (ap_msg);
-  assert (ap_msg->class < ETIZEventLoopMsgMax);
+  tiz_event_ring_t ** pp_rings = ap_rings;
+  OMX_U32 i = 0;
 
-  (void) tiz_event_loop_msg_to_fnt_tbl[ap_msg->class](ap_msg);
+  /* The loops free the rings once they have drained them */
+  for (i = 0; i < TIZ_EVENT_LOOP_MAX_SHARDS; ++i)
+    {
+      if (pp_rings[i])
+        {
+          __atomic_store_n (&(pp_rings[i]->orphaned), true, __ATOMIC_RELEASE);
+          release_ring (pp_rings[i]);
+          pp_rings[i] = NULL;
+        }
+    }
 }
 
-static OMX_S32
-pqueue_cmp (OMX_PTR ap_left, OMX_PTR ap_right)
+static void
+create_ring_key (void)
 {
-  /* Not planning to use tiz_pqueue_remove or tiz_pqueue_removep */
-  assert (0);
-  return 1;
+  (void) pthread_key_create (&g_event_ring_key, orphan_rings);
 }
 
-static OMX_BOOL
-ev_io_msg_dequeue (void * ap_elem, OMX_S32 a_data1, void * ap_data2)
+static tiz_event_ring_t *
+get_ring (tiz_event_loop_t * ap_lp)
 {
-  OMX_BOOL rc = OMX_FALSE;
-  tiz_event_loop_msg_t * p_msg = ap_elem;
-  const tiz_event_loop_msg_class_t class_to_delete = a_data1;
-  tiz_event_loop_msg_class_t elem_class = ETIZEventLoopMsgMax;
-  bool elem_class_is_io = false;
-
-  assert (p_msg);
-  assert (ETIZEventLoopMsgIoStart == class_to_delete
-          || ETIZEventLoopMsgIoStop == class_to_delete
-          || ETIZEventLoopMsgIoDestroy == class_to_delete
-          || ETIZEventLoopMsgIoAny == class_to_delete);
+  tiz_event_ring_t * p_ring = tp_event_rings[ap_lp->shard];
 
-  elem_class = p_msg->class;
-  elem_class_is_io = (ETIZEventLoopMsgIoStart == elem_class
-                      || ETIZEventLoopMsgIoStop == elem_class
-                      || ETIZEventLoopMsgIoDestroy == elem_class);
+  /* NOTE: The loop that owned this ring may have been destroyed since; this
+     thread's reference to it is dropped, and the ring is freed by whoever
+     holds the last one */
+  if (p_ring && ap_lp != __atomic_load_n (&(p_ring->p_lp), __ATOMIC_ACQUIRE))
+    {
+      __atomic_store_n (&(p_ring->orphaned), true, __ATOMIC_RELEASE);
+      release_ring (p_ring);
+      tp_event_rings[ap_lp->shard] = NULL;
+      p_ring = NULL;
+    }
 
-  if (class_to_delete == elem_class
-      || (elem_class_is_io && class_to_delete == ETIZEventLoopMsgIoAny))
+  if (!p_ring)
     {
-      tiz_event_loop_msg_io_t * p_msg_io = NULL;
-      tiz_event_io_t * p_ev_io = NULL;
-      p_msg_io = &(p_msg->io);
-      assert (p_msg_io);
-      p_ev_io = p_msg_io->p_ev_io;
-      assert (p_ev_io);
-      if (ap_data2 == p_ev_io)
+      if ((p_ring = tiz_mem_calloc (1, sizeof (tiz_event_ring_t))))
         {
-          tiz_event_io_t * p_ev_io_needle = ap_data2;
-          if (p_ev_io_needle->id == p_msg_io->id)
-            {
-              /* Found, return TRUE so that the msg will be removed from the
-                 queue */
-              rc = OMX_TRUE;
-            }
+          (void) pthread_once (&g_event_ring_key_once, create_ring_key);
+          p_ring->p_lp = ap_lp;
+          p_ring->refs = 2;
+          (void) tiz_mutex_lock (&(ap_lp->mutex));
+          p_ring->p_next = ap_lp->p_rings;
+          ap_lp->p_rings = p_ring;
+          (void) tiz_mutex_unlock (&(ap_lp->mutex));
+          tp_event_rings[ap_lp->shard] = p_ring;
+          (void) pthread_setspecific (g_event_ring_key, tp_event_rings);
         }
     }
-  return rc;
+
+  return p_ring;
 }
 
-static OMX_BOOL
-ev_timer_msg_dequeue (void * ap_elem, OMX_S32 a_data1, void * ap_data2)
+static bool
+push_ring_msg (tiz_event_loop_t * ap_lp, const tiz_event_loop_msg_t * ap_msg)
 {
-  OMX_BOOL rc = OMX_FALSE;
-  tiz_event_loop_msg_t * p_msg = ap_elem;
-  const tiz_event_loop_msg_class_t class_to_delete = a_data1;
-  tiz_event_loop_msg_class_t elem_class = ETIZEventLoopMsgMax;
-  bool elem_class_is_timer = false;
+  tiz_event_ring_t * p_ring = get_ring (ap_lp);
+  uint32_t tail = 0;
 
-  assert (p_msg);
-  assert (ETIZEventLoopMsgTimerStart == class_to_delete
-          || ETIZEventLoopMsgTimerStop == class_to_delete
-          || ETIZEventLoopMsgTimerDestroy == class_to_delete
-          || ETIZEventLoopMsgTimerAny == class_to_delete);
+  if (!p_ring)
+    {
+      return false;
+    }
 
-  elem_class = p_msg->class;
-  elem_class_is_timer = (ETIZEventLoopMsgTimerStart == elem_class
-                         || ETIZEventLoopMsgTimerStop == elem_class
-                         || ETIZEventLoopMsgTimerDestroy == elem_class);
+  tail = p_ring->tail;
+  if (tail - __atomic_load_n (&(p_ring->head), __ATOMIC_ACQUIRE)
+      >= TIZ_EVENT_RING_SIZE)
+    {
+      return false;
+    }
 
-  if (class_to_delete == p_msg->class || (elem_class_is_timer
-                                          && class_to_delete
-                                               == ETIZEventLoopMsgTimerAny))
+  p_ring->msgs[tail & (TIZ_EVENT_RING_SIZE - 1)] = *ap_msg;
+  __atomic_store_n (&(p_ring->tail), tail + 1, __ATOMIC_RELEASE);
+
+  /* Only the first request since the last drain needs to wake the loop up */
+  if (0 == __atomic_fetch_add (&(ap_lp->nqueued), 1, __ATOMIC_SEQ_CST))
     {
-      tiz_event_loop_msg_timer_t * p_msg_timer = NULL;
-      tiz_event_timer_t * p_ev_timer = NULL;
-      p_msg_timer = &(p_msg->timer);
-      assert (p_msg_timer);
-      p_ev_timer = p_msg_timer->p_ev_timer;
-      assert (p_ev_timer);
-      if (ap_data2 == p_ev_timer)
+      ev_async_send (ap_lp->p_loop, ap_lp->p_async_watcher);
+    }
+
+  return true;
+}
+
+static inline void
+copy_msg_args (tiz_event_loop_msg_t * ap_dst,
+               const tiz_event_loop_msg_t * ap_src)
+{
+  /* The class and priority are set by init_event_loop_msg */
+  switch (ap_src->class)
+    {
+      case ETIZEventLoopMsgIoStart:
+      case ETIZEventLoopMsgIoStop:
+      case ETIZEventLoopMsgIoDestroy:
         {
-          tiz_event_timer_t * p_ev_timer_needle = ap_data2;
-          if (p_ev_timer_needle->id == p_msg_timer->id)
-            {
-              /* Found, return TRUE so that the msg will be removed from the
-                 queue */
-              rc = OMX_TRUE;
-            }
+          ap_dst->io = ap_src->io;
         }
-    }
-  return rc;
+        break;
+      case ETIZEventLoopMsgTimerStart:
+      case ETIZEventLoopMsgTimerRestart:
+      case ETIZEventLoopMsgTimerStop:
+      case ETIZEventLoopMsgTimerDestroy:
+        {
+          ap_dst->timer = ap_src->timer;
+        }
+        break;
+      default:
+        {
+          ap_dst->stat = ap_src->stat;
+        }
+        break;
+    };
 }
 
-static OMX_BOOL
-ev_stat_msg_dequeue (void * ap_elem, OMX_S32 a_data1, void * ap_data2)
+static bool
+is_destroy_msg (const tiz_event_loop_msg_t * ap_msg)
 {
-  OMX_BOOL rc = OMX_FALSE;
-  tiz_event_loop_msg_t * p_msg = ap_elem;
-  const tiz_event_loop_msg_class_t class_to_delete = a_data1;
-  tiz_event_loop_msg_class_t elem_class = ETIZEventLoopMsgMax;
-  bool elem_class_is_stat = false;
+  return (ETIZEventLoopMsgIoDestroy == ap_msg->class
+          || ETIZEventLoopMsgTimerDestroy == ap_msg->class
+          || ETIZEventLoopMsgStatDestroy == ap_msg->class);
+}
 
-  assert (p_msg);
-  assert (ETIZEventLoopMsgStatStart == class_to_delete
-          || ETIZEventLoopMsgStatStop == class_to_delete
-          || ETIZEventLoopMsgStatDestroy == class_to_delete
-          || ETIZEventLoopMsgStatAny == class_to_delete);
+/* Called with the loop's mutex held */
+static void
+drain_rings (tiz_event_loop_t * ap_lp)
+{
+  bool sweep = true;
 
-  elem_class = p_msg->class;
-  elem_class_is_stat = (ETIZEventLoopMsgStatStart == elem_class
-                        || ETIZEventLoopMsgStatStop == elem_class
-                        || ETIZEventLoopMsgStatDestroy == elem_class);
+  /* Requests written after this are announced again */
+  __atomic_store_n (&(ap_lp->nqueued), 0, __ATOMIC_SEQ_CST);
 
-  if (class_to_delete == p_msg->class || (elem_class_is_stat
-                                          && class_to_delete
-                                               == ETIZEventLoopMsgStatAny))
+  while (sweep)
     {
-      tiz_event_loop_msg_stat_t * p_msg_stat = NULL;
-      tiz_event_stat_t * p_ev_stat = NULL;
-      p_msg_stat = &(p_msg->stat);
-      assert (p_msg_stat);
-      p_ev_stat = p_msg_stat->p_ev_stat;
-      assert (p_ev_stat);
-      if (ap_data2 == p_ev_stat)
+      tiz_event_ring_t ** pp_ring = &(ap_lp->p_rings);
+      sweep = false;
+      while (*pp_ring)
         {
-          tiz_event_stat_t * p_ev_stat_needle = ap_data2;
-          if (p_ev_stat_needle->id == p_msg_stat->id)
+          tiz_event_ring_t * p_ring = *pp_ring;
+          const bool orphaned
+            = __atomic_load_n (&(p_ring->orphaned), __ATOMIC_ACQUIRE);
+          const uint32_t tail
+            = __atomic_load_n (&(p_ring->tail), __ATOMIC_ACQUIRE);
+          uint32_t head = p_ring->head;
+
+          for (; head != tail; ++head)
             {
-              /* Found, return TRUE so that the msg will be removed from the
-                 queue */
-              rc = OMX_TRUE;
-            }
+              const tiz_event_loop_msg_t * p_src
+                = &(p_ring->msgs[head & (TIZ_EVENT_RING_SIZE - 1)]);
+              tiz_event_loop_msg_t * p_msg
+                = init_event_loop_msg (ap_lp, p_src->class);
+              if (!p_msg)
+                {
+                  break;
+                }
+              copy_msg_args (p_msg, p_src);
+              if (OMX_ErrorNone
+                  != tiz_pqueue_send (ap_lp->p_pq, p_msg, p_msg->priority))
+                {
+                  tiz_soa_free (ap_lp->p_soa, p_msg);
+                  break;
+                }
+              /* Whatever was requested before a destroy must be in the queue
+                 when the destroy is processed */
+              sweep = sweep || is_destroy_msg (p_msg);
+            }
+          __atomic_store_n (&(p_ring->head), head, __ATOMIC_RELEASE);
+
+          if (orphaned && head == tail)
+            {
+              *pp_ring = p_ring->p_next;
+              release_ring (p_ring);
+            }
+          else
+            {
+              pp_ring = &(p_ring->p_next);
+            }
+        }
+    }
+}
+
+static inline int *
+msg_npending (tiz_event_loop_msg_t * ap_msg)
+{
+  switch (ap_msg->class)
+    {
+      case ETIZEventLoopMsgIoStart:
+      case ETIZEventLoopMsgIoStop:
+      case ETIZEventLoopMsgIoDestroy:
+        {
+          return &(ap_msg->io.p_ev_io->req.npending);
+        }
+      case ETIZEventLoopMsgTimerStart:
+      case ETIZEventLoopMsgTimerRestart:
+      case ETIZEventLoopMsgTimerStop:
+      case ETIZEventLoopMsgTimerDestroy:
+        {
+          return &(ap_msg->timer.p_ev_timer->req.npending);
+        }
+      default:
+        {
+          return &(ap_msg->stat.p_ev_stat->req.npending);
+        }
+    };
+}
+
+/* Returns true if a start request would change nothing; the new id is then
+   stored directly. The id is only replaced if nobody else has changed it
+   since it was read, so that a request the loop has applied meanwhile is
+   not overwritten with an older id; the request goes through the loop
+   otherwise. Watchers that stop by themselves (e.g. 'once' watchers) are
+   always restarted through the loop */
+static inline bool
+skip_start (tiz_event_request_state_t * ap_req, uint32_t * ap_id,
+            const uint32_t a_id, const bool a_self_stopping)
+{
+  uint32_t id = __atomic_load_n (ap_id, __ATOMIC_SEQ_CST);
+  return (1 == __atomic_exchange_n (&(ap_req->requested), 1, __ATOMIC_SEQ_CST)
+          && !a_self_stopping
+          && 0 == __atomic_load_n (&(ap_req->npending), __ATOMIC_SEQ_CST)
+          && __atomic_compare_exchange_n (ap_id, &id, a_id, false,
+                                          __ATOMIC_SEQ_CST,
+                                          __ATOMIC_SEQ_CST));
+}
+
+/* Returns true if a stop request would change nothing */
+static inline bool
+skip_stop (tiz_event_request_state_t * ap_req)
+{
+  return (0 == __atomic_exchange_n (&(ap_req->requested), 0, __ATOMIC_SEQ_CST));
+}
+
+static inline bool
+is_requested (tiz_event_request_state_t * ap_req)
+{
+  return (1 == __atomic_load_n (&(ap_req->requested), __ATOMIC_SEQ_CST));
+}
+
+static OMX_ERRORTYPE
+enqueue_msg (tiz_event_loop_t * ap_lp, tiz_event_loop_msg_t * ap_msg)
+{
+  OMX_ERRORTYPE rc = OMX_ErrorUndefined;
+  tiz_event_loop_msg_t * p_msg = NULL;
+  int * p_npending = msg_npending (ap_msg);
+
+  assert (ap_lp);
+  assert (ap_msg);
+
+  if (tp_event_loop != ap_lp)
+    {
+      __atomic_add_fetch (p_npending, 1, __ATOMIC_SEQ_CST);
+      if (push_ring_msg (ap_lp, ap_msg))
+        {
+          return OMX_ErrorNone;
+        }
+      /* No ring, or a full one; take the slow path */
+    }
+
+  tiz_check_omx (tiz_mutex_lock (&(ap_lp->mutex)));
+  /* Other threads' requests, if any, go first */
+  if (0 != __atomic_load_n (&(ap_lp->nqueued), __ATOMIC_SEQ_CST))
+    {
+      drain_rings (ap_lp);
+    }
+  if (dispatch_inline (ap_lp))
+    {
+      dispatch_msg (ap_lp, ap_msg);
+      tiz_check_omx (tiz_mutex_unlock (&(ap_lp->mutex)));
+      return OMX_ErrorNone;
+    }
+
+  if (tp_event_loop == ap_lp)
+    {
+      __atomic_add_fetch (p_npending, 1, __ATOMIC_SEQ_CST);
+    }
+
+  tiz_goto_end_on_null ((p_msg = init_event_loop_msg (ap_lp, ap_msg->class)),
+                        "Failed to initialise the event loop");
+
+  assert (p_msg);
+  copy_msg_args (p_msg, ap_msg);
+  tiz_goto_end_on_omx_err (
+    (rc = tiz_pqueue_send (ap_lp->p_pq, p_msg, p_msg->priority)),
+    "Failed to insert into the queue");
+  tiz_check_omx (tiz_mutex_unlock (&(ap_lp->mutex)));
+  ev_async_send (ap_lp->p_loop, ap_lp->p_async_watcher);
+
+  /* All good */
+  rc = OMX_ErrorNone;
+
+ end:
+
+  if (OMX_ErrorNone != rc)
+    {
+      if (p_msg)
+        {
+          tiz_soa_free (ap_lp->p_soa, p_msg);
+        }
+      __atomic_sub_fetch (p_npending, 1, __ATOMIC_SEQ_CST);
+      tiz_check_omx (tiz_mutex_unlock (&(ap_lp->mutex)));
+    }
+
+  return rc;
+}
+
+static OMX_ERRORTYPE
+enqueue_io_msg (tiz_event_io_t * ap_ev_io, const uint32_t a_id,
+                const tiz_event_loop_msg_class_t a_class)
+{
+  tiz_event_loop_msg_t msg;
+
+  assert (ap_ev_io);
+  assert (ETIZEventLoopMsgIoStart == a_class
+          || ETIZEventLoopMsgIoStop == a_class
+          || ETIZEventLoopMsgIoDestroy == a_class);
+
+  if ((ETIZEventLoopMsgIoStart == a_class
+       && skip_start (&(ap_ev_io->req), &(ap_ev_io->id), a_id,
+                       ap_ev_io->once))
+      || (ETIZEventLoopMsgIoStop == a_class && skip_stop (&(ap_ev_io->req))))
+    {
+      return OMX_ErrorNone;
+    }
+
+  msg.class = a_class;
+  msg.priority = 0;
+  msg.io.p_ev_io = ap_ev_io;
+  msg.io.id = a_id;
+  return enqueue_msg (ap_ev_io->p_lp, &msg);
+}
+
+static OMX_ERRORTYPE
+enqueue_timer_msg (tiz_event_timer_t * ap_ev_timer, const uint32_t a_id,
+                   const tiz_event_loop_msg_class_t a_class)
+{
+  tiz_event_loop_msg_t msg;
+
+  assert (ap_ev_timer);
+  assert (ETIZEventLoopMsgTimerStart == a_class
+          || ETIZEventLoopMsgTimerStop == a_class
+          || ETIZEventLoopMsgTimerRestart == a_class
+          || ETIZEventLoopMsgTimerDestroy == a_class);
+
+  if ((ETIZEventLoopMsgTimerStart == a_class
+       && skip_start (&(ap_ev_timer->req), &(ap_ev_timer->id), a_id,
+                       ap_ev_timer->once))
+      || (ETIZEventLoopMsgTimerStop == a_class
+          && skip_stop (&(ap_ev_timer->req))))
+    {
+      return OMX_ErrorNone;
+    }
+
+  if (ETIZEventLoopMsgTimerRestart == a_class)
+    {
+      /* Restarting a non-repeating timer stops it (see ev_timer_again) */
+      __atomic_store_n (&(ap_ev_timer->req.requested),
+                        ap_ev_timer->once ? 0 : 1, __ATOMIC_SEQ_CST);
+    }
+
+  msg.class = a_class;
+  msg.priority = 0;
+  msg.timer.p_ev_timer = ap_ev_timer;
+  msg.timer.id = a_id;
+  return enqueue_msg (ap_ev_timer->p_lp, &msg);
+}
+
+static OMX_ERRORTYPE
+enqueue_stat_msg (tiz_event_stat_t * ap_ev_stat, const uint32_t a_id,
+                  const tiz_event_loop_msg_class_t a_class)
+{
+  tiz_event_loop_msg_t msg;
+
+  assert (ap_ev_stat);
+  assert (ETIZEventLoopMsgStatStart == a_class
+          || ETIZEventLoopMsgStatStop == a_class
+          || ETIZEventLoopMsgStatDestroy == a_class);
+
+  if ((ETIZEventLoopMsgStatStart == a_class
+       && skip_start (&(ap_ev_stat->req), &(ap_ev_stat->id), a_id, false))
+      || (ETIZEventLoopMsgStatStop == a_class
+          && skip_stop (&(ap_ev_stat->req))))
+    {
+      return OMX_ErrorNone;
+    }
+
+  msg.class = a_class;
+  msg.priority = 0;
+  msg.stat.p_ev_stat = ap_ev_stat;
+  msg.stat.id = a_id;
+  return enqueue_msg (ap_ev_stat->p_lp, &msg);
+}
+
+static void
+dispatch_msg (tiz_event_loop_t * ap_lp, tiz_event_loop_msg_t * ap_msg)
+{
+  assert (ap_lp);
+  assert (ap_msg);
+  assert (ap_msg->class < ETIZEventLoopMsgMax);
+
+  (void) tiz_event_loop_msg_to_fnt_tbl[ap_msg->class](ap_lp, ap_msg);
+}
+
+static OMX_S32
+pqueue_cmp (OMX_PTR ap_left, OMX_PTR ap_right)
+{
+  /* Not planning to use tiz_pqueue_remove or tiz_pqueue_removep */
+  assert (0);
+  return 1;
+}
+
+static OMX_BOOL
+ev_io_msg_dequeue (void * ap_elem, OMX_S32 a_data1, void * ap_data2)
+{
+  OMX_BOOL rc = OMX_FALSE;
+  tiz_event_loop_msg_t * p_msg = ap_elem;
+  tiz_event_loop_dequeue_t * p_dq = ap_data2;
+  const tiz_event_loop_msg_class_t class_to_delete = a_data1;
+  tiz_event_loop_msg_class_t elem_class = ETIZEventLoopMsgMax;
+  bool elem_class_is_io = false;
+
+  assert (p_msg);
+  assert (ETIZEventLoopMsgIoStart == class_to_delete
+          || ETIZEventLoopMsgIoStop == class_to_delete
+          || ETIZEventLoopMsgIoDestroy == class_to_delete
+          || ETIZEventLoopMsgIoAny == class_to_delete);
+
+  elem_class = p_msg->class;
+  elem_class_is_io = (ETIZEventLoopMsgIoStart == elem_class
+                      || ETIZEventLoopMsgIoStop == elem_class
+                      || ETIZEventLoopMsgIoDestroy == elem_class);
+
+  if (class_to_delete == elem_class
+      || (elem_class_is_io && class_to_delete == ETIZEventLoopMsgIoAny))
+    {
+      tiz_event_loop_msg_io_t * p_msg_io = NULL;
+      tiz_event_io_t * p_ev_io = NULL;
+      p_msg_io = &(p_msg->io);
+      assert (p_msg_io);
+      p_ev_io = p_msg_io->p_ev_io;
+      assert (p_ev_io);
+      if (p_dq->p_watcher == p_ev_io
+          && p_dq->nmsgs < TIZ_EVENT_DEQUEUE_BATCH)
+        {
+          tiz_event_io_t * p_ev_io_needle = p_dq->p_watcher;
+          /* When the watcher is being destroyed, every request that refers
+             to it must go, whatever its id */
+          if (ETIZEventLoopMsgIoAny == class_to_delete
+              || p_ev_io_needle->id == p_msg_io->id)
+            {
+              /* Found, return TRUE so that the msg will be removed from the
+                 queue */
+              p_dq->p_msgs[p_dq->nmsgs++] = p_msg;
+              rc = OMX_TRUE;
+            }
+        }
+    }
+  return rc;
+}
+
+static OMX_BOOL
+ev_timer_msg_dequeue (void * ap_elem, OMX_S32 a_data1, void * ap_data2)
+{
+  OMX_BOOL rc = OMX_FALSE;
+  tiz_event_loop_msg_t * p_msg = ap_elem;
+  tiz_event_loop_dequeue_t * p_dq = ap_data2;
+  const tiz_event_loop_msg_class_t class_to_delete = a_data1;
+  tiz_event_loop_msg_class_t elem_class = ETIZEventLoopMsgMax;
+  bool elem_class_is_timer = false;
+
+  assert (p_msg);
+  assert (ETIZEventLoopMsgTimerStart == class_to_delete
+          || ETIZEventLoopMsgTimerStop == class_to_delete
+          || ETIZEventLoopMsgTimerDestroy == class_to_delete
+          || ETIZEventLoopMsgTimerAny == class_to_delete);
+
+  elem_class = p_msg->class;
+  elem_class_is_timer = (ETIZEventLoopMsgTimerStart == elem_class
+                         || ETIZEventLoopMsgTimerRestart == elem_class
+                         || ETIZEventLoopMsgTimerStop == elem_class
+                         || ETIZEventLoopMsgTimerDestroy == elem_class);
+
+  if (class_to_delete == p_msg->class || (elem_class_is_timer
+                                          && class_to_delete
+                                               == ETIZEventLoopMsgTimerAny))
+    {
+      tiz_event_loop_msg_timer_t * p_msg_timer = NULL;
+      tiz_event_timer_t * p_ev_timer = NULL;
+      p_msg_timer = &(p_msg->timer);
+      assert (p_msg_timer);
+      p_ev_timer = p_msg_timer->p_ev_timer;
+      assert (p_ev_timer);
+      if (p_dq->p_watcher == p_ev_timer
+          && p_dq->nmsgs < TIZ_EVENT_DEQUEUE_BATCH)
+        {
+          tiz_event_timer_t * p_ev_timer_needle = p_dq->p_watcher;
+          /* When the watcher is being destroyed, every request that refers
+             to it must go, whatever its id */
+          if (ETIZEventLoopMsgTimerAny == class_to_delete
+              || p_ev_timer_needle->id == p_msg_timer->id)
+            {
+              /* Found, return TRUE so that the msg will be removed from the
+                 queue */
+              p_dq->p_msgs[p_dq->nmsgs++] = p_msg;
+              rc = OMX_TRUE;
+            }
+        }
+    }
+  return rc;
+}
+
+static OMX_BOOL
+ev_stat_msg_dequeue (void * ap_elem, OMX_S32 a_data1, void * ap_data2)
+{
+  OMX_BOOL rc = OMX_FALSE;
+  tiz_event_loop_msg_t * p_msg = ap_elem;
+  tiz_event_loop_dequeue_t * p_dq = ap_data2;
+  const tiz_event_loop_msg_class_t class_to_delete = a_data1;
+  tiz_event_loop_msg_class_t elem_class = ETIZEventLoopMsgMax;
+  bool elem_class_is_stat = false;
+
+  assert (p_msg);
+  assert (ETIZEventLoopMsgStatStart == class_to_delete
+          || ETIZEventLoopMsgStatStop == class_to_delete
+          || ETIZEventLoopMsgStatDestroy == class_to_delete
+          || ETIZEventLoopMsgStatAny == class_to_delete);
+
+  elem_class = p_msg->class;
+  elem_class_is_stat = (ETIZEventLoopMsgStatStart == elem_class
+                        || ETIZEventLoopMsgStatStop == elem_class
+                        || ETIZEventLoopMsgStatDestroy == elem_class);
+
+  if (class_to_delete == p_msg->class || (elem_class_is_stat
+                                          && class_to_delete
+                                               == ETIZEventLoopMsgStatAny))
+    {
+      tiz_event_loop_msg_stat_t * p_msg_stat = NULL;
+      tiz_event_stat_t * p_ev_stat = NULL;
+      p_msg_stat = &(p_msg->stat);
+      assert (p_msg_stat);
+      p_ev_stat = p_msg_stat->p_ev_stat;
+      assert (p_ev_stat);
+      if (p_dq->p_watcher == p_ev_stat
+          && p_dq->nmsgs < TIZ_EVENT_DEQUEUE_BATCH)
+        {
+          tiz_event_stat_t * p_ev_stat_needle = p_dq->p_watcher;
+          /* When the watcher is being destroyed, every request that refers
+             to it must go, whatever its id */
+          if (ETIZEventLoopMsgStatAny == class_to_delete
+              || p_ev_stat_needle->id == p_msg_stat->id)
+            {
+              /* Found, return TRUE so that the msg will be removed from the
+                 queue */
+              p_dq->p_msgs[p_dq->nmsgs++] = p_msg;
+              rc = OMX_TRUE;
+            }
+        }
+    }
+  return rc;
+}
+
+/* Removes from the queue, and releases, the requests that refer to a
+   watcher; called with the loop's mutex held */
+static void
+dequeue_watcher_msgs (tiz_event_loop_t * ap_lp, tiz_pq_func_f apf_dequeue,
+                      const tiz_event_loop_msg_class_t a_class,
+                      void * ap_watcher)
+{
+  tiz_event_loop_dequeue_t dq;
+  OMX_U32 i = 0;
+
+  dq.p_watcher = ap_watcher;
+  do
+    {
+      dq.nmsgs = 0;
+      (void) tiz_pqueue_remove_func (ap_lp->p_pq, apf_dequeue,
+                                     (OMX_S32) a_class, &dq);
+      for (i = 0; i < dq.nmsgs; ++i)
+        {
+          __atomic_sub_fetch (msg_npending (dq.p_msgs[i]), 1,
+                              __ATOMIC_SEQ_CST);
+          tiz_soa_free (ap_lp->p_soa, dq.p_msgs[i]);
         }
     }
-  return rc;
+  while (TIZ_EVENT_DEQUEUE_BATCH == dq.nmsgs);
 }
 
 static OMX_ERRORTYPE
-do_io_start (tiz_event_loop_msg_t * ap_msg)
+do_io_start (tiz_event_loop_t * ap_lp, tiz_event_loop_msg_t * ap_msg)
 {
   tiz_event_loop_msg_io_t * p_msg_io = NULL;
   tiz_event_io_t * p_ev_io = NULL;
 
-  assert (gp_event_loop);
+  assert (ap_lp);
   assert (ap_msg);
-  assert (ETIZEventLoopStateStarted == gp_event_loop->state);
+  assert (ETIZEventLoopStateStarted == ap_lp->state
+          || ETIZEventLoopStateStopping == ap_lp->state);
 
   p_msg_io = &(ap_msg->io);
   assert (p_msg_io);
   p_ev_io = p_msg_io->p_ev_io;
   assert (p_ev_io);
-  /* debug: Verify that ids don't get repeated */
-  if (p_ev_io->id != 0 && p_ev_io->id == p_msg_io->id)
+  if (!is_requested (&(p_ev_io->req)))
     {
-      assert (p_ev_io->id != p_msg_io->id);
+      /* A later stop request has superseded this one */
+      return OMX_ErrorNone;
     }
-  p_ev_io->id = p_msg_io->id;
-  /* debug: Verify that we are starting a watcher that was stopped */
-  if (p_ev_io->started)
+  __atomic_store_n (&(p_ev_io->id), p_msg_io->id, __ATOMIC_SEQ_CST);
+  if (!p_ev_io->started)
     {
-      assert (!p_ev_io->started);
+      p_ev_io->started = true;
+      ev_io_start (ap_lp->p_loop, (ev_io *) (p_ev_io));
     }
-  p_ev_io->started = true;
-  ev_io_start (gp_event_loop->p_loop, (ev_io *) (p_ev_io));
 
   return OMX_ErrorNone;
 }
 
 static OMX_ERRORTYPE
-do_io_stop (tiz_event_loop_msg_t * ap_msg)
+do_io_stop (tiz_event_loop_t * ap_lp, tiz_event_loop_msg_t * ap_msg)
 {
   tiz_event_loop_msg_io_t * p_msg_io = NULL;
   tiz_event_io_t * p_ev_io = NULL;
 
-  assert (gp_event_loop);
+  assert (ap_lp);
   assert (ap_msg);
-  assert (ETIZEventLoopStateStarted == gp_event_loop->state);
+  assert (ETIZEventLoopStateStarted == ap_lp->state
+          || ETIZEventLoopStateStopping == ap_lp->state);
 
   p_msg_io = &(ap_msg->io);
   assert (p_msg_io);
@@ -646,30 +1300,24 @@ do_io_stop (tiz_event_loop_msg_t * ap_msg)
   if (p_ev_io->started)
     {
       /* The io watcher has been started, let's stop it */
-      ev_io_stop (gp_event_loop->p_loop, (ev_io *) (p_ev_io));
+      ev_io_stop (ap_lp->p_loop, (ev_io *) (p_ev_io));
       p_ev_io->started = false;
     }
-  else
-    {
-      /* This io watcher hasn't been started, let's make sure there are no
-         start requests left behind in the queue */
-      const tiz_event_loop_msg_class_t class_to_be_deleted
-        = ETIZEventLoopMsgIoStart;
-      tiz_pqueue_remove_func (gp_event_loop->p_pq, ev_io_msg_dequeue,
-                              (OMX_S32) class_to_be_deleted, p_ev_io);
-    }
+  /* NOTE: Start requests still in the queue are not purged; they are
+     ignored when processed, as this stop has superseded them */
   return OMX_ErrorNone;
 }
 
 static OMX_ERRORTYPE
-do_io_destroy (tiz_event_loop_msg_t * ap_msg)
+do_io_destroy (tiz_event_loop_t * ap_lp, tiz_event_loop_msg_t * ap_msg)
 {
   tiz_event_loop_msg_io_t * p_msg_io = NULL;
   tiz_event_io_t * p_ev_io = NULL;
 
-  assert (gp_event_loop);
+  assert (ap_lp);
   assert (ap_msg);
-  assert (ETIZEventLoopStateStarted == gp_event_loop->state);
+  assert (ETIZEventLoopStateStarted == ap_lp->state
+          || ETIZEventLoopStateStopping == ap_lp->state);
 
   p_msg_io = &(ap_msg->io);
   assert (p_msg_io);
@@ -678,16 +1326,13 @@ do_io_destroy (tiz_event_loop_msg_t * ap_msg)
   if (p_ev_io->started)
     {
       /* The io watcher has been started, let's stop it */
-      ev_io_stop (gp_event_loop->p_loop, (ev_io *) (p_ev_io));
+      ev_io_stop (ap_lp->p_loop, (ev_io *) (p_ev_io));
     }
 
-  {
-    /* Now remove any references to this watcher that might be present in the
-       queue */
-    tiz_event_loop_msg_class_t class_to_be_deleted = ETIZEventLoopMsgIoAny;
-    tiz_pqueue_remove_func (gp_event_loop->p_pq, ev_io_msg_dequeue,
-                            (OMX_S32) class_to_be_deleted, p_ev_io);
-  }
+  /* Now remove any references to this watcher that might be present in the
+     queue */
+  dequeue_watcher_msgs (ap_lp, ev_io_msg_dequeue, ETIZEventLoopMsgIoAny,
+                        p_ev_io);
 
   /* And now it should be safe to delete the io event */
   tiz_mem_free (p_ev_io);
@@ -697,66 +1342,77 @@ do_io_destroy (tiz_event_loop_msg_t * ap_msg)
 }
 
 static OMX_ERRORTYPE
-do_timer_start (tiz_event_loop_msg_t * ap_msg)
+do_timer_start (tiz_event_loop_t * ap_lp, tiz_event_loop_msg_t * ap_msg)
 {
   tiz_event_loop_msg_timer_t * p_msg_timer = NULL;
   tiz_event_timer_t * p_ev_timer = NULL;
 
-  assert (gp_event_loop);
+  assert (ap_lp);
   assert (ap_msg);
-  assert (ETIZEventLoopStateStarted == gp_event_loop->state);
+  assert (ETIZEventLoopStateStarted == ap_lp->state
+          || ETIZEventLoopStateStopping == ap_lp->state);
 
   p_msg_timer = &(ap_msg->timer);
   assert (p_msg_timer);
   p_ev_timer = p_msg_timer->p_ev_timer;
   assert (p_ev_timer);
-  /* debug: Verify that ids don't get repeated */
-  if (p_ev_timer->id != 0 && p_ev_timer->id == p_msg_timer->id)
+  if (!is_requested (&(p_ev_timer->req)))
     {
-      assert (p_ev_timer->id != p_msg_timer->id);
+      /* A later stop request has superseded this one */
+      return OMX_ErrorNone;
+    }
+  __atomic_store_n (&(p_ev_timer->id), p_msg_timer->id, __ATOMIC_SEQ_CST);
+  if (!p_ev_timer->started)
+    {
+      p_ev_timer->started = true;
+      ev_timer_start (ap_lp->p_loop, (ev_timer *) (p_ev_timer));
     }
-  p_ev_timer->id = p_msg_timer->id;
-  p_ev_timer->started = true;
-  ev_timer_start (gp_event_loop->p_loop, (ev_timer *) (p_ev_timer));
 
   return OMX_ErrorNone;
 }
 
 static OMX_ERRORTYPE
-do_timer_restart (tiz_event_loop_msg_t * ap_msg)
+do_timer_restart (tiz_event_loop_t * ap_lp, tiz_event_loop_msg_t * ap_msg)
 {
   tiz_event_loop_msg_timer_t * p_msg_timer = NULL;
   tiz_event_timer_t * p_ev_timer = NULL;
 
-  assert (gp_event_loop);
+  assert (ap_lp);
   assert (ap_msg);
-  assert (ETIZEventLoopStateStarted == gp_event_loop->state);
+  assert (ETIZEventLoopStateStarted == ap_lp->state
+          || ETIZEventLoopStateStopping == ap_lp->state);
 
   p_msg_timer = &(ap_msg->timer);
   assert (p_msg_timer);
   p_ev_timer = p_msg_timer->p_ev_timer;
   assert (p_ev_timer);
-  /* debug: Verify that ids don't get repeated */
-  if (p_ev_timer->id != 0 && p_ev_timer->id == p_msg_timer->id)
+  __atomic_store_n (&(p_ev_timer->id), p_msg_timer->id, __ATOMIC_SEQ_CST);
+  if (is_requested (&(p_ev_timer->req)))
+    {
+      p_ev_timer->started = true;
+      ev_timer_again (ap_lp->p_loop, (ev_timer *) (p_ev_timer));
+    }
+  else if (p_ev_timer->started)
     {
-      assert (p_ev_timer->id != p_msg_timer->id);
+      /* Either a non-repeating timer (see ev_timer_again), or a later stop
+         request has superseded this one */
+      p_ev_timer->started = false;
+      ev_timer_stop (ap_lp->p_loop, (ev_timer *) (p_ev_timer));
     }
-  p_ev_timer->id = p_msg_timer->id;
-  p_ev_timer->started = true;
-  ev_timer_again (gp_event_loop->p_loop, (ev_timer *) (p_ev_timer));
 
   return OMX_ErrorNone;
 }
 
 static OMX_ERRORTYPE
-do_timer_stop (tiz_event_loop_msg_t * ap_msg)
+do_timer_stop (tiz_event_loop_t * ap_lp, tiz_event_loop_msg_t * ap_msg)
 {
   tiz_event_loop_msg_timer_t * p_msg_timer = NULL;
   tiz_event_timer_t * p_ev_timer = NULL;
 
-  assert (gp_event_loop);
+  assert (ap_lp);
   assert (ap_msg);
-  assert (ETIZEventLoopStateStarted == gp_event_loop->state);
+  assert (ETIZEventLoopStateStarted == ap_lp->state
+          || ETIZEventLoopStateStopping == ap_lp->state);
 
   p_msg_timer = &(ap_msg->timer);
   assert (p_msg_timer);
@@ -765,49 +1421,45 @@ do_timer_stop (tiz_event_loop_msg_t * ap_msg)
   if (p_ev_timer->started)
     {
       /* The timer watcher has been started, let's stop it */
-      ev_timer_stop (gp_event_loop->p_loop, (ev_timer *) (p_ev_timer));
+      ev_timer_stop (ap_lp->p_loop, (ev_timer *) (p_ev_timer));
       p_ev_timer->started = false;
     }
-  else
-    {
-      /* The timer watcher hasn't been started, let's make sure there are no
-         start
-         requests in the queue */
-      const tiz_event_loop_msg_class_t class_to_be_deleted
-        = ETIZEventLoopMsgTimerStart;
-      tiz_pqueue_remove_func (gp_event_loop->p_pq, ev_timer_msg_dequeue,
-                              (OMX_S32) class_to_be_deleted, p_ev_timer);
-    }
+  /* NOTE: Start requests still in the queue are not purged; they are
+     ignored when processed, as this stop has superseded them */
 
   return OMX_ErrorNone;
 }
 
 static OMX_ERRORTYPE
-do_timer_destroy (tiz_event_loop_msg_t * ap_msg)
+do_timer_destroy (tiz_event_loop_t * ap_lp, tiz_event_loop_msg_t * ap_msg)
 {
   tiz_event_loop_msg_timer_t * p_msg_timer = NULL;
   tiz_event_timer_t * p_ev_timer = NULL;
 
-  assert (gp_event_loop);
+  assert (ap_lp);
   assert (ap_msg);
-  assert (ETIZEventLoopStateStarted == gp_event_loop->state);
+  assert (ETIZEventLoopStateStarted == ap_lp->state
+          || ETIZEventLoopStateStopping == ap_lp->state);
 
   p_msg_timer = &(ap_msg->timer);
   assert (p_msg_timer);
   p_ev_timer = p_msg_timer->p_ev_timer;
   assert (p_ev_timer);
-  if (p_ev_timer->started)
+  if (p_ev_timer->p_wheel_timer)
+    {
+      tiz_twheel_timer_destroy (p_ev_timer->p_wheel_timer);
+      p_ev_timer->p_wheel_timer = NULL;
+      unlink_fired_timer (ap_lp, p_ev_timer);
+    }
+  else if (p_ev_timer->started)
     {
       /* The timer watcher has been started, let's stop it */
-      ev_timer_stop (gp_event_loop->p_loop, (ev_timer *) (p_ev_timer));
+      ev_timer_stop (ap_lp->p_loop, (ev_timer *) (p_ev_timer));
     }
-  {
-    /* Now remove any references to this watcher that might be present in the
-       queue */
-    tiz_event_loop_msg_class_t class_to_be_deleted = ETIZEventLoopMsgTimerAny;
-    tiz_pqueue_remove_func (gp_event_loop->p_pq, ev_timer_msg_dequeue,
-                            (OMX_S32) class_to_be_deleted, p_ev_timer);
-  }
+  /* Now remove any references to this watcher that might be present in the
+     queue */
+  dequeue_watcher_msgs (ap_lp, ev_timer_msg_dequeue, ETIZEventLoopMsgTimerAny,
+                        p_ev_timer);
 
   /* And now it should be safe to delete the timer event */
   tiz_mem_free (p_ev_timer);
@@ -817,45 +1469,45 @@ do_timer_destroy (tiz_event_loop_msg_t * ap_msg)
 }
 
 static OMX_ERRORTYPE
-do_stat_start (tiz_event_loop_msg_t * ap_msg)
+do_stat_start (tiz_event_loop_t * ap_lp, tiz_event_loop_msg_t * ap_msg)
 {
   tiz_event_loop_msg_stat_t * p_msg_stat = NULL;
   tiz_event_stat_t * p_ev_stat = NULL;
 
-  assert (gp_event_loop);
+  assert (ap_lp);
   assert (ap_msg);
-  assert (ETIZEventLoopStateStarted == gp_event_loop->state);
+  assert (ETIZEventLoopStateStarted == ap_lp->state
+          || ETIZEventLoopStateStopping == ap_lp->state);
 
   p_msg_stat = &(ap_msg->stat);
   assert (p_msg_stat);
   p_ev_stat = p_msg_stat->p_ev_stat;
   assert (p_ev_stat);
-  /* debug: Verify that ids don't get repeated */
-  if (p_ev_stat->id != 0 && p_ev_stat->id == p_msg_stat->id)
+  if (!is_requested (&(p_ev_stat->req)))
     {
-      assert (p_ev_stat->id != p_msg_stat->id);
+      /* A later stop request has superseded this one */
+      return OMX_ErrorNone;
     }
-  p_ev_stat->id = p_msg_stat->id;
-  /* debug: Verify that we are starting a watcher that was stopped */
-  if (p_ev_stat->started)
+  __atomic_store_n (&(p_ev_stat->id), p_msg_stat->id, __ATOMIC_SEQ_CST);
+  if (!p_ev_stat->started)
     {
-      assert (!p_ev_stat->started);
+      p_ev_stat->started = true;
+      ev_stat_start (ap_lp->p_loop, (ev_stat *) (p_ev_stat));
     }
-  p_ev_stat->started = true;
-  ev_stat_start (gp_event_loop->p_loop, (ev_stat *) (p_ev_stat));
 
   return OMX_ErrorNone;
 }
 
 static OMX_ERRORTYPE
-do_stat_stop (tiz_event_loop_msg_t * ap_msg)
+do_stat_stop (tiz_event_loop_t * ap_lp, tiz_event_loop_msg_t * ap_msg)
 {
   tiz_event_loop_msg_stat_t * p_msg_stat = NULL;
   tiz_event_stat_t * p_ev_stat = NULL;
 
-  assert (gp_event_loop);
+  assert (ap_lp);
   assert (ap_msg);
-  assert (ETIZEventLoopStateStarted == gp_event_loop->state);
+  assert (ETIZEventLoopStateStarted == ap_lp->state
+          || ETIZEventLoopStateStopping == ap_lp->state);
 
   p_msg_stat = &(ap_msg->stat);
   assert (p_msg_stat);
@@ -864,31 +1516,24 @@ do_stat_stop (tiz_event_loop_msg_t * ap_msg)
   if (p_ev_stat->started)
     {
       /* The stat watcher has been started, let's stop it */
-      ev_stat_stop (gp_event_loop->p_loop, (ev_stat *) (p_ev_stat));
+      ev_stat_stop (ap_lp->p_loop, (ev_stat *) (p_ev_stat));
       p_ev_stat->started = false;
     }
-  else
-    {
-      /* The stat watcher hasn't been started, let's make sure there are no
-         start
-         requests in the queue */
-      const tiz_event_loop_msg_class_t class_to_be_deleted
-        = ETIZEventLoopMsgStatStart;
-      tiz_pqueue_remove_func (gp_event_loop->p_pq, ev_stat_msg_dequeue,
-                              (OMX_S32) class_to_be_deleted, p_ev_stat);
-    }
+  /* NOTE: Start requests still in the queue are not purged; they are
+     ignored when processed, as this stop has superseded them */
   return OMX_ErrorNone;
 }
 
 static OMX_ERRORTYPE
-do_stat_destroy (tiz_event_loop_msg_t * ap_msg)
+do_stat_destroy (tiz_event_loop_t * ap_lp, tiz_event_loop_msg_t * ap_msg)
 {
   tiz_event_loop_msg_stat_t * p_msg_stat = NULL;
   tiz_event_stat_t * p_ev_stat = NULL;
 
-  assert (gp_event_loop);
+  assert (ap_lp);
   assert (ap_msg);
-  assert (ETIZEventLoopStateStarted == gp_event_loop->state);
+  assert (ETIZEventLoopStateStarted == ap_lp->state
+          || ETIZEventLoopStateStopping == ap_lp->state);
 
   p_msg_stat = &(ap_msg->stat);
   assert (p_msg_stat);
@@ -897,16 +1542,13 @@ do_stat_destroy (tiz_event_loop_msg_t * ap_msg)
   if (p_ev_stat->started)
     {
       /* The stat watcher has been started, let's stop it */
-      ev_stat_stop (gp_event_loop->p_loop, (ev_stat *) (p_ev_stat));
+      ev_stat_stop (ap_lp->p_loop, (ev_stat *) (p_ev_stat));
     }
 
-  {
-    /* Now remove any references to this watcher that might be present in the
-       queue */
-    tiz_event_loop_msg_class_t class_to_be_deleted = ETIZEventLoopMsgStatAny;
-    tiz_pqueue_remove_func (gp_event_loop->p_pq, ev_stat_msg_dequeue,
-                            (OMX_S32) class_to_be_deleted, p_ev_stat);
-  }
+  /* Now remove any references to this watcher that might be present in the
+     queue */
+  dequeue_watcher_msgs (ap_lp, ev_stat_msg_dequeue, ETIZEventLoopMsgStatAny,
+                        p_ev_stat);
 
   /* And now it should be safe to delete the stat event */
   tiz_mem_free (p_msg_stat->p_ev_stat);
@@ -915,95 +1557,668 @@ do_stat_destroy (tiz_event_loop_msg_t * ap_msg)
 }
 
 static void
-async_watcher_cback (struct ev_loop * ap_loop, ev_async * ap_watcher,
+append_aio (tiz_event_loop_t * ap_lp, tiz_event_aio_t * ap_ev_aio)
+{
+  if (!ap_ev_aio->listed)
+    {
+      ap_ev_aio->p_next = NULL;
+      if (ap_lp->p_aio_tail)
+        {
+          ap_lp->p_aio_tail->p_next = ap_ev_aio;
+        }
+      else
+        {
+          ap_lp->p_aio_head = ap_ev_aio;
+        }
+      ap_lp->p_aio_tail = ap_ev_aio;
+      ap_ev_aio->listed = true;
+    }
+}
+
+static tiz_event_aio_t *
+pop_aio (tiz_event_loop_t * ap_lp)
+{
+  tiz_event_aio_t * p_ev_aio = ap_lp->p_aio_head;
+  if (p_ev_aio)
+    {
+      ap_lp->p_aio_head = p_ev_aio->p_next;
+      if (!ap_lp->p_aio_head)
+        {
+          ap_lp->p_aio_tail = NULL;
+        }
+      p_ev_aio->p_next = NULL;
+      p_ev_aio->listed = false;
+    }
+  return p_ev_aio;
+}
+
+#ifdef HAVE_LIBURING
+/* Called with the loop's mutex held */
+static void
+submit_uring (tiz_event_loop_t * ap_lp)
+{
+  if (ap_lp->uring_pending > 0)
+    {
+      const int ret = io_uring_submit (&(ap_lp->ring));
+      if (ret < 0)
+        {
+          TIZ_LOG (TIZ_PRIORITY_ERROR, "[%s] io_uring_submit failed [%s]",
+                   ap_lp->name, strerror (-ret));
+        }
+      ap_lp->uring_pending = 0;
+    }
+}
+
+/* Called with the loop's mutex held */
+static struct io_uring_sqe *
+get_uring_sqe (tiz_event_loop_t * ap_lp)
+{
+  struct io_uring_sqe * p_sqe = io_uring_get_sqe (&(ap_lp->ring));
+  if (!p_sqe)
+    {
+      /* The submission queue is full; make room */
+      submit_uring (ap_lp);
+      p_sqe = io_uring_get_sqe (&(ap_lp->ring));
+    }
+  return p_sqe;
+}
+
+/* Called with the loop's mutex held */
+static OMX_ERRORTYPE
+queue_uring_aio (tiz_event_loop_t * ap_lp, tiz_event_aio_t * ap_ev_aio)
+{
+  struct io_uring_sqe * p_sqe = get_uring_sqe (ap_lp);
+  /* -1 means the current file position (IORING_FEAT_RW_CUR_POS) */
+  const uint64_t offset
+    = ap_ev_aio->offset < 0 ? (uint64_t) -1 : (uint64_t) ap_ev_aio->offset;
+
+  if (!p_sqe)
+    {
+      return OMX_ErrorInsufficientResources;
+    }
+
+  switch (ap_ev_aio->op)
+    {
+      case TIZ_EVENT_AIO_READ:
+        {
+          io_uring_prep_read (p_sqe, ap_ev_aio->fd, ap_ev_aio->p_buf,
+                              ap_ev_aio->len, offset);
+        }
+        break;
+      case TIZ_EVENT_AIO_WRITE:
+        {
+          io_uring_prep_write (p_sqe, ap_ev_aio->fd, ap_ev_aio->p_buf,
+                               ap_ev_aio->len, offset);
+        }
+        break;
+      case TIZ_EVENT_AIO_RECV:
+        {
+          io_uring_prep_recv (p_sqe, ap_ev_aio->fd, ap_ev_aio->p_buf,
+                              ap_ev_aio->len, 0);
+        }
+        break;
+      case TIZ_EVENT_AIO_SEND:
+        {
+          io_uring_prep_send (p_sqe, ap_ev_aio->fd, ap_ev_aio->p_buf,
+                              ap_ev_aio->len, MSG_NOSIGNAL);
+        }
+        break;
+      default:
+        {
+          assert (0);
+        }
+        break;
+    };
+
+  io_uring_sqe_set_data (p_sqe, ap_ev_aio);
+  ap_ev_aio->state = ETIZEventAioStateInFlight;
+  ap_lp->uring_pending++;
+  ap_lp->uring_inflight++;
+
+  if (!(tp_event_loop == ap_lp && ap_lp->uring_reaping))
+    {
+      submit_uring (ap_lp);
+    }
+
+  return OMX_ErrorNone;
+}
+#endif
+
+/* Called from the loop's thread, with the loop's mutex held. The request is
+   freed, unless it still has to be removed from the aio list, or cancelled */
+static void
+release_aio (tiz_event_loop_t * ap_lp, tiz_event_aio_t * ap_ev_aio)
+{
+  assert (ap_ev_aio->destroyed);
+
+  if (ap_ev_aio->listed)
+    {
+      return;
+    }
+
+  switch (ap_ev_aio->state)
+    {
+      case ETIZEventAioStateWaiting:
+        {
+          ev_io_stop (ap_lp->p_loop, &(ap_ev_aio->io));
+          tiz_mem_free (ap_ev_aio);
+        }
+        break;
+#ifdef HAVE_LIBURING
+      case ETIZEventAioStateInFlight:
+        {
+          /* Freed once the ring is done with it */
+          struct io_uring_sqe * p_sqe = get_uring_sqe (ap_lp);
+          if (p_sqe)
+            {
+              io_uring_prep_cancel (p_sqe, ap_ev_aio, 0);
+              io_uring_sqe_set_data (p_sqe, NULL);
+              ap_lp->uring_pending++;
+              if (!ap_lp->uring_reaping)
+                {
+                  submit_uring (ap_lp);
+                }
+            }
+        }
+        break;
+#endif
+      default:
+        {
+          tiz_mem_free (ap_ev_aio);
+        }
+        break;
+    };
+}
+
+static ssize_t
+perform_aio (tiz_event_aio_t * ap_ev_aio)
+{
+  ssize_t result = -1;
+  void * p_buf = ap_ev_aio->p_buf;
+  const size_t len = ap_ev_aio->len;
+  const int fd = ap_ev_aio->fd;
+
+  do
+    {
+      switch (ap_ev_aio->op)
+        {
+          case TIZ_EVENT_AIO_READ:
+            {
+              result = ap_ev_aio->offset < 0
+                         ? read (fd, p_buf, len)
+                         : pread (fd, p_buf, len, ap_ev_aio->offset);
+            }
+            break;
+          case TIZ_EVENT_AIO_WRITE:
+            {
+              result = ap_ev_aio->offset < 0
+                         ? write (fd, p_buf, len)
+                         : pwrite (fd, p_buf, len, ap_ev_aio->offset);
+            }
+            break;
+          case TIZ_EVENT_AIO_RECV:
+            {
+              result = recv (fd, p_buf, len, MSG_DONTWAIT);
+            }
+            break;
+          case TIZ_EVENT_AIO_SEND:
+            {
+              result = send (fd, p_buf, len, MSG_DONTWAIT | MSG_NOSIGNAL);
+            }
+            break;
+          default:
+            {
+              assert (0);
+            }
+            break;
+        };
+    }
+  while (result < 0 && EINTR == errno);
+
+  return result < 0 ? -errno : result;
+}
+
+static void
+notify_aio (tiz_event_aio_t * ap_ev_aio, const ssize_t a_result)
+{
+  /* The callback may destroy the request; keep what the tracer needs */
+  void * p_arg0 = ap_ev_aio->p_arg0;
+  const int fd = ap_ev_aio->fd;
+  const OMX_U64 start = tiz_tracer_enabled () ? tiz_monotonic_ns () : 0;
+
+  assert (ap_ev_aio->pf_cback);
+  ap_ev_aio->pf_cback (p_arg0, ap_ev_aio, ap_ev_aio->p_arg1, ap_ev_aio->id,
+                       a_result);
+  if (start)
+    {
+      tiz_tracer_complete ("event", "aio completion", start,
+                           (uintptr_t) p_arg0, fd);
+    }
+}
+
+/* Called from the loop's thread, with the loop's mutex held; the callback is
+   called without it. The request must not be used after this returns */
+static void
+complete_aio (tiz_event_loop_t * ap_lp, tiz_event_aio_t * ap_ev_aio,
+              const ssize_t a_result)
+{
+  if (ap_ev_aio->destroyed)
+    {
+      /* No callback; the request is released from the aio list */
+      ap_ev_aio->state = ETIZEventAioStateIdle;
+      release_aio (ap_lp, ap_ev_aio);
+    }
+  else if (-EAGAIN == a_result)
+    {
+      ev_io_set (&(ap_ev_aio->io), ap_ev_aio->fd,
+                 (TIZ_EVENT_AIO_READ == ap_ev_aio->op
+                  || TIZ_EVENT_AIO_RECV == ap_ev_aio->op)
+                   ? EV_READ
+                   : EV_WRITE);
+      ev_io_start (ap_lp->p_loop, &(ap_ev_aio->io));
+      ap_ev_aio->state = ETIZEventAioStateWaiting;
+    }
+  else
+    {
+      ap_ev_aio->state = ETIZEventAioStateIdle;
+      (void) tiz_mutex_unlock (&(ap_lp->mutex));
+      notify_aio (ap_ev_aio, a_result);
+      (void) tiz_mutex_lock (&(ap_lp->mutex));
+    }
+}
+
+/* Called from the loop's thread, with the loop's mutex held */
+static void
+run_aio (tiz_event_loop_t * ap_lp, tiz_event_aio_t * ap_ev_aio)
+{
+  ssize_t result = 0;
+
+  /* The request can only be destroyed meanwhile, which just flags it */
+  (void) tiz_mutex_unlock (&(ap_lp->mutex));
+  result = perform_aio (ap_ev_aio);
+  (void) tiz_mutex_lock (&(ap_lp->mutex));
+  complete_aio (ap_lp, ap_ev_aio, result);
+}
+
+/* Called from the loop's thread, with the loop's mutex held */
+static void
+process_aio_list (tiz_event_loop_t * ap_lp)
+{
+  /* The requests submitted again from their callbacks are left for the next
+     wakeup, so that a busy descriptor can't starve the other watchers */
+  tiz_event_aio_t * p_last = ap_lp->p_aio_tail;
+  tiz_event_aio_t * p_ev_aio = NULL;
+  bool last = (NULL == p_last);
+
+  while (!last && (p_ev_aio = pop_aio (ap_lp)))
+    {
+      last = (p_ev_aio == p_last);
+      if (p_ev_aio->destroyed)
+        {
+          release_aio (ap_lp, p_ev_aio);
+        }
+      else if (ETIZEventAioStateQueued == p_ev_aio->state)
+        {
+          run_aio (ap_lp, p_ev_aio);
+        }
+    }
+}
+
+static void
+aio_watcher_cback (struct ev_loop * ap_loop, ev_io * ap_watcher, int a_revents)
+{
+  tiz_event_aio_t * p_ev_aio = (tiz_event_aio_t *) ap_watcher;
+  tiz_event_loop_t * p_lp = p_ev_aio->p_lp;
+  (void) a_revents;
+
+  (void) tiz_mutex_lock (&(p_lp->mutex));
+  ev_io_stop (ap_loop, ap_watcher);
+  if (p_ev_aio->destroyed)
+    {
+      /* Released from the aio list */
+      p_ev_aio->state = ETIZEventAioStateIdle;
+    }
+  else
+    {
+      run_aio (p_lp, p_ev_aio);
+    }
+  (void) tiz_mutex_unlock (&(p_lp->mutex));
+}
+
+#ifdef HAVE_LIBURING
+static void
+uring_watcher_cback (struct ev_loop * ap_loop, ev_io * ap_watcher,
                      int a_revents)
 {
+  tiz_event_loop_t * p_lp = ap_watcher->data;
+  struct io_uring_cqe * p_cqe = NULL;
   (void) ap_loop;
-  (void) ap_watcher;
   (void) a_revents;
 
-  if (gp_event_loop)
+  assert (p_lp);
+
+  (void) tiz_mutex_lock (&(p_lp->mutex));
+  p_lp->uring_reaping = true;
+  while (0 == io_uring_peek_cqe (&(p_lp->ring), &p_cqe))
     {
-      if (ETIZEventLoopStateStopping == gp_event_loop->state)
+      tiz_event_aio_t * p_ev_aio = io_uring_cqe_get_data (p_cqe);
+      const ssize_t result = p_cqe->res;
+      io_uring_cqe_seen (&(p_lp->ring), p_cqe);
+      /* Cancellations carry no request */
+      if (p_ev_aio)
         {
-          ev_break (gp_event_loop->p_loop, EVBREAK_ONE);
+          p_lp->uring_inflight--;
+          complete_aio (p_lp, p_ev_aio, result);
         }
-      else if (ETIZEventLoopStateStarted == gp_event_loop->state)
+    }
+  p_lp->uring_reaping = false;
+  /* All the requests submitted from the callbacks, in one go */
+  submit_uring (p_lp);
+  (void) tiz_mutex_unlock (&(p_lp->mutex));
+}
+
+/* Called once the loop's thread is gone. The ring must not be torn down
+   while the kernel may still write to the requests' buffers, so whatever is
+   still in flight is cancelled and its completion waited for. Requests
+   destroyed meanwhile are freed; the others are just left idle, without a
+   callback */
+static void
+drain_uring (tiz_event_loop_t * ap_lp)
+{
+  struct io_uring_cqe * p_cqe = NULL;
+  int tries = 0;
+
+  if (ap_lp->uring_inflight > 0)
+    {
+      struct io_uring_sqe * p_sqe = get_uring_sqe (ap_lp);
+      if (p_sqe)
         {
-          void * p_msg = NULL;
+          io_uring_prep_cancel (p_sqe, NULL, IORING_ASYNC_CANCEL_ANY);
+          io_uring_sqe_set_data (p_sqe, NULL);
+          ap_lp->uring_pending++;
+        }
+    }
+  submit_uring (ap_lp);
 
-          /* Process all items from the queue */
-          (void) tiz_mutex_lock (&(gp_event_loop->mutex));
-          while (0 < tiz_pqueue_length (gp_event_loop->p_pq))
+  while (ap_lp->uring_inflight > 0 && tries < TIZ_EVENT_URING_DRAIN_TRIES)
+    {
+      if (0 == io_uring_peek_cqe (&(ap_lp->ring), &p_cqe))
+        {
+          tiz_event_aio_t * p_ev_aio = io_uring_cqe_get_data (p_cqe);
+          io_uring_cqe_seen (&(ap_lp->ring), p_cqe);
+          if (p_ev_aio)
             {
-              if (OMX_ErrorNone
-                  != tiz_pqueue_receive (gp_event_loop->p_pq, &p_msg))
+              ap_lp->uring_inflight--;
+              p_ev_aio->state = ETIZEventAioStateIdle;
+              if (p_ev_aio->destroyed && !p_ev_aio->listed)
                 {
-                  break;
+                  tiz_mem_free (p_ev_aio);
                 }
-              /* Process the message */
-              dispatch_msg (p_msg);
-              /* Delete the message */
-              tiz_soa_free (gp_event_loop->p_soa, p_msg);
             }
-          (void) tiz_mutex_unlock (&(gp_event_loop->mutex));
         }
+      else
+        {
+          const struct timespec wait = {0, 1000000};
+          (void) nanosleep (&wait, NULL);
+          tries++;
+        }
+    }
+
+  if (ap_lp->uring_inflight > 0)
+    {
+      /* Better leaked than written to after being freed */
+      TIZ_LOG (TIZ_PRIORITY_ERROR,
+               "[%s] %u async io requests still in flight; leaking them",
+               ap_lp->name, (unsigned int) ap_lp->uring_inflight);
+    }
+}
+
+static void
+init_uring (tiz_event_loop_t * ap_lp)
+{
+  const int ret
+    = io_uring_queue_init (TIZ_EVENT_URING_ENTRIES, &(ap_lp->ring), 0);
+
+  if (0 != ret)
+    {
+      TIZ_LOG (TIZ_PRIORITY_NOTICE,
+               "[%s] io_uring unavailable [%s]; serving async io requests "
+               "from the loop",
+               ap_lp->name, strerror (-ret));
+    }
+  else if (!(ap_lp->ring.features & IORING_FEAT_RW_CUR_POS))
+    {
+      TIZ_LOG (TIZ_PRIORITY_NOTICE,
+               "[%s] io_uring too old; serving async io requests from the "
+               "loop",
+               ap_lp->name);
+      io_uring_queue_exit (&(ap_lp->ring));
+    }
+  else
+    {
+      ap_lp->uring = true;
+      ev_io_init (&(ap_lp->uring_watcher), uring_watcher_cback,
+                  ap_lp->ring.ring_fd, EV_READ);
+      ap_lp->uring_watcher.data = ap_lp;
+      ev_io_start (ap_lp->p_loop, &(ap_lp->uring_watcher));
+    }
+}
+#endif
+
+static void
+async_watcher_cback (struct ev_loop * ap_loop, ev_async * ap_watcher,
+                     int a_revents)
+{
+  tiz_event_loop_t * p_lp = ap_watcher->data;
+  (void) a_revents;
+
+  assert (p_lp);
+
+  /* NOTE: The queue is also drained when the loop is stopping, so that
+     watchers destroyed just before the loop are released */
+  if (ETIZEventLoopStateStarted == p_lp->state
+      || ETIZEventLoopStateStopping == p_lp->state)
+    {
+      const OMX_U64 start = tiz_tracer_enabled () ? tiz_monotonic_ns () : 0;
+      void * p_msg = NULL;
+      OMX_U32 nmsgs = 0;
+
+      /* Process all items from the rings and the queue */
+      (void) tiz_mutex_lock (&(p_lp->mutex));
+      drain_rings (p_lp);
+      while (0 < tiz_pqueue_length (p_lp->p_pq))
+        {
+          int * p_npending = NULL;
+          if (OMX_ErrorNone != tiz_pqueue_receive (p_lp->p_pq, &p_msg))
+            {
+              break;
+            }
+          /* The watcher is gone after a destroy request */
+          p_npending = msg_npending (p_msg);
+          if (is_destroy_msg (p_msg))
+            {
+              __atomic_sub_fetch (p_npending, 1, __ATOMIC_SEQ_CST);
+              p_npending = NULL;
+            }
+          /* Process the message */
+          dispatch_msg (p_lp, p_msg);
+          if (p_npending)
+            {
+              __atomic_sub_fetch (p_npending, 1, __ATOMIC_SEQ_CST);
+            }
+          /* Delete the message */
+          tiz_soa_free (p_lp->p_soa, p_msg);
+          nmsgs++;
+        }
+      if (p_lp->wheel_rearm)
+        {
+          arm_wheel_watcher (p_lp);
+        }
+      process_aio_list (p_lp);
+      (void) tiz_mutex_unlock (&(p_lp->mutex));
+
+      if (start)
+        {
+          tiz_tracer_complete ("event", "async wakeup", start, p_lp->shard,
+                               nmsgs);
+        }
+    }
+
+  if (ETIZEventLoopStateStopping == p_lp->state)
+    {
+      ev_break (ap_loop, EVBREAK_ONE);
+    }
+}
+
+static void
+io_watcher_cback (struct ev_loop * ap_loop, ev_io * ap_watcher, int a_revents)
+{
+  tiz_event_io_t * p_io_event = (tiz_event_io_t *) ap_watcher;
+  /* The callback may destroy the watcher; keep what the tracer needs */
+  void * p_arg0 = p_io_event->p_arg0;
+  const int fd = ap_watcher->fd;
+  const OMX_U64 start = tiz_tracer_enabled () ? tiz_monotonic_ns () : 0;
+
+  assert (p_io_event);
+  assert (p_io_event->pf_cback);
+
+  if (p_io_event->once)
+    {
+      p_io_event->started = false;
+      ev_io_stop (ap_loop, ap_watcher);
+    }
+  p_io_event->pf_cback (p_arg0, p_io_event, p_io_event->p_arg1,
+                        p_io_event->id, fd, a_revents);
+  if (start)
+    {
+      tiz_tracer_complete ("event", "io wakeup", start, (uintptr_t) p_arg0,
+                           fd);
+    }
+}
+
+/* The callback and its arguments are passed in, as wheel timers may be
+   restarted by other threads as soon as the loop's mutex is released */
+static void
+notify_timer (tiz_event_timer_t * ap_timer_event,
+              tiz_event_timer_cb_f apf_cback, void * ap_arg0, void * ap_arg1,
+              const uint32_t a_id)
+{
+  const OMX_U64 start = tiz_tracer_enabled () ? tiz_monotonic_ns () : 0;
+
+  assert (apf_cback);
+  apf_cback (ap_arg0, ap_timer_event, ap_arg1, a_id);
+  if (start)
+    {
+      tiz_tracer_complete ("event", "timer wakeup", start, (uintptr_t) ap_arg0,
+                           0);
     }
 }
 
 static void
-io_watcher_cback (struct ev_loop * ap_loop, ev_io * ap_watcher, int a_revents)
+timer_watcher_cback (struct ev_loop * ap_loop, ev_timer * ap_watcher,
+                     int a_revents)
 {
-  tiz_event_io_t * p_io_event = (tiz_event_io_t *) ap_watcher;
-  (void) ap_loop;
+  tiz_event_timer_t * p_timer_event = (tiz_event_timer_t *) ap_watcher;
+  (void) a_revents;
 
-  if (gp_event_loop)
+  assert (p_timer_event);
+  if (!ev_is_active (ap_watcher))
     {
-      assert (p_io_event);
-      assert (p_io_event->pf_cback);
+      /* A non-repeating timer stops by itself */
+      p_timer_event->started = false;
+    }
+  notify_timer (p_timer_event, p_timer_event->pf_cback, p_timer_event->p_arg0,
+                p_timer_event->p_arg1, p_timer_event->id);
+}
+
+/* Called from tiz_twheel_advance, with the loop's mutex held */
+static void
+wheel_timer_cback (void * ap_arg, tiz_twheel_timer_t * ap_wheel_timer)
+{
+  tiz_event_timer_t * p_timer_event = ap_arg;
+  tiz_event_loop_t * p_lp = NULL;
 
-      if (p_io_event->once)
+  assert (p_timer_event);
+  assert (!p_timer_event->fired);
+  p_lp = p_timer_event->p_lp;
+
+  if (p_timer_event->once)
+    {
+      p_timer_event->started = false;
+    }
+  else
+    {
+      const OMX_U64 now_ns = tiz_monotonic_ns ();
+      p_timer_event->due_ns += p_timer_event->repeat_ns;
+      if (p_timer_event->due_ns <= now_ns)
         {
-          p_io_event->started = false;
-          ev_io_stop (gp_event_loop->p_loop, (ev_io *) p_io_event);
+          p_timer_event->due_ns = now_ns + p_timer_event->repeat_ns;
         }
-      p_io_event->pf_cback (p_io_event->p_arg0, p_io_event, p_io_event->p_arg1,
-                            p_io_event->id, ((ev_io *) p_io_event)->fd,
-                            a_revents);
+      (void) tiz_twheel_timer_start (ap_wheel_timer, p_timer_event->due_ns,
+                                     p_timer_event->slack_ns);
+    }
+
+  /* The callback is delivered once the wheel is done */
+  p_timer_event->fired = true;
+  p_timer_event->p_next_fired = NULL;
+  if (p_lp->p_fired_tail)
+    {
+      p_lp->p_fired_tail->p_next_fired = p_timer_event;
     }
+  else
+    {
+      p_lp->p_fired_head = p_timer_event;
+    }
+  p_lp->p_fired_tail = p_timer_event;
 }
 
 static void
-timer_watcher_cback (struct ev_loop * ap_loop, ev_timer * ap_watcher,
+wheel_watcher_cback (struct ev_loop * ap_loop, ev_timer * ap_watcher,
                      int a_revents)
 {
+  tiz_event_loop_t * p_lp = ap_watcher->data;
   (void) ap_loop;
   (void) a_revents;
 
-  if (gp_event_loop)
+  assert (p_lp);
+
+  (void) tiz_mutex_lock (&(p_lp->mutex));
+  (void) tiz_twheel_advance (p_lp->p_wheel, tiz_monotonic_ns ());
+  /* The callbacks run without the mutex, and may start, stop or destroy
+     any timer, so the list is re-checked after each one */
+  while (p_lp->p_fired_head)
     {
-      tiz_event_timer_t * p_timer_event = (tiz_event_timer_t *) ap_watcher;
-      assert (p_timer_event);
-      assert (p_timer_event->pf_cback);
-      p_timer_event->pf_cback (p_timer_event->p_arg0, p_timer_event,
-                               p_timer_event->p_arg1, p_timer_event->id);
+      tiz_event_timer_t * p_timer_event = p_lp->p_fired_head;
+      const tiz_event_timer_cb_f pf_cback = p_timer_event->pf_cback;
+      void * p_arg0 = p_timer_event->p_arg0;
+      void * p_arg1 = p_timer_event->p_arg1;
+      const uint32_t id = p_timer_event->id;
+      unlink_fired_timer (p_lp, p_timer_event);
+      (void) tiz_mutex_unlock (&(p_lp->mutex));
+      notify_timer (p_timer_event, pf_cback, p_arg0, p_arg1, id);
+      (void) tiz_mutex_lock (&(p_lp->mutex));
     }
+  arm_wheel_watcher (p_lp);
+  (void) tiz_mutex_unlock (&(p_lp->mutex));
 }
 
 static void
 stat_watcher_cback (struct ev_loop * ap_loop, ev_stat * ap_watcher,
                     int a_revents)
 {
+  tiz_event_stat_t * p_stat_event = (tiz_event_stat_t *) ap_watcher;
+  void * p_arg0 = p_stat_event->p_arg0;
+  const OMX_U64 start = tiz_tracer_enabled () ? tiz_monotonic_ns () : 0;
   (void) ap_loop;
 
-  if (gp_event_loop)
+  assert (p_stat_event);
+  assert (p_stat_event->pf_cback);
+  p_stat_event->pf_cback (p_arg0, p_stat_event, p_stat_event->p_arg1,
+                          p_stat_event->id, a_revents);
+  if (start)
     {
-      tiz_event_stat_t * p_stat_event = (tiz_event_stat_t *) ap_watcher;
-      assert (p_stat_event);
-      assert (p_stat_event->pf_cback);
-      p_stat_event->pf_cback (p_stat_event->p_arg0, p_stat_event,
-                              p_stat_event->p_arg1, p_stat_event->id,
-                              a_revents);
+      tiz_tracer_complete ("event", "stat wakeup", start, (uintptr_t) p_arg0,
+                           0);
     }
 }
 
@@ -1019,15 +2234,20 @@ event_loop_thread_func (void * p_arg)
   assert (p_loop);
 
   (void) tiz_thread_setname (&(p_event_loop->thread),
-                             (const OMX_STRING) TIZ_EVENT_LOOP_THREAD_NAME);
+                             (const OMX_STRING) p_event_loop->name);
+  tp_event_loop = p_event_loop;
 
-  TIZ_LOG (TIZ_PRIORITY_TRACE, "Entering the dispatcher...");
+  TIZ_LOG (TIZ_PRIORITY_TRACE, "[%s] Entering the dispatcher...",
+           p_event_loop->name);
   tiz_sem_post (&(p_event_loop->sem));
 
   ev_run (p_loop, 0);
 
-  TIZ_LOG (TIZ_PRIORITY_TRACE, "Have left the dispatcher, thread exiting...");
+  TIZ_LOG (TIZ_PRIORITY_TRACE,
+           "[%s] Have left the dispatcher, thread exiting...",
+           p_event_loop->name);
 
+  tp_event_loop = NULL;
   return NULL;
 }
 
@@ -1048,6 +2268,30 @@ clean_up_thread_data (tiz_event_loop_t * ap_lp)
           ap_lp->p_loop = NULL;
         }
 
+      if (ap_lp->p_wheel)
+        {
+          tiz_twheel_destroy (ap_lp->p_wheel);
+          ap_lp->p_wheel = NULL;
+        }
+
+#ifdef HAVE_LIBURING
+      if (ap_lp->uring)
+        {
+          drain_uring (ap_lp);
+          io_uring_queue_exit (&(ap_lp->ring));
+          ap_lp->uring = false;
+        }
+#endif
+
+      while (ap_lp->p_rings)
+        {
+          tiz_event_ring_t * p_ring = ap_lp->p_rings;
+          ap_lp->p_rings = p_ring->p_next;
+          /* The producer thread must not use this ring again */
+          __atomic_store_n (&(p_ring->p_lp), NULL, __ATOMIC_RELEASE);
+          release_ring (p_ring);
+        }
+
       if (ap_lp->mutex)
         {
           (void) tiz_mutex_destroy (&(ap_lp->mutex));
@@ -1062,6 +2306,13 @@ clean_up_thread_data (tiz_event_loop_t * ap_lp)
 
       if (ap_lp->p_pq)
         {
+          void * p_msg = NULL;
+          /* Requests that arrived after the loop stopped are discarded */
+          while (0 < tiz_pqueue_length (ap_lp->p_pq)
+                 && OMX_ErrorNone == tiz_pqueue_receive (ap_lp->p_pq, &p_msg))
+            {
+              tiz_soa_free (ap_lp->p_soa, p_msg);
+            }
           tiz_pqueue_destroy (ap_lp->p_pq);
           ap_lp->p_pq = NULL;
         }
@@ -1072,100 +2323,147 @@ clean_up_thread_data (tiz_event_loop_t * ap_lp)
           ap_lp->p_soa = NULL;
         }
 
-      tiz_mem_free (gp_event_loop);
-      gp_event_loop = NULL;
+      tiz_mem_free (ap_lp);
     }
 }
 
 static void
 child_event_loop_reset (void)
 {
-  /* Reset the once control */
+  /* Reset the once controls */
   pthread_once_t once = PTHREAD_ONCE_INIT;
   memcpy (&g_event_loop_once, &once, sizeof (g_event_loop_once));
+  memcpy (&g_event_shards_once, &once, sizeof (g_event_shards_once));
   gp_event_loop = NULL;
+  memset (g_event_shards.loops, 0, sizeof (g_event_shards.loops));
+  g_event_shards.nloops = 0;
 }
 
-static void
-init_event_loop_thread (void)
+static tiz_event_loop_t *
+start_event_loop (const OMX_U32 a_shard)
 {
-  OMX_ERRORTYPE rc = OMX_ErrorNone;
-
-  if (!gp_event_loop)
-    {
-      /* Let's return OOM error if something goes wrong */
-      rc = OMX_ErrorInsufficientResources;
-
-      /* Register a handler to reset the pthread_once_t global variable to try
-         to cope with the scenario of a process forking without exec. The idea
-         is to make sure that the loop thread is re-created in the child
-         process */
-      pthread_atfork (NULL, NULL, child_event_loop_reset);
-
-      tiz_goto_end_on_null (
-        (gp_event_loop
-         = (tiz_event_loop_t *) tiz_mem_calloc (1, sizeof (tiz_event_loop_t))),
-        "Error allocating thread data struct.");
+  OMX_ERRORTYPE rc = OMX_ErrorInsufficientResources;
+  tiz_event_loop_t * p_lp = NULL;
 
-      gp_event_loop->state = ETIZEventLoopStateStarting;
+  tiz_goto_end_on_null ((p_lp = tiz_mem_calloc (1, sizeof (tiz_event_loop_t))),
+                        "Error allocating thread data struct.");
 
-      tiz_goto_end_on_omx_err (tiz_rcfile_init (&(gp_event_loop->p_rcfile)),
-                           "Error opening configuration file.");
+  p_lp->state = ETIZEventLoopStateStarting;
+  p_lp->shard = a_shard;
+  if (0 == a_shard)
+    {
+      (void) snprintf (p_lp->name, sizeof (p_lp->name), "%s",
+                       TIZ_EVENT_LOOP_THREAD_NAME);
+    }
+  else
+    {
+      (void) snprintf (p_lp->name, sizeof (p_lp->name), "%s%u",
+                       TIZ_EVENT_LOOP_THREAD_NAME, (unsigned int) a_shard);
+    }
 
-      tiz_goto_end_on_null ((gp_event_loop->p_loop = ev_loop_new (EVFLAG_AUTO)),
-                            "Error instantiating ev_loop.");
+  tiz_goto_end_on_null ((p_lp->p_loop = ev_loop_new (EVFLAG_AUTO)),
+                        "Error instantiating ev_loop.");
 
-      tiz_goto_end_on_null ((gp_event_loop->p_async_watcher
-                            = (ev_async *) tiz_mem_calloc (1, sizeof (ev_async))),
-                           "Error initializing async watcher.");
+  tiz_goto_end_on_null ((p_lp->p_async_watcher
+                         = (ev_async *) tiz_mem_calloc (1, sizeof (ev_async))),
+                        "Error initializing async watcher.");
 
-      tiz_goto_end_on_omx_err (tiz_mutex_init (&(gp_event_loop->mutex)),
+  tiz_goto_end_on_omx_err (tiz_mutex_init (&(p_lp->mutex)),
                            "Error initializing mutex.");
 
-      tiz_goto_end_on_omx_err (tiz_sem_init (&(gp_event_loop->sem), 0),
+  tiz_goto_end_on_omx_err (tiz_sem_init (&(p_lp->sem), 0),
                            "Error initializing sem.");
 
-      /* Init the small object allocator */
-      tiz_goto_end_on_omx_err (tiz_soa_init (&(gp_event_loop->p_soa)),
+  /* Init the small object allocator */
+  tiz_goto_end_on_omx_err (tiz_soa_init (&(p_lp->p_soa)),
                            "Error initializing the small object allocator.");
 
-      /* Init the priority queue */
-      tiz_goto_end_on_omx_err (
-        tiz_pqueue_init (&gp_event_loop->p_pq, 2, &pqueue_cmp,
-                         gp_event_loop->p_soa, TIZ_EVENT_LOOP_THREAD_NAME),
-        "Error initializing pqueue.");
+  /* Init the priority queue */
+  tiz_goto_end_on_omx_err (tiz_pqueue_init (&p_lp->p_pq, 2, &pqueue_cmp,
+                                            p_lp->p_soa, p_lp->name),
+                           "Error initializing pqueue.");
+
+  /* Init the timer wheel */
+  tiz_goto_end_on_omx_err (tiz_twheel_init (&(p_lp->p_wheel),
+                                            TIZ_EVENT_WHEEL_TICK_NS,
+                                            tiz_monotonic_ns ()),
+                           "Error initializing the timer wheel.");
+  ev_init (&(p_lp->wheel_watcher), wheel_watcher_cback);
+  p_lp->wheel_watcher.data = p_lp;
+  p_lp->wheel_deadline_ns = UINT64_MAX;
+
+#ifdef HAVE_LIBURING
+  init_uring (p_lp);
+#endif
 
-      /* All good */
-      rc = OMX_ErrorNone;
+  ev_async_init (p_lp->p_async_watcher, async_watcher_cback);
+  p_lp->p_async_watcher->data = p_lp;
+  ev_async_start (p_lp->p_loop, p_lp->p_async_watcher);
 
-      ev_async_init (gp_event_loop->p_async_watcher, async_watcher_cback);
-      ev_async_start (gp_event_loop->p_loop, gp_event_loop->p_async_watcher);
+  p_lp->state = ETIZEventLoopStateStarted;
+  /* This is to prevent the event loop from exiting when there are no
+   * more active events */
+  ev_ref (p_lp->p_loop);
 
-      assert (gp_event_loop);
-    }
+  /* Create event loop thread */
+  tiz_goto_end_on_omx_err (
+    tiz_thread_create (&(p_lp->thread), 0, 0, event_loop_thread_func, p_lp),
+    "Error creating the event loop thread.");
+  tiz_sem_wait (&(p_lp->sem));
+  TIZ_LOG (TIZ_PRIORITY_TRACE,
+           "[%s] Now in ETIZEventLoopStateStarted state...", p_lp->name);
+
+  /* All good */
+  rc = OMX_ErrorNone;
 
 end:
 
-  if (OMX_ErrorNone == rc)
+  if (OMX_ErrorNone != rc)
     {
-      tiz_event_loop_t * p_lp = gp_event_loop;
-      p_lp->state = ETIZEventLoopStateStarted;
-      /* Create event loop thread */
-      tiz_thread_create (&(p_lp->thread), 0, 0, event_loop_thread_func, p_lp);
-      TIZ_LOG (TIZ_PRIORITY_TRACE, "Now in ETIZEventLoopStateStarted state...");
-
-      (void) tiz_mutex_lock (&(p_lp->mutex));
-      /* This is to prevent the event loop from exiting when there are no
-       * more active events */
-      ev_ref (p_lp->p_loop);
-      (void) tiz_mutex_unlock (&(p_lp->mutex));
-      tiz_sem_wait (&(p_lp->sem));
+      clean_up_thread_data (p_lp);
+      p_lp = NULL;
     }
-  else
+
+  return p_lp;
+}
+
+static void
+stop_event_loop (tiz_event_loop_t * ap_lp)
+{
+  OMX_PTR p_result = NULL;
+
+  assert (ap_lp);
+
+  (void) tiz_mutex_lock (&(ap_lp->mutex));
+  TIZ_LOG (TIZ_PRIORITY_TRACE, "destroying event loop thread [%s].",
+           ap_lp->name);
+  ap_lp->state = ETIZEventLoopStateStopping;
+  ev_unref (ap_lp->p_loop);
+  ev_async_send (ap_lp->p_loop, ap_lp->p_async_watcher);
+  (void) tiz_mutex_unlock (&(ap_lp->mutex));
+
+  tiz_thread_join (&(ap_lp->thread), &p_result);
+  clean_up_thread_data (ap_lp);
+}
+
+static void
+init_event_loop_thread (void)
+{
+  if (!gp_event_loop)
     {
-      clean_up_thread_data (gp_event_loop);
-      tiz_mem_free (gp_event_loop);
-      gp_event_loop = NULL;
+      /* Register a handler to reset the pthread_once_t global variables to
+         try to cope with the scenario of a process forking without exec. The
+         idea is to make sure that the loop threads are re-created in the child
+         process */
+      pthread_atfork (NULL, NULL, child_event_loop_reset);
+
+      if (!gp_rcfile && OMX_ErrorNone != tiz_rcfile_init (&gp_rcfile))
+        {
+          TIZ_LOG (TIZ_PRIORITY_ERROR, "Error opening configuration file.");
+          return;
+        }
+
+      gp_event_loop = start_event_loop (0);
     }
 }
 
@@ -1176,36 +2474,196 @@ get_event_loop (void)
   return gp_event_loop;
 }
 
+static OMX_U32
+read_event_loop_count (void)
+{
+  const char * p_count = tiz_rcfile_get_value ("ilcore", "event-loops");
+  long count = p_count ? strtol (p_count, NULL, 10) : 1;
+
+  if (count <= 0)
+    {
+      /* Zero means one loop per online CPU */
+      count = sysconf (_SC_NPROCESSORS_ONLN);
+    }
+
+  return (count < 1 ? 1 : count > TIZ_EVENT_LOOP_MAX_SHARDS
+                            ? TIZ_EVENT_LOOP_MAX_SHARDS
+                            : count);
+}
+
+static void
+init_event_loop_shards (void)
+{
+  /* NOTE: The rc file is read through get_event_loop; this must not run
+     inside the primary loop's pthread_once */
+  tiz_event_loop_t * p_primary = get_event_loop ();
+
+  if (p_primary)
+    {
+      const OMX_U32 count = read_event_loop_count ();
+      OMX_U32 i = 0;
+
+      g_event_shards.loops[0] = p_primary;
+      for (i = 1; i < count; ++i)
+        {
+          if (!(g_event_shards.loops[i] = start_event_loop (i)))
+            {
+              TIZ_LOG (TIZ_PRIORITY_ERROR,
+                       "Could only start [%u] of [%u] event loops",
+                       (unsigned int) i, (unsigned int) count);
+              break;
+            }
+        }
+      g_event_shards.nloops = i;
+      TIZ_LOG (TIZ_PRIORITY_NOTICE, "[%u] event loop(s)",
+               (unsigned int) g_event_shards.nloops);
+    }
+}
+
+static inline OMX_U32
+get_event_loop_shards (void)
+{
+  (void) pthread_once (&g_event_shards_once, init_event_loop_shards);
+  return g_event_shards.nloops;
+}
+
+static inline OMX_U32
+hash_owner (const void * ap_owner)
+{
+  uint64_t h = (uintptr_t) ap_owner;
+  /* Owners are heap pointers, so the low bits carry little entropy */
+  h ^= h >> 33;
+  h *= 0xff51afd7ed558ccdULL;
+  h ^= h >> 33;
+  return (OMX_U32) h;
+}
+
+static tiz_event_loop_binding_t *
+find_binding (const void * ap_owner)
+{
+  OMX_U32 i = 0;
+  for (i = 0; i < g_event_shards.nbindings; ++i)
+    {
+      if (g_event_shards.p_bindings[i].p_owner == ap_owner)
+        {
+          return &(g_event_shards.p_bindings[i]);
+        }
+    }
+  return NULL;
+}
+
+static tiz_event_loop_t *
+select_event_loop (const void * ap_owner)
+{
+  const OMX_U32 nloops = get_event_loop_shards ();
+  OMX_U32 shard = 0;
+
+  if (nloops > 1)
+    {
+      tiz_event_loop_binding_t * p_binding = NULL;
+      (void) pthread_mutex_lock (&(g_event_shards.mutex));
+      p_binding = find_binding (ap_owner);
+      shard = p_binding ? p_binding->shard : hash_owner (ap_owner) % nloops;
+      (void) pthread_mutex_unlock (&(g_event_shards.mutex));
+    }
+
+  return nloops > 0 ? g_event_shards.loops[shard] : NULL;
+}
+
 OMX_ERRORTYPE
 tiz_event_loop_init (void)
 {
-  return get_event_loop () ? OMX_ErrorNone : OMX_ErrorInsufficientResources;
+  return get_event_loop_shards () > 0 ? OMX_ErrorNone
+                                      : OMX_ErrorInsufficientResources;
 }
 
 void
 tiz_event_loop_destroy (void)
 {
-  /* NOTE: If the thread is destroyed, it can't be recreated in the same
-     process as it's been instantiated with pthread_once. */
+  /* NOTE: If the threads are destroyed, they can't be recreated in the same
+     process as they've been instantiated with pthread_once. */
+  OMX_U32 i = 0;
+
+  for (i = g_event_shards.nloops; i > 1; --i)
+    {
+      stop_event_loop (g_event_shards.loops[i - 1]);
+      g_event_shards.loops[i - 1] = NULL;
+    }
+  g_event_shards.loops[0] = NULL;
+  g_event_shards.nloops = 0;
 
   if (gp_event_loop)
     {
-      (void) tiz_mutex_lock (&(gp_event_loop->mutex));
-      TIZ_LOG (TIZ_PRIORITY_TRACE, "destroying event loop thread [%p].",
-               gp_event_loop);
-      gp_event_loop->state = ETIZEventLoopStateStopping;
-      ev_unref (gp_event_loop->p_loop);
-      ev_async_send (gp_event_loop->p_loop, gp_event_loop->p_async_watcher);
-      (void) tiz_mutex_unlock (&(gp_event_loop->mutex));
+      stop_event_loop (gp_event_loop);
+      gp_event_loop = NULL;
+    }
+}
+
+OMX_U32
+tiz_event_loop_shards (void)
+{
+  return get_event_loop_shards ();
+}
+
+OMX_ERRORTYPE
+tiz_event_loop_bind (const void * ap_owner, const OMX_U32 a_shard)
+{
+  OMX_ERRORTYPE rc = OMX_ErrorNone;
+  tiz_event_loop_binding_t * p_binding = NULL;
+
+  if (a_shard >= get_event_loop_shards ())
+    {
+      return OMX_ErrorBadParameter;
+    }
+
+  (void) pthread_mutex_lock (&(g_event_shards.mutex));
+  if (!(p_binding = find_binding (ap_owner)))
+    {
+      if (g_event_shards.nbindings == g_event_shards.capacity)
+        {
+          const OMX_U32 capacity
+            = g_event_shards.capacity ? g_event_shards.capacity * 2 : 8;
+          tiz_event_loop_binding_t * p_bindings = tiz_mem_realloc (
+            g_event_shards.p_bindings,
+            capacity * sizeof (tiz_event_loop_binding_t));
+          if (p_bindings)
+            {
+              g_event_shards.p_bindings = p_bindings;
+              g_event_shards.capacity = capacity;
+            }
+        }
+      if (g_event_shards.nbindings < g_event_shards.capacity)
+        {
+          p_binding
+            = &(g_event_shards.p_bindings[g_event_shards.nbindings++]);
+          p_binding->p_owner = ap_owner;
+        }
+    }
+  if (p_binding)
+    {
+      p_binding->shard = a_shard;
+    }
+  else
+    {
+      rc = OMX_ErrorInsufficientResources;
+    }
+  (void) pthread_mutex_unlock (&(g_event_shards.mutex));
+
+  return rc;
+}
+
+void
+tiz_event_loop_unbind (const void * ap_owner)
+{
+  tiz_event_loop_binding_t * p_binding = NULL;
 
-      {
-        OMX_PTR p_result = NULL;
-        tiz_thread_join (&(gp_event_loop->thread), &p_result);
-        clean_up_thread_data (gp_event_loop);
-        tiz_mem_free (gp_event_loop);
-        gp_event_loop = NULL;
-      }
+  (void) pthread_mutex_lock (&(g_event_shards.mutex));
+  if ((p_binding = find_binding (ap_owner)))
+    {
+      /* Move the last binding into the hole */
+      *p_binding = g_event_shards.p_bindings[--g_event_shards.nbindings];
     }
+  (void) pthread_mutex_unlock (&(g_event_shards.mutex));
 }
 
 /*
@@ -1218,14 +2676,15 @@ tiz_event_io_init (tiz_event_io_t ** app_ev_io, void * ap_arg0,
 {
   OMX_ERRORTYPE rc = OMX_ErrorInsufficientResources;
   tiz_event_io_t * p_ev_io = NULL;
+  tiz_event_loop_t * p_lp = NULL;
 
   assert (app_ev_io);
   assert (ap_cback);
-  (void) get_event_loop ();
 
-  if ((p_ev_io
-       = (tiz_event_io_t *) tiz_mem_calloc (1, sizeof (tiz_event_io_t))))
+  if ((p_lp = select_event_loop (ap_arg0))
+      && (p_ev_io = tiz_mem_calloc (1, sizeof (tiz_event_io_t))))
     {
+      p_ev_io->p_lp = p_lp;
       p_ev_io->pf_cback = ap_cback;
       p_ev_io->p_arg0 = ap_arg0;
       p_ev_io->p_arg1 = ap_arg1;
@@ -1298,14 +2757,15 @@ tiz_event_timer_init (tiz_event_timer_t ** app_ev_timer, void * ap_arg0,
 {
   OMX_ERRORTYPE rc = OMX_ErrorInsufficientResources;
   tiz_event_timer_t * p_ev_timer = NULL;
+  tiz_event_loop_t * p_lp = NULL;
 
   assert (app_ev_timer);
   assert (ap_cback);
-  (void) get_event_loop ();
 
-  if ((p_ev_timer
-       = (tiz_event_timer_t *) tiz_mem_calloc (1, sizeof (tiz_event_timer_t))))
+  if ((p_lp = select_event_loop (ap_arg0))
+      && (p_ev_timer = tiz_mem_calloc (1, sizeof (tiz_event_timer_t))))
     {
+      p_ev_timer->p_lp = p_lp;
       p_ev_timer->pf_cback = ap_cback;
       p_ev_timer->p_arg0 = ap_arg0;
       p_ev_timer->p_arg1 = ap_arg1;
@@ -1328,14 +2788,52 @@ tiz_event_timer_set (tiz_event_timer_t * ap_ev_timer, double a_after,
   assert (ap_ev_timer);
   (void) get_event_loop ();
   ap_ev_timer->once = a_repeat ? false : true;
+  ap_ev_timer->after_ns = a_after > 0 ? a_after * 1e9 : 0;
+  ap_ev_timer->repeat_ns = a_repeat > 0 ? a_repeat * 1e9 : 0;
   ev_timer_set ((ev_timer *) ap_ev_timer, a_after, a_repeat);
 }
 
+OMX_ERRORTYPE
+tiz_event_timer_set_slack (tiz_event_timer_t * ap_ev_timer, double a_slack)
+{
+  tiz_event_loop_t * p_lp = NULL;
+
+  assert (ap_ev_timer);
+  p_lp = ap_ev_timer->p_lp;
+  assert (p_lp);
+
+  if (a_slack > 0)
+    {
+      if (!ap_ev_timer->p_wheel_timer)
+        {
+          tiz_check_omx (tiz_twheel_timer_init (p_lp->p_wheel,
+                                                &(ap_ev_timer->p_wheel_timer),
+                                                wheel_timer_cback,
+                                                ap_ev_timer));
+        }
+      ap_ev_timer->slack_ns = a_slack * 1e9;
+    }
+  else if (ap_ev_timer->p_wheel_timer)
+    {
+      tiz_check_omx (tiz_mutex_lock (&(p_lp->mutex)));
+      tiz_twheel_timer_destroy (ap_ev_timer->p_wheel_timer);
+      ap_ev_timer->p_wheel_timer = NULL;
+      unlink_fired_timer (p_lp, ap_ev_timer);
+      tiz_check_omx (tiz_mutex_unlock (&(p_lp->mutex)));
+      ap_ev_timer->slack_ns = 0;
+    }
+  return OMX_ErrorNone;
+}
+
 OMX_ERRORTYPE
 tiz_event_timer_start (tiz_event_timer_t * ap_ev_timer, const uint32_t a_id)
 {
   assert (ap_ev_timer);
   (void) get_event_loop ();
+  if (ap_ev_timer->p_wheel_timer)
+    {
+      return start_wheel_timer (ap_ev_timer, a_id, false);
+    }
   return enqueue_timer_msg (ap_ev_timer, a_id, ETIZEventLoopMsgTimerStart);
 }
 
@@ -1344,6 +2842,10 @@ tiz_event_timer_restart (tiz_event_timer_t * ap_ev_timer, const uint32_t a_id)
 {
   assert (ap_ev_timer);
   (void) get_event_loop ();
+  if (ap_ev_timer->p_wheel_timer)
+    {
+      return start_wheel_timer (ap_ev_timer, a_id, true);
+    }
   return enqueue_timer_msg (ap_ev_timer, a_id, ETIZEventLoopMsgTimerRestart);
 }
 
@@ -1352,6 +2854,10 @@ tiz_event_timer_stop (tiz_event_timer_t * ap_ev_timer)
 {
   assert (ap_ev_timer);
   (void) get_event_loop ();
+  if (ap_ev_timer->p_wheel_timer)
+    {
+      return stop_wheel_timer (ap_ev_timer);
+    }
   return enqueue_timer_msg (ap_ev_timer, ap_ev_timer->id,
                             ETIZEventLoopMsgTimerStop);
 }
@@ -1384,14 +2890,15 @@ tiz_event_stat_init (tiz_event_stat_t ** app_ev_stat, void * ap_arg0,
 {
   OMX_ERRORTYPE rc = OMX_ErrorInsufficientResources;
   tiz_event_stat_t * p_ev_stat = NULL;
+  tiz_event_loop_t * p_lp = NULL;
 
   assert (app_ev_stat);
   assert (ap_cback);
-  (void) get_event_loop ();
 
-  if ((p_ev_stat
-       = (tiz_event_stat_t *) tiz_mem_calloc (1, sizeof (tiz_event_stat_t))))
+  if ((p_lp = select_event_loop (ap_arg0))
+      && (p_ev_stat = tiz_mem_calloc (1, sizeof (tiz_event_stat_t))))
     {
+      p_ev_stat->p_lp = p_lp;
       p_ev_stat->pf_cback = ap_cback;
       p_ev_stat->p_arg0 = ap_arg0;
       p_ev_stat->p_arg1 = ap_arg1;
@@ -1442,10 +2949,136 @@ tiz_event_stat_destroy (tiz_event_stat_t * ap_ev_stat)
     }
 }
 
+/*
+ * Async io-related functions
+ */
+
+OMX_ERRORTYPE
+tiz_event_aio_init (tiz_event_aio_t ** app_ev_aio, void * ap_arg0,
+                    tiz_event_aio_cb_f ap_cback, void * ap_arg1)
+{
+  OMX_ERRORTYPE rc = OMX_ErrorInsufficientResources;
+  tiz_event_aio_t * p_ev_aio = NULL;
+  tiz_event_loop_t * p_lp = NULL;
+
+  assert (app_ev_aio);
+  assert (ap_cback);
+
+  if ((p_lp = select_event_loop (ap_arg0))
+      && (p_ev_aio = tiz_mem_calloc (1, sizeof (tiz_event_aio_t))))
+    {
+      p_ev_aio->p_lp = p_lp;
+      p_ev_aio->pf_cback = ap_cback;
+      p_ev_aio->p_arg0 = ap_arg0;
+      p_ev_aio->p_arg1 = ap_arg1;
+      p_ev_aio->id = 0;
+      p_ev_aio->fd = -1;
+      p_ev_aio->state = ETIZEventAioStateIdle;
+      ev_init ((ev_io *) p_ev_aio, aio_watcher_cback);
+      rc = OMX_ErrorNone;
+    }
+
+  *app_ev_aio = p_ev_aio;
+
+  return rc;
+}
+
+OMX_ERRORTYPE
+tiz_event_aio_submit (tiz_event_aio_t * ap_ev_aio, tiz_event_aio_op_t a_op,
+                      int a_fd, void * ap_buf, size_t a_len, OMX_S64 a_offset,
+                      const uint32_t a_id)
+{
+  OMX_ERRORTYPE rc = OMX_ErrorNone;
+  tiz_event_loop_t * p_lp = NULL;
+  bool wake_up = false;
+
+  assert (ap_ev_aio);
+  assert (a_op < TIZ_EVENT_AIO_MAX);
+  assert (a_fd >= 0);
+
+  p_lp = ap_ev_aio->p_lp;
+  assert (p_lp);
+
+  tiz_check_omx (tiz_mutex_lock (&(p_lp->mutex)));
+  if (ETIZEventAioStateIdle != ap_ev_aio->state || ap_ev_aio->listed)
+    {
+      rc = OMX_ErrorNotReady;
+    }
+  else
+    {
+      ap_ev_aio->op = a_op;
+      ap_ev_aio->fd = a_fd;
+      ap_ev_aio->p_buf = ap_buf;
+      ap_ev_aio->len = a_len;
+      ap_ev_aio->offset = a_offset;
+      ap_ev_aio->id = a_id;
+#ifdef HAVE_LIBURING
+      if (p_lp->uring)
+        {
+          rc = queue_uring_aio (p_lp, ap_ev_aio);
+        }
+      else
+#endif
+        {
+          ap_ev_aio->state = ETIZEventAioStateQueued;
+          append_aio (p_lp, ap_ev_aio);
+          wake_up = true;
+        }
+    }
+  tiz_check_omx (tiz_mutex_unlock (&(p_lp->mutex)));
+
+  if (wake_up)
+    {
+      ev_async_send (p_lp->p_loop, p_lp->p_async_watcher);
+    }
+
+  return rc;
+}
+
+bool
+tiz_event_aio_is_busy (tiz_event_aio_t * ap_ev_aio)
+{
+  bool busy = false;
+  assert (ap_ev_aio);
+  (void) tiz_mutex_lock (&(ap_ev_aio->p_lp->mutex));
+  busy = (ETIZEventAioStateIdle != ap_ev_aio->state);
+  (void) tiz_mutex_unlock (&(ap_ev_aio->p_lp->mutex));
+  return busy;
+}
+
+void
+tiz_event_aio_destroy (tiz_event_aio_t * ap_ev_aio)
+{
+  if (ap_ev_aio)
+    {
+      tiz_event_loop_t * p_lp = ap_ev_aio->p_lp;
+      bool wake_up = false;
+
+      assert (p_lp);
+
+      (void) tiz_mutex_lock (&(p_lp->mutex));
+      ap_ev_aio->destroyed = true;
+      if (tp_event_loop == p_lp)
+        {
+          release_aio (p_lp, ap_ev_aio);
+        }
+      else
+        {
+          append_aio (p_lp, ap_ev_aio);
+          wake_up = true;
+        }
+      (void) tiz_mutex_unlock (&(p_lp->mutex));
+
+      if (wake_up)
+        {
+          ev_async_send (p_lp->p_loop, p_lp->p_async_watcher);
+        }
+    }
+}
+
 tiz_rcfile_t *
 tiz_rcfile_get_handle (void)
 {
-  tiz_event_loop_t * p_event_loop = get_event_loop ();
-  return (p_event_loop && p_event_loop->p_rcfile) ? p_event_loop->p_rcfile
-                                                  : NULL;
+  (void) get_event_loop ();
+  return gp_rcfile;
 }
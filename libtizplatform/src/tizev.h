@@ -38,11 +38,19 @@ extern "C" {
  *
  * Global event loop, async io and timers.
  *
+ * The watchers may be spread over several event loops ('shards'), each one
+ * hosted in its own thread. The number of loops comes from the 'event-loops'
+ * key of the rc file (1 by default, 0 means one per online CPU). The loop
+ * that serves a watcher is chosen when the watcher is initialised, from its
+ * owner (the ap_arg0 argument): the loop the owner has been bound to with
+ * tiz_event_loop_bind, or a hash of the owner otherwise.
+ *
  * @ingroup libtizplatform
  */
 
 #include <stdbool.h>
 #include <stdint.h>
+#include <sys/types.h>
 
 #include <OMX_Core.h>
 #include <OMX_Types.h>
@@ -65,6 +73,12 @@ typedef struct tiz_event_timer tiz_event_timer_t;
  */
 typedef struct tiz_event_stat tiz_event_stat_t;
 
+/**
+ * Handle to an async io request
+ * @ingroup tizevent
+ */
+typedef struct tiz_event_aio tiz_event_aio_t;
+
 /**
  * Callback prototype for io events
  *
@@ -89,6 +103,29 @@ typedef void (*tiz_event_stat_cb_f) (void * ap_arg0,
                                      void * ap_arg1, const uint32_t a_id,
                                      int a_events);
 
+/**
+ * Callback prototype for async io requests
+ *
+ * @param ap_ev_aio The request that has completed; it may be submitted again
+ * from the callback
+ *
+ * @param a_result The number of bytes transferred, or a negative errno value
+ *
+ * @ingroup tizevent
+ */
+typedef void (*tiz_event_aio_cb_f) (void * ap_arg0,
+                                    tiz_event_aio_t * ap_ev_aio,
+                                    void * ap_arg1, const uint32_t a_id,
+                                    ssize_t a_result);
+
+typedef enum tiz_event_aio_op {
+  TIZ_EVENT_AIO_READ = 0, /* read (2) or pread (2) */
+  TIZ_EVENT_AIO_WRITE,    /* write (2) or pwrite (2) */
+  TIZ_EVENT_AIO_RECV,     /* recv (2), on a socket */
+  TIZ_EVENT_AIO_SEND,     /* send (2), on a socket (without SIGPIPE) */
+  TIZ_EVENT_AIO_MAX
+} tiz_event_aio_op_t;
+
 typedef enum tiz_event_io_event {
   TIZ_EVENT_READ = 0x01,  /* ev_io detected read will not block */
   TIZ_EVENT_WRITE = 0x02, /* ev_io detected write will not block */
@@ -125,6 +162,44 @@ tiz_event_loop_init (void);
 void
 tiz_event_loop_destroy (void);
 
+/**
+ * The number of event loops (shards) in this process.
+ *
+ * @ingroup tizevent
+ *
+ * @return The number of event loops, or zero if they could not be started.
+ */
+OMX_U32
+tiz_event_loop_shards (void);
+
+/**
+ * Have all the watchers of an owner (the ap_arg0 argument of the watcher
+ * init functions) served by a given event loop. Only the watchers that are
+ * initialised after this call are affected.
+ *
+ * @ingroup tizevent
+ *
+ * @param ap_owner The owner (e.g. a component handle).
+ *
+ * @param a_shard The event loop, from 0 to tiz_event_loop_shards () - 1.
+ *
+ * @return OMX_ErrorNone if success, OMX_ErrorBadParameter if the shard does
+ * not exist, OMX_ErrorInsufficientResources otherwise.
+ */
+OMX_ERRORTYPE
+tiz_event_loop_bind (const void * ap_owner, const OMX_U32 a_shard);
+
+/**
+ * Remove an owner's binding, if any. Its watchers are assigned by hash
+ * again.
+ *
+ * @ingroup tizevent
+ *
+ * @param ap_owner The owner (e.g. a component handle).
+ */
+void
+tiz_event_loop_unbind (const void * ap_owner);
+
 OMX_ERRORTYPE
 tiz_event_io_init (tiz_event_io_t ** app_ev_io, void * ap_arg0,
                    tiz_event_io_cb_f ap_cback, void * ap_arg1);
@@ -153,6 +228,28 @@ void
 tiz_event_timer_set (tiz_event_timer_t * ap_ev_timer, double a_after,
                      double a_repeat);
 
+/**
+ * Give a timer some slack. A timer with slack is served by its loop's timer
+ * wheel instead of an exact timer: it may expire up to a_slack seconds (plus
+ * 1 ms) late, in exchange for being cheaper to start and stop and for
+ * sharing its loop's wakeups with the other timers due at about the same
+ * time. Starting, restarting and stopping such a timer is not queued to the
+ * loop; the loop is only woken up when the timer is due earlier than any
+ * other timer in the wheel.
+ *
+ * This must be called while the timer is stopped.
+ *
+ * @ingroup tizevent
+ *
+ * @param a_slack How late the timer may expire, in seconds. Zero (the
+ * default) gives an exact timer.
+ *
+ * @return OMX_ErrorNone if success, OMX_ErrorInsufficientResources
+ * otherwise.
+ */
+OMX_ERRORTYPE
+tiz_event_timer_set_slack (tiz_event_timer_t * ap_ev_timer, double a_slack);
+
 OMX_ERRORTYPE
 tiz_event_timer_start (tiz_event_timer_t * ap_ev_timer, const uint32_t a_id);
 
@@ -184,6 +281,65 @@ tiz_event_stat_stop (tiz_event_stat_t * ap_ev_stat);
 void
 tiz_event_stat_destroy (tiz_event_stat_t * ap_ev_stat);
 
+/**
+ * Create an async io request. The request is served by the event loop of its
+ * owner (ap_arg0), and its callback is called from that loop's thread.
+ *
+ * @ingroup tizevent
+ *
+ * @return OMX_ErrorNone if success, OMX_ErrorInsufficientResources
+ * otherwise.
+ */
+OMX_ERRORTYPE
+tiz_event_aio_init (tiz_event_aio_t ** app_ev_aio, void * ap_arg0,
+                    tiz_event_aio_cb_f ap_cback, void * ap_arg1);
+
+/**
+ * Submit a read, write, recv or send, without blocking the caller. The
+ * callback is called once the operation has completed.
+ *
+ * When libtizplatform has been built with liburing, the loop hands the
+ * request to the kernel through io_uring, and the requests submitted from
+ * the loop's own thread (e.g. from the callback of a previous request) are
+ * batched into a single system call. Otherwise, the loop's thread performs
+ * the operation itself: sockets and other non-blocking descriptors are
+ * waited upon until they are ready, and regular files are read and written
+ * synchronously.
+ *
+ * @ingroup tizevent
+ *
+ * @param ap_buf The buffer; it must remain valid until the callback has been
+ * called, or until the request has been destroyed and its loop has
+ * cancelled it.
+ *
+ * @param a_offset The file offset, or -1 to use (and update) the current
+ * file position. Ignored by TIZ_EVENT_AIO_RECV and TIZ_EVENT_AIO_SEND.
+ *
+ * @return OMX_ErrorNone if success, OMX_ErrorNotReady if the request is
+ * still in progress, OMX_ErrorInsufficientResources otherwise.
+ */
+OMX_ERRORTYPE
+tiz_event_aio_submit (tiz_event_aio_t * ap_ev_aio, tiz_event_aio_op_t a_op,
+                      int a_fd, void * ap_buf, size_t a_len, OMX_S64 a_offset,
+                      const uint32_t a_id);
+
+/**
+ * @ingroup tizevent
+ * @return true if the request has been submitted and its callback has not
+ * been called yet.
+ */
+bool
+tiz_event_aio_is_busy (tiz_event_aio_t * ap_ev_aio);
+
+/**
+ * Destroy a request. A request still in progress is cancelled, and its
+ * callback is not called.
+ *
+ * @ingroup tizevent
+ */
+void
+tiz_event_aio_destroy (tiz_event_aio_t * ap_ev_aio);
+
 #ifdef __cplusplus
 }
 #endif
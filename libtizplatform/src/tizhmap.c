@@ -0,0 +1,360 @@
+/**
+ * Copyright (C) 2011-2020 Aratelia Limited - Juan A. Rubio and contributors
+ *
+ * This file is part of Tizonia
+ *
+ * Tizonia is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Tizonia is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Tizonia.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file   tizhmap.c
+ * @author Juan A. Rubio <juan.rubio@aratelia.com>
+ *
+ * @brief  Open-addressing hash map with integer keys
+ *
+ * Each slot records its distance from the key's home bucket ('dist', stored
+ * plus one so that zero means an empty slot). On insertion, an item that is
+ * further from home than the slot's occupant takes the slot and the occupant
+ * moves on (Robin Hood). This bounds the probe sequences and lets a lookup
+ * stop as soon as it meets a slot whose occupant is closer to home than the
+ * key being searched. On removal, the items that follow are shifted back one
+ * slot until an empty slot or an item at its home bucket is found, so no
+ * tombstones are needed.
+ *
+ */
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <assert.h>
+#include <string.h>
+
+#include "tizplatform.h"
+
+#ifdef TIZ_LOG_CATEGORY_NAME
+#undef TIZ_LOG_CATEGORY_NAME
+#define TIZ_LOG_CATEGORY_NAME "tiz.platform.hmap"
+#endif
+
+#define HMAP_MIN_CAPACITY 8
+/* Maximum load factor: 7/8 */
+#define HMAP_MAX_LOAD_NUM 7
+#define HMAP_MAX_LOAD_DEN 8
+
+typedef struct tiz_hmap_slot tiz_hmap_slot_t;
+struct tiz_hmap_slot
+{
+  uintptr_t key;
+  OMX_PTR p_value;
+  OMX_U32 dist;
+};
+
+struct tiz_hmap
+{
+  tiz_hmap_slot_t * p_slots;
+  OMX_U32 capacity;
+  OMX_U32 mask;
+  OMX_U32 size;
+  tiz_hmap_free_f pf_free;
+};
+
+static inline OMX_U32
+hmap_home (const tiz_hmap_t * ap_map, uintptr_t a_key)
+{
+  /* Fibonacci hashing; pointer keys have their low bits clear, so the high
+     bits of the product are used */
+  const uint64_t h = (uint64_t) a_key * 0x9E3779B97F4A7C15ULL;
+  return (OMX_U32) (h >> 32) & ap_map->mask;
+}
+
+static inline bool
+hmap_is_full (const tiz_hmap_t * ap_map)
+{
+  return ((uint64_t) (ap_map->size + 1) * HMAP_MAX_LOAD_DEN
+          > (uint64_t) ap_map->capacity * HMAP_MAX_LOAD_NUM);
+}
+
+static OMX_U32
+hmap_capacity_for (OMX_U32 a_nitems)
+{
+  OMX_U32 capacity = HMAP_MIN_CAPACITY;
+  while ((uint64_t) a_nitems * HMAP_MAX_LOAD_DEN
+         > (uint64_t) capacity * HMAP_MAX_LOAD_NUM)
+    {
+      capacity <<= 1;
+    }
+  return capacity;
+}
+
+static void
+hmap_place (tiz_hmap_t * ap_map, uintptr_t a_key, OMX_PTR ap_value)
+{
+  tiz_hmap_slot_t cur;
+  OMX_U32 pos = hmap_home (ap_map, a_key);
+
+  cur.key = a_key;
+  cur.p_value = ap_value;
+  cur.dist = 1;
+
+  for (;;)
+    {
+      tiz_hmap_slot_t * p_slot = &(ap_map->p_slots[pos]);
+      if (0 == p_slot->dist)
+        {
+          *p_slot = cur;
+          ap_map->size++;
+          return;
+        }
+      if (p_slot->dist < cur.dist)
+        {
+          const tiz_hmap_slot_t tmp = *p_slot;
+          *p_slot = cur;
+          cur = tmp;
+        }
+      pos = (pos + 1) & ap_map->mask;
+      cur.dist++;
+    }
+}
+
+static OMX_ERRORTYPE
+hmap_resize (tiz_hmap_t * ap_map, OMX_U32 a_capacity)
+{
+  tiz_hmap_slot_t * p_old = ap_map->p_slots;
+  const OMX_U32 old_capacity = ap_map->capacity;
+  OMX_U32 i = 0;
+
+  assert (a_capacity > ap_map->size);
+
+  tiz_check_null_ret_oom (
+    (ap_map->p_slots = tiz_mem_calloc (a_capacity, sizeof (tiz_hmap_slot_t))));
+  ap_map->capacity = a_capacity;
+  ap_map->mask = a_capacity - 1;
+  ap_map->size = 0;
+
+  for (i = 0; i < old_capacity; ++i)
+    {
+      if (p_old[i].dist > 0)
+        {
+          hmap_place (ap_map, p_old[i].key, p_old[i].p_value);
+        }
+    }
+
+  tiz_mem_free (p_old);
+  return OMX_ErrorNone;
+}
+
+static tiz_hmap_slot_t *
+hmap_lookup (const tiz_hmap_t * ap_map, uintptr_t a_key)
+{
+  OMX_U32 pos = hmap_home (ap_map, a_key);
+  OMX_U32 dist = 1;
+
+  for (;;)
+    {
+      tiz_hmap_slot_t * p_slot = &(ap_map->p_slots[pos]);
+      /* An empty slot, or an occupant closer to home than we are: the key
+         would have been placed here */
+      if (p_slot->dist < dist)
+        {
+          return NULL;
+        }
+      if (p_slot->key == a_key)
+        {
+          return p_slot;
+        }
+      pos = (pos + 1) & ap_map->mask;
+      dist++;
+    }
+}
+
+OMX_ERRORTYPE
+tiz_hmap_init (tiz_hmap_ptr_t * app_map, OMX_U32 a_capacity,
+               tiz_hmap_free_f a_pf_free)
+{
+  tiz_hmap_t * p_map = NULL;
+
+  assert (app_map);
+
+  tiz_check_null_ret_oom ((p_map = tiz_mem_calloc (1, sizeof (tiz_hmap_t))));
+
+  p_map->capacity = hmap_capacity_for (a_capacity);
+  p_map->mask = p_map->capacity - 1;
+  p_map->size = 0;
+  p_map->pf_free = a_pf_free;
+
+  if (!(p_map->p_slots
+        = tiz_mem_calloc (p_map->capacity, sizeof (tiz_hmap_slot_t))))
+    {
+      tiz_mem_free (p_map);
+      return OMX_ErrorInsufficientResources;
+    }
+
+  *app_map = p_map;
+  return OMX_ErrorNone;
+}
+
+void
+tiz_hmap_destroy (tiz_hmap_t * ap_map)
+{
+  if (ap_map)
+    {
+      TIZ_LOG (TIZ_PRIORITY_TRACE, "Destroying hmap [%p]", ap_map);
+      tiz_hmap_clear (ap_map);
+      tiz_mem_free (ap_map->p_slots);
+      tiz_mem_free (ap_map);
+    }
+}
+
+OMX_ERRORTYPE
+tiz_hmap_insert (tiz_hmap_t * ap_map, uintptr_t a_key, OMX_PTR ap_value)
+{
+  assert (ap_map);
+
+  if (hmap_lookup (ap_map, a_key))
+    {
+      return OMX_ErrorBadParameter;
+    }
+
+  if (hmap_is_full (ap_map))
+    {
+      tiz_check_omx (hmap_resize (ap_map, ap_map->capacity << 1));
+    }
+
+  hmap_place (ap_map, a_key, ap_value);
+  return OMX_ErrorNone;
+}
+
+OMX_PTR
+tiz_hmap_find (const tiz_hmap_t * ap_map, uintptr_t a_key)
+{
+  const tiz_hmap_slot_t * p_slot = NULL;
+  assert (ap_map);
+  p_slot = hmap_lookup (ap_map, a_key);
+  return p_slot ? p_slot->p_value : NULL;
+}
+
+bool
+tiz_hmap_contains (const tiz_hmap_t * ap_map, uintptr_t a_key)
+{
+  assert (ap_map);
+  return (NULL != hmap_lookup (ap_map, a_key));
+}
+
+void
+tiz_hmap_erase (tiz_hmap_t * ap_map, uintptr_t a_key)
+{
+  tiz_hmap_slot_t * p_slot = NULL;
+
+  assert (ap_map);
+
+  if ((p_slot = hmap_lookup (ap_map, a_key)))
+    {
+      const uintptr_t key = p_slot->key;
+      OMX_PTR p_value = p_slot->p_value;
+      OMX_U32 pos = p_slot - ap_map->p_slots;
+      OMX_U32 next = (pos + 1) & ap_map->mask;
+
+      /* Backward-shift the rest of the cluster */
+      while (ap_map->p_slots[next].dist > 1)
+        {
+          ap_map->p_slots[pos] = ap_map->p_slots[next];
+          ap_map->p_slots[pos].dist--;
+          pos = next;
+          next = (next + 1) & ap_map->mask;
+        }
+      ap_map->p_slots[pos].dist = 0;
+      ap_map->size--;
+
+      /* The map is consistent by now, in case the free function uses it */
+      if (ap_map->pf_free)
+        {
+          ap_map->pf_free (key, p_value);
+        }
+    }
+}
+
+void
+tiz_hmap_clear (tiz_hmap_t * ap_map)
+{
+  OMX_U32 i = 0;
+
+  assert (ap_map);
+
+  for (i = 0; i < ap_map->capacity && ap_map->size > 0; ++i)
+    {
+      tiz_hmap_slot_t * p_slot = &(ap_map->p_slots[i]);
+      if (p_slot->dist > 0)
+        {
+          p_slot->dist = 0;
+          ap_map->size--;
+          if (ap_map->pf_free)
+            {
+              ap_map->pf_free (p_slot->key, p_slot->p_value);
+            }
+        }
+    }
+}
+
+bool
+tiz_hmap_empty (const tiz_hmap_t * ap_map)
+{
+  assert (ap_map);
+  return (0 == ap_map->size);
+}
+
+OMX_U32
+tiz_hmap_size (const tiz_hmap_t * ap_map)
+{
+  assert (ap_map);
+  return ap_map->size;
+}
+
+void
+tiz_hmap_iter_init (const tiz_hmap_t * ap_map, tiz_hmap_iter_t * ap_iter)
+{
+  assert (ap_map);
+  assert (ap_iter);
+  ap_iter->p_map = ap_map;
+  ap_iter->pos = 0;
+}
+
+bool
+tiz_hmap_iter_next (tiz_hmap_iter_t * ap_iter, uintptr_t * ap_key,
+                    OMX_PTR * app_value)
+{
+  const tiz_hmap_t * p_map = NULL;
+
+  assert (ap_iter);
+  assert (ap_iter->p_map);
+
+  p_map = ap_iter->p_map;
+  while (ap_iter->pos < p_map->capacity)
+    {
+      const tiz_hmap_slot_t * p_slot = &(p_map->p_slots[ap_iter->pos++]);
+      if (p_slot->dist > 0)
+        {
+          if (ap_key)
+            {
+              *ap_key = p_slot->key;
+            }
+          if (app_value)
+            {
+              *app_value = p_slot->p_value;
+            }
+          return true;
+        }
+    }
+  return false;
+}
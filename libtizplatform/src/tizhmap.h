@@ -0,0 +1,204 @@
+/**
+ * Copyright (C) 2011-2020 Aratelia Limited - Juan A. Rubio and contributors
+ *
+ * This file is part of Tizonia
+ *
+ * Tizonia is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Tizonia is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Tizonia.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file   tizhmap.h
+ * @author Juan A. Rubio <juan.rubio@aratelia.com>
+ *
+ * @brief  Open-addressing hash map with integer keys
+ *
+ *
+ */
+
+#ifndef TIZHMAP_H
+#define TIZHMAP_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup tizhmap Hash map
+ *
+ * A hash map for integer or pointer-sized keys. Keys and values are stored
+ * inline in a single power-of-two table, using Robin Hood linear probing
+ * with backward-shift deletion. Lookups, insertions and removals are O(1) on
+ * average, and iteration is a linear walk over the table.
+ *
+ * Unlike the AVL-backed tiz_map, there is no key ordering and no positional
+ * access; use the iterator functions to visit the items instead.
+ *
+ * @ingroup libtizplatform
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <OMX_Core.h>
+#include <OMX_Types.h>
+
+/**
+ * Hash map opaque structure.
+ * @ingroup tizhmap
+ */
+typedef struct tiz_hmap tiz_hmap_t;
+typedef /*@null@ */ tiz_hmap_t * tiz_hmap_ptr_t;
+
+/**
+ * Function called when an item is removed from the map (may be NULL).
+ * @ingroup tizhmap
+ */
+typedef void (*tiz_hmap_free_f) (uintptr_t a_key, OMX_PTR ap_value);
+
+/**
+ * Hash map iterator. Its contents are private; use tiz_hmap_iter_init to
+ * initialise it.
+ * @ingroup tizhmap
+ */
+typedef struct tiz_hmap_iter tiz_hmap_iter_t;
+struct tiz_hmap_iter
+{
+  const tiz_hmap_t * p_map;
+  OMX_U32 pos;
+};
+
+/**
+ * Create an empty map.
+ *
+ * @ingroup tizhmap
+ *
+ * @param a_capacity The number of items the map is expected to hold. The map
+ * grows as needed, so this is only a hint (may be zero).
+ *
+ * @param a_pf_free A function called with the key-value pair of every item
+ * that is erased, cleared or destroyed (may be NULL).
+ *
+ * @return OMX_ErrorNone if success, OMX_ErrorInsufficientResources otherwise.
+ */
+OMX_ERRORTYPE
+tiz_hmap_init (/*@out@*/ tiz_hmap_ptr_t * app_map, OMX_U32 a_capacity,
+               tiz_hmap_free_f a_pf_free);
+
+/**
+ * Destroy the map, after calling the free function on every item still in
+ * it. If ap_map is NULL, no operation is performed.
+ *
+ * @ingroup tizhmap
+ *
+ */
+void
+tiz_hmap_destroy (/*@null@ */ tiz_hmap_t * ap_map);
+
+/**
+ * Insert a new item.
+ *
+ * @ingroup tizhmap
+ *
+ * @return OMX_ErrorNone if success, OMX_ErrorBadParameter if the key is
+ * already in the map, OMX_ErrorInsufficientResources if the map could not
+ * grow.
+ */
+OMX_ERRORTYPE
+tiz_hmap_insert (tiz_hmap_t * ap_map, uintptr_t a_key, OMX_PTR ap_value);
+
+/**
+ * Look up a key.
+ *
+ * @ingroup tizhmap
+ *
+ * @return The value associated to the key, or NULL if the key is not in the
+ * map.
+ */
+OMX_PTR
+tiz_hmap_find (const tiz_hmap_t * ap_map, uintptr_t a_key);
+
+/**
+ * Find out whether a key is in the map. Useful when NULL is a valid value.
+ *
+ * @ingroup tizhmap
+ *
+ */
+bool
+tiz_hmap_contains (const tiz_hmap_t * ap_map, uintptr_t a_key);
+
+/**
+ * Remove an item, calling the free function on it. Nothing happens if the
+ * key is not in the map.
+ *
+ * @ingroup tizhmap
+ *
+ */
+void
+tiz_hmap_erase (tiz_hmap_t * ap_map, uintptr_t a_key);
+
+/**
+ * Remove all the items, calling the free function on each of them. The
+ * table keeps its current capacity.
+ *
+ * @ingroup tizhmap
+ *
+ */
+void
+tiz_hmap_clear (tiz_hmap_t * ap_map);
+
+/**
+ * @ingroup tizhmap
+ * @return true if the map has no items.
+ */
+bool
+tiz_hmap_empty (const tiz_hmap_t * ap_map);
+
+/**
+ * @ingroup tizhmap
+ * @return The number of items in the map.
+ */
+OMX_U32
+tiz_hmap_size (const tiz_hmap_t * ap_map);
+
+/**
+ * Position an iterator before the first item of the map. Items are visited in
+ * an unspecified order. The map must not be modified while it is being
+ * iterated.
+ *
+ * @ingroup tizhmap
+ *
+ */
+void
+tiz_hmap_iter_init (const tiz_hmap_t * ap_map, tiz_hmap_iter_t * ap_iter);
+
+/**
+ * Advance an iterator to the next item.
+ *
+ * @ingroup tizhmap
+ *
+ * @param ap_key Receives the item's key (may be NULL).
+ *
+ * @param app_value Receives the item's value (may be NULL).
+ *
+ * @return false when there are no more items, true otherwise.
+ */
+bool
+tiz_hmap_iter_next (tiz_hmap_iter_t * ap_iter, uintptr_t * ap_key,
+                    OMX_PTR * app_value);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TIZHMAP_H */
@@ -23,6 +23,22 @@
  *
  * @brief  Tizonia Platform - Logging API implementation
  *
+ * In asynchronous mode, each logging thread owns a single-producer,
+ * single-consumer ring of fixed-size records, which it finds through a
+ * thread-local pointer. The producer fills in a slot and publishes it by
+ * advancing 'head' with release semantics; the writer thread consumes it and
+ * then advances 'tail'. Producers only take a lock to link a new ring in
+ * the global list (once per thread) and, rarely, to wake up the writer. While
+ * the writer runs, it is the only thread that calls into log4c. A ring is
+ * freed by the writer once its thread has exited and the ring is empty.
+ * A producer that publishes a record after tiz_log_async_stop's final drain
+ * writes its ring out itself.
+ *
+ * When the format only has numeric and pointer conversions, the record
+ * keeps a copy of the format and the raw arguments, and the writer does the
+ * formatting. Otherwise the message is formatted by the producer. Strings
+ * are always copied, since component names and the file and function names
+ * of plugins may be gone by the time the record is written.
  *
  */
 
@@ -30,9 +46,15 @@
 #include <config.h>
 #endif
 
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
 #include <assert.h>
+#include <ctype.h>
+#include <pthread.h>
+#include <sys/time.h>
 #include <sys/types.h>
 #include <sys/stat.h>
 #include <unistd.h>
@@ -47,6 +69,8 @@
 
 #include "tizlog.h"
 
+unsigned int tiz_log_gen = 1;
+
 typedef struct user_locinfo user_locinfo_t;
 struct user_locinfo
 {
@@ -54,6 +78,7 @@ struct user_locinfo
   int tid;
   const char * cname;
   char * cbuf;
+  const struct timeval * p_ts; /* the event's timestamp if NULL */
 };
 
 static const char *
@@ -70,8 +95,10 @@ log_layout_format (const log4c_layout_t * a_layout,
   if (a_event->evt_loc->loc_data)
     {
       struct tm tm;
-      gmtime_r (&a_event->evt_timestamp.tv_sec, &tm);
+      const struct timeval * p_ts = NULL;
       uloc = (user_locinfo_t *) a_event->evt_loc->loc_data;
+      p_ts = uloc->p_ts ? uloc->p_ts : &a_event->evt_timestamp;
+      gmtime_r (&p_ts->tv_sec, &tm);
 
       if (NULL == uloc->cname)
         {
@@ -79,7 +106,7 @@ log_layout_format (const log4c_layout_t * a_layout,
                     "%02d-%02d-%04d %02d:%02d:%02d.%03ld - "
                     "[PID:%i][TID:%i] [%s] [%s] [%s:%s:%i] --- %s\n",
                     tm.tm_mday, tm.tm_mon + 1, tm.tm_year + 1900, tm.tm_hour,
-                    tm.tm_min, tm.tm_sec, a_event->evt_timestamp.tv_usec / 1000,
+                    tm.tm_min, tm.tm_sec, p_ts->tv_usec / 1000,
                     uloc->pid, uloc->tid,
                     log4c_priority_to_string (a_event->evt_priority),
                     a_event->evt_category, a_event->evt_loc->loc_file,
@@ -94,7 +121,7 @@ log_layout_format (const log4c_layout_t * a_layout,
                     "%02d-%02d-%04d %02d:%02d:%02d.%03ld - "
                     "[PID:%i][TID:%i] [%s] [%s] [%s:%s:%i] --- %s\n",
                     tm.tm_mday, tm.tm_mon + 1, tm.tm_year + 1900, tm.tm_hour,
-                    tm.tm_min, tm.tm_sec, a_event->evt_timestamp.tv_usec / 1000,
+                    tm.tm_min, tm.tm_sec, p_ts->tv_usec / 1000,
                     uloc->pid, uloc->tid,
                     log4c_priority_to_string (a_event->evt_priority),
                     uloc->cname, a_event->evt_loc->loc_file,
@@ -125,6 +152,12 @@ static const log4c_layout_type_t * const layout_types[] = {&tizonia_log_layout};
 static int nlayout_types
   = (int) (sizeof (layout_types) / sizeof (layout_types[0]));
 
+static void
+invalidate_log_sites (void)
+{
+  (void) __atomic_add_fetch (&tiz_log_gen, 1, __ATOMIC_RELEASE);
+}
+
 static int
 log_formatters_init (void)
 {
@@ -139,12 +172,770 @@ log_formatters_init (void)
   return rc;
 }
 
+#ifndef WITHOUT_LOG4C
+
+#define LOG_RECORD_TEXT_SIZE 384
+#define LOG_RECORD_MAX_ARGS 8
+#define LOG_SPEC_MAX_LEN 32
+#define LOG_MSG_MAX_LEN 4096
+#define LOG_WRITER_PERIOD_MS 20
+#define LOG_BLOCK_WAIT_NS 100000
+
+typedef enum log_arg_type log_arg_type_t;
+enum log_arg_type
+{
+  ELogArgInt,
+  ELogArgLong,
+  ELogArgLongLong,
+  ELogArgSize,
+  ELogArgIntMax,
+  ELogArgPtrDiff,
+  ELogArgDouble,
+  ELogArgPtr
+};
+
+typedef union log_arg log_arg_t;
+union log_arg
+{
+  long long i;
+  double d;
+  void * p;
+};
+
+/* 'text' holds the file name, the function name, the component name (if
+   any) and either the formatted message or the format string, each one
+   nul-terminated. */
+typedef struct log_record log_record_t;
+struct log_record
+{
+  struct timeval ts;
+  const log4c_category_t * p_cat;
+  int priority;
+  int line;
+  int tid;
+  uint16_t func_off;
+  uint16_t cname_off; /* 0 if there is no component name */
+  uint16_t msg_off;
+  uint8_t nargs;      /* 0 if the message is already formatted */
+  uint8_t arg_types[LOG_RECORD_MAX_ARGS];
+  log_arg_t args[LOG_RECORD_MAX_ARGS];
+  char text[LOG_RECORD_TEXT_SIZE];
+};
+
+typedef struct log_ring log_ring_t;
+struct log_ring
+{
+  log_ring_t * p_next;
+  log_record_t * p_records;
+  uint32_t mask;
+  int tid;
+  bool orphaned;      /* the owner thread has exited */
+  uint64_t reported;  /* drops already reported by the writer */
+  uint64_t head __attribute__ ((aligned (64))); /* owner thread only */
+  uint64_t dropped;                              /* owner thread only */
+  uint64_t tail __attribute__ ((aligned (64))); /* writer only */
+};
+
+typedef struct log_async log_async_t;
+struct log_async
+{
+  bool enabled;
+  bool stop;
+  bool running;
+  uint32_t capacity;
+  tiz_log_overflow_t overflow;
+  pthread_t writer;
+  int pid;
+  pthread_mutex_t mutex;      /* the writer holds it while it writes */
+  pthread_cond_t cond;
+  pthread_mutex_t list_mutex; /* protects 'p_rings' */
+  pthread_key_t key;
+  log_ring_t * p_rings;
+  uint64_t written;
+  uint64_t dropped; /* drops in rings already freed */
+  char msg[LOG_MSG_MAX_LEN];
+  /* The layout writes the record into 'cbuf' when there is a component
+     name. This can't be the component's own buffer, which its thread may
+     be using. */
+  char cbuf[LOG_MSG_MAX_LEN];
+};
+
+static log_async_t g_async = {
+  .mutex = PTHREAD_MUTEX_INITIALIZER,
+  .cond = PTHREAD_COND_INITIALIZER,
+  .list_mutex = PTHREAD_MUTEX_INITIALIZER,
+};
+static pthread_once_t g_async_once = PTHREAD_ONCE_INIT;
+static __thread log_ring_t * tp_log_ring = NULL;
+/* Set once the thread's ring has been handed over to the writer; whatever
+   the thread logs after that (e.g. from other TLS destructors) is written
+   synchronously */
+static __thread bool tp_log_ring_orphaned = false;
+
+/* Unlinks and frees the ring; the caller holds g_async.list_mutex */
+static void
+async_ring_free (log_ring_t * ap_ring)
+{
+  log_ring_t ** pp = &g_async.p_rings;
+  while (*pp != ap_ring)
+    {
+      pp = &(*pp)->p_next;
+    }
+  *pp = ap_ring->p_next;
+  g_async.dropped += ap_ring->dropped;
+  free (ap_ring->p_records);
+  free (ap_ring);
+}
+
+static void
+async_ring_orphan (void * ap_ring)
+{
+  log_ring_t * p_ring = ap_ring;
+  tp_log_ring = NULL;
+  tp_log_ring_orphaned = true;
+  pthread_mutex_lock (&g_async.mutex);
+  if (g_async.running)
+    {
+      /* The writer frees it once it has been drained */
+      __atomic_store_n (&p_ring->orphaned, true, __ATOMIC_RELEASE);
+    }
+  else
+    {
+      /* No writer; tiz_log_async_stop has drained the ring already */
+      pthread_mutex_lock (&g_async.list_mutex);
+      async_ring_free (p_ring);
+      pthread_mutex_unlock (&g_async.list_mutex);
+    }
+  pthread_mutex_unlock (&g_async.mutex);
+}
+
+static void
+async_key_create (void)
+{
+  (void) pthread_key_create (&g_async.key, async_ring_orphan);
+}
+
+static log_ring_t *
+async_ring_attach (void)
+{
+  log_ring_t * p_ring = calloc (1, sizeof (log_ring_t));
+  const uint32_t capacity = __atomic_load_n (&g_async.capacity,
+                                             __ATOMIC_RELAXED);
+  if (p_ring)
+    {
+      p_ring->p_records = calloc (capacity, sizeof (log_record_t));
+      if (!p_ring->p_records)
+        {
+          free (p_ring);
+          return NULL;
+        }
+      p_ring->mask = capacity - 1;
+      p_ring->tid = syscall (SYS_gettid);
+      (void) pthread_setspecific (g_async.key, p_ring);
+      pthread_mutex_lock (&g_async.list_mutex);
+      p_ring->p_next = g_async.p_rings;
+      g_async.p_rings = p_ring;
+      pthread_mutex_unlock (&g_async.list_mutex);
+      tp_log_ring = p_ring;
+    }
+  return p_ring;
+}
+
+/* Never waits: if the mutex is taken, the writer is already busy */
+static void
+async_wake_writer (void)
+{
+  if (0 == pthread_mutex_trylock (&g_async.mutex))
+    {
+      pthread_cond_signal (&g_async.cond);
+      pthread_mutex_unlock (&g_async.mutex);
+    }
+}
+
+static size_t
+record_append (log_record_t * ap_rec, size_t a_off, const char * ap_str)
+{
+  const size_t room = LOG_RECORD_TEXT_SIZE - a_off;
+  size_t len = ap_str ? strlen (ap_str) : 0;
+  assert (a_off < LOG_RECORD_TEXT_SIZE);
+  if (len >= room)
+    {
+      len = room - 1;
+    }
+  memcpy (ap_rec->text + a_off, ap_str, len);
+  ap_rec->text[a_off + len] = '\0';
+  return a_off + len + 1 < LOG_RECORD_TEXT_SIZE ? a_off + len + 1
+                                                : LOG_RECORD_TEXT_SIZE - 1;
+}
+
+/* Finds the type of each argument of a format that has numeric and pointer
+   conversions only. Returns the number of arguments, or -1 if the format
+   can't be deferred. */
+static int
+parse_format (const char * ap_format, uint8_t * ap_types)
+{
+  const char * p = ap_format;
+  int nargs = 0;
+
+  while ((p = strchr (p, '%')))
+    {
+      const char * p_spec = p++;
+      int length = 0; /* 'h' and 'hh' promote to int */
+      log_arg_type_t type = ELogArgInt;
+
+      if ('%' == *p)
+        {
+          p++;
+          continue;
+        }
+      while ('-' == *p || '+' == *p || ' ' == *p || '#' == *p || '0' == *p
+             || '\'' == *p)
+        {
+          p++;
+        }
+      while (isdigit (*p))
+        {
+          p++;
+        }
+      if ('.' == *p)
+        {
+          p++;
+          while (isdigit (*p))
+            {
+              p++;
+            }
+        }
+      while ('h' == *p || 'l' == *p || 'z' == *p || 'j' == *p || 't' == *p)
+        {
+          length = ('l' == *p && 'l' == length) ? 'L' : *p;
+          p++;
+        }
+      if (p - p_spec >= LOG_SPEC_MAX_LEN - 1 || nargs == LOG_RECORD_MAX_ARGS)
+        {
+          return -1;
+        }
+      switch (*p)
+        {
+          case 'c':
+            if (length)
+              {
+                return -1;
+              }
+          /* fall through */
+          case 'd':
+          case 'i':
+          case 'u':
+          case 'o':
+          case 'x':
+          case 'X':
+            type = 'l' == length
+                     ? ELogArgLong
+                     : 'L' == length
+                         ? ELogArgLongLong
+                         : 'z' == length
+                             ? ELogArgSize
+                             : 'j' == length
+                                 ? ELogArgIntMax
+                                 : 't' == length ? ELogArgPtrDiff : ELogArgInt;
+            break;
+          case 'e':
+          case 'E':
+          case 'f':
+          case 'F':
+          case 'g':
+          case 'G':
+          case 'a':
+          case 'A':
+            type = ELogArgDouble;
+            break;
+          case 'p':
+            type = ELogArgPtr;
+            break;
+          default:
+            /* %s, %n, '*' widths, long doubles, etc */
+            return -1;
+        };
+      ap_types[nargs++] = type;
+      p++;
+    }
+  return nargs;
+}
+
+static void
+capture_args (log_record_t * ap_rec, va_list a_va)
+{
+  int i = 0;
+  for (i = 0; i < ap_rec->nargs; ++i)
+    {
+      log_arg_t * p_arg = &ap_rec->args[i];
+      switch (ap_rec->arg_types[i])
+        {
+          case ELogArgInt:
+            p_arg->i = va_arg (a_va, int);
+            break;
+          case ELogArgLong:
+            p_arg->i = va_arg (a_va, long);
+            break;
+          case ELogArgLongLong:
+            p_arg->i = va_arg (a_va, long long);
+            break;
+          case ELogArgSize:
+            p_arg->i = (long long) va_arg (a_va, size_t);
+            break;
+          case ELogArgIntMax:
+            p_arg->i = (long long) va_arg (a_va, intmax_t);
+            break;
+          case ELogArgPtrDiff:
+            p_arg->i = va_arg (a_va, ptrdiff_t);
+            break;
+          case ELogArgDouble:
+            p_arg->d = va_arg (a_va, double);
+            break;
+          case ELogArgPtr:
+          default:
+            p_arg->p = va_arg (a_va, void *);
+            break;
+        };
+    }
+}
+
+/* Formats a deferred record, one conversion at a time */
+static void
+render_args (const log_record_t * ap_rec, char * ap_out, size_t a_size)
+{
+  const char * p = ap_rec->text + ap_rec->msg_off;
+  size_t pos = 0;
+  int i = 0;
+
+  while (*p && pos < a_size - 1)
+    {
+      const char * p_next = strchr (p + ('%' == *p ? 1 : 0), '%');
+      const size_t len = p_next ? (size_t) (p_next - p) : strlen (p);
+      size_t room = a_size - pos;
+      int n = 0;
+
+      if ('%' == *p && '%' == p[1])
+        {
+          ap_out[pos++] = '%';
+          p += 2;
+          continue;
+        }
+      if ('%' != *p)
+        {
+          n = len < room ? (int) len : (int) room - 1;
+          memcpy (ap_out + pos, p, n);
+          pos += n;
+          p += len;
+          continue;
+        }
+
+      /* A conversion specifier, followed by literal text up to the next '%' */
+      {
+        char spec[LOG_SPEC_MAX_LEN];
+        const size_t spec_len = strcspn (p + 1, "diuoxXceEfFgGaAp") + 2;
+        const log_arg_t * p_arg = &ap_rec->args[i];
+        assert (spec_len < LOG_SPEC_MAX_LEN);
+        memcpy (spec, p, spec_len);
+        spec[spec_len] = '\0';
+        switch (ap_rec->arg_types[i++])
+          {
+            case ELogArgInt:
+              n = snprintf (ap_out + pos, room, spec, (int) p_arg->i);
+              break;
+            case ELogArgLong:
+              n = snprintf (ap_out + pos, room, spec, (long) p_arg->i);
+              break;
+            case ELogArgLongLong:
+              n = snprintf (ap_out + pos, room, spec, p_arg->i);
+              break;
+            case ELogArgSize:
+              n = snprintf (ap_out + pos, room, spec, (size_t) p_arg->i);
+              break;
+            case ELogArgIntMax:
+              n = snprintf (ap_out + pos, room, spec, (intmax_t) p_arg->i);
+              break;
+            case ELogArgPtrDiff:
+              n = snprintf (ap_out + pos, room, spec, (ptrdiff_t) p_arg->i);
+              break;
+            case ELogArgDouble:
+              n = snprintf (ap_out + pos, room, spec, p_arg->d);
+              break;
+            case ELogArgPtr:
+            default:
+              n = snprintf (ap_out + pos, room, spec, p_arg->p);
+              break;
+          };
+        pos += (n < 0) ? 0 : ((size_t) n < room ? (size_t) n : room - 1);
+        p += spec_len;
+      }
+    }
+  ap_out[pos] = '\0';
+}
+
+static void
+async_write (const log4c_category_t * ap_cat, int a_priority,
+             const char * ap_file, int a_line, const char * ap_func, int a_tid,
+             const char * ap_cname, const struct timeval * ap_ts,
+             const char * ap_msg)
+{
+  log4c_location_info_t locinfo;
+  user_locinfo_t user_locinfo;
+
+  user_locinfo.pid = g_async.pid;
+  user_locinfo.tid = a_tid;
+  user_locinfo.cname = ap_cname;
+  user_locinfo.cbuf = g_async.cbuf;
+  user_locinfo.p_ts = ap_ts;
+  locinfo.loc_file = ap_file;
+  locinfo.loc_line = a_line;
+  locinfo.loc_function = ap_func;
+  locinfo.loc_data = &user_locinfo;
+
+  log4c_category_log_locinfo (ap_cat, &locinfo, a_priority, "%s", ap_msg);
+}
+
+static void
+async_write_record (const log_record_t * ap_rec)
+{
+  const char * p_msg = ap_rec->text + ap_rec->msg_off;
+  if (ap_rec->nargs > 0)
+    {
+      render_args (ap_rec, g_async.msg, sizeof (g_async.msg));
+      p_msg = g_async.msg;
+    }
+  async_write (ap_rec->p_cat, ap_rec->priority, ap_rec->text, ap_rec->line,
+               ap_rec->text + ap_rec->func_off, ap_rec->tid,
+               ap_rec->cname_off ? ap_rec->text + ap_rec->cname_off : NULL,
+               &ap_rec->ts, p_msg);
+}
+
+static void
+async_report_drops (log_ring_t * ap_ring)
+{
+  const uint64_t dropped = __atomic_load_n (&ap_ring->dropped,
+                                            __ATOMIC_RELAXED);
+  if (dropped != ap_ring->reported)
+    {
+      char msg[128];
+      snprintf (msg, sizeof (msg), "%llu log records dropped (ring full)",
+                (unsigned long long) (dropped - ap_ring->reported));
+      async_write (log4c_category_get ("tiz.platform.log"),
+                   LOG4C_PRIORITY_WARN, __FILE__, __LINE__, __FUNCTION__,
+                   ap_ring->tid, NULL, NULL, msg);
+      ap_ring->reported = dropped;
+    }
+}
+
+/* Writes out what has been queued in a ring; the caller holds
+   g_async.mutex */
+static void
+async_ring_drain (log_ring_t * ap_ring)
+{
+  const uint64_t head = __atomic_load_n (&ap_ring->head, __ATOMIC_ACQUIRE);
+  uint64_t tail = ap_ring->tail;
+
+  for (; tail != head; ++tail)
+    {
+      async_write_record (&ap_ring->p_records[tail & ap_ring->mask]);
+      g_async.written++;
+    }
+  __atomic_store_n (&ap_ring->tail, tail, __ATOMIC_RELEASE);
+  async_report_drops (ap_ring);
+}
+
+/* Writes out everything that has been queued so far, and frees the rings of
+   the threads that have exited; the caller holds g_async.mutex */
+static void
+async_drain (void)
+{
+  log_ring_t * p_ring = NULL;
+
+  /* Rings are only ever pushed at the front of the list */
+  pthread_mutex_lock (&g_async.list_mutex);
+  p_ring = g_async.p_rings;
+  pthread_mutex_unlock (&g_async.list_mutex);
+
+  while (p_ring)
+    {
+      log_ring_t * p_next = p_ring->p_next;
+      const bool orphaned = __atomic_load_n (&p_ring->orphaned,
+                                             __ATOMIC_ACQUIRE);
+      async_ring_drain (p_ring);
+
+      if (orphaned)
+        {
+          /* New rings may have been pushed in front of this one */
+          pthread_mutex_lock (&g_async.list_mutex);
+          async_ring_free (p_ring);
+          pthread_mutex_unlock (&g_async.list_mutex);
+        }
+      p_ring = p_next;
+    }
+}
+
+/* Called by a producer that finds asynchronous logging disabled after
+   publishing a record. Once the writer is gone, tiz_log_async_stop's final
+   drain may have missed the record, so the producer writes out its own
+   ring. */
+static void
+async_ring_flush (log_ring_t * ap_ring)
+{
+  pthread_mutex_lock (&g_async.mutex);
+  if (!g_async.running)
+    {
+      async_ring_drain (ap_ring);
+    }
+  pthread_mutex_unlock (&g_async.mutex);
+}
+
+/* Returns false if the record could not be queued and must be logged
+   synchronously */
+static bool
+async_push (const log4c_category_t * ap_category, const char * ap_file,
+            int a_line, const char * ap_func, int a_priority,
+            const char * ap_cname, const char * ap_format, va_list a_va)
+{
+  log_ring_t * p_ring = tp_log_ring;
+  log_record_t * p_rec = NULL;
+  uint64_t head = 0;
+  size_t off = 0;
+  int nargs = 0;
+
+  if (!p_ring)
+    {
+      if (tp_log_ring_orphaned)
+        {
+          return false;
+        }
+      p_ring = async_ring_attach ();
+      if (!p_ring)
+        {
+          return false;
+        }
+    }
+
+  head = p_ring->head;
+  while (head - __atomic_load_n (&p_ring->tail, __ATOMIC_ACQUIRE)
+         > p_ring->mask)
+    {
+      if (TIZ_LOG_OVERFLOW_BLOCK != g_async.overflow)
+        {
+          __atomic_store_n (&p_ring->dropped, p_ring->dropped + 1,
+                            __ATOMIC_RELAXED);
+          return true;
+        }
+      if (!__atomic_load_n (&g_async.enabled, __ATOMIC_ACQUIRE))
+        {
+          return false;
+        }
+      async_wake_writer ();
+      {
+        const struct timespec wait = {0, LOG_BLOCK_WAIT_NS};
+        (void) nanosleep (&wait, NULL);
+      }
+    }
+
+  p_rec = &p_ring->p_records[head & p_ring->mask];
+  (void) gettimeofday (&p_rec->ts, NULL);
+  p_rec->p_cat = ap_category;
+  p_rec->priority = a_priority;
+  p_rec->line = a_line;
+  p_rec->tid = p_ring->tid;
+  off = record_append (p_rec, 0, ap_file);
+  p_rec->func_off = off;
+  off = record_append (p_rec, off, ap_func);
+  p_rec->cname_off = 0;
+  if (ap_cname)
+    {
+      p_rec->cname_off = off;
+      off = record_append (p_rec, off, ap_cname);
+    }
+  p_rec->msg_off = off;
+
+  nargs = parse_format (ap_format, p_rec->arg_types);
+  if (nargs > 0 && strlen (ap_format) < LOG_RECORD_TEXT_SIZE - off)
+    {
+      p_rec->nargs = nargs;
+      (void) record_append (p_rec, off, ap_format);
+      capture_args (p_rec, a_va);
+    }
+  else
+    {
+      p_rec->nargs = 0;
+      (void) vsnprintf (p_rec->text + off, LOG_RECORD_TEXT_SIZE - off,
+                        ap_format, a_va);
+    }
+
+  /* This store and the load of 'enabled' below pair with
+     tiz_log_async_stop's store and final drain: either the drain sees the
+     record, or the producer sees logging disabled */
+  __atomic_store_n (&p_ring->head, head + 1, __ATOMIC_SEQ_CST);
+
+  if (!__atomic_load_n (&g_async.enabled, __ATOMIC_SEQ_CST))
+    {
+      async_ring_flush (p_ring);
+      return true;
+    }
+
+  /* Don't wait for the writer's next period if the ring is filling up */
+  if (head + 1 - __atomic_load_n (&p_ring->tail, __ATOMIC_RELAXED)
+      == (p_ring->mask + 1) / 2)
+    {
+      async_wake_writer ();
+    }
+  return true;
+}
+
+static void *
+async_writer_func (void * ap_arg)
+{
+  (void) ap_arg;
+  (void) pthread_setname_np (pthread_self (), "tizlogwriter");
+
+  pthread_mutex_lock (&g_async.mutex);
+  while (!g_async.stop)
+    {
+      struct timespec deadline;
+      async_drain ();
+      (void) clock_gettime (CLOCK_REALTIME, &deadline);
+      deadline.tv_nsec += LOG_WRITER_PERIOD_MS * 1000000L;
+      if (deadline.tv_nsec >= 1000000000L)
+        {
+          deadline.tv_sec++;
+          deadline.tv_nsec -= 1000000000L;
+        }
+      (void) pthread_cond_timedwait (&g_async.cond, &g_async.mutex, &deadline);
+    }
+  async_drain ();
+  pthread_mutex_unlock (&g_async.mutex);
+  return NULL;
+}
+
+static uint32_t
+round_up_pow2 (uint32_t a_value)
+{
+  uint32_t value = 1;
+  while (value < a_value)
+    {
+      value <<= 1;
+    }
+  return value;
+}
+
+#endif
+
+int
+tiz_log_async_start (unsigned int a_records_per_thread,
+                     tiz_log_overflow_t a_overflow)
+{
+#ifndef WITHOUT_LOG4C
+  int rc = 0;
+  (void) pthread_once (&g_async_once, async_key_create);
+  pthread_mutex_lock (&g_async.mutex);
+  if (!g_async.running)
+    {
+      g_async.capacity = round_up_pow2 (
+        a_records_per_thread ? a_records_per_thread
+                             : TIZ_LOG_ASYNC_DEFAULT_RECORDS);
+      g_async.overflow = a_overflow;
+      g_async.pid = getpid ();
+      g_async.stop = false;
+      rc = pthread_create (&g_async.writer, NULL, async_writer_func, NULL);
+      if (0 == rc)
+        {
+          g_async.running = true;
+          __atomic_store_n (&g_async.enabled, true, __ATOMIC_RELEASE);
+        }
+    }
+  pthread_mutex_unlock (&g_async.mutex);
+  return 0 == rc ? 0 : -1;
+#else
+  return -1;
+#endif
+}
+
+int
+tiz_log_async_stop (void)
+{
+#ifndef WITHOUT_LOG4C
+  bool running = false;
+  pthread_mutex_lock (&g_async.mutex);
+  running = g_async.running;
+  __atomic_store_n (&g_async.enabled, false, __ATOMIC_SEQ_CST);
+  g_async.stop = true;
+  pthread_cond_signal (&g_async.cond);
+  pthread_mutex_unlock (&g_async.mutex);
+  if (running)
+    {
+      (void) pthread_join (g_async.writer, NULL);
+      pthread_mutex_lock (&g_async.mutex);
+      g_async.running = false;
+      /* Threads may have exited after the writer's last drain; from now on,
+         exiting threads free their own rings, and producers that published
+         after this drain write out their own records */
+      __atomic_thread_fence (__ATOMIC_SEQ_CST);
+      async_drain ();
+      pthread_mutex_unlock (&g_async.mutex);
+    }
+#endif
+  return 0;
+}
+
+bool
+tiz_log_async_enabled (void)
+{
+#ifndef WITHOUT_LOG4C
+  return __atomic_load_n (&g_async.enabled, __ATOMIC_ACQUIRE);
+#else
+  return false;
+#endif
+}
+
+void
+tiz_log_async_stats (unsigned long long * ap_written,
+                     unsigned long long * ap_dropped)
+{
+#ifndef WITHOUT_LOG4C
+  unsigned long long dropped = 0;
+  log_ring_t * p_ring = NULL;
+  pthread_mutex_lock (&g_async.mutex);
+  dropped = g_async.dropped;
+  pthread_mutex_lock (&g_async.list_mutex);
+  for (p_ring = g_async.p_rings; p_ring; p_ring = p_ring->p_next)
+    {
+      dropped += __atomic_load_n (&p_ring->dropped, __ATOMIC_RELAXED);
+    }
+  pthread_mutex_unlock (&g_async.list_mutex);
+  if (ap_written)
+    {
+      *ap_written = g_async.written;
+    }
+  if (ap_dropped)
+    {
+      *ap_dropped = dropped;
+    }
+  pthread_mutex_unlock (&g_async.mutex);
+#else
+  if (ap_written)
+    {
+      *ap_written = 0;
+    }
+  if (ap_dropped)
+    {
+      *ap_dropped = 0;
+    }
+#endif
+}
+
 int
 tiz_log_init (void)
 {
 #ifndef WITHOUT_LOG4C
+  int rc = 0;
   log_formatters_init ();
-  return log4c_init ();
+  rc = log4c_init ();
+  invalidate_log_sites ();
+  return rc;
 #else
   return 0;
 #endif
@@ -162,6 +953,10 @@ tiz_log_set_unique_rolling_file (const char * ap_logdir,
       return;
     }
 
+#ifndef WITHOUT_LOG4C
+  /* Don't change the appender under the writer thread's feet */
+  pthread_mutex_lock (&g_async.mutex);
+#endif
   {
     log4c_appender_t * app = log4c_appender_get ("tizlogfile");
 
@@ -191,48 +986,96 @@ tiz_log_set_unique_rolling_file (const char * ap_logdir,
           }
       }
   }
+#ifndef WITHOUT_LOG4C
+  pthread_mutex_unlock (&g_async.mutex);
+#endif
 }
 
 int
 tiz_log_deinit (void)
 {
 #ifndef WITHOUT_LOG4C
+  /* Flush the queued records while their categories still exist */
+  (void) tiz_log_async_stop ();
+  /* Sites must not hold on to categories that log4c is about to delete */
+  invalidate_log_sites ();
   return log4c_fini ();
 #else
   return 0;
 #endif
 }
 
+int
+tiz_log_site_refresh (tiz_log_site_t * ap_site, const char * ap_cat_name)
+{
+  /* Read the generation first; if the configuration changes while the site
+     is being refreshed, the site is left stale and refreshed again */
+  const unsigned int gen = __atomic_load_n (&tiz_log_gen, __ATOMIC_ACQUIRE);
+#ifndef WITHOUT_LOG4C
+  const log4c_category_t * p_category = log4c_category_get (ap_cat_name);
+  const int priority = log4c_category_get_chainedpriority (p_category);
+#else
+  const void * p_category = NULL;
+  const int priority = TIZ_PRIORITY_TRACE;
+#endif
+  assert (ap_site);
+  __atomic_store_n (&ap_site->p_cat, p_category, __ATOMIC_RELAXED);
+  __atomic_store_n (&ap_site->priority, priority, __ATOMIC_RELAXED);
+  __atomic_store_n (&ap_site->gen, gen, __ATOMIC_RELEASE);
+  return priority;
+}
+
+#ifndef WITHOUT_LOG4C
+static void
+log_to_category (const log4c_category_t * ap_category, const char * ap_file,
+                 int a_line, const char * ap_func, int a_priority,
+                 const char * ap_cname, char * ap_cbuf,
+                 const char * ap_format, va_list a_va)
+{
+  log4c_location_info_t locinfo;
+  user_locinfo_t user_locinfo;
+  char * buffer = NULL;
+
+  if (__atomic_load_n (&g_async.enabled, __ATOMIC_ACQUIRE)
+      && async_push (ap_category, ap_file, a_line, ap_func, a_priority,
+                     ap_cname, ap_format, a_va))
+    {
+      return;
+    }
+
+  /* TODO: 4096 - this value should be obtained at config time */
+  buffer = alloca (4096);
+  user_locinfo.pid = getpid ();
+  user_locinfo.tid = syscall (SYS_gettid);
+  user_locinfo.cname = ap_cname;
+  user_locinfo.cbuf = ap_cbuf;
+  user_locinfo.p_ts = NULL;
+  locinfo.loc_file = ap_file;
+  locinfo.loc_line = a_line;
+  locinfo.loc_function = ap_func;
+  /*          locinfo.loc_data = NULL; */
+  locinfo.loc_data = &user_locinfo;
+
+  vsprintf (buffer, ap_format, a_va);
+  log4c_category_log_locinfo (ap_category, &locinfo, a_priority, "%s",
+                              buffer);
+}
+#endif
+
 void
 tiz_log (const char * ap_file, int a_line, const char * ap_func,
          const char * ap_cat_name, int a_priority, const char * ap_cname,
          char * ap_cbuf, const char * ap_format, ...)
 {
 #ifndef WITHOUT_LOG4C
-  log4c_location_info_t locinfo;
-  user_locinfo_t user_locinfo;
-
   const log4c_category_t * p_category = log4c_category_get (ap_cat_name);
   if (log4c_category_is_priority_enabled (p_category, a_priority))
     {
-      /* TODO: 4096 - this value should be obtained at config time */
-      char * buffer = alloca (4096);
-      user_locinfo.pid = getpid ();
-      user_locinfo.tid = syscall (SYS_gettid);
-      user_locinfo.cname = ap_cname;
-      user_locinfo.cbuf = ap_cbuf;
-      locinfo.loc_file = ap_file;
-      locinfo.loc_line = a_line;
-      locinfo.loc_function = ap_func;
-      /*          locinfo.loc_data = NULL; */
-      locinfo.loc_data = &user_locinfo;
-
       va_list va;
       va_start (va, ap_format);
-      vsprintf (buffer, ap_format, va);
+      log_to_category (p_category, ap_file, a_line, ap_func, a_priority,
+                       ap_cname, ap_cbuf, ap_format, va);
       va_end (va);
-      log4c_category_log_locinfo (p_category, &locinfo, a_priority, "%s",
-                                  buffer);
     }
 #else
 
@@ -245,6 +1088,26 @@ tiz_log (const char * ap_file, int a_line, const char * ap_func,
 #endif
 }
 
+void
+tiz_log_at (const tiz_log_site_t * ap_site, const char * ap_file, int a_line,
+            const char * ap_func, int a_priority, const char * ap_cname,
+            char * ap_cbuf, const char * ap_format, ...)
+{
+  va_list va;
+  assert (ap_site);
+  va_start (va, ap_format);
+#ifndef WITHOUT_LOG4C
+  /* The caller has already checked the priority against the site */
+  log_to_category (__atomic_load_n (&ap_site->p_cat, __ATOMIC_RELAXED),
+                   ap_file, a_line, ap_func, a_priority, ap_cname, ap_cbuf,
+                   ap_format, va);
+#else
+  vprintf (ap_format, va);
+  printf ("\n");
+#endif
+  va_end (va);
+}
+
 /*  TODO: Allow override the logging configuration via command line */
 /*        const int overwrite = 1; */
 /*        setenv("LOG4C_PRIORITY", "error", overwrite); */
@@ -33,6 +33,8 @@
 extern "C" {
 #endif
 
+#include <stdbool.h>
+
 #include <log4c.h>
 
 #ifndef TIZ_LOG_CATEGORY_NAME
@@ -41,10 +43,6 @@ extern "C" {
 
 /* #define WITHOUT_LOG4C 1 */
 
-#define TIZ_LOG(priority, format, args...)                                    \
-  tiz_log (__FILE__, __LINE__, __FUNCTION__, TIZ_LOG_CATEGORY_NAME, priority, \
-           NULL, NULL, format, ##args);
-
 #ifndef WITHOUT_LOG4C
 #define TIZ_PRIORITY_ERROR LOG4C_PRIORITY_ERROR
 #define TIZ_PRIORITY_WARN LOG4C_PRIORITY_WARN
@@ -59,6 +57,70 @@ extern "C" {
 #define TIZ_PRIORITY_TRACE 5
 #endif
 
+/* The most verbose priority that is compiled in. Log statements with a less
+ * severe priority compile to nothing, and their arguments are never
+ * evaluated. E.g. 'meson -Dlog-min-level=debug' (or
+ * CPPFLAGS=-DTIZ_LOG_MIN_LEVEL=TIZ_PRIORITY_DEBUG with autotools) removes every
+ * trace statement from the build. */
+#ifndef TIZ_LOG_MIN_LEVEL
+#define TIZ_LOG_MIN_LEVEL TIZ_PRIORITY_TRACE
+#endif
+
+/* Every log statement caches its category and the category's priority in a
+ * static tiz_log_site_t. The cache is refreshed whenever tiz_log_init or
+ * tiz_log_deinit change the log configuration, so a disabled statement costs
+ * two loads and a compare, and does not evaluate its arguments. log4c's
+ * 'reread' option is not honoured: edits to the rc file are only seen after
+ * tiz_log_deinit and tiz_log_init. */
+#define TIZ_LOG_SITE(priority, cname, cbuf, format, args...)                 \
+  do                                                                         \
+    {                                                                        \
+      static tiz_log_site_t s_tiz_log_site = {NULL, 0, 0};                   \
+      if ((priority) <= TIZ_LOG_MIN_LEVEL                                    \
+          && tiz_log_site_enabled (&s_tiz_log_site, TIZ_LOG_CATEGORY_NAME,   \
+                                   (priority)))                              \
+        {                                                                    \
+          tiz_log_at (&s_tiz_log_site, __FILE__, __LINE__, __FUNCTION__,     \
+                      (priority), cname, cbuf, format, ##args);              \
+        }                                                                    \
+    }                                                                        \
+  while (0)
+
+#define TIZ_LOG(priority, format, args...) \
+  TIZ_LOG_SITE (priority, NULL, NULL, format, ##args)
+
+typedef struct tiz_log_site tiz_log_site_t;
+struct tiz_log_site
+{
+  const void * p_cat;
+  int priority;
+  unsigned int gen;
+};
+
+/* Bumped every time the log configuration changes; a site whose gen differs
+ * needs refreshing. Do not modify. */
+extern unsigned int tiz_log_gen;
+
+int
+tiz_log_site_refresh (tiz_log_site_t * ap_site, const char * ap_cat_name);
+
+static inline int
+tiz_log_site_enabled (tiz_log_site_t * ap_site, const char * ap_cat_name,
+                      int a_priority)
+{
+  int priority = 0;
+  if (__atomic_load_n (&ap_site->gen, __ATOMIC_ACQUIRE)
+      == __atomic_load_n (&tiz_log_gen, __ATOMIC_RELAXED))
+    {
+      priority = __atomic_load_n (&ap_site->priority, __ATOMIC_RELAXED);
+    }
+  else
+    {
+      priority = tiz_log_site_refresh (ap_site, ap_cat_name);
+    }
+  return a_priority <= priority;
+}
+
 int
 tiz_log_init (void);
 void
@@ -66,12 +128,48 @@ tiz_log_set_unique_rolling_file (const char * ap_logdir,
                                  const char * ap_file_prefix);
 int
 tiz_log_deinit (void);
+
+/* Asynchronous mode: log statements queue their records in a per-thread ring
+ * and return; a background thread writes them out. tiz_log_deinit stops it,
+ * after writing out the queued records. Each record takes about 512 bytes;
+ * longer messages are truncated. */
+#define TIZ_LOG_ASYNC_DEFAULT_RECORDS 256
+
+typedef enum tiz_log_overflow tiz_log_overflow_t;
+enum tiz_log_overflow
+{
+  TIZ_LOG_OVERFLOW_DROP, /* discard the new record, and count it */
+  TIZ_LOG_OVERFLOW_BLOCK /* wait until the writer thread makes room */
+};
+
+/* a_records_per_thread is rounded up to a power of two (zero means
+ * TIZ_LOG_ASYNC_DEFAULT_RECORDS). Returns 0 on success (or if already
+ * started). */
+int
+tiz_log_async_start (unsigned int a_records_per_thread,
+                     tiz_log_overflow_t a_overflow);
+/* Writes out the queued records and goes back to synchronous logging. Best
+ * called when the other threads have stopped logging. */
+int
+tiz_log_async_stop (void);
+bool
+tiz_log_async_enabled (void);
+/* Totals since the process started; both pointers may be NULL */
+void
+tiz_log_async_stats (unsigned long long * ap_written,
+                     unsigned long long * ap_dropped);
 void
 tiz_log (const char * __p_file, int __line, const char * __p_func,
          const char * __p_cat_name, int __priority,
          /*@null@ */ const char * __p_cname,
          /*@null@ */ char * __p_cbuf,
          /*@null@ */ const char * __p_format, ...);
+void
+tiz_log_at (const tiz_log_site_t * __p_site, const char * __p_file, int __line,
+            const char * __p_func, int __priority,
+            /*@null@ */ const char * __p_cname,
+            /*@null@ */ char * __p_cbuf,
+            /*@null@ */ const char * __p_format, ...);
 
 #ifdef __cplusplus
 }
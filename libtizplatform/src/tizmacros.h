@@ -170,7 +170,7 @@ extern "C" {
         }                                                      \
       else                                                     \
         {                                                      \
-          TIZ_LOG (TIZ_PRIORITY_ERROR, "[NULL] : [%s]", #expr) \
+          TIZ_LOG (TIZ_PRIORITY_ERROR, "[NULL] : [%s]", #expr); \
           return NULL;                                         \
         }                                                      \
     }                                                          \
@@ -30,23 +30,783 @@
 #include <config.h>
 #endif
 
+#include <assert.h>
+#include <pthread.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
 #include "tizplatform.h"
 
+#define MEM_GUARD_SZ 16
+#define MEM_GUARD_BYTE 0xfd
+#define MEM_FRESH_BYTE 0xa5
+#define MEM_FREED_BYTE 0x5a
+#define MEM_REGISTRY_MIN_SLOTS 64
+#define MEM_REGISTRY_SHARD_BITS 4
+#define MEM_REGISTRY_NSHARDS (1 << MEM_REGISTRY_SHARD_BITS)
+
+struct tiz_mem_account
+{
+  uint64_t bytes;
+  uint64_t peak_bytes;
+  uint64_t allocs;
+  uint64_t frees;
+  uint64_t failures;
+  uint64_t limit;
+  uint32_t refs; /* the owner's, plus one per live allocation */
+};
+
+/* The blocks charged to an account that are not small objects (whose tag
+   names the account), every block of a custom backend and every block of
+   the debug backend are recorded in a registry keyed by address. Memory that
+   isn't found there comes straight from the C library (e.g. strdup'ed
+   strings) and is released by it; nothing outside a block is ever read to
+   find out who owns it. The registry is a set of hash tables (linear
+   probing, backward-shift deletion), each with its own lock, and its memory
+   comes straight from the C library. */
+typedef struct mem_record mem_record_t;
+struct mem_record
+{
+  void * p_addr; /* NULL if the slot is free */
+  size_t size;
+  tiz_mem_account_t * p_account;
+  bool debug;
+};
+
+typedef struct mem_registry mem_registry_t;
+struct mem_registry
+{
+  pthread_mutex_t mutex;
+  mem_record_t * p_slots;
+  size_t capacity; /* a power of two */
+  size_t count;
+} __attribute__ ((aligned (64)));
+
+static mem_registry_t g_mem_registry[MEM_REGISTRY_NSHARDS]
+  = {[0 ... MEM_REGISTRY_NSHARDS - 1] = {PTHREAD_MUTEX_INITIALIZER, NULL, 0, 0}};
+
+static pthread_once_t g_mem_once = PTHREAD_ONCE_INIT;
+static tiz_mem_backend_type_t g_mem_backend = ETIZMemBackendDefault;
+static tiz_mem_backend_t g_mem_custom = {NULL, NULL, NULL};
+/* Set once the default backend has been used; never reset, as it may still
+   own memory */
+static tiz_soa_t * gp_mem_soa = NULL;
+static bool g_mem_used = false;
+static __thread tiz_mem_account_t * tp_mem_account = NULL;
+
+static void
+init_mem (void)
+{
+  const char * p_env = getenv ("TIZONIA_MEM_BACKEND");
+
+  if (p_env && 0 == strncmp (p_env, "libc", 5))
+    {
+      g_mem_backend = ETIZMemBackendLibc;
+    }
+  else if (p_env && 0 == strncmp (p_env, "debug", 6))
+    {
+      g_mem_backend = ETIZMemBackendDebug;
+    }
+  else
+    {
+      gp_mem_soa = tiz_soa_shared ();
+    }
+}
+
+static inline tiz_mem_backend_type_t
+get_backend (void)
+{
+  (void) pthread_once (&g_mem_once, init_mem);
+  return __atomic_load_n (&g_mem_backend, __ATOMIC_ACQUIRE);
+}
+
+static inline tiz_soa_t *
+get_soa (void)
+{
+  (void) pthread_once (&g_mem_once, init_mem);
+  return __atomic_load_n (&gp_mem_soa, __ATOMIC_ACQUIRE);
+}
+
+/*
+ * Accounts
+ */
+
+static void
+unref_account (tiz_mem_account_t * ap_account)
+{
+  if (0 == __atomic_sub_fetch (&(ap_account->refs), 1, __ATOMIC_ACQ_REL))
+    {
+      free (ap_account);
+    }
+}
+
+static inline void
+update_peak (tiz_mem_account_t * ap_account, const uint64_t a_bytes)
+{
+  uint64_t peak = __atomic_load_n (&(ap_account->peak_bytes), __ATOMIC_RELAXED);
+  while (a_bytes > peak
+         && !__atomic_compare_exchange_n (&(ap_account->peak_bytes), &peak,
+                                          a_bytes, true, __ATOMIC_RELAXED,
+                                          __ATOMIC_RELAXED))
+    {
+    }
+}
+
+/* The limit is checked before the allocation is made, so concurrent
+   allocations may overshoot it slightly */
+static bool
+may_charge (tiz_mem_account_t * ap_account, const size_t a_size)
+{
+  const uint64_t limit
+    = __atomic_load_n (&(ap_account->limit), __ATOMIC_RELAXED);
+
+  if (limit > 0
+      && __atomic_load_n (&(ap_account->bytes), __ATOMIC_RELAXED) + a_size
+           > limit)
+    {
+      (void) __atomic_add_fetch (&(ap_account->failures), 1, __ATOMIC_RELAXED);
+      return false;
+    }
+  return true;
+}
+
+static void
+charge (tiz_mem_account_t * ap_account, const size_t a_size)
+{
+  (void) __atomic_add_fetch (&(ap_account->refs), 1, __ATOMIC_RELAXED);
+  (void) __atomic_add_fetch (&(ap_account->allocs), 1, __ATOMIC_RELAXED);
+  update_peak (ap_account, __atomic_add_fetch (&(ap_account->bytes), a_size,
+                                               __ATOMIC_RELAXED));
+}
+
+static void
+discharge (tiz_mem_account_t * ap_account, const size_t a_size)
+{
+  (void) __atomic_sub_fetch (&(ap_account->bytes), a_size, __ATOMIC_RELAXED);
+  (void) __atomic_add_fetch (&(ap_account->frees), 1, __ATOMIC_RELAXED);
+  unref_account (ap_account);
+}
+
+static void
+recharge (tiz_mem_account_t * ap_account, const size_t a_old_size,
+          const size_t a_new_size)
+{
+  if (a_new_size >= a_old_size)
+    {
+      update_peak (ap_account,
+                   __atomic_add_fetch (&(ap_account->bytes),
+                                       a_new_size - a_old_size,
+                                       __ATOMIC_RELAXED));
+    }
+  else
+    {
+      (void) __atomic_sub_fetch (&(ap_account->bytes), a_old_size - a_new_size,
+                                 __ATOMIC_RELAXED);
+    }
+}
+
+/*
+ * Registry
+ */
+
+static inline uint64_t
+registry_hash (const void * ap_addr)
+{
+  return ((uint64_t) (uintptr_t) ap_addr >> 4) * 0x9e3779b97f4a7c15ULL;
+}
+
+/* The shard comes from the top bits of the hash, the home slot from the
+   middle ones */
+static inline mem_registry_t *
+registry_shard (const void * ap_addr)
+{
+  return &(g_mem_registry[registry_hash (ap_addr)
+                          >> (64 - MEM_REGISTRY_SHARD_BITS)]);
+}
+
+static inline size_t
+registry_home (const mem_registry_t * ap_reg, const void * ap_addr)
+{
+  return (size_t) (registry_hash (ap_addr) >> 28) & (ap_reg->capacity - 1);
+}
+
+static mem_record_t *
+registry_lookup (const mem_registry_t * ap_reg, const void * ap_addr)
+{
+  size_t i = 0;
+
+  if (0 == ap_reg->count)
+    {
+      return NULL;
+    }
+
+  for (i = registry_home (ap_reg, ap_addr); ap_reg->p_slots[i].p_addr;
+       i = (i + 1) & (ap_reg->capacity - 1))
+    {
+      if (ap_reg->p_slots[i].p_addr == ap_addr)
+        {
+          return &(ap_reg->p_slots[i]);
+        }
+    }
+  return NULL;
+}
+
+static void
+registry_place (mem_registry_t * ap_reg, const mem_record_t * ap_rec)
+{
+  size_t i = registry_home (ap_reg, ap_rec->p_addr);
+  while (ap_reg->p_slots[i].p_addr)
+    {
+      i = (i + 1) & (ap_reg->capacity - 1);
+    }
+  ap_reg->p_slots[i] = *ap_rec;
+}
+
+static bool
+registry_grow (mem_registry_t * ap_reg)
+{
+  const size_t old_capacity = ap_reg->capacity;
+  mem_record_t * p_old = ap_reg->p_slots;
+  size_t i = 0;
+  size_t capacity
+    = old_capacity ? old_capacity * 2 : MEM_REGISTRY_MIN_SLOTS;
+  mem_record_t * p_slots = calloc (capacity, sizeof (mem_record_t));
+
+  if (!p_slots)
+    {
+      return false;
+    }
+
+  ap_reg->p_slots = p_slots;
+  ap_reg->capacity = capacity;
+  for (i = 0; i < old_capacity; ++i)
+    {
+      if (p_old[i].p_addr)
+        {
+          registry_place (ap_reg, &(p_old[i]));
+        }
+    }
+  free (p_old);
+  return true;
+}
+
+static void
+registry_remove (mem_registry_t * ap_reg, mem_record_t * ap_rec)
+{
+  const size_t mask = ap_reg->capacity - 1;
+  size_t hole = (size_t) (ap_rec - ap_reg->p_slots);
+  size_t i = (hole + 1) & mask;
+
+  /* Shift back the records that were displaced past the hole */
+  while (ap_reg->p_slots[i].p_addr)
+    {
+      const size_t home = registry_home (ap_reg, ap_reg->p_slots[i].p_addr);
+      if (((i - home) & mask) >= ((i - hole) & mask))
+        {
+          ap_reg->p_slots[hole] = ap_reg->p_slots[i];
+          hole = i;
+        }
+      i = (i + 1) & mask;
+    }
+  ap_reg->p_slots[hole].p_addr = NULL;
+  __atomic_store_n (&(ap_reg->count), ap_reg->count - 1, __ATOMIC_RELAXED);
+}
+
+static bool
+registry_insert (void * ap_addr, const size_t a_size,
+                 tiz_mem_account_t * ap_account, const bool a_debug)
+{
+  mem_registry_t * p_reg = registry_shard (ap_addr);
+  const mem_record_t rec = {ap_addr, a_size, ap_account, a_debug};
+  bool rc = true;
+
+  (void) pthread_mutex_lock (&(p_reg->mutex));
+  if ((p_reg->count + 1) * 4 > p_reg->capacity * 3)
+    {
+      rc = registry_grow (p_reg);
+    }
+  if (rc)
+    {
+      registry_place (p_reg, &rec);
+      __atomic_store_n (&(p_reg->count), p_reg->count + 1, __ATOMIC_RELAXED);
+    }
+  (void) pthread_mutex_unlock (&(p_reg->mutex));
+  return rc;
+}
+
+/* Copy out, and optionally remove, the record of an address */
+static bool
+registry_find (void * ap_addr, mem_record_t * ap_rec, const bool a_remove)
+{
+  mem_registry_t * p_reg = registry_shard (ap_addr);
+  mem_record_t * p_rec = NULL;
+
+  /* The caller owns the memory, so if it was registered, the record is
+     visible by now */
+  if (0 == __atomic_load_n (&(p_reg->count), __ATOMIC_RELAXED))
+    {
+      return false;
+    }
+
+  (void) pthread_mutex_lock (&(p_reg->mutex));
+  if ((p_rec = registry_lookup (p_reg, ap_addr)))
+    {
+      if (ap_rec)
+        {
+          *ap_rec = *p_rec;
+        }
+      if (a_remove)
+        {
+          registry_remove (p_reg, p_rec);
+        }
+    }
+  (void) pthread_mutex_unlock (&(p_reg->mutex));
+  return p_rec != NULL;
+}
+
+static bool
+track (void * ap_addr, const size_t a_size, tiz_mem_account_t * ap_account,
+       const bool a_debug)
+{
+  if (!registry_insert (ap_addr, a_size, ap_account, a_debug))
+    {
+      return false;
+    }
+  if (ap_account)
+    {
+      charge (ap_account, a_size);
+    }
+  return true;
+}
+
+/*
+ * Backends
+ */
+
+static inline bool
+guard_intact (const uint8_t * ap_mem, const size_t a_size)
+{
+  size_t i = 0;
+  for (i = 0; i < MEM_GUARD_SZ; ++i)
+    {
+      if (MEM_GUARD_BYTE != ap_mem[a_size + i])
+        {
+          return false;
+        }
+    }
+  return true;
+}
+
+static void *
+debug_alloc (tiz_mem_account_t * ap_account, const size_t a_size,
+             const bool a_clear)
+{
+  uint8_t * p_mem = NULL;
+
+  if (a_size > SIZE_MAX - MEM_GUARD_SZ
+      || !(p_mem = malloc (a_size + MEM_GUARD_SZ)))
+    {
+      return NULL;
+    }
+
+  (void) memset (p_mem, a_clear ? 0 : MEM_FRESH_BYTE, a_size);
+  (void) memset (p_mem + a_size, MEM_GUARD_BYTE, MEM_GUARD_SZ);
+
+  if (!track (p_mem, a_size, ap_account, true))
+    {
+      free (p_mem);
+      return NULL;
+    }
+  return p_mem;
+}
+
+static void
+debug_release (uint8_t * ap_mem, const size_t a_size)
+{
+  if (!guard_intact (ap_mem, a_size))
+    {
+      fprintf (stderr,
+               "tiz_mem: the block at %p (%lu bytes) has been overrun\n",
+               (void *) ap_mem, (unsigned long) a_size);
+      abort ();
+    }
+  (void) memset (ap_mem, MEM_FREED_BYTE, a_size);
+  free (ap_mem);
+}
+
+static inline void *
+raw_alloc (const tiz_mem_backend_type_t a_backend, const size_t a_size,
+           const bool a_clear)
+{
+  void * p_mem = NULL;
+
+  if (ETIZMemBackendCustom == a_backend)
+    {
+      if ((p_mem = g_mem_custom.pf_alloc (g_mem_custom.p_arg, a_size))
+          && a_clear)
+        {
+          (void) memset (p_mem, 0, a_size);
+        }
+      return p_mem;
+    }
+  return a_clear ? calloc (1, a_size) : malloc (a_size);
+}
+
+static inline void
+raw_free (void * ap_ptr)
+{
+  if (ETIZMemBackendCustom == get_backend ())
+    {
+      g_mem_custom.pf_free (g_mem_custom.p_arg, ap_ptr);
+    }
+  else
+    {
+      free (ap_ptr);
+    }
+}
+
+/* Allocate memory charged to an account (if not NULL) */
+static void *
+alloc_as (tiz_mem_account_t * ap_account, const size_t a_size,
+          const bool a_clear)
+{
+  const tiz_mem_backend_type_t backend = get_backend ();
+  tiz_soa_t * p_soa = NULL;
+  void * p_mem = NULL;
+
+  if (!__atomic_load_n (&g_mem_used, __ATOMIC_RELAXED))
+    {
+      __atomic_store_n (&g_mem_used, true, __ATOMIC_RELAXED);
+    }
+
+  if (ap_account && !may_charge (ap_account, a_size))
+    {
+      return NULL;
+    }
+
+  if (ETIZMemBackendDebug == backend)
+    {
+      return debug_alloc (ap_account, a_size, a_clear);
+    }
+
+  if (ETIZMemBackendDefault == backend && a_size <= TIZ_SOA_MAX_OBJECT_SIZE
+      && (p_soa = get_soa ())
+      && (p_mem = a_clear ? tiz_soa_calloc (p_soa, a_size)
+                          : tiz_soa_alloc (p_soa, a_size)))
+    {
+      if (ap_account)
+        {
+          tiz_soa_set_tag (p_mem, ap_account);
+          charge (ap_account, tiz_soa_usable_size (p_mem));
+        }
+      return p_mem;
+    }
+
+  if (!(p_mem = raw_alloc (backend, a_size, a_clear)))
+    {
+      return NULL;
+    }
+
+  if ((ap_account || ETIZMemBackendCustom == backend)
+      && !track (p_mem, a_size, ap_account, false))
+    {
+      raw_free (p_mem);
+      return NULL;
+    }
+
+  return p_mem;
+}
+
+/* Reallocate a block found in the registry. The new block is recorded
+   before the old one is released, so that the old one stays valid and
+   registered if that fails; the account is only charged the difference. */
+static void *
+realloc_tracked (void * ap_ptr, const mem_record_t * ap_rec,
+                 const size_t a_size)
+{
+  tiz_mem_account_t * p_account = ap_rec->p_account;
+  uint8_t * p_mem = NULL;
+
+  if (p_account && a_size > ap_rec->size
+      && !may_charge (p_account, a_size - ap_rec->size))
+    {
+      return NULL;
+    }
+
+  if (ap_rec->debug)
+    {
+      if (a_size > SIZE_MAX - MEM_GUARD_SZ
+          || !(p_mem = malloc (a_size + MEM_GUARD_SZ)))
+        {
+          return NULL;
+        }
+      if (a_size > ap_rec->size)
+        {
+          (void) memset (p_mem + ap_rec->size, MEM_FRESH_BYTE,
+                         a_size - ap_rec->size);
+        }
+      (void) memset (p_mem + a_size, MEM_GUARD_BYTE, MEM_GUARD_SZ);
+    }
+  else if (!(p_mem = raw_alloc (get_backend (), a_size, false)))
+    {
+      return NULL;
+    }
+
+  (void) memcpy (p_mem, ap_ptr, MIN (a_size, ap_rec->size));
+
+  if (!registry_insert (p_mem, a_size, p_account, ap_rec->debug))
+    {
+      if (ap_rec->debug)
+        {
+          free (p_mem);
+        }
+      else
+        {
+          raw_free (p_mem);
+        }
+      return NULL;
+    }
+
+  (void) registry_find (ap_ptr, NULL, true);
+  if (ap_rec->debug)
+    {
+      debug_release (ap_ptr, ap_rec->size);
+    }
+  else
+    {
+      raw_free (ap_ptr);
+    }
+
+  if (p_account)
+    {
+      recharge (p_account, ap_rec->size, a_size);
+    }
+  return p_mem;
+}
+
+OMX_ERRORTYPE
+tiz_mem_set_backend (const tiz_mem_backend_type_t a_type,
+                     const tiz_mem_backend_t * ap_custom)
+{
+  const tiz_mem_backend_type_t current = get_backend ();
+
+  if (a_type >= ETIZMemBackendMax
+      || (ETIZMemBackendCustom == a_type
+          && (!ap_custom || !ap_custom->pf_alloc || !ap_custom->pf_free)))
+    {
+      return OMX_ErrorBadParameter;
+    }
+
+  if (current == a_type && ETIZMemBackendCustom != a_type)
+    {
+      return OMX_ErrorNone;
+    }
+
+  /* Memory from the C library and from a custom backend can't be told
+     apart */
+  if (ETIZMemBackendCustom == current
+      || (ETIZMemBackendCustom == a_type
+          && __atomic_load_n (&g_mem_used, __ATOMIC_RELAXED)))
+    {
+      return OMX_ErrorIncorrectStateOperation;
+    }
+
+  if (ETIZMemBackendCustom == a_type)
+    {
+      g_mem_custom = *ap_custom;
+    }
+  else if (ETIZMemBackendDefault == a_type && !get_soa ())
+    {
+      __atomic_store_n (&gp_mem_soa, tiz_soa_shared (), __ATOMIC_RELEASE);
+    }
+
+  __atomic_store_n (&g_mem_backend, a_type, __ATOMIC_RELEASE);
+  return OMX_ErrorNone;
+}
+
+tiz_mem_backend_type_t
+tiz_mem_get_backend (void)
+{
+  return get_backend ();
+}
+
+OMX_U32
+tiz_mem_debug_report (const bool a_print)
+{
+  OMX_U32 nlive = 0;
+  size_t i = 0;
+  size_t j = 0;
+
+  for (j = 0; j < MEM_REGISTRY_NSHARDS; ++j)
+    {
+      mem_registry_t * p_reg = &(g_mem_registry[j]);
+      (void) pthread_mutex_lock (&(p_reg->mutex));
+      for (i = 0; i < p_reg->capacity; ++i)
+        {
+          const mem_record_t * p_rec = &(p_reg->p_slots[i]);
+          if (p_rec->p_addr && p_rec->debug)
+            {
+              ++nlive;
+              if (a_print)
+                {
+                  fprintf (stderr, "tiz_mem: %p %lu bytes - account %p%s\n",
+                           p_rec->p_addr, (unsigned long) p_rec->size,
+                           (void *) p_rec->p_account,
+                           guard_intact (p_rec->p_addr, p_rec->size)
+                             ? ""
+                             : " - OVERRUN");
+                }
+            }
+        }
+      (void) pthread_mutex_unlock (&(p_reg->mutex));
+    }
+
+  return nlive;
+}
+
+OMX_ERRORTYPE
+tiz_mem_account_init (tiz_mem_account_ptr_t * app_account)
+{
+  tiz_mem_account_t * p_account = NULL;
+
+  assert (app_account);
+
+  /* Straight from the C library, so that it isn't charged to the calling
+     thread's account */
+  tiz_check_null_ret_oom ((p_account = calloc (1, sizeof (tiz_mem_account_t))));
+  p_account->refs = 1;
+  *app_account = p_account;
+  return OMX_ErrorNone;
+}
+
+void
+tiz_mem_account_destroy (tiz_mem_account_t * ap_account)
+{
+  if (ap_account)
+    {
+      unref_account (ap_account);
+    }
+}
+
+tiz_mem_account_t *
+tiz_mem_account_swap (tiz_mem_account_t * ap_account)
+{
+  tiz_mem_account_t * p_prev = tp_mem_account;
+  tp_mem_account = ap_account;
+  return p_prev;
+}
+
+void
+tiz_mem_account_set_limit (tiz_mem_account_t * ap_account,
+                           const OMX_U64 a_limit)
+{
+  assert (ap_account);
+  __atomic_store_n (&(ap_account->limit), a_limit, __ATOMIC_RELAXED);
+}
+
+void
+tiz_mem_account_info (const tiz_mem_account_t * ap_account,
+                      tiz_mem_account_info_t * ap_info)
+{
+  assert (ap_account);
+  assert (ap_info);
+  ap_info->bytes = __atomic_load_n (&(ap_account->bytes), __ATOMIC_RELAXED);
+  ap_info->peak_bytes
+    = __atomic_load_n (&(ap_account->peak_bytes), __ATOMIC_RELAXED);
+  ap_info->allocs = __atomic_load_n (&(ap_account->allocs), __ATOMIC_RELAXED);
+  ap_info->frees = __atomic_load_n (&(ap_account->frees), __ATOMIC_RELAXED);
+  ap_info->failures
+    = __atomic_load_n (&(ap_account->failures), __ATOMIC_RELAXED);
+  ap_info->limit = __atomic_load_n (&(ap_account->limit), __ATOMIC_RELAXED);
+}
+
+void
+tiz_mem_account_reset (tiz_mem_account_t * ap_account)
+{
+  assert (ap_account);
+  __atomic_store_n (&(ap_account->allocs), 0, __ATOMIC_RELAXED);
+  __atomic_store_n (&(ap_account->frees), 0, __ATOMIC_RELAXED);
+  __atomic_store_n (&(ap_account->failures), 0, __ATOMIC_RELAXED);
+  __atomic_store_n (&(ap_account->peak_bytes),
+                    __atomic_load_n (&(ap_account->bytes), __ATOMIC_RELAXED),
+                    __ATOMIC_RELAXED);
+}
+
+tiz_mem_account_t *
+tiz_mem_account_current (void)
+{
+  return tp_mem_account;
+}
+
+bool
+tiz_mem_account_charge (tiz_mem_account_t * ap_account, const size_t a_size)
+{
+  assert (ap_account);
+  if (!may_charge (ap_account, a_size))
+    {
+      return false;
+    }
+  charge (ap_account, a_size);
+  return true;
+}
+
+void
+tiz_mem_account_discharge (tiz_mem_account_t * ap_account,
+                           const size_t a_size)
+{
+  assert (ap_account);
+  discharge (ap_account, a_size);
+}
+
 /*@only@ */ /*@null@ */ /*@out@ */
 OMX_PTR
 tiz_mem_alloc (size_t a_size)
 {
-  return malloc (a_size);
+  return alloc_as (tp_mem_account, a_size, false);
 }
 
 void
 tiz_mem_free (/*@only@ */ /*@out@ */ /*@null@ */ OMX_PTR a_ptr)
 {
-  free (a_ptr);
+  tiz_soa_t * p_soa = get_soa ();
+  mem_record_t rec;
+
+  if (!a_ptr)
+    {
+      return;
+    }
+
+  if (p_soa && tiz_soa_owns (p_soa, a_ptr))
+    {
+      tiz_mem_account_t * p_account = tiz_soa_get_tag (a_ptr);
+      if (p_account)
+        {
+          discharge (p_account, tiz_soa_usable_size (a_ptr));
+        }
+      tiz_soa_free (p_soa, a_ptr);
+    }
+  else if (registry_find (a_ptr, &rec, true))
+    {
+      if (rec.p_account)
+        {
+          discharge (rec.p_account, rec.size);
+        }
+      if (rec.debug)
+        {
+          debug_release (a_ptr, rec.size);
+        }
+      else
+        {
+          raw_free (a_ptr);
+        }
+    }
+  else
+    {
+      /* Never a custom backend's; those are all in the registry */
+      free (a_ptr);
+    }
 }
 
 /*@only@ */ /*@null@ */ /*@out@ */
@@ -54,6 +814,38 @@ OMX_PTR
 tiz_mem_realloc (/*@only@ */ /*@out@ */ /*@null@ */ OMX_PTR a_ptr,
                  size_t a_size)
 {
+  tiz_soa_t * p_soa = get_soa ();
+  mem_record_t rec;
+
+  if (!a_ptr)
+    {
+      return tiz_mem_alloc (a_size);
+    }
+
+  if (p_soa && tiz_soa_owns (p_soa, a_ptr))
+    {
+      const size_t usable = tiz_soa_usable_size (a_ptr);
+      OMX_PTR p_mem = NULL;
+
+      if (a_size <= usable)
+        {
+          return a_ptr;
+        }
+
+      /* The new block is charged to the same account as the old one */
+      if ((p_mem = alloc_as (tiz_soa_get_tag (a_ptr), a_size, false)))
+        {
+          memcpy (p_mem, a_ptr, usable);
+          tiz_mem_free (a_ptr);
+        }
+      return p_mem;
+    }
+
+  if (registry_find (a_ptr, &rec, false))
+    {
+      return realloc_tracked (a_ptr, &rec, a_size);
+    }
+
   return realloc (a_ptr, a_size);
 }
 
@@ -61,7 +853,11 @@ tiz_mem_realloc (/*@only@ */ /*@out@ */ /*@null@ */ OMX_PTR a_ptr,
 OMX_PTR
 tiz_mem_calloc (size_t a_num_elem, size_t a_elem_size)
 {
-  return calloc (a_num_elem, a_elem_size);
+  if (a_num_elem > 0 && a_elem_size > SIZE_MAX / a_num_elem)
+    {
+      return NULL;
+    }
+  return alloc_as (tp_mem_account, a_num_elem * a_elem_size, true);
 }
 
 OMX_PTR
@@ -33,9 +33,128 @@
 extern "C" {
 #endif
 
+#include <stdbool.h>
 #include <sys/types.h>
+#include <OMX_Core.h>
 #include <OMX_Types.h>
 
+/* The allocators tiz_mem_* may be backed by */
+typedef enum tiz_mem_backend_type tiz_mem_backend_type_t;
+enum tiz_mem_backend_type
+{
+  /* Small requests go to the shared small object allocator (see tizsoa.h),
+     the rest to the C library */
+  ETIZMemBackendDefault = 0,
+  /* Everything goes to the C library (e.g. for valgrind) */
+  ETIZMemBackendLibc,
+  /* The C library, plus a record of every live allocation, guard bytes
+     after each block (checked on free; an overrun aborts the process), and
+     poisoned fresh and freed memory */
+  ETIZMemBackendDebug,
+  /* The functions given in a tiz_mem_backend_t */
+  ETIZMemBackendCustom,
+  ETIZMemBackendMax
+};
+
+/* A custom backend (e.g. a wrapper around jemalloc's je_malloc and
+   friends). Its free function is only given memory it has allocated itself;
+   memory returned by e.g. strdup, which is routinely released with
+   tiz_mem_free, goes back to the C library. tiz_mem_realloc moves the
+   backend's blocks with pf_alloc and pf_free. */
+typedef struct tiz_mem_backend tiz_mem_backend_t;
+struct tiz_mem_backend
+{
+  void * (*pf_alloc) (void * ap_arg, size_t a_size);
+  void (*pf_free) (void * ap_arg, void * ap_ptr);
+  void * p_arg;
+};
+
+/* Select the backend. The initial one is ETIZMemBackendDefault, unless the
+   TIZONIA_MEM_BACKEND environment variable says 'libc' or 'debug'. The
+   built-in backends may be switched at any time: memory is always released
+   by the backend that allocated it. A custom backend however may only be
+   installed before the first allocation, and stays in place for good:
+   OMX_ErrorIncorrectStateOperation otherwise. ap_custom is only used with
+   ETIZMemBackendCustom, and is copied. */
+OMX_ERRORTYPE
+tiz_mem_set_backend (const tiz_mem_backend_type_t a_type,
+                     const tiz_mem_backend_t * ap_custom);
+
+tiz_mem_backend_type_t
+tiz_mem_get_backend (void);
+
+/* Debug backend: the number of live allocations made through it. If
+   a_print is true, these are also listed on stderr, along with the account
+   they were charged to and whether their guard bytes are intact. */
+OMX_U32
+tiz_mem_debug_report (const bool a_print);
+
+/* Memory accounts. A thread may have a current account (e.g. a component's
+   scheduler thread has the component's), which every allocation the thread
+   makes is then charged to, and refused if the account has a limit that the
+   allocation would exceed. The allocation stays charged to that account
+   until it is released, whichever the thread that releases it. */
+typedef struct tiz_mem_account tiz_mem_account_t;
+typedef /*@null@ */ tiz_mem_account_t * tiz_mem_account_ptr_t;
+
+typedef struct tiz_mem_account_info tiz_mem_account_info_t;
+struct tiz_mem_account_info
+{
+  /* Bytes currently allocated (small objects are counted by their size
+     class) */
+  OMX_U64 bytes;
+  /* The maximum value 'bytes' has reached */
+  OMX_U64 peak_bytes;
+  /* Allocations and releases so far */
+  OMX_U64 allocs;
+  OMX_U64 frees;
+  /* Allocations refused because of the limit */
+  OMX_U64 failures;
+  /* Zero if there is no limit */
+  OMX_U64 limit;
+};
+
+OMX_ERRORTYPE
+tiz_mem_account_init (tiz_mem_account_ptr_t * app_account);
+
+/* The account itself lives on until the last allocation charged to it has
+   been released */
+void
+tiz_mem_account_destroy (tiz_mem_account_t * ap_account);
+
+/* Make an account (or none, if NULL) the calling thread's current one;
+   returns the previous one */
+tiz_mem_account_t *
+tiz_mem_account_swap (tiz_mem_account_t * ap_account);
+
+void
+tiz_mem_account_set_limit (tiz_mem_account_t * ap_account,
+                           const OMX_U64 a_limit);
+
+void
+tiz_mem_account_info (const tiz_mem_account_t * ap_account,
+                      tiz_mem_account_info_t * ap_info);
+
+/* Reset the counters of allocations, releases and failures, and the peak
+   (to the current number of bytes) */
+void
+tiz_mem_account_reset (tiz_mem_account_t * ap_account);
+
+/* For allocators that don't go through tiz_mem_alloc (e.g. tiz_bufpool):
+   the calling thread's current account (may be NULL) */
+tiz_mem_account_t *
+tiz_mem_account_current (void);
+
+/* Charge an account with a block of a_size bytes; false if the account's
+   limit forbids it. A successful charge must eventually be matched by a
+   discharge of the same size, and keeps the account alive until then. */
+bool
+tiz_mem_account_charge (tiz_mem_account_t * ap_account, const size_t a_size);
+
+void
+tiz_mem_account_discharge (tiz_mem_account_t * ap_account,
+                           const size_t a_size);
+
 /*@only@*/ /*@null@*/ /*@out@*/
 OMX_PTR
 tiz_mem_alloc (size_t size);
@@ -0,0 +1,404 @@
+/**
+ * Copyright (C) 2011-2020 Aratelia Limited - Juan A. Rubio and contributors
+ *
+ * This file is part of Tizonia
+ *
+ * Tizonia is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Tizonia is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Tizonia.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file   tizmpscq.c
+ * @author Juan A. Rubio <juan.rubio@aratelia.com>
+ *
+ * @brief  Lock-free multiple-producer, single-consumer queue
+ *
+ * This is a bounded ring of cells, each tagged with a sequence number (see
+ * D. Vyukov's bounded MPMC queue). Producers reserve a cell with a CAS on the
+ * enqueue position and publish it by bumping the cell's sequence number. The
+ * single consumer owns the dequeue position and needs no CAS at all.
+ *
+ * Parking uses two futex words: 'consumer_parked' (the consumer sleeps on it
+ * when the queue is empty) and 'space_seq' (producers sleep on it when the
+ * queue is full). The wake-up side only issues a syscall when it observes a
+ * parked peer.
+ *
+ */
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <assert.h>
+#include <errno.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+
+#include "tizplatform.h"
+
+#ifdef TIZ_LOG_CATEGORY_NAME
+#undef TIZ_LOG_CATEGORY_NAME
+#define TIZ_LOG_CATEGORY_NAME "tiz.platform.mpscq"
+#endif
+
+#define MPSCQ_CACHE_LINE_SIZE 64
+#define MPSCQ_SPIN_COUNT 128
+
+#if defined(__x86_64__) || defined(__i386__)
+#define mpscq_cpu_relax() __asm__ __volatile__ ("pause" ::: "memory")
+#else
+#define mpscq_cpu_relax() __asm__ __volatile__ ("" ::: "memory")
+#endif
+
+typedef struct tiz_mpscq_cell tiz_mpscq_cell_t;
+struct tiz_mpscq_cell
+{
+  size_t seq;
+  OMX_PTR p_data;
+};
+
+struct tiz_mpscq
+{
+  tiz_mpscq_cell_t * p_cells;
+  size_t mask;
+  OMX_S32 capacity;
+  char pad0[MPSCQ_CACHE_LINE_SIZE];
+  /* Producers' side */
+  size_t enqueue_pos;
+  char pad1[MPSCQ_CACHE_LINE_SIZE - sizeof (size_t)];
+  /* Consumer's side */
+  size_t dequeue_pos;
+  char pad2[MPSCQ_CACHE_LINE_SIZE - sizeof (size_t)];
+  /* Shared counters and futex words */
+  int32_t length;
+  int32_t consumer_parked;
+  int32_t producers_parked;
+  int32_t space_seq;
+};
+
+static inline int
+futex_wait (int32_t * ap_addr, int32_t a_val, const struct timespec * ap_ts)
+{
+  return syscall (SYS_futex, ap_addr, FUTEX_WAIT_PRIVATE, a_val, ap_ts, NULL,
+                  0);
+}
+
+static inline void
+futex_wake (int32_t * ap_addr, int32_t a_nwaiters)
+{
+  (void) syscall (SYS_futex, ap_addr, FUTEX_WAKE_PRIVATE, a_nwaiters, NULL,
+                  NULL, 0);
+}
+
+static inline OMX_BOOL
+try_push (tiz_mpscq_t * ap_q, OMX_PTR ap_data)
+{
+  tiz_mpscq_cell_t * p_cell = NULL;
+  size_t pos = __atomic_load_n (&(ap_q->enqueue_pos), __ATOMIC_RELAXED);
+
+  for (;;)
+    {
+      size_t seq = 0;
+      intptr_t dif = 0;
+      p_cell = &(ap_q->p_cells[pos & ap_q->mask]);
+      seq = __atomic_load_n (&(p_cell->seq), __ATOMIC_ACQUIRE);
+      dif = (intptr_t) seq - (intptr_t) pos;
+      if (0 == dif)
+        {
+          if (__atomic_compare_exchange_n (&(ap_q->enqueue_pos), &pos, pos + 1,
+                                           true, __ATOMIC_RELAXED,
+                                           __ATOMIC_RELAXED))
+            {
+              break;
+            }
+        }
+      else if (dif < 0)
+        {
+          /* The queue is full */
+          return OMX_FALSE;
+        }
+      else
+        {
+          pos = __atomic_load_n (&(ap_q->enqueue_pos), __ATOMIC_RELAXED);
+        }
+    }
+
+  p_cell->p_data = ap_data;
+  (void) __atomic_add_fetch (&(ap_q->length), 1, __ATOMIC_RELAXED);
+  __atomic_store_n (&(p_cell->seq), pos + 1, __ATOMIC_RELEASE);
+
+  /* Pairs with the fence in park_consumer */
+  __atomic_thread_fence (__ATOMIC_SEQ_CST);
+  if (__atomic_load_n (&(ap_q->consumer_parked), __ATOMIC_RELAXED)
+      && __atomic_exchange_n (&(ap_q->consumer_parked), 0, __ATOMIC_SEQ_CST))
+    {
+      futex_wake (&(ap_q->consumer_parked), 1);
+    }
+
+  return OMX_TRUE;
+}
+
+static inline OMX_BOOL
+try_pop (tiz_mpscq_t * ap_q, OMX_PTR * app_data)
+{
+  const size_t pos = ap_q->dequeue_pos;
+  tiz_mpscq_cell_t * p_cell = &(ap_q->p_cells[pos & ap_q->mask]);
+  const size_t seq = __atomic_load_n (&(p_cell->seq), __ATOMIC_ACQUIRE);
+
+  if (seq != pos + 1)
+    {
+      /* Either empty, or a producer has reserved this cell but not yet
+         published it. In the latter case, the producer will wake us up. */
+      return OMX_FALSE;
+    }
+
+  *app_data = p_cell->p_data;
+  p_cell->p_data = NULL;
+  ap_q->dequeue_pos = pos + 1;
+  __atomic_store_n (&(p_cell->seq), pos + ap_q->mask + 1, __ATOMIC_RELEASE);
+  (void) __atomic_sub_fetch (&(ap_q->length), 1, __ATOMIC_RELAXED);
+
+  /* Pairs with the fence in park_producer */
+  __atomic_thread_fence (__ATOMIC_SEQ_CST);
+  if (__atomic_load_n (&(ap_q->producers_parked), __ATOMIC_RELAXED) > 0)
+    {
+      (void) __atomic_add_fetch (&(ap_q->space_seq), 1, __ATOMIC_SEQ_CST);
+      futex_wake (&(ap_q->space_seq), 1);
+    }
+
+  return OMX_TRUE;
+}
+
+static OMX_BOOL
+park_consumer (tiz_mpscq_t * ap_q, OMX_PTR * app_data,
+               const struct timespec * ap_timeout)
+{
+  OMX_BOOL received = OMX_FALSE;
+  __atomic_store_n (&(ap_q->consumer_parked), 1, __ATOMIC_SEQ_CST);
+  /* Pairs with the fence in try_push */
+  __atomic_thread_fence (__ATOMIC_SEQ_CST);
+  if (!(received = try_pop (ap_q, app_data)))
+    {
+      (void) futex_wait (&(ap_q->consumer_parked), 1, ap_timeout);
+    }
+  __atomic_store_n (&(ap_q->consumer_parked), 0, __ATOMIC_RELAXED);
+  return received;
+}
+
+static OMX_BOOL
+park_producer (tiz_mpscq_t * ap_q, OMX_PTR ap_data)
+{
+  OMX_BOOL sent = OMX_FALSE;
+  const int32_t seq = __atomic_load_n (&(ap_q->space_seq), __ATOMIC_ACQUIRE);
+  (void) __atomic_add_fetch (&(ap_q->producers_parked), 1, __ATOMIC_SEQ_CST);
+  /* Pairs with the fence in try_pop */
+  __atomic_thread_fence (__ATOMIC_SEQ_CST);
+  if (!(sent = try_push (ap_q, ap_data)))
+    {
+      (void) futex_wait (&(ap_q->space_seq), seq, NULL);
+    }
+  (void) __atomic_sub_fetch (&(ap_q->producers_parked), 1, __ATOMIC_SEQ_CST);
+  return sent;
+}
+
+static inline OMX_BOOL
+spin_pop (tiz_mpscq_t * ap_q, OMX_PTR * app_data)
+{
+  int i = 0;
+  for (i = 0; i < MPSCQ_SPIN_COUNT; ++i)
+    {
+      if (try_pop (ap_q, app_data))
+        {
+          return OMX_TRUE;
+        }
+      mpscq_cpu_relax ();
+    }
+  return OMX_FALSE;
+}
+
+static inline void
+ms_to_timespec (OMX_U32 a_millis, struct timespec * ap_ts)
+{
+  assert (ap_ts);
+  ap_ts->tv_sec = a_millis / 1000;
+  ap_ts->tv_nsec = (a_millis % 1000) * 1000000L;
+}
+
+static inline OMX_S64
+now_ns (void)
+{
+  struct timespec ts;
+  (void) clock_gettime (CLOCK_MONOTONIC, &ts);
+  return (OMX_S64) ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+OMX_ERRORTYPE
+tiz_mpscq_init (tiz_mpscq_ptr_t * app_q, OMX_S32 a_capacity)
+{
+  tiz_mpscq_t * p_q = NULL;
+  size_t ncells = 2;
+  size_t i = 0;
+
+  assert (app_q);
+  assert (a_capacity > 0);
+
+  while (ncells < (size_t) a_capacity)
+    {
+      ncells <<= 1;
+    }
+
+  TIZ_LOG (TIZ_PRIORITY_TRACE, "queue capacity [%d] cells [%zu]", a_capacity,
+           ncells);
+
+  if (!(p_q = (tiz_mpscq_t *) tiz_mem_calloc (1, sizeof (tiz_mpscq_t))))
+    {
+      TIZ_LOG (TIZ_PRIORITY_ERROR,
+               "[OMX_ErrorInsufficientResources] : "
+               "Could not instantiate queue struct.");
+      return OMX_ErrorInsufficientResources;
+    }
+
+  if (!(p_q->p_cells = (tiz_mpscq_cell_t *) tiz_mem_calloc (
+          ncells, sizeof (tiz_mpscq_cell_t))))
+    {
+      TIZ_LOG (TIZ_PRIORITY_ERROR,
+               "[OMX_ErrorInsufficientResources] : "
+               "Could not instantiate queue cells.");
+      tiz_mem_free (p_q);
+      return OMX_ErrorInsufficientResources;
+    }
+
+  for (i = 0; i < ncells; ++i)
+    {
+      p_q->p_cells[i].seq = i;
+    }
+
+  p_q->mask = ncells - 1;
+  p_q->capacity = (OMX_S32) ncells;
+  *app_q = p_q;
+
+  return OMX_ErrorNone;
+}
+
+void
+tiz_mpscq_destroy (tiz_mpscq_t * ap_q)
+{
+  if (ap_q)
+    {
+      tiz_mem_free (ap_q->p_cells);
+      tiz_mem_free (ap_q);
+    }
+}
+
+OMX_ERRORTYPE
+tiz_mpscq_send (tiz_mpscq_t * ap_q, OMX_PTR ap_data)
+{
+  assert (ap_q);
+  assert (ap_data);
+
+  while (!try_push (ap_q, ap_data))
+    {
+      if (park_producer (ap_q, ap_data))
+        {
+          break;
+        }
+    }
+
+  return OMX_ErrorNone;
+}
+
+OMX_ERRORTYPE
+tiz_mpscq_try_send (tiz_mpscq_t * ap_q, OMX_PTR ap_data)
+{
+  assert (ap_q);
+  assert (ap_data);
+  return try_push (ap_q, ap_data) ? OMX_ErrorNone : OMX_ErrorNoMore;
+}
+
+OMX_ERRORTYPE
+tiz_mpscq_receive (tiz_mpscq_t * ap_q, OMX_PTR * app_data)
+{
+  assert (ap_q);
+  assert (app_data);
+
+  while (!try_pop (ap_q, app_data) && !spin_pop (ap_q, app_data))
+    {
+      if (park_consumer (ap_q, app_data, NULL))
+        {
+          break;
+        }
+    }
+
+  return OMX_ErrorNone;
+}
+
+OMX_ERRORTYPE
+tiz_mpscq_try_receive (tiz_mpscq_t * ap_q, OMX_PTR * app_data)
+{
+  assert (ap_q);
+  assert (app_data);
+  return try_pop (ap_q, app_data) ? OMX_ErrorNone : OMX_ErrorNoMore;
+}
+
+OMX_ERRORTYPE
+tiz_mpscq_timed_receive (tiz_mpscq_t * ap_q, OMX_PTR * app_data,
+                         OMX_U32 a_millis)
+{
+  const OMX_S64 deadline = now_ns () + (OMX_S64) a_millis * 1000000LL;
+  struct timespec ts;
+
+  assert (ap_q);
+  assert (app_data);
+
+  if (try_pop (ap_q, app_data) || spin_pop (ap_q, app_data))
+    {
+      return OMX_ErrorNone;
+    }
+
+  ms_to_timespec (a_millis, &ts);
+  for (;;)
+    {
+      OMX_S64 remaining = 0;
+      if (park_consumer (ap_q, app_data, &ts) || try_pop (ap_q, app_data))
+        {
+          return OMX_ErrorNone;
+        }
+      remaining = deadline - now_ns ();
+      if (remaining <= 0)
+        {
+          break;
+        }
+      ts.tv_sec = remaining / 1000000000LL;
+      ts.tv_nsec = remaining % 1000000000LL;
+    }
+
+  return OMX_ErrorTimeout;
+}
+
+OMX_S32
+tiz_mpscq_capacity (const tiz_mpscq_t * ap_q)
+{
+  assert (ap_q);
+  return ap_q->capacity;
+}
+
+OMX_S32
+tiz_mpscq_length (const tiz_mpscq_t * ap_q)
+{
+  assert (ap_q);
+  return __atomic_load_n (&(ap_q->length), __ATOMIC_RELAXED);
+}
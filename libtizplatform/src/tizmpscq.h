@@ -0,0 +1,161 @@
+/**
+ * Copyright (C) 2011-2020 Aratelia Limited - Juan A. Rubio and contributors
+ *
+ * This file is part of Tizonia
+ *
+ * Tizonia is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Tizonia is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Tizonia.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file   tizmpscq.h
+ * @author Juan A. Rubio <juan.rubio@aratelia.com>
+ *
+ * @brief  Lock-free multiple-producer, single-consumer queue
+ *
+ *
+ */
+
+#ifndef TIZMPSCQ_H
+#define TIZMPSCQ_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup tizmpscq Lock-free multiple-producer, single-consumer queue
+ *
+ * Bounded FIFO queue that can be fed concurrently by any number of producer
+ * threads and drained by exactly one consumer thread. Producers and consumer
+ * never take a lock; a thread only enters the kernel (futex wait/wake) when it
+ * needs to park, i.e. the consumer when the queue is empty or a producer when
+ * the queue is full.
+ *
+ * @ingroup libtizplatform
+ */
+
+#include <OMX_Core.h>
+#include <OMX_Types.h>
+
+/**
+ * MPSC queue opaque structure.
+ * @ingroup tizmpscq
+ */
+typedef struct tiz_mpscq tiz_mpscq_t;
+typedef /*@null@ */ tiz_mpscq_t * tiz_mpscq_ptr_t;
+
+/**
+ * Initialize a new empty queue.
+ *
+ * @ingroup tizmpscq
+ *
+ * @param a_capacity Minimum number of items that can be sent into the
+ * queue. The actual capacity is rounded up to the next power of two (see
+ * tiz_mpscq_capacity).
+ *
+ * @return OMX_ErrorNone if success, OMX_ErrorInsufficientResources otherwise.
+ */
+OMX_ERRORTYPE
+tiz_mpscq_init (/*@out@*/ tiz_mpscq_ptr_t * app_q, OMX_S32 a_capacity);
+
+/**
+ * Destroy a queue. If ap_q is NULL, no operation is performed. There must be
+ * no producers or consumer using the queue at this point.
+ *
+ * @ingroup tizmpscq
+ *
+ */
+void
+tiz_mpscq_destroy (/*@null@ */ tiz_mpscq_t * ap_q);
+
+/**
+ * Add an item onto the end of the queue. May be called from any thread. If
+ * the queue is full, it blocks until a space becomes available.
+ *
+ * @ingroup tizmpscq
+ *
+ */
+OMX_ERRORTYPE
+tiz_mpscq_send (tiz_mpscq_t * ap_q, OMX_PTR ap_data);
+
+/**
+ * Add an item onto the end of the queue, without blocking. May be called from
+ * any thread.
+ *
+ * @ingroup tizmpscq
+ *
+ * @return OMX_ErrorNone if success, OMX_ErrorNoMore if the queue is full.
+ */
+OMX_ERRORTYPE
+tiz_mpscq_try_send (tiz_mpscq_t * ap_q, OMX_PTR ap_data);
+
+/**
+ * Retrieve an item from the head of the queue. Must only be called from the
+ * consumer thread. If the queue is empty, it blocks until an item becomes
+ * available.
+ *
+ * @ingroup tizmpscq
+ *
+ */
+OMX_ERRORTYPE
+tiz_mpscq_receive (tiz_mpscq_t * ap_q, OMX_PTR * app_data);
+
+/**
+ * Retrieve an item from the head of the queue, without blocking. Must only be
+ * called from the consumer thread.
+ *
+ * @ingroup tizmpscq
+ *
+ * @return OMX_ErrorNone if success, OMX_ErrorNoMore if the queue is empty.
+ */
+OMX_ERRORTYPE
+tiz_mpscq_try_receive (tiz_mpscq_t * ap_q, OMX_PTR * app_data);
+
+/**
+ * Retrieve an item from the head of the queue. Must only be called from the
+ * consumer thread. If the queue is empty, it waits for up to a_millis
+ * milliseconds or until an item becomes available.
+ *
+ * @ingroup tizmpscq
+ *
+ * @return OMX_ErrorNone if success, OMX_ErrorTimeout if no item was received.
+ */
+OMX_ERRORTYPE
+tiz_mpscq_timed_receive (tiz_mpscq_t * ap_q, OMX_PTR * app_data,
+                         OMX_U32 a_millis);
+
+/**
+ * Retrieve the maximum number of items that can be stored in the queue.
+ *
+ * @ingroup tizmpscq
+ *
+ */
+OMX_S32
+tiz_mpscq_capacity (const tiz_mpscq_t * ap_q);
+
+/**
+ * Retrieve the number of items currently stored in the queue. The value is
+ * only a snapshot when producers are active.
+ *
+ * @ingroup tizmpscq
+ *
+ */
+OMX_S32
+tiz_mpscq_length (const tiz_mpscq_t * ap_q);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TIZMPSCQ_H */
@@ -667,6 +667,14 @@ static const tiz_idx_str_t tiz_idx_to_str_tbl[] = {
    (const OMX_STRING) "OMX_TizoniaIndexConfigPlaylistPosition"},
   {OMX_TizoniaIndexConfigPlaylistPrintAction,
    (const OMX_STRING) "OMX_TizoniaIndexConfigPlaylistPrintAction"},
+  {OMX_TizoniaIndexConfigEmptyTheseBuffers,
+   (const OMX_STRING) "OMX_TizoniaIndexConfigEmptyTheseBuffers"},
+  {OMX_TizoniaIndexConfigFillTheseBuffers,
+   (const OMX_STRING) "OMX_TizoniaIndexConfigFillTheseBuffers"},
+  {OMX_TizoniaIndexConfigPerfStats,
+   (const OMX_STRING) "OMX_TizoniaIndexConfigPerfStats"},
+  {OMX_TizoniaIndexConfigMemStats,
+   (const OMX_STRING) "OMX_TizoniaIndexConfigMemStats"},
   {OMX_IndexKhronosExtensions, (const OMX_STRING) "OMX_IndexKhronosExtensions"},
   {OMX_IndexVendorStartUnused, (const OMX_STRING) "OMX_IndexVendorStartUnused"},
   {OMX_IndexMax, (const OMX_STRING) "OMX_IndexMax"}};
@@ -40,6 +40,8 @@
 #include "tizlog.h"
 #include "tizmem.h"
 #include "tizqueue.h"
+#include "tizmpscq.h"
+#include "tizwpool.h"
 #include "tizpqueue.h"
 #include "tizbuffer.h"
 #include "tizvector.h"
@@ -49,9 +51,14 @@
 #include "tizomxutils.h"
 #include "tizrc.h"
 #include "tizsoa.h"
+#include "tizbufpool.h"
 #include "tizev.h"
 #include "tizhttp.h"
 #include "tizmap.h"
+#include "tizhmap.h"
+#include "tizring.h"
+#include "tiztwheel.h"
+#include "tiztracer.h"
 #include "tizlimits.h"
 #include "tizprintf.h"
 #include "tizshufflelst.h"
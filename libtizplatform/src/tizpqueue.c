@@ -33,6 +33,7 @@
 #include "tizplatform.h"
 
 #include <assert.h>
+#include <stdint.h>
 #include <string.h>
 
 #ifdef TIZ_LOG_CATEGORY_NAME
@@ -40,32 +41,35 @@
 #define TIZ_LOG_CATEGORY_NAME "tiz.platform.pqueue"
 #endif
 
-#if 0
-static void
-_pq_dump_item (const char *ap_name, void    *ap_data,
-               OMX_S32  a_priority, void    *ap_cur,
-               void    *ap_prev, void *ap_next)
-{
-  TIZ_LOG (TIZ_PRIORITY_ERROR, "DUMP [%s]: ap_data[%p] a_priority[%d] "
-           "ap_cur[%p] ap_prev[%p] ap_next[%p]",
-           ap_name, ap_data, a_priority, ap_cur, ap_prev, ap_next);
-}
-#endif
+#define PQUEUE_BITS_PER_WORD 64
 
+/* Items are kept in one FIFO list per priority group (bucket). A bitmap of
+   the non-empty buckets lets send and receive run in constant time. Nodes are
+   recycled through a free list, so that in steady state no allocations take
+   place. */
 typedef struct tiz_pqueue_item tiz_pqueue_item_t;
 struct tiz_pqueue_item
 {
   void * p_data;
-  OMX_S32 priority;
+  OMX_S32 priority; /* -1 while the node is in the free list */
+  OMX_U32 seq;      /* Bumped every time the node is reused */
   tiz_pqueue_item_t * p_prev;
   tiz_pqueue_item_t * p_next;
 };
 
-struct tiz_pqueue
+typedef struct tiz_pqueue_bucket tiz_pqueue_bucket_t;
+struct tiz_pqueue_bucket
 {
-  /*@dependent@ */ tiz_pqueue_item_t ** pp_store;
   /*@dependent@ */ /*@null@ */ tiz_pqueue_item_t * p_first;
   /*@dependent@ */ /*@null@ */ tiz_pqueue_item_t * p_last;
+};
+
+struct tiz_pqueue
+{
+  tiz_pqueue_bucket_t * p_buckets;
+  uint64_t * p_bitmap;
+  OMX_S32 nwords;
+  /*@null@ */ tiz_pqueue_item_t * p_free;
   OMX_S32 length;
   OMX_S32 max_prio;
   tiz_pq_cmp_f pf_cmp;
@@ -85,43 +89,111 @@ pqueue_free (tiz_soa_t * p_soa, void * ap_addr)
   p_soa ? tiz_soa_free (p_soa, ap_addr) : tiz_mem_free (ap_addr);
 }
 
-static inline void
-hook_before (tiz_pqueue_t * p_q, tiz_pqueue_item_t * p_cur,
-             tiz_pqueue_item_t * p_new)
+static inline tiz_pqueue_item_t *
+get_item (tiz_pqueue_t * p_q)
 {
-  tiz_pqueue_item_t * p_tmp = p_cur->p_prev;
-  p_cur->p_prev = p_new;
-  p_new->p_next = p_cur;
-  if (p_tmp)
+  tiz_pqueue_item_t * p_item = p_q->p_free;
+  if (p_item)
     {
-      p_new->p_prev = p_tmp;
-      p_tmp->p_next = p_new;
+      p_q->p_free = p_item->p_next;
     }
   else
     {
-      p_q->p_first = p_new;
+      p_item = (tiz_pqueue_item_t *) pqueue_calloc (
+        p_q->p_soa, sizeof (tiz_pqueue_item_t));
+    }
+  return p_item;
+}
+
+static inline void
+put_item (tiz_pqueue_t * p_q, tiz_pqueue_item_t * p_item)
+{
+  p_item->p_data = NULL;
+  p_item->priority = -1;
+  p_item->seq++;
+  p_item->p_prev = NULL;
+  p_item->p_next = p_q->p_free;
+  p_q->p_free = p_item;
+}
+
+static inline OMX_S32
+first_priority (const tiz_pqueue_t * p_q)
+{
+  OMX_S32 i = 0;
+  for (i = 0; i < p_q->nwords; ++i)
+    {
+      if (p_q->p_bitmap[i])
+        {
+          return i * PQUEUE_BITS_PER_WORD + __builtin_ctzll (p_q->p_bitmap[i]);
+        }
     }
+  return -1;
 }
 
 static inline void
 hook_last (tiz_pqueue_t * p_q, tiz_pqueue_item_t * p_new)
 {
-  tiz_pqueue_item_t * p_tmp = NULL;
+  tiz_pqueue_bucket_t * p_bucket = NULL;
 
   assert (p_q);
+  assert (p_new);
 
-  if (p_q->p_last)
+  p_bucket = &(p_q->p_buckets[p_new->priority]);
+  p_new->p_next = NULL;
+  p_new->p_prev = p_bucket->p_last;
+  if (p_bucket->p_last)
+    {
+      p_bucket->p_last->p_next = p_new;
+    }
+  else
+    {
+      p_bucket->p_first = p_new;
+      p_q->p_bitmap[p_new->priority / PQUEUE_BITS_PER_WORD]
+        |= (uint64_t) 1 << (p_new->priority % PQUEUE_BITS_PER_WORD);
+    }
+  p_bucket->p_last = p_new;
+  p_q->length++;
+}
+
+static inline void
+unhook (tiz_pqueue_t * p_q, tiz_pqueue_item_t * p_cur)
+{
+  tiz_pqueue_bucket_t * p_bucket = NULL;
+
+  assert (p_q);
+  assert (p_cur);
+  assert (p_cur->priority >= 0);
+
+  p_bucket = &(p_q->p_buckets[p_cur->priority]);
+
+  if (p_cur->p_prev)
+    {
+      p_cur->p_prev->p_next = p_cur->p_next;
+    }
+  else
+    {
+      p_bucket->p_first = p_cur->p_next;
+    }
+
+  if (p_cur->p_next)
+    {
+      p_cur->p_next->p_prev = p_cur->p_prev;
+    }
+  else
     {
-      p_tmp = p_q->p_last;
-      p_tmp->p_next = p_new;
-      p_new->p_prev = p_tmp;
+      p_bucket->p_last = p_cur->p_prev;
     }
 
-  p_q->p_last = p_new;
-  if (NULL == p_q->p_first)
+  if (!p_bucket->p_first)
     {
-      p_q->p_first = p_new;
+      p_q->p_bitmap[p_cur->priority / PQUEUE_BITS_PER_WORD]
+        &= ~((uint64_t) 1 << (p_cur->priority % PQUEUE_BITS_PER_WORD));
     }
+
+  p_q->length--;
+  put_item (p_q, p_cur);
+
+  assert (p_q->length >= 0);
 }
 
 OMX_ERRORTYPE
@@ -141,18 +213,26 @@ tiz_pqueue_init (tiz_pqueue_t ** pp_q, OMX_S32 a_max_prio,
       return OMX_ErrorInsufficientResources;
     }
 
-  /* There is one pointer per priority category */
+  p_q->nwords = a_max_prio / PQUEUE_BITS_PER_WORD + 1;
+
+  /* There is one bucket per priority category */
   if (NULL
-      == (p_q->pp_store = (tiz_pqueue_item_t **) pqueue_calloc (
-            ap_soa, (size_t) (a_max_prio + 1) * sizeof (tiz_pqueue_item_t *))))
+        == (p_q->p_buckets = (tiz_pqueue_bucket_t *) pqueue_calloc (
+              ap_soa, (size_t) (a_max_prio + 1) * sizeof (tiz_pqueue_bucket_t)))
+      || NULL
+           == (p_q->p_bitmap = (uint64_t *) pqueue_calloc (
+                 ap_soa, (size_t) p_q->nwords * sizeof (uint64_t))))
     {
+      if (p_q->p_buckets)
+        {
+          pqueue_free (ap_soa, p_q->p_buckets);
+        }
       pqueue_free (ap_soa, p_q);
       p_q = NULL;
       return OMX_ErrorInsufficientResources;
     }
 
-  p_q->p_first = NULL;
-  p_q->p_last = NULL;
+  p_q->p_free = NULL;
   p_q->length = 0;
   p_q->max_prio = a_max_prio;
   p_q->pf_cmp = a_pf_cmp;
@@ -174,11 +254,19 @@ tiz_pqueue_destroy (tiz_pqueue_t * p_q)
 {
   if (p_q)
     {
-      assert (p_q->p_first == p_q->p_last);
-      assert (p_q->p_first == NULL);
+      tiz_pqueue_item_t * p_item = NULL;
+
       assert (p_q->length == 0);
+      assert (first_priority (p_q) == -1);
+
+      while ((p_item = p_q->p_free))
+        {
+          p_q->p_free = p_item->p_next;
+          pqueue_free (p_q->p_soa, p_item);
+        }
 
-      pqueue_free (p_q->p_soa, p_q->pp_store);
+      pqueue_free (p_q->p_soa, p_q->p_bitmap);
+      pqueue_free (p_q->p_soa, p_q->p_buckets);
       pqueue_free (p_q->p_soa, p_q);
     }
 }
@@ -186,242 +274,130 @@ tiz_pqueue_destroy (tiz_pqueue_t * p_q)
 OMX_ERRORTYPE
 tiz_pqueue_send (tiz_pqueue_t * p_q, void * ap_data, OMX_S32 a_priority)
 {
-  OMX_ERRORTYPE rc = OMX_ErrorNone;
+  return tiz_pqueue_send_with_handle (p_q, ap_data, a_priority, NULL);
+}
+
+OMX_ERRORTYPE
+tiz_pqueue_send_with_handle (tiz_pqueue_t * p_q, void * ap_data,
+                             OMX_S32 a_priority,
+                             tiz_pqueue_handle_t * ap_handle)
+{
   tiz_pqueue_item_t * p_new = NULL;
 
   assert (p_q);
   assert (a_priority >= 0);
   assert (a_priority <= p_q->max_prio);
 
-  if (NULL == (p_new = (tiz_pqueue_item_t *) pqueue_calloc (
-                 p_q->p_soa, sizeof (tiz_pqueue_item_t))))
+  if (NULL == (p_new = get_item (p_q)))
     {
-      rc = OMX_ErrorInsufficientResources;
+      return OMX_ErrorInsufficientResources;
     }
-  else
-    {
-      OMX_S32 next_prio = a_priority + 1;
-      /* Find the next priority upwards. This will make next_prio equal to next
-       * prio up or max+1 if none */
-      while ((next_prio <= p_q->max_prio) && (NULL == p_q->pp_store[next_prio]))
-        {
-          next_prio++;
-        }
 
-      if (NULL == p_q->pp_store[a_priority])
-        {
-          p_q->pp_store[a_priority] = p_new;
-        }
-
-      if ((next_prio <= p_q->max_prio) && (p_q->pp_store[next_prio]))
-        {
-          hook_before (p_q, p_q->pp_store[next_prio], p_new);
-        }
-      else
-        {
-          hook_last (p_q, p_new);
-        }
-
-      p_new->p_data = ap_data;
-      p_new->priority = a_priority;
-      p_q->length++;
+  p_new->p_data = ap_data;
+  p_new->priority = a_priority;
+  hook_last (p_q, p_new);
 
-      assert (p_q->p_first);
-      assert (p_q->p_last);
+  if (ap_handle)
+    {
+      ap_handle->p_item = p_new;
+      ap_handle->seq = p_new->seq;
     }
 
-  return rc;
+  return OMX_ErrorNone;
 }
 
 OMX_ERRORTYPE
 tiz_pqueue_receive (tiz_pqueue_t * p_q, void ** app_data)
 {
-  OMX_ERRORTYPE rc = OMX_ErrorNone;
+  tiz_pqueue_item_t * p_cur = NULL;
+  OMX_S32 prio = 0;
 
   assert (p_q);
   assert (app_data);
 
-  TIZ_LOG (TIZ_PRIORITY_TRACE, "[%s], pq[%p] len[%d] fst [%p] lst [%p]",
-           p_q->name, p_q, p_q->length, p_q->p_first, p_q->p_last);
-
   if (0 >= p_q->length)
     {
-      assert (p_q->p_first == p_q->p_last);
       assert (0 == p_q->length);
-      rc = OMX_ErrorNoMore;
+      return OMX_ErrorNoMore;
     }
-  else
-    {
-      tiz_pqueue_item_t * p_cur = NULL;
-      tiz_pqueue_item_t * p_next = NULL;
-
-      p_cur = p_q->p_first;
-      assert (p_cur);
-      p_next = p_cur->p_next;
-      p_q->p_first = p_next;
-
-      if (p_next)
-        {
-          p_next->p_prev = NULL;
-        }
-      else
-        {
-          p_q->p_last = NULL;
-          assert (p_q->length == 1);
-        }
 
-      if (p_q->pp_store[p_cur->priority] == p_cur)
-        {
-          if ((p_next) && (p_next->priority == p_cur->priority))
-            {
-              p_q->pp_store[p_cur->priority] = p_next;
-            }
-          else
-            {
-              p_q->pp_store[p_cur->priority] = NULL;
-            }
-        }
-
-      p_q->length--;
-      *app_data = p_cur->p_data;
-      pqueue_free (p_q->p_soa, p_cur);
-
-      assert (p_q->length >= 0);
-      assert (p_q->length > 0 ? (p_q->p_first && p_q->p_last) : 1);
-    }
+  prio = first_priority (p_q);
+  assert (prio >= 0 && prio <= p_q->max_prio);
+  p_cur = p_q->p_buckets[prio].p_first;
+  assert (p_cur);
 
-  TIZ_LOG (TIZ_PRIORITY_TRACE, "[%s], pq[%p] len[%d] fst [%p] lst [%p]",
-           p_q->name, p_q, p_q->length, p_q->p_first, p_q->p_last);
+  *app_data = p_cur->p_data;
+  unhook (p_q, p_cur);
 
-  return rc;
+  return OMX_ErrorNone;
 }
 
 OMX_ERRORTYPE
 tiz_pqueue_remove (tiz_pqueue_t * p_q, void * ap_data)
 {
-  OMX_ERRORTYPE rc = OMX_ErrorNoMore;
-  tiz_pqueue_item_t * p_cur = NULL;
-  tiz_pqueue_item_t * p_next = NULL;
-  tiz_pqueue_item_t * p_prev = NULL;
+  OMX_S32 prio = 0;
 
   assert (p_q);
   assert (ap_data);
 
-  p_cur = p_q->p_first;
-  while (p_cur)
+  for (prio = 0; prio <= p_q->max_prio; ++prio)
     {
-      if (p_q->pf_cmp (p_cur->p_data, ap_data) == 0)
+      if (OMX_ErrorNone == tiz_pqueue_removep (p_q, ap_data, prio))
         {
-          p_next = p_cur->p_next;
-          p_prev = p_cur->p_prev;
-
-          if (p_next)
-            {
-              p_next->p_prev = p_prev;
-            }
-
-          if (p_prev)
-            {
-              p_prev->p_next = p_next;
-            }
-
-          if (p_q->p_first == p_cur)
-            {
-              p_q->p_first = p_next;
-            }
-
-          if (p_q->p_last == p_cur)
-            {
-              p_q->p_last = p_prev;
-            }
-
-          if (p_q->pp_store[p_cur->priority] == p_cur)
-            {
-              if ((p_next) && (p_next->priority == p_cur->priority))
-                {
-                  p_q->pp_store[p_cur->priority] = p_next;
-                }
-              else
-                {
-                  p_q->pp_store[p_cur->priority] = NULL;
-                }
-            }
-
-          pqueue_free (p_q->p_soa, p_cur);
-          p_q->length--;
-          rc = OMX_ErrorNone;
-          /* DONE */
-          break;
+          return OMX_ErrorNone;
         }
-      p_cur = p_cur->p_next;
     }
 
-  return rc;
+  return OMX_ErrorNoMore;
 }
 
 OMX_ERRORTYPE
 tiz_pqueue_removep (tiz_pqueue_t * p_q, void * ap_data, OMX_S32 a_priority)
 {
-  OMX_ERRORTYPE rc = OMX_ErrorNoMore;
   tiz_pqueue_item_t * p_cur = NULL;
-  tiz_pqueue_item_t * p_next = NULL;
-  tiz_pqueue_item_t * p_prev = NULL;
 
   assert (p_q);
   assert (ap_data != NULL);
   assert (a_priority >= 0);
   assert (a_priority <= p_q->max_prio);
 
-  p_cur = p_q->pp_store[a_priority];
-  while (p_cur && p_cur->priority == a_priority)
+  for (p_cur = p_q->p_buckets[a_priority].p_first; p_cur;
+       p_cur = p_cur->p_next)
     {
       if (p_q->pf_cmp (p_cur->p_data, ap_data) == 0)
         {
-          p_next = p_cur->p_next;
-          p_prev = p_cur->p_prev;
-
-          if (p_next)
-            {
-              p_next->p_prev = p_prev;
-            }
+          unhook (p_q, p_cur);
+          return OMX_ErrorNone;
+        }
+    }
 
-          if (p_prev)
-            {
-              p_prev->p_next = p_next;
-            }
+  return OMX_ErrorNoMore;
+}
 
-          if (p_q->p_first == p_cur)
-            {
-              p_q->p_first = p_next;
-            }
+OMX_ERRORTYPE
+tiz_pqueue_remove_handle (tiz_pqueue_t * p_q,
+                          const tiz_pqueue_handle_t * ap_handle,
+                          void ** app_data)
+{
+  tiz_pqueue_item_t * p_cur = NULL;
 
-          if (p_q->p_last == p_cur)
-            {
-              p_q->p_last = p_prev;
-            }
+  assert (p_q);
+  assert (ap_handle);
 
-          if (p_q->pp_store[p_cur->priority] == p_cur)
-            {
-              if ((p_next) && (p_next->priority == p_cur->priority))
-                {
-                  p_q->pp_store[p_cur->priority] = p_next;
-                }
-              else
-                {
-                  p_q->pp_store[p_cur->priority] = NULL;
-                }
-            }
+  p_cur = ap_handle->p_item;
+  if (!p_cur || p_cur->priority < 0 || p_cur->seq != ap_handle->seq)
+    {
+      /* Already received or removed */
+      return OMX_ErrorNoMore;
+    }
 
-          pqueue_free (p_q->p_soa, p_cur);
-          p_q->length--;
-          rc = OMX_ErrorNone;
-          /* DONE */
-          break;
-        }
-      p_cur = p_cur->p_next;
+  if (app_data)
+    {
+      *app_data = p_cur->p_data;
     }
+  unhook (p_q, p_cur);
 
-  return rc;
+  return OMX_ErrorNone;
 }
 
 OMX_S32
@@ -430,8 +406,8 @@ tiz_pqueue_remove_func (tiz_pqueue_t * p_q, tiz_pq_func_f a_pf_func,
 {
   tiz_pqueue_item_t * p_cur = NULL;
   tiz_pqueue_item_t * p_next = NULL;
-  tiz_pqueue_item_t * p_prev = NULL;
   OMX_S32 initial_item_count = 0;
+  OMX_S32 prio = 0;
 
   assert (p_q);
   assert (a_pf_func);
@@ -439,58 +415,17 @@ tiz_pqueue_remove_func (tiz_pqueue_t * p_q, tiz_pq_func_f a_pf_func,
 
   initial_item_count = p_q->length;
 
-  p_cur = p_q->p_first;
-  while (p_cur)
+  for (prio = 0; prio <= p_q->max_prio && p_q->length > 0; ++prio)
     {
-      if (OMX_TRUE == a_pf_func (p_cur->p_data, a_data1, ap_data2))
+      for (p_cur = p_q->p_buckets[prio].p_first; p_cur; p_cur = p_next)
         {
           p_next = p_cur->p_next;
-          p_prev = p_cur->p_prev;
-
-          if (p_next)
-            {
-              p_next->p_prev = p_prev;
-            }
-
-          if (p_prev)
-            {
-              p_prev->p_next = p_next;
-            }
-
-          if (p_q->p_first == p_cur)
-            {
-              p_q->p_first = p_next;
-            }
-
-          if (p_q->p_last == p_cur)
-            {
-              p_q->p_last = p_prev;
-            }
-
-          if (p_q->pp_store[p_cur->priority] == p_cur)
+          if (OMX_TRUE == a_pf_func (p_cur->p_data, a_data1, ap_data2))
             {
-              if ((p_next) && (p_next->priority == p_cur->priority))
-                {
-                  p_q->pp_store[p_cur->priority] = p_next;
-                }
-              else
-                {
-                  p_q->pp_store[p_cur->priority] = NULL;
-                }
+              /* NOTE: We continue here to remove as many matching items as
+               * possible */
+              unhook (p_q, p_cur);
             }
-
-          {
-            tiz_pqueue_item_t * p_to_delete = p_cur;
-            p_cur = p_cur->p_next;
-            pqueue_free (p_q->p_soa, p_to_delete);
-            p_q->length--;
-            /* NOTE: We continue here to remove as many matching items as
-             * possible */
-          }
-        }
-      else
-        {
-          p_cur = p_cur->p_next;
         }
     }
 
@@ -500,23 +435,21 @@ tiz_pqueue_remove_func (tiz_pqueue_t * p_q, tiz_pq_func_f a_pf_func,
 OMX_ERRORTYPE
 tiz_pqueue_first (tiz_pqueue_t * p_q, void ** app_data)
 {
-  OMX_ERRORTYPE rc = OMX_ErrorNone;
+  OMX_S32 prio = 0;
 
   assert (p_q);
   assert (app_data);
 
   if (0 >= p_q->length)
     {
-      assert (p_q->p_first == p_q->p_last);
-      rc = OMX_ErrorNoMore;
-    }
-  else
-    {
-      assert (p_q->p_first);
-      *app_data = p_q->p_first->p_data;
+      return OMX_ErrorNoMore;
     }
 
-  return rc;
+  prio = first_priority (p_q);
+  assert (prio >= 0 && p_q->p_buckets[prio].p_first);
+  *app_data = p_q->p_buckets[prio].p_first->p_data;
+
+  return OMX_ErrorNone;
 }
 
 OMX_S32
@@ -531,17 +464,20 @@ tiz_pqueue_dump (tiz_pqueue_t * p_q, tiz_pq_dump_item_f a_pf_dump)
 {
   tiz_pqueue_item_t * p_current = NULL;
   OMX_S32 count = 0;
+  OMX_S32 prio = 0;
 
   assert (p_q);
   assert (a_pf_dump);
 
-  p_current = p_q->p_first;
-  while (p_current)
+  for (prio = 0; prio <= p_q->max_prio; ++prio)
     {
-      a_pf_dump (p_q->name, p_current->p_data, p_current->priority, p_current,
-                 p_current->p_prev, p_current->p_next);
-      p_current = p_current->p_next;
-      count++;
+      for (p_current = p_q->p_buckets[prio].p_first; p_current;
+           p_current = p_current->p_next)
+        {
+          a_pf_dump (p_q->name, p_current->p_data, p_current->priority,
+                     p_current, p_current->p_prev, p_current->p_next);
+          count++;
+        }
     }
 
   return count;
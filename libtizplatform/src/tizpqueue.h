@@ -37,7 +37,9 @@ extern "C" {
  * @defgroup tizpqueue Priority message queue handling
  *
  * Non-synchronized priority queue. External synchronisation is required in
- * case it needs to be accessed safely from multiple threads.
+ * case it needs to be accessed safely from multiple threads. Items are kept
+ * in one FIFO bucket per priority group, so sending, receiving and removing
+ * an item by its handle take constant time.
  *
  * @ingroup libtizplatform
  */
@@ -53,6 +55,19 @@ extern "C" {
  */
 typedef struct tiz_pqueue tiz_pqueue_t;
 
+/**
+ * A reference to an item in the queue, as returned by
+ * tiz_pqueue_send_with_handle. A handle becomes stale once its item has been
+ * received or removed; using a stale handle is harmless.
+ * @ingroup tizpqueue
+ */
+typedef struct tiz_pqueue_handle tiz_pqueue_handle_t;
+struct tiz_pqueue_handle
+{
+  void * p_item;
+  OMX_U32 seq;
+};
+
 /**
  * \typedef The comparison function to be used by the removal functions
  * tiz_pqueue_remove and tiz_pqueue_removep.
@@ -157,6 +172,21 @@ tiz_pqueue_destroy (/*@null@ */ tiz_pqueue_t * ap_pq);
 OMX_ERRORTYPE
 tiz_pqueue_send (tiz_pqueue_t * ap_pq, void * ap_data, OMX_S32 a_prio);
 
+/**
+ * Add an item to the end of the priority group a_prio, and obtain a handle
+ * that can later be used to remove it with tiz_pqueue_remove_handle.
+ *
+ * @ingroup tizpqueue
+ *
+ * @param ap_handle The handle of the new item (may be NULL).
+ *
+ * @return OMX_ErrorNone if success, OMX_ErrorInsufficientResources otherwise
+ *
+ */
+OMX_ERRORTYPE
+tiz_pqueue_send_with_handle (tiz_pqueue_t * ap_pq, void * ap_data,
+                             OMX_S32 a_prio, tiz_pqueue_handle_t * ap_handle);
+
 /**
  * Receive the first item from the queue. The item received is no longer in
  * the queue.
@@ -194,6 +224,23 @@ tiz_pqueue_remove (tiz_pqueue_t * ap_pq, void * ap_data);
 OMX_ERRORTYPE
 tiz_pqueue_removep (tiz_pqueue_t * ap_pq, void * ap_data, OMX_S32 a_priority);
 
+/**
+ * Remove the item referenced by a handle obtained with
+ * tiz_pqueue_send_with_handle, without searching the queue.
+ *
+ * @param app_data The data of the item removed (may be NULL).
+ *
+ * @return OMX_ErrorNone if success, OMX_ErrorNoMore if the item is no longer
+ * in the queue
+ *
+ * @ingroup tizpqueue
+ *
+ */
+OMX_ERRORTYPE
+tiz_pqueue_remove_handle (tiz_pqueue_t * ap_pq,
+                          const tiz_pqueue_handle_t * ap_handle,
+                          void ** app_data);
+
 /**
  * Remove from the queue all the items found using the comparison function
  * apf_func.
@@ -229,7 +229,6 @@ tiz_queue_send (tiz_queue_t * p_q, OMX_PTR ap_data)
   tiz_check_omx_ret_oom (tiz_mutex_lock (&(p_q->mutex)));
 
   assert (p_q->p_last);
-  assert (NULL == (p_q->p_last->p_data));
   assert (p_q->length <= p_q->capacity);
 
   while (p_q->length == p_q->capacity)
@@ -239,6 +238,7 @@ tiz_queue_send (tiz_queue_t * p_q, OMX_PTR ap_data)
 
   if (OMX_ErrorNone == rc)
     {
+      assert (NULL == (p_q->p_last->p_data));
       p_q->p_last->p_data = ap_data;
       p_q->p_last = p_q->p_last->p_next;
       p_q->length++;
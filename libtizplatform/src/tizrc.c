@@ -204,14 +204,19 @@ get_node (const tiz_rcfile_t * ap_rc, char * str, keyval_t ** app_kv)
   keyval_t * p_kv = NULL;
   value_t * p_v = NULL;
   value_t * p_next_v = NULL;
+  const char * p_key_trimmed = NULL;
+  const char * p_value_trimmed = NULL;
 
   assert (ap_rc);
   assert (str);
   assert (app_kv);
 
-  TIZ_LOG (TIZ_PRIORITY_TRACE, "key : [%s]", trimwhitespace (key));
-  TIZ_LOG (TIZ_PRIORITY_TRACE, "val : [%s]",
-           trimlistseparator (trimwhitespace (value)));
+  /* The trimming is done in place; it must stay out of the log statements,
+     which do not evaluate their arguments when disabled */
+  p_key_trimmed = trimwhitespace (key);
+  p_value_trimmed = trimlistseparator (trimwhitespace (value));
+  TIZ_LOG (TIZ_PRIORITY_TRACE, "key : [%s]", p_key_trimmed);
+  TIZ_LOG (TIZ_PRIORITY_TRACE, "val : [%s]", p_value_trimmed);
 
 /*   if (strstr (value, "\"")) */
 /*     { */
@@ -445,8 +450,8 @@ analyze_pattern (FILE * ap_file, char * ap_str, keyval_t ** app_last_kv,
   char *p_comment_ptr = NULL;
   if ((p_comment_ptr = strstr (ap_str, "#")))
     {
-      char * str = trimcommenting (trimwhitespace (ap_str));
-      TIZ_LOG (TIZ_PRIORITY_TRACE, "Comment : [%s]", trimwhitespace (str));
+      char * str = trimwhitespace (trimcommenting (trimwhitespace (ap_str)));
+      TIZ_LOG (TIZ_PRIORITY_TRACE, "Comment : [%s]", str);
       (void) str;
       /* Ignore the commented section of this line */
       *p_comment_ptr = '\0';
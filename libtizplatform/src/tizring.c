@@ -0,0 +1,219 @@
+/**
+ * Copyright (C) 2011-2020 Aratelia Limited - Juan A. Rubio and contributors
+ *
+ * This file is part of Tizonia
+ *
+ * Tizonia is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Tizonia is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Tizonia.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file   tizring.c
+ * @author Juan A. Rubio <juan.rubio@aratelia.com>
+ *
+ * @brief  Growable ring buffer of pointers
+ *
+ *
+ */
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <assert.h>
+#include <string.h>
+
+#include "tizplatform.h"
+
+#ifdef TIZ_LOG_CATEGORY_NAME
+#undef TIZ_LOG_CATEGORY_NAME
+#define TIZ_LOG_CATEGORY_NAME "tiz.platform.ring"
+#endif
+
+#define RING_MIN_GROWTH 4
+
+struct tiz_ring
+{
+  OMX_PTR * pp_items;
+  OMX_S32 capacity;
+  OMX_S32 head;
+  OMX_S32 length;
+};
+
+/* Array slot of the item at position a_pos */
+static inline OMX_S32
+ring_slot (const tiz_ring_t * ap_ring, OMX_S32 a_pos)
+{
+  OMX_S32 slot = ap_ring->head + a_pos;
+  return (slot >= ap_ring->capacity) ? slot - ap_ring->capacity : slot;
+}
+
+OMX_ERRORTYPE
+tiz_ring_init (tiz_ring_ptr_t * app_ring, OMX_S32 a_capacity)
+{
+  tiz_ring_t * p_ring = NULL;
+
+  assert (app_ring);
+  assert (a_capacity >= 0);
+
+  tiz_check_null_ret_oom ((p_ring = tiz_mem_calloc (1, sizeof (tiz_ring_t))));
+
+  if (OMX_ErrorNone != tiz_ring_reserve (p_ring, a_capacity))
+    {
+      tiz_mem_free (p_ring);
+      return OMX_ErrorInsufficientResources;
+    }
+
+  *app_ring = p_ring;
+  return OMX_ErrorNone;
+}
+
+void
+tiz_ring_destroy (tiz_ring_t * ap_ring)
+{
+  if (ap_ring)
+    {
+      tiz_mem_free (ap_ring->pp_items);
+      tiz_mem_free (ap_ring);
+    }
+}
+
+OMX_ERRORTYPE
+tiz_ring_reserve (tiz_ring_t * ap_ring, OMX_S32 a_capacity)
+{
+  OMX_PTR * pp_items = NULL;
+  OMX_S32 i = 0;
+
+  assert (ap_ring);
+
+  if (a_capacity <= ap_ring->capacity)
+    {
+      return OMX_ErrorNone;
+    }
+
+  tiz_check_null_ret_oom (
+    (pp_items = tiz_mem_alloc (a_capacity * sizeof (OMX_PTR))));
+
+  /* Unwrap the items into the new array */
+  for (i = 0; i < ap_ring->length; ++i)
+    {
+      pp_items[i] = ap_ring->pp_items[ring_slot (ap_ring, i)];
+    }
+
+  tiz_mem_free (ap_ring->pp_items);
+  ap_ring->pp_items = pp_items;
+  ap_ring->capacity = a_capacity;
+  ap_ring->head = 0;
+  return OMX_ErrorNone;
+}
+
+OMX_ERRORTYPE
+tiz_ring_push_back (tiz_ring_t * ap_ring, OMX_PTR ap_data)
+{
+  assert (ap_ring);
+
+  if (ap_ring->length == ap_ring->capacity)
+    {
+      tiz_check_omx (tiz_ring_reserve (
+        ap_ring, ap_ring->capacity + MAX (ap_ring->capacity, RING_MIN_GROWTH)));
+    }
+
+  ap_ring->pp_items[ring_slot (ap_ring, ap_ring->length)] = ap_data;
+  ap_ring->length++;
+  return OMX_ErrorNone;
+}
+
+OMX_PTR
+tiz_ring_at (const tiz_ring_t * ap_ring, OMX_S32 a_pos)
+{
+  assert (ap_ring);
+  assert (a_pos >= 0 && a_pos < ap_ring->length);
+  return ap_ring->pp_items[ring_slot (ap_ring, a_pos)];
+}
+
+void
+tiz_ring_erase (tiz_ring_t * ap_ring, OMX_S32 a_pos)
+{
+  OMX_S32 i = 0;
+
+  assert (ap_ring);
+  assert (a_pos >= 0 && a_pos < ap_ring->length);
+
+  if (a_pos < ap_ring->length / 2)
+    {
+      /* Shift the items in front of a_pos one position towards the back */
+      for (i = a_pos; i > 0; --i)
+        {
+          ap_ring->pp_items[ring_slot (ap_ring, i)]
+            = ap_ring->pp_items[ring_slot (ap_ring, i - 1)];
+        }
+      ap_ring->head = ring_slot (ap_ring, 1);
+    }
+  else
+    {
+      /* Shift the items behind a_pos one position towards the front */
+      for (i = a_pos; i < ap_ring->length - 1; ++i)
+        {
+          ap_ring->pp_items[ring_slot (ap_ring, i)]
+            = ap_ring->pp_items[ring_slot (ap_ring, i + 1)];
+        }
+    }
+
+  ap_ring->length--;
+  if (0 == ap_ring->length)
+    {
+      ap_ring->head = 0;
+    }
+}
+
+OMX_ERRORTYPE
+tiz_ring_append (tiz_ring_t * ap_dst, const tiz_ring_t * ap_src)
+{
+  OMX_S32 i = 0;
+
+  assert (ap_dst);
+  assert (ap_src);
+  assert (ap_dst != ap_src);
+
+  tiz_check_omx (tiz_ring_reserve (ap_dst, ap_dst->length + ap_src->length));
+
+  for (i = 0; i < ap_src->length; ++i)
+    {
+      ap_dst->pp_items[ring_slot (ap_dst, ap_dst->length)]
+        = ap_src->pp_items[ring_slot (ap_src, i)];
+      ap_dst->length++;
+    }
+  return OMX_ErrorNone;
+}
+
+void
+tiz_ring_clear (tiz_ring_t * ap_ring)
+{
+  assert (ap_ring);
+  ap_ring->head = 0;
+  ap_ring->length = 0;
+}
+
+OMX_S32
+tiz_ring_length (const tiz_ring_t * ap_ring)
+{
+  assert (ap_ring);
+  return ap_ring->length;
+}
+
+OMX_S32
+tiz_ring_capacity (const tiz_ring_t * ap_ring)
+{
+  assert (ap_ring);
+  return ap_ring->capacity;
+}
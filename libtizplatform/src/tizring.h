@@ -0,0 +1,160 @@
+/**
+ * Copyright (C) 2011-2020 Aratelia Limited - Juan A. Rubio and contributors
+ *
+ * This file is part of Tizonia
+ *
+ * Tizonia is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Tizonia is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Tizonia.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file   tizring.h
+ * @author Juan A. Rubio <juan.rubio@aratelia.com>
+ *
+ * @brief  Growable ring buffer of pointers
+ *
+ *
+ */
+
+#ifndef TIZRING_H
+#define TIZRING_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup tizring Ring buffer
+ *
+ * A double-ended sequence of pointers stored in a circular array. Adding at
+ * the back and removing at either end are O(1) and never move the other
+ * items; removing from the middle moves the items on the shorter side of the
+ * removed one. The ring grows when it is full, so a ring created with the
+ * right capacity never allocates again.
+ *
+ * @ingroup libtizplatform
+ */
+
+#include <OMX_Core.h>
+#include <OMX_Types.h>
+
+/**
+ * Ring buffer opaque structure.
+ * @ingroup tizring
+ */
+typedef struct tiz_ring tiz_ring_t;
+typedef /*@null@ */ tiz_ring_t * tiz_ring_ptr_t;
+
+/**
+ * Create an empty ring.
+ *
+ * @ingroup tizring
+ *
+ * @param a_capacity The number of items the ring can hold before it needs to
+ * grow (may be zero).
+ *
+ * @return OMX_ErrorNone if success, OMX_ErrorInsufficientResources otherwise.
+ */
+OMX_ERRORTYPE
+tiz_ring_init (/*@out@*/ tiz_ring_ptr_t * app_ring, OMX_S32 a_capacity);
+
+/**
+ * Destroy the ring. The items are not freed. If ap_ring is NULL, no
+ * operation is performed.
+ *
+ * @ingroup tizring
+ *
+ */
+void
+tiz_ring_destroy (/*@null@ */ tiz_ring_t * ap_ring);
+
+/**
+ * Make sure the ring can hold at least a_capacity items without growing.
+ *
+ * @ingroup tizring
+ *
+ * @return OMX_ErrorNone if success, OMX_ErrorInsufficientResources otherwise.
+ */
+OMX_ERRORTYPE
+tiz_ring_reserve (tiz_ring_t * ap_ring, OMX_S32 a_capacity);
+
+/**
+ * Add an item at the back of the ring.
+ *
+ * @ingroup tizring
+ *
+ * @return OMX_ErrorNone if success, OMX_ErrorInsufficientResources if the
+ * ring was full and could not grow.
+ */
+OMX_ERRORTYPE
+tiz_ring_push_back (tiz_ring_t * ap_ring, OMX_PTR ap_data);
+
+/**
+ * Retrieve the item at a given position, where zero is the front of the
+ * ring.
+ *
+ * @ingroup tizring
+ *
+ */
+OMX_PTR
+tiz_ring_at (const tiz_ring_t * ap_ring, OMX_S32 a_pos);
+
+/**
+ * Remove the item at a given position. This is O(1) at the front and at the
+ * back of the ring.
+ *
+ * @ingroup tizring
+ *
+ */
+void
+tiz_ring_erase (tiz_ring_t * ap_ring, OMX_S32 a_pos);
+
+/**
+ * Add all the items of ap_src, in order, at the back of ap_dst.
+ *
+ * @ingroup tizring
+ *
+ * @return OMX_ErrorNone if success, OMX_ErrorInsufficientResources
+ * otherwise, in which case ap_dst is not modified.
+ */
+OMX_ERRORTYPE
+tiz_ring_append (tiz_ring_t * ap_dst, const tiz_ring_t * ap_src);
+
+/**
+ * Remove all the items. The ring keeps its current capacity.
+ *
+ * @ingroup tizring
+ *
+ */
+void
+tiz_ring_clear (tiz_ring_t * ap_ring);
+
+/**
+ * @ingroup tizring
+ * @return The number of items in the ring.
+ */
+OMX_S32
+tiz_ring_length (const tiz_ring_t * ap_ring);
+
+/**
+ * @ingroup tizring
+ * @return The number of items the ring can hold before it needs to grow.
+ */
+OMX_S32
+tiz_ring_capacity (const tiz_ring_t * ap_ring);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TIZRING_H */
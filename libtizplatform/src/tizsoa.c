@@ -33,47 +33,111 @@
 #include "tizplatform.h"
 
 #include <assert.h>
+#include <pthread.h>
 #include <stdlib.h>
 #include <string.h>
+#include <sys/mman.h>
 
 #ifdef TIZ_LOG_CATEGORY_NAME
 #undef TIZ_LOG_CATEGORY_NAME
 #define TIZ_LOG_CATEGORY_NAME "tiz.platform.soa"
 #endif
 
-#define SOA_MAX_SLICE_SIZE 256
-#define SOA_SLICE_ALIGN 8
+#define SOA_MAX_SLICE_SIZE 4096
+#define SOA_SLICE_ALIGN 16
 #define SOA_CHUNK_SZ 4096
+#define SOA_MIN_SLICES_PER_CHUNK 8
 
-static const int32_t chunk_class_tbl[] = {
-  0, 0, 0, 0, 0,                                 /* 32 bytes */
-  1, 1, 1, 1,                                    /* 64 bytes */
-  2, 2, 2, 2,                                    /* 96 bytes */
-  3, 3, 3, 3,                                    /* 128 bytes */
-  4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4 /* 256 bytes */
-};
+/* The shared allocator's chunks ('spans') are all the same size, so that an
+   empty one can be reused for any class */
+#define SOA_SPAN_SZ (64 * 1024)
+#define SOA_REGION_SZ \
+  (sizeof (void *) > 4 ? 256 * 1024 * 1024 : 32 * 1024 * 1024)
+
+/* How much a thread may cache, per class */
+#define SOA_MAGAZINE_BYTES (16 * 1024)
+#define SOA_MAGAZINE_MIN 4
+#define SOA_MAGAZINE_MAX 64
 
 static const size_t slice_sz_tbl[TIZ_SOA_NUM_CHUNK_CLASSES]
-  = {32, 64, 96, 128, 256};
+  = {32, 64, 96, 128, 256, 384, 512, 768, 1024, 1536, 2048, 3072, 4096};
 
+typedef struct slice slice_t;
 typedef struct chunk chunk_t;
+
 struct chunk
 {
-  chunk_t * p_next;
+  chunk_t * p_next; /* all the chunks */
+  chunk_t * p_prev;
+  chunk_t * p_next_avail; /* the chunks of a class with free slices */
+  chunk_t * p_prev_avail;
   tiz_soa_t * p_soa;
+  slice_t * p_free_slices;
+  uint8_t * p_unused; /* slices never handed out start here */
+  uint8_t * p_end;
+  size_t size;
   int32_t n_allocated_slices;
   int32_t class;
-  uint8_t data[SOA_CHUNK_SZ];
 };
+#define CHUNK_HEADER_SZ \
+  ((sizeof (chunk_t) + SOA_SLICE_ALIGN - 1) & ~(SOA_SLICE_ALIGN - 1))
 
-typedef struct slice slice_t;
 struct slice
 {
-  size_t size;
+  void * p_tag;
   chunk_t * p_chunk;
-  slice_t * p_next_free;
+  slice_t * p_next_free; /* only while the slice is free */
+};
+#define SLICE_PREAMBLE_SZ SOA_SLICE_ALIGN
+
+typedef struct soa_magazine soa_magazine_t;
+struct soa_magazine
+{
+  slice_t * p_head;
+  int32_t count;
+};
+
+/* A thread's magazines, for the shared allocator */
+typedef struct soa_cache soa_cache_t;
+struct soa_cache
+{
+  soa_magazine_t mags[TIZ_SOA_NUM_CHUNK_CLASSES];
+  uint64_t n_allocs;
+  uint64_t n_frees;
+  soa_cache_t * p_next;
+  soa_cache_t * p_prev;
+};
+
+struct tiz_soa
+{
+  chunk_t * p_avail[TIZ_SOA_NUM_CHUNK_CLASSES];
+  int32_t n_empty[TIZ_SOA_NUM_CHUNK_CLASSES];
+  chunk_t * p_chunk_lst;
+  int32_t n_chunks;
+  int32_t n_released;
+  int32_t n_allocated_objects; /* slices handed out by the chunks */
+  size_t chunk_bytes;
+  uint64_t n_allocs;
+  uint64_t n_frees;
+  /* Only used by the shared allocator */
+  bool shared;
+  pthread_mutex_t mutex;
+  uint8_t * p_region;
+  size_t region_sz;
+  size_t region_used;
+  uint32_t * p_free_spans;
+  uint32_t n_free_spans;
+  int32_t mag_max[TIZ_SOA_NUM_CHUNK_CLASSES];
+  soa_cache_t * p_caches;
 };
-#define SLICE_PREAMBLE_SZ (sizeof (size_t) + sizeof (chunk_t *))
+
+static pthread_once_t g_soa_shared_once = PTHREAD_ONCE_INIT;
+static tiz_soa_t * gp_soa_shared = NULL;
+static pthread_key_t g_soa_cache_key;
+static __thread soa_cache_t * tp_soa_cache = NULL;
+/* Set once the thread's cache has been released; a cache created after that
+   (e.g. by a later TLS destructor) would never be released */
+static __thread bool tp_soa_cache_released = false;
 
 static inline uint8_t *
 get_usr_ptr (slice_t * p_slice)
@@ -82,66 +146,485 @@ get_usr_ptr (slice_t * p_slice)
 }
 
 static inline slice_t *
-get_slice_ptr (void * p_usr)
+get_slice_ptr (const void * p_usr)
 {
   return ((slice_t *) ((uint8_t *) p_usr - SLICE_PREAMBLE_SZ));
 }
 
-struct tiz_soa
+static inline size_t
+get_alloc_sz (const size_t a_size)
 {
-  slice_t * p_slice_store[TIZ_SOA_NUM_CHUNK_CLASSES];
-  slice_t * p_pending_chain;
-  chunk_t * p_chunk_lst;
-  int32_t n_chunks;
-  int32_t n_allocated_objects;
-};
+  return ((a_size + SOA_SLICE_ALIGN - 1) & ~(SOA_SLICE_ALIGN - 1))
+         + SLICE_PREAMBLE_SZ;
+}
 
-/*@null@*/ static slice_t *
+static inline int32_t
+get_chunk_class (const size_t a_alloc_sz)
+{
+  int32_t chunk_class = 4;
+
+  assert (a_alloc_sz > 0);
+  assert (a_alloc_sz <= SOA_MAX_SLICE_SIZE);
+
+  if (a_alloc_sz <= slice_sz_tbl[3])
+    {
+      /* The first classes are 32 bytes apart */
+      return (int32_t) ((a_alloc_sz - 1) >> 5);
+    }
+
+  while (slice_sz_tbl[chunk_class] < a_alloc_sz)
+    {
+      ++chunk_class;
+    }
+
+  return chunk_class;
+}
+
+static inline bool
+is_chunk_full (const chunk_t * p_chunk)
+{
+  return (!p_chunk->p_free_slices
+          && p_chunk->p_unused + slice_sz_tbl[p_chunk->class]
+               > p_chunk->p_end);
+}
+
+static void
+link_avail_chunk (tiz_soa_t * p_soa, chunk_t * p_chunk)
+{
+  chunk_t ** pp_head = &(p_soa->p_avail[p_chunk->class]);
+  p_chunk->p_prev_avail = NULL;
+  p_chunk->p_next_avail = *pp_head;
+  if (*pp_head)
+    {
+      (*pp_head)->p_prev_avail = p_chunk;
+    }
+  *pp_head = p_chunk;
+}
+
+static void
+unlink_avail_chunk (tiz_soa_t * p_soa, chunk_t * p_chunk)
+{
+  if (p_chunk->p_prev_avail)
+    {
+      p_chunk->p_prev_avail->p_next_avail = p_chunk->p_next_avail;
+    }
+  else
+    {
+      p_soa->p_avail[p_chunk->class] = p_chunk->p_next_avail;
+    }
+  if (p_chunk->p_next_avail)
+    {
+      p_chunk->p_next_avail->p_prev_avail = p_chunk->p_prev_avail;
+    }
+  p_chunk->p_next_avail = p_chunk->p_prev_avail = NULL;
+}
+
+/*@null@*/ static void *
+alloc_span (tiz_soa_t * p_soa)
+{
+  uint8_t * p_span = NULL;
+
+  if (p_soa->n_free_spans > 0)
+    {
+      /* Released spans are still accessible, just without backing pages */
+      p_span = p_soa->p_region
+               + (size_t) p_soa->p_free_spans[--p_soa->n_free_spans]
+                   * SOA_SPAN_SZ;
+    }
+  else if (p_soa->region_used + SOA_SPAN_SZ <= p_soa->region_sz)
+    {
+      p_span = p_soa->p_region + p_soa->region_used;
+      if (0 != mprotect (p_span, SOA_SPAN_SZ, PROT_READ | PROT_WRITE))
+        {
+          return NULL;
+        }
+      /* NOTE: Read without the mutex by tiz_soa_owns */
+      __atomic_store_n (&(p_soa->region_used),
+                        p_soa->region_used + SOA_SPAN_SZ, __ATOMIC_RELEASE);
+    }
+
+  return p_span;
+}
+
+static void
+free_span (tiz_soa_t * p_soa, void * ap_span)
+{
+  (void) madvise (ap_span, SOA_SPAN_SZ, MADV_DONTNEED);
+  p_soa->p_free_spans[p_soa->n_free_spans++]
+    = (uint32_t) (((uint8_t *) ap_span - p_soa->p_region) / SOA_SPAN_SZ);
+}
+
+/*@null@*/ static chunk_t *
 alloc_chunk (tiz_soa_t * p_soa, int32_t chunk_class)
 {
-  slice_t * p_slice = NULL;
-  int32_t num_slices = 0;
-  size_t slice_sz = 0;
   chunk_t * p_new_chunk = NULL;
+  size_t chunk_sz = 0;
 
   TIZ_LOG (TIZ_PRIORITY_TRACE, "chunk_class [%d] ", chunk_class);
 
   assert (p_soa != NULL);
   assert (chunk_class < TIZ_SOA_NUM_CHUNK_CLASSES);
 
-  slice_sz = slice_sz_tbl[chunk_class];
+  if (p_soa->shared)
+    {
+      chunk_sz = SOA_SPAN_SZ;
+      p_new_chunk = alloc_span (p_soa);
+    }
+  else
+    {
+      const size_t data_sz
+        = MAX (SOA_CHUNK_SZ,
+               SOA_MIN_SLICES_PER_CHUNK * slice_sz_tbl[chunk_class]);
+      chunk_sz = CHUNK_HEADER_SZ + data_sz;
+      p_new_chunk = tiz_mem_alloc (chunk_sz);
+    }
 
-  if ((p_new_chunk = tiz_mem_calloc (1, sizeof (chunk_t))))
+  if (p_new_chunk)
     {
+      /* Slices are carved out of the chunk as they are needed */
       p_new_chunk->p_soa = p_soa;
-      p_new_chunk->p_next = p_soa->p_chunk_lst;
+      p_new_chunk->p_free_slices = NULL;
+      p_new_chunk->p_unused = (uint8_t *) p_new_chunk + CHUNK_HEADER_SZ;
+      p_new_chunk->p_end = (uint8_t *) p_new_chunk + chunk_sz;
+      p_new_chunk->size = chunk_sz;
       p_new_chunk->n_allocated_slices = 0;
       p_new_chunk->class = chunk_class;
+      p_new_chunk->p_prev = NULL;
+      p_new_chunk->p_next = p_soa->p_chunk_lst;
+      if (p_soa->p_chunk_lst)
+        {
+          p_soa->p_chunk_lst->p_prev = p_new_chunk;
+        }
       p_soa->p_chunk_lst = p_new_chunk;
+      link_avail_chunk (p_soa, p_new_chunk);
       p_soa->n_chunks += 1;
-      num_slices = SOA_CHUNK_SZ / slice_sz - 2;
-      p_soa->p_slice_store[chunk_class] = p_slice
-        = (slice_t *) (p_new_chunk->data + slice_sz);
-      do
+      p_soa->n_empty[chunk_class] += 1;
+      p_soa->chunk_bytes += chunk_sz;
+    }
+
+  return p_new_chunk;
+}
+
+static void
+release_chunk (tiz_soa_t * p_soa, chunk_t * p_chunk)
+{
+  TIZ_LOG (TIZ_PRIORITY_TRACE, "chunk_class [%d] ", p_chunk->class);
+
+  unlink_avail_chunk (p_soa, p_chunk);
+  if (p_chunk->p_prev)
+    {
+      p_chunk->p_prev->p_next = p_chunk->p_next;
+    }
+  else
+    {
+      p_soa->p_chunk_lst = p_chunk->p_next;
+    }
+  if (p_chunk->p_next)
+    {
+      p_chunk->p_next->p_prev = p_chunk->p_prev;
+    }
+  p_soa->n_chunks -= 1;
+  p_soa->n_released += 1;
+  p_soa->chunk_bytes -= p_chunk->size;
+
+  if (p_soa->shared)
+    {
+      free_span (p_soa, p_chunk);
+    }
+  else
+    {
+      tiz_mem_free (p_chunk);
+    }
+}
+
+/* Takes a free slice from the class' chunks */
+/*@null@*/ static slice_t *
+take_slice (tiz_soa_t * p_soa, int32_t chunk_class)
+{
+  chunk_t * p_chunk = p_soa->p_avail[chunk_class];
+  slice_t * p_slice = NULL;
+
+  if (!p_chunk && !(p_chunk = alloc_chunk (p_soa, chunk_class)))
+    {
+      return NULL;
+    }
+
+  if (p_chunk->p_free_slices)
+    {
+      p_slice = p_chunk->p_free_slices;
+      p_chunk->p_free_slices = p_slice->p_next_free;
+    }
+  else
+    {
+      p_slice = (slice_t *) p_chunk->p_unused;
+      p_slice->p_chunk = p_chunk;
+      p_chunk->p_unused += slice_sz_tbl[chunk_class];
+    }
+
+  if (0 == p_chunk->n_allocated_slices++)
+    {
+      p_soa->n_empty[chunk_class] -= 1;
+    }
+  if (is_chunk_full (p_chunk))
+    {
+      unlink_avail_chunk (p_soa, p_chunk);
+    }
+  p_soa->n_allocated_objects += 1;
+
+  return p_slice;
+}
+
+/* Gives a slice back to its chunk; an empty chunk is released, unless it is
+   the only empty chunk left in its class */
+static void
+give_slice (tiz_soa_t * p_soa, slice_t * p_slice)
+{
+  chunk_t * p_chunk = p_slice->p_chunk;
+  const int32_t chunk_class = p_chunk->class;
+
+  assert (p_chunk != NULL);
+  assert (p_chunk->p_soa == p_soa);
+  assert (p_chunk->n_allocated_slices > 0);
+
+  if (is_chunk_full (p_chunk))
+    {
+      link_avail_chunk (p_soa, p_chunk);
+    }
+  p_slice->p_next_free = p_chunk->p_free_slices;
+  p_chunk->p_free_slices = p_slice;
+  p_soa->n_allocated_objects -= 1;
+
+  if (0 == --p_chunk->n_allocated_slices)
+    {
+      if (p_soa->n_empty[chunk_class] > 0)
+        {
+          release_chunk (p_soa, p_chunk);
+        }
+      else
         {
-          slice_t * p_next = (slice_t *) ((uint8_t *) p_slice + slice_sz);
-          p_slice->p_chunk = p_new_chunk;
-          p_slice->size = 0;
-          p_slice->p_next_free = p_next;
-          p_slice = p_next;
+          p_soa->n_empty[chunk_class] += 1;
         }
-      while (--num_slices != 0);
+    }
+}
 
-      p_slice->p_chunk = p_new_chunk;
-      p_slice->size = 0;
-      p_slice->p_next_free = NULL;
-      p_slice = (slice_t *) p_new_chunk->data;
-      p_slice->p_chunk = p_new_chunk;
+static void
+flush_magazine (tiz_soa_t * p_soa, soa_magazine_t * p_mag, int32_t a_count)
+{
+  /* Called with the shared allocator's mutex held */
+  while (a_count-- > 0 && p_mag->p_head)
+    {
+      slice_t * p_slice = p_mag->p_head;
+      p_mag->p_head = p_slice->p_next_free;
+      p_mag->count -= 1;
+      give_slice (p_soa, p_slice);
+    }
+}
+
+static void
+refill_magazine (tiz_soa_t * p_soa, soa_magazine_t * p_mag,
+                 int32_t chunk_class)
+{
+  int32_t count = p_soa->mag_max[chunk_class] / 2;
+
+  (void) pthread_mutex_lock (&(p_soa->mutex));
+  while (count-- > 0)
+    {
+      slice_t * p_slice = take_slice (p_soa, chunk_class);
+      if (!p_slice)
+        {
+          break;
+        }
+      p_slice->p_next_free = p_mag->p_head;
+      p_mag->p_head = p_slice;
+      p_mag->count += 1;
+    }
+  (void) pthread_mutex_unlock (&(p_soa->mutex));
+}
+
+static void
+release_cache (void * ap_cache)
+{
+  soa_cache_t * p_cache = ap_cache;
+  tiz_soa_t * p_soa = gp_soa_shared;
+  int32_t i = 0;
+
+  assert (p_soa);
+
+  /* The thread is exiting; whatever it cached goes back to the chunks */
+  (void) pthread_mutex_lock (&(p_soa->mutex));
+  for (i = 0; i < TIZ_SOA_NUM_CHUNK_CLASSES; ++i)
+    {
+      flush_magazine (p_soa, &(p_cache->mags[i]), p_cache->mags[i].count);
+    }
+  p_soa->n_allocs += p_cache->n_allocs;
+  p_soa->n_frees += p_cache->n_frees;
+  if (p_cache->p_prev)
+    {
+      p_cache->p_prev->p_next = p_cache->p_next;
+    }
+  else
+    {
+      p_soa->p_caches = p_cache->p_next;
+    }
+  if (p_cache->p_next)
+    {
+      p_cache->p_next->p_prev = p_cache->p_prev;
+    }
+  (void) pthread_mutex_unlock (&(p_soa->mutex));
+
+  tp_soa_cache = NULL;
+  tp_soa_cache_released = true;
+  free (p_cache);
+}
+
+/*@null@*/ static inline soa_cache_t *
+get_cache (tiz_soa_t * p_soa)
+{
+  soa_cache_t * p_cache = tp_soa_cache;
+
+  /* NOTE: This allocator's own bookkeeping can't come from itself. A thread
+     that is being torn down goes straight to the shared chunks */
+  if (!p_cache && !tp_soa_cache_released
+      && (p_cache = calloc (1, sizeof (soa_cache_t))))
+    {
+      (void) pthread_mutex_lock (&(p_soa->mutex));
+      p_cache->p_next = p_soa->p_caches;
+      if (p_soa->p_caches)
+        {
+          p_soa->p_caches->p_prev = p_cache;
+        }
+      p_soa->p_caches = p_cache;
+      (void) pthread_mutex_unlock (&(p_soa->mutex));
+      (void) pthread_setspecific (g_soa_cache_key, p_cache);
+      tp_soa_cache = p_cache;
+    }
+
+  return p_cache;
+}
+
+/*@null@*/ static slice_t *
+take_shared_slice (tiz_soa_t * p_soa, int32_t chunk_class)
+{
+  soa_cache_t * p_cache = get_cache (p_soa);
+  slice_t * p_slice = NULL;
+
+  if (p_cache)
+    {
+      soa_magazine_t * p_mag = &(p_cache->mags[chunk_class]);
+      if (!p_mag->p_head)
+        {
+          refill_magazine (p_soa, p_mag, chunk_class);
+        }
+      if ((p_slice = p_mag->p_head))
+        {
+          p_mag->p_head = p_slice->p_next_free;
+          p_mag->count -= 1;
+          p_cache->n_allocs += 1;
+        }
+    }
+  else
+    {
+      (void) pthread_mutex_lock (&(p_soa->mutex));
+      if ((p_slice = take_slice (p_soa, chunk_class)))
+        {
+          p_soa->n_allocs += 1;
+        }
+      (void) pthread_mutex_unlock (&(p_soa->mutex));
     }
 
   return p_slice;
 }
 
+static void
+give_shared_slice (tiz_soa_t * p_soa, slice_t * p_slice)
+{
+  soa_cache_t * p_cache = get_cache (p_soa);
+
+  if (p_cache)
+    {
+      const int32_t chunk_class = p_slice->p_chunk->class;
+      soa_magazine_t * p_mag = &(p_cache->mags[chunk_class]);
+      p_slice->p_next_free = p_mag->p_head;
+      p_mag->p_head = p_slice;
+      p_mag->count += 1;
+      p_cache->n_frees += 1;
+      if (p_mag->count > p_soa->mag_max[chunk_class])
+        {
+          (void) pthread_mutex_lock (&(p_soa->mutex));
+          flush_magazine (p_soa, p_mag, p_soa->mag_max[chunk_class] / 2);
+          (void) pthread_mutex_unlock (&(p_soa->mutex));
+        }
+    }
+  else
+    {
+      (void) pthread_mutex_lock (&(p_soa->mutex));
+      give_slice (p_soa, p_slice);
+      p_soa->n_frees += 1;
+      (void) pthread_mutex_unlock (&(p_soa->mutex));
+    }
+}
+
+static void
+lock_shared (void)
+{
+  (void) pthread_mutex_lock (&(gp_soa_shared->mutex));
+}
+
+static void
+unlock_shared (void)
+{
+  (void) pthread_mutex_unlock (&(gp_soa_shared->mutex));
+}
+
+static void
+init_shared (void)
+{
+  tiz_soa_t * p_soa = NULL;
+  void * p_region = MAP_FAILED;
+  int32_t i = 0;
+
+  if (!(p_soa = calloc (1, sizeof (tiz_soa_t)))
+      || !(p_soa->p_free_spans
+           = calloc (SOA_REGION_SZ / SOA_SPAN_SZ, sizeof (uint32_t)))
+      || MAP_FAILED
+           == (p_region = mmap (NULL, SOA_REGION_SZ, PROT_NONE,
+                                MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE,
+                                -1, 0))
+      || 0 != pthread_key_create (&g_soa_cache_key, release_cache))
+    {
+      TIZ_LOG (TIZ_PRIORITY_ERROR,
+               "[OMX_ErrorInsufficientResources] : "
+               "Unable to create the shared allocator");
+      if (MAP_FAILED != p_region)
+        {
+          (void) munmap (p_region, SOA_REGION_SZ);
+        }
+      if (p_soa)
+        {
+          free (p_soa->p_free_spans);
+          free (p_soa);
+        }
+      return;
+    }
+
+  /* Address space is only reserved here; spans are made accessible as they
+     are needed */
+  p_soa->shared = true;
+  p_soa->p_region = p_region;
+  p_soa->region_sz = SOA_REGION_SZ;
+  (void) pthread_mutex_init (&(p_soa->mutex), NULL);
+  for (i = 0; i < TIZ_SOA_NUM_CHUNK_CLASSES; ++i)
+    {
+      p_soa->mag_max[i]
+        = MIN (SOA_MAGAZINE_MAX,
+               MAX (SOA_MAGAZINE_MIN, SOA_MAGAZINE_BYTES / slice_sz_tbl[i]));
+    }
+  gp_soa_shared = p_soa;
+
+  /* A child process must not inherit a locked mutex */
+  (void) pthread_atfork (lock_shared, unlock_shared, unlock_shared);
+}
+
 OMX_ERRORTYPE
 tiz_soa_init (/*@null@ */ tiz_soa_ptr_t * app_soa)
 {
@@ -160,21 +643,39 @@ tiz_soa_init (/*@null@ */ tiz_soa_ptr_t * app_soa)
   return rc;
 }
 
+/*@null@ */ tiz_soa_t *
+tiz_soa_shared (void)
+{
+  (void) pthread_once (&g_soa_shared_once, init_shared);
+  return gp_soa_shared;
+}
+
 OMX_ERRORTYPE
 tiz_soa_reserve_chunk (tiz_soa_t * p_soa, int32_t chunk_class)
 {
+  chunk_t * p_chunk = NULL;
+
   assert (p_soa != NULL);
   assert (chunk_class < TIZ_SOA_NUM_CHUNK_CLASSES);
 
-  return alloc_chunk (p_soa, chunk_class) == NULL
-           ? OMX_ErrorInsufficientResources
-           : OMX_ErrorNone;
+  if (p_soa->shared)
+    {
+      (void) pthread_mutex_lock (&(p_soa->mutex));
+    }
+  p_chunk = alloc_chunk (p_soa, chunk_class);
+  if (p_soa->shared)
+    {
+      (void) pthread_mutex_unlock (&(p_soa->mutex));
+    }
+
+  return p_chunk == NULL ? OMX_ErrorInsufficientResources : OMX_ErrorNone;
 }
 
 void
 tiz_soa_destroy (tiz_soa_t * p_soa)
 {
-  if (p_soa)
+  /* NOTE: The shared allocator lives as long as the process */
+  if (p_soa && !p_soa->shared)
     {
       chunk_t * p_chunk = NULL;
       chunk_t * p_next = NULL;
@@ -193,40 +694,42 @@ tiz_soa_destroy (tiz_soa_t * p_soa)
 }
 
 /*@null@*/ void *
-tiz_soa_calloc (tiz_soa_t * p_soa, size_t size)
+tiz_soa_alloc (tiz_soa_t * p_soa, size_t size)
 {
-  size_t alloc_sz = ((size + SOA_SLICE_ALIGN - 1) & ~(SOA_SLICE_ALIGN - 1))
-                    + SLICE_PREAMBLE_SZ;
-  uint8_t * p_usr = NULL;
+  const size_t alloc_sz = get_alloc_sz (size);
+  const int32_t chunk_class = get_chunk_class (alloc_sz);
+  slice_t * p_slice = NULL;
 
   assert (p_soa);
-  assert (alloc_sz > 0);
-  assert (alloc_sz <= SOA_MAX_SLICE_SIZE);
-
-  {
-    int32_t chunk_class = chunk_class_tbl[alloc_sz / SOA_SLICE_ALIGN];
-    slice_t * p_slice = NULL;
-
-    p_slice = p_soa->p_slice_store[chunk_class];
-
-    if (NULL == p_slice)
-      {
-        p_slice = alloc_chunk (p_soa, chunk_class);
-      }
-    else
-      {
-        p_soa->p_slice_store[chunk_class] = p_slice->p_next_free;
-      }
-
-    if (p_slice)
-      {
-        p_slice->p_chunk->n_allocated_slices += 1;
-        p_soa->n_allocated_objects += 1;
-        p_slice->size = alloc_sz;
-        p_usr = get_usr_ptr (p_slice);
-        (void) tiz_mem_set (p_usr, 0, size);
-      }
-  }
+  assert (size <= TIZ_SOA_MAX_OBJECT_SIZE);
+
+  if (p_soa->shared)
+    {
+      p_slice = take_shared_slice (p_soa, chunk_class);
+    }
+  else if ((p_slice = take_slice (p_soa, chunk_class)))
+    {
+      p_soa->n_allocs += 1;
+    }
+
+  if (p_slice)
+    {
+      p_slice->p_tag = NULL;
+      return get_usr_ptr (p_slice);
+    }
+
+  return NULL;
+}
+
+/*@null@*/ void *
+tiz_soa_calloc (tiz_soa_t * p_soa, size_t size)
+{
+  uint8_t * p_usr = tiz_soa_alloc (p_soa, size);
+
+  if (p_usr)
+    {
+      (void) tiz_mem_set (p_usr, 0, size);
+    }
 
   return p_usr;
 }
@@ -241,45 +744,123 @@ tiz_soa_free (tiz_soa_t * p_soa, void * p_addr)
       slice_t * p_slice = get_slice_ptr (p_addr);
 
       assert (p_slice != NULL);
-      assert (p_slice->size <= SOA_MAX_SLICE_SIZE);
-      {
-        chunk_t * p_chunk = p_slice->p_chunk;
-        int32_t chunk_class = chunk_class_tbl[p_slice->size / SOA_SLICE_ALIGN];
+      assert (p_slice->p_chunk != NULL);
+      assert (p_slice->p_chunk->class < TIZ_SOA_NUM_CHUNK_CLASSES);
+
+      if (p_soa->shared)
+        {
+          give_shared_slice (p_soa, p_slice);
+        }
+      else
+        {
+          give_slice (p_soa, p_slice);
+          p_soa->n_frees += 1;
+        }
+    }
+}
+
+size_t
+tiz_soa_usable_size (const void * ap_addr)
+{
+  const slice_t * p_slice = get_slice_ptr (ap_addr);
+  assert (ap_addr);
+  return slice_sz_tbl[p_slice->p_chunk->class] - SLICE_PREAMBLE_SZ;
+}
+
+void
+tiz_soa_set_tag (void * ap_addr, void * ap_tag)
+{
+  assert (ap_addr);
+  get_slice_ptr (ap_addr)->p_tag = ap_tag;
+}
+
+void *
+tiz_soa_get_tag (const void * ap_addr)
+{
+  assert (ap_addr);
+  return get_slice_ptr (ap_addr)->p_tag;
+}
+
+bool
+tiz_soa_owns (const tiz_soa_t * p_soa, const void * ap_addr)
+{
+  const chunk_t * p_chunk = NULL;
 
-        assert (p_chunk != NULL);
+  assert (p_soa != NULL);
 
-        p_slice->p_chunk->n_allocated_slices -= 1;
-        p_soa->n_allocated_objects -= 1;
-        p_slice->p_next_free = p_soa->p_slice_store[chunk_class];
-        p_soa->p_slice_store[chunk_class] = p_slice;
-      }
+  if (p_soa->shared)
+    {
+      return ((uintptr_t) ap_addr - (uintptr_t) p_soa->p_region
+              < __atomic_load_n (&(p_soa->region_used), __ATOMIC_ACQUIRE));
     }
+
+  for (p_chunk = p_soa->p_chunk_lst; p_chunk; p_chunk = p_chunk->p_next)
+    {
+      if ((const uint8_t *) ap_addr > (const uint8_t *) p_chunk
+          && (const uint8_t *) ap_addr < p_chunk->p_end)
+        {
+          return true;
+        }
+    }
+
+  return false;
 }
 
 void
 tiz_soa_info (tiz_soa_t * p_soa, tiz_soa_info_t * p_info)
 {
+  const soa_cache_t * p_cache = NULL;
+  const chunk_t * p_chunk = NULL;
   int32_t i = 0;
-  chunk_t * p_chunk = NULL;
 
   assert (p_soa != NULL);
   assert (p_info != NULL);
 
   (void) tiz_mem_set (p_info, 0, sizeof (tiz_soa_info_t));
 
-  p_info->chunks = p_soa->n_chunks;
-  p_chunk = p_soa->p_chunk_lst;
+  if (p_soa->shared)
+    {
+      (void) pthread_mutex_lock (&(p_soa->mutex));
+    }
 
-  for (i = p_soa->n_chunks; i > 0; --i)
+  for (p_chunk = p_soa->p_chunk_lst; p_chunk; p_chunk = p_chunk->p_next)
     {
-      p_info->slices[p_chunk->class] = p_chunk->n_allocated_slices;
-      p_chunk = p_chunk->p_next;
+      p_info->slices[p_chunk->class] += p_chunk->n_allocated_slices;
     }
 
-  assert (p_chunk == NULL);
+  p_info->objects = p_soa->n_allocated_objects;
+  p_info->allocs = p_soa->n_allocs;
+  p_info->frees = p_soa->n_frees;
+
+  /* The slices in the threads' magazines are free, but the chunks count them
+     as allocated. NOTE: The other threads update their magazines and counters
+     without the mutex; these are just snapshots */
+  for (p_cache = p_soa->p_caches; p_cache; p_cache = p_cache->p_next)
+    {
+      for (i = 0; i < TIZ_SOA_NUM_CHUNK_CLASSES; ++i)
+        {
+          const int32_t count = p_cache->mags[i].count;
+          p_info->slices[i] -= count;
+          p_info->objects -= count;
+          p_info->cached += count;
+        }
+      p_info->allocs += p_cache->n_allocs;
+      p_info->frees += p_cache->n_frees;
+    }
+
+  for (i = 0; i < TIZ_SOA_NUM_CHUNK_CLASSES; ++i)
+    {
+      p_info->slice_bytes += (size_t) p_info->slices[i] * slice_sz_tbl[i];
+    }
 
   p_info->chunks = p_soa->n_chunks;
-  p_info->objects = p_soa->n_allocated_objects;
+  p_info->released = p_soa->n_released;
+  p_info->chunk_bytes = p_soa->chunk_bytes;
+
+  if (p_soa->shared)
+    {
+      (void) pthread_mutex_unlock (&(p_soa->mutex));
+    }
 
   TIZ_LOG (TIZ_PRIORITY_TRACE, "objects [%d] chunks [%d]", p_info->objects,
            p_info->chunks);
@@ -33,13 +33,18 @@
 extern "C" {
 #endif /* __cplusplus */
 
+#include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
 
 #include <OMX_Types.h>
 #include <OMX_Core.h>
 
-#define TIZ_SOA_NUM_CHUNK_CLASSES 5
+#define TIZ_SOA_NUM_CHUNK_CLASSES 13
+
+/* The largest object the allocator serves; every slice carries a 16-byte
+   preamble, and the largest slice class is 4 KB */
+#define TIZ_SOA_MAX_OBJECT_SIZE 4080
 
 typedef struct tiz_soa tiz_soa_t;
 typedef /*@null@ */ tiz_soa_t * tiz_soa_ptr_t;
@@ -50,15 +55,47 @@ tiz_soa_init (/*@null@ */ tiz_soa_ptr_t * app_soa);
 void
 tiz_soa_destroy (tiz_soa_t * p_soa);
 
+/* The process-wide allocator. Unlike the instances created with
+   tiz_soa_init, it may be used from any thread: each thread keeps a few free
+   slices of each class at hand (a 'magazine'), so that most allocations and
+   frees don't need its lock. Its chunks live in a reserved address range, and
+   empty chunks go back to the system. It is never destroyed; returns NULL if
+   the address range can't be reserved. */
+/*@null@ */ tiz_soa_t *
+tiz_soa_shared (void);
+
 OMX_ERRORTYPE
 tiz_soa_reserve_chunk (tiz_soa_t * p_soa, int32_t chunk_class);
 
+/* Objects are 16-byte aligned, and at most TIZ_SOA_MAX_OBJECT_SIZE bytes */
 /*@null@ */ void *
 tiz_soa_calloc (tiz_soa_t * p_soa, size_t a_size);
 
+/* Same as tiz_soa_calloc, without clearing the object */
+/*@null@ */ void *
+tiz_soa_alloc (tiz_soa_t * p_soa, size_t a_size);
+
 void
 tiz_soa_free (tiz_soa_t * p_soa, void * ap_addr);
 
+/* The number of bytes that may be used in an object (at least the size that
+   was requested) */
+size_t
+tiz_soa_usable_size (const void * ap_addr);
+
+/* Objects may carry a pointer-sized tag (e.g. to tell who allocated them);
+   it is NULL when the object is allocated */
+void
+tiz_soa_set_tag (void * ap_addr, void * ap_tag);
+
+void *
+tiz_soa_get_tag (const void * ap_addr);
+
+/* Whether an address belongs to an object of this allocator. This is cheap
+   for the shared allocator; other instances look through their chunks. */
+bool
+tiz_soa_owns (const tiz_soa_t * p_soa, const void * ap_addr);
+
 typedef struct tiz_soa_info tiz_soa_info_t;
 struct tiz_soa_info
 {
@@ -68,8 +105,21 @@ struct tiz_soa_info
   int32_t objects;
   /* Number of slices currently in use in each chunk class */
   int32_t slices[TIZ_SOA_NUM_CHUNK_CLASSES];
+  /* Number of free slices held in the threads' magazines */
+  int32_t cached;
+  /* Number of empty chunks released so far */
+  int32_t released;
+  /* Bytes currently held in chunks */
+  size_t chunk_bytes;
+  /* Bytes in the slices currently in use (preambles included) */
+  size_t slice_bytes;
+  /* Total number of allocations and frees so far */
+  uint64_t allocs;
+  uint64_t frees;
 };
 
+/* NOTE: For the shared allocator, the figures are only approximate while
+   other threads are using it */
 void
 tiz_soa_info (tiz_soa_t * p_soa, tiz_soa_info_t * p_info);
 
@@ -39,6 +39,7 @@
 #include <unistd.h>
 #include <sys/syscall.h>
 #include <pthread.h>
+#include <time.h>
 #include <assert.h>
 
 #ifdef TIZ_LOG_CATEGORY_NAME
@@ -212,3 +213,11 @@ tiz_sleep (OMX_U32 usec)
 
   return rc;
 }
+
+OMX_U64
+tiz_monotonic_ns (void)
+{
+  struct timespec ts;
+  (void) clock_gettime (CLOCK_MONOTONIC, &ts);
+  return (OMX_U64) ts.tv_sec * 1000000000ULL + (OMX_U64) ts.tv_nsec;
+}
@@ -114,6 +114,17 @@ tiz_thread_id (void);
 OMX_S32
 tiz_sleep (OMX_U32 a_usec);
 
+/**
+ * Read the monotonic clock. Cheap enough to be used for always-on
+ * measurements (no system call on most platforms).
+ *
+ * @ingroup tizthread
+ *
+ * @return The current value of CLOCK_MONOTONIC, in nanoseconds.
+ */
+OMX_U64
+tiz_monotonic_ns (void);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,469 @@
+/**
+ * Copyright (C) 2011-2020 Aratelia Limited - Juan A. Rubio and contributors
+ *
+ * This file is part of Tizonia
+ *
+ * Tizonia is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Tizonia is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Tizonia.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file   tiztracer.c
+ * @author Juan A. Rubio <juan.rubio@aratelia.com>
+ *
+ * @brief  Event tracer with Chrome trace export
+ *
+ * Each thread owns one ring, which it finds through a thread-local pointer.
+ * Only the owner writes to a ring: it fills in the slot and then publishes it
+ * by advancing 'head' with release semantics, so a reader that loads 'head'
+ * with acquire semantics sees complete events. The rings are linked in a
+ * global list (the only place where a lock is taken, once per thread). When
+ * a thread exits, its ring stays in the list, so that its events can still
+ * be dumped, and is also put on a free list. Once TRACER_MAX_RINGS rings
+ * exist, a new thread takes over a ring from the free list instead of
+ * allocating another one, so memory use does not grow with thread churn.
+ *
+ */
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <assert.h>
+#include <inttypes.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "tizplatform.h"
+
+#ifdef TIZ_LOG_CATEGORY_NAME
+#undef TIZ_LOG_CATEGORY_NAME
+#define TIZ_LOG_CATEGORY_NAME "tiz.platform.tracer"
+#endif
+
+#define TRACER_THREAD_NAME_LEN 16
+#define TRACER_CAT_LEN 11
+#define TRACER_NAME_LEN 40
+#define TRACER_MAX_RINGS 32
+
+/* The names are copied: most of them live in component plugins and their
+   libraries, which are usually unloaded by the time the trace is dumped */
+typedef struct tiz_tracer_event tiz_tracer_event_t;
+struct tiz_tracer_event
+{
+  OMX_U64 ts_ns;
+  OMX_U64 dur_ns;
+  uintptr_t id;
+  OMX_U32 arg;
+  char phase;
+  char cat[TRACER_CAT_LEN];
+  char name[TRACER_NAME_LEN];
+};
+
+typedef struct tiz_tracer_ring tiz_tracer_ring_t;
+struct tiz_tracer_ring
+{
+  tiz_tracer_ring_t * p_next;
+  tiz_tracer_ring_t * p_next_free;
+  OMX_S32 tid;
+  char name[TRACER_THREAD_NAME_LEN];
+  OMX_U64 head;                 /* written by the owner thread only */
+  OMX_U64 base;                 /* value of 'head' at tiz_tracer_start */
+  OMX_U32 mask;
+  tiz_tracer_event_t events[];
+};
+
+static int g_tracer_enabled = 0;
+static OMX_U32 g_tracer_capacity = TIZ_TRACER_DEFAULT_CAPACITY;
+static tiz_tracer_ring_t * gp_tracer_rings = NULL;
+static tiz_tracer_ring_t * gp_tracer_free_rings = NULL;
+static OMX_U32 g_tracer_nrings = 0;
+static pthread_mutex_t g_tracer_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_once_t g_tracer_key_once = PTHREAD_ONCE_INIT;
+static pthread_key_t g_tracer_key;
+static __thread tiz_tracer_ring_t * tp_tracer_ring = NULL;
+
+static OMX_U32
+tracer_capacity_for (OMX_U32 a_nevents)
+{
+  OMX_U32 capacity = 2;
+  while (capacity < a_nevents && capacity < (1U << 30))
+    {
+      capacity <<= 1;
+    }
+  return capacity;
+}
+
+static void
+tracer_release_ring (void * ap_ring)
+{
+  tiz_tracer_ring_t * p_ring = ap_ring;
+  /* The thread is exiting; its events stay in the global list until a new
+     thread takes the ring over */
+  tp_tracer_ring = NULL;
+  (void) pthread_mutex_lock (&g_tracer_mutex);
+  p_ring->p_next_free = gp_tracer_free_rings;
+  gp_tracer_free_rings = p_ring;
+  (void) pthread_mutex_unlock (&g_tracer_mutex);
+}
+
+static void
+tracer_create_key (void)
+{
+  (void) pthread_key_create (&g_tracer_key, tracer_release_ring);
+}
+
+static void
+tracer_unlink_ring (tiz_tracer_ring_t * ap_ring)
+{
+  tiz_tracer_ring_t ** pp_ring = &gp_tracer_rings;
+  /* Called with g_tracer_mutex held */
+  while (*pp_ring && *pp_ring != ap_ring)
+    {
+      pp_ring = &((*pp_ring)->p_next);
+    }
+  if (*pp_ring)
+    {
+      *pp_ring = ap_ring->p_next;
+      g_tracer_nrings--;
+    }
+}
+
+static tiz_tracer_ring_t *
+tracer_reuse_ring (const OMX_U32 a_capacity)
+{
+  tiz_tracer_ring_t ** pp_ring = &gp_tracer_free_rings;
+  tiz_tracer_ring_t ** pp_oldest = NULL;
+  tiz_tracer_ring_t * p_ring = NULL;
+
+  /* Called with g_tracer_mutex held. Exiting threads push their rings at the
+     head of the free list, so the last one belongs to the thread that exited
+     first. Rings of another capacity (i.e. from before a tiz_tracer_start
+     with a new one) are freed; the dump takes the same lock, so nobody is
+     reading them. */
+  while ((p_ring = *pp_ring))
+    {
+      if (p_ring->mask != a_capacity - 1)
+        {
+          *pp_ring = p_ring->p_next_free;
+          tracer_unlink_ring (p_ring);
+          tiz_mem_free (p_ring);
+        }
+      else
+        {
+          pp_oldest = pp_ring;
+          pp_ring = &(p_ring->p_next_free);
+        }
+    }
+
+  if (pp_oldest)
+    {
+      p_ring = *pp_oldest;
+      *pp_oldest = p_ring->p_next_free;
+      p_ring->p_next_free = NULL;
+    }
+  return p_ring;
+}
+
+static tiz_tracer_ring_t *
+tracer_thread_ring (void)
+{
+  if (!tp_tracer_ring)
+    {
+      const OMX_U32 capacity
+        = __atomic_load_n (&g_tracer_capacity, __ATOMIC_RELAXED);
+      tiz_tracer_ring_t * p_ring = NULL;
+
+      (void) pthread_once (&g_tracer_key_once, tracer_create_key);
+
+      (void) pthread_mutex_lock (&g_tracer_mutex);
+      if (g_tracer_nrings >= TRACER_MAX_RINGS)
+        {
+          p_ring = tracer_reuse_ring (capacity);
+        }
+      if (!p_ring
+          && (p_ring = tiz_mem_calloc (1, sizeof (tiz_tracer_ring_t)
+                                            + capacity
+                                                * sizeof (tiz_tracer_event_t))))
+        {
+          p_ring->mask = capacity - 1;
+          p_ring->p_next = gp_tracer_rings;
+          gp_tracer_rings = p_ring;
+          g_tracer_nrings++;
+        }
+      if (p_ring)
+        {
+          /* A ring taken over from an exited thread drops that thread's
+             events */
+          p_ring->tid = tiz_thread_id ();
+          p_ring->name[0] = '\0';
+          (void) pthread_getname_np (pthread_self (), p_ring->name,
+                                     sizeof (p_ring->name));
+          __atomic_store_n (&(p_ring->base), p_ring->head, __ATOMIC_RELAXED);
+        }
+      (void) pthread_mutex_unlock (&g_tracer_mutex);
+
+      if (p_ring)
+        {
+          (void) pthread_setspecific (g_tracer_key, p_ring);
+          tp_tracer_ring = p_ring;
+        }
+    }
+  return tp_tracer_ring;
+}
+
+static inline void
+tracer_copy_name (char * ap_dst, const char * ap_src, const size_t a_len)
+{
+  size_t i = 0;
+  for (i = 0; i < a_len - 1 && ap_src[i]; ++i)
+    {
+      ap_dst[i] = ap_src[i];
+    }
+  ap_dst[i] = '\0';
+}
+
+static inline void
+tracer_record (const char a_phase, const char * ap_cat, const char * ap_name,
+               const OMX_U64 a_ts_ns, const OMX_U64 a_dur_ns,
+               const uintptr_t a_id, const OMX_U32 a_arg)
+{
+  tiz_tracer_ring_t * p_ring = tracer_thread_ring ();
+  if (p_ring)
+    {
+      const OMX_U64 head = p_ring->head;
+      tiz_tracer_event_t * p_ev = &(p_ring->events[head & p_ring->mask]);
+      p_ev->ts_ns = a_ts_ns;
+      p_ev->dur_ns = a_dur_ns;
+      tracer_copy_name (p_ev->cat, ap_cat, TRACER_CAT_LEN);
+      tracer_copy_name (p_ev->name, ap_name, TRACER_NAME_LEN);
+      p_ev->id = a_id;
+      p_ev->arg = a_arg;
+      p_ev->phase = a_phase;
+      __atomic_store_n (&(p_ring->head), head + 1, __ATOMIC_RELEASE);
+    }
+}
+
+static void
+tracer_write_name (FILE * ap_file, const char * ap_name)
+{
+  /* Names are arbitrary; keep the JSON well-formed */
+  for (; *ap_name; ++ap_name)
+    {
+      const char c = *ap_name;
+      fputc ((c == '"' || c == '\\' || (unsigned char) c < 0x20) ? '_' : c,
+             ap_file);
+    }
+}
+
+static void
+tracer_write_ts (FILE * ap_file, const char * ap_key, const OMX_U64 a_ns)
+{
+  /* Chrome trace timestamps are in microseconds */
+  fprintf (ap_file, ",\"%s\":%llu.%03u", ap_key,
+           (unsigned long long) (a_ns / 1000), (unsigned int) (a_ns % 1000));
+}
+
+static OMX_U64
+tracer_write_ring (FILE * ap_file, const tiz_tracer_ring_t * ap_ring,
+                   const int a_pid, bool * ap_first)
+{
+  const OMX_U64 head = __atomic_load_n (&(ap_ring->head), __ATOMIC_ACQUIRE);
+  const OMX_U64 capacity = (OMX_U64) ap_ring->mask + 1;
+  OMX_U64 start = __atomic_load_n (&(ap_ring->base), __ATOMIC_RELAXED);
+  OMX_U64 i = 0;
+
+  if (head - start > capacity)
+    {
+      start = head - capacity;
+    }
+
+  if (start == head)
+    {
+      return 0;
+    }
+
+  fprintf (ap_file,
+           "%s\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%d,"
+           "\"tid\":%d,\"args\":{\"name\":\"",
+           *ap_first ? "" : ",", a_pid, (int) ap_ring->tid);
+  tracer_write_name (ap_file, ap_ring->name[0] ? ap_ring->name : "thread");
+  fputs ("\"}}", ap_file);
+  *ap_first = false;
+
+  for (i = start; i < head; ++i)
+    {
+      const tiz_tracer_event_t * p_ev = &(ap_ring->events[i & ap_ring->mask]);
+      fputs (",\n{\"name\":\"", ap_file);
+      tracer_write_name (ap_file, p_ev->name);
+      fputs ("\",\"cat\":\"", ap_file);
+      tracer_write_name (ap_file, p_ev->cat);
+      fprintf (ap_file, "\",\"ph\":\"%c\"", p_ev->phase);
+      tracer_write_ts (ap_file, "ts", p_ev->ts_ns);
+      switch (p_ev->phase)
+        {
+          case 'X':
+            {
+              tracer_write_ts (ap_file, "dur", p_ev->dur_ns);
+            }
+            break;
+          case 'i':
+            {
+              fputs (",\"s\":\"t\"", ap_file);
+            }
+            break;
+          case 's':
+          case 'f':
+            {
+              fprintf (ap_file, ",\"id\":\"0x%" PRIxPTR "\"%s", p_ev->id,
+                       p_ev->phase == 'f' ? ",\"bp\":\"e\"" : "");
+            }
+            break;
+          default:
+            break;
+        };
+      fprintf (ap_file,
+               ",\"pid\":%d,\"tid\":%d,\"args\":{\"id\":\"0x%" PRIxPTR
+               "\",\"arg\":%u}}",
+               a_pid, (int) ap_ring->tid, p_ev->id, (unsigned int) p_ev->arg);
+    }
+
+  return head - start;
+}
+
+OMX_ERRORTYPE
+tiz_tracer_start (OMX_U32 a_capacity)
+{
+  tiz_tracer_ring_t * p_ring = NULL;
+
+  __atomic_store_n (
+    &g_tracer_capacity,
+    tracer_capacity_for (a_capacity > 0 ? a_capacity
+                                        : TIZ_TRACER_DEFAULT_CAPACITY),
+    __ATOMIC_RELAXED);
+
+  /* Forget the previous recording; 'head' belongs to the owner threads, so
+     only the starting point moves */
+  (void) pthread_mutex_lock (&g_tracer_mutex);
+  for (p_ring = gp_tracer_rings; p_ring; p_ring = p_ring->p_next)
+    {
+      __atomic_store_n (&(p_ring->base),
+                        __atomic_load_n (&(p_ring->head), __ATOMIC_ACQUIRE),
+                        __ATOMIC_RELAXED);
+    }
+  (void) pthread_mutex_unlock (&g_tracer_mutex);
+
+  __atomic_store_n (&g_tracer_enabled, 1, __ATOMIC_RELEASE);
+  TIZ_LOG (TIZ_PRIORITY_NOTICE, "Tracer started [%u events per thread]",
+           (unsigned int) g_tracer_capacity);
+  return OMX_ErrorNone;
+}
+
+void
+tiz_tracer_stop (void)
+{
+  __atomic_store_n (&g_tracer_enabled, 0, __ATOMIC_RELEASE);
+}
+
+bool
+tiz_tracer_enabled (void)
+{
+  return __atomic_load_n (&g_tracer_enabled, __ATOMIC_RELAXED);
+}
+
+void
+tiz_tracer_instant (const char * ap_cat, const char * ap_name, uintptr_t a_id,
+                    OMX_U32 a_arg)
+{
+  if (tiz_tracer_enabled ())
+    {
+      tracer_record ('i', ap_cat, ap_name, tiz_monotonic_ns (), 0, a_id,
+                     a_arg);
+    }
+}
+
+void
+tiz_tracer_complete (const char * ap_cat, const char * ap_name,
+                     OMX_U64 a_start_ns, uintptr_t a_id, OMX_U32 a_arg)
+{
+  if (tiz_tracer_enabled ())
+    {
+      const OMX_U64 now = tiz_monotonic_ns ();
+      tracer_record ('X', ap_cat, ap_name, a_start_ns,
+                     now > a_start_ns ? now - a_start_ns : 0, a_id, a_arg);
+    }
+}
+
+void
+tiz_tracer_flow_begin (const char * ap_cat, const char * ap_name,
+                       uintptr_t a_id)
+{
+  if (tiz_tracer_enabled ())
+    {
+      tracer_record ('s', ap_cat, ap_name, tiz_monotonic_ns (), 0, a_id, 0);
+    }
+}
+
+void
+tiz_tracer_flow_end (const char * ap_cat, const char * ap_name,
+                     uintptr_t a_id)
+{
+  if (tiz_tracer_enabled ())
+    {
+      tracer_record ('f', ap_cat, ap_name, tiz_monotonic_ns (), 0, a_id, 0);
+    }
+}
+
+OMX_ERRORTYPE
+tiz_tracer_dump (const char * ap_path, OMX_U64 * ap_nevents)
+{
+  tiz_tracer_ring_t * p_ring = NULL;
+  FILE * p_file = NULL;
+  OMX_U64 nevents = 0;
+  bool first = true;
+  const int pid = getpid ();
+
+  assert (ap_path);
+
+  if (!(p_file = fopen (ap_path, "w")))
+    {
+      TIZ_LOG (TIZ_PRIORITY_ERROR, "Unable to open trace file [%s]", ap_path);
+      return OMX_ErrorInsufficientResources;
+    }
+
+  fputs ("{\"displayTimeUnit\":\"ns\",\"traceEvents\":[", p_file);
+  (void) pthread_mutex_lock (&g_tracer_mutex);
+  for (p_ring = gp_tracer_rings; p_ring; p_ring = p_ring->p_next)
+    {
+      nevents += tracer_write_ring (p_file, p_ring, pid, &first);
+    }
+  (void) pthread_mutex_unlock (&g_tracer_mutex);
+  fputs ("\n]}\n", p_file);
+
+  if (0 != fclose (p_file))
+    {
+      TIZ_LOG (TIZ_PRIORITY_ERROR, "Unable to write trace file [%s]", ap_path);
+      return OMX_ErrorInsufficientResources;
+    }
+
+  TIZ_LOG (TIZ_PRIORITY_NOTICE, "Wrote [%llu] trace events to [%s]",
+           (unsigned long long) nevents, ap_path);
+
+  if (ap_nevents)
+    {
+      *ap_nevents = nevents;
+    }
+  return OMX_ErrorNone;
+}
@@ -0,0 +1,175 @@
+/**
+ * Copyright (C) 2011-2020 Aratelia Limited - Juan A. Rubio and contributors
+ *
+ * This file is part of Tizonia
+ *
+ * Tizonia is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Tizonia is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Tizonia.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file   tiztracer.h
+ * @author Juan A. Rubio <juan.rubio@aratelia.com>
+ *
+ * @brief  Event tracer with Chrome trace export
+ *
+ *
+ */
+
+#ifndef TIZTRACER_H
+#define TIZTRACER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup tiztracer Event tracer
+ *
+ * An opt-in recorder of timestamped events. Every thread that records an
+ * event gets its own fixed-size ring, so recording takes no locks and does
+ * not allocate (except for the thread's very first event). When a ring is
+ * full, the oldest events are overwritten. The ring of a thread that has
+ * exited is kept, with its events. Once there are 32 rings, new threads take
+ * over the rings of exited threads, whose events are then discarded.
+ *
+ * The recording can be written out in the Chrome trace event JSON format,
+ * which both chrome://tracing and the Perfetto UI (ui.perfetto.dev) open.
+ *
+ * Category and event names are copied into the event (and truncated to 10
+ * and 39 characters respectively), so they may live in libraries that are
+ * unloaded before the recording is dumped.
+ *
+ * @ingroup libtizplatform
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <OMX_Core.h>
+#include <OMX_Types.h>
+
+/**
+ * The number of events per thread used when tiz_tracer_start is given zero.
+ * @ingroup tiztracer
+ */
+#define TIZ_TRACER_DEFAULT_CAPACITY 65536
+
+/**
+ * Start (or restart) recording. Events recorded before this call are
+ * discarded.
+ *
+ * @ingroup tiztracer
+ *
+ * @param a_capacity The number of events kept per thread, rounded up to a
+ * power of two (zero means TIZ_TRACER_DEFAULT_CAPACITY). Threads that already
+ * have a ring keep its original capacity.
+ *
+ * @return OMX_ErrorNone.
+ */
+OMX_ERRORTYPE
+tiz_tracer_start (OMX_U32 a_capacity);
+
+/**
+ * Stop recording. The events recorded so far are kept, and can be dumped.
+ *
+ * @ingroup tiztracer
+ *
+ */
+void
+tiz_tracer_stop (void);
+
+/**
+ * @ingroup tiztracer
+ * @return true if events are being recorded.
+ */
+bool
+tiz_tracer_enabled (void);
+
+/**
+ * Record an instant event. Nothing is recorded if the tracer is not enabled.
+ *
+ * @ingroup tiztracer
+ *
+ * @param a_id An object associated to the event (e.g. a buffer header).
+ *
+ * @param a_arg An integer argument (e.g. a port index).
+ */
+void
+tiz_tracer_instant (const char * ap_cat, const char * ap_name, uintptr_t a_id,
+                    OMX_U32 a_arg);
+
+/**
+ * Record an event with a duration, from a_start_ns until now. Nothing is
+ * recorded if the tracer is not enabled.
+ *
+ * @ingroup tiztracer
+ *
+ * @param a_start_ns The start of the event, as returned by tiz_monotonic_ns.
+ *
+ * @param a_id An object associated to the event (e.g. a component handle).
+ *
+ * @param a_arg An integer argument.
+ */
+void
+tiz_tracer_complete (const char * ap_cat, const char * ap_name,
+                     OMX_U64 a_start_ns, uintptr_t a_id, OMX_U32 a_arg);
+
+/**
+ * Record the start of a flow, i.e. an object (e.g. a buffer header) that
+ * leaves the current thread. The viewer draws an arrow from the event that
+ * encloses this one to the event enclosing the matching
+ * tiz_tracer_flow_end.
+ *
+ * @ingroup tiztracer
+ *
+ * @param a_id The object that flows; it identifies the flow.
+ */
+void
+tiz_tracer_flow_begin (const char * ap_cat, const char * ap_name,
+                       uintptr_t a_id);
+
+/**
+ * Record the end of a flow started with tiz_tracer_flow_begin.
+ *
+ * @ingroup tiztracer
+ *
+ * @param a_id The object that flows; it identifies the flow.
+ */
+void
+tiz_tracer_flow_end (const char * ap_cat, const char * ap_name,
+                     uintptr_t a_id);
+
+/**
+ * Write the events recorded since the last tiz_tracer_start as a Chrome
+ * trace event JSON file. This is best called once recording has been
+ * stopped; events that are recorded while the dump is in progress may or may
+ * not be included.
+ *
+ * @ingroup tiztracer
+ *
+ * @param ap_path The file to (over)write.
+ *
+ * @param ap_nevents Receives the number of events written (may be NULL).
+ *
+ * @return OMX_ErrorNone if success, OMX_ErrorInsufficientResources if the
+ * file could not be written.
+ */
+OMX_ERRORTYPE
+tiz_tracer_dump (const char * ap_path, OMX_U64 * ap_nevents);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TIZTRACER_H */
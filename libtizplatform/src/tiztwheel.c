@@ -0,0 +1,513 @@
+/**
+ * Copyright (C) 2011-2020 Aratelia Limited - Juan A. Rubio and contributors
+ *
+ * This file is part of Tizonia
+ *
+ * Tizonia is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Tizonia is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Tizonia.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file   tiztwheel.c
+ * @author Juan A. Rubio <juan.rubio@aratelia.com>
+ *
+ * @brief  Hierarchical timer wheel
+ *
+ * The wheel has TWHEEL_LEVELS levels of TWHEEL_SLOTS slots. A timer that is
+ * due in 'd' ticks, with 64^l <= d < 64^(l+1), goes to level 'l', in the slot
+ * given by bits [6l, 6l+6) of its expiry tick. When the wheel's time reaches
+ * the start of a level 'l' slot, the slot is 'cascaded': its timers are
+ * re-inserted, which moves them to lower levels, until they reach level 0,
+ * where each slot holds the timers of exactly one tick. Timers further away
+ * than the whole wheel are parked in the top level and re-inserted when
+ * their slot comes round.
+ *
+ * A bitmap per level tracks the occupied slots, so that advancing the wheel
+ * jumps straight to the next tick where there is something to do.
+ *
+ */
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <assert.h>
+#include <stdint.h>
+
+#include "tizplatform.h"
+
+#ifdef TIZ_LOG_CATEGORY_NAME
+#undef TIZ_LOG_CATEGORY_NAME
+#define TIZ_LOG_CATEGORY_NAME "tiz.platform.twheel"
+#endif
+
+#define TWHEEL_BITS 6
+#define TWHEEL_SLOTS (1 << TWHEEL_BITS)
+#define TWHEEL_MASK (TWHEEL_SLOTS - 1)
+#define TWHEEL_LEVELS 5
+#define TWHEEL_RANGE ((OMX_U64) 1 << (TWHEEL_BITS * TWHEEL_LEVELS))
+/* Pseudo list indexes */
+#define TWHEEL_LIST_NONE -1
+#define TWHEEL_LIST_EXPIRED (TWHEEL_LEVELS * TWHEEL_SLOTS)
+
+typedef struct tiz_twheel_link tiz_twheel_link_t;
+struct tiz_twheel_link
+{
+  tiz_twheel_link_t * p_next;
+  tiz_twheel_link_t * p_prev;
+};
+
+struct tiz_twheel_timer
+{
+  tiz_twheel_link_t link; /* must be the first member */
+  tiz_twheel_t * p_wheel;
+  tiz_twheel_cb_f pf_cback;
+  void * p_arg;
+  OMX_U64 expiry; /* in ticks */
+  OMX_S32 list;   /* slot index, or one of the pseudo list indexes */
+};
+
+struct tiz_twheel
+{
+  OMX_U64 tick_ns;
+  OMX_U64 base_ns;
+  OMX_U64 now; /* in ticks */
+  OMX_U32 count;
+  uint64_t occupied[TWHEEL_LEVELS];
+  tiz_twheel_link_t slots[TWHEEL_LEVELS * TWHEEL_SLOTS];
+  tiz_twheel_link_t expired;
+};
+
+static inline void
+list_init (tiz_twheel_link_t * ap_head)
+{
+  ap_head->p_next = ap_head;
+  ap_head->p_prev = ap_head;
+}
+
+static inline bool
+list_empty (const tiz_twheel_link_t * ap_head)
+{
+  return ap_head->p_next == ap_head;
+}
+
+static inline void
+list_append (tiz_twheel_link_t * ap_head, tiz_twheel_link_t * ap_link)
+{
+  ap_link->p_prev = ap_head->p_prev;
+  ap_link->p_next = ap_head;
+  ap_head->p_prev->p_next = ap_link;
+  ap_head->p_prev = ap_link;
+}
+
+static inline void
+list_unlink (tiz_twheel_link_t * ap_link)
+{
+  ap_link->p_prev->p_next = ap_link->p_next;
+  ap_link->p_next->p_prev = ap_link->p_prev;
+  ap_link->p_next = ap_link;
+  ap_link->p_prev = ap_link;
+}
+
+/* Moves all the elements of ap_from to the (empty) list ap_to */
+static inline void
+list_move (tiz_twheel_link_t * ap_from, tiz_twheel_link_t * ap_to)
+{
+  assert (list_empty (ap_to));
+  if (!list_empty (ap_from))
+    {
+      ap_to->p_next = ap_from->p_next;
+      ap_to->p_prev = ap_from->p_prev;
+      ap_to->p_next->p_prev = ap_to;
+      ap_to->p_prev->p_next = ap_to;
+      list_init (ap_from);
+    }
+}
+
+static inline OMX_U64
+ns_to_ticks (const tiz_twheel_t * ap_wheel, const OMX_U64 a_ns,
+             const bool a_round_up)
+{
+  OMX_U64 ns = 0;
+  if (a_ns <= ap_wheel->base_ns)
+    {
+      return 0;
+    }
+  ns = a_ns - ap_wheel->base_ns;
+  return (ns / ap_wheel->tick_ns)
+         + ((a_round_up && (ns % ap_wheel->tick_ns)) ? 1 : 0);
+}
+
+static inline OMX_U64
+ticks_to_ns (const tiz_twheel_t * ap_wheel, const OMX_U64 a_ticks)
+{
+  return ap_wheel->base_ns + a_ticks * ap_wheel->tick_ns;
+}
+
+static inline int
+level_shift (const int a_level)
+{
+  return a_level * TWHEEL_BITS;
+}
+
+static void
+insert_timer (tiz_twheel_t * ap_wheel, tiz_twheel_timer_t * ap_timer)
+{
+  OMX_U64 delta = 0;
+  OMX_U64 pos = ap_timer->expiry;
+  int level = 0;
+  int slot = 0;
+
+  if (ap_timer->expiry <= ap_wheel->now)
+    {
+      ap_timer->list = TWHEEL_LIST_EXPIRED;
+      list_append (&(ap_wheel->expired), &(ap_timer->link));
+      return;
+    }
+
+  delta = ap_timer->expiry - ap_wheel->now;
+  if (delta >= TWHEEL_RANGE)
+    {
+      /* Park it in the top level; it is re-inserted when its slot cascades */
+      pos = ap_wheel->now + TWHEEL_RANGE - 1;
+      level = TWHEEL_LEVELS - 1;
+    }
+  else
+    {
+      level = (63 - __builtin_clzll (delta)) / TWHEEL_BITS;
+    }
+
+  slot = (pos >> level_shift (level)) & TWHEEL_MASK;
+  ap_timer->list = level * TWHEEL_SLOTS + slot;
+  list_append (&(ap_wheel->slots[ap_timer->list]), &(ap_timer->link));
+  ap_wheel->occupied[level] |= ((uint64_t) 1 << slot);
+}
+
+static void
+remove_timer (tiz_twheel_t * ap_wheel, tiz_twheel_timer_t * ap_timer)
+{
+  const OMX_S32 list = ap_timer->list;
+  assert (TWHEEL_LIST_NONE != list);
+
+  list_unlink (&(ap_timer->link));
+  ap_timer->list = TWHEEL_LIST_NONE;
+  if (TWHEEL_LIST_EXPIRED != list && list_empty (&(ap_wheel->slots[list])))
+    {
+      ap_wheel->occupied[list / TWHEEL_SLOTS]
+        &= ~((uint64_t) 1 << (list % TWHEEL_SLOTS));
+    }
+}
+
+/* The first occupied slot of a level that comes after the current time, or
+   -1 if the level is empty. *ap_tick receives the tick at which the slot is
+   reached. */
+static int
+next_slot (const tiz_twheel_t * ap_wheel, const int a_level, OMX_U64 * ap_tick)
+{
+  const uint64_t occupied = ap_wheel->occupied[a_level];
+  const OMX_U64 cur = ap_wheel->now >> level_shift (a_level);
+  const int first = (cur + 1) & TWHEEL_MASK;
+  uint64_t rotated = 0;
+  int k = 0;
+
+  if (!occupied)
+    {
+      return -1;
+    }
+
+  rotated = first
+              ? ((occupied >> first) | (occupied << (TWHEEL_SLOTS - first)))
+              : occupied;
+  k = __builtin_ctzll (rotated) + 1;
+  *ap_tick = (cur + k) << level_shift (a_level);
+  return (first + k - 1) & TWHEEL_MASK;
+}
+
+static void
+cascade (tiz_twheel_t * ap_wheel, const int a_level, const int a_slot)
+{
+  tiz_twheel_link_t pending;
+  list_init (&pending);
+  list_move (&(ap_wheel->slots[a_level * TWHEEL_SLOTS + a_slot]), &pending);
+  ap_wheel->occupied[a_level] &= ~((uint64_t) 1 << a_slot);
+  while (!list_empty (&pending))
+    {
+      tiz_twheel_timer_t * p_timer = (tiz_twheel_timer_t *) pending.p_next;
+      list_unlink (&(p_timer->link));
+      insert_timer (ap_wheel, p_timer);
+    }
+}
+
+OMX_ERRORTYPE
+tiz_twheel_init (tiz_twheel_t ** app_wheel, const OMX_U64 a_tick_ns,
+                 const OMX_U64 a_now_ns)
+{
+  tiz_twheel_t * p_wheel = NULL;
+  int i = 0;
+
+  assert (app_wheel);
+  assert (a_tick_ns > 0);
+
+  tiz_check_null_ret_oom (
+    (p_wheel = tiz_mem_calloc (1, sizeof (tiz_twheel_t))));
+
+  p_wheel->tick_ns = a_tick_ns;
+  p_wheel->base_ns = a_now_ns;
+  p_wheel->now = 0;
+  p_wheel->count = 0;
+  for (i = 0; i < TWHEEL_LEVELS * TWHEEL_SLOTS; ++i)
+    {
+      list_init (&(p_wheel->slots[i]));
+    }
+  list_init (&(p_wheel->expired));
+
+  *app_wheel = p_wheel;
+  return OMX_ErrorNone;
+}
+
+void
+tiz_twheel_destroy (tiz_twheel_t * ap_wheel)
+{
+  if (ap_wheel)
+    {
+      int i = 0;
+      for (i = 0; i <= TWHEEL_LIST_EXPIRED; ++i)
+        {
+          tiz_twheel_link_t * p_head = (TWHEEL_LIST_EXPIRED == i)
+                                         ? &(ap_wheel->expired)
+                                         : &(ap_wheel->slots[i]);
+          while (!list_empty (p_head))
+            {
+              tiz_twheel_timer_t * p_timer
+                = (tiz_twheel_timer_t *) p_head->p_next;
+              list_unlink (&(p_timer->link));
+              p_timer->list = TWHEEL_LIST_NONE;
+            }
+        }
+      tiz_mem_free (ap_wheel);
+    }
+}
+
+OMX_ERRORTYPE
+tiz_twheel_timer_init (tiz_twheel_t * ap_wheel,
+                       tiz_twheel_timer_t ** app_timer,
+                       tiz_twheel_cb_f apf_cback, void * ap_arg)
+{
+  tiz_twheel_timer_t * p_timer = NULL;
+
+  assert (ap_wheel);
+  assert (app_timer);
+  assert (apf_cback);
+
+  tiz_check_null_ret_oom (
+    (p_timer = tiz_mem_calloc (1, sizeof (tiz_twheel_timer_t))));
+
+  list_init (&(p_timer->link));
+  p_timer->p_wheel = ap_wheel;
+  p_timer->pf_cback = apf_cback;
+  p_timer->p_arg = ap_arg;
+  p_timer->list = TWHEEL_LIST_NONE;
+
+  *app_timer = p_timer;
+  return OMX_ErrorNone;
+}
+
+void
+tiz_twheel_timer_destroy (tiz_twheel_timer_t * ap_timer)
+{
+  if (ap_timer)
+    {
+      tiz_twheel_timer_stop (ap_timer);
+      tiz_mem_free (ap_timer);
+    }
+}
+
+OMX_U64
+tiz_twheel_timer_start (tiz_twheel_timer_t * ap_timer,
+                        const OMX_U64 a_expiry_ns, const OMX_U64 a_slack_ns)
+{
+  tiz_twheel_t * p_wheel = NULL;
+  OMX_U64 expiry = 0;
+  OMX_U64 slack = 0;
+
+  assert (ap_timer);
+  p_wheel = ap_timer->p_wheel;
+  assert (p_wheel);
+
+  tiz_twheel_timer_stop (ap_timer);
+
+  expiry = ns_to_ticks (p_wheel, a_expiry_ns, true);
+  slack = a_slack_ns / p_wheel->tick_ns;
+  if (slack > 1)
+    {
+      /* Round up to a multiple of the largest power of two that fits in the
+         slack: timers due at about the same time end up on the same tick */
+      const OMX_U64 granularity
+        = (OMX_U64) 1 << (63 - __builtin_clzll (slack));
+      expiry = (expiry + granularity - 1) & ~(granularity - 1);
+    }
+  if (expiry <= p_wheel->now)
+    {
+      expiry = p_wheel->now + 1;
+    }
+
+  ap_timer->expiry = expiry;
+  insert_timer (p_wheel, ap_timer);
+  p_wheel->count++;
+
+  return ticks_to_ns (p_wheel, expiry);
+}
+
+void
+tiz_twheel_timer_stop (tiz_twheel_timer_t * ap_timer)
+{
+  assert (ap_timer);
+  if (TWHEEL_LIST_NONE != ap_timer->list)
+    {
+      remove_timer (ap_timer->p_wheel, ap_timer);
+      assert (ap_timer->p_wheel->count > 0);
+      ap_timer->p_wheel->count--;
+    }
+}
+
+bool
+tiz_twheel_timer_is_active (const tiz_twheel_timer_t * ap_timer)
+{
+  assert (ap_timer);
+  return TWHEEL_LIST_NONE != ap_timer->list;
+}
+
+OMX_U32
+tiz_twheel_advance (tiz_twheel_t * ap_wheel, const OMX_U64 a_now_ns)
+{
+  OMX_U64 target = 0;
+  OMX_U32 nexpired = 0;
+
+  assert (ap_wheel);
+
+  target = ns_to_ticks (ap_wheel, a_now_ns, false);
+  while (target > ap_wheel->now)
+    {
+      OMX_U64 next = UINT64_MAX;
+      int level = 0;
+
+      for (level = 0; level < TWHEEL_LEVELS; ++level)
+        {
+          OMX_U64 tick = 0;
+          if (next_slot (ap_wheel, level, &tick) >= 0 && tick < next)
+            {
+              next = tick;
+            }
+        }
+
+      if (next > target)
+        {
+          ap_wheel->now = target;
+          break;
+        }
+
+      ap_wheel->now = next;
+
+      /* Higher levels first, so that their timers trickle down */
+      for (level = TWHEEL_LEVELS - 1; level > 0; --level)
+        {
+          const OMX_U64 mask = ((OMX_U64) 1 << level_shift (level)) - 1;
+          if (0 == (next & mask))
+            {
+              cascade (ap_wheel, level, (next >> level_shift (level))
+                                          & TWHEEL_MASK);
+            }
+        }
+      cascade (ap_wheel, 0, next & TWHEEL_MASK);
+    }
+
+  /* The callbacks are free to use the wheel */
+  while (!list_empty (&(ap_wheel->expired)))
+    {
+      tiz_twheel_timer_t * p_timer
+        = (tiz_twheel_timer_t *) ap_wheel->expired.p_next;
+      remove_timer (ap_wheel, p_timer);
+      ap_wheel->count--;
+      nexpired++;
+      p_timer->pf_cback (p_timer->p_arg, p_timer);
+    }
+
+  return nexpired;
+}
+
+bool
+tiz_twheel_next_expiry (const tiz_twheel_t * ap_wheel, OMX_U64 * ap_expiry_ns)
+{
+  OMX_U64 best = UINT64_MAX;
+  int level = 0;
+
+  assert (ap_wheel);
+  assert (ap_expiry_ns);
+
+  if (0 == ap_wheel->count)
+    {
+      return false;
+    }
+
+  if (!list_empty (&(ap_wheel->expired)))
+    {
+      best = ap_wheel->now;
+    }
+
+  for (level = 0; level < TWHEEL_LEVELS && best > ap_wheel->now; ++level)
+    {
+      OMX_U64 tick = 0;
+      const int slot = next_slot (ap_wheel, level, &tick);
+      if (slot >= 0 && tick < best)
+        {
+          /* The first occupied slot holds the earliest timers of the level,
+             but a level 0 slot is the only one where they all expire on the
+             slot's tick */
+          if (0 == level)
+            {
+              best = tick;
+            }
+          else
+            {
+              const tiz_twheel_link_t * p_head
+                = &(ap_wheel->slots[level * TWHEEL_SLOTS + slot]);
+              const tiz_twheel_link_t * p_link = p_head->p_next;
+              const int shift = level_shift (level);
+              for (; p_link != p_head; p_link = p_link->p_next)
+                {
+                  const tiz_twheel_timer_t * p_timer
+                    = (const tiz_twheel_timer_t *) p_link;
+                  /* A parked timer needs a wakeup at the cascade */
+                  const OMX_U64 expiry
+                    = ((p_timer->expiry >> shift) == (tick >> shift))
+                        ? p_timer->expiry
+                        : tick;
+                  if (expiry < best)
+                    {
+                      best = expiry;
+                    }
+                }
+            }
+        }
+    }
+
+  *ap_expiry_ns = ticks_to_ns (ap_wheel, best);
+  return true;
+}
+
+OMX_U32
+tiz_twheel_count (const tiz_twheel_t * ap_wheel)
+{
+  assert (ap_wheel);
+  return ap_wheel->count;
+}
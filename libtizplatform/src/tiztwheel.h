@@ -0,0 +1,202 @@
+/**
+ * Copyright (C) 2011-2020 Aratelia Limited - Juan A. Rubio and contributors
+ *
+ * This file is part of Tizonia
+ *
+ * Tizonia is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Tizonia is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Tizonia.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file   tiztwheel.h
+ * @author Juan A. Rubio <juan.rubio@aratelia.com>
+ *
+ * @brief  Hierarchical timer wheel
+ *
+ *
+ */
+
+#ifndef TIZTWHEEL_H
+#define TIZTWHEEL_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup tiztwheel Hierarchical timer wheel
+ *
+ * A timer wheel for large numbers of timers that are started, stopped and
+ * restarted much more often than they expire. Starting and stopping a timer
+ * take constant time, whatever the number of timers in the wheel.
+ *
+ * Time is measured in nanoseconds, on any monotonic clock chosen by the
+ * caller (e.g. tiz_monotonic_ns), and is rounded up to the wheel's tick: a
+ * timer never expires early, and expires at most one tick late. On top of
+ * that, a timer may be given some slack: its expiry is then rounded up to a
+ * coarser boundary (no further than the slack), so that timers due at about
+ * the same time expire together and the caller wakes up less often.
+ *
+ * The wheel is not thread-safe; the caller must serialise all the calls that
+ * use the same wheel or its timers.
+ *
+ * @ingroup libtizplatform
+ */
+
+#include <stdbool.h>
+
+#include <OMX_Core.h>
+#include <OMX_Types.h>
+
+/**
+ * Timer wheel opaque structure
+ * @ingroup tiztwheel
+ */
+typedef struct tiz_twheel tiz_twheel_t;
+
+/**
+ * Timer opaque structure
+ * @ingroup tiztwheel
+ */
+typedef struct tiz_twheel_timer tiz_twheel_timer_t;
+
+/**
+ * Timer expiry callback. The timer is no longer active when this is called;
+ * the callback may start, stop or destroy any timer of the wheel, including
+ * this one.
+ * @ingroup tiztwheel
+ */
+typedef void (*tiz_twheel_cb_f) (void * ap_arg, tiz_twheel_timer_t * ap_timer);
+
+/**
+ * Create a timer wheel.
+ *
+ * @ingroup tiztwheel
+ *
+ * @param app_wheel Receives the new wheel.
+ *
+ * @param a_tick_ns The resolution of the wheel (must be non-zero).
+ *
+ * @param a_now_ns The current time.
+ *
+ * @return OMX_ErrorNone if success, OMX_ErrorInsufficientResources otherwise.
+ */
+OMX_ERRORTYPE
+tiz_twheel_init (tiz_twheel_t ** app_wheel, const OMX_U64 a_tick_ns,
+                 const OMX_U64 a_now_ns);
+
+/**
+ * Destroy a timer wheel. The timers that are still active are stopped, but
+ * not destroyed.
+ *
+ * @ingroup tiztwheel
+ */
+void
+tiz_twheel_destroy (tiz_twheel_t * ap_wheel);
+
+/**
+ * Create a timer. The timer is inactive until started.
+ *
+ * @ingroup tiztwheel
+ *
+ * @param apf_cback The function called when the timer expires.
+ *
+ * @param ap_arg The first argument of the callback.
+ *
+ * @return OMX_ErrorNone if success, OMX_ErrorInsufficientResources otherwise.
+ */
+OMX_ERRORTYPE
+tiz_twheel_timer_init (tiz_twheel_t * ap_wheel,
+                       tiz_twheel_timer_t ** app_timer,
+                       tiz_twheel_cb_f apf_cback, void * ap_arg);
+
+/**
+ * Destroy a timer (stopping it first if needed).
+ *
+ * @ingroup tiztwheel
+ */
+void
+tiz_twheel_timer_destroy (tiz_twheel_timer_t * ap_timer);
+
+/**
+ * Start (or restart) a timer.
+ *
+ * @ingroup tiztwheel
+ *
+ * @param a_expiry_ns The time at which the timer is due. A time that has
+ * already passed makes the timer expire on the next tick.
+ *
+ * @param a_slack_ns How late the timer may expire, on top of the rounding to
+ * the wheel's tick.
+ *
+ * @return The time at which the timer will actually expire.
+ */
+OMX_U64
+tiz_twheel_timer_start (tiz_twheel_timer_t * ap_timer,
+                        const OMX_U64 a_expiry_ns, const OMX_U64 a_slack_ns);
+
+/**
+ * Stop a timer. Stopping an inactive timer is harmless.
+ *
+ * @ingroup tiztwheel
+ */
+void
+tiz_twheel_timer_stop (tiz_twheel_timer_t * ap_timer);
+
+/**
+ * @ingroup tiztwheel
+ * @return true if the timer has been started and has not expired yet.
+ */
+bool
+tiz_twheel_timer_is_active (const tiz_twheel_timer_t * ap_timer);
+
+/**
+ * Advance the wheel's time, calling the callbacks of the timers that expire,
+ * in expiry order.
+ *
+ * @ingroup tiztwheel
+ *
+ * @param a_now_ns The current time. The wheel's time never goes backwards.
+ *
+ * @return The number of timers that expired.
+ */
+OMX_U32
+tiz_twheel_advance (tiz_twheel_t * ap_wheel, const OMX_U64 a_now_ns);
+
+/**
+ * Retrieve the time at which the next timer expires.
+ *
+ * @ingroup tiztwheel
+ *
+ * @param ap_expiry_ns Receives the time at which the earliest timer will
+ * expire (as returned by tiz_twheel_timer_start). Timers that were started
+ * beyond the range of the wheel (2^30 ticks) may make this earlier; the wheel
+ * then just has some internal work to do at that time.
+ *
+ * @return false if no timer is active.
+ */
+bool
+tiz_twheel_next_expiry (const tiz_twheel_t * ap_wheel, OMX_U64 * ap_expiry_ns);
+
+/**
+ * @ingroup tiztwheel
+ * @return The number of active timers.
+ */
+OMX_U32
+tiz_twheel_count (const tiz_twheel_t * ap_wheel);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TIZTWHEEL_H */
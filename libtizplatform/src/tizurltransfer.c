@@ -196,6 +196,7 @@ struct tiz_urltrans
   tiz_event_timer_t * p_ev_reconnect_timer_;
   bool awaiting_reconnect_timer_ev_;
   tiz_buffer_t * p_store_;
+  int store_capacity_initial_;
   int internal_buffer_size_;
   int internal_buffer_size_initial_;
   CURL * p_curl_;        /* curl easy */
@@ -946,6 +947,8 @@ allocate_temp_data_store (tiz_urltrans_t * ap_trans)
   assert (ap_trans->p_store_ == NULL);
   tiz_check_omx (
     tiz_buffer_init (&(ap_trans->p_store_), ap_trans->store_bytes_));
+  (void) tiz_buffer_seek_mode (ap_trans->p_store_, TIZ_BUFFER_RING);
+  ap_trans->store_capacity_initial_ = tiz_buffer_capacity (ap_trans->p_store_);
   return OMX_ErrorNone;
 }
 
@@ -1106,6 +1109,7 @@ tiz_urltrans_init (tiz_urltrans_ptr_t * app_trans, void * ap_parent,
           p_trans->p_ev_reconnect_timer_ = NULL;
           p_trans->awaiting_reconnect_timer_ev_ = false;
           p_trans->p_store_ = NULL;
+          p_trans->store_capacity_initial_ = 0;
           p_trans->internal_buffer_size_ = 0;
           p_trans->internal_buffer_size_initial_ = 0;
           p_trans->p_curl_ = NULL;
@@ -1263,6 +1267,12 @@ tiz_urltrans_flush_buffer (tiz_urltrans_t * ap_trans)
   if (ap_trans->p_store_)
     {
       tiz_buffer_clear (ap_trans->p_store_);
+      /* Give back what the store may have grown to */
+      if (tiz_buffer_capacity (ap_trans->p_store_)
+          > ap_trans->store_capacity_initial_)
+        {
+          (void) tiz_buffer_shrink_to_fit (ap_trans->p_store_);
+        }
     }
   URLTRANS_LOG_API_END (ap_trans);
 }
@@ -0,0 +1,543 @@
+/**
+ * Copyright (C) 2011-2020 Aratelia Limited - Juan A. Rubio and contributors
+ *
+ * This file is part of Tizonia
+ *
+ * Tizonia is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Tizonia is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Tizonia.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file   tizwpool.c
+ * @author Juan A. Rubio <juan.rubio@aratelia.com>
+ *
+ * @brief  Work-stealing thread pool
+ *
+ * Each worker owns a deque protected by its own mutex. The owner takes tasks
+ * from the front of its deque (oldest first, so that re-queued tasks are
+ * served fairly) and thieves take them from the back. The pool-wide mutex and
+ * condition variable are only used to put idle workers to sleep and to start
+ * and retire extra workers; the 'pending' and 'nidle' counters let the submit
+ * path skip them when every worker is busy.
+ *
+ * Only the highest-numbered extra worker may retire, so that the live workers
+ * are always pp_workers[0, nthreads). A retired worker's thread exits, but its
+ * structure stays in place (thieves may still be looking at it) and is reused
+ * by the next extra worker started in that slot.
+ *
+ */
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <assert.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "tizplatform.h"
+
+#ifdef TIZ_LOG_CATEGORY_NAME
+#undef TIZ_LOG_CATEGORY_NAME
+#define TIZ_LOG_CATEGORY_NAME "tiz.platform.wpool"
+#endif
+
+#define WPOOL_DEQUE_INITIAL_CAPACITY 16
+#define WPOOL_MAX_EXTRA_WORKERS 64
+#define WPOOL_THREAD_NAME_SIZE 16
+
+typedef struct tiz_wpool_entry tiz_wpool_entry_t;
+struct tiz_wpool_entry
+{
+  tiz_wpool_task_f pf_task;
+  OMX_PTR p_arg;
+};
+
+typedef struct tiz_wpool_worker tiz_wpool_worker_t;
+struct tiz_wpool_worker
+{
+  tiz_wpool_t * p_pool;
+  tiz_thread_t thread;
+  tiz_mutex_t mutex;
+  tiz_wpool_entry_t * p_ring;
+  size_t capacity;
+  size_t head;
+  size_t count;
+  OMX_U32 id;
+  OMX_BOOL joinable;
+};
+
+struct tiz_wpool
+{
+  tiz_mutex_t mutex;
+  tiz_cond_t cond;
+  tiz_wpool_worker_t ** pp_workers;
+  OMX_U32 max_threads;
+  OMX_U32 nworkers;
+  OMX_U32 nthreads;
+  OMX_U32 nslots;
+  OMX_U32 nblocked;
+  OMX_S32 nidle;
+  OMX_S32 pending;
+  OMX_U32 next;
+  OMX_BOOL stopping;
+  char name[WPOOL_THREAD_NAME_SIZE];
+};
+
+/* The worker that the calling thread is running, if any */
+static __thread tiz_wpool_worker_t * tls_worker = NULL;
+
+static OMX_ERRORTYPE
+deque_push (tiz_wpool_worker_t * ap_w, tiz_wpool_task_f apf_task,
+            OMX_PTR ap_arg)
+{
+  tiz_wpool_entry_t * p_entry = NULL;
+
+  assert (ap_w);
+
+  if (ap_w->count == ap_w->capacity)
+    {
+      const size_t new_capacity = ap_w->capacity * 2;
+      tiz_wpool_entry_t * p_ring
+        = tiz_mem_alloc (new_capacity * sizeof (tiz_wpool_entry_t));
+      size_t i = 0;
+      tiz_check_null_ret_oom (p_ring);
+      for (i = 0; i < ap_w->count; ++i)
+        {
+          p_ring[i] = ap_w->p_ring[(ap_w->head + i) % ap_w->capacity];
+        }
+      tiz_mem_free (ap_w->p_ring);
+      ap_w->p_ring = p_ring;
+      ap_w->capacity = new_capacity;
+      ap_w->head = 0;
+    }
+
+  p_entry = &(ap_w->p_ring[(ap_w->head + ap_w->count) % ap_w->capacity]);
+  p_entry->pf_task = apf_task;
+  p_entry->p_arg = ap_arg;
+  __atomic_store_n (&(ap_w->count), ap_w->count + 1, __ATOMIC_RELAXED);
+  return OMX_ErrorNone;
+}
+
+static OMX_BOOL
+deque_take (tiz_wpool_worker_t * ap_w, const OMX_BOOL a_front,
+            tiz_wpool_entry_t * ap_entry)
+{
+  OMX_BOOL taken = OMX_FALSE;
+
+  assert (ap_w);
+  assert (ap_entry);
+
+  /* Cheap check before taking the lock */
+  if (0 == __atomic_load_n (&(ap_w->count), __ATOMIC_RELAXED))
+    {
+      return OMX_FALSE;
+    }
+
+  (void) tiz_mutex_lock (&(ap_w->mutex));
+  if (ap_w->count > 0)
+    {
+      if (a_front)
+        {
+          *ap_entry = ap_w->p_ring[ap_w->head];
+          ap_w->head = (ap_w->head + 1) % ap_w->capacity;
+        }
+      else
+        {
+          *ap_entry
+            = ap_w->p_ring[(ap_w->head + ap_w->count - 1) % ap_w->capacity];
+        }
+      __atomic_store_n (&(ap_w->count), ap_w->count - 1, __ATOMIC_RELAXED);
+      taken = OMX_TRUE;
+    }
+  (void) tiz_mutex_unlock (&(ap_w->mutex));
+
+  return taken;
+}
+
+static OMX_BOOL
+find_task (tiz_wpool_worker_t * ap_w, tiz_wpool_entry_t * ap_entry)
+{
+  tiz_wpool_t * p_pool = NULL;
+  OMX_U32 nthreads = 0;
+  OMX_U32 i = 0;
+
+  assert (ap_w);
+  p_pool = ap_w->p_pool;
+
+  if (deque_take (ap_w, OMX_TRUE, ap_entry))
+    {
+      return OMX_TRUE;
+    }
+
+  /* Nothing left in our own deque; try to steal from the other workers */
+  nthreads = __atomic_load_n (&(p_pool->nthreads), __ATOMIC_ACQUIRE);
+  for (i = 1; i < nthreads; ++i)
+    {
+      tiz_wpool_worker_t * p_victim
+        = p_pool->pp_workers[(ap_w->id + i) % nthreads];
+      if (deque_take (p_victim, OMX_FALSE, ap_entry))
+        {
+          return OMX_TRUE;
+        }
+    }
+
+  return OMX_FALSE;
+}
+
+/* Must be called with the pool mutex held */
+static OMX_BOOL
+should_retire (const tiz_wpool_t * ap_pool, const tiz_wpool_worker_t * ap_w)
+{
+  assert (ap_pool);
+  assert (ap_w);
+  /* An extra worker is no longer needed once enough of the blocked workers
+     have resumed. Don't retire with tasks pending, as this worker may be the
+     one that tiz_wpool_submit has just woken up. */
+  return (ap_w->id >= ap_pool->nworkers && ap_w->id == ap_pool->nthreads - 1
+          && ap_pool->nthreads - ap_pool->nblocked > ap_pool->nworkers
+          && 0 == __atomic_load_n (&(ap_w->count), __ATOMIC_RELAXED)
+          && __atomic_load_n (&(ap_pool->pending), __ATOMIC_SEQ_CST) <= 0)
+           ? OMX_TRUE
+           : OMX_FALSE;
+}
+
+static void *
+worker_thread_func (void * ap_arg)
+{
+  tiz_wpool_worker_t * p_w = ap_arg;
+  tiz_wpool_t * p_pool = NULL;
+  tiz_wpool_entry_t entry;
+
+  assert (p_w);
+  p_pool = p_w->p_pool;
+  tls_worker = p_w;
+
+  for (;;)
+    {
+      if (find_task (p_w, &entry))
+        {
+          (void) __atomic_sub_fetch (&(p_pool->pending), 1, __ATOMIC_SEQ_CST);
+          entry.pf_task (entry.p_arg);
+          continue;
+        }
+
+      (void) tiz_mutex_lock (&(p_pool->mutex));
+      if (p_pool->stopping)
+        {
+          (void) tiz_mutex_unlock (&(p_pool->mutex));
+          break;
+        }
+      if (should_retire (p_pool, p_w))
+        {
+          TIZ_LOG (TIZ_PRIORITY_TRACE,
+                   "pool [%s] : retiring extra worker (threads [%lu] blocked "
+                   "[%lu])",
+                   p_pool->name, (unsigned long) p_pool->nthreads,
+                   (unsigned long) p_pool->nblocked);
+          __atomic_store_n (&(p_pool->nthreads), p_w->id, __ATOMIC_RELEASE);
+          (void) tiz_mutex_unlock (&(p_pool->mutex));
+          break;
+        }
+      /* Pairs with the 'nidle' check in tiz_wpool_submit */
+      (void) __atomic_add_fetch (&(p_pool->nidle), 1, __ATOMIC_SEQ_CST);
+      if (__atomic_load_n (&(p_pool->pending), __ATOMIC_SEQ_CST) <= 0)
+        {
+          (void) tiz_cond_wait (&(p_pool->cond), &(p_pool->mutex));
+        }
+      (void) __atomic_sub_fetch (&(p_pool->nidle), 1, __ATOMIC_SEQ_CST);
+      (void) tiz_mutex_unlock (&(p_pool->mutex));
+    }
+
+  tls_worker = NULL;
+  return NULL;
+}
+
+static void
+destroy_worker (tiz_wpool_worker_t * ap_w)
+{
+  if (ap_w)
+    {
+      (void) tiz_mutex_destroy (&(ap_w->mutex));
+      tiz_mem_free (ap_w->p_ring);
+      tiz_mem_free (ap_w);
+    }
+}
+
+/* Must be called with the pool mutex held */
+static OMX_ERRORTYPE
+start_worker (tiz_wpool_t * ap_pool)
+{
+  tiz_wpool_worker_t * p_w = NULL;
+  const OMX_U32 id = ap_pool->nthreads;
+
+  assert (ap_pool);
+  assert (id < ap_pool->max_threads);
+
+  if (id < ap_pool->nslots)
+    {
+      /* Reuse the slot of a retired worker; its thread is on its way out, if
+         not gone already */
+      p_w = ap_pool->pp_workers[id];
+      if (p_w->joinable)
+        {
+          OMX_PTR p_result = NULL;
+          (void) tiz_thread_join (&(p_w->thread), &p_result);
+          p_w->joinable = OMX_FALSE;
+        }
+      assert (0 == p_w->count);
+    }
+  else
+    {
+      tiz_check_null_ret_oom (
+        (p_w = tiz_mem_calloc (1, sizeof (tiz_wpool_worker_t))));
+      p_w->p_pool = ap_pool;
+      p_w->id = id;
+      p_w->capacity = WPOOL_DEQUE_INITIAL_CAPACITY;
+      if (!(p_w->p_ring
+            = tiz_mem_calloc (p_w->capacity, sizeof (tiz_wpool_entry_t)))
+          || OMX_ErrorNone != tiz_mutex_init (&(p_w->mutex)))
+        {
+          tiz_mem_free (p_w->p_ring);
+          tiz_mem_free (p_w);
+          return OMX_ErrorInsufficientResources;
+        }
+      ap_pool->pp_workers[id] = p_w;
+      ap_pool->nslots++;
+    }
+
+  /* Publish the worker before it starts, so that it can be stolen from */
+  __atomic_store_n (&(ap_pool->nthreads), id + 1, __ATOMIC_RELEASE);
+
+  if (OMX_ErrorNone
+      != tiz_thread_create (&(p_w->thread), 0, 0, worker_thread_func, p_w))
+    {
+      /* The slot is kept for later */
+      __atomic_store_n (&(ap_pool->nthreads), id, __ATOMIC_RELEASE);
+      return OMX_ErrorInsufficientResources;
+    }
+  p_w->joinable = OMX_TRUE;
+
+  (void) tiz_thread_setname (&(p_w->thread), ap_pool->name);
+
+  return OMX_ErrorNone;
+}
+
+OMX_ERRORTYPE
+tiz_wpool_init (tiz_wpool_ptr_t * app_pool, OMX_U32 a_nworkers,
+                const char * ap_name)
+{
+  tiz_wpool_t * p_pool = NULL;
+  OMX_ERRORTYPE rc = OMX_ErrorNone;
+  OMX_U32 i = 0;
+
+  assert (app_pool);
+
+  if (0 == a_nworkers)
+    {
+      const long ncpus = sysconf (_SC_NPROCESSORS_ONLN);
+      a_nworkers = ncpus > 0 ? (OMX_U32) ncpus : 1;
+    }
+
+  TIZ_LOG (TIZ_PRIORITY_TRACE, "pool [%s] workers [%lu]",
+           ap_name ? ap_name : "", (unsigned long) a_nworkers);
+
+  tiz_check_null_ret_oom ((p_pool = tiz_mem_calloc (1, sizeof (tiz_wpool_t))));
+
+  p_pool->nworkers = a_nworkers;
+  p_pool->max_threads = a_nworkers + WPOOL_MAX_EXTRA_WORKERS;
+  p_pool->stopping = OMX_FALSE;
+  (void) strncpy (p_pool->name, ap_name ? ap_name : "tizwpool",
+                  WPOOL_THREAD_NAME_SIZE - 1);
+
+  if (!(p_pool->pp_workers = tiz_mem_calloc (
+          p_pool->max_threads, sizeof (tiz_wpool_worker_t *))))
+    {
+      tiz_mem_free (p_pool);
+      return OMX_ErrorInsufficientResources;
+    }
+
+  if (OMX_ErrorNone != tiz_mutex_init (&(p_pool->mutex)))
+    {
+      tiz_mem_free (p_pool->pp_workers);
+      tiz_mem_free (p_pool);
+      return OMX_ErrorInsufficientResources;
+    }
+
+  if (OMX_ErrorNone != tiz_cond_init (&(p_pool->cond)))
+    {
+      (void) tiz_mutex_destroy (&(p_pool->mutex));
+      tiz_mem_free (p_pool->pp_workers);
+      tiz_mem_free (p_pool);
+      return OMX_ErrorInsufficientResources;
+    }
+
+  (void) tiz_mutex_lock (&(p_pool->mutex));
+  for (i = 0; i < a_nworkers && OMX_ErrorNone == rc; ++i)
+    {
+      rc = start_worker (p_pool);
+    }
+  (void) tiz_mutex_unlock (&(p_pool->mutex));
+
+  *app_pool = p_pool;
+
+  if (OMX_ErrorNone != rc)
+    {
+      tiz_wpool_destroy (p_pool);
+      *app_pool = NULL;
+    }
+
+  return rc;
+}
+
+void
+tiz_wpool_destroy (tiz_wpool_t * ap_pool)
+{
+  OMX_U32 i = 0;
+
+  if (!ap_pool)
+    {
+      return;
+    }
+
+  assert (!tls_worker || tls_worker->p_pool != ap_pool);
+
+  (void) tiz_mutex_lock (&(ap_pool->mutex));
+  ap_pool->stopping = OMX_TRUE;
+  (void) tiz_cond_broadcast (&(ap_pool->cond));
+  (void) tiz_mutex_unlock (&(ap_pool->mutex));
+
+  /* This includes the retired workers, that may not have been joined yet */
+  for (i = 0; i < ap_pool->nslots; ++i)
+    {
+      OMX_PTR p_result = NULL;
+      if (ap_pool->pp_workers[i]->joinable)
+        {
+          (void) tiz_thread_join (&(ap_pool->pp_workers[i]->thread),
+                                  &p_result);
+        }
+    }
+
+  for (i = 0; i < ap_pool->nslots; ++i)
+    {
+      destroy_worker (ap_pool->pp_workers[i]);
+    }
+
+  (void) tiz_cond_destroy (&(ap_pool->cond));
+  (void) tiz_mutex_destroy (&(ap_pool->mutex));
+  tiz_mem_free (ap_pool->pp_workers);
+  tiz_mem_free (ap_pool);
+}
+
+OMX_ERRORTYPE
+tiz_wpool_submit (tiz_wpool_t * ap_pool, tiz_wpool_task_f apf_task,
+                  OMX_PTR ap_arg)
+{
+  tiz_wpool_worker_t * p_w = tls_worker;
+  OMX_ERRORTYPE rc = OMX_ErrorNone;
+
+  assert (ap_pool);
+  assert (apf_task);
+
+  if (!p_w || p_w->p_pool != ap_pool)
+    {
+      /* Not one of our workers; spread the load over the regular workers */
+      const OMX_U32 next
+        = __atomic_fetch_add (&(ap_pool->next), 1, __ATOMIC_RELAXED);
+      p_w = ap_pool->pp_workers[next % ap_pool->nworkers];
+    }
+
+  (void) tiz_mutex_lock (&(p_w->mutex));
+  rc = deque_push (p_w, apf_task, ap_arg);
+  (void) tiz_mutex_unlock (&(p_w->mutex));
+  tiz_check_omx (rc);
+
+  /* Pairs with the 'pending' check in worker_thread_func */
+  (void) __atomic_add_fetch (&(ap_pool->pending), 1, __ATOMIC_SEQ_CST);
+  if (__atomic_load_n (&(ap_pool->nidle), __ATOMIC_SEQ_CST) > 0)
+    {
+      (void) tiz_mutex_lock (&(ap_pool->mutex));
+      (void) tiz_cond_signal (&(ap_pool->cond));
+      (void) tiz_mutex_unlock (&(ap_pool->mutex));
+    }
+
+  return OMX_ErrorNone;
+}
+
+void
+tiz_wpool_blocking_begin (tiz_wpool_t * ap_pool)
+{
+  assert (ap_pool);
+
+  if (!tls_worker || tls_worker->p_pool != ap_pool)
+    {
+      return;
+    }
+
+  (void) tiz_mutex_lock (&(ap_pool->mutex));
+  ap_pool->nblocked++;
+  if (__atomic_load_n (&(ap_pool->pending), __ATOMIC_SEQ_CST) > 0
+      && __atomic_load_n (&(ap_pool->nidle), __ATOMIC_SEQ_CST) > 0)
+    {
+      /* Someone else can run what we leave behind */
+      (void) tiz_cond_signal (&(ap_pool->cond));
+    }
+  else if (!ap_pool->stopping
+           && 0 == __atomic_load_n (&(ap_pool->nidle), __ATOMIC_SEQ_CST)
+           && ap_pool->nthreads - ap_pool->nblocked < ap_pool->nworkers
+           && ap_pool->nthreads < ap_pool->max_threads)
+    {
+      TIZ_LOG (TIZ_PRIORITY_TRACE,
+               "pool [%s] : starting extra worker (threads [%lu] blocked "
+               "[%lu])",
+               ap_pool->name, (unsigned long) ap_pool->nthreads,
+               (unsigned long) ap_pool->nblocked);
+      if (OMX_ErrorNone != start_worker (ap_pool))
+        {
+          TIZ_LOG (TIZ_PRIORITY_ERROR,
+                   "pool [%s] : could not start an extra worker",
+                   ap_pool->name);
+        }
+    }
+  (void) tiz_mutex_unlock (&(ap_pool->mutex));
+}
+
+void
+tiz_wpool_blocking_end (tiz_wpool_t * ap_pool)
+{
+  assert (ap_pool);
+
+  if (!tls_worker || tls_worker->p_pool != ap_pool)
+    {
+      return;
+    }
+
+  (void) tiz_mutex_lock (&(ap_pool->mutex));
+  assert (ap_pool->nblocked > 0);
+  ap_pool->nblocked--;
+  if (ap_pool->nthreads > ap_pool->nworkers
+      && ap_pool->nthreads - ap_pool->nblocked > ap_pool->nworkers
+      && __atomic_load_n (&(ap_pool->nidle), __ATOMIC_SEQ_CST) > 0)
+    {
+      /* An idle extra worker may retire now */
+      (void) tiz_cond_broadcast (&(ap_pool->cond));
+    }
+  (void) tiz_mutex_unlock (&(ap_pool->mutex));
+}
+
+OMX_U32
+tiz_wpool_nthreads (const tiz_wpool_t * ap_pool)
+{
+  assert (ap_pool);
+  return __atomic_load_n (&(ap_pool->nthreads), __ATOMIC_ACQUIRE);
+}
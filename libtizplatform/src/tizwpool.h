@@ -0,0 +1,143 @@
+/**
+ * Copyright (C) 2011-2020 Aratelia Limited - Juan A. Rubio and contributors
+ *
+ * This file is part of Tizonia
+ *
+ * Tizonia is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Tizonia is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Tizonia.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file   tizwpool.h
+ * @author Juan A. Rubio <juan.rubio@aratelia.com>
+ *
+ * @brief  Work-stealing thread pool
+ *
+ *
+ */
+
+#ifndef TIZWPOOL_H
+#define TIZWPOOL_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup tizwpool Work-stealing thread pool
+ *
+ * A fixed set of worker threads, each one with its own task deque. Tasks
+ * submitted from a worker thread go to that worker's deque; tasks submitted
+ * from any other thread are distributed round-robin. Idle workers steal tasks
+ * from their peers before going to sleep.
+ *
+ * A task that needs to block (e.g. waiting for another task to complete)
+ * should bracket the wait with tiz_wpool_blocking_begin and
+ * tiz_wpool_blocking_end. If all the other workers are busy, the pool then
+ * starts an extra worker so that the number of workers able to run tasks does
+ * not drop below the configured size. Extra workers retire once they run out
+ * of tasks and are no longer needed to make up for blocked workers.
+ *
+ * @ingroup libtizplatform
+ */
+
+#include <OMX_Core.h>
+#include <OMX_Types.h>
+
+/**
+ * Work-stealing pool opaque structure.
+ * @ingroup tizwpool
+ */
+typedef struct tiz_wpool tiz_wpool_t;
+typedef /*@null@ */ tiz_wpool_t * tiz_wpool_ptr_t;
+
+/**
+ * Task function.
+ * @ingroup tizwpool
+ */
+typedef void (*tiz_wpool_task_f) (OMX_PTR ap_arg);
+
+/**
+ * Create a pool and start its worker threads.
+ *
+ * @ingroup tizwpool
+ *
+ * @param a_nworkers Number of workers. If zero, the number of online CPUs is
+ * used.
+ *
+ * @param ap_name Name given to the worker threads (may be NULL).
+ *
+ * @return OMX_ErrorNone if success, OMX_ErrorInsufficientResources otherwise.
+ */
+OMX_ERRORTYPE
+tiz_wpool_init (/*@out@*/ tiz_wpool_ptr_t * app_pool, OMX_U32 a_nworkers,
+                const char * ap_name);
+
+/**
+ * Stop and join all the worker threads and destroy the pool. Tasks that are
+ * still queued at this point are discarded. If ap_pool is NULL, no operation
+ * is performed.
+ *
+ * @ingroup tizwpool
+ *
+ */
+void
+tiz_wpool_destroy (/*@null@ */ tiz_wpool_t * ap_pool);
+
+/**
+ * Queue a task for execution. May be called from any thread.
+ *
+ * @ingroup tizwpool
+ *
+ * @return OMX_ErrorNone if success, OMX_ErrorInsufficientResources otherwise.
+ */
+OMX_ERRORTYPE
+tiz_wpool_submit (tiz_wpool_t * ap_pool, tiz_wpool_task_f apf_task,
+                  OMX_PTR ap_arg);
+
+/**
+ * Announce that the calling task is about to block. This is a no-op when the
+ * caller is not one of the pool's workers.
+ *
+ * @ingroup tizwpool
+ *
+ */
+void
+tiz_wpool_blocking_begin (tiz_wpool_t * ap_pool);
+
+/**
+ * Announce that the calling task is no longer blocked. Must be paired with
+ * tiz_wpool_blocking_begin.
+ *
+ * @ingroup tizwpool
+ *
+ */
+void
+tiz_wpool_blocking_end (tiz_wpool_t * ap_pool);
+
+/**
+ * Retrieve the number of worker threads currently owned by the pool,
+ * including the extra workers that are currently compensating for blocked
+ * ones.
+ *
+ * @ingroup tizwpool
+ *
+ */
+OMX_U32
+tiz_wpool_nthreads (const tiz_wpool_t * ap_pool);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TIZWPOOL_H */
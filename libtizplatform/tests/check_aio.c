@@ -0,0 +1,333 @@
+/**
+ * Copyright (C) 2011-2020 Aratelia Limited - Juan A. Rubio and contributors
+ *
+ * This file is part of Tizonia
+ *
+ * Tizonia is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Tizonia is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Tizonia.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file   check_aio.c
+ * @author Juan A. Rubio <juan.rubio@aratelia.com>
+ *
+ * @brief  Async io requests unit tests and micro-benchmarks
+ *
+ *
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/socket.h>
+
+#define AIO_TEST_CHUNK 4096
+#define AIO_TEST_NCHUNKS 64
+#define AIO_BENCH_NREQUESTS 8
+#define AIO_BENCH_NCHUNKS 2048
+
+typedef struct check_aio_ctx check_aio_ctx_t;
+struct check_aio_ctx
+{
+  tiz_sem_t sem;
+  tiz_event_aio_op_t op;
+  int fd;
+  char * p_buf;
+  size_t chunk;
+  OMX_U32 nleft;
+  OMX_S64 offset; /* -1 to use the file position */
+  ssize_t result;
+  OMX_U32 ncalls;
+};
+
+static void
+check_aio_init_ctx (check_aio_ctx_t * ap_ctx, tiz_event_aio_op_t a_op,
+                    int a_fd, char * ap_buf, size_t a_chunk, OMX_U32 a_nchunks,
+                    OMX_S64 a_offset)
+{
+  memset (ap_ctx, 0, sizeof (check_aio_ctx_t));
+  fail_if (OMX_ErrorNone != tiz_sem_init (&(ap_ctx->sem), 0));
+  ap_ctx->op = a_op;
+  ap_ctx->fd = a_fd;
+  ap_ctx->p_buf = ap_buf;
+  ap_ctx->chunk = a_chunk;
+  ap_ctx->nleft = a_nchunks;
+  ap_ctx->offset = a_offset;
+}
+
+static OMX_ERRORTYPE
+check_aio_submit_next (tiz_event_aio_t * ap_ev_aio, check_aio_ctx_t * ap_ctx)
+{
+  char * p_buf = ap_ctx->p_buf + (ap_ctx->ncalls * ap_ctx->chunk);
+  const OMX_S64 offset
+    = ap_ctx->offset < 0 ? -1
+                         : ap_ctx->offset + ap_ctx->ncalls * ap_ctx->chunk;
+  return tiz_event_aio_submit (ap_ev_aio, ap_ctx->op, ap_ctx->fd, p_buf,
+                               ap_ctx->chunk, offset, ap_ctx->ncalls);
+}
+
+static void
+check_aio_chain_cback (void * ap_arg0, tiz_event_aio_t * ap_ev_aio,
+                       void * ap_arg1, const uint32_t a_id, ssize_t a_result)
+{
+  check_aio_ctx_t * p_ctx = ap_arg1;
+
+  fail_if (a_id != p_ctx->ncalls);
+  fail_if (tiz_event_aio_is_busy (ap_ev_aio));
+  p_ctx->result = a_result;
+  p_ctx->ncalls++;
+
+  /* Submit the next chunk from the callback, until done or failed */
+  if (a_result != (ssize_t) p_ctx->chunk || 0 == --p_ctx->nleft
+      || OMX_ErrorNone != check_aio_submit_next (ap_ev_aio, p_ctx))
+    {
+      tiz_sem_post (&(p_ctx->sem));
+    }
+}
+
+static void
+check_aio_unexpected_cback (void * ap_arg0, tiz_event_aio_t * ap_ev_aio,
+                            void * ap_arg1, const uint32_t a_id,
+                            ssize_t a_result)
+{
+  fail_if (1);
+}
+
+static int
+check_aio_tmpfile (void)
+{
+  char path[] = "/tmp/check_aio_XXXXXX";
+  const int fd = mkstemp (path);
+  fail_if (fd < 0);
+  (void) unlink (path);
+  return fd;
+}
+
+START_TEST (test_aio_file_roundtrip)
+{
+  static char out[AIO_TEST_CHUNK * AIO_TEST_NCHUNKS];
+  static char in[AIO_TEST_CHUNK * AIO_TEST_NCHUNKS];
+  tiz_event_aio_t * p_ev_aio = NULL;
+  check_aio_ctx_t ctx;
+  const int fd = check_aio_tmpfile ();
+  int i = 0;
+
+  for (i = 0; i < sizeof (out); ++i)
+    {
+      out[i] = (char) random ();
+    }
+
+  /* Write at explicit offsets, then read back from the file position */
+  fail_if (OMX_ErrorNone != tiz_event_aio_init (&p_ev_aio, &ctx,
+                                                check_aio_chain_cback, &ctx));
+  check_aio_init_ctx (&ctx, TIZ_EVENT_AIO_WRITE, fd, out, AIO_TEST_CHUNK,
+                      AIO_TEST_NCHUNKS, 0);
+  fail_if (OMX_ErrorNone != check_aio_submit_next (p_ev_aio, &ctx));
+  tiz_sem_wait (&(ctx.sem));
+  fail_if (AIO_TEST_CHUNK != ctx.result);
+  fail_if (AIO_TEST_NCHUNKS != ctx.ncalls);
+  (void) tiz_sem_destroy (&(ctx.sem));
+
+  check_aio_init_ctx (&ctx, TIZ_EVENT_AIO_READ, fd, in, AIO_TEST_CHUNK,
+                      AIO_TEST_NCHUNKS, -1);
+  fail_if (OMX_ErrorNone != check_aio_submit_next (p_ev_aio, &ctx));
+  tiz_sem_wait (&(ctx.sem));
+  fail_if (AIO_TEST_CHUNK != ctx.result);
+  fail_if (0 != memcmp (in, out, sizeof (out)));
+  fail_if (sizeof (out) != lseek (fd, 0, SEEK_CUR));
+  (void) tiz_sem_destroy (&(ctx.sem));
+
+  /* End of file */
+  check_aio_init_ctx (&ctx, TIZ_EVENT_AIO_READ, fd, in, AIO_TEST_CHUNK, 1,
+                      -1);
+  fail_if (OMX_ErrorNone != check_aio_submit_next (p_ev_aio, &ctx));
+  tiz_sem_wait (&(ctx.sem));
+  fail_if (0 != ctx.result);
+  (void) tiz_sem_destroy (&(ctx.sem));
+
+  /* Errors are reported as negative errno values */
+  fail_if (0 != close (fd));
+  check_aio_init_ctx (&ctx, TIZ_EVENT_AIO_READ, fd, in, AIO_TEST_CHUNK, 1,
+                      0);
+  fail_if (OMX_ErrorNone != check_aio_submit_next (p_ev_aio, &ctx));
+  tiz_sem_wait (&(ctx.sem));
+  fail_if (-EBADF != ctx.result);
+  (void) tiz_sem_destroy (&(ctx.sem));
+
+  tiz_event_aio_destroy (p_ev_aio);
+}
+END_TEST
+
+START_TEST (test_aio_socket)
+{
+  static char out[AIO_TEST_CHUNK * AIO_TEST_NCHUNKS];
+  static char in[AIO_TEST_CHUNK * AIO_TEST_NCHUNKS];
+  tiz_event_aio_t * p_recv_aio = NULL;
+  tiz_event_aio_t * p_send_aio = NULL;
+  check_aio_ctx_t recv_ctx;
+  check_aio_ctx_t send_ctx;
+  int sv[2] = {-1, -1};
+  int i = 0;
+
+  fail_if (0 != socketpair (AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK, 0, sv));
+  for (i = 0; i < sizeof (out); ++i)
+    {
+      out[i] = (char) random ();
+    }
+
+  /* The receiver waits for data that is not there yet */
+  fail_if (OMX_ErrorNone != tiz_event_aio_init (&p_recv_aio, &recv_ctx,
+                                                check_aio_chain_cback,
+                                                &recv_ctx));
+  fail_if (OMX_ErrorNone != tiz_event_aio_init (&p_send_aio, &send_ctx,
+                                                check_aio_chain_cback,
+                                                &send_ctx));
+  check_aio_init_ctx (&recv_ctx, TIZ_EVENT_AIO_RECV, sv[1], in,
+                      AIO_TEST_CHUNK, AIO_TEST_NCHUNKS, 0);
+  check_aio_init_ctx (&send_ctx, TIZ_EVENT_AIO_SEND, sv[0], out,
+                      AIO_TEST_CHUNK, AIO_TEST_NCHUNKS, 0);
+  fail_if (OMX_ErrorNone != check_aio_submit_next (p_recv_aio, &recv_ctx));
+  usleep (10000);
+  fail_if (0 != recv_ctx.ncalls);
+  fail_if (!tiz_event_aio_is_busy (p_recv_aio));
+  fail_if (OMX_ErrorNotReady
+           != check_aio_submit_next (p_recv_aio, &recv_ctx));
+
+  fail_if (OMX_ErrorNone != check_aio_submit_next (p_send_aio, &send_ctx));
+  tiz_sem_wait (&(send_ctx.sem));
+  tiz_sem_wait (&(recv_ctx.sem));
+  fail_if (AIO_TEST_CHUNK != send_ctx.result);
+  fail_if (AIO_TEST_CHUNK != recv_ctx.result);
+  fail_if (0 != memcmp (in, out, sizeof (out)));
+
+  /* Sending to a closed peer fails, without SIGPIPE */
+  (void) tiz_sem_destroy (&(send_ctx.sem));
+  fail_if (0 != close (sv[1]));
+  check_aio_init_ctx (&send_ctx, TIZ_EVENT_AIO_SEND, sv[0], out,
+                      AIO_TEST_CHUNK, 1, 0);
+  fail_if (OMX_ErrorNone != check_aio_submit_next (p_send_aio, &send_ctx));
+  tiz_sem_wait (&(send_ctx.sem));
+  fail_if (-EPIPE != send_ctx.result);
+
+  tiz_event_aio_destroy (p_recv_aio);
+  tiz_event_aio_destroy (p_send_aio);
+  (void) tiz_sem_destroy (&(send_ctx.sem));
+  (void) tiz_sem_destroy (&(recv_ctx.sem));
+  fail_if (0 != close (sv[0]));
+}
+END_TEST
+
+START_TEST (test_aio_destroy_in_progress)
+{
+  static char buf[AIO_TEST_CHUNK];
+  tiz_event_aio_t * p_ev_aio = NULL;
+  int sv[2] = {-1, -1};
+
+  fail_if (0 != socketpair (AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK, 0, sv));
+
+  /* A request destroyed while in progress is cancelled, without callback */
+  fail_if (OMX_ErrorNone
+           != tiz_event_aio_init (&p_ev_aio, NULL, check_aio_unexpected_cback,
+                                  NULL));
+  fail_if (OMX_ErrorNone
+           != tiz_event_aio_submit (p_ev_aio, TIZ_EVENT_AIO_RECV, sv[1], buf,
+                                    sizeof (buf), 0, 0));
+  usleep (10000);
+  tiz_event_aio_destroy (p_ev_aio);
+  usleep (10000);
+
+  /* Data arriving after that goes nowhere */
+  fail_if (sizeof (buf) != write (sv[0], buf, sizeof (buf)));
+  usleep (10000);
+  fail_if (sizeof (buf) != read (sv[1], buf, sizeof (buf)));
+
+  fail_if (0 != close (sv[0]));
+  fail_if (0 != close (sv[1]));
+}
+END_TEST
+
+START_TEST (test_aio_benchmark)
+{
+  static char buf[AIO_BENCH_NREQUESTS][AIO_TEST_CHUNK * AIO_BENCH_NCHUNKS];
+  tiz_event_aio_t * p_aios[AIO_BENCH_NREQUESTS];
+  check_aio_ctx_t ctxs[AIO_BENCH_NREQUESTS];
+  struct timespec start;
+  double sync_ns = 0;
+  double async_ns = 0;
+  const int fd = check_aio_tmpfile ();
+  int i = 0;
+  int j = 0;
+
+  /* Each request reads its own region of the file, chunk after chunk */
+  for (i = 0; i < AIO_BENCH_NREQUESTS; ++i)
+    {
+      memset (buf[i], i, sizeof (buf[i]));
+      fail_if (sizeof (buf[i]) != write (fd, buf[i], sizeof (buf[i])));
+      fail_if (OMX_ErrorNone != tiz_event_aio_init (&p_aios[i], &ctxs[i],
+                                                    check_aio_chain_cback,
+                                                    &ctxs[i]));
+    }
+
+  (void) clock_gettime (CLOCK_MONOTONIC, &start);
+  for (i = 0; i < AIO_BENCH_NREQUESTS; ++i)
+    {
+      for (j = 0; j < AIO_BENCH_NCHUNKS; ++j)
+        {
+          fail_if (AIO_TEST_CHUNK
+                   != pread (fd, buf[i] + j * AIO_TEST_CHUNK, AIO_TEST_CHUNK,
+                             (OMX_S64) sizeof (buf[i]) * i
+                               + j * AIO_TEST_CHUNK));
+        }
+    }
+  sync_ns = check_bench_elapsed_ns (&start);
+
+  (void) clock_gettime (CLOCK_MONOTONIC, &start);
+  for (i = 0; i < AIO_BENCH_NREQUESTS; ++i)
+    {
+      check_aio_init_ctx (&ctxs[i], TIZ_EVENT_AIO_READ, fd, buf[i],
+                          AIO_TEST_CHUNK, AIO_BENCH_NCHUNKS,
+                          (OMX_S64) sizeof (buf[i]) * i);
+      fail_if (OMX_ErrorNone != check_aio_submit_next (p_aios[i], &ctxs[i]));
+    }
+  for (i = 0; i < AIO_BENCH_NREQUESTS; ++i)
+    {
+      tiz_sem_wait (&(ctxs[i].sem));
+    }
+  async_ns = check_bench_elapsed_ns (&start);
+
+  for (i = 0; i < AIO_BENCH_NREQUESTS; ++i)
+    {
+      fail_if (AIO_TEST_CHUNK != ctxs[i].result);
+      fail_if (i != buf[i][0] || i != buf[i][sizeof (buf[i]) - 1]);
+      tiz_event_aio_destroy (p_aios[i]);
+      (void) tiz_sem_destroy (&(ctxs[i].sem));
+    }
+  fail_if (0 != close (fd));
+
+  printf ("[%d x %d reads of %d bytes] pread: %.0f ns/read - aio: %.0f "
+          "ns/read\n",
+          AIO_BENCH_NREQUESTS, AIO_BENCH_NCHUNKS, AIO_TEST_CHUNK,
+          sync_ns / (AIO_BENCH_NREQUESTS * AIO_BENCH_NCHUNKS),
+          async_ns / (AIO_BENCH_NREQUESTS * AIO_BENCH_NCHUNKS));
+}
+END_TEST
+
+/* Local Variables: */
+/* c-default-style: gnu */
+/* fill-column: 79 */
+/* indent-tabs-mode: nil */
+/* compile-command: "make check" */
+/* End: */
@@ -0,0 +1,55 @@
+/**
+ * Copyright (C) 2011-2020 Aratelia Limited - Juan A. Rubio and contributors
+ *
+ * This file is part of Tizonia
+ *
+ * Tizonia is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Tizonia is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Tizonia.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/**
+ * @file   check_bench.c
+ * @author Juan A. Rubio <juan.rubio@aratelia.com>
+ *
+ * @brief  Benchmark helpers
+ *
+ *
+ */
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/* The benchmarks are not part of 'make check'; they are only run when
+   TIZONIA_CHECK_BENCH is set in the environment (see 'make bench') */
+#define CHECK_BENCH_ENV "TIZONIA_CHECK_BENCH"
+
+static bool
+check_bench_enabled (void)
+{
+  const char *p_env = getenv (CHECK_BENCH_ENV);
+  return p_env && *p_env && 0 != strcmp (p_env, "0");
+}
+
+/* Nanoseconds elapsed since ap_start (from CLOCK_MONOTONIC) */
+static double
+check_bench_elapsed_ns (const struct timespec * ap_start)
+{
+  struct timespec now;
+  (void) clock_gettime (CLOCK_MONOTONIC, &now);
+  return (now.tv_sec - ap_start->tv_sec) * 1e9
+         + (now.tv_nsec - ap_start->tv_nsec);
+}
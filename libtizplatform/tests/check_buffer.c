@@ -0,0 +1,240 @@
+/**
+ * Copyright (C) 2011-2020 Aratelia Limited - Juan A. Rubio and contributors
+ *
+ * This file is part of Tizonia
+ *
+ * Tizonia is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Tizonia is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Tizonia.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/**
+ * @file   check_buffer.c
+ * @author Juan A. Rubio <juan.rubio@aratelia.com>
+ *
+ * @brief  Dynamic buffer unit tests
+ *
+ *
+ */
+
+#include <time.h>
+
+static void
+check_buffer_fill (unsigned char *ap_data, const size_t a_nbytes,
+                   const unsigned int a_seed)
+{
+  size_t i = 0;
+  for (i = 0; i < a_nbytes; ++i)
+    {
+      ap_data[i] = (unsigned char) (a_seed + i * 7);
+    }
+}
+
+static bool
+check_buffer_matches (const unsigned char *ap_data, const size_t a_nbytes,
+                      const unsigned int a_seed)
+{
+  size_t i = 0;
+  for (i = 0; i < a_nbytes; ++i)
+    {
+      if (ap_data[i] != (unsigned char) (a_seed + i * 7))
+        {
+          return false;
+        }
+    }
+  return true;
+}
+
+START_TEST (test_buffer_modes)
+{
+  tiz_buffer_t *p_buf = NULL;
+  unsigned char data[1000];
+  int i = 0;
+
+  check_buffer_fill (data, sizeof (data), 0);
+
+  /* Seekable buffers keep the data behind the position marker */
+  fail_if (OMX_ErrorNone != tiz_buffer_init (&p_buf, 512));
+  fail_if (TIZ_BUFFER_NON_SEEKABLE
+           != tiz_buffer_seek_mode (p_buf, TIZ_BUFFER_SEEKABLE));
+  fail_if (1000 != tiz_buffer_push (p_buf, data, sizeof (data)));
+  fail_if (1024 != tiz_buffer_capacity (p_buf));
+  fail_if (600 != tiz_buffer_advance (p_buf, 600));
+  fail_if (100 != tiz_buffer_push (p_buf, data, 100));
+  fail_if (0 != tiz_buffer_seek (p_buf, 0, TIZ_BUFFER_SEEK_SET));
+  fail_if (1100 != tiz_buffer_available (p_buf));
+  fail_if (!check_buffer_matches (tiz_buffer_get (p_buf), 1000, 0));
+
+  /* Non-seekable ones drop it when they need room */
+  fail_if (TIZ_BUFFER_SEEKABLE
+           != tiz_buffer_seek_mode (p_buf, TIZ_BUFFER_NON_SEEKABLE));
+  fail_if (1000 != tiz_buffer_advance (p_buf, 1000));
+  for (i = 0; i < 10; ++i)
+    {
+      fail_if (1000 != tiz_buffer_push (p_buf, data, sizeof (data)));
+      fail_if (1000 != tiz_buffer_advance (p_buf, 1000));
+    }
+  fail_if (100 != tiz_buffer_available (p_buf));
+  fail_if (0 != memcmp (tiz_buffer_get (p_buf), data + 900, 100));
+  fail_if (2048 != tiz_buffer_capacity (p_buf));
+
+  /* Shrinking never goes below the initial size */
+  fail_if (0 != tiz_buffer_shrink_to_fit (p_buf));
+  fail_if (512 != tiz_buffer_capacity (p_buf));
+  fail_if (100 != tiz_buffer_available (p_buf));
+  fail_if (0 != memcmp (tiz_buffer_get (p_buf), data + 900, 100));
+
+  /* The maximum capacity bounds the store, and what a push may store */
+  tiz_buffer_set_max_capacity (p_buf, 1024);
+  fail_if (924 != tiz_buffer_push (p_buf, data, sizeof (data)));
+  fail_if (1024 != tiz_buffer_capacity (p_buf));
+  fail_if (0 != tiz_buffer_push (p_buf, data, 1));
+
+  tiz_buffer_destroy (p_buf);
+}
+END_TEST
+
+START_TEST (test_buffer_ring)
+{
+  tiz_buffer_t *p_buf = NULL;
+  unsigned char data[6000];
+  /* Stream positions: bytes pushed, and bytes consumed; the byte at stream
+     position p is (7 * p) */
+  size_t w = 0;
+  size_t r = 0;
+  int capacity = 0;
+  int avail = 0;
+  int i = 0;
+
+  fail_if (OMX_ErrorNone != tiz_buffer_init (&p_buf, 1000));
+  check_buffer_fill (data, 300, 0);
+  fail_if (300 != tiz_buffer_push (p_buf, data, 300));
+  w += 300;
+  fail_if (TIZ_BUFFER_NON_SEEKABLE
+           != tiz_buffer_seek_mode (p_buf, TIZ_BUFFER_RING));
+  fail_if (300 != tiz_buffer_available (p_buf));
+  fail_if (!check_buffer_matches (tiz_buffer_get (p_buf), 300, 0));
+  capacity = tiz_buffer_capacity (p_buf);
+  fail_if (capacity < 1000);
+
+  /* The data wraps around the store, and still reads contiguously */
+  for (i = 0; i < 500; ++i)
+    {
+      const int nbytes = 1 + (i * 337) % 2000;
+      check_buffer_fill (data, nbytes, 7 * w);
+      fail_if (nbytes != tiz_buffer_push (p_buf, data, nbytes));
+      w += nbytes;
+      avail = tiz_buffer_available (p_buf);
+      fail_if (w - r != (size_t) avail);
+      fail_if (!check_buffer_matches (tiz_buffer_get (p_buf), avail, 7 * r));
+      avail -= MIN (i % 50, avail);
+      fail_if (avail != tiz_buffer_advance (p_buf, avail));
+      r += avail;
+    }
+  fail_if (capacity != tiz_buffer_capacity (p_buf));
+
+  /* Only forward seeks */
+  fail_if (-1 != tiz_buffer_seek (p_buf, 0, TIZ_BUFFER_SEEK_SET));
+  fail_if (-1 != tiz_buffer_seek (p_buf, -1, TIZ_BUFFER_SEEK_CUR));
+  fail_if (-1 != tiz_buffer_seek (p_buf, -1, TIZ_BUFFER_SEEK_END));
+  check_buffer_fill (data, 100, 7 * w);
+  fail_if (100 != tiz_buffer_push (p_buf, data, 100));
+  w += 100;
+  fail_if (0 != tiz_buffer_seek (p_buf, 10, TIZ_BUFFER_SEEK_CUR));
+  r += 10;
+  fail_if (w - r != (size_t) tiz_buffer_available (p_buf));
+
+  /* Growing keeps the data */
+  check_buffer_fill (data, sizeof (data), 7 * w);
+  fail_if (sizeof (data) != tiz_buffer_push (p_buf, data, sizeof (data)));
+  w += sizeof (data);
+  avail = tiz_buffer_available (p_buf);
+  fail_if (w - r != (size_t) avail);
+  fail_if (tiz_buffer_capacity (p_buf) < avail);
+  fail_if (!check_buffer_matches (tiz_buffer_get (p_buf), avail, 7 * r));
+
+  /* ...and shrinking too */
+  fail_if (avail - 90 != tiz_buffer_advance (p_buf, avail - 90));
+  r += avail - 90;
+  fail_if (0 != tiz_buffer_shrink_to_fit (p_buf));
+  fail_if (capacity != tiz_buffer_capacity (p_buf));
+  fail_if (90 != tiz_buffer_available (p_buf));
+  fail_if (!check_buffer_matches (tiz_buffer_get (p_buf), 90, 7 * r));
+
+  /* Back to a linear store */
+  fail_if (TIZ_BUFFER_RING
+           != tiz_buffer_seek_mode (p_buf, TIZ_BUFFER_SEEKABLE));
+  fail_if (90 != tiz_buffer_available (p_buf));
+  fail_if (!check_buffer_matches (tiz_buffer_get (p_buf), 90, 7 * r));
+  fail_if (0 != tiz_buffer_seek (p_buf, 0, TIZ_BUFFER_SEEK_SET));
+  fail_if (90 != tiz_buffer_available (p_buf));
+
+  tiz_buffer_destroy (p_buf);
+}
+END_TEST
+
+static double
+check_buffer_throughput (const int a_mode, const size_t a_chunk,
+                         const size_t a_backlog, const int a_iterations)
+{
+  tiz_buffer_t *p_buf = NULL;
+  unsigned char data[4096];
+  struct timespec start;
+  double secs = 0;
+  int i = 0;
+
+  fail_if (a_chunk > sizeof (data));
+  check_buffer_fill (data, sizeof (data), 0);
+
+  fail_if (OMX_ErrorNone != tiz_buffer_init (&p_buf, 64 * 1024));
+  (void) tiz_buffer_seek_mode (p_buf, a_mode);
+
+  /* Keep a backlog of data in the buffer, as a source that runs ahead of
+     its consumer does */
+  for (i = 0; (size_t) i < a_backlog / a_chunk; ++i)
+    {
+      (void) tiz_buffer_push (p_buf, data, a_chunk);
+    }
+
+  (void) clock_gettime (CLOCK_MONOTONIC, &start);
+  for (i = 0; i < a_iterations; ++i)
+    {
+      fail_if ((int) a_chunk != tiz_buffer_push (p_buf, data, a_chunk));
+      fail_if ((int) a_chunk != tiz_buffer_advance (p_buf, a_chunk));
+    }
+  secs = check_bench_elapsed_ns (&start) / 1e9;
+
+  tiz_buffer_destroy (p_buf);
+
+  return (double) a_chunk * a_iterations / (1024 * 1024) / secs;
+}
+
+START_TEST (test_buffer_benchmark)
+{
+  const size_t chunks[] = {512, 4096};
+  const size_t backlog = 48 * 1024;
+  const int iterations = 100000;
+  size_t c = 0;
+
+  for (c = 0; c < sizeof (chunks) / sizeof (chunks[0]); ++c)
+    {
+      const double linear = check_buffer_throughput (
+        TIZ_BUFFER_NON_SEEKABLE, chunks[c], backlog, iterations);
+      const double ring = check_buffer_throughput (TIZ_BUFFER_RING, chunks[c],
+                                                   backlog, iterations);
+      printf ("[%zu-byte push/advance, %zu bytes queued] non-seekable: "
+              "%.0f MiB/s - ring: %.0f MiB/s\n",
+              chunks[c], backlog, linear, ring);
+    }
+}
+END_TEST
@@ -0,0 +1,249 @@
+/**
+ * Copyright (C) 2011-2020 Aratelia Limited - Juan A. Rubio and contributors
+ *
+ * This file is part of Tizonia
+ *
+ * Tizonia is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Tizonia is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Tizonia.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/**
+ * @file   check_bufpool.c
+ * @author Juan A. Rubio <juan.rubio@aratelia.com>
+ *
+ * @brief  Buffer pool unit tests
+ *
+ *
+ */
+
+#include <stdint.h>
+#include <time.h>
+
+#define BUFPOOL_TEST_HUGE_SZ (2 * 1024 * 1024)
+
+static bool
+check_bufpool_is_zero (const uint8_t *ap_buf, const size_t a_size)
+{
+  size_t i = 0;
+  for (i = 0; i < a_size; ++i)
+    {
+      if (ap_buf[i])
+        {
+          return false;
+        }
+    }
+  return true;
+}
+
+START_TEST (test_bufpool_alloc_and_reuse)
+{
+  const size_t sizes[] = {1, 100, 4096, 5000, 200 * 1024};
+  tiz_bufpool_info_t before;
+  tiz_bufpool_info_t info;
+  uint8_t *p_buf = NULL;
+  size_t i = 0;
+
+  fail_if (OMX_ErrorNone
+           != tiz_bufpool_configure (ETIZBufpoolHugepagesNone,
+                                     4 * 1024 * 1024));
+  tiz_bufpool_trim ();
+
+  for (i = 0; i < sizeof (sizes) / sizeof (sizes[0]); ++i)
+    {
+      tiz_bufpool_info (&before);
+      p_buf = tiz_bufpool_alloc (sizes[i]);
+      fail_if (NULL == p_buf);
+      fail_if (0 != (uintptr_t) p_buf % TIZ_BUFPOOL_ALIGN);
+      fail_if (!check_bufpool_is_zero (p_buf, sizes[i]));
+      tiz_bufpool_info (&info);
+      fail_if (before.buffers + 1 != info.buffers);
+      fail_if (info.bytes - before.bytes < sizes[i]);
+      (void) memset (p_buf, 0xab, sizes[i]);
+      tiz_bufpool_free (p_buf);
+
+      /* A buffer of the same size comes back from the cache, zeroed */
+      p_buf = tiz_bufpool_alloc (sizes[i]);
+      fail_if (NULL == p_buf);
+      fail_if (!check_bufpool_is_zero (p_buf, sizes[i]));
+      tiz_bufpool_info (&info);
+      fail_if (before.hits + 1 != info.hits);
+      fail_if (before.misses + 1 != info.misses);
+      tiz_bufpool_free (p_buf);
+    }
+
+  tiz_bufpool_info (&info);
+  fail_if (info.cached < sizeof (sizes) / sizeof (sizes[0]));
+  tiz_bufpool_trim ();
+  tiz_bufpool_info (&info);
+  fail_if (0 != info.cached || 0 != info.cached_bytes);
+
+  /* Without a cache, buffers go straight back to the system */
+  fail_if (OMX_ErrorNone
+           != tiz_bufpool_configure (ETIZBufpoolHugepagesNone, 0));
+  p_buf = tiz_bufpool_alloc (8192);
+  fail_if (NULL == p_buf);
+  tiz_bufpool_free (p_buf);
+  tiz_bufpool_info (&info);
+  fail_if (0 != info.cached);
+
+  fail_if (OMX_ErrorNone
+           != tiz_bufpool_configure (ETIZBufpoolHugepagesNone,
+                                     64 * 1024 * 1024));
+}
+END_TEST
+
+START_TEST (test_bufpool_hugepages)
+{
+  tiz_bufpool_info_t before;
+  tiz_bufpool_info_t info;
+  uint8_t *p_bufs[3] = {NULL, NULL, NULL};
+  uint8_t *p_large = NULL;
+  int i = 0;
+
+  fail_if (OMX_ErrorBadParameter
+           != tiz_bufpool_configure (ETIZBufpoolHugepagesMax, 0));
+  fail_if (OMX_ErrorNone
+           != tiz_bufpool_configure (ETIZBufpoolHugepagesTransparent,
+                                     64 * 1024 * 1024));
+  tiz_bufpool_trim ();
+  tiz_bufpool_info (&before);
+
+  /* Buffers of the same size share a huge page block */
+  for (i = 0; i < 3; ++i)
+    {
+      p_bufs[i] = tiz_bufpool_alloc (64 * 1024);
+      fail_if (NULL == p_bufs[i]);
+      fail_if (!check_bufpool_is_zero (p_bufs[i], 64 * 1024));
+      (void) memset (p_bufs[i], i + 1, 64 * 1024);
+    }
+  fail_if (0 != (uintptr_t) p_bufs[0] % BUFPOOL_TEST_HUGE_SZ);
+  tiz_bufpool_info (&info);
+  fail_if (before.huge_bytes + BUFPOOL_TEST_HUGE_SZ != info.huge_bytes);
+  fail_if (before.misses + 1 != info.misses);
+  fail_if (before.hits + 2 != info.hits);
+  fail_if (3 * 64 * 1024 != info.bytes - before.bytes);
+
+  /* Larger buffers are rounded up to whole huge pages */
+  p_large = tiz_bufpool_alloc (3 * 1024 * 1024);
+  fail_if (NULL == p_large);
+  fail_if (0 != (uintptr_t) p_large % BUFPOOL_TEST_HUGE_SZ);
+  tiz_bufpool_info (&info);
+  fail_if (before.huge_bytes + 3 * BUFPOOL_TEST_HUGE_SZ != info.huge_bytes);
+  tiz_bufpool_free (p_large);
+
+  /* A block goes back to the system once all its buffers are released */
+  for (i = 0; i < 3; ++i)
+    {
+      tiz_bufpool_free (p_bufs[i]);
+    }
+  tiz_bufpool_trim ();
+  tiz_bufpool_info (&info);
+  fail_if (before.huge_bytes != info.huge_bytes);
+  fail_if (0 != info.cached);
+
+  /* Without a huge page pool, this falls back to transparent huge pages */
+  fail_if (OMX_ErrorNone
+           != tiz_bufpool_configure (ETIZBufpoolHugepagesExplicit,
+                                     64 * 1024 * 1024));
+  p_large = tiz_bufpool_alloc (256 * 1024);
+  fail_if (NULL == p_large);
+  fail_if (!check_bufpool_is_zero (p_large, 256 * 1024));
+  tiz_bufpool_free (p_large);
+  tiz_bufpool_trim ();
+
+  fail_if (OMX_ErrorNone
+           != tiz_bufpool_configure (ETIZBufpoolHugepagesNone,
+                                     64 * 1024 * 1024));
+}
+END_TEST
+
+START_TEST (test_bufpool_accounts)
+{
+  tiz_mem_account_t *p_account = NULL;
+  tiz_mem_account_t *p_prev = NULL;
+  tiz_mem_account_info_t info;
+  uint8_t *p_buf = NULL;
+
+  fail_if (OMX_ErrorNone != tiz_mem_account_init (&p_account));
+
+  /* Buffers are charged to the allocating thread's account */
+  p_prev = tiz_mem_account_swap (p_account);
+  p_buf = tiz_bufpool_alloc (100 * 1024);
+  fail_if (NULL == p_buf);
+  tiz_mem_account_info (p_account, &info);
+  fail_if (info.bytes < 100 * 1024);
+  fail_if (1 != info.allocs);
+
+  /* ...and refused beyond its limit */
+  tiz_mem_account_set_limit (p_account, info.bytes + 1024);
+  fail_if (NULL != tiz_bufpool_alloc (2048));
+  tiz_mem_account_info (p_account, &info);
+  fail_if (1 != info.failures);
+  fail_if (p_account != tiz_mem_account_swap (p_prev));
+
+  /* Releasing the buffer from elsewhere credits the account */
+  tiz_bufpool_free (p_buf);
+  tiz_mem_account_info (p_account, &info);
+  fail_if (0 != info.bytes);
+  fail_if (1 != info.frees);
+
+  tiz_mem_account_destroy (p_account);
+}
+END_TEST
+
+START_TEST (test_bufpool_benchmark)
+{
+  const size_t sizes[] = {8192, 65536, 1024 * 1024};
+  const int iterations = 2000;
+  struct timespec start;
+  double pool_ns = 0;
+  double calloc_ns = 0;
+  void *p_buf = NULL;
+  size_t s = 0;
+  int i = 0;
+
+  fail_if (OMX_ErrorNone
+           != tiz_bufpool_configure (ETIZBufpoolHugepagesNone,
+                                     64 * 1024 * 1024));
+
+  for (s = 0; s < sizeof (sizes) / sizeof (sizes[0]); ++s)
+    {
+      (void) clock_gettime (CLOCK_MONOTONIC, &start);
+      for (i = 0; i < iterations; ++i)
+        {
+          p_buf = tiz_bufpool_alloc (sizes[s]);
+          fail_if (NULL == p_buf);
+          ((volatile uint8_t *) p_buf)[0] = 1;
+          tiz_bufpool_free (p_buf);
+        }
+      pool_ns = check_bench_elapsed_ns (&start) / iterations;
+
+      (void) clock_gettime (CLOCK_MONOTONIC, &start);
+      for (i = 0; i < iterations; ++i)
+        {
+          p_buf = calloc (1, sizes[s]);
+          fail_if (NULL == p_buf);
+          ((volatile uint8_t *) p_buf)[0] = 1;
+          free (p_buf);
+        }
+      calloc_ns = check_bench_elapsed_ns (&start) / iterations;
+
+      printf ("[%zu bytes x %d alloc/free pairs] tiz_bufpool: %.1f ns/pair - "
+              "calloc: %.1f ns/pair\n",
+              sizes[s], iterations, pool_ns, calloc_ns);
+    }
+
+  tiz_bufpool_trim ();
+}
+END_TEST
@@ -21,7 +21,7 @@
  * @file   check_event.c
  * @author Juan A. Rubio <juan.rubio@aratelia.com>
  *
- * @brief  Event loop API unit tests
+ * @brief  Event loop API unit tests and micro-benchmark
  *
  *
  */
@@ -32,6 +32,7 @@
 #include <strings.h>
 #include <unistd.h>
 #include <fcntl.h>
+#include <pthread.h>
 #include <stdbool.h>
 #include <stdlib.h>
 #include <time.h>
@@ -48,6 +49,12 @@
 #define CHECK_STAT_TOUCH_CMD "/bin/bash -c \"touch /tmp/check_event.txt\""
 #define CHECK_STAT_ECHO_CMD "/bin/bash -c \"echo \"Hello\" > /tmp/check_event.txt\""
 
+/* Must match the 'event-loops' key in tests/tizonia.conf */
+#define CHECK_SHARDS_COUNT 3
+#define CHECK_SHARDS_NTIMERS 4
+#define CHECK_SHARDS_INLINE_NTICKS 50
+#define CHECK_SHARDS_BENCH_NOPS 2000
+
 static bool g_io_cback_received = false;
 static int g_timeout_count = 5;
 static int g_restart_count = 2;
@@ -166,6 +173,80 @@ check_event_stat_cback (OMX_HANDLETYPE p_hdl, tiz_event_stat_t * ap_ev_stat,
   fail_if (OMX_ErrorNone != error);
 }
 
+typedef struct check_shards_timer check_shards_timer_t;
+struct check_shards_timer
+{
+  tiz_event_timer_t * p_ev_timer;
+  pthread_t thread;
+  volatile int nticks;
+  double elapsed_ns;
+};
+
+static void
+check_shards_timer_cback (void * ap_arg0, tiz_event_timer_t * ap_ev_timer,
+                          void * ap_arg1, const uint32_t a_id)
+{
+  check_shards_timer_t * p_timer = ap_arg1;
+  fail_if (p_timer->p_ev_timer != ap_ev_timer);
+  p_timer->thread = pthread_self ();
+  p_timer->nticks++;
+}
+
+static void
+check_shards_inline_cback (void * ap_arg0, tiz_event_timer_t * ap_ev_timer,
+                           void * ap_arg1, const uint32_t a_id)
+{
+  check_shards_timer_t * p_timer = ap_arg1;
+  if (++p_timer->nticks == CHECK_SHARDS_INLINE_NTICKS)
+    {
+      /* These run straight away, as this is the timer's own loop; the timer
+         is gone when they return */
+      fail_if (OMX_ErrorNone != tiz_event_timer_stop (ap_ev_timer));
+      tiz_event_timer_destroy (ap_ev_timer);
+      p_timer->p_ev_timer = NULL;
+    }
+}
+
+static void
+check_shards_bench_cback (void * ap_arg0, tiz_event_timer_t * ap_ev_timer,
+                          void * ap_arg1, const uint32_t a_id)
+{
+  check_shards_timer_t * p_timer = ap_arg1;
+  tiz_event_timer_t * p_other = NULL;
+  struct timespec start;
+  int i = 0;
+
+  fail_if (OMX_ErrorNone
+           != tiz_event_timer_init (&p_other, ap_arg0,
+                                    check_shards_timer_cback, NULL));
+  tiz_event_timer_set (p_other, 60., 0.);
+  (void) clock_gettime (CLOCK_MONOTONIC, &start);
+  for (i = 0; i < CHECK_SHARDS_BENCH_NOPS; ++i)
+    {
+      (void) tiz_event_timer_start (p_other, i + 1);
+      (void) tiz_event_timer_stop (p_other);
+    }
+  p_timer->elapsed_ns = check_bench_elapsed_ns (&start);
+  tiz_event_timer_destroy (p_other);
+  p_timer->nticks++;
+}
+
+static void
+check_shards_wait (check_shards_timer_t * ap_timers, const int a_ntimers,
+                   const int a_nticks)
+{
+  int i = 0;
+  int waited_ms = 0;
+  for (i = 0; i < a_ntimers && waited_ms < 5000; ++i)
+    {
+      while (ap_timers[i].nticks < a_nticks && waited_ms < 5000)
+        {
+          (void) tiz_sleep (1000);
+          waited_ms++;
+        }
+    }
+}
+
 /* TESTS */
 
 START_TEST (test_event_loop_init_and_destroy)
@@ -341,6 +422,202 @@ START_TEST (test_event_stat)
 }
 END_TEST
 
+START_TEST (test_event_loop_shards)
+{
+  check_shards_timer_t timers[CHECK_SHARDS_NTIMERS];
+  /* Two timers of owner 0, one each for owners 1 and 2 */
+  const int owners[CHECK_SHARDS_NTIMERS] = {0, 0, 1, 2};
+  int handles[3];
+  int i = 0;
+
+  memset (timers, 0, sizeof (timers));
+  fail_if (OMX_ErrorNone != tiz_event_loop_init ());
+  fail_if (CHECK_SHARDS_COUNT != tiz_event_loop_shards ());
+
+  fail_if (OMX_ErrorNone != tiz_event_loop_bind (&handles[0], 2));
+  fail_if (OMX_ErrorNone != tiz_event_loop_bind (&handles[1], 0));
+  fail_if (OMX_ErrorNone != tiz_event_loop_bind (&handles[1], 1));
+  fail_if (OMX_ErrorBadParameter
+           != tiz_event_loop_bind (&handles[2], CHECK_SHARDS_COUNT));
+
+  for (i = 0; i < CHECK_SHARDS_NTIMERS; ++i)
+    {
+      fail_if (OMX_ErrorNone
+               != tiz_event_timer_init (&timers[i].p_ev_timer,
+                                        &handles[owners[i]],
+                                        check_shards_timer_cback, &timers[i]));
+      tiz_event_timer_set (timers[i].p_ev_timer, 0.001, 0.);
+      fail_if (OMX_ErrorNone
+               != tiz_event_timer_start (timers[i].p_ev_timer, i + 1));
+    }
+
+  check_shards_wait (timers, CHECK_SHARDS_NTIMERS, 1);
+  for (i = 0; i < CHECK_SHARDS_NTIMERS; ++i)
+    {
+      fail_if (1 != timers[i].nticks);
+      fail_if (pthread_equal (pthread_self (), timers[i].thread));
+    }
+
+  /* The watchers of an owner share a loop; bound owners get their own */
+  fail_if (!pthread_equal (timers[0].thread, timers[1].thread));
+  fail_if (pthread_equal (timers[0].thread, timers[2].thread));
+
+  tiz_event_loop_unbind (&handles[0]);
+  tiz_event_loop_unbind (&handles[1]);
+  tiz_event_loop_unbind (&handles[2]);
+
+  for (i = 0; i < CHECK_SHARDS_NTIMERS; ++i)
+    {
+      tiz_event_timer_destroy (timers[i].p_ev_timer);
+    }
+  tiz_event_loop_destroy ();
+  fail_if (0 != tiz_event_loop_shards ());
+}
+END_TEST
+
+START_TEST (test_event_loop_inline_ops)
+{
+  check_shards_timer_t timer;
+  int handle = 0;
+
+  memset (&timer, 0, sizeof (timer));
+  fail_if (OMX_ErrorNone
+           != tiz_event_timer_init (&timer.p_ev_timer, &handle,
+                                    check_shards_inline_cback, &timer));
+  tiz_event_timer_set (timer.p_ev_timer, 0.001, 0.001);
+  fail_if (OMX_ErrorNone != tiz_event_timer_start (timer.p_ev_timer, 1));
+
+  check_shards_wait (&timer, 1, CHECK_SHARDS_INLINE_NTICKS);
+  (void) tiz_sleep (50000);
+
+  /* The timer was stopped from its own callback; no tick after that */
+  fail_if (CHECK_SHARDS_INLINE_NTICKS != timer.nticks);
+  fail_if (NULL != timer.p_ev_timer);
+
+  tiz_event_loop_destroy ();
+}
+END_TEST
+
+START_TEST (test_event_loop_benchmark)
+{
+  check_shards_timer_t timer;
+  check_shards_timer_t sentinel;
+  tiz_event_timer_t * p_other = NULL;
+  struct timespec start;
+  double queued_ns = 0;
+  int handle = 0;
+  int i = 0;
+
+  memset (&timer, 0, sizeof (timer));
+  memset (&sentinel, 0, sizeof (sentinel));
+
+  /* From a thread other than the loop's, the requests are queued; the
+     sentinel fires once the loop has caught up with them */
+  fail_if (OMX_ErrorNone
+           != tiz_event_timer_init (&p_other, &handle,
+                                    check_shards_timer_cback, NULL));
+  fail_if (OMX_ErrorNone
+           != tiz_event_timer_init (&sentinel.p_ev_timer, &handle,
+                                    check_shards_timer_cback, &sentinel));
+  tiz_event_timer_set (p_other, 60., 0.);
+  tiz_event_timer_set (sentinel.p_ev_timer, 0., 0.);
+  (void) clock_gettime (CLOCK_MONOTONIC, &start);
+  for (i = 0; i < CHECK_SHARDS_BENCH_NOPS; ++i)
+    {
+      (void) tiz_event_timer_start (p_other, i + 1);
+      (void) tiz_event_timer_stop (p_other);
+    }
+  fail_if (OMX_ErrorNone != tiz_event_timer_start (sentinel.p_ev_timer, 1));
+  check_shards_wait (&sentinel, 1, 1);
+  queued_ns = check_bench_elapsed_ns (&start);
+  fail_if (1 != sentinel.nticks);
+
+  /* The same, from a callback running on the loop's thread: inline */
+  fail_if (OMX_ErrorNone
+           != tiz_event_timer_init (&timer.p_ev_timer, &handle,
+                                    check_shards_bench_cback, &timer));
+  tiz_event_timer_set (timer.p_ev_timer, 0., 0.);
+  fail_if (OMX_ErrorNone != tiz_event_timer_start (timer.p_ev_timer, 1));
+  check_shards_wait (&timer, 1, 1);
+  fail_if (1 != timer.nticks);
+
+  printf ("[%d timer start/stop pairs] queued: %.1f ns/pair - inline: %.1f "
+          "ns/pair\n",
+          CHECK_SHARDS_BENCH_NOPS, queued_ns / CHECK_SHARDS_BENCH_NOPS,
+          timer.elapsed_ns / CHECK_SHARDS_BENCH_NOPS);
+
+  tiz_event_timer_destroy (p_other);
+  tiz_event_timer_destroy (sentinel.p_ev_timer);
+  tiz_event_timer_destroy (timer.p_ev_timer);
+  tiz_event_loop_destroy ();
+}
+END_TEST
+
+START_TEST (test_event_loop_request_rings)
+{
+  check_shards_timer_t timer;
+  tiz_event_timer_t * p_other = NULL;
+  int nticks = 0;
+  int handle = 0;
+  int i = 0;
+
+  memset (&timer, 0, sizeof (timer));
+  fail_if (OMX_ErrorNone
+           != tiz_event_timer_init (&timer.p_ev_timer, &handle,
+                                    check_shards_timer_cback, &timer));
+  tiz_event_timer_set (timer.p_ev_timer, 0.001, 0.001);
+
+  /* Requests from this thread go through its ring, and overflow to the
+     queue; the last one wins */
+  for (i = 0; i < CHECK_SHARDS_BENCH_NOPS; ++i)
+    {
+      fail_if (OMX_ErrorNone
+               != tiz_event_timer_start (timer.p_ev_timer, i + 1));
+      fail_if (OMX_ErrorNone != tiz_event_timer_stop (timer.p_ev_timer));
+    }
+  fail_if (OMX_ErrorNone
+           != tiz_event_timer_start (timer.p_ev_timer,
+                                     CHECK_SHARDS_BENCH_NOPS + 1));
+  check_shards_wait (&timer, 1, 3);
+  fail_if (3 > timer.nticks);
+
+  /* The timer is already started; these need not reach the loop */
+  for (i = 0; i < CHECK_SHARDS_BENCH_NOPS; ++i)
+    {
+      fail_if (OMX_ErrorNone
+               != tiz_event_timer_start (timer.p_ev_timer,
+                                         CHECK_SHARDS_BENCH_NOPS + 2 + i));
+    }
+
+  fail_if (OMX_ErrorNone != tiz_event_timer_stop (timer.p_ev_timer));
+  for (i = 0; i < CHECK_SHARDS_BENCH_NOPS; ++i)
+    {
+      fail_if (OMX_ErrorNone != tiz_event_timer_stop (timer.p_ev_timer));
+    }
+
+  /* Once stopped, the timer stays stopped */
+  (void) tiz_sleep (20000);
+  nticks = timer.nticks;
+  (void) tiz_sleep (20000);
+  fail_if (nticks != timer.nticks);
+
+  /* A watcher may be destroyed with requests still in flight */
+  fail_if (OMX_ErrorNone
+           != tiz_event_timer_init (&p_other, &handle,
+                                    check_shards_timer_cback, NULL));
+  tiz_event_timer_set (p_other, 60., 0.);
+  for (i = 0; i < CHECK_SHARDS_BENCH_NOPS; ++i)
+    {
+      (void) tiz_event_timer_start (p_other, i + 1);
+      (void) tiz_event_timer_stop (p_other);
+    }
+  tiz_event_timer_destroy (p_other);
+
+  tiz_event_timer_destroy (timer.p_ev_timer);
+  tiz_event_loop_destroy ();
+}
+END_TEST
+
 /* Local Variables: */
 /* c-default-style: gnu */
 /* fill-column: 79 */
@@ -0,0 +1,258 @@
+/**
+ * Copyright (C) 2011-2020 Aratelia Limited - Juan A. Rubio and contributors
+ *
+ * This file is part of Tizonia
+ *
+ * Tizonia is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Tizonia is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Tizonia.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file   check_hmap.c
+ * @author Juan A. Rubio <juan.rubio@aratelia.com>
+ *
+ * @brief  Hash map API unit tests and micro-benchmark
+ *
+ *
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+
+#define HMAP_TEST_NITEMS 5000
+#define HMAP_BENCH_NKEYS 64
+#define HMAP_BENCH_ROUNDS 20000
+
+static OMX_U32 g_hmap_freed = 0;
+
+static void
+check_hmap_free_f (uintptr_t a_key, OMX_PTR ap_value)
+{
+  fail_if ((uintptr_t) ap_value != a_key + 1);
+  g_hmap_freed++;
+}
+
+static OMX_S32
+check_hmap_ptr_cmp_f (OMX_PTR ap_key1, OMX_PTR ap_key2)
+{
+  return (ap_key1 == ap_key2) ? 0 : ((ap_key1 < ap_key2) ? -1 : 1);
+}
+
+static void
+check_hmap_map_free_f (OMX_PTR ap_key, OMX_PTR ap_value)
+{
+}
+
+START_TEST (test_hmap_init_and_destroy)
+{
+  tiz_hmap_t *p_map = NULL;
+
+  fail_if (OMX_ErrorNone != tiz_hmap_init (&p_map, 0, NULL));
+  fail_if (!tiz_hmap_empty (p_map));
+  fail_if (0 != tiz_hmap_size (p_map));
+  fail_if (NULL != tiz_hmap_find (p_map, 0));
+  fail_if (tiz_hmap_contains (p_map, 0));
+  tiz_hmap_destroy (p_map);
+  tiz_hmap_destroy (NULL);
+}
+END_TEST
+
+START_TEST (test_hmap_insert_find_erase)
+{
+  tiz_hmap_t *p_map = NULL;
+  uintptr_t i = 0;
+
+  g_hmap_freed = 0;
+  fail_if (OMX_ErrorNone != tiz_hmap_init (&p_map, 4, check_hmap_free_f));
+
+  /* Key zero is a valid key; the map grows well beyond the initial hint */
+  for (i = 0; i < HMAP_TEST_NITEMS; ++i)
+    {
+      fail_if (OMX_ErrorNone
+               != tiz_hmap_insert (p_map, i * 8, (OMX_PTR) (i * 8 + 1)));
+    }
+  fail_if (HMAP_TEST_NITEMS != tiz_hmap_size (p_map));
+  fail_if (OMX_ErrorBadParameter
+           != tiz_hmap_insert (p_map, 16, (OMX_PTR) (uintptr_t) 17));
+  fail_if (HMAP_TEST_NITEMS != tiz_hmap_size (p_map));
+
+  for (i = 0; i < HMAP_TEST_NITEMS; ++i)
+    {
+      fail_if ((OMX_PTR) (i * 8 + 1) != tiz_hmap_find (p_map, i * 8));
+      fail_if (tiz_hmap_contains (p_map, i * 8 + 4));
+    }
+
+  /* Remove every other item; the rest must still be reachable */
+  for (i = 0; i < HMAP_TEST_NITEMS; i += 2)
+    {
+      tiz_hmap_erase (p_map, i * 8);
+    }
+  tiz_hmap_erase (p_map, 3);
+  fail_if (HMAP_TEST_NITEMS / 2 != g_hmap_freed);
+  fail_if (HMAP_TEST_NITEMS - HMAP_TEST_NITEMS / 2 != tiz_hmap_size (p_map));
+
+  for (i = 0; i < HMAP_TEST_NITEMS; ++i)
+    {
+      fail_if (tiz_hmap_contains (p_map, i * 8) != (i % 2 == 1));
+    }
+
+  tiz_hmap_destroy (p_map);
+  fail_if (HMAP_TEST_NITEMS != g_hmap_freed);
+}
+END_TEST
+
+START_TEST (test_hmap_iterate_and_clear)
+{
+  tiz_hmap_t *p_map = NULL;
+  tiz_hmap_iter_t iter;
+  uintptr_t key = 0;
+  OMX_PTR p_value = NULL;
+  OMX_U8 seen[HMAP_TEST_NITEMS];
+  OMX_U32 count = 0;
+  uintptr_t i = 0;
+
+  g_hmap_freed = 0;
+  memset (seen, 0, sizeof (seen));
+  fail_if (OMX_ErrorNone != tiz_hmap_init (&p_map, 0, check_hmap_free_f));
+
+  tiz_hmap_iter_init (p_map, &iter);
+  fail_if (tiz_hmap_iter_next (&iter, &key, &p_value));
+
+  for (i = 0; i < HMAP_TEST_NITEMS; ++i)
+    {
+      fail_if (OMX_ErrorNone
+               != tiz_hmap_insert (p_map, i, (OMX_PTR) (i + 1)));
+    }
+
+  tiz_hmap_iter_init (p_map, &iter);
+  while (tiz_hmap_iter_next (&iter, &key, &p_value))
+    {
+      fail_if (key >= HMAP_TEST_NITEMS);
+      fail_if ((OMX_PTR) (key + 1) != p_value);
+      fail_if (seen[key]);
+      seen[key] = 1;
+      count++;
+    }
+  fail_if (HMAP_TEST_NITEMS != count);
+
+  tiz_hmap_clear (p_map);
+  fail_if (HMAP_TEST_NITEMS != g_hmap_freed);
+  fail_if (!tiz_hmap_empty (p_map));
+  fail_if (tiz_hmap_contains (p_map, 1));
+
+  /* The map is still usable after a clear */
+  fail_if (OMX_ErrorNone != tiz_hmap_insert (p_map, 1, (OMX_PTR) 2));
+  fail_if ((OMX_PTR) 2 != tiz_hmap_find (p_map, 1));
+
+  tiz_hmap_destroy (p_map);
+  fail_if (HMAP_TEST_NITEMS + 1 != g_hmap_freed);
+}
+END_TEST
+
+START_TEST (test_hmap_benchmark)
+{
+  tiz_hmap_t *p_hmap = NULL;
+  tiz_map_t *p_map = NULL;
+  OMX_PTR keys[HMAP_BENCH_NKEYS];
+  struct timespec start;
+  double hmap_ns = 0;
+  double map_ns = 0;
+  const double nops = (double) HMAP_BENCH_NKEYS * HMAP_BENCH_ROUNDS;
+  OMX_U32 index = 0;
+  uintptr_t sum = 0;
+  int r = 0;
+  int i = 0;
+
+  /* Pointer keys, as with the servant watcher maps */
+  for (i = 0; i < HMAP_BENCH_NKEYS; ++i)
+    {
+      keys[i] = tiz_mem_alloc (32);
+      fail_if (NULL == keys[i]);
+    }
+
+  fail_if (OMX_ErrorNone != tiz_hmap_init (&p_hmap, 0, NULL));
+  fail_if (OMX_ErrorNone != tiz_map_init (&p_map, check_hmap_ptr_cmp_f,
+                                          check_hmap_map_free_f, NULL));
+
+  /* Each round inserts, looks up, walks and erases all the keys */
+  (void) clock_gettime (CLOCK_MONOTONIC, &start);
+  for (r = 0; r < HMAP_BENCH_ROUNDS; ++r)
+    {
+      tiz_hmap_iter_t iter;
+      OMX_PTR p_value = NULL;
+      for (i = 0; i < HMAP_BENCH_NKEYS; ++i)
+        {
+          fail_if (OMX_ErrorNone
+                   != tiz_hmap_insert (p_hmap, (uintptr_t) keys[i], keys[i]));
+        }
+      for (i = 0; i < HMAP_BENCH_NKEYS; ++i)
+        {
+          sum += (uintptr_t) tiz_hmap_find (p_hmap, (uintptr_t) keys[i]);
+        }
+      tiz_hmap_iter_init (p_hmap, &iter);
+      while (tiz_hmap_iter_next (&iter, NULL, &p_value))
+        {
+          sum += (uintptr_t) p_value;
+        }
+      for (i = 0; i < HMAP_BENCH_NKEYS; ++i)
+        {
+          tiz_hmap_erase (p_hmap, (uintptr_t) keys[i]);
+        }
+    }
+  hmap_ns = check_bench_elapsed_ns (&start);
+
+  (void) clock_gettime (CLOCK_MONOTONIC, &start);
+  for (r = 0; r < HMAP_BENCH_ROUNDS; ++r)
+    {
+      for (i = 0; i < HMAP_BENCH_NKEYS; ++i)
+        {
+          fail_if (OMX_ErrorNone
+                   != tiz_map_insert (p_map, keys[i], keys[i], &index));
+        }
+      for (i = 0; i < HMAP_BENCH_NKEYS; ++i)
+        {
+          sum -= (uintptr_t) tiz_map_find (p_map, keys[i]);
+        }
+      for (i = 0; i < HMAP_BENCH_NKEYS; ++i)
+        {
+          sum -= (uintptr_t) tiz_map_value_at (p_map, i);
+        }
+      for (i = 0; i < HMAP_BENCH_NKEYS; ++i)
+        {
+          tiz_map_erase (p_map, keys[i]);
+        }
+    }
+  map_ns = check_bench_elapsed_ns (&start);
+
+  fail_if (0 != sum);
+
+  printf ("[%d keys, %.0f ops] tiz_map: %.1f ns/op - tiz_hmap: %.1f ns/op\n",
+          HMAP_BENCH_NKEYS, nops * 4, map_ns / (nops * 4),
+          hmap_ns / (nops * 4));
+
+  tiz_hmap_destroy (p_hmap);
+  tiz_map_destroy (p_map);
+  for (i = 0; i < HMAP_BENCH_NKEYS; ++i)
+    {
+      tiz_mem_free (keys[i]);
+    }
+}
+END_TEST
+
+/* Local Variables: */
+/* c-default-style: gnu */
+/* fill-column: 79 */
+/* indent-tabs-mode: nil */
+/* compile-command: "make check" */
+/* End: */
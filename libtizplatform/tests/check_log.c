@@ -0,0 +1,268 @@
+/**
+ * Copyright (C) 2011-2020 Aratelia Limited - Juan A. Rubio and contributors
+ *
+ * This file is part of Tizonia
+ *
+ * Tizonia is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Tizonia is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Tizonia.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file   check_log.c
+ * @author Juan A. Rubio <juan.rubio@aratelia.com>
+ *
+ * @brief  Logging macros and asynchronous logging unit tests and
+ * micro-benchmarks
+ *
+ *
+ */
+
+#include <pthread.h>
+#include <stdio.h>
+#include <time.h>
+
+#define LOG_BENCH_NCALLS 10000000
+#define LOG_ASYNC_NTHREADS 4
+#define LOG_ASYNC_NRECORDS 2000
+#define LOG_ASYNC_BENCH_NRECORDS 20000
+
+static int g_log_nargs = 0;
+
+static int
+check_log_arg (void)
+{
+  return ++g_log_nargs;
+}
+
+static bool
+check_log_trace_enabled (void)
+{
+  return log4c_category_is_priority_enabled (
+    log4c_category_get (TIZ_LOG_CATEGORY_NAME), TIZ_PRIORITY_TRACE);
+}
+
+/* Trace statements in the following functions are compiled out */
+#undef TIZ_LOG_MIN_LEVEL
+#define TIZ_LOG_MIN_LEVEL TIZ_PRIORITY_DEBUG
+
+static void
+check_log_compiled_out (int a_ncalls)
+{
+  int i = 0;
+  for (i = 0; i < a_ncalls; ++i)
+    {
+      TIZ_LOG (TIZ_PRIORITY_TRACE, "compiled out [%d]", check_log_arg ());
+    }
+}
+
+#undef TIZ_LOG_MIN_LEVEL
+#define TIZ_LOG_MIN_LEVEL TIZ_PRIORITY_TRACE
+
+static void
+check_log_cached (int a_ncalls)
+{
+  int i = 0;
+  for (i = 0; i < a_ncalls; ++i)
+    {
+      TIZ_LOG (TIZ_PRIORITY_TRACE, "cached [%d]", check_log_arg ());
+    }
+}
+
+static void
+check_log_uncached (int a_ncalls)
+{
+  int i = 0;
+  for (i = 0; i < a_ncalls; ++i)
+    {
+      tiz_log (__FILE__, __LINE__, __FUNCTION__, TIZ_LOG_CATEGORY_NAME,
+               TIZ_PRIORITY_TRACE, NULL, NULL, "uncached [%d]",
+               check_log_arg ());
+    }
+}
+
+START_TEST (test_log_args_evaluation)
+{
+  const int expected = check_log_trace_enabled () ? 3 : 0;
+
+  g_log_nargs = 0;
+  check_log_compiled_out (3);
+  fail_if (0 != g_log_nargs);
+
+  /* The arguments are only evaluated when the statement is enabled */
+  check_log_cached (3);
+  fail_if (expected != g_log_nargs);
+
+  /* Re-initialising the log configuration refreshes the cached sites */
+  g_log_nargs = 0;
+  tiz_log_deinit ();
+  tiz_log_init ();
+  check_log_cached (3);
+  fail_if ((check_log_trace_enabled () ? 3 : 0) != g_log_nargs);
+
+  /* Errors are never compiled out */
+  TIZ_LOG (TIZ_PRIORITY_ERROR, "error statements are kept");
+}
+END_TEST
+
+START_TEST (test_log_benchmark)
+{
+  struct timespec start;
+  double uncached_ns = 0;
+  double cached_ns = 0;
+  double compiled_out_ns = 0;
+
+  if (check_log_trace_enabled ())
+    {
+      printf ("Trace priority enabled in [%s]; skipping log benchmark\n",
+              TIZ_LOG_CATEGORY_NAME);
+      return;
+    }
+
+  (void) clock_gettime (CLOCK_MONOTONIC, &start);
+  check_log_uncached (LOG_BENCH_NCALLS);
+  uncached_ns = check_bench_elapsed_ns (&start);
+
+  (void) clock_gettime (CLOCK_MONOTONIC, &start);
+  check_log_cached (LOG_BENCH_NCALLS);
+  cached_ns = check_bench_elapsed_ns (&start);
+
+  (void) clock_gettime (CLOCK_MONOTONIC, &start);
+  check_log_compiled_out (LOG_BENCH_NCALLS);
+  compiled_out_ns = check_bench_elapsed_ns (&start);
+
+  printf ("[%d disabled trace calls] tiz_log: %.2f ns/call - TIZ_LOG: %.2f "
+          "ns/call - compiled out: %.2f ns/call\n",
+          LOG_BENCH_NCALLS, uncached_ns / LOG_BENCH_NCALLS,
+          cached_ns / LOG_BENCH_NCALLS, compiled_out_ns / LOG_BENCH_NCALLS);
+}
+END_TEST
+
+static void
+check_log_async_record (tiz_log_site_t * ap_site, int a_i)
+{
+  /* A deferred format, and one the writer can't defer (%s) */
+  tiz_log_at (ap_site, __FILE__, __LINE__, __FUNCTION__, TIZ_PRIORITY_TRACE,
+              NULL, NULL, "record [%d] [%lu] [%.2f] [%p] [%%]", a_i,
+              (unsigned long) a_i * 2, a_i / 3.0, (void *) ap_site);
+  tiz_log_at (ap_site, __FILE__, __LINE__, __FUNCTION__, TIZ_PRIORITY_TRACE,
+              "component.name", NULL, "record [%d] [%s]", a_i, "string");
+}
+
+static void *
+check_log_async_thread_func (void * ap_arg)
+{
+  tiz_log_site_t * p_site = ap_arg;
+  int i = 0;
+  for (i = 0; i < LOG_ASYNC_NRECORDS / 2; ++i)
+    {
+      check_log_async_record (p_site, i);
+    }
+  return NULL;
+}
+
+static void
+check_log_async_run (tiz_log_overflow_t a_overflow,
+                     unsigned long long * ap_written,
+                     unsigned long long * ap_dropped)
+{
+  static tiz_log_site_t site = {NULL, 0, 0};
+  pthread_t threads[LOG_ASYNC_NTHREADS];
+  unsigned long long written = 0;
+  unsigned long long dropped = 0;
+  int i = 0;
+
+  (void) tiz_log_site_refresh (&site, TIZ_LOG_CATEGORY_NAME);
+  tiz_log_async_stats (&written, &dropped);
+
+  fail_if (0 != tiz_log_async_start (16, a_overflow));
+  fail_if (!tiz_log_async_enabled ());
+  for (i = 0; i < LOG_ASYNC_NTHREADS; ++i)
+    {
+      fail_if (0 != pthread_create (&threads[i], NULL,
+                                    check_log_async_thread_func, &site));
+    }
+  for (i = 0; i < LOG_ASYNC_NTHREADS; ++i)
+    {
+      fail_if (0 != pthread_join (threads[i], NULL));
+    }
+  fail_if (0 != tiz_log_async_stop ());
+  fail_if (tiz_log_async_enabled ());
+
+  tiz_log_async_stats (ap_written, ap_dropped);
+  *ap_written -= written;
+  *ap_dropped -= dropped;
+}
+
+START_TEST (test_log_async_overflow)
+{
+  unsigned long long written = 0;
+  unsigned long long dropped = 0;
+
+  /* Every record is either written or counted as dropped */
+  check_log_async_run (TIZ_LOG_OVERFLOW_DROP, &written, &dropped);
+  fail_if (LOG_ASYNC_NTHREADS * LOG_ASYNC_NRECORDS != written + dropped);
+
+  /* No record is lost when the producers wait for the writer */
+  check_log_async_run (TIZ_LOG_OVERFLOW_BLOCK, &written, &dropped);
+  fail_if (LOG_ASYNC_NTHREADS * LOG_ASYNC_NRECORDS != written);
+  fail_if (0 != dropped);
+
+  /* Stopping twice is harmless */
+  fail_if (0 != tiz_log_async_stop ());
+}
+END_TEST
+
+START_TEST (test_log_async_benchmark)
+{
+  tiz_log_site_t site = {NULL, 0, 0};
+  struct timespec start;
+  unsigned long long dropped = 0;
+  double sync_ns = 0;
+  double async_ns = 0;
+  int i = 0;
+
+  (void) tiz_log_site_refresh (&site, TIZ_LOG_CATEGORY_NAME);
+
+  (void) clock_gettime (CLOCK_MONOTONIC, &start);
+  for (i = 0; i < LOG_ASYNC_BENCH_NRECORDS / 2; ++i)
+    {
+      check_log_async_record (&site, i);
+    }
+  sync_ns = check_bench_elapsed_ns (&start);
+
+  fail_if (0 != tiz_log_async_start (LOG_ASYNC_BENCH_NRECORDS,
+                                     TIZ_LOG_OVERFLOW_DROP));
+  (void) clock_gettime (CLOCK_MONOTONIC, &start);
+  for (i = 0; i < LOG_ASYNC_BENCH_NRECORDS / 2; ++i)
+    {
+      check_log_async_record (&site, i);
+    }
+  async_ns = check_bench_elapsed_ns (&start);
+  fail_if (0 != tiz_log_async_stop ());
+  tiz_log_async_stats (NULL, &dropped);
+
+  printf ("[%d records, trace %s] sync: %.1f ns/record - async: %.1f "
+          "ns/record (%llu dropped)\n",
+          LOG_ASYNC_BENCH_NRECORDS,
+          check_log_trace_enabled () ? "enabled" : "disabled",
+          sync_ns / LOG_ASYNC_BENCH_NRECORDS,
+          async_ns / LOG_ASYNC_BENCH_NRECORDS, dropped);
+}
+END_TEST
+
+/* Local Variables: */
+/* c-default-style: gnu */
+/* fill-column: 79 */
+/* indent-tabs-mode: nil */
+/* compile-command: "make check" */
+/* End: */
@@ -26,6 +26,8 @@
  *
  */
 
+#include <pthread.h>
+
 START_TEST (test_mem_alloc_and_free)
 {
 
@@ -39,6 +41,217 @@ START_TEST (test_mem_alloc_and_free)
 }
 END_TEST
 
+START_TEST (test_mem_small_objects)
+{
+  tiz_soa_t *p_soa = tiz_soa_shared ();
+  char *p_small = NULL;
+  char *p_large = NULL;
+  char *p_str = NULL;
+  int i = 0;
+  const tiz_mem_backend_type_t initial = tiz_mem_get_backend ();
+
+  fail_if (NULL == p_soa);
+  fail_if (OMX_ErrorNone
+           != tiz_mem_set_backend (ETIZMemBackendDefault, NULL));
+
+  /* Small requests come from the shared allocator, large ones don't */
+  p_small = tiz_mem_calloc (4, 8);
+  fail_if (NULL == p_small);
+  fail_if (!tiz_soa_owns (p_soa, p_small));
+  for (i = 0; i < 32; i++)
+    {
+      fail_if (0 != p_small[i]);
+      p_small[i] = (char) i;
+    }
+
+  p_large = tiz_mem_alloc (TIZ_SOA_MAX_OBJECT_SIZE + 1);
+  fail_if (NULL == p_large);
+  fail_if (tiz_soa_owns (p_soa, p_large));
+  tiz_mem_free (p_large);
+
+  /* Growing an object moves it out of the shared allocator when needed */
+  p_small = tiz_mem_realloc (p_small, 16 * 1024);
+  fail_if (NULL == p_small);
+  fail_if (tiz_soa_owns (p_soa, p_small));
+  for (i = 0; i < 32; i++)
+    {
+      fail_if ((char) i != p_small[i]);
+    }
+  tiz_mem_free (p_small);
+
+  /* Memory from the C library may still be released here */
+  p_str = strndup ("tizonia", 7);
+  fail_if (NULL == p_str);
+  fail_if (tiz_soa_owns (p_soa, p_str));
+  tiz_mem_free (p_str);
+  tiz_mem_free (NULL);
+
+  fail_if (OMX_ErrorNone != tiz_mem_set_backend (initial, NULL));
+}
+END_TEST
+
+static void *
+check_mem_release_thread (void *ap_arg)
+{
+  void **pp_mem = ap_arg;
+  tiz_mem_free (pp_mem[0]);
+  tiz_mem_free (pp_mem[1]);
+  return NULL;
+}
+
+START_TEST (test_mem_accounts)
+{
+  tiz_mem_account_t *p_account = NULL;
+  tiz_mem_account_t *p_prev = NULL;
+  tiz_mem_account_info_t info;
+  void *p_mem[2] = {NULL, NULL};
+  void *p_refused = NULL;
+  char *p_str = NULL;
+  pthread_t thread;
+  const tiz_mem_backend_type_t initial = tiz_mem_get_backend ();
+
+  fail_if (OMX_ErrorNone
+           != tiz_mem_set_backend (ETIZMemBackendDefault, NULL));
+  fail_if (OMX_ErrorNone != tiz_mem_account_init (&p_account));
+
+  /* What the thread allocates is charged to its current account */
+  p_prev = tiz_mem_account_swap (p_account);
+  p_mem[0] = tiz_mem_alloc (100);
+  p_mem[1] = tiz_mem_calloc (1, 64 * 1024);
+  fail_if (NULL == p_mem[0] || NULL == p_mem[1]);
+  fail_if (p_account != tiz_mem_account_swap (p_prev));
+
+  /* ...but not memory allocated elsewhere */
+  p_str = strndup ("tizonia", 7);
+  fail_if (NULL == p_str);
+  tiz_mem_free (p_str);
+
+  tiz_mem_account_info (p_account, &info);
+  fail_if (2 != info.allocs);
+  fail_if (0 != info.frees);
+  fail_if (info.bytes < 100 + 64 * 1024);
+  fail_if (info.bytes > 128 + 64 * 1024);
+  fail_if (info.peak_bytes != info.bytes);
+
+  /* Growing a block keeps it on the same account */
+  p_mem[1] = tiz_mem_realloc (p_mem[1], 128 * 1024);
+  fail_if (NULL == p_mem[1]);
+  tiz_mem_account_info (p_account, &info);
+  fail_if (info.bytes < 100 + 128 * 1024);
+  fail_if (2 != info.allocs);
+
+  /* A limit makes the allocations that would exceed it fail */
+  tiz_mem_account_set_limit (p_account, info.bytes + 1024);
+  p_prev = tiz_mem_account_swap (p_account);
+  p_refused = tiz_mem_alloc (2048);
+  fail_if (NULL != p_refused);
+  fail_if (NULL != tiz_mem_realloc (p_mem[1], 256 * 1024));
+  (void) tiz_mem_account_swap (p_prev);
+  tiz_mem_account_info (p_account, &info);
+  fail_if (2 != info.failures);
+  fail_if (2 != info.allocs);
+
+  /* Releasing the memory from another thread credits the account it was
+     charged to; the account outlives its owner until then */
+  tiz_mem_account_reset (p_account);
+  tiz_mem_account_info (p_account, &info);
+  fail_if (0 != info.allocs || 0 != info.failures);
+  fail_if (info.peak_bytes != info.bytes);
+  fail_if (0 != pthread_create (&thread, NULL, check_mem_release_thread,
+                                p_mem));
+  fail_if (0 != pthread_join (thread, NULL));
+  tiz_mem_account_info (p_account, &info);
+  fail_if (0 != info.bytes);
+  fail_if (2 != info.frees);
+
+  p_prev = tiz_mem_account_swap (p_account);
+  p_mem[0] = tiz_mem_alloc (10);
+  fail_if (NULL == p_mem[0]);
+  (void) tiz_mem_account_swap (p_prev);
+  tiz_mem_account_destroy (p_account);
+  tiz_mem_free (p_mem[0]);
+
+  fail_if (OMX_ErrorNone != tiz_mem_set_backend (initial, NULL));
+}
+END_TEST
+
+static size_t check_mem_custom_allocs = 0;
+
+static void *
+check_mem_custom_alloc (void *ap_arg, size_t a_size)
+{
+  check_mem_custom_allocs++;
+  return malloc (a_size);
+}
+
+static void
+check_mem_custom_free (void *ap_arg, void *ap_ptr)
+{
+  free (ap_ptr);
+}
+
+START_TEST (test_mem_backends)
+{
+  const tiz_mem_backend_t custom
+    = {check_mem_custom_alloc, check_mem_custom_free, NULL};
+  const tiz_mem_backend_type_t initial = tiz_mem_get_backend ();
+  tiz_soa_t *p_soa = tiz_soa_shared ();
+  OMX_U32 nlive = 0;
+  char *p_small = NULL;
+  char *p_large = NULL;
+  char *p_debug = NULL;
+  int i = 0;
+
+  fail_if (ETIZMemBackendCustom == initial);
+  fail_if (OMX_ErrorNone
+           != tiz_mem_set_backend (ETIZMemBackendDefault, NULL));
+
+  p_small = tiz_mem_alloc (32);
+  fail_if (NULL == p_small);
+
+  /* Too late for a custom backend */
+  fail_if (OMX_ErrorIncorrectStateOperation
+           != tiz_mem_set_backend (ETIZMemBackendCustom, &custom));
+  fail_if (OMX_ErrorBadParameter
+           != tiz_mem_set_backend (ETIZMemBackendCustom, NULL));
+  fail_if (0 != check_mem_custom_allocs);
+
+  /* The debug backend keeps a record of its allocations, and fills fresh
+     memory with garbage */
+  fail_if (OMX_ErrorNone
+           != tiz_mem_set_backend (ETIZMemBackendDebug, NULL));
+  fail_if (ETIZMemBackendDebug != tiz_mem_get_backend ());
+  nlive = tiz_mem_debug_report (false);
+  p_debug = tiz_mem_alloc (40);
+  fail_if (NULL == p_debug);
+  fail_if (NULL != p_soa && tiz_soa_owns (p_soa, p_debug));
+  fail_if (0 == p_debug[0] && 0 == p_debug[39]);
+  fail_if (nlive + 1 != tiz_mem_debug_report (false));
+  for (i = 0; i < 40; i++)
+    {
+      p_debug[i] = (char) i;
+    }
+  p_debug = tiz_mem_realloc (p_debug, 4000);
+  fail_if (NULL == p_debug);
+  for (i = 0; i < 40; i++)
+    {
+      fail_if ((char) i != p_debug[i]);
+    }
+  fail_if (nlive + 1 != tiz_mem_debug_report (false));
+
+  /* Memory from the other backends may be released at any time */
+  tiz_mem_free (p_small);
+  p_large = tiz_mem_calloc (1, 8192);
+  fail_if (NULL == p_large);
+  fail_if (0 != p_large[8191]);
+
+  fail_if (OMX_ErrorNone != tiz_mem_set_backend (initial, NULL));
+  tiz_mem_free (p_debug);
+  tiz_mem_free (p_large);
+  fail_if (nlive != tiz_mem_debug_report (false));
+}
+END_TEST
+
 /* Local Variables: */
 /* c-default-style: gnu */
 /* fill-column: 79 */
@@ -0,0 +1,263 @@
+/**
+ * Copyright (C) 2011-2020 Aratelia Limited - Juan A. Rubio and contributors
+ *
+ * This file is part of Tizonia
+ *
+ * Tizonia is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Tizonia is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Tizonia.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file   check_mpscq.c
+ * @author Juan A. Rubio <juan.rubio@aratelia.com>
+ *
+ * @brief  Lock-free MPSC queue API unit tests and micro-benchmark
+ *
+ *
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+
+#define MPSCQ_TEST_PRODUCERS 4
+#define MPSCQ_TEST_ITEMS_PER_PRODUCER 20000
+#define MPSCQ_BENCH_ITEMS_PER_PRODUCER 200000
+#define MPSCQ_BENCH_CAPACITY 30
+
+typedef OMX_ERRORTYPE (*mpscq_test_send_f) (void * ap_q, OMX_PTR ap_data);
+typedef OMX_ERRORTYPE (*mpscq_test_recv_f) (void * ap_q, OMX_PTR * app_data);
+
+typedef struct mpscq_test_producer mpscq_test_producer_t;
+struct mpscq_test_producer
+{
+  void * p_q;
+  mpscq_test_send_f pf_send;
+  uintptr_t first;
+  uintptr_t nitems;
+};
+
+static OMX_ERRORTYPE
+mpscq_test_queue_send (void * ap_q, OMX_PTR ap_data)
+{
+  return tiz_queue_send (ap_q, ap_data);
+}
+
+static OMX_ERRORTYPE
+mpscq_test_queue_receive (void * ap_q, OMX_PTR * app_data)
+{
+  return tiz_queue_receive (ap_q, app_data);
+}
+
+static OMX_ERRORTYPE
+mpscq_test_mpscq_send (void * ap_q, OMX_PTR ap_data)
+{
+  return tiz_mpscq_send (ap_q, ap_data);
+}
+
+static OMX_ERRORTYPE
+mpscq_test_mpscq_receive (void * ap_q, OMX_PTR * app_data)
+{
+  return tiz_mpscq_receive (ap_q, app_data);
+}
+
+static void *
+mpscq_test_producer_func (void * ap_arg)
+{
+  mpscq_test_producer_t * p_prod = ap_arg;
+  uintptr_t i = 0;
+  for (i = 0; i < p_prod->nitems; ++i)
+    {
+      /* Items are never NULL */
+      if (OMX_ErrorNone
+          != p_prod->pf_send (p_prod->p_q, (OMX_PTR) (p_prod->first + i + 1)))
+        {
+          return (void *) 1;
+        }
+    }
+  return NULL;
+}
+
+/* Runs MPSCQ_TEST_PRODUCERS producers against one consumer, checks that every
+   item has been received exactly once and in per-producer FIFO order, and
+   returns the elapsed time in nanoseconds. */
+static double
+mpscq_test_run (void * ap_q, mpscq_test_send_f apf_send,
+                mpscq_test_recv_f apf_recv, uintptr_t a_items_per_producer)
+{
+  tiz_thread_t threads[MPSCQ_TEST_PRODUCERS];
+  mpscq_test_producer_t producers[MPSCQ_TEST_PRODUCERS];
+  uintptr_t last[MPSCQ_TEST_PRODUCERS];
+  const uintptr_t total = a_items_per_producer * MPSCQ_TEST_PRODUCERS;
+  struct timespec start;
+  uintptr_t i = 0;
+  int j = 0;
+
+  (void) clock_gettime (CLOCK_MONOTONIC, &start);
+
+  for (j = 0; j < MPSCQ_TEST_PRODUCERS; ++j)
+    {
+      producers[j].p_q = ap_q;
+      producers[j].pf_send = apf_send;
+      producers[j].first = j * a_items_per_producer;
+      producers[j].nitems = a_items_per_producer;
+      last[j] = 0;
+      fail_if (OMX_ErrorNone
+               != tiz_thread_create (&threads[j], 0, 0,
+                                     mpscq_test_producer_func, &producers[j]));
+    }
+
+  for (i = 0; i < total; ++i)
+    {
+      OMX_PTR p_data = NULL;
+      uintptr_t item = 0;
+      uintptr_t prod = 0;
+      fail_if (OMX_ErrorNone != apf_recv (ap_q, &p_data));
+      fail_if (NULL == p_data);
+      item = (uintptr_t) p_data - 1;
+      prod = item / a_items_per_producer;
+      fail_if (prod >= MPSCQ_TEST_PRODUCERS);
+      fail_if (item + 1 != producers[prod].first + last[prod] + 1);
+      last[prod]++;
+    }
+
+  for (j = 0; j < MPSCQ_TEST_PRODUCERS; ++j)
+    {
+      void * p_result = NULL;
+      tiz_thread_join (&threads[j], &p_result);
+      fail_if (p_result != NULL);
+      fail_if (last[j] != a_items_per_producer);
+    }
+
+  return check_bench_elapsed_ns (&start);
+}
+
+START_TEST (test_mpscq_init_and_destroy)
+{
+  OMX_ERRORTYPE error = OMX_ErrorNone;
+  tiz_mpscq_t *p_queue = NULL;
+
+  error = tiz_mpscq_init (&p_queue, 10);
+
+  fail_if (error != OMX_ErrorNone);
+  fail_if (tiz_mpscq_capacity (p_queue) != 16);
+  fail_if (tiz_mpscq_length (p_queue) != 0);
+
+  tiz_mpscq_destroy (p_queue);
+}
+END_TEST
+
+START_TEST (test_mpscq_send_and_receive)
+{
+  OMX_U32 i;
+  OMX_PTR p_received = NULL;
+  OMX_ERRORTYPE error = OMX_ErrorNone;
+  int *p_item = NULL;
+  tiz_mpscq_t *p_queue = NULL;
+
+  error = tiz_mpscq_init (&p_queue, 16);
+  fail_if (error != OMX_ErrorNone);
+
+  for (i = 0; i < 16; i++)
+    {
+      p_item = (int *) tiz_mem_alloc (sizeof (int));
+      fail_if (p_item == NULL);
+      *p_item = i;
+      error = tiz_mpscq_send (p_queue, p_item);
+      fail_if (error != OMX_ErrorNone);
+    }
+
+  fail_if (16 != tiz_mpscq_length (p_queue));
+
+  /* The queue is full now */
+  fail_if (OMX_ErrorNoMore != tiz_mpscq_try_send (p_queue, &i));
+
+  for (i = 0; i < 16; i++)
+    {
+      error = tiz_mpscq_receive (p_queue, &p_received);
+      fail_if (error != OMX_ErrorNone);
+      fail_if (p_received == NULL);
+      p_item = (int *) p_received;
+      fail_if (*p_item != i);
+      tiz_mem_free (p_received);
+    }
+
+  fail_if (0 != tiz_mpscq_length (p_queue));
+
+  /* Nothing left in the queue */
+  p_received = NULL;
+  fail_if (OMX_ErrorNoMore != tiz_mpscq_try_receive (p_queue, &p_received));
+  fail_if (p_received != NULL);
+  error = tiz_mpscq_timed_receive (p_queue, &p_received, 10);
+  fail_if (error != OMX_ErrorTimeout);
+  fail_if (p_received != NULL);
+
+  tiz_mpscq_destroy (p_queue);
+}
+END_TEST
+
+START_TEST (test_mpscq_multiple_producers)
+{
+  tiz_mpscq_t *p_queue = NULL;
+
+  /* Small capacity, so that producers have to park frequently */
+  fail_if (OMX_ErrorNone != tiz_mpscq_init (&p_queue, 4));
+
+  (void) mpscq_test_run (p_queue, mpscq_test_mpscq_send,
+                         mpscq_test_mpscq_receive,
+                         MPSCQ_TEST_ITEMS_PER_PRODUCER);
+
+  fail_if (0 != tiz_mpscq_length (p_queue));
+
+  tiz_mpscq_destroy (p_queue);
+}
+END_TEST
+
+START_TEST (test_mpscq_benchmark)
+{
+  tiz_queue_t *p_queue = NULL;
+  tiz_mpscq_t *p_mpscq = NULL;
+  const double nitems
+    = (double) MPSCQ_BENCH_ITEMS_PER_PRODUCER * MPSCQ_TEST_PRODUCERS;
+  double queue_ns = 0;
+  double mpscq_ns = 0;
+
+  fail_if (OMX_ErrorNone
+           != tiz_queue_init (&p_queue, MPSCQ_BENCH_CAPACITY));
+  fail_if (OMX_ErrorNone
+           != tiz_mpscq_init (&p_mpscq, MPSCQ_BENCH_CAPACITY));
+
+  queue_ns = mpscq_test_run (p_queue, mpscq_test_queue_send,
+                             mpscq_test_queue_receive,
+                             MPSCQ_BENCH_ITEMS_PER_PRODUCER);
+  mpscq_ns = mpscq_test_run (p_mpscq, mpscq_test_mpscq_send,
+                             mpscq_test_mpscq_receive,
+                             MPSCQ_BENCH_ITEMS_PER_PRODUCER);
+
+  printf ("[%d producers, %.0f msgs] tiz_queue: %.0f ns/msg (%.0f msgs/s) - "
+          "tiz_mpscq: %.0f ns/msg (%.0f msgs/s)\n",
+          MPSCQ_TEST_PRODUCERS, nitems, queue_ns / nitems,
+          nitems * 1e9 / queue_ns, mpscq_ns / nitems,
+          nitems * 1e9 / mpscq_ns);
+
+  tiz_queue_destroy (p_queue);
+  tiz_mpscq_destroy (p_mpscq);
+}
+END_TEST
+
+/* Local Variables: */
+/* c-default-style: gnu */
+/* fill-column: 79 */
+/* indent-tabs-mode: nil */
+/* compile-command: "make check" */
+/* End: */
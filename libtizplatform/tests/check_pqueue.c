@@ -452,6 +452,103 @@ START_TEST (test_pqueue_removep)
 }
 END_TEST
 
+START_TEST (test_pqueue_remove_handle)
+{
+  OMX_S32 i;
+  OMX_ERRORTYPE error = OMX_ErrorNone;
+  tiz_pqueue_t *p_queue = NULL;
+  tiz_pqueue_handle_t handles[10];
+  OMX_PTR p_received = NULL;
+  int items[10];
+
+  TIZ_LOG (TIZ_PRIORITY_TRACE, "test_pqueue_remove_handle");
+
+  error = tiz_pqueue_init (&p_queue, 4, &pqueue_cmp, NULL, "tizkrn");
+  fail_if (error != OMX_ErrorNone);
+
+  for (i = 0; i < 10; i++)
+    {
+      items[i] = i;
+      error = tiz_pqueue_send_with_handle (p_queue, &items[i], i % 5,
+                                           &handles[i]);
+      fail_if (error != OMX_ErrorNone);
+    }
+
+  /* Remove the first item of group 0, and the last one of group 4 */
+  error = tiz_pqueue_remove_handle (p_queue, &handles[0], &p_received);
+  fail_if (error != OMX_ErrorNone);
+  fail_if (p_received != &items[0]);
+  error = tiz_pqueue_remove_handle (p_queue, &handles[9], NULL);
+  fail_if (error != OMX_ErrorNone);
+  fail_if (tiz_pqueue_length (p_queue) != 8);
+
+  /* Stale handles are rejected, even once their nodes have been reused */
+  error = tiz_pqueue_remove_handle (p_queue, &handles[0], NULL);
+  fail_if (error != OMX_ErrorNoMore);
+  error = tiz_pqueue_send (p_queue, &items[0], 0);
+  fail_if (error != OMX_ErrorNone);
+  error = tiz_pqueue_remove_handle (p_queue, &handles[9], NULL);
+  fail_if (error != OMX_ErrorNoMore);
+  fail_if (tiz_pqueue_length (p_queue) != 9);
+
+  /* 5, 0, 1, 6, 2, 7, 3, 8, 4 */
+  {
+    const int expected[] = {5, 0, 1, 6, 2, 7, 3, 8, 4};
+    for (i = 0; i < 9; i++)
+      {
+        error = tiz_pqueue_receive (p_queue, &p_received);
+        fail_if (error != OMX_ErrorNone);
+        fail_if (*(int *) p_received != expected[i]);
+      }
+  }
+
+  error = tiz_pqueue_receive (p_queue, &p_received);
+  fail_if (error != OMX_ErrorNoMore);
+
+  tiz_pqueue_destroy (p_queue);
+}
+END_TEST
+
+START_TEST (test_pqueue_many_groups)
+{
+  const OMX_S32 max_prio = 150;
+  OMX_S32 i;
+  OMX_ERRORTYPE error = OMX_ErrorNone;
+  tiz_pqueue_t *p_queue = NULL;
+  OMX_PTR p_received = NULL;
+  int items[151];
+
+  TIZ_LOG (TIZ_PRIORITY_TRACE, "test_pqueue_many_groups");
+
+  error = tiz_pqueue_init (&p_queue, max_prio, &pqueue_cmp, NULL, "tizkrn");
+  fail_if (error != OMX_ErrorNone);
+
+  /* Groups spread over several bitmap words, sent in reverse order */
+  for (i = max_prio; i >= 0; i--)
+    {
+      items[i] = i;
+      error = tiz_pqueue_send (p_queue, &items[i], i);
+      fail_if (error != OMX_ErrorNone);
+    }
+
+  fail_if (tiz_pqueue_dump (p_queue, &pqueue_dump_item) != max_prio + 1);
+
+  for (i = 0; i <= max_prio; i++)
+    {
+      error = tiz_pqueue_first (p_queue, &p_received);
+      fail_if (error != OMX_ErrorNone);
+      fail_if (*(int *) p_received != i);
+      error = tiz_pqueue_receive (p_queue, &p_received);
+      fail_if (error != OMX_ErrorNone);
+      fail_if (*(int *) p_received != i);
+    }
+
+  fail_if (tiz_pqueue_length (p_queue) != 0);
+
+  tiz_pqueue_destroy (p_queue);
+}
+END_TEST
+
 /* Local Variables: */
 /* c-default-style: gnu */
 /* fill-column: 79 */
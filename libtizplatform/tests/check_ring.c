@@ -0,0 +1,210 @@
+/**
+ * Copyright (C) 2011-2020 Aratelia Limited - Juan A. Rubio and contributors
+ *
+ * This file is part of Tizonia
+ *
+ * Tizonia is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Tizonia is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Tizonia.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file   check_ring.c
+ * @author Juan A. Rubio <juan.rubio@aratelia.com>
+ *
+ * @brief  Ring buffer API unit tests and micro-benchmark
+ *
+ *
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+
+#define RING_TEST_NITEMS 1000
+#define RING_BENCH_NBUFS 16
+#define RING_BENCH_ROUNDS 200000
+
+START_TEST (test_ring_init_and_destroy)
+{
+  tiz_ring_t *p_ring = NULL;
+
+  fail_if (OMX_ErrorNone != tiz_ring_init (&p_ring, 0));
+  fail_if (0 != tiz_ring_length (p_ring));
+  fail_if (0 != tiz_ring_capacity (p_ring));
+  tiz_ring_destroy (p_ring);
+
+  fail_if (OMX_ErrorNone != tiz_ring_init (&p_ring, 8));
+  fail_if (8 != tiz_ring_capacity (p_ring));
+  fail_if (OMX_ErrorNone != tiz_ring_reserve (p_ring, 4));
+  fail_if (8 != tiz_ring_capacity (p_ring));
+  tiz_ring_destroy (p_ring);
+  tiz_ring_destroy (NULL);
+}
+END_TEST
+
+START_TEST (test_ring_push_erase_wraparound)
+{
+  tiz_ring_t *p_ring = NULL;
+  uintptr_t next_in = 0;
+  uintptr_t next_out = 0;
+  int i = 0;
+
+  fail_if (OMX_ErrorNone != tiz_ring_init (&p_ring, 4));
+
+  /* Items go round the array many times without the ring growing */
+  for (i = 0; i < RING_TEST_NITEMS; ++i)
+    {
+      while (tiz_ring_length (p_ring) < 3)
+        {
+          fail_if (OMX_ErrorNone
+                   != tiz_ring_push_back (p_ring, (OMX_PTR) next_in++));
+        }
+      fail_if ((OMX_PTR) next_out++ != tiz_ring_at (p_ring, 0));
+      tiz_ring_erase (p_ring, 0);
+    }
+  fail_if (4 != tiz_ring_capacity (p_ring));
+
+  /* Removing the last item */
+  fail_if ((OMX_PTR) (next_in - 1) != tiz_ring_at (p_ring, 1));
+  tiz_ring_erase (p_ring, 1);
+  fail_if (1 != tiz_ring_length (p_ring));
+  fail_if ((OMX_PTR) next_out != tiz_ring_at (p_ring, 0));
+
+  /* Growing a wrapped ring keeps the order */
+  for (i = 0; i < RING_TEST_NITEMS; ++i)
+    {
+      fail_if (OMX_ErrorNone
+               != tiz_ring_push_back (p_ring, (OMX_PTR) (next_out + 1 + i)));
+    }
+  fail_if (RING_TEST_NITEMS + 1 != tiz_ring_length (p_ring));
+  for (i = 0; i <= RING_TEST_NITEMS; ++i)
+    {
+      fail_if ((OMX_PTR) (next_out + i) != tiz_ring_at (p_ring, i));
+    }
+
+  tiz_ring_clear (p_ring);
+  fail_if (0 != tiz_ring_length (p_ring));
+  tiz_ring_destroy (p_ring);
+}
+END_TEST
+
+START_TEST (test_ring_erase_middle_and_append)
+{
+  tiz_ring_t *p_ring = NULL;
+  tiz_ring_t *p_other = NULL;
+  uintptr_t expected[] = {0, 2, 3, 5, 7, 100, 101};
+  uintptr_t i = 0;
+
+  fail_if (OMX_ErrorNone != tiz_ring_init (&p_ring, 8));
+  fail_if (OMX_ErrorNone != tiz_ring_init (&p_other, 0));
+
+  /* Start the items half way through the array */
+  for (i = 0; i < 4; ++i)
+    {
+      fail_if (OMX_ErrorNone != tiz_ring_push_back (p_ring, (OMX_PTR) i));
+      tiz_ring_erase (p_ring, 0);
+    }
+  for (i = 0; i < 8; ++i)
+    {
+      fail_if (OMX_ErrorNone != tiz_ring_push_back (p_ring, (OMX_PTR) i));
+    }
+
+  /* Removals on both sides of the middle */
+  tiz_ring_erase (p_ring, 1);
+  tiz_ring_erase (p_ring, 3);
+  tiz_ring_erase (p_ring, 4);
+
+  fail_if (OMX_ErrorNone != tiz_ring_push_back (p_other, (OMX_PTR) 100));
+  fail_if (OMX_ErrorNone != tiz_ring_push_back (p_other, (OMX_PTR) 101));
+  fail_if (OMX_ErrorNone != tiz_ring_append (p_ring, p_other));
+  fail_if (2 != tiz_ring_length (p_other));
+
+  fail_if (sizeof (expected) / sizeof (expected[0])
+           != tiz_ring_length (p_ring));
+  for (i = 0; i < sizeof (expected) / sizeof (expected[0]); ++i)
+    {
+      fail_if ((OMX_PTR) expected[i] != tiz_ring_at (p_ring, i));
+    }
+
+  tiz_ring_destroy (p_ring);
+  tiz_ring_destroy (p_other);
+}
+END_TEST
+
+START_TEST (test_ring_benchmark)
+{
+  tiz_ring_t *p_ring = NULL;
+  tiz_vector_t *p_vector = NULL;
+  struct timespec start;
+  double ring_ns = 0;
+  double vector_ns = 0;
+  const double nops = (double) RING_BENCH_NBUFS * RING_BENCH_ROUNDS;
+  uintptr_t sum = 0;
+  uintptr_t i = 0;
+  int r = 0;
+
+  /* A port's buffer list: buffers are claimed from the front and returned
+     at the back */
+  fail_if (OMX_ErrorNone != tiz_ring_init (&p_ring, RING_BENCH_NBUFS));
+  fail_if (OMX_ErrorNone != tiz_vector_init (&p_vector, sizeof (OMX_PTR)));
+  for (i = 1; i <= RING_BENCH_NBUFS; ++i)
+    {
+      OMX_PTR p_hdr = (OMX_PTR) i;
+      fail_if (OMX_ErrorNone != tiz_ring_push_back (p_ring, p_hdr));
+      fail_if (OMX_ErrorNone != tiz_vector_push_back (p_vector, &p_hdr));
+    }
+
+  (void) clock_gettime (CLOCK_MONOTONIC, &start);
+  for (r = 0; r < RING_BENCH_ROUNDS; ++r)
+    {
+      for (i = 0; i < RING_BENCH_NBUFS; ++i)
+        {
+          OMX_PTR p_hdr = tiz_ring_at (p_ring, 0);
+          tiz_ring_erase (p_ring, 0);
+          sum += (uintptr_t) p_hdr;
+          fail_if (OMX_ErrorNone != tiz_ring_push_back (p_ring, p_hdr));
+        }
+    }
+  ring_ns = check_bench_elapsed_ns (&start);
+
+  (void) clock_gettime (CLOCK_MONOTONIC, &start);
+  for (r = 0; r < RING_BENCH_ROUNDS; ++r)
+    {
+      for (i = 0; i < RING_BENCH_NBUFS; ++i)
+        {
+          OMX_PTR p_hdr = *(OMX_PTR *) tiz_vector_at (p_vector, 0);
+          tiz_vector_erase (p_vector, 0, 1);
+          sum -= (uintptr_t) p_hdr;
+          fail_if (OMX_ErrorNone != tiz_vector_push_back (p_vector, &p_hdr));
+        }
+    }
+  vector_ns = check_bench_elapsed_ns (&start);
+
+  fail_if (0 != sum);
+  fail_if (RING_BENCH_NBUFS != tiz_ring_capacity (p_ring));
+
+  printf ("[%d buffers, %.0f claim/release pairs] tiz_vector: %.1f ns/pair "
+          "- tiz_ring: %.1f ns/pair\n",
+          RING_BENCH_NBUFS, nops, vector_ns / nops, ring_ns / nops);
+
+  tiz_ring_destroy (p_ring);
+  tiz_vector_destroy (p_vector);
+}
+END_TEST
+
+/* Local Variables: */
+/* c-default-style: gnu */
+/* fill-column: 79 */
+/* indent-tabs-mode: nil */
+/* compile-command: "make check" */
+/* End: */
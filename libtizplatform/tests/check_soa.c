@@ -27,6 +27,8 @@
  */
 
 #include <malloc.h>
+#include <pthread.h>
+#include <time.h>
 
 #define MAX_CLASS0_OBJS 126
 #define MAX_CLASS1_OBJS 62
@@ -255,6 +257,222 @@ START_TEST (test_soa_reserve_life_cycle)
 }
 END_TEST
 
+START_TEST (test_soa_size_classes)
+{
+  const size_t sizes[] = {0, 1, 15, 16, 17, 100, 200, 300, 500, 1000,
+                          2000, 3000, TIZ_SOA_MAX_OBJECT_SIZE};
+  const int nsizes = sizeof (sizes) / sizeof (sizes[0]);
+  void *objs[sizeof (sizes) / sizeof (sizes[0])];
+  tiz_soa_t *p_soa = NULL;
+  tiz_soa_info_t info;
+  int i = 0;
+
+  fail_if (OMX_ErrorNone != tiz_soa_init (&p_soa));
+
+  for (i = 0; i < nsizes; i++)
+    {
+      fail_if (NULL == (objs[i] = tiz_soa_calloc (p_soa, sizes[i])));
+      fail_if (0 != ((uintptr_t) objs[i] & 15));
+      fail_if (tiz_soa_usable_size (objs[i]) < sizes[i]);
+      fail_if (!tiz_soa_owns (p_soa, objs[i]));
+      memset (objs[i], 0xa5, tiz_soa_usable_size (objs[i]));
+    }
+
+  tiz_soa_info (p_soa, &info);
+  fail_if (info.objects != nsizes);
+  fail_if (info.slices[TIZ_SOA_NUM_CHUNK_CLASSES - 1] != 1);
+  fail_if (info.allocs != nsizes);
+  fail_if (info.slice_bytes == 0 || info.slice_bytes > info.chunk_bytes);
+
+  for (i = 0; i < nsizes; i++)
+    {
+      tiz_soa_free (p_soa, objs[i]);
+    }
+
+  tiz_soa_info (p_soa, &info);
+  fail_if (info.objects != 0);
+  fail_if (info.frees != nsizes);
+  fail_if (info.slice_bytes != 0);
+
+  tiz_soa_destroy (p_soa);
+}
+END_TEST
+
+START_TEST (test_soa_chunk_release)
+{
+  void *objs[3 * 128];
+  tiz_soa_t *p_soa = NULL;
+  tiz_soa_info_t info;
+  size_t chunk_bytes = 0;
+  int i = 0;
+
+  fail_if (OMX_ErrorNone != tiz_soa_init (&p_soa));
+
+  /* Three chunks' worth of 32-byte slices */
+  for (i = 0; i < 3 * 128; i++)
+    {
+      fail_if (NULL == (objs[i] = tiz_soa_calloc (p_soa, 8)));
+    }
+
+  tiz_soa_info (p_soa, &info);
+  fail_if (info.chunks != 3);
+  chunk_bytes = info.chunk_bytes;
+
+  /* Empty chunks are released, but for one */
+  for (i = 0; i < 3 * 128; i++)
+    {
+      tiz_soa_free (p_soa, objs[i]);
+    }
+
+  tiz_soa_info (p_soa, &info);
+  fail_if (info.chunks != 1);
+  fail_if (info.released != 2);
+  fail_if (info.chunk_bytes != chunk_bytes / 3);
+
+  tiz_soa_destroy (p_soa);
+}
+END_TEST
+
+#define CHECK_SOA_NTHREADS 4
+#define CHECK_SOA_NOBJS 512
+#define CHECK_SOA_NROUNDS 400
+
+typedef struct check_soa_thread check_soa_thread_t;
+struct check_soa_thread
+{
+  pthread_t thread;
+  void *objs[CHECK_SOA_NOBJS];
+  bool use_malloc;
+  double elapsed_ns;
+};
+
+static void *
+check_soa_thread (void *ap_arg)
+{
+  check_soa_thread_t *p_thread = ap_arg;
+  tiz_soa_t *p_soa = tiz_soa_shared ();
+  struct timespec start;
+  int i = 0;
+  int j = 0;
+
+  (void) clock_gettime (CLOCK_MONOTONIC, &start);
+  for (i = 0; i < CHECK_SOA_NROUNDS; i++)
+    {
+      for (j = 0; j < CHECK_SOA_NOBJS; j++)
+        {
+          const size_t size = 16 + (j % 16) * 24;
+          p_thread->objs[j] = p_thread->use_malloc
+                                ? malloc (size)
+                                : tiz_soa_alloc (p_soa, size);
+          fail_if (NULL == p_thread->objs[j]);
+          *(int *) p_thread->objs[j] = j;
+        }
+      for (j = 0; j < CHECK_SOA_NOBJS; j++)
+        {
+          fail_if (*(int *) p_thread->objs[j] != j);
+          if (p_thread->use_malloc)
+            {
+              free (p_thread->objs[j]);
+            }
+          else
+            {
+              tiz_soa_free (p_soa, p_thread->objs[j]);
+            }
+        }
+    }
+  p_thread->elapsed_ns = check_bench_elapsed_ns (&start);
+
+  /* Leave some objects behind, to be freed by the main thread */
+  for (j = 0; j < CHECK_SOA_NOBJS; j++)
+    {
+      p_thread->objs[j] = p_thread->use_malloc
+                            ? malloc (64)
+                            : tiz_soa_alloc (p_soa, 64);
+    }
+
+  return NULL;
+}
+
+static double
+check_soa_run_threads (check_soa_thread_t *ap_threads, bool a_use_malloc)
+{
+  tiz_soa_t *p_soa = tiz_soa_shared ();
+  double elapsed_ns = 0;
+  int i = 0;
+  int j = 0;
+
+  for (i = 0; i < CHECK_SOA_NTHREADS; i++)
+    {
+      ap_threads[i].use_malloc = a_use_malloc;
+      fail_if (0 != pthread_create (&ap_threads[i].thread, NULL,
+                                    check_soa_thread, &ap_threads[i]));
+    }
+  for (i = 0; i < CHECK_SOA_NTHREADS; i++)
+    {
+      fail_if (0 != pthread_join (ap_threads[i].thread, NULL));
+      elapsed_ns += ap_threads[i].elapsed_ns;
+      for (j = 0; j < CHECK_SOA_NOBJS; j++)
+        {
+          fail_if (NULL == ap_threads[i].objs[j]);
+          if (a_use_malloc)
+            {
+              free (ap_threads[i].objs[j]);
+            }
+          else
+            {
+              fail_if (!tiz_soa_owns (p_soa, ap_threads[i].objs[j]));
+              tiz_soa_free (p_soa, ap_threads[i].objs[j]);
+            }
+        }
+    }
+
+  return elapsed_ns
+         / ((double) CHECK_SOA_NTHREADS * CHECK_SOA_NROUNDS * CHECK_SOA_NOBJS);
+}
+
+START_TEST (test_soa_shared_threads)
+{
+  check_soa_thread_t threads[CHECK_SOA_NTHREADS];
+  tiz_soa_t *p_soa = tiz_soa_shared ();
+  tiz_soa_info_t before;
+  tiz_soa_info_t after;
+
+  fail_if (NULL == p_soa);
+  tiz_soa_info (p_soa, &before);
+
+  memset (threads, 0, sizeof (threads));
+  (void) check_soa_run_threads (threads, false);
+
+  /* The exited threads' magazines went back to the chunks; everything is
+     accounted for */
+  tiz_soa_info (p_soa, &after);
+  fail_if (after.objects != before.objects);
+  fail_if (after.allocs - before.allocs != after.frees - before.frees);
+  fail_if (after.allocs - before.allocs
+           != (uint64_t) CHECK_SOA_NTHREADS * (CHECK_SOA_NROUNDS + 1)
+                * CHECK_SOA_NOBJS);
+  fail_if (after.chunks > before.chunks + TIZ_SOA_NUM_CHUNK_CLASSES);
+}
+END_TEST
+
+START_TEST (test_soa_benchmark)
+{
+  check_soa_thread_t threads[CHECK_SOA_NTHREADS];
+  double soa_ns = 0;
+  double malloc_ns = 0;
+
+  memset (threads, 0, sizeof (threads));
+  soa_ns = check_soa_run_threads (threads, false);
+  memset (threads, 0, sizeof (threads));
+  malloc_ns = check_soa_run_threads (threads, true);
+
+  printf ("[%d threads x %d alloc/free pairs] tiz_soa: %.1f ns/pair - "
+          "malloc: %.1f ns/pair\n",
+          CHECK_SOA_NTHREADS, CHECK_SOA_NROUNDS * CHECK_SOA_NOBJS, soa_ns,
+          malloc_ns);
+}
+END_TEST
+
 /* Local Variables: */
 /* c-default-style: gnu */
 /* fill-column: 79 */
@@ -40,10 +40,13 @@
 #endif
 
 #include "check_tizplatform.h"
+#include "./check_bench.c"
 #include "./check_mem.c"
 #include "./check_sem.c"
 #include "./check_mutex.c"
 #include "./check_queue.c"
+#include "./check_mpscq.c"
+#include "./check_wpool.c"
 #include "./check_pqueue.c"
 #include "./check_vector.c"
 #include "./check_rc.c"
@@ -51,6 +54,14 @@
 #include "./check_event.c"
 #include "./check_http_parser.c"
 #include "./check_map.c"
+#include "./check_hmap.c"
+#include "./check_ring.c"
+#include "./check_tracer.c"
+#include "./check_log.c"
+#include "./check_twheel.c"
+#include "./check_aio.c"
+#include "./check_bufpool.c"
+#include "./check_buffer.c"
 
 #define EVENT_API_TEST_TIMEOUT 100
 
@@ -63,6 +74,9 @@ platform_mem_suite (void)
   /* Memory API test case */
   tc_mem = tcase_create ("memory");
   tcase_add_test (tc_mem, test_mem_alloc_and_free);
+  tcase_add_test (tc_mem, test_mem_small_objects);
+  tcase_add_test (tc_mem, test_mem_accounts);
+  tcase_add_test (tc_mem, test_mem_backends);
   suite_add_tcase (s, tc_mem);
 
   return s;
@@ -108,6 +122,38 @@ platform_queue_suite (void)
   return s;
 }
 
+Suite *
+platform_mpscq_suite (void)
+{
+  TCase *tc_mpscq = NULL;
+  Suite *s = suite_create ("Lock-free MPSC queue");
+
+  /* mpscq API test case */
+  tc_mpscq = tcase_create ("mpscq");
+  tcase_add_test (tc_mpscq, test_mpscq_init_and_destroy);
+  tcase_add_test (tc_mpscq, test_mpscq_send_and_receive);
+  tcase_add_test (tc_mpscq, test_mpscq_multiple_producers);
+  suite_add_tcase (s, tc_mpscq);
+
+  return s;
+}
+
+Suite *
+platform_wpool_suite (void)
+{
+  TCase *tc_wpool = NULL;
+  Suite *s = suite_create ("Work-stealing pool");
+
+  /* wpool API test case */
+  tc_wpool = tcase_create ("wpool");
+  tcase_add_test (tc_wpool, test_wpool_init_and_destroy);
+  tcase_add_test (tc_wpool, test_wpool_submit);
+  tcase_add_test (tc_wpool, test_wpool_blocking);
+  suite_add_tcase (s, tc_wpool);
+
+  return s;
+}
+
 Suite *
 platform_pqueue_suite (void)
 {
@@ -123,6 +169,8 @@ platform_pqueue_suite (void)
   tcase_add_test (tc_pqueue, test_pqueue_first);
   tcase_add_test (tc_pqueue, test_pqueue_remove);
   tcase_add_test (tc_pqueue, test_pqueue_removep);
+  tcase_add_test (tc_pqueue, test_pqueue_remove_handle);
+  tcase_add_test (tc_pqueue, test_pqueue_many_groups);
   suite_add_tcase (s, tc_pqueue);
 
   return s;
@@ -173,6 +221,9 @@ platform_soa_suite (void)
   tc_soa = tcase_create ("soa");
   tcase_add_test (tc_soa, test_soa_basic_life_cycle);
   tcase_add_test (tc_soa, test_soa_reserve_life_cycle);
+  tcase_add_test (tc_soa, test_soa_size_classes);
+  tcase_add_test (tc_soa, test_soa_chunk_release);
+  tcase_add_test (tc_soa, test_soa_shared_threads);
   suite_add_tcase (s, tc_soa);
 
   return s;
@@ -196,6 +247,22 @@ platform_event_suite (void)
   return s;
 }
 
+Suite *
+platform_event_shards_suite (void)
+{
+  TCase *tc_shards = NULL;
+  Suite *s = suite_create ("Event loop shards");
+
+  /* event loop sharding test cases */
+  tc_shards = tcase_create ("event loop shards");
+  tcase_add_test (tc_shards, test_event_loop_shards);
+  tcase_add_test (tc_shards, test_event_loop_inline_ops);
+  tcase_add_test (tc_shards, test_event_loop_request_rings);
+  suite_add_tcase (s, tc_shards);
+
+  return s;
+}
+
 Suite *
 platform_http_parser_suite (void)
 {
@@ -227,6 +294,160 @@ platform_map_suite (void)
 
 }
 
+Suite *
+platform_hmap_suite (void)
+{
+  TCase *tc_hmap = NULL;
+  Suite *s = suite_create ("Hash map");
+
+  /* hmap API test cases */
+  tc_hmap = tcase_create ("hmap");
+  tcase_add_test (tc_hmap, test_hmap_init_and_destroy);
+  tcase_add_test (tc_hmap, test_hmap_insert_find_erase);
+  tcase_add_test (tc_hmap, test_hmap_iterate_and_clear);
+  suite_add_tcase (s, tc_hmap);
+
+  return s;
+}
+
+Suite *
+platform_ring_suite (void)
+{
+  TCase *tc_ring = NULL;
+  Suite *s = suite_create ("Ring buffer");
+
+  /* ring API test cases */
+  tc_ring = tcase_create ("ring");
+  tcase_add_test (tc_ring, test_ring_init_and_destroy);
+  tcase_add_test (tc_ring, test_ring_push_erase_wraparound);
+  tcase_add_test (tc_ring, test_ring_erase_middle_and_append);
+  suite_add_tcase (s, tc_ring);
+
+  return s;
+}
+
+Suite *
+platform_tracer_suite (void)
+{
+  TCase *tc_tracer = NULL;
+  Suite *s = suite_create ("Event tracer");
+
+  /* tracer API test cases */
+  tc_tracer = tcase_create ("tracer");
+  tcase_add_test (tc_tracer, test_tracer_record_and_dump);
+  tcase_add_test (tc_tracer, test_tracer_overwrite_and_restart);
+  tcase_add_test (tc_tracer, test_tracer_ring_reuse);
+  suite_add_tcase (s, tc_tracer);
+
+  return s;
+}
+
+Suite *
+platform_log_suite (void)
+{
+  TCase *tc_log = NULL;
+  Suite *s = suite_create ("Logging macros");
+
+  /* logging macros test cases */
+  tc_log = tcase_create ("log");
+  tcase_add_test (tc_log, test_log_args_evaluation);
+  tcase_add_test (tc_log, test_log_async_overflow);
+  suite_add_tcase (s, tc_log);
+
+  return s;
+}
+
+Suite *
+platform_twheel_suite (void)
+{
+  TCase *tc_twheel = NULL;
+  Suite *s = suite_create ("Timer wheel");
+
+  /* timer wheel test cases */
+  tc_twheel = tcase_create ("twheel");
+  tcase_add_test (tc_twheel, test_twheel_expiry_order);
+  tcase_add_test (tc_twheel, test_twheel_slack_coalescing);
+  tcase_add_test (tc_twheel, test_twheel_callbacks);
+  tcase_add_test (tc_twheel, test_twheel_event_timers);
+  suite_add_tcase (s, tc_twheel);
+
+  return s;
+}
+
+Suite *
+platform_aio_suite (void)
+{
+  TCase *tc_aio = NULL;
+  Suite *s = suite_create ("Async io requests");
+
+  /* async io test cases */
+  tc_aio = tcase_create ("aio");
+  tcase_add_test (tc_aio, test_aio_file_roundtrip);
+  tcase_add_test (tc_aio, test_aio_socket);
+  tcase_add_test (tc_aio, test_aio_destroy_in_progress);
+  suite_add_tcase (s, tc_aio);
+
+  return s;
+}
+
+Suite *
+platform_bufpool_suite (void)
+{
+  TCase *tc_bufpool = NULL;
+  Suite *s = suite_create ("Buffer pool");
+
+  /* buffer pool test cases */
+  tc_bufpool = tcase_create ("bufpool");
+  tcase_add_test (tc_bufpool, test_bufpool_alloc_and_reuse);
+  tcase_add_test (tc_bufpool, test_bufpool_hugepages);
+  tcase_add_test (tc_bufpool, test_bufpool_accounts);
+  suite_add_tcase (s, tc_bufpool);
+
+  return s;
+}
+
+Suite *
+platform_buffer_suite (void)
+{
+  TCase *tc_buffer = NULL;
+  Suite *s = suite_create ("Dynamic buffer");
+
+  /* dynamic buffer test cases */
+  tc_buffer = tcase_create ("buffer");
+  tcase_add_test (tc_buffer, test_buffer_modes);
+  tcase_add_test (tc_buffer, test_buffer_ring);
+  suite_add_tcase (s, tc_buffer);
+
+  return s;
+}
+
+Suite *
+platform_bench_suite (void)
+{
+  TCase *tc_bench = NULL;
+  Suite *s = suite_create ("Benchmarks");
+
+  /* benchmarks; these only run when TIZONIA_CHECK_BENCH is set */
+  tc_bench = tcase_create ("bench");
+  tcase_set_timeout (tc_bench, 0);
+  tcase_add_test (tc_bench, test_mpscq_benchmark);
+  tcase_add_test (tc_bench, test_soa_benchmark);
+  tcase_add_test (tc_bench, test_event_loop_benchmark);
+  tcase_add_test (tc_bench, test_hmap_benchmark);
+  tcase_add_test (tc_bench, test_ring_benchmark);
+  tcase_add_test (tc_bench, test_tracer_benchmark);
+  tcase_add_test (tc_bench, test_log_benchmark);
+  tcase_add_test (tc_bench, test_log_async_benchmark);
+  tcase_add_test (tc_bench, test_twheel_benchmark);
+  tcase_add_test (tc_bench, test_twheel_event_benchmark);
+  tcase_add_test (tc_bench, test_aio_benchmark);
+  tcase_add_test (tc_bench, test_bufpool_benchmark);
+  tcase_add_test (tc_bench, test_buffer_benchmark);
+  suite_add_tcase (s, tc_bench);
+
+  return s;
+}
+
 int
 main (void)
 {
@@ -240,13 +461,28 @@ main (void)
   sr = srunner_create (platform_mem_suite ());
   srunner_add_suite (sr, platform_sync_suite ());
   srunner_add_suite (sr, platform_queue_suite ());
+  srunner_add_suite (sr, platform_mpscq_suite ());
+  srunner_add_suite (sr, platform_wpool_suite ());
   srunner_add_suite (sr, platform_pqueue_suite ());
   srunner_add_suite (sr, platform_vector_suite ());
   srunner_add_suite (sr, platform_rcfile_suite ());
   srunner_add_suite (sr, platform_soa_suite ());
   srunner_add_suite (sr, platform_http_parser_suite ());
   srunner_add_suite (sr, platform_map_suite ());
+  srunner_add_suite (sr, platform_hmap_suite ());
+  srunner_add_suite (sr, platform_ring_suite ());
+  srunner_add_suite (sr, platform_tracer_suite ());
+  srunner_add_suite (sr, platform_log_suite ());
 /*   srunner_add_suite (sr, platform_event_suite ()); */
+  srunner_add_suite (sr, platform_event_shards_suite ());
+  srunner_add_suite (sr, platform_twheel_suite ());
+  srunner_add_suite (sr, platform_aio_suite ());
+  srunner_add_suite (sr, platform_bufpool_suite ());
+  srunner_add_suite (sr, platform_buffer_suite ());
+  if (check_bench_enabled ())
+    {
+      srunner_add_suite (sr, platform_bench_suite ());
+    }
   srunner_run_all (sr, CK_VERBOSE);
   number_failed = srunner_ntests_failed (sr);
   srunner_free (sr);
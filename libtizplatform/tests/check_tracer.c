@@ -0,0 +1,236 @@
+/**
+ * Copyright (C) 2011-2020 Aratelia Limited - Juan A. Rubio and contributors
+ *
+ * This file is part of Tizonia
+ *
+ * Tizonia is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Tizonia is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Tizonia.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file   check_tracer.c
+ * @author Juan A. Rubio <juan.rubio@aratelia.com>
+ *
+ * @brief  Event tracer unit tests and micro-benchmark
+ *
+ *
+ */
+
+#include <pthread.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#define TRACER_TEST_FILE "/tmp/check_tizplatform_trace.json"
+#define TRACER_TEST_NTHREADS 4
+#define TRACER_TEST_NEVENTS 100
+#define TRACER_TEST_MAX_RINGS 32
+#define TRACER_BENCH_NEVENTS 1000000
+
+static char *
+check_tracer_read_file (const char * ap_path)
+{
+  FILE * p_file = fopen (ap_path, "r");
+  char * p_buf = NULL;
+  long len = 0;
+
+  fail_if (NULL == p_file);
+  fail_if (0 != fseek (p_file, 0, SEEK_END));
+  len = ftell (p_file);
+  rewind (p_file);
+  p_buf = tiz_mem_calloc (1, len + 1);
+  fail_if (NULL == p_buf);
+  fail_if ((size_t) len != fread (p_buf, 1, len, p_file));
+  fclose (p_file);
+  return p_buf;
+}
+
+static OMX_U32
+check_tracer_count (const char * ap_haystack, const char * ap_needle)
+{
+  OMX_U32 count = 0;
+  while ((ap_haystack = strstr (ap_haystack, ap_needle)))
+    {
+      count++;
+      ap_haystack += strlen (ap_needle);
+    }
+  return count;
+}
+
+static void *
+check_tracer_thread_func (void * ap_arg)
+{
+  const uintptr_t id = (uintptr_t) ap_arg;
+  int i = 0;
+
+  (void) pthread_setname_np (pthread_self (), "tracer-test");
+  for (i = 0; i < TRACER_TEST_NEVENTS; ++i)
+    {
+      const OMX_U64 start = tiz_monotonic_ns ();
+      tiz_tracer_instant ("test", "instant", id, i);
+      tiz_tracer_complete ("test", "complete", start, id, i);
+    }
+  return NULL;
+}
+
+START_TEST (test_tracer_record_and_dump)
+{
+  pthread_t threads[TRACER_TEST_NTHREADS];
+  OMX_U64 nevents = 0;
+  char * p_json = NULL;
+  uintptr_t i = 0;
+
+  /* Nothing is recorded until the tracer is started */
+  fail_if (tiz_tracer_enabled ());
+  tiz_tracer_instant ("test", "ignored", 0, 0);
+
+  fail_if (OMX_ErrorNone != tiz_tracer_start (TRACER_TEST_NEVENTS * 2));
+  fail_if (!tiz_tracer_enabled ());
+
+  for (i = 0; i < TRACER_TEST_NTHREADS; ++i)
+    {
+      fail_if (0 != pthread_create (&threads[i], NULL,
+                                    check_tracer_thread_func, (void *) i));
+    }
+  for (i = 0; i < TRACER_TEST_NTHREADS; ++i)
+    {
+      fail_if (0 != pthread_join (threads[i], NULL));
+    }
+
+  tiz_tracer_flow_begin ("test", "flow", 0x1234);
+  tiz_tracer_flow_end ("test", "flow", 0x1234);
+
+  tiz_tracer_stop ();
+  fail_if (tiz_tracer_enabled ());
+  tiz_tracer_instant ("test", "ignored", 0, 0);
+
+  /* The events of threads that have exited are still there */
+  fail_if (OMX_ErrorNone != tiz_tracer_dump (TRACER_TEST_FILE, &nevents));
+  fail_if (TRACER_TEST_NTHREADS * TRACER_TEST_NEVENTS * 2 + 2 != nevents);
+
+  p_json = check_tracer_read_file (TRACER_TEST_FILE);
+  fail_if (p_json != strstr (p_json, "{\"displayTimeUnit\":\"ns\","
+                                     "\"traceEvents\":["));
+  /* One thread name record per recording thread, this one included */
+  fail_if (TRACER_TEST_NTHREADS + 1
+           != check_tracer_count (p_json, "\"thread_name\",\"ph\":\"M\""));
+  fail_if (TRACER_TEST_NTHREADS
+           != check_tracer_count (p_json, "{\"name\":\"tracer-test\"}"));
+  fail_if (TRACER_TEST_NTHREADS * TRACER_TEST_NEVENTS
+           != check_tracer_count (p_json, "\"name\":\"complete\","
+                                          "\"cat\":\"test\",\"ph\":\"X\""));
+  fail_if (TRACER_TEST_NTHREADS * TRACER_TEST_NEVENTS
+           != check_tracer_count (p_json, "\"ph\":\"i\""));
+  fail_if (1 != check_tracer_count (p_json, "\"ph\":\"s\""));
+  fail_if (1 != check_tracer_count (p_json, "\"bp\":\"e\""));
+  fail_if (0 != check_tracer_count (p_json, "ignored"));
+  fail_if (NULL == strstr (p_json, "\n]}\n"));
+  tiz_mem_free (p_json);
+
+  (void) unlink (TRACER_TEST_FILE);
+}
+END_TEST
+
+START_TEST (test_tracer_overwrite_and_restart)
+{
+  pthread_t thread;
+  OMX_U64 nevents = 0;
+
+  /* A small ring keeps only the most recent events */
+  fail_if (OMX_ErrorNone != tiz_tracer_start (10));
+  fail_if (0 != pthread_create (&thread, NULL, check_tracer_thread_func,
+                                (void *) 1));
+  fail_if (0 != pthread_join (thread, NULL));
+  tiz_tracer_stop ();
+  fail_if (OMX_ErrorNone != tiz_tracer_dump (TRACER_TEST_FILE, &nevents));
+  fail_if (16 != nevents);
+
+  /* Restarting discards the previous recording */
+  fail_if (OMX_ErrorNone != tiz_tracer_start (0));
+  tiz_tracer_stop ();
+  fail_if (OMX_ErrorNone != tiz_tracer_dump (TRACER_TEST_FILE, &nevents));
+  fail_if (0 != nevents);
+
+  fail_if (OMX_ErrorInsufficientResources
+           != tiz_tracer_dump ("/nonexistent/dir/trace.json", NULL));
+  (void) unlink (TRACER_TEST_FILE);
+}
+END_TEST
+
+START_TEST (test_tracer_ring_reuse)
+{
+  pthread_t thread;
+  OMX_U64 nevents = 0;
+  OMX_U32 nrings = 0;
+  char * p_json = NULL;
+  uintptr_t i = 0;
+
+  /* Short-lived threads end up recycling the rings of exited ones instead of
+     allocating new ones */
+  fail_if (OMX_ErrorNone != tiz_tracer_start (16));
+  for (i = 0; i < TRACER_TEST_MAX_RINGS + 8; ++i)
+    {
+      fail_if (0 != pthread_create (&thread, NULL, check_tracer_thread_func,
+                                    (void *) i));
+      fail_if (0 != pthread_join (thread, NULL));
+    }
+  tiz_tracer_stop ();
+  fail_if (OMX_ErrorNone != tiz_tracer_dump (TRACER_TEST_FILE, &nevents));
+
+  p_json = check_tracer_read_file (TRACER_TEST_FILE);
+  nrings = check_tracer_count (p_json, "{\"name\":\"tracer-test\"}");
+  fail_if (0 == nrings);
+  fail_if (TRACER_TEST_MAX_RINGS < nrings);
+  fail_if (nrings * 16 != nevents);
+  tiz_mem_free (p_json);
+
+  (void) unlink (TRACER_TEST_FILE);
+}
+END_TEST
+
+START_TEST (test_tracer_benchmark)
+{
+  struct timespec start;
+  double off_ns = 0;
+  double on_ns = 0;
+  int i = 0;
+
+  (void) clock_gettime (CLOCK_MONOTONIC, &start);
+  for (i = 0; i < TRACER_BENCH_NEVENTS; ++i)
+    {
+      tiz_tracer_instant ("bench", "instant", i, i);
+    }
+  off_ns = check_bench_elapsed_ns (&start);
+
+  fail_if (OMX_ErrorNone != tiz_tracer_start (0));
+  (void) clock_gettime (CLOCK_MONOTONIC, &start);
+  for (i = 0; i < TRACER_BENCH_NEVENTS; ++i)
+    {
+      tiz_tracer_instant ("bench", "instant", i, i);
+    }
+  on_ns = check_bench_elapsed_ns (&start);
+  tiz_tracer_stop ();
+
+  printf ("[%d events] tracer disabled: %.1f ns/event - enabled: %.1f "
+          "ns/event\n",
+          TRACER_BENCH_NEVENTS, off_ns / TRACER_BENCH_NEVENTS,
+          on_ns / TRACER_BENCH_NEVENTS);
+}
+END_TEST
+
+/* Local Variables: */
+/* c-default-style: gnu */
+/* fill-column: 79 */
+/* indent-tabs-mode: nil */
+/* compile-command: "make check" */
+/* End: */
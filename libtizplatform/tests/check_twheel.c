@@ -0,0 +1,509 @@
+/**
+ * Copyright (C) 2011-2020 Aratelia Limited - Juan A. Rubio and contributors
+ *
+ * This file is part of Tizonia
+ *
+ * Tizonia is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Tizonia is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Tizonia.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file   check_twheel.c
+ * @author Juan A. Rubio <juan.rubio@aratelia.com>
+ *
+ * @brief  Timer wheel unit tests and micro-benchmarks
+ *
+ *
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+#include <unistd.h>
+
+#define TWHEEL_TEST_NTIMERS 5000
+#define TWHEEL_TEST_TICK_NS 1000
+#define TWHEEL_SLACK_NTIMERS 1000
+#define TWHEEL_SLACK_NS 16000000
+#define TWHEEL_BENCH_NTIMERS 10000
+#define TWHEEL_BENCH_NROUNDS 100
+#define TWHEEL_EVENT_NTIMERS 200
+#define TWHEEL_EVENT_NROUNDS 10
+
+typedef struct check_twheel_timer check_twheel_timer_t;
+struct check_twheel_timer
+{
+  tiz_twheel_timer_t * p_timer;
+  OMX_U64 requested_ns;
+  OMX_U64 expected_ns;
+  OMX_U32 nfired;
+  OMX_U32 nrepeats;
+  check_twheel_timer_t * p_victim;
+};
+
+static OMX_U64 g_twheel_now_ns = 0;
+static OMX_U64 g_twheel_last_ns = 0;
+static OMX_U32 g_twheel_nfired = 0;
+
+static OMX_U64
+check_twheel_rand (void)
+{
+  return ((OMX_U64) random () << 31) ^ (OMX_U64) random ();
+}
+
+static void
+check_twheel_order_cback (void * ap_arg, tiz_twheel_timer_t * ap_timer)
+{
+  check_twheel_timer_t * p_t = ap_arg;
+  fail_if (p_t->p_timer != ap_timer);
+  fail_if (tiz_twheel_timer_is_active (ap_timer));
+  /* Never early, and in expiry order */
+  fail_if (p_t->expected_ns > g_twheel_now_ns);
+  fail_if (p_t->expected_ns < g_twheel_last_ns);
+  g_twheel_last_ns = p_t->expected_ns;
+  p_t->nfired++;
+  g_twheel_nfired++;
+}
+
+START_TEST (test_twheel_expiry_order)
+{
+  tiz_twheel_t * p_wheel = NULL;
+  check_twheel_timer_t * p_timers = NULL;
+  int i = 0;
+
+  srandom (1234);
+  g_twheel_now_ns = 0;
+  g_twheel_last_ns = 0;
+  g_twheel_nfired = 0;
+
+  fail_if (OMX_ErrorNone
+           != tiz_twheel_init (&p_wheel, TWHEEL_TEST_TICK_NS, 0));
+  p_timers = tiz_mem_calloc (TWHEEL_TEST_NTIMERS, sizeof (*p_timers));
+  fail_if (NULL == p_timers);
+
+  for (i = 0; i < TWHEEL_TEST_NTIMERS; ++i)
+    {
+      check_twheel_timer_t * p_t = &(p_timers[i]);
+      /* Log-uniform, up to well beyond the range of the wheel */
+      p_t->requested_ns = 1 + check_twheel_rand () % ((OMX_U64) 1
+                                                      << (random () % 46));
+      fail_if (OMX_ErrorNone
+               != tiz_twheel_timer_init (p_wheel, &(p_t->p_timer),
+                                         check_twheel_order_cback, p_t));
+      p_t->expected_ns
+        = tiz_twheel_timer_start (p_t->p_timer, p_t->requested_ns, 0);
+      /* Rounded up to the tick, and no further */
+      fail_if (p_t->expected_ns < p_t->requested_ns);
+      fail_if (p_t->expected_ns - p_t->requested_ns >= TWHEEL_TEST_TICK_NS);
+      fail_if (!tiz_twheel_timer_is_active (p_t->p_timer));
+    }
+
+  /* Stop and restart some of them */
+  for (i = 0; i < TWHEEL_TEST_NTIMERS; i += 7)
+    {
+      check_twheel_timer_t * p_t = &(p_timers[i]);
+      tiz_twheel_timer_stop (p_t->p_timer);
+      fail_if (tiz_twheel_timer_is_active (p_t->p_timer));
+      if (i % 2)
+        {
+          p_t->expected_ns
+            = tiz_twheel_timer_start (p_t->p_timer, p_t->requested_ns, 0);
+        }
+      else
+        {
+          p_t->nfired = 1; /* never fires */
+        }
+    }
+
+  while (tiz_twheel_count (p_wheel) > 0)
+    {
+      OMX_U64 next_ns = 0;
+      OMX_U64 min_ns = UINT64_MAX;
+      for (i = 0; i < TWHEEL_TEST_NTIMERS; ++i)
+        {
+          if (tiz_twheel_timer_is_active (p_timers[i].p_timer)
+              && p_timers[i].expected_ns < min_ns)
+            {
+              min_ns = p_timers[i].expected_ns;
+            }
+        }
+      fail_if (!tiz_twheel_next_expiry (p_wheel, &next_ns));
+      /* Earlier only for timers parked beyond the range of the wheel */
+      fail_if (next_ns > min_ns);
+
+      g_twheel_now_ns += 1 + check_twheel_rand () % ((OMX_U64) 1
+                                                     << (random () % 40));
+      (void) tiz_twheel_advance (p_wheel, g_twheel_now_ns);
+      /* Nothing due is left behind */
+      fail_if (tiz_twheel_next_expiry (p_wheel, &next_ns)
+               && next_ns <= g_twheel_now_ns);
+    }
+
+  for (i = 0; i < TWHEEL_TEST_NTIMERS; ++i)
+    {
+      fail_if (1 != p_timers[i].nfired);
+      tiz_twheel_timer_destroy (p_timers[i].p_timer);
+    }
+
+  tiz_mem_free (p_timers);
+  tiz_twheel_destroy (p_wheel);
+}
+END_TEST
+
+static void
+check_twheel_count_cback (void * ap_arg, tiz_twheel_timer_t * ap_timer)
+{
+  check_twheel_timer_t * p_t = ap_arg;
+  (void) ap_timer;
+  p_t->nfired++;
+  g_twheel_nfired++;
+}
+
+START_TEST (test_twheel_slack_coalescing)
+{
+  tiz_twheel_t * p_wheel = NULL;
+  check_twheel_timer_t * p_timers = NULL;
+  const OMX_U64 tick_ns = 1000000;
+  int nwakeups = 0;
+  int nexact = 0;
+  OMX_U64 now_ns = 0;
+  int i = 0;
+
+  srandom (5678);
+  g_twheel_nfired = 0;
+
+  fail_if (OMX_ErrorNone != tiz_twheel_init (&p_wheel, tick_ns, 0));
+  p_timers = tiz_mem_calloc (TWHEEL_SLACK_NTIMERS, sizeof (*p_timers));
+  fail_if (NULL == p_timers);
+
+  for (i = 0; i < TWHEEL_SLACK_NTIMERS; ++i)
+    {
+      check_twheel_timer_t * p_t = &(p_timers[i]);
+      p_t->requested_ns = random () % 1000000000;
+      fail_if (OMX_ErrorNone
+               != tiz_twheel_timer_init (p_wheel, &(p_t->p_timer),
+                                         check_twheel_count_cback, p_t));
+      p_t->expected_ns = tiz_twheel_timer_start (
+        p_t->p_timer, p_t->requested_ns, TWHEEL_SLACK_NS);
+      fail_if (p_t->expected_ns < p_t->requested_ns);
+      fail_if (p_t->expected_ns - p_t->requested_ns
+               >= TWHEEL_SLACK_NS + tick_ns);
+    }
+
+  /* Count the wakeups of a caller that sleeps until the next expiry */
+  while (tiz_twheel_next_expiry (p_wheel, &now_ns))
+    {
+      const OMX_U32 nfired = g_twheel_nfired;
+      (void) tiz_twheel_advance (p_wheel, now_ns);
+      fail_if (nfired == g_twheel_nfired);
+      nwakeups++;
+    }
+  fail_if (TWHEEL_SLACK_NTIMERS != g_twheel_nfired);
+  /* At most one wakeup per 16 ms (the power of two that fits the slack) */
+  fail_if (nwakeups > 1000 / 16 + 2);
+
+  /* The same timers without slack */
+  for (i = 0; i < TWHEEL_SLACK_NTIMERS; ++i)
+    {
+      (void) tiz_twheel_timer_start (p_timers[i].p_timer,
+                                     now_ns + p_timers[i].requested_ns, 0);
+    }
+  while (tiz_twheel_next_expiry (p_wheel, &now_ns))
+    {
+      (void) tiz_twheel_advance (p_wheel, now_ns);
+      nexact++;
+    }
+
+  fail_if (nexact <= nwakeups);
+
+  for (i = 0; i < TWHEEL_SLACK_NTIMERS; ++i)
+    {
+      fail_if (2 != p_timers[i].nfired);
+      tiz_twheel_timer_destroy (p_timers[i].p_timer);
+    }
+  tiz_mem_free (p_timers);
+  tiz_twheel_destroy (p_wheel);
+}
+END_TEST
+
+static void
+check_twheel_busy_cback (void * ap_arg, tiz_twheel_timer_t * ap_timer)
+{
+  check_twheel_timer_t * p_t = ap_arg;
+  p_t->nfired++;
+  if (p_t->p_victim)
+    {
+      tiz_twheel_timer_stop (p_t->p_victim->p_timer);
+    }
+  else if (p_t->nrepeats > 0)
+    {
+      p_t->nrepeats--;
+      (void) tiz_twheel_timer_start (ap_timer, g_twheel_now_ns, 0);
+    }
+  else
+    {
+      tiz_twheel_timer_destroy (ap_timer);
+      p_t->p_timer = NULL;
+    }
+}
+
+START_TEST (test_twheel_callbacks)
+{
+  tiz_twheel_t * p_wheel = NULL;
+  check_twheel_timer_t timers[3];
+  OMX_U32 nadvances = 0;
+  int i = 0;
+
+  memset (timers, 0, sizeof (timers));
+  g_twheel_now_ns = 0;
+
+  fail_if (OMX_ErrorNone
+           != tiz_twheel_init (&p_wheel, TWHEEL_TEST_TICK_NS, 0));
+  for (i = 0; i < 3; ++i)
+    {
+      fail_if (OMX_ErrorNone
+               != tiz_twheel_timer_init (p_wheel, &(timers[i].p_timer),
+                                         check_twheel_busy_cback,
+                                         &(timers[i])));
+    }
+
+  /* 0 restarts itself 10 times, then destroys itself; 1 stops 2, which is
+     due on the same tick */
+  timers[0].nrepeats = 10;
+  timers[1].p_victim = &(timers[2]);
+  (void) tiz_twheel_timer_start (timers[0].p_timer, 5000, 0);
+  (void) tiz_twheel_timer_start (timers[1].p_timer, 5000, 0);
+  (void) tiz_twheel_timer_start (timers[2].p_timer, 5000, 0);
+  fail_if (3 != tiz_twheel_count (p_wheel));
+
+  while (tiz_twheel_count (p_wheel) > 0)
+    {
+      g_twheel_now_ns += TWHEEL_TEST_TICK_NS;
+      (void) tiz_twheel_advance (p_wheel, g_twheel_now_ns);
+      nadvances++;
+      fail_if (nadvances > 100);
+    }
+
+  fail_if (11 != timers[0].nfired);
+  fail_if (NULL != timers[0].p_timer);
+  fail_if (1 != timers[1].nfired);
+  fail_if (0 != timers[2].nfired);
+
+  /* Destroying the wheel stops the timers left */
+  (void) tiz_twheel_timer_start (timers[2].p_timer, 1000000, 0);
+  tiz_twheel_destroy (p_wheel);
+  fail_if (tiz_twheel_timer_is_active (timers[2].p_timer));
+  tiz_twheel_timer_destroy (timers[1].p_timer);
+  tiz_twheel_timer_destroy (timers[2].p_timer);
+}
+END_TEST
+
+START_TEST (test_twheel_benchmark)
+{
+  tiz_twheel_t * p_wheel = NULL;
+  check_twheel_timer_t * p_timers = NULL;
+  struct timespec start;
+  double wheel_ns = 0;
+  OMX_U64 now_ns = 0;
+  int i = 0;
+  int j = 0;
+
+  srandom (4321);
+  fail_if (OMX_ErrorNone != tiz_twheel_init (&p_wheel, 1000000, 0));
+  p_timers = tiz_mem_calloc (TWHEEL_BENCH_NTIMERS, sizeof (*p_timers));
+  fail_if (NULL == p_timers);
+  for (i = 0; i < TWHEEL_BENCH_NTIMERS; ++i)
+    {
+      fail_if (OMX_ErrorNone
+               != tiz_twheel_timer_init (p_wheel, &(p_timers[i].p_timer),
+                                         check_twheel_count_cback,
+                                         &(p_timers[i])));
+      p_timers[i].requested_ns = 1000000 + random () % 5000000000LL;
+    }
+
+  /* Short timers, restarted far more often than they expire, while time
+     goes by */
+  (void) clock_gettime (CLOCK_MONOTONIC, &start);
+  for (j = 0; j < TWHEEL_BENCH_NROUNDS; ++j)
+    {
+      now_ns += 1000000;
+      (void) tiz_twheel_advance (p_wheel, now_ns);
+      for (i = 0; i < TWHEEL_BENCH_NTIMERS; ++i)
+        {
+          (void) tiz_twheel_timer_start (
+            p_timers[i].p_timer, now_ns + p_timers[i].requested_ns, 4000000);
+        }
+    }
+  wheel_ns = check_bench_elapsed_ns (&start);
+
+  printf ("[%d timers x %d restarts] wheel: %.1f ns/restart\n",
+          TWHEEL_BENCH_NTIMERS, TWHEEL_BENCH_NROUNDS,
+          wheel_ns / (TWHEEL_BENCH_NTIMERS * TWHEEL_BENCH_NROUNDS));
+
+  fail_if (TWHEEL_BENCH_NTIMERS != tiz_twheel_count (p_wheel));
+  for (i = 0; i < TWHEEL_BENCH_NTIMERS; ++i)
+    {
+      tiz_twheel_timer_destroy (p_timers[i].p_timer);
+    }
+  fail_if (0 != tiz_twheel_count (p_wheel));
+  tiz_mem_free (p_timers);
+  tiz_twheel_destroy (p_wheel);
+}
+END_TEST
+
+typedef struct check_twheel_event check_twheel_event_t;
+struct check_twheel_event
+{
+  tiz_event_timer_t * p_ev_timer;
+  OMX_U64 due_ns;
+  OMX_U64 late_ns;
+  volatile OMX_U32 nfired;
+  volatile bool early;
+};
+
+static void
+check_twheel_event_cback (void * ap_arg0, tiz_event_timer_t * ap_ev_timer,
+                          void * ap_arg1, const uint32_t a_id)
+{
+  check_twheel_event_t * p_ev = ap_arg1;
+  const OMX_U64 now_ns = tiz_monotonic_ns ();
+  (void) ap_arg0;
+  (void) a_id;
+  fail_if (p_ev->p_ev_timer != ap_ev_timer);
+  if (now_ns < p_ev->due_ns)
+    {
+      p_ev->early = true;
+    }
+  else
+    {
+      p_ev->late_ns = now_ns - p_ev->due_ns;
+    }
+  p_ev->nfired++;
+}
+
+static double
+check_twheel_restart_events (check_twheel_event_t * ap_evs,
+                             const double a_slack)
+{
+  struct timespec start;
+  double elapsed_ns = 0;
+  int i = 0;
+  int j = 0;
+
+  for (i = 0; i < TWHEEL_EVENT_NTIMERS; ++i)
+    {
+      fail_if (OMX_ErrorNone
+               != tiz_event_timer_init (&(ap_evs[i].p_ev_timer), ap_evs,
+                                        check_twheel_event_cback,
+                                        &(ap_evs[i])));
+      fail_if (OMX_ErrorNone
+               != tiz_event_timer_set_slack (ap_evs[i].p_ev_timer, a_slack));
+      tiz_event_timer_set (ap_evs[i].p_ev_timer, 10., 10.);
+    }
+
+  (void) clock_gettime (CLOCK_MONOTONIC, &start);
+  for (j = 0; j < TWHEEL_EVENT_NROUNDS; ++j)
+    {
+      for (i = 0; i < TWHEEL_EVENT_NTIMERS; ++i)
+        {
+          fail_if (OMX_ErrorNone
+                   != tiz_event_timer_restart (ap_evs[i].p_ev_timer, j + 1));
+        }
+    }
+  elapsed_ns = check_bench_elapsed_ns (&start);
+
+  for (i = 0; i < TWHEEL_EVENT_NTIMERS; ++i)
+    {
+      fail_if (OMX_ErrorNone != tiz_event_timer_stop (ap_evs[i].p_ev_timer));
+      tiz_event_timer_destroy (ap_evs[i].p_ev_timer);
+    }
+
+  return elapsed_ns / (TWHEEL_EVENT_NTIMERS * TWHEEL_EVENT_NROUNDS);
+}
+
+START_TEST (test_twheel_event_timers)
+{
+  static check_twheel_event_t evs[TWHEEL_EVENT_NTIMERS];
+  int nwaits = 0;
+  int nfired = 0;
+  int i = 0;
+
+  srandom (8765);
+  memset (evs, 0, sizeof (evs));
+  fail_if (OMX_ErrorNone != tiz_event_loop_init ());
+
+  /* Timers with 5 ms of slack, due within 50 ms */
+  for (i = 0; i < TWHEEL_EVENT_NTIMERS; ++i)
+    {
+      const double after = (1 + random () % 50) / 1000.;
+      fail_if (OMX_ErrorNone
+               != tiz_event_timer_init (&(evs[i].p_ev_timer), evs,
+                                        check_twheel_event_cback, &(evs[i])));
+      fail_if (OMX_ErrorNone
+               != tiz_event_timer_set_slack (evs[i].p_ev_timer, 0.005));
+      tiz_event_timer_set (evs[i].p_ev_timer, after, 0.);
+      evs[i].due_ns = tiz_monotonic_ns () + after * 1e9;
+      fail_if (OMX_ErrorNone != tiz_event_timer_start (evs[i].p_ev_timer, 1));
+    }
+
+  while (nfired < TWHEEL_EVENT_NTIMERS && nwaits++ < 200)
+    {
+      usleep (10000);
+      for (i = 0, nfired = 0; i < TWHEEL_EVENT_NTIMERS; ++i)
+        {
+          nfired += evs[i].nfired;
+        }
+    }
+  fail_if (TWHEEL_EVENT_NTIMERS != nfired);
+
+  for (i = 0; i < TWHEEL_EVENT_NTIMERS; ++i)
+    {
+      fail_if (1 != evs[i].nfired);
+      fail_if (evs[i].early);
+      tiz_event_timer_destroy (evs[i].p_ev_timer);
+    }
+
+  /* Frequently restarted timers: queued to the loop, and in the wheel */
+  memset (evs, 0, sizeof (evs));
+  (void) check_twheel_restart_events (evs, 0.);
+  memset (evs, 0, sizeof (evs));
+  (void) check_twheel_restart_events (evs, 0.005);
+
+  /* Let the loops destroy the timers */
+  usleep (100000);
+  tiz_event_loop_destroy ();
+}
+END_TEST
+
+START_TEST (test_twheel_event_benchmark)
+{
+  static check_twheel_event_t evs[TWHEEL_EVENT_NTIMERS];
+  double exact_ns = 0;
+  double slack_ns = 0;
+
+  fail_if (OMX_ErrorNone != tiz_event_loop_init ());
+
+  /* Frequently restarted timers: queued to the loop vs in the wheel */
+  memset (evs, 0, sizeof (evs));
+  exact_ns = check_twheel_restart_events (evs, 0.);
+  memset (evs, 0, sizeof (evs));
+  slack_ns = check_twheel_restart_events (evs, 0.005);
+
+  printf ("[%d event timers] restart: %.1f ns exact - %.1f ns with slack\n",
+          TWHEEL_EVENT_NTIMERS, exact_ns, slack_ns);
+
+  /* Let the loops destroy the timers */
+  usleep (100000);
+  tiz_event_loop_destroy ();
+}
+END_TEST
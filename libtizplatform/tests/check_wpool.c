@@ -0,0 +1,173 @@
+/**
+ * Copyright (C) 2011-2020 Aratelia Limited - Juan A. Rubio and contributors
+ *
+ * This file is part of Tizonia
+ *
+ * Tizonia is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Tizonia is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Tizonia.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file   check_wpool.c
+ * @author Juan A. Rubio <juan.rubio@aratelia.com>
+ *
+ * @brief  Work-stealing pool API unit tests
+ *
+ *
+ */
+
+#define WPOOL_TEST_WORKERS 4
+#define WPOOL_TEST_TASKS 10000
+
+typedef struct wpool_test_ctx wpool_test_ctx_t;
+struct wpool_test_ctx
+{
+  tiz_wpool_t * p_pool;
+  tiz_sem_t sem;
+  OMX_U32 ntasks;
+  OMX_U32 nthreads;
+};
+
+static void
+wpool_test_count_task (OMX_PTR ap_arg)
+{
+  wpool_test_ctx_t * p_ctx = ap_arg;
+  if (WPOOL_TEST_TASKS
+      == __atomic_add_fetch (&(p_ctx->ntasks), 1, __ATOMIC_SEQ_CST))
+    {
+      (void) tiz_sem_post (&(p_ctx->sem));
+    }
+}
+
+static void
+wpool_test_spawn_task (OMX_PTR ap_arg)
+{
+  wpool_test_ctx_t * p_ctx = ap_arg;
+  /* Tasks submitted from a worker go to its own deque, and are stolen by the
+     others */
+  (void) tiz_wpool_submit (p_ctx->p_pool, wpool_test_count_task, p_ctx);
+}
+
+static void
+wpool_test_post_task (OMX_PTR ap_arg)
+{
+  wpool_test_ctx_t * p_ctx = ap_arg;
+  (void) tiz_sem_post (&(p_ctx->sem));
+}
+
+static void
+wpool_test_blocking_task (OMX_PTR ap_arg)
+{
+  wpool_test_ctx_t * p_ctx = ap_arg;
+  tiz_sem_t sem;
+  wpool_test_ctx_t inner;
+
+  (void) tiz_sem_init (&sem, 0);
+  inner.p_pool = p_ctx->p_pool;
+  inner.sem = sem;
+  inner.ntasks = 0;
+
+  /* The only regular worker is about to block waiting for a task that has
+     not been run yet; the pool must start another worker to run it. */
+  tiz_wpool_blocking_begin (p_ctx->p_pool);
+  (void) tiz_wpool_submit (p_ctx->p_pool, wpool_test_post_task, &inner);
+  (void) tiz_sem_wait (&sem);
+  p_ctx->nthreads = tiz_wpool_nthreads (p_ctx->p_pool);
+  tiz_wpool_blocking_end (p_ctx->p_pool);
+
+  (void) tiz_sem_destroy (&sem);
+  (void) tiz_sem_post (&(p_ctx->sem));
+}
+
+START_TEST (test_wpool_init_and_destroy)
+{
+  tiz_wpool_t * p_pool = NULL;
+
+  fail_if (OMX_ErrorNone != tiz_wpool_init (&p_pool, WPOOL_TEST_WORKERS,
+                                            "check_wpool"));
+  fail_if (NULL == p_pool);
+  fail_if (WPOOL_TEST_WORKERS != tiz_wpool_nthreads (p_pool));
+  tiz_wpool_destroy (p_pool);
+
+  /* Zero means one worker per online CPU */
+  fail_if (OMX_ErrorNone != tiz_wpool_init (&p_pool, 0, NULL));
+  fail_if (tiz_wpool_nthreads (p_pool) < 1);
+  tiz_wpool_destroy (p_pool);
+}
+END_TEST
+
+START_TEST (test_wpool_submit)
+{
+  wpool_test_ctx_t ctx;
+  OMX_U32 i = 0;
+
+  ctx.ntasks = 0;
+  fail_if (OMX_ErrorNone != tiz_sem_init (&(ctx.sem), 0));
+  fail_if (OMX_ErrorNone != tiz_wpool_init (&(ctx.p_pool), WPOOL_TEST_WORKERS,
+                                            "check_wpool"));
+
+  for (i = 0; i < WPOOL_TEST_TASKS / 2; ++i)
+    {
+      fail_if (OMX_ErrorNone
+               != tiz_wpool_submit (ctx.p_pool, wpool_test_count_task, &ctx));
+      fail_if (OMX_ErrorNone
+               != tiz_wpool_submit (ctx.p_pool, wpool_test_spawn_task, &ctx));
+    }
+
+  fail_if (OMX_ErrorNone != tiz_sem_wait (&(ctx.sem)));
+  fail_if (WPOOL_TEST_TASKS != ctx.ntasks);
+
+  tiz_wpool_destroy (ctx.p_pool);
+  (void) tiz_sem_destroy (&(ctx.sem));
+}
+END_TEST
+
+START_TEST (test_wpool_blocking)
+{
+  wpool_test_ctx_t ctx;
+  int i = 0;
+
+  ctx.ntasks = 0;
+  ctx.nthreads = 0;
+  fail_if (OMX_ErrorNone != tiz_sem_init (&(ctx.sem), 0));
+  fail_if (OMX_ErrorNone != tiz_wpool_init (&(ctx.p_pool), 1, "check_wpool"));
+
+  fail_if (OMX_ErrorNone
+           != tiz_wpool_submit (ctx.p_pool, wpool_test_blocking_task, &ctx));
+  fail_if (OMX_ErrorNone != tiz_sem_wait (&(ctx.sem)));
+  fail_if (2 != ctx.nthreads);
+
+  /* The extra worker retires once the blocked one has resumed */
+  for (i = 0; i < 1000 && 1 != tiz_wpool_nthreads (ctx.p_pool); ++i)
+    {
+      (void) tiz_sleep (1000);
+    }
+  fail_if (1 != tiz_wpool_nthreads (ctx.p_pool));
+
+  /* ... and its slot is reused the next time */
+  fail_if (OMX_ErrorNone
+           != tiz_wpool_submit (ctx.p_pool, wpool_test_blocking_task, &ctx));
+  fail_if (OMX_ErrorNone != tiz_sem_wait (&(ctx.sem)));
+  fail_if (2 != ctx.nthreads);
+
+  tiz_wpool_destroy (ctx.p_pool);
+  (void) tiz_sem_destroy (&(ctx.sem));
+}
+END_TEST
+
+/* Local Variables: */
+/* c-default-style: gnu */
+/* fill-column: 79 */
+/* indent-tabs-mode: nil */
+/* compile-command: "make check" */
+/* End: */
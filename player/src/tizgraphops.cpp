@@ -597,6 +597,7 @@ void graph::ops::do_tear_down_tunnels ()
 
 void graph::ops::do_destroy_graph ()
 {
+  util::dump_perf_stats (handles_, comp_lst_);
   util::destroy_list (handles_);
   handles_.clear ();
   h2n_.clear ();
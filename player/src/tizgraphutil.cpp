@@ -92,6 +92,9 @@ namespace  // Unnamed namespace
     OMX_ERRORTYPE error_;
     bool transition_verified_;
   };
+
+  // Set via the --stats command line option
+  bool perf_stats_enabled = false;
 }
 
 OMX_ERRORTYPE
@@ -1204,6 +1207,74 @@ bool graph::util::is_mpris_enabled ()
   return is_enabled;
 }
 
+void graph::util::enable_perf_stats (const bool enabled)
+{
+  perf_stats_enabled = enabled;
+}
+
+bool graph::util::is_perf_stats_enabled ()
+{
+  return perf_stats_enabled;
+}
+
+void graph::util::dump_perf_stats (const omx_comp_handle_lst_t &hdl_list,
+                                   const omx_comp_name_lst_t &comp_list)
+{
+  if (!perf_stats_enabled)
+  {
+    return;
+  }
+
+  for (size_t i = 0; i < hdl_list.size (); ++i)
+  {
+    OMX_TIZONIA_PERFSTATSTYPE stats;
+    TIZ_INIT_OMX_STRUCT (stats);
+    stats.nPortIndex = OMX_ALL;
+    if (OMX_ErrorNone
+        != OMX_GetConfig (hdl_list[i], static_cast< OMX_INDEXTYPE > (
+                                           OMX_TizoniaIndexConfigPerfStats),
+                          &stats))
+    {
+      continue;
+    }
+
+    TIZ_PRINTF_C04 ("[%s] msgs: cmd %llu cfg %llu buf %llu mgmt %llu "
+                    "evt %llu other %llu | mailbox hwm %u | ticks %llu | "
+                    "msg pool hits %llu misses %llu",
+                    i < comp_list.size () ? comp_list[i].c_str () : "?",
+                    stats.nMessages[OMX_TIZONIA_PerfStatsMsgCommand],
+                    stats.nMessages[OMX_TIZONIA_PerfStatsMsgParamConfig],
+                    stats.nMessages[OMX_TIZONIA_PerfStatsMsgBuffer],
+                    stats.nMessages[OMX_TIZONIA_PerfStatsMsgBufferMgmt],
+                    stats.nMessages[OMX_TIZONIA_PerfStatsMsgEvent],
+                    stats.nMessages[OMX_TIZONIA_PerfStatsMsgOther],
+                    static_cast< unsigned int > (stats.nMailboxHighWater),
+                    stats.nTicks, stats.nMsgPoolHits, stats.nMsgPoolMisses);
+    TIZ_PRINTF_C04 ("[%s] buffers: claimed %llu released %llu bytes %llu | "
+                    "transfer_and_process %llu (%.1f ms) | "
+                    "buffers_ready %llu (%.1f ms)",
+                    i < comp_list.size () ? comp_list[i].c_str () : "?",
+                    stats.nBuffersClaimed, stats.nBuffersReleased,
+                    stats.nBytes, stats.nTransferAndProcessCalls,
+                    stats.nTransferAndProcessNs / 1e6,
+                    stats.nBuffersReadyCalls, stats.nBuffersReadyNs / 1e6);
+
+    OMX_TIZONIA_MEMSTATSTYPE mem;
+    TIZ_INIT_OMX_STRUCT (mem);
+    if (OMX_ErrorNone
+        == OMX_GetConfig (hdl_list[i], static_cast< OMX_INDEXTYPE > (
+                                           OMX_TizoniaIndexConfigMemStats),
+                          &mem))
+    {
+      TIZ_PRINTF_C04 ("[%s] memory: in use %llu peak %llu | allocs %llu "
+                      "frees %llu | failures %llu",
+                      i < comp_list.size () ? comp_list[i].c_str () : "?",
+                      mem.nBytesInUse, mem.nBytesPeak, mem.nAllocations,
+                      mem.nFrees, mem.nFailures);
+    }
+  }
+}
+
 void graph::util::copy_omx_string (
     OMX_U8 *p_dest, const std::string &omx_string,
     const size_t max_length /*  = OMX_MAX_STRINGNAME_SIZE */
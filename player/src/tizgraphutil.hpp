@@ -259,6 +259,13 @@ namespace tiz
 
       static bool is_mpris_enabled ();
 
+      static void enable_perf_stats (const bool enabled);
+
+      static bool is_perf_stats_enabled ();
+
+      static void dump_perf_stats (const omx_comp_handle_lst_t &hdl_list,
+                                   const omx_comp_name_lst_t &comp_list);
+
       static void copy_omx_string (OMX_U8 *p_dest,
                                    const std::string &omx_string,
                                    const size_t max_length
@@ -67,6 +67,7 @@
 #include "tizdaemon.hpp"
 #include "tizgraphmgr.hpp"
 #include "tizgraphtypes.hpp"
+#include "tizgraphutil.hpp"
 #include "tizomxutil.hpp"
 #include <decoders/tizdecgraphmgr.hpp>
 #include <httpclnt/tizhttpclntmgr.hpp>
@@ -646,6 +647,8 @@ void tiz::playapp::set_option_handlers ()
       "log-directory", boost::bind (&tiz::playapp::unique_log_file, this));
   popts_.set_option_handler (
       "debug-info", boost::bind (&tiz::playapp::print_debug_info, this));
+  popts_.set_option_handler (
+      "stats", boost::bind (&tiz::playapp::enable_perf_stats, this));
   // OMX-related program options
   popts_.set_option_handler ("comp-list",
                              boost::bind (&tiz::playapp::list_of_comps, this));
@@ -750,6 +753,13 @@ tiz::playapp::unique_log_file () const
   return OMX_ErrorNone;
 }
 
+OMX_ERRORTYPE
+tiz::playapp::enable_perf_stats () const
+{
+  tiz::graph::util::enable_perf_stats (popts_.stats ());
+  return OMX_ErrorNone;
+}
+
 OMX_ERRORTYPE
 tiz::playapp::print_debug_info () const
 {
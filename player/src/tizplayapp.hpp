@@ -53,6 +53,7 @@ namespace tiz
     OMX_ERRORTYPE daemonize_if_requested () const;
     OMX_ERRORTYPE unique_log_file () const;
     OMX_ERRORTYPE print_debug_info () const;
+    OMX_ERRORTYPE enable_perf_stats () const;
     OMX_ERRORTYPE list_of_comps () const;
     OMX_ERRORTYPE roles_of_comp () const;
     OMX_ERRORTYPE comp_of_role () const;
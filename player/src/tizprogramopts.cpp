@@ -340,6 +340,7 @@ tiz::programopts::programopts (int argc, char *argv[])
     proxy_password_(),
     log_dir_ (),
     debug_info_ (false),
+    stats_ (false),
     comp_name_ (),
     role_name_ (),
     port_ (TIZ_STREAMING_SERVER_DEFAULT_PORT),
@@ -737,6 +738,11 @@ bool tiz::programopts::debug_info () const
   return debug_info_;
 }
 
+bool tiz::programopts::stats () const
+{
+  return stats_;
+}
+
 const std::string &tiz::programopts::component_name () const
 {
   return comp_name_;
@@ -1619,10 +1625,14 @@ void tiz::programopts::init_debug_options ()
           "debug-info", po::bool_switch (&debug_info_)->default_value (false),
           "Print debug-related information.")
       /* TIZ_CLASS_COMMENT: */
+      ("stats", po::bool_switch (&stats_)->default_value (false),
+       "Print the performance and memory counters of each OpenMAX IL "
+       "component when its graph is destroyed.")
+      /* TIZ_CLASS_COMMENT: */
       ;
   register_consume_function (&tiz::programopts::consume_debug_options);
   all_debug_options_
-      = boost::assign::list_of ("log-directory") ("debug-info")
+      = boost::assign::list_of ("log-directory") ("debug-info") ("stats")
             .convert_to_container< std::vector< std::string > > ();
 }
 
@@ -2158,6 +2168,11 @@ int tiz::programopts::consume_debug_options (bool &done, std::string &msg)
     (void)call_handler (option_handlers_map_.find ("log-directory"));
     rc = EXIT_SUCCESS;
   }
+  if (vm_.count ("stats") && stats_)
+  {
+    (void)call_handler (option_handlers_map_.find ("stats"));
+    rc = EXIT_SUCCESS;
+  }
   if (vm_.count ("debug-info") && debug_info_)
   {
     (void)call_handler (option_handlers_map_.find ("debug-info"));
@@ -68,6 +68,7 @@ namespace tiz
     const std::string &proxy_password () const;
     const std::string &log_dir () const;
     bool debug_info () const;
+    bool stats () const;
     const std::string &component_name () const;
     const std::string &component_role () const;
     int port () const;
@@ -209,6 +210,7 @@ namespace tiz
     std::string proxy_password_;
     std::string log_dir_;
     bool debug_info_;
+    bool stats_;
     std::string comp_name_;
     std::string role_name_;
     int port_;
@@ -62,7 +62,9 @@ static OMX_ERRORTYPE allocate_temp_data_store (aacdec_prc_t *ap_prc)
                             OMX_IndexParamPortDefinition, &port_def));
 
   assert (ap_prc->p_store_ == NULL);
-  return tiz_buffer_init (&(ap_prc->p_store_), port_def.nBufferSize);
+  tiz_check_omx (tiz_buffer_init (&(ap_prc->p_store_), port_def.nBufferSize));
+  (void) tiz_buffer_seek_mode (ap_prc->p_store_, TIZ_BUFFER_RING);
+  return OMX_ErrorNone;
 }
 
 static inline void deallocate_temp_data_store (
@@ -546,7 +548,8 @@ static void reset_stream_parameters (aacdec_prc_t *ap_prc)
 
 static void *aacdec_prc_ctor (void *ap_obj, va_list *app)
 {
-  aacdec_prc_t *p_prc = super_ctor (typeOf (ap_obj, "aacdecprc"), ap_obj, app);
+  aacdec_prc_t *p_prc
+    = super_ctor (TIZ_TYPE_OF (ap_obj, "aacdecprc"), ap_obj, app);
   assert (p_prc);
   unsigned long cap = NeAACDecGetCapabilities ();
   TIZ_DEBUG (handleOf (ap_obj), "libfaad2 caps: %X", cap);
@@ -567,7 +570,7 @@ static void *aacdec_prc_dtor (void *ap_obj)
       NeAACDecClose (p_prc->p_aac_dec_);
       p_prc->p_aac_dec_ = NULL;
     }
-  return super_dtor (typeOf (p_prc, "aacdecprc"), p_prc);
+  return super_dtor (TIZ_TYPE_OF (p_prc, "aacdecprc"), p_prc);
 }
 
 /*
@@ -668,7 +671,7 @@ static OMX_ERRORTYPE aacdec_prc_port_disable (const void *ap_prc, OMX_U32 a_pid)
 static void *aacdec_prc_class_ctor (void *ap_obj, va_list *app)
 {
   /* NOTE: Class methods might be added in the future. None for now. */
-  return super_ctor (typeOf (ap_obj, "aacdecprc_class"), ap_obj, app);
+  return super_ctor (TIZ_TYPE_OF (ap_obj, "aacdecprc_class"), ap_obj, app);
 }
 
 /*
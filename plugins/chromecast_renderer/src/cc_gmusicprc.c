@@ -188,7 +188,7 @@ static void *
 cc_gmusic_prc_ctor (void * ap_obj, va_list * app)
 {
   cc_gmusic_prc_t * p_prc
-    = super_ctor (typeOf (ap_obj, "cc_gmusicprc"), ap_obj, app);
+    = super_ctor (TIZ_TYPE_OF (ap_obj, "cc_gmusicprc"), ap_obj, app);
   TIZ_INIT_OMX_STRUCT (p_prc->gm_session_);
   TIZ_INIT_OMX_STRUCT (p_prc->gm_playlist_);
   p_prc->p_gm_ = NULL;
@@ -198,7 +198,7 @@ cc_gmusic_prc_ctor (void * ap_obj, va_list * app)
 static void *
 cc_gmusic_prc_dtor (void * ap_obj)
 {
-  return super_dtor (typeOf (ap_obj, "cc_gmusicprc"), ap_obj);
+  return super_dtor (TIZ_TYPE_OF (ap_obj, "cc_gmusicprc"), ap_obj);
 }
 
 static OMX_ERRORTYPE
@@ -208,7 +208,7 @@ cc_gmusic_prc_allocate_resources (void * ap_obj, OMX_U32 a_pid)
   assert (p_prc);
 
   tiz_check_omx (tiz_srv_super_allocate_resources (
-    typeOf (p_prc, "cc_gmusicprc"), p_prc, a_pid));
+    TIZ_TYPE_OF (p_prc, "cc_gmusicprc"), p_prc, a_pid));
 
   tiz_check_omx (retrieve_gm_session (p_prc));
   tiz_check_omx (retrieve_gm_playlist (p_prc));
@@ -237,8 +237,8 @@ cc_gmusic_prc_deallocate_resources (void * ap_prc)
   assert (p_prc);
   tiz_gmusic_destroy (p_prc->p_gm_);
   p_prc->p_gm_ = NULL;
-  return tiz_srv_super_deallocate_resources (typeOf (ap_prc, "cc_gmusicprc"),
-                                             ap_prc);
+  return tiz_srv_super_deallocate_resources (
+    TIZ_TYPE_OF (ap_prc, "cc_gmusicprc"), ap_prc);
 }
 
 static const char *
@@ -352,7 +352,7 @@ static void *
 cc_gmusic_prc_class_ctor (void * ap_obj, va_list * app)
 {
   /* NOTE: Class methods might be added in the future. None for now. */
-  return super_ctor (typeOf (ap_obj, "cc_gmusicprc_class"), ap_obj, app);
+  return super_ctor (TIZ_TYPE_OF (ap_obj, "cc_gmusicprc_class"), ap_obj, app);
 }
 
 /*
@@ -103,7 +103,7 @@ static void *
 cc_http_prc_ctor (void * ap_obj, va_list * app)
 {
   cc_http_prc_t * p_prc
-    = super_ctor (typeOf (ap_obj, "cc_httpprc"), ap_obj, app);
+    = super_ctor (TIZ_TYPE_OF (ap_obj, "cc_httpprc"), ap_obj, app);
   p_prc->p_content_uri_ = NULL;
   return p_prc;
 }
@@ -112,7 +112,7 @@ static void *
 cc_http_prc_dtor (void * ap_obj)
 {
   delete_url (ap_obj);
-  return super_dtor (typeOf (ap_obj, "cc_httpprc"), ap_obj);
+  return super_dtor (TIZ_TYPE_OF (ap_obj, "cc_httpprc"), ap_obj);
 }
 
 /*
@@ -125,8 +125,9 @@ cc_http_prc_allocate_resources (void * ap_obj, OMX_U32 a_pid)
   cc_http_prc_t * p_prc = ap_obj;
   assert (p_prc);
 
-  tiz_check_omx (tiz_srv_super_allocate_resources (typeOf (p_prc, "cc_httpprc"),
-                                                   p_prc, a_pid));
+  tiz_check_omx (
+    tiz_srv_super_allocate_resources (TIZ_TYPE_OF (p_prc, "cc_httpprc"), p_prc,
+                                      a_pid));
 
   return obtain_url (ap_obj);
 }
@@ -135,7 +136,7 @@ static OMX_ERRORTYPE
 cc_http_prc_deallocate_resources (void * ap_prc)
 {
   delete_url (ap_prc);
-  return tiz_srv_super_deallocate_resources (typeOf (ap_prc, "cc_httpprc"),
+  return tiz_srv_super_deallocate_resources (TIZ_TYPE_OF (ap_prc, "cc_httpprc"),
                                              ap_prc);
 }
 
@@ -193,7 +194,7 @@ static void *
 cc_http_prc_class_ctor (void * ap_obj, va_list * app)
 {
   /* NOTE: Class methods might be added in the future. None for now. */
-  return super_ctor (typeOf (ap_obj, "cc_httpprc_class"), ap_obj, app);
+  return super_ctor (TIZ_TYPE_OF (ap_obj, "cc_httpprc_class"), ap_obj, app);
 }
 
 /*
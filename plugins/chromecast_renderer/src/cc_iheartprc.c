@@ -135,7 +135,7 @@ static void *
 cc_iheart_prc_ctor (void * ap_obj, va_list * app)
 {
   cc_iheart_prc_t * p_prc
-    = super_ctor (typeOf (ap_obj, "cc_iheartprc"), ap_obj, app);
+    = super_ctor (TIZ_TYPE_OF (ap_obj, "cc_iheartprc"), ap_obj, app);
   TIZ_INIT_OMX_STRUCT (p_prc->iheart_session_);
   TIZ_INIT_OMX_STRUCT (p_prc->iheart_playlist_);
   p_prc->p_iheart_ = NULL;
@@ -146,7 +146,7 @@ cc_iheart_prc_ctor (void * ap_obj, va_list * app)
 static void *
 cc_iheart_prc_dtor (void * ap_obj)
 {
-  return super_dtor (typeOf (ap_obj, "cc_iheartprc"), ap_obj);
+  return super_dtor (TIZ_TYPE_OF (ap_obj, "cc_iheartprc"), ap_obj);
 }
 
 /*
@@ -160,7 +160,7 @@ cc_iheart_prc_allocate_resources (void * ap_obj, OMX_U32 a_pid)
   assert (p_prc);
 
   tiz_check_omx (tiz_srv_super_allocate_resources (
-    typeOf (p_prc, "cc_iheartprc"), p_prc, a_pid));
+    TIZ_TYPE_OF (p_prc, "cc_iheartprc"), p_prc, a_pid));
 
   tiz_check_omx (retrieve_iheart_session (p_prc));
   tiz_check_omx (retrieve_iheart_playlist (p_prc));
@@ -180,8 +180,8 @@ cc_iheart_prc_deallocate_resources (void * ap_prc)
   assert (p_prc);
   tiz_iheart_destroy (p_prc->p_iheart_);
   p_prc->p_iheart_ = NULL;
-  return tiz_srv_super_deallocate_resources (typeOf (ap_prc, "cc_iheartprc"),
-                                             ap_prc);
+  return tiz_srv_super_deallocate_resources (
+    TIZ_TYPE_OF (ap_prc, "cc_iheartprc"), ap_prc);
 }
 
 static const char *
@@ -270,7 +270,7 @@ static void *
 cc_iheart_prc_class_ctor (void * ap_obj, va_list * app)
 {
   /* NOTE: Class methods might be added in the future. None for now. */
-  return super_ctor (typeOf (ap_obj, "cc_iheartprc_class"), ap_obj, app);
+  return super_ctor (TIZ_TYPE_OF (ap_obj, "cc_iheartprc_class"), ap_obj, app);
 }
 
 /*
@@ -52,7 +52,7 @@ static void *
 cc_plex_cfgport_ctor (void * ap_obj, va_list * app)
 {
   cc_plex_cfgport_t * p_obj
-    = super_ctor (typeOf (ap_obj, "cc_plexcfgport"), ap_obj, app);
+    = super_ctor (TIZ_TYPE_OF (ap_obj, "cc_plexcfgport"), ap_obj, app);
 
   assert (p_obj);
 
@@ -83,7 +83,7 @@ cc_plex_cfgport_ctor (void * ap_obj, va_list * app)
 static void *
 cc_plex_cfgport_dtor (void * ap_obj)
 {
-  return super_dtor (typeOf (ap_obj, "cc_plexcfgport"), ap_obj);
+  return super_dtor (TIZ_TYPE_OF (ap_obj, "cc_plexcfgport"), ap_obj);
 }
 
 /*
@@ -115,7 +115,7 @@ cc_plex_cfgport_GetParameter (const void * ap_obj, OMX_HANDLETYPE ap_hdl,
   else
     {
       /* Delegate to the base port */
-      rc = super_GetParameter (typeOf (ap_obj, "cc_plexcfgport"), ap_obj,
+      rc = super_GetParameter (TIZ_TYPE_OF (ap_obj, "cc_plexcfgport"), ap_obj,
                                ap_hdl, a_index, ap_struct);
     }
 
@@ -153,7 +153,7 @@ cc_plex_cfgport_SetParameter (const void * ap_obj, OMX_HANDLETYPE ap_hdl,
   else
     {
       /* Delegate to the base port */
-      rc = super_SetParameter (typeOf (ap_obj, "cc_plexcfgport"), ap_obj,
+      rc = super_SetParameter (TIZ_TYPE_OF (ap_obj, "cc_plexcfgport"), ap_obj,
                                ap_hdl, a_index, ap_struct);
     }
 
@@ -168,7 +168,7 @@ static void *
 cc_plex_cfgport_class_ctor (void * ap_obj, va_list * app)
 {
   /* NOTE: Class methods might be added in the future. None for now. */
-  return super_ctor (typeOf (ap_obj, "cc_plexcfgport_class"), ap_obj, app);
+  return super_ctor (TIZ_TYPE_OF (ap_obj, "cc_plexcfgport_class"), ap_obj, app);
 }
 
 /*
@@ -145,7 +145,7 @@ static void *
 cc_plex_prc_ctor (void * ap_obj, va_list * app)
 {
   cc_plex_prc_t * p_prc
-    = super_ctor (typeOf (ap_obj, "cc_plexprc"), ap_obj, app);
+    = super_ctor (TIZ_TYPE_OF (ap_obj, "cc_plexprc"), ap_obj, app);
   TIZ_INIT_OMX_STRUCT (p_prc->sc_session_);
   TIZ_INIT_OMX_STRUCT (p_prc->sc_playlist_);
   p_prc->p_plex_ = NULL;
@@ -156,7 +156,7 @@ cc_plex_prc_ctor (void * ap_obj, va_list * app)
 static void *
 cc_plex_prc_dtor (void * ap_obj)
 {
-  return super_dtor (typeOf (ap_obj, "cc_plexprc"), ap_obj);
+  return super_dtor (TIZ_TYPE_OF (ap_obj, "cc_plexprc"), ap_obj);
 }
 
 /*
@@ -169,8 +169,9 @@ cc_plex_prc_allocate_resources (void * ap_obj, OMX_U32 a_pid)
   cc_plex_prc_t * p_prc = ap_obj;
   assert (p_prc);
 
-  tiz_check_omx (tiz_srv_super_allocate_resources (typeOf (p_prc, "cc_plexprc"),
-                                                   p_prc, a_pid));
+  tiz_check_omx (
+    tiz_srv_super_allocate_resources (TIZ_TYPE_OF (p_prc, "cc_plexprc"), p_prc,
+                                      a_pid));
 
   tiz_check_omx (retrieve_plex_session (p_prc));
   tiz_check_omx (retrieve_plex_playlist (p_prc));
@@ -192,7 +193,7 @@ cc_plex_prc_deallocate_resources (void * ap_prc)
   assert (p_prc);
   tiz_plex_destroy (p_prc->p_plex_);
   p_prc->p_plex_ = NULL;
-  return tiz_srv_super_deallocate_resources (typeOf (ap_prc, "cc_plexprc"),
+  return tiz_srv_super_deallocate_resources (TIZ_TYPE_OF (ap_prc, "cc_plexprc"),
                                              ap_prc);
 }
 
@@ -288,7 +289,7 @@ static void *
 cc_plex_prc_class_ctor (void * ap_obj, va_list * app)
 {
   /* NOTE: Class methods might be added in the future. None for now. */
-  return super_ctor (typeOf (ap_obj, "cc_plexprc_class"), ap_obj, app);
+  return super_ctor (TIZ_TYPE_OF (ap_obj, "cc_plexprc_class"), ap_obj, app);
 }
 
 /*
@@ -485,7 +485,7 @@ toggle_mute (cc_prc_t * ap_prc, const bool a_mute)
 static void *
 prc_ctor (void * ap_obj, va_list * app)
 {
-  cc_prc_t * p_prc = super_ctor (typeOf (ap_obj, "cc_prc"), ap_obj, app);
+  cc_prc_t * p_prc = super_ctor (TIZ_TYPE_OF (ap_obj, "cc_prc"), ap_obj, app);
   assert (p_prc);
   TIZ_INIT_OMX_STRUCT (p_prc->cc_session_);
   TIZ_INIT_OMX_STRUCT (p_prc->pl_skip_);
@@ -505,7 +505,7 @@ static void *
 prc_dtor (void * ap_obj)
 {
   (void) tiz_srv_deallocate_resources (ap_obj);
-  return super_dtor (typeOf (ap_obj, "cc_prc"), ap_obj);
+  return super_dtor (TIZ_TYPE_OF (ap_obj, "cc_prc"), ap_obj);
 }
 
 static OMX_ERRORTYPE
@@ -855,7 +855,7 @@ static void *
 cc_prc_class_ctor (void * ap_obj, va_list * app)
 {
   cc_prc_class_t * p_obj
-    = super_ctor (typeOf (ap_obj, "cc_prc_class"), ap_obj, app);
+    = super_ctor (TIZ_TYPE_OF (ap_obj, "cc_prc_class"), ap_obj, app);
   typedef void (*voidf) ();
   voidf selector = NULL;
   va_list ap;
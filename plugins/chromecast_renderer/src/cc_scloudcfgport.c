@@ -52,7 +52,7 @@ static void *
 cc_scloud_cfgport_ctor (void * ap_obj, va_list * app)
 {
   cc_scloud_cfgport_t * p_obj
-    = super_ctor (typeOf (ap_obj, "cc_scloudcfgport"), ap_obj, app);
+    = super_ctor (TIZ_TYPE_OF (ap_obj, "cc_scloudcfgport"), ap_obj, app);
 
   assert (p_obj);
 
@@ -84,7 +84,7 @@ cc_scloud_cfgport_ctor (void * ap_obj, va_list * app)
 static void *
 cc_scloud_cfgport_dtor (void * ap_obj)
 {
-  return super_dtor (typeOf (ap_obj, "cc_scloudcfgport"), ap_obj);
+  return super_dtor (TIZ_TYPE_OF (ap_obj, "cc_scloudcfgport"), ap_obj);
 }
 
 /*
@@ -116,7 +116,7 @@ cc_scloud_cfgport_GetParameter (const void * ap_obj, OMX_HANDLETYPE ap_hdl,
   else
     {
       /* Delegate to the base port */
-      rc = super_GetParameter (typeOf (ap_obj, "cc_scloudcfgport"), ap_obj,
+      rc = super_GetParameter (TIZ_TYPE_OF (ap_obj, "cc_scloudcfgport"), ap_obj,
                                ap_hdl, a_index, ap_struct);
     }
 
@@ -156,7 +156,7 @@ cc_scloud_cfgport_SetParameter (const void * ap_obj, OMX_HANDLETYPE ap_hdl,
   else
     {
       /* Delegate to the base port */
-      rc = super_SetParameter (typeOf (ap_obj, "cc_scloudcfgport"), ap_obj,
+      rc = super_SetParameter (TIZ_TYPE_OF (ap_obj, "cc_scloudcfgport"), ap_obj,
                                ap_hdl, a_index, ap_struct);
     }
 
@@ -171,7 +171,8 @@ static void *
 cc_scloud_cfgport_class_ctor (void * ap_obj, va_list * app)
 {
   /* NOTE: Class methods might be added in the future. None for now. */
-  return super_ctor (typeOf (ap_obj, "cc_scloudcfgport_class"), ap_obj, app);
+  return super_ctor (TIZ_TYPE_OF (ap_obj, "cc_scloudcfgport_class"), ap_obj,
+                     app);
 }
 
 /*
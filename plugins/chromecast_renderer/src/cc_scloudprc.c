@@ -165,7 +165,7 @@ static void *
 cc_scloud_prc_ctor (void * ap_obj, va_list * app)
 {
   cc_scloud_prc_t * p_prc
-    = super_ctor (typeOf (ap_obj, "cc_scloudprc"), ap_obj, app);
+    = super_ctor (TIZ_TYPE_OF (ap_obj, "cc_scloudprc"), ap_obj, app);
   TIZ_INIT_OMX_STRUCT (p_prc->sc_session_);
   TIZ_INIT_OMX_STRUCT (p_prc->sc_playlist_);
   p_prc->p_sc_ = NULL;
@@ -175,7 +175,7 @@ cc_scloud_prc_ctor (void * ap_obj, va_list * app)
 static void *
 cc_scloud_prc_dtor (void * ap_obj)
 {
-  return super_dtor (typeOf (ap_obj, "cc_scloudprc"), ap_obj);
+  return super_dtor (TIZ_TYPE_OF (ap_obj, "cc_scloudprc"), ap_obj);
 }
 
 /*
@@ -189,7 +189,7 @@ cc_scloud_prc_allocate_resources (void * ap_obj, OMX_U32 a_pid)
   assert (p_prc);
 
   tiz_check_omx (tiz_srv_super_allocate_resources (
-    typeOf (p_prc, "cc_scloudprc"), p_prc, a_pid));
+    TIZ_TYPE_OF (p_prc, "cc_scloudprc"), p_prc, a_pid));
 
   tiz_check_omx (retrieve_sc_session (p_prc));
   tiz_check_omx (retrieve_sc_playlist (p_prc));
@@ -209,8 +209,8 @@ cc_scloud_prc_deallocate_resources (void * ap_prc)
   assert (p_prc);
   tiz_scloud_destroy (p_prc->p_sc_);
   p_prc->p_sc_ = NULL;
-  return tiz_srv_super_deallocate_resources (typeOf (ap_prc, "cc_scloudprc"),
-                                             ap_prc);
+  return tiz_srv_super_deallocate_resources (
+    TIZ_TYPE_OF (ap_prc, "cc_scloudprc"), ap_prc);
 }
 
 static const char *
@@ -299,7 +299,7 @@ static void *
 cc_scloud_prc_class_ctor (void * ap_obj, va_list * app)
 {
   /* NOTE: Class methods might be added in the future. None for now. */
-  return super_ctor (typeOf (ap_obj, "cc_scloudprc_class"), ap_obj, app);
+  return super_ctor (TIZ_TYPE_OF (ap_obj, "cc_scloudprc_class"), ap_obj, app);
 }
 
 /*
@@ -169,7 +169,7 @@ static void *
 cc_tunein_prc_ctor (void * ap_obj, va_list * app)
 {
   cc_tunein_prc_t * p_prc
-    = super_ctor (typeOf (ap_obj, "cc_tuneinprc"), ap_obj, app);
+    = super_ctor (TIZ_TYPE_OF (ap_obj, "cc_tuneinprc"), ap_obj, app);
   TIZ_INIT_OMX_STRUCT (p_prc->tunein_session_);
   TIZ_INIT_OMX_STRUCT (p_prc->tunein_playlist_);
   p_prc->p_tunein_ = NULL;
@@ -180,7 +180,7 @@ cc_tunein_prc_ctor (void * ap_obj, va_list * app)
 static void *
 cc_tunein_prc_dtor (void * ap_obj)
 {
-  return super_dtor (typeOf (ap_obj, "cc_tuneinprc"), ap_obj);
+  return super_dtor (TIZ_TYPE_OF (ap_obj, "cc_tuneinprc"), ap_obj);
 }
 
 /*
@@ -194,7 +194,7 @@ cc_tunein_prc_allocate_resources (void * ap_obj, OMX_U32 a_pid)
   assert (p_prc);
 
   tiz_check_omx (tiz_srv_super_allocate_resources (
-    typeOf (p_prc, "cc_tuneinprc"), p_prc, a_pid));
+    TIZ_TYPE_OF (p_prc, "cc_tuneinprc"), p_prc, a_pid));
 
   tiz_check_omx (retrieve_tunein_session (p_prc));
   tiz_check_omx (retrieve_tunein_playlist (p_prc));
@@ -214,8 +214,8 @@ cc_tunein_prc_deallocate_resources (void * ap_prc)
   assert (p_prc);
   tiz_tunein_destroy (p_prc->p_tunein_);
   p_prc->p_tunein_ = NULL;
-  return tiz_srv_super_deallocate_resources (typeOf (ap_prc, "cc_tuneinprc"),
-                                             ap_prc);
+  return tiz_srv_super_deallocate_resources (
+    TIZ_TYPE_OF (ap_prc, "cc_tuneinprc"), ap_prc);
 }
 
 static const char *
@@ -309,7 +309,7 @@ static void *
 cc_tunein_prc_class_ctor (void * ap_obj, va_list * app)
 {
   /* NOTE: Class methods might be added in the future. None for now. */
-  return super_ctor (typeOf (ap_obj, "cc_tuneinprc_class"), ap_obj, app);
+  return super_ctor (TIZ_TYPE_OF (ap_obj, "cc_tuneinprc_class"), ap_obj, app);
 }
 
 /*
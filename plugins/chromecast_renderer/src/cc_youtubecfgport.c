@@ -52,7 +52,7 @@ static void *
 cc_youtube_cfgport_ctor (void * ap_obj, va_list * app)
 {
   cc_youtube_cfgport_t * p_obj
-    = super_ctor (typeOf (ap_obj, "cc_youtubecfgport"), ap_obj, app);
+    = super_ctor (TIZ_TYPE_OF (ap_obj, "cc_youtubecfgport"), ap_obj, app);
 
   assert (p_obj);
 
@@ -79,7 +79,7 @@ cc_youtube_cfgport_ctor (void * ap_obj, va_list * app)
 static void *
 cc_youtube_cfgport_dtor (void * ap_obj)
 {
-  return super_dtor (typeOf (ap_obj, "cc_youtubecfgport"), ap_obj);
+  return super_dtor (TIZ_TYPE_OF (ap_obj, "cc_youtubecfgport"), ap_obj);
 }
 
 /*
@@ -111,8 +111,8 @@ cc_youtube_cfgport_GetParameter (const void * ap_obj, OMX_HANDLETYPE ap_hdl,
   else
     {
       /* Delegate to the base port */
-      rc = super_GetParameter (typeOf (ap_obj, "cc_youtubecfgport"), ap_obj,
-                               ap_hdl, a_index, ap_struct);
+      rc = super_GetParameter (TIZ_TYPE_OF (ap_obj, "cc_youtubecfgport"),
+                               ap_obj, ap_hdl, a_index, ap_struct);
     }
 
   return rc;
@@ -148,8 +148,8 @@ cc_youtube_cfgport_SetParameter (const void * ap_obj, OMX_HANDLETYPE ap_hdl,
   else
     {
       /* Delegate to the base port */
-      rc = super_SetParameter (typeOf (ap_obj, "cc_youtubecfgport"), ap_obj,
-                               ap_hdl, a_index, ap_struct);
+      rc = super_SetParameter (TIZ_TYPE_OF (ap_obj, "cc_youtubecfgport"),
+                               ap_obj, ap_hdl, a_index, ap_struct);
     }
 
   return rc;
@@ -163,7 +163,8 @@ static void *
 cc_youtube_cfgport_class_ctor (void * ap_obj, va_list * app)
 {
   /* NOTE: Class methods might be added in the future. None for now. */
-  return super_ctor (typeOf (ap_obj, "cc_youtubecfgport_class"), ap_obj, app);
+  return super_ctor (TIZ_TYPE_OF (ap_obj, "cc_youtubecfgport_class"), ap_obj,
+                     app);
 }
 
 /*
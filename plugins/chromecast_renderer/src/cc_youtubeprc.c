@@ -163,7 +163,7 @@ static void *
 cc_youtube_prc_ctor (void * ap_obj, va_list * app)
 {
   cc_youtube_prc_t * p_prc
-    = super_ctor (typeOf (ap_obj, "cc_youtubeprc"), ap_obj, app);
+    = super_ctor (TIZ_TYPE_OF (ap_obj, "cc_youtubeprc"), ap_obj, app);
   TIZ_INIT_OMX_STRUCT (p_prc->yt_session_);
   TIZ_INIT_OMX_STRUCT (p_prc->yt_playlist_);
   p_prc->p_yt_ = NULL;
@@ -174,7 +174,7 @@ cc_youtube_prc_ctor (void * ap_obj, va_list * app)
 static void *
 cc_youtube_prc_dtor (void * ap_obj)
 {
-  return super_dtor (typeOf (ap_obj, "cc_youtubeprc"), ap_obj);
+  return super_dtor (TIZ_TYPE_OF (ap_obj, "cc_youtubeprc"), ap_obj);
 }
 
 /*
@@ -188,7 +188,7 @@ cc_youtube_prc_allocate_resources (void * ap_obj, OMX_U32 a_pid)
   assert (p_prc);
 
   tiz_check_omx (tiz_srv_super_allocate_resources (
-    typeOf (p_prc, "cc_youtubeprc"), p_prc, a_pid));
+    TIZ_TYPE_OF (p_prc, "cc_youtubeprc"), p_prc, a_pid));
 
   tiz_check_omx (retrieve_yt_session (p_prc));
   tiz_check_omx (retrieve_yt_playlist (p_prc));
@@ -208,8 +208,8 @@ cc_youtube_prc_deallocate_resources (void * ap_prc)
   assert (p_prc);
   tiz_youtube_destroy (p_prc->p_yt_);
   p_prc->p_yt_ = NULL;
-  return tiz_srv_super_deallocate_resources (typeOf (ap_prc, "cc_youtubeprc"),
-                                             ap_prc);
+  return tiz_srv_super_deallocate_resources (
+    TIZ_TYPE_OF (ap_prc, "cc_youtubeprc"), ap_prc);
 }
 
 static const char *
@@ -309,7 +309,7 @@ static void *
 cc_youtube_prc_class_ctor (void * ap_obj, va_list * app)
 {
   /* NOTE: Class methods might be added in the future. None for now. */
-  return super_ctor (typeOf (ap_obj, "cc_youtubeprc_class"), ap_obj, app);
+  return super_ctor (TIZ_TYPE_OF (ap_obj, "cc_youtubeprc_class"), ap_obj, app);
 }
 
 /*
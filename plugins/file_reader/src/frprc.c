@@ -176,7 +176,7 @@ read_into_buffer (const void * ap_obj, OMX_BUFFERHEADERTYPE * p_hdr)
 static void *
 fr_prc_ctor (void * ap_obj, va_list * app)
 {
-  fr_prc_t * p_prc = super_ctor (typeOf (ap_obj, "frprc"), ap_obj, app);
+  fr_prc_t * p_prc = super_ctor (TIZ_TYPE_OF (ap_obj, "frprc"), ap_obj, app);
   assert (p_prc);
   p_prc->p_file_ = NULL;
   p_prc->p_uri_param_ = NULL;
@@ -188,7 +188,7 @@ static void *
 fr_prc_dtor (void * ap_obj)
 {
   (void) fr_prc_deallocate_resources (ap_obj);
-  return super_dtor (typeOf (ap_obj, "frprc"), ap_obj);
+  return super_dtor (TIZ_TYPE_OF (ap_obj, "frprc"), ap_obj);
 }
 
 /*
@@ -285,7 +285,7 @@ static void *
 fr_prc_class_ctor (void * ap_obj, va_list * app)
 {
   /* NOTE: Class methods might be added in the future. None for now. */
-  return super_ctor (typeOf (ap_obj, "frprc_class"), ap_obj, app);
+  return super_ctor (TIZ_TYPE_OF (ap_obj, "frprc_class"), ap_obj, app);
 }
 
 /*
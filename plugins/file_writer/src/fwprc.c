@@ -102,7 +102,7 @@ obtain_uri (fw_prc_t * ap_prc)
 static void *
 fw_proc_ctor (void * ap_obj, va_list * app)
 {
-  fw_prc_t * p_prc = super_ctor (typeOf (ap_obj, "fwprc"), ap_obj, app);
+  fw_prc_t * p_prc = super_ctor (TIZ_TYPE_OF (ap_obj, "fwprc"), ap_obj, app);
   assert (p_prc);
   p_prc->p_file_ = NULL;
   p_prc->p_uri_param_ = NULL;
@@ -127,7 +127,7 @@ fw_proc_dtor (void * ap_obj)
       tiz_mem_free (p_prc->p_uri_param_);
     }
 
-  return super_dtor (typeOf (ap_obj, "fwprc"), ap_obj);
+  return super_dtor (TIZ_TYPE_OF (ap_obj, "fwprc"), ap_obj);
 }
 
 static OMX_ERRORTYPE
@@ -273,7 +273,7 @@ static void *
 fw_prc_class_ctor (void * ap_obj, va_list * app)
 {
   /* NOTE: Class methods might be added in the future. None for now. */
-  return super_ctor (typeOf (ap_obj, "fwprc_class"), ap_obj, app);
+  return super_ctor (TIZ_TYPE_OF (ap_obj, "fwprc_class"), ap_obj, app);
 }
 
 /*
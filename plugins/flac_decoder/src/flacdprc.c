@@ -619,7 +619,8 @@ reset_stream_parameters (flacd_prc_t * ap_prc)
 static void *
 flacd_prc_ctor (void * ap_obj, va_list * app)
 {
-  flacd_prc_t * p_prc = super_ctor (typeOf (ap_obj, "flacdprc"), ap_obj, app);
+  flacd_prc_t * p_prc
+    = super_ctor (TIZ_TYPE_OF (ap_obj, "flacdprc"), ap_obj, app);
   assert (p_prc);
   p_prc->p_flac_dec_ = NULL;
   p_prc->p_in_hdr_ = NULL;
@@ -638,7 +639,7 @@ static void *
 flacd_prc_dtor (void * ap_obj)
 {
   (void) flacd_prc_deallocate_resources (ap_obj);
-  return super_dtor (typeOf (ap_obj, "flacdprc"), ap_obj);
+  return super_dtor (TIZ_TYPE_OF (ap_obj, "flacdprc"), ap_obj);
 }
 
 /*
@@ -746,7 +747,7 @@ static void *
 flacd_prc_class_ctor (void * ap_obj, va_list * app)
 {
   /* NOTE: Class methods might be added in the future. None for now. */
-  return super_ctor (typeOf (ap_obj, "flacdprc_class"), ap_obj, app);
+  return super_ctor (TIZ_TYPE_OF (ap_obj, "flacdprc_class"), ap_obj, app);
 }
 
 /*
@@ -53,7 +53,7 @@ static void *
 httpr_cfgport_ctor (void * ap_obj, va_list * app)
 {
   httpr_cfgport_t * p_obj
-    = super_ctor (typeOf (ap_obj, "httprcfgport"), ap_obj, app);
+    = super_ctor (TIZ_TYPE_OF (ap_obj, "httprcfgport"), ap_obj, app);
 
   assert (p_obj);
 
@@ -70,7 +70,7 @@ httpr_cfgport_ctor (void * ap_obj, va_list * app)
 static void *
 httpr_cfgport_dtor (void * ap_obj)
 {
-  return super_dtor (typeOf (ap_obj, "httprcfgport"), ap_obj);
+  return super_dtor (TIZ_TYPE_OF (ap_obj, "httprcfgport"), ap_obj);
 }
 
 /*
@@ -98,8 +98,8 @@ httpr_cfgport_GetParameter (const void * ap_obj, OMX_HANDLETYPE ap_hdl,
   else
     {
       /* Delegate to the base port */
-      rc = super_GetParameter (typeOf (ap_obj, "httprcfgport"), ap_obj, ap_hdl,
-                               a_index, ap_struct);
+      rc = super_GetParameter (TIZ_TYPE_OF (ap_obj, "httprcfgport"), ap_obj,
+                               ap_hdl, a_index, ap_struct);
     }
 
   return rc;
@@ -129,8 +129,8 @@ httpr_cfgport_SetParameter (const void * ap_obj, OMX_HANDLETYPE ap_hdl,
   else
     {
       /* Delegate to the base port */
-      rc = super_SetParameter (typeOf (ap_obj, "httprcfgport"), ap_obj, ap_hdl,
-                               a_index, ap_struct);
+      rc = super_SetParameter (TIZ_TYPE_OF (ap_obj, "httprcfgport"), ap_obj,
+                               ap_hdl, a_index, ap_struct);
     }
 
   return rc;
@@ -144,7 +144,7 @@ static void *
 httpr_cfgport_class_ctor (void * ap_obj, va_list * app)
 {
   /* NOTE: Class methods might be added in the future. None for now. */
-  return super_ctor (typeOf (ap_obj, "httprcfgport_class"), ap_obj, app);
+  return super_ctor (TIZ_TYPE_OF (ap_obj, "httprcfgport_class"), ap_obj, app);
 }
 
 /*
@@ -53,7 +53,7 @@ static void *
 httpr_mp3port_ctor (void * ap_obj, va_list * app)
 {
   httpr_mp3port_t * p_obj
-    = super_ctor (typeOf (ap_obj, "httprmp3port"), ap_obj, app);
+    = super_ctor (TIZ_TYPE_OF (ap_obj, "httprmp3port"), ap_obj, app);
   assert (p_obj);
 
   tiz_port_register_index (p_obj, OMX_TizoniaIndexParamIcecastMountpoint);
@@ -92,7 +92,7 @@ httpr_mp3port_dtor (void * ap_obj)
   httpr_mp3port_t * p_obj = ap_obj;
   assert (p_obj);
   tiz_mem_free (p_obj->p_stream_title_);
-  return super_dtor (typeOf (ap_obj, "httprmp3port"), ap_obj);
+  return super_dtor (TIZ_TYPE_OF (ap_obj, "httprmp3port"), ap_obj);
 }
 
 /*
@@ -118,8 +118,8 @@ httpr_mp3port_GetParameter (const void * ap_obj, OMX_HANDLETYPE ap_hdl,
   else
     {
       /* Delegate to the base port */
-      rc = super_GetParameter (typeOf (ap_obj, "httprmp3port"), ap_obj, ap_hdl,
-                               a_index, ap_struct);
+      rc = super_GetParameter (TIZ_TYPE_OF (ap_obj, "httprmp3port"), ap_obj,
+                               ap_hdl, a_index, ap_struct);
     }
 
   return rc;
@@ -151,8 +151,8 @@ httpr_mp3port_SetParameter (const void * ap_obj, OMX_HANDLETYPE ap_hdl,
   else
     {
       /* Try the parent's indexes */
-      rc = super_SetParameter (typeOf (ap_obj, "httprmp3port"), ap_obj, ap_hdl,
-                               a_index, ap_struct);
+      rc = super_SetParameter (TIZ_TYPE_OF (ap_obj, "httprmp3port"), ap_obj,
+                               ap_hdl, a_index, ap_struct);
     }
 
   return rc;
@@ -205,8 +205,8 @@ httpr_mp3port_GetConfig (const void * ap_obj, OMX_HANDLETYPE ap_hdl,
   else
     {
       /* Delegate to the base port */
-      rc = super_GetConfig (typeOf (ap_obj, "httprmp3port"), ap_obj, ap_hdl,
-                            a_index, ap_struct);
+      rc = super_GetConfig (TIZ_TYPE_OF (ap_obj, "httprmp3port"), ap_obj,
+                            ap_hdl, a_index, ap_struct);
     }
 
   return rc;
@@ -255,8 +255,8 @@ httpr_mp3port_SetConfig (const void * ap_obj, OMX_HANDLETYPE ap_hdl,
   else
     {
       /* Delegate to the base port */
-      rc = super_SetConfig (typeOf (ap_obj, "httprmp3port"), ap_obj, ap_hdl,
-                            a_index, ap_struct);
+      rc = super_SetConfig (TIZ_TYPE_OF (ap_obj, "httprmp3port"), ap_obj,
+                            ap_hdl, a_index, ap_struct);
     }
 
   return rc;
@@ -270,7 +270,7 @@ static void *
 httpr_mp3port_class_ctor (void * ap_obj, va_list * app)
 {
   /* NOTE: Class methods might be added in the future. None for now. */
-  return super_ctor (typeOf (ap_obj, "httprmp3port_class"), ap_obj, app);
+  return super_ctor (TIZ_TYPE_OF (ap_obj, "httprmp3port_class"), ap_obj, app);
 }
 
 /*
@@ -155,7 +155,8 @@ retrieve_mountpoint_settings (const void * ap_prc,
 static void *
 httpr_prc_ctor (void * ap_prc, va_list * app)
 {
-  httpr_prc_t * p_prc = super_ctor (typeOf (ap_prc, "httprprc"), ap_prc, app);
+  httpr_prc_t * p_prc
+    = super_ctor (TIZ_TYPE_OF (ap_prc, "httprprc"), ap_prc, app);
   assert (p_prc);
   p_prc->mount_name_ = NULL;
   p_prc->port_disabled_ = false;
@@ -167,7 +168,7 @@ httpr_prc_ctor (void * ap_prc, va_list * app)
 static void *
 httpr_prc_dtor (void * ap_prc)
 {
-  return super_dtor (typeOf (ap_prc, "httprprc"), ap_prc);
+  return super_dtor (TIZ_TYPE_OF (ap_prc, "httprprc"), ap_prc);
 }
 
 /*
@@ -387,7 +388,7 @@ static void *
 httpr_prc_class_ctor (void * ap_prc, va_list * app)
 {
   /* NOTE: Class methods might be added in the future. None for now. */
-  return super_ctor (typeOf (ap_prc, "httprprc_class"), ap_prc, app);
+  return super_ctor (TIZ_TYPE_OF (ap_prc, "httprprc_class"), ap_prc, app);
 }
 
 /*
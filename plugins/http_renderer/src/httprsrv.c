@@ -131,7 +131,7 @@ struct httpr_server
   tiz_event_io_t * p_srv_ev_io;
   OMX_U32 max_clients; /* In future, more than one will be allowed;
                           only one allowed at the moment. */
-  tiz_map_t * p_lstnrs;
+  tiz_hmap_t * p_lstnrs; /* sockfd -> listener */
   OMX_BUFFERHEADERTYPE * p_hdr;
   httpr_srv_release_buffer_f pf_release_buf;
   httpr_srv_acquire_buffer_f pf_acquire_buf;
@@ -151,18 +151,8 @@ struct httpr_server
 static void
 srv_destroy_listener (httpr_listener_t * ap_lstnr);
 
-static OMX_S32
-listeners_map_compare_func (OMX_PTR ap_key1, OMX_PTR ap_key2)
-{
-  int * p_sockfd1 = (int *) ap_key1;
-  int * p_sockfd2 = (int *) ap_key2;
-  assert (ap_key1);
-  assert (ap_key2);
-  return (*p_sockfd1 == *p_sockfd2) ? 0 : ((*p_sockfd1 < *p_sockfd2) ? -1 : 1);
-}
-
 static void
-listeners_map_free_func (OMX_PTR ap_key, OMX_PTR ap_value)
+listeners_map_free_func (uintptr_t a_sockfd, OMX_PTR ap_value)
 {
   httpr_listener_t * p_lstnr = (httpr_listener_t *) ap_value;
   assert (p_lstnr);
@@ -211,7 +201,7 @@ srv_get_listeners_count (const httpr_server_t * ap_server)
   int rc = 0;
   if (ap_server && ap_server->p_lstnrs)
     {
-      rc = tiz_map_size (ap_server->p_lstnrs);
+      rc = tiz_hmap_size (ap_server->p_lstnrs);
     }
   return rc;
 }
@@ -219,12 +209,14 @@ srv_get_listeners_count (const httpr_server_t * ap_server)
 static httpr_listener_t *
 srv_get_first_listener (const httpr_server_t * ap_server)
 {
-  httpr_listener_t * p_lstnr = NULL;
+  OMX_PTR p_lstnr = NULL;
   if (srv_get_listeners_count (ap_server) > 0)
     {
-      p_lstnr = tiz_map_value_at (ap_server->p_lstnrs, 0);
+      tiz_hmap_iter_t iter;
+      tiz_hmap_iter_init (ap_server->p_lstnrs, &iter);
+      (void) tiz_hmap_iter_next (&iter, NULL, &p_lstnr);
     }
-  return p_lstnr;
+  return (httpr_listener_t *) p_lstnr;
 }
 
 static int
@@ -556,7 +548,7 @@ srv_remove_listener (httpr_server_t * ap_server, httpr_listener_t * ap_lstnr)
            "Destroyed listener [%s] - [%d] listeners remaining",
            ap_lstnr->p_con->p_ip, nlstnrs - 1);
 
-  tiz_map_erase (ap_server->p_lstnrs, &ap_lstnr->p_con->sockfd);
+  tiz_hmap_erase (ap_server->p_lstnrs, (uintptr_t) ap_lstnr->p_con->sockfd);
   assert (nlstnrs - 1 == srv_get_listeners_count (ap_server));
 
   /* NOTE: No need to call srv_destroy_listener as this has been called already
@@ -990,23 +982,6 @@ end:
   return rc;
 }
 
-static OMX_S32
-srv_remove_existing_listener (OMX_PTR ap_key, OMX_PTR ap_value, OMX_PTR ap_arg)
-{
-  httpr_server_t * p_server = ap_arg;
-  httpr_listener_t * p_lstnr = NULL;
-
-  assert (p_server);
-  assert (ap_key);
-  assert (ap_value);
-
-  p_lstnr = (httpr_listener_t *) ap_value;
-
-  srv_remove_listener (p_server, p_lstnr);
-
-  return 0;
-}
-
 inline static void
 srv_release_empty_buffer (httpr_server_t * ap_server,
                           httpr_listener_t * ap_lstnr,
@@ -1422,14 +1397,15 @@ srv_accept_connection (httpr_server_t * ap_server)
     {
       /* This is a simple solution to prevent more than one connection at
        * a time. One day this could be a multi-client renderer */
-      tiz_map_for_each (ap_server->p_lstnrs, srv_remove_existing_listener,
-                        ap_server);
+      while ((p_lstnr = srv_get_first_listener (ap_server)))
+        {
+          srv_remove_listener (ap_server, p_lstnr);
+        }
     }
 
   if ((p_ip = (char *) tiz_mem_alloc (ICE_RENDERER_MAX_ADDR_LEN)))
     {
       unsigned short port = 0;
-      OMX_U32 index = 0;
 
       connected_sockfd
         = srv_accept_socket (ap_server, p_ip, ICE_RENDERER_MAX_ADDR_LEN, &port);
@@ -1444,8 +1420,8 @@ srv_accept_connection (httpr_server_t * ap_server)
       assert (p_lstnr->p_con);
       p_con = p_lstnr->p_con;
 
-      rc = tiz_map_insert (ap_server->p_lstnrs, &(p_con->sockfd), p_lstnr,
-                           &index);
+      rc = tiz_hmap_insert (ap_server->p_lstnrs, (uintptr_t) p_con->sockfd,
+                            p_lstnr);
       goto_end_on_omx_error (rc, p_hdl,
                              "Unable to add the listener to the map");
 
@@ -1642,8 +1618,7 @@ httpr_srv_destroy (httpr_server_t * ap_server)
       tiz_mem_free (ap_server->p_ip);
       if (ap_server->p_lstnrs)
         {
-          tiz_map_clear (ap_server->p_lstnrs);
-          tiz_map_destroy (ap_server->p_lstnrs);
+          tiz_hmap_destroy (ap_server->p_lstnrs);
         }
       tiz_mem_free (ap_server);
     }
@@ -1704,8 +1679,7 @@ httpr_srv_init (httpr_server_t ** app_server, void * ap_parent,
   goto_end_on_omx_error (rc, handleOf (ap_parent),
                          "Unable to duo the server ip address");
 
-  rc = tiz_map_init (&(p_server->p_lstnrs), listeners_map_compare_func,
-                     listeners_map_free_func, NULL);
+  rc = tiz_hmap_init (&(p_server->p_lstnrs), 0, listeners_map_free_func);
   goto_end_on_omx_error (rc, handleOf (ap_parent),
                          "Unable to init the listeners map");
 
@@ -52,7 +52,7 @@ static void *
 gmusic_cfgport_ctor (void * ap_obj, va_list * app)
 {
   gmusic_cfgport_t * p_obj
-    = super_ctor (typeOf (ap_obj, "gmusiccfgport"), ap_obj, app);
+    = super_ctor (TIZ_TYPE_OF (ap_obj, "gmusiccfgport"), ap_obj, app);
 
   assert (p_obj);
 
@@ -87,7 +87,7 @@ gmusic_cfgport_ctor (void * ap_obj, va_list * app)
 static void *
 gmusic_cfgport_dtor (void * ap_obj)
 {
-  return super_dtor (typeOf (ap_obj, "gmusiccfgport"), ap_obj);
+  return super_dtor (TIZ_TYPE_OF (ap_obj, "gmusiccfgport"), ap_obj);
 }
 
 /*
@@ -119,8 +119,8 @@ gmusic_cfgport_GetParameter (const void * ap_obj, OMX_HANDLETYPE ap_hdl,
   else
     {
       /* Delegate to the base port */
-      rc = super_GetParameter (typeOf (ap_obj, "gmusiccfgport"), ap_obj, ap_hdl,
-                               a_index, ap_struct);
+      rc = super_GetParameter (TIZ_TYPE_OF (ap_obj, "gmusiccfgport"), ap_obj,
+                               ap_hdl, a_index, ap_struct);
     }
 
   return rc;
@@ -161,8 +161,8 @@ gmusic_cfgport_SetParameter (const void * ap_obj, OMX_HANDLETYPE ap_hdl,
   else
     {
       /* Delegate to the base port */
-      rc = super_SetParameter (typeOf (ap_obj, "gmusiccfgport"), ap_obj, ap_hdl,
-                               a_index, ap_struct);
+      rc = super_SetParameter (TIZ_TYPE_OF (ap_obj, "gmusiccfgport"), ap_obj,
+                               ap_hdl, a_index, ap_struct);
     }
 
   return rc;
@@ -176,7 +176,7 @@ static void *
 gmusic_cfgport_class_ctor (void * ap_obj, va_list * app)
 {
   /* NOTE: Class methods might be added in the future. None for now. */
-  return super_ctor (typeOf (ap_obj, "gmusiccfgport_class"), ap_obj, app);
+  return super_ctor (TIZ_TYPE_OF (ap_obj, "gmusiccfgport_class"), ap_obj, app);
 }
 
 /*
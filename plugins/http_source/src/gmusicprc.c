@@ -720,7 +720,8 @@ enqueue_playlist_items (gmusic_prc_t * ap_prc)
 static void *
 gmusic_prc_ctor (void * ap_obj, va_list * app)
 {
-  gmusic_prc_t * p_prc = super_ctor (typeOf (ap_obj, "gmusicprc"), ap_obj, app);
+  gmusic_prc_t * p_prc
+    = super_ctor (TIZ_TYPE_OF (ap_obj, "gmusicprc"), ap_obj, app);
   p_prc->p_outhdr_ = NULL;
   p_prc->p_uri_param_ = NULL;
   p_prc->p_trans_ = NULL;
@@ -745,7 +746,7 @@ static void *
 gmusic_prc_dtor (void * ap_obj)
 {
   (void) gmusic_prc_deallocate_resources (ap_obj);
-  return super_dtor (typeOf (ap_obj, "gmusicprc"), ap_obj);
+  return super_dtor (TIZ_TYPE_OF (ap_obj, "gmusicprc"), ap_obj);
 }
 
 /*
@@ -1050,7 +1051,7 @@ static void *
 gmusic_prc_class_ctor (void * ap_obj, va_list * app)
 {
   /* NOTE: Class methods might be added in the future. None for now. */
-  return super_ctor (typeOf (ap_obj, "gmusicprc_class"), ap_obj, app);
+  return super_ctor (TIZ_TYPE_OF (ap_obj, "gmusicprc_class"), ap_obj, app);
 }
 
 /*
@@ -53,7 +53,7 @@ static void *
 httpsrc_port_ctor (void * ap_obj, va_list * app)
 {
   httpsrc_port_t * p_obj
-    = super_ctor (typeOf (ap_obj, "httpsrcport"), ap_obj, app);
+    = super_ctor (TIZ_TYPE_OF (ap_obj, "httpsrcport"), ap_obj, app);
   assert (p_obj);
 
   tiz_check_omx_ret_null (
@@ -122,7 +122,7 @@ httpsrc_port_dtor (void * ap_obj)
 {
   httpsrc_port_t * p_obj = ap_obj;
   assert (p_obj);
-  return super_dtor (typeOf (ap_obj, "httpsrcport"), ap_obj);
+  return super_dtor (TIZ_TYPE_OF (ap_obj, "httpsrcport"), ap_obj);
 }
 
 /*
@@ -177,8 +177,8 @@ httpsrc_port_GetParameter (const void * ap_obj, OMX_HANDLETYPE ap_hdl,
           else
             {
               /* Try the parent's indexes */
-              rc = super_GetParameter (typeOf (ap_obj, "httpsrcport"), ap_obj,
-                                       ap_hdl, a_index, ap_struct);
+              rc = super_GetParameter (TIZ_TYPE_OF (ap_obj, "httpsrcport"),
+                                       ap_obj, ap_hdl, a_index, ap_struct);
             }
         }
         break;
@@ -349,8 +349,8 @@ httpsrc_port_SetParameter (const void * ap_obj, OMX_HANDLETYPE ap_hdl,
           else
             {
               /* Try the parent's indexes */
-              rc = super_SetParameter (typeOf (ap_obj, "httpsrcport"), ap_obj,
-                                       ap_hdl, a_index, ap_struct);
+              rc = super_SetParameter (TIZ_TYPE_OF (ap_obj, "httpsrcport"),
+                                       ap_obj, ap_hdl, a_index, ap_struct);
             }
         }
     };
@@ -609,7 +609,7 @@ static void *
 httpsrc_port_class_ctor (void * ap_obj, va_list * app)
 {
   /* NOTE: Class methods might be added in the future. None for now. */
-  return super_ctor (typeOf (ap_obj, "httpsrcport_class"), ap_obj, app);
+  return super_ctor (TIZ_TYPE_OF (ap_obj, "httpsrcport_class"), ap_obj, app);
 }
 
 /*
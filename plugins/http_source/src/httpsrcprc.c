@@ -740,7 +740,7 @@ static void *
 httpsrc_prc_ctor (void * ap_obj, va_list * app)
 {
   httpsrc_prc_t * p_prc
-    = super_ctor (typeOf (ap_obj, "httpsrcprc"), ap_obj, app);
+    = super_ctor (TIZ_TYPE_OF (ap_obj, "httpsrcprc"), ap_obj, app);
   p_prc->p_outhdr_ = NULL;
   p_prc->p_uri_param_ = NULL;
   p_prc->p_trans_ = NULL;
@@ -761,7 +761,7 @@ static void *
 httpsrc_prc_dtor (void * ap_obj)
 {
   (void) httpsrc_prc_deallocate_resources (ap_obj);
-  return super_dtor (typeOf (ap_obj, "httpsrcprc"), ap_obj);
+  return super_dtor (TIZ_TYPE_OF (ap_obj, "httpsrcprc"), ap_obj);
 }
 
 /*
@@ -941,7 +941,7 @@ static void *
 httpsrc_prc_class_ctor (void * ap_obj, va_list * app)
 {
   /* NOTE: Class methods might be added in the future. None for now. */
-  return super_ctor (typeOf (ap_obj, "httpsrcprc_class"), ap_obj, app);
+  return super_ctor (TIZ_TYPE_OF (ap_obj, "httpsrcprc_class"), ap_obj, app);
 }
 
 /*
@@ -698,7 +698,8 @@ enqueue_playlist_items (iheart_prc_t * ap_prc)
 static void *
 iheart_prc_ctor (void * ap_obj, va_list * app)
 {
-  iheart_prc_t * p_prc = super_ctor (typeOf (ap_obj, "iheartprc"), ap_obj, app);
+  iheart_prc_t * p_prc
+    = super_ctor (TIZ_TYPE_OF (ap_obj, "iheartprc"), ap_obj, app);
   p_prc->p_outhdr_ = NULL;
   TIZ_INIT_OMX_STRUCT (p_prc->session_);
   TIZ_INIT_OMX_STRUCT (p_prc->playlist_);
@@ -727,7 +728,7 @@ static void *
 iheart_prc_dtor (void * ap_obj)
 {
   (void) iheart_prc_deallocate_resources (ap_obj);
-  return super_dtor (typeOf (ap_obj, "iheartprc"), ap_obj);
+  return super_dtor (TIZ_TYPE_OF (ap_obj, "iheartprc"), ap_obj);
 }
 
 /*
@@ -1016,7 +1017,7 @@ static void *
 iheart_prc_class_ctor (void * ap_obj, va_list * app)
 {
   /* NOTE: Class methods might be added in the future. None for now. */
-  return super_ctor (typeOf (ap_obj, "iheartprc_class"), ap_obj, app);
+  return super_ctor (TIZ_TYPE_OF (ap_obj, "iheartprc_class"), ap_obj, app);
 }
 
 /*
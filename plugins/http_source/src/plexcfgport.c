@@ -52,7 +52,7 @@ static void *
 plex_cfgport_ctor (void * ap_obj, va_list * app)
 {
   plex_cfgport_t * p_obj
-    = super_ctor (typeOf (ap_obj, "plexcfgport"), ap_obj, app);
+    = super_ctor (TIZ_TYPE_OF (ap_obj, "plexcfgport"), ap_obj, app);
 
   assert (p_obj);
 
@@ -83,7 +83,7 @@ plex_cfgport_ctor (void * ap_obj, va_list * app)
 static void *
 plex_cfgport_dtor (void * ap_obj)
 {
-  return super_dtor (typeOf (ap_obj, "plexcfgport"), ap_obj);
+  return super_dtor (TIZ_TYPE_OF (ap_obj, "plexcfgport"), ap_obj);
 }
 
 /*
@@ -115,8 +115,8 @@ plex_cfgport_GetParameter (const void * ap_obj, OMX_HANDLETYPE ap_hdl,
   else
     {
       /* Delegate to the base port */
-      rc = super_GetParameter (typeOf (ap_obj, "plexcfgport"), ap_obj, ap_hdl,
-                               a_index, ap_struct);
+      rc = super_GetParameter (TIZ_TYPE_OF (ap_obj, "plexcfgport"), ap_obj,
+                               ap_hdl, a_index, ap_struct);
     }
 
   return rc;
@@ -155,8 +155,8 @@ plex_cfgport_SetParameter (const void * ap_obj, OMX_HANDLETYPE ap_hdl,
   else
     {
       /* Delegate to the base port */
-      rc = super_SetParameter (typeOf (ap_obj, "plexcfgport"), ap_obj, ap_hdl,
-                               a_index, ap_struct);
+      rc = super_SetParameter (TIZ_TYPE_OF (ap_obj, "plexcfgport"), ap_obj,
+                               ap_hdl, a_index, ap_struct);
     }
 
   return rc;
@@ -170,7 +170,7 @@ static void *
 plex_cfgport_class_ctor (void * ap_obj, va_list * app)
 {
   /* NOTE: Class methods might be added in the future. None for now. */
-  return super_ctor (typeOf (ap_obj, "plexcfgport_class"), ap_obj, app);
+  return super_ctor (TIZ_TYPE_OF (ap_obj, "plexcfgport_class"), ap_obj, app);
 }
 
 /*
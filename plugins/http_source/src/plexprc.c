@@ -736,7 +736,8 @@ enqueue_playlist_items (plex_prc_t * ap_prc)
 static void *
 plex_prc_ctor (void * ap_obj, va_list * app)
 {
-  plex_prc_t * p_prc = super_ctor (typeOf (ap_obj, "plexprc"), ap_obj, app);
+  plex_prc_t * p_prc
+    = super_ctor (TIZ_TYPE_OF (ap_obj, "plexprc"), ap_obj, app);
   p_prc->p_outhdr_ = NULL;
   TIZ_INIT_OMX_STRUCT (p_prc->session_);
   TIZ_INIT_OMX_STRUCT (p_prc->playlist_);
@@ -766,7 +767,7 @@ static void *
 plex_prc_dtor (void * ap_obj)
 {
   (void) plex_prc_deallocate_resources (ap_obj);
-  return super_dtor (typeOf (ap_obj, "plexprc"), ap_obj);
+  return super_dtor (TIZ_TYPE_OF (ap_obj, "plexprc"), ap_obj);
 }
 
 /*
@@ -1053,7 +1054,7 @@ static void *
 plex_prc_class_ctor (void * ap_obj, va_list * app)
 {
   /* NOTE: Class methods might be added in the future. None for now. */
-  return super_ctor (typeOf (ap_obj, "plexprc_class"), ap_obj, app);
+  return super_ctor (TIZ_TYPE_OF (ap_obj, "plexprc_class"), ap_obj, app);
 }
 
 /*
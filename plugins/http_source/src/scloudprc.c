@@ -676,7 +676,8 @@ enqueue_playlist_items (scloud_prc_t * ap_prc)
 static void *
 scloud_prc_ctor (void * ap_obj, va_list * app)
 {
-  scloud_prc_t * p_prc = super_ctor (typeOf (ap_obj, "scloudprc"), ap_obj, app);
+  scloud_prc_t * p_prc
+    = super_ctor (TIZ_TYPE_OF (ap_obj, "scloudprc"), ap_obj, app);
   p_prc->p_outhdr_ = NULL;
   TIZ_INIT_OMX_STRUCT (p_prc->session_);
   TIZ_INIT_OMX_STRUCT (p_prc->playlist_);
@@ -703,7 +704,7 @@ static void *
 scloud_prc_dtor (void * ap_obj)
 {
   (void) scloud_prc_deallocate_resources (ap_obj);
-  return super_dtor (typeOf (ap_obj, "scloudprc"), ap_obj);
+  return super_dtor (TIZ_TYPE_OF (ap_obj, "scloudprc"), ap_obj);
 }
 
 /*
@@ -979,7 +980,7 @@ static void *
 scloud_prc_class_ctor (void * ap_obj, va_list * app)
 {
   /* NOTE: Class methods might be added in the future. None for now. */
-  return super_ctor (typeOf (ap_obj, "scloudprc_class"), ap_obj, app);
+  return super_ctor (TIZ_TYPE_OF (ap_obj, "scloudprc_class"), ap_obj, app);
 }
 
 /*
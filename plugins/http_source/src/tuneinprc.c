@@ -733,7 +733,8 @@ enqueue_playlist_items (tunein_prc_t * ap_prc)
 static void *
 tunein_prc_ctor (void * ap_obj, va_list * app)
 {
-  tunein_prc_t * p_prc = super_ctor (typeOf (ap_obj, "tuneinprc"), ap_obj, app);
+  tunein_prc_t * p_prc
+    = super_ctor (TIZ_TYPE_OF (ap_obj, "tuneinprc"), ap_obj, app);
   p_prc->p_outhdr_ = NULL;
   TIZ_INIT_OMX_STRUCT (p_prc->session_);
   TIZ_INIT_OMX_STRUCT (p_prc->playlist_);
@@ -762,7 +763,7 @@ static void *
 tunein_prc_dtor (void * ap_obj)
 {
   (void) tunein_prc_deallocate_resources (ap_obj);
-  return super_dtor (typeOf (ap_obj, "tuneinprc"), ap_obj);
+  return super_dtor (TIZ_TYPE_OF (ap_obj, "tuneinprc"), ap_obj);
 }
 
 /*
@@ -1050,7 +1051,7 @@ static void *
 tunein_prc_class_ctor (void * ap_obj, va_list * app)
 {
   /* NOTE: Class methods might be added in the future. None for now. */
-  return super_ctor (typeOf (ap_obj, "tuneinprc_class"), ap_obj, app);
+  return super_ctor (TIZ_TYPE_OF (ap_obj, "tuneinprc_class"), ap_obj, app);
 }
 
 /*
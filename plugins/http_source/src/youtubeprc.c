@@ -768,7 +768,7 @@ static void *
 youtube_prc_ctor (void * ap_obj, va_list * app)
 {
   youtube_prc_t * p_prc
-    = super_ctor (typeOf (ap_obj, "youtubeprc"), ap_obj, app);
+    = super_ctor (TIZ_TYPE_OF (ap_obj, "youtubeprc"), ap_obj, app);
   p_prc->p_outhdr_ = NULL;
   TIZ_INIT_OMX_STRUCT (p_prc->session_);
   TIZ_INIT_OMX_STRUCT (p_prc->playlist_);
@@ -796,7 +796,7 @@ static void *
 youtube_prc_dtor (void * ap_obj)
 {
   (void) youtube_prc_deallocate_resources (ap_obj);
-  return super_dtor (typeOf (ap_obj, "youtubeprc"), ap_obj);
+  return super_dtor (TIZ_TYPE_OF (ap_obj, "youtubeprc"), ap_obj);
 }
 
 /*
@@ -1076,7 +1076,7 @@ static void *
 youtube_prc_class_ctor (void * ap_obj, va_list * app)
 {
   /* NOTE: Class methods might be added in the future. None for now. */
-  return super_ctor (typeOf (ap_obj, "youtubeprc_class"), ap_obj, app);
+  return super_ctor (TIZ_TYPE_OF (ap_obj, "youtubeprc_class"), ap_obj, app);
 }
 
 /*
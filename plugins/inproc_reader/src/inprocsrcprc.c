@@ -53,7 +53,8 @@
 static void *
 inprocsrc_prc_ctor (void *ap_obj, va_list * app)
 {
-  inprocsrc_prc_t *p_obj = super_ctor (typeOf (ap_obj, "inprocsrcprc"), ap_obj, app);
+  inprocsrc_prc_t *p_obj
+    = super_ctor (TIZ_TYPE_OF (ap_obj, "inprocsrcprc"), ap_obj, app);
   p_obj->eos_ = false;
   return p_obj;
 }
@@ -61,7 +62,7 @@ inprocsrc_prc_ctor (void *ap_obj, va_list * app)
 static void *
 inprocsrc_prc_dtor (void *ap_obj)
 {
-  return super_dtor (typeOf (ap_obj, "inprocsrcprc"), ap_obj);
+  return super_dtor (TIZ_TYPE_OF (ap_obj, "inprocsrcprc"), ap_obj);
 }
 
 static OMX_ERRORTYPE
@@ -122,7 +123,7 @@ static void *
 inprocsrc_prc_class_ctor (void *ap_obj, va_list * app)
 {
   /* NOTE: Class methods might be added in the future. None for now. */
-  return super_ctor (typeOf (ap_obj, "inprocsrcprc_class"), ap_obj, app);
+  return super_ctor (TIZ_TYPE_OF (ap_obj, "inprocsrcprc_class"), ap_obj, app);
 }
 
 /*
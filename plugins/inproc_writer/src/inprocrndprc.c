@@ -194,7 +194,7 @@ static OMX_ERRORTYPE write_buffer (inprocrnd_prc_t *ap_prc)
 static void *inprocrnd_prc_ctor (void *ap_prc, va_list *app)
 {
   inprocrnd_prc_t *p_prc
-      = super_ctor (typeOf (ap_prc, "inprocrndprc"), ap_prc, app);
+      = super_ctor (TIZ_TYPE_OF (ap_prc, "inprocrndprc"), ap_prc, app);
   p_prc->port_disabled_ = false;
   p_prc->paused_ = false;
   p_prc->stopped_ = true;
@@ -207,7 +207,7 @@ static void *inprocrnd_prc_ctor (void *ap_prc, va_list *app)
 
 static void *inprocrnd_prc_dtor (void *ap_prc)
 {
-  return super_dtor (typeOf (ap_prc, "inprocrndprc"), ap_prc);
+  return super_dtor (TIZ_TYPE_OF (ap_prc, "inprocrndprc"), ap_prc);
 }
 
 /*
@@ -333,7 +333,7 @@ static OMX_ERRORTYPE inprocrnd_prc_buffers_ready (const void *ap_prc)
 static void *inprocrnd_prc_class_ctor (void *ap_prc, va_list *app)
 {
   /* NOTE: Class methods might be added in the future. None for now. */
-  return super_ctor (typeOf (ap_prc, "inprocrndprc_class"), ap_prc, app);
+  return super_ctor (TIZ_TYPE_OF (ap_prc, "inprocrndprc_class"), ap_prc, app);
 }
 
 /*
@@ -705,7 +705,8 @@ claim_output_buffer (mp3d_prc_t * ap_prc)
 static void *
 mp3d_proc_ctor (void * ap_obj, va_list * app)
 {
-  mp3d_prc_t * p_obj = super_ctor (typeOf (ap_obj, "mp3dprc"), ap_obj, app);
+  mp3d_prc_t * p_obj
+    = super_ctor (TIZ_TYPE_OF (ap_obj, "mp3dprc"), ap_obj, app);
   p_obj->remaining_ = 0;
   p_obj->frame_count_ = 0;
   p_obj->p_inhdr_ = 0;
@@ -720,7 +721,7 @@ mp3d_proc_ctor (void * ap_obj, va_list * app)
 static void *
 mp3d_proc_dtor (void * ap_obj)
 {
-  return super_dtor (typeOf (ap_obj, "mp3dprc"), ap_obj);
+  return super_dtor (TIZ_TYPE_OF (ap_obj, "mp3dprc"), ap_obj);
 }
 
 /*
@@ -900,7 +901,7 @@ static void *
 mp3d_prc_class_ctor (void * ap_obj, va_list * app)
 {
   /* NOTE: Class methods might be added in the future. None for now. */
-  return super_ctor (typeOf (ap_obj, "mp3dprc_class"), ap_obj, app);
+  return super_ctor (TIZ_TYPE_OF (ap_obj, "mp3dprc_class"), ap_obj, app);
 }
 
 /*
@@ -359,7 +359,8 @@ set_lame_mp3_settings (void * ap_obj, OMX_HANDLETYPE ap_hdl, void * ap_krn)
 static void *
 mp3e_proc_ctor (void * ap_obj, va_list * app)
 {
-  mp3e_prc_t * p_prc = super_ctor (typeOf (ap_obj, "mp3eprc"), ap_obj, app);
+  mp3e_prc_t * p_prc
+    = super_ctor (TIZ_TYPE_OF (ap_obj, "mp3eprc"), ap_obj, app);
   assert (p_prc);
   p_prc->lame_ = NULL;
   p_prc->frame_size_ = 0;
@@ -382,7 +383,7 @@ mp3e_proc_dtor (void * ap_obj)
       p_prc->lame_ = NULL;
     }
 
-  return super_dtor (typeOf (ap_obj, "mp3eprc"), ap_obj);
+  return super_dtor (TIZ_TYPE_OF (ap_obj, "mp3eprc"), ap_obj);
 }
 
 /*
@@ -564,7 +565,7 @@ static void *
 mp3e_prc_class_ctor (void * ap_obj, va_list * app)
 {
   /* NOTE: Class methods might be added in the future. None for now. */
-  return super_ctor (typeOf (ap_obj, "mp3eprc_class"), ap_obj, app);
+  return super_ctor (TIZ_TYPE_OF (ap_obj, "mp3eprc_class"), ap_obj, app);
 }
 
 /*
@@ -222,7 +222,7 @@ static OMX_ERRORTYPE remove_metadata (mp3meta_prc_t *ap_prc)
 static void *mp3meta_prc_ctor (void *ap_obj, va_list *app)
 {
   mp3meta_prc_t *p_prc
-      = super_ctor (typeOf (ap_obj, "mp3metaprc"), ap_obj, app);
+      = super_ctor (TIZ_TYPE_OF (ap_obj, "mp3metaprc"), ap_obj, app);
   assert (p_prc);
   p_prc->p_mpg123_ = NULL;
   p_prc->p_out_hdr_ = NULL;
@@ -244,7 +244,7 @@ static void *mp3meta_prc_dtor (void *ap_obj)
 {
   (void)mp3meta_prc_deallocate_resources (ap_obj);
   mpg123_exit ();
-  return super_dtor (typeOf (ap_obj, "mp3metaprc"), ap_obj);
+  return super_dtor (TIZ_TYPE_OF (ap_obj, "mp3metaprc"), ap_obj);
 }
 
 /*
@@ -387,7 +387,7 @@ static OMX_ERRORTYPE mp3meta_prc_port_disable (const void *ap_prc,
 static void *mp3meta_prc_class_ctor (void *ap_obj, va_list *app)
 {
   /* NOTE: Class methods might be added in the future. None for now. */
-  return super_ctor (typeOf (ap_obj, "mp3metaprc_class"), ap_obj, app);
+  return super_ctor (TIZ_TYPE_OF (ap_obj, "mp3metaprc_class"), ap_obj, app);
 }
 
 /*
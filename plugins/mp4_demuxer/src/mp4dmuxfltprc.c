@@ -996,7 +996,7 @@ static void *
 mp4dmuxflt_prc_ctor (void * ap_prc, va_list * app)
 {
   mp4dmuxflt_prc_t * p_prc
-    = super_ctor (typeOf (ap_prc, "mp4dmuxfltprc"), ap_prc, app);
+    = super_ctor (TIZ_TYPE_OF (ap_prc, "mp4dmuxfltprc"), ap_prc, app);
   assert (p_prc);
   p_prc->tmp_fd_1_ = -1;
   p_prc->tmp_fd_2_ = -1;
@@ -1019,7 +1019,7 @@ mp4dmuxflt_prc_dtor (void * ap_obj)
 {
   (void) mp4dmuxflt_prc_deallocate_resources (ap_obj);
   gp_prc = NULL;
-  return super_dtor (typeOf (ap_obj, "mp4dmuxfltprc"), ap_obj);
+  return super_dtor (TIZ_TYPE_OF (ap_obj, "mp4dmuxfltprc"), ap_obj);
 }
 
 /*
@@ -1156,7 +1156,7 @@ static void *
 mp4dmuxflt_prc_class_ctor (void * ap_prc, va_list * app)
 {
   /* NOTE: Class methods might be added in the future. None for now. */
-  return super_ctor (typeOf (ap_prc, "mp4dmuxfltprc_class"), ap_prc, app);
+  return super_ctor (TIZ_TYPE_OF (ap_prc, "mp4dmuxfltprc_class"), ap_prc, app);
 }
 
 /*
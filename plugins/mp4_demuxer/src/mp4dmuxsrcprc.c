@@ -417,7 +417,7 @@ static void *
 mp4dmuxsrc_prc_ctor (void * ap_prc, va_list * app)
 {
   mp4dmuxsrc_prc_t * p_prc
-    = super_ctor (typeOf (ap_prc, "mp4dmuxsrcprc"), ap_prc, app);
+    = super_ctor (TIZ_TYPE_OF (ap_prc, "mp4dmuxsrcprc"), ap_prc, app);
   assert (p_prc);
   p_prc->p_outhdr_ = NULL;
   p_prc->p_uri_ = NULL;
@@ -436,7 +436,7 @@ static void *
 mp4dmuxsrc_prc_dtor (void * ap_obj)
 {
   (void) mp4dmuxsrc_prc_deallocate_resources (ap_obj);
-  return super_dtor (typeOf (ap_obj, "mp4dmuxsrcprc"), ap_obj);
+  return super_dtor (TIZ_TYPE_OF (ap_obj, "mp4dmuxsrcprc"), ap_obj);
 }
 
 /* static OMX_ERRORTYPE */
@@ -632,7 +632,7 @@ static void *
 mp4dmuxsrc_prc_class_ctor (void * ap_prc, va_list * app)
 {
   /* NOTE: Class methods might be added in the future. None for now. */
-  return super_ctor (typeOf (ap_prc, "mp4dmuxsrcprc_class"), ap_prc, app);
+  return super_ctor (TIZ_TYPE_OF (ap_prc, "mp4dmuxsrcprc_class"), ap_prc, app);
 }
 
 /*
@@ -417,7 +417,7 @@ static void reset_stream_parameters (mpg123d_prc_t *ap_prc)
 static void *mpg123d_prc_ctor (void *ap_obj, va_list *app)
 {
   mpg123d_prc_t *p_prc
-      = super_ctor (typeOf (ap_obj, "mpg123dprc"), ap_obj, app);
+      = super_ctor (TIZ_TYPE_OF (ap_obj, "mpg123dprc"), ap_obj, app);
   assert (p_prc);
   p_prc->p_mpg123_ = NULL;
   reset_stream_parameters (p_prc);
@@ -433,7 +433,7 @@ static void *mpg123d_prc_dtor (void *ap_obj)
 {
   (void)mpg123d_prc_deallocate_resources (ap_obj);
   mpg123_exit ();
-  return super_dtor (typeOf (ap_obj, "mpg123dprc"), ap_obj);
+  return super_dtor (TIZ_TYPE_OF (ap_obj, "mpg123dprc"), ap_obj);
 }
 
 /*
@@ -545,7 +545,7 @@ static OMX_ERRORTYPE mpg123d_prc_port_disable (const void *ap_prc,
 static void *mpg123d_prc_class_ctor (void *ap_obj, va_list *app)
 {
   /* NOTE: Class methods might be added in the future. None for now. */
-  return super_ctor (typeOf (ap_obj, "mpg123dprc_class"), ap_obj, app);
+  return super_ctor (TIZ_TYPE_OF (ap_obj, "mpg123dprc_class"), ap_obj, app);
 }
 
 /*
@@ -1078,7 +1078,7 @@ static void *
 oggdmux_prc_ctor (void * ap_obj, va_list * app)
 {
   oggdmux_prc_t * p_prc
-    = super_ctor (typeOf (ap_obj, "oggdmuxprc"), ap_obj, app);
+    = super_ctor (TIZ_TYPE_OF (ap_obj, "oggdmuxprc"), ap_obj, app);
   assert (p_prc);
   p_prc->p_file_ = NULL;
   p_prc->p_uri_ = NULL;
@@ -1109,7 +1109,7 @@ static void *
 oggdmux_prc_dtor (void * ap_obj)
 {
   (void) oggdmux_prc_deallocate_resources (ap_obj);
-  return super_dtor (typeOf (ap_obj, "oggdmuxprc"), ap_obj);
+  return super_dtor (TIZ_TYPE_OF (ap_obj, "oggdmuxprc"), ap_obj);
 }
 
 /*
@@ -1249,7 +1249,7 @@ static void *
 oggdmux_prc_class_ctor (void * ap_obj, va_list * app)
 {
   /* NOTE: Class methods might be added in the future. None for now. */
-  return super_ctor (typeOf (ap_obj, "oggdmuxprc_class"), ap_obj, app);
+  return super_ctor (TIZ_TYPE_OF (ap_obj, "oggdmuxprc_class"), ap_obj, app);
 }
 
 /*
@@ -549,7 +549,7 @@ static void *
 oggmuxflt_prc_ctor (void * ap_prc, va_list * app)
 {
   oggmuxflt_prc_t * p_prc
-    = super_ctor (typeOf (ap_prc, "oggmuxfltprc"), ap_prc, app);
+    = super_ctor (TIZ_TYPE_OF (ap_prc, "oggmuxfltprc"), ap_prc, app);
   assert (p_prc);
   p_prc->p_oggz_ = NULL;
   p_prc->oggz_audio_serialno_ = 0;
@@ -566,7 +566,7 @@ static void *
 oggmuxflt_prc_dtor (void * ap_obj)
 {
   (void) oggmuxflt_prc_deallocate_resources (ap_obj);
-  return super_dtor (typeOf (ap_obj, "oggmuxfltprc"), ap_obj);
+  return super_dtor (TIZ_TYPE_OF (ap_obj, "oggmuxfltprc"), ap_obj);
 }
 
 /*
@@ -681,7 +681,7 @@ static void *
 oggmuxflt_prc_class_ctor (void * ap_prc, va_list * app)
 {
   /* NOTE: Class methods might be added in the future. None for now. */
-  return super_ctor (typeOf (ap_prc, "oggmuxfltprc_class"), ap_prc, app);
+  return super_ctor (TIZ_TYPE_OF (ap_prc, "oggmuxfltprc_class"), ap_prc, app);
 }
 
 /*
@@ -381,7 +381,7 @@ static void *
 oggmuxsnk_prc_ctor (void * ap_prc, va_list * app)
 {
   oggmuxsnk_prc_t * p_prc
-    = super_ctor (typeOf (ap_prc, "oggmuxsnkprc"), ap_prc, app);
+    = super_ctor (TIZ_TYPE_OF (ap_prc, "oggmuxsnkprc"), ap_prc, app);
   assert (p_prc);
 
   p_prc->p_audio_store_ = NULL;
@@ -408,7 +408,7 @@ static void *
 oggmuxsnk_prc_dtor (void * ap_obj)
 {
   (void) oggmuxsnk_prc_deallocate_resources (ap_obj);
-  return super_dtor (typeOf (ap_obj, "oggmuxsnkprc"), ap_obj);
+  return super_dtor (TIZ_TYPE_OF (ap_obj, "oggmuxsnkprc"), ap_obj);
 }
 
 /*
@@ -579,7 +579,7 @@ static void *
 oggmuxsnk_prc_class_ctor (void * ap_prc, va_list * app)
 {
   /* NOTE: Class methods might be added in the future. None for now. */
-  return super_ctor (typeOf (ap_prc, "oggmuxsnkprc_class"), ap_prc, app);
+  return super_ctor (TIZ_TYPE_OF (ap_prc, "oggmuxsnkprc_class"), ap_prc, app);
 }
 
 /*
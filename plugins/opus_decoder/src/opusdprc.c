@@ -542,7 +542,8 @@ reset_stream_parameters (opusd_prc_t * ap_prc)
 static void *
 opusd_prc_ctor (void * ap_obj, va_list * app)
 {
-  opusd_prc_t * p_prc = super_ctor (typeOf (ap_obj, "opusdprc"), ap_obj, app);
+  opusd_prc_t * p_prc
+    = super_ctor (TIZ_TYPE_OF (ap_obj, "opusdprc"), ap_obj, app);
   assert (p_prc);
   p_prc->p_opus_dec_ = NULL;
   p_prc->p_in_hdr_ = NULL;
@@ -560,7 +561,7 @@ static void *
 opusd_prc_dtor (void * ap_obj)
 {
   (void) opusd_prc_deallocate_resources (ap_obj);
-  return super_dtor (typeOf (ap_obj, "opusdprc"), ap_obj);
+  return super_dtor (TIZ_TYPE_OF (ap_obj, "opusdprc"), ap_obj);
 }
 
 /*
@@ -708,7 +709,7 @@ static void *
 opusd_prc_class_ctor (void * ap_obj, va_list * app)
 {
   /* NOTE: Class methods might be added in the future. None for now. */
-  return super_ctor (typeOf (ap_obj, "opusdprc_class"), ap_obj, app);
+  return super_ctor (TIZ_TYPE_OF (ap_obj, "opusdprc_class"), ap_obj, app);
 }
 
 /*
@@ -91,7 +91,9 @@ allocate_temp_data_store (opusfiled_prc_t * ap_prc)
                           OMX_IndexParamPortDefinition, &port_def));
 
   assert (ap_prc->p_store_ == NULL);
-  return tiz_buffer_init (&(ap_prc->p_store_), port_def.nBufferSize);
+  tiz_check_omx (tiz_buffer_init (&(ap_prc->p_store_), port_def.nBufferSize));
+  (void) tiz_buffer_seek_mode (ap_prc->p_store_, TIZ_BUFFER_RING);
+  return OMX_ErrorNone;
 }
 
 static inline void
@@ -331,7 +333,7 @@ static void *
 opusfiled_prc_ctor (void * ap_obj, va_list * app)
 {
   opusfiled_prc_t * p_prc
-    = super_ctor (typeOf (ap_obj, "opusfiledprc"), ap_obj, app);
+    = super_ctor (TIZ_TYPE_OF (ap_obj, "opusfiledprc"), ap_obj, app);
   assert (p_prc);
   p_prc->p_opus_dec_ = NULL;
   p_prc->p_store_ = NULL;
@@ -343,7 +345,7 @@ static void *
 opusfiled_prc_dtor (void * ap_obj)
 {
   (void) opusfiled_prc_deallocate_resources (ap_obj);
-  return super_dtor (typeOf (ap_obj, "opusfiledprc"), ap_obj);
+  return super_dtor (TIZ_TYPE_OF (ap_obj, "opusfiledprc"), ap_obj);
 }
 
 /*
@@ -465,7 +467,7 @@ static void *
 opusfiled_prc_class_ctor (void * ap_obj, va_list * app)
 {
   /* NOTE: Class methods might be added in the future. None for now. */
-  return super_ctor (typeOf (ap_obj, "opusfiledprc_class"), ap_obj, app);
+  return super_ctor (TIZ_TYPE_OF (ap_obj, "opusfiledprc_class"), ap_obj, app);
 }
 
 /*
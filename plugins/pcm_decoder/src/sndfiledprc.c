@@ -120,7 +120,9 @@ allocate_temp_data_store (sndfiled_prc_t * ap_prc)
     tiz_api_GetParameter (tiz_get_krn (handleOf (ap_prc)), handleOf (ap_prc),
                           OMX_IndexParamPortDefinition, &port_def));
   assert (ap_prc->p_store_ == NULL);
-  return tiz_buffer_init (&(ap_prc->p_store_), port_def.nBufferSize);
+  tiz_check_omx (tiz_buffer_init (&(ap_prc->p_store_), port_def.nBufferSize));
+  (void) tiz_buffer_seek_mode (ap_prc->p_store_, TIZ_BUFFER_RING);
+  return OMX_ErrorNone;
 }
 
 static inline void
@@ -320,7 +322,7 @@ static void *
 sndfiled_prc_ctor (void * ap_obj, va_list * app)
 {
   sndfiled_prc_t * p_prc
-    = super_ctor (typeOf (ap_obj, "sndfiledprc"), ap_obj, app);
+    = super_ctor (TIZ_TYPE_OF (ap_obj, "sndfiledprc"), ap_obj, app);
   assert (p_prc);
   p_prc->p_sf_ = NULL;
   p_prc->sf_info_.format = 0;
@@ -337,7 +339,7 @@ static void *
 sndfiled_prc_dtor (void * ap_obj)
 {
   (void) sndfiled_prc_deallocate_resources (ap_obj);
-  return super_dtor (typeOf (ap_obj, "sndfiledprc"), ap_obj);
+  return super_dtor (TIZ_TYPE_OF (ap_obj, "sndfiledprc"), ap_obj);
 }
 
 /*
@@ -440,7 +442,7 @@ static void *
 sndfiled_prc_class_ctor (void * ap_obj, va_list * app)
 {
   /* NOTE: Class methods might be added in the future. None for now. */
-  return super_ctor (typeOf (ap_obj, "sndfiledprc_class"), ap_obj, app);
+  return super_ctor (TIZ_TYPE_OF (ap_obj, "sndfiledprc_class"), ap_obj, app);
 }
 
 /*
@@ -40,6 +40,7 @@
 
 #include <tizutils.h>
 #include <tizkernel.h>
+#include <tizprobe.h>
 
 #include "ar.h"
 #include "arprc.h"
@@ -867,6 +868,8 @@ render_buffer (ar_prc_t * ap_prc, OMX_BUFFERHEADERTYPE * ap_hdr)
   assert (ap_hdr->nFilledLen > 0);
   samples_per_channel = ap_hdr->nFilledLen / step;
 
+  TIZ_PROBE3 (render__start, handleOf (ap_prc), ap_hdr, ap_hdr->nFilledLen);
+
   adjust_gain (ap_prc, ap_hdr, samples_per_channel);
   swap_byte_order (ap_prc, ap_hdr);
 
@@ -905,6 +908,8 @@ render_buffer (ar_prc_t * ap_prc, OMX_BUFFERHEADERTYPE * ap_hdr)
         }
     }
 
+  TIZ_PROBE3 (render__done, handleOf (ap_prc), ap_hdr, rc);
+
   return rc;
 }
 
@@ -999,7 +1004,7 @@ render_pcm_data (ar_prc_t * ap_prc)
 static void *
 ar_prc_ctor (void * ap_prc, va_list * app)
 {
-  ar_prc_t * p_prc = super_ctor (typeOf (ap_prc, "arprc"), ap_prc, app);
+  ar_prc_t * p_prc = super_ctor (TIZ_TYPE_OF (ap_prc, "arprc"), ap_prc, app);
   p_prc->p_pcm_ = NULL;
   p_prc->p_hw_params_ = NULL;
   p_prc->p_pcm_name_ = NULL;
@@ -1029,7 +1034,7 @@ static void *
 ar_prc_dtor (void * ap_prc)
 {
   (void) ar_prc_deallocate_resources (ap_prc);
-  return super_dtor (typeOf (ap_prc, "arprc"), ap_prc);
+  return super_dtor (TIZ_TYPE_OF (ap_prc, "arprc"), ap_prc);
 }
 
 /*
@@ -1417,7 +1422,7 @@ static void *
 ar_prc_class_ctor (void * ap_prc, va_list * app)
 {
   /* NOTE: Class methods might be added in the future. None for now. */
-  return super_ctor (typeOf (ap_prc, "arprc_class"), ap_prc, app);
+  return super_ctor (TIZ_TYPE_OF (ap_prc, "arprc_class"), ap_prc, app);
 }
 
 /*
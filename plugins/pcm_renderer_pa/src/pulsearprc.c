@@ -39,6 +39,7 @@
 
 #include <tizkernel.h>
 #include <tizscheduler.h>
+#include <tizprobe.h>
 
 #include "pulsear.h"
 #include "pulsearprc.h"
@@ -308,6 +309,8 @@ render_pcm_data (pulsear_prc_t * ap_prc)
           assert (ap_prc->p_pa_loop_);
           assert (ap_prc->p_pa_context_);
 
+          TIZ_PROBE3 (render__start, handleOf (ap_prc), p_hdr,
+                      bytes_to_write);
           pa_threaded_mainloop_lock (ap_prc->p_pa_loop_);
           int result = pa_stream_write (
             ap_prc->p_pa_stream_, p_hdr->pBuffer + p_hdr->nOffset,
@@ -315,6 +318,8 @@ render_pcm_data (pulsear_prc_t * ap_prc)
           /* TODO : Check return code */
           (void) result;
           pa_threaded_mainloop_unlock (ap_prc->p_pa_loop_);
+          TIZ_PROBE3 (render__done, handleOf (ap_prc), p_hdr,
+                      0 == result ? OMX_ErrorNone : OMX_ErrorUndefined);
           p_hdr->nFilledLen -= bytes_to_write;
           p_hdr->nOffset += bytes_to_write;
           ap_prc->pa_nbytes_ -= bytes_to_write;
@@ -1033,7 +1038,7 @@ static void *
 pulsear_prc_ctor (void * ap_prc, va_list * app)
 {
   pulsear_prc_t * p_prc
-    = super_ctor (typeOf (ap_prc, "pulsearprc"), ap_prc, app);
+    = super_ctor (TIZ_TYPE_OF (ap_prc, "pulsearprc"), ap_prc, app);
   p_prc->p_inhdr_ = NULL;
   p_prc->port_disabled_ = false;
   p_prc->paused_ = false;
@@ -1059,7 +1064,7 @@ static void *
 pulsear_prc_dtor (void * ap_prc)
 {
   (void) pulsear_prc_deallocate_resources (ap_prc);
-  return super_dtor (typeOf (ap_prc, "pulsearprc"), ap_prc);
+  return super_dtor (TIZ_TYPE_OF (ap_prc, "pulsearprc"), ap_prc);
 }
 
 /*
@@ -1335,7 +1340,7 @@ static void *
 pulsear_prc_class_ctor (void * ap_obj, va_list * app)
 {
   /* NOTE: Class methods might be added in the future. None for now. */
-  return super_ctor (typeOf (ap_obj, "pulsearprc_class"), ap_obj, app);
+  return super_ctor (TIZ_TYPE_OF (ap_obj, "pulsearprc_class"), ap_obj, app);
 }
 
 /*
@@ -53,7 +53,7 @@ static void *
 spfysrc_cfgport_ctor (void * ap_obj, va_list * app)
 {
   spfysrc_cfgport_t * p_obj
-    = super_ctor (typeOf (ap_obj, "spfysrccfgport"), ap_obj, app);
+    = super_ctor (TIZ_TYPE_OF (ap_obj, "spfysrccfgport"), ap_obj, app);
 
   assert (p_obj);
 
@@ -93,7 +93,7 @@ spfysrc_cfgport_ctor (void * ap_obj, va_list * app)
 static void *
 spfysrc_cfgport_dtor (void * ap_obj)
 {
-  return super_dtor (typeOf (ap_obj, "spfysrccfgport"), ap_obj);
+  return super_dtor (TIZ_TYPE_OF (ap_obj, "spfysrccfgport"), ap_obj);
 }
 
 /*
@@ -125,7 +125,7 @@ spfysrc_cfgport_GetParameter (const void * ap_obj, OMX_HANDLETYPE ap_hdl,
   else
     {
       /* Delegate to the base port */
-      rc = super_GetParameter (typeOf (ap_obj, "spfysrccfgport"), ap_obj,
+      rc = super_GetParameter (TIZ_TYPE_OF (ap_obj, "spfysrccfgport"), ap_obj,
                                ap_hdl, a_index, ap_struct);
     }
 
@@ -167,7 +167,7 @@ spfysrc_cfgport_SetParameter (const void * ap_obj, OMX_HANDLETYPE ap_hdl,
   else
     {
       /* Delegate to the base port */
-      rc = super_SetParameter (typeOf (ap_obj, "spfysrccfgport"), ap_obj,
+      rc = super_SetParameter (TIZ_TYPE_OF (ap_obj, "spfysrccfgport"), ap_obj,
                                ap_hdl, a_index, ap_struct);
     }
 
@@ -182,7 +182,7 @@ static void *
 spfysrc_cfgport_class_ctor (void * ap_obj, va_list * app)
 {
   /* NOTE: Class methods might be added in the future. None for now. */
-  return super_ctor (typeOf (ap_obj, "spfysrccfgport_class"), ap_obj, app);
+  return super_ctor (TIZ_TYPE_OF (ap_obj, "spfysrccfgport_class"), ap_obj, app);
 }
 
 /*
@@ -101,7 +101,7 @@ static void reset_stream_parameters (fr_prc_t *ap_prc)
 static void *
 fr_prc_ctor (void *ap_obj, va_list * app)
 {
-  fr_prc_t *p_prc = super_ctor (typeOf (ap_obj, "frprc"), ap_obj, app);
+  fr_prc_t *p_prc = super_ctor (TIZ_TYPE_OF (ap_obj, "frprc"), ap_obj, app);
   assert (p_prc);
   return p_prc;
 }
@@ -110,7 +110,7 @@ static void *
 fr_prc_dtor (void *ap_obj)
 {
   (void) fr_prc_deallocate_resources (ap_obj);
-  return super_dtor (typeOf (ap_obj, "frprc"), ap_obj);
+  return super_dtor (TIZ_TYPE_OF (ap_obj, "frprc"), ap_obj);
 }
 
 /*
@@ -197,7 +197,7 @@ static void *
 fr_prc_class_ctor (void *ap_obj, va_list * app)
 {
   /* NOTE: Class methods might be added in the future. None for now. */
-  return super_ctor (typeOf (ap_obj, "frprc_class"), ap_obj, app);
+  return super_ctor (TIZ_TYPE_OF (ap_obj, "frprc_class"), ap_obj, app);
 }
 
 /*
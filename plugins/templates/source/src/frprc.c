@@ -53,7 +53,7 @@
 static void *
 fr_prc_ctor (void *ap_obj, va_list * app)
 {
-  fr_prc_t *p_obj = super_ctor (typeOf (ap_obj, "frprc"), ap_obj, app);
+  fr_prc_t *p_obj = super_ctor (TIZ_TYPE_OF (ap_obj, "frprc"), ap_obj, app);
   p_obj->eos_ = false;
   return p_obj;
 }
@@ -61,7 +61,7 @@ fr_prc_ctor (void *ap_obj, va_list * app)
 static void *
 fr_prc_dtor (void *ap_obj)
 {
-  return super_dtor (typeOf (ap_obj, "frprc"), ap_obj);
+  return super_dtor (TIZ_TYPE_OF (ap_obj, "frprc"), ap_obj);
 }
 
 static OMX_ERRORTYPE
@@ -122,7 +122,7 @@ static void *
 fr_prc_class_ctor (void *ap_obj, va_list * app)
 {
   /* NOTE: Class methods might be added in the future. None for now. */
-  return super_ctor (typeOf (ap_obj, "frprc_class"), ap_obj, app);
+  return super_ctor (TIZ_TYPE_OF (ap_obj, "frprc_class"), ap_obj, app);
 }
 
 /*
@@ -577,7 +577,7 @@ static void *
 vorbisd_prc_ctor (void * ap_obj, va_list * app)
 {
   vorbisd_prc_t * p_prc
-    = super_ctor (typeOf (ap_obj, "vorbisdprc"), ap_obj, app);
+    = super_ctor (TIZ_TYPE_OF (ap_obj, "vorbisdprc"), ap_obj, app);
   assert (p_prc);
   p_prc->p_fsnd_ = NULL;
   p_prc->started_ = false;
@@ -591,7 +591,7 @@ static void *
 vorbisd_prc_dtor (void * ap_obj)
 {
   (void) vorbisd_prc_deallocate_resources (ap_obj);
-  return super_dtor (typeOf (ap_obj, "vorbisdprc"), ap_obj);
+  return super_dtor (TIZ_TYPE_OF (ap_obj, "vorbisdprc"), ap_obj);
 }
 
 /*
@@ -724,7 +724,7 @@ static void *
 vorbisd_prc_class_ctor (void * ap_obj, va_list * app)
 {
   /* NOTE: Class methods might be added in the future. None for now. */
-  return super_ctor (typeOf (ap_obj, "vorbisdprc_class"), ap_obj, app);
+  return super_ctor (TIZ_TYPE_OF (ap_obj, "vorbisdprc_class"), ap_obj, app);
 }
 
 /*
@@ -35,12 +35,12 @@
 
 static void * vp8d_inport_ctor (void * ap_obj, va_list * app)
 {
-   return super_ctor (typeOf (ap_obj, "vp8dinport"), ap_obj, app);
+   return super_ctor (TIZ_TYPE_OF (ap_obj, "vp8dinport"), ap_obj, app);
 }
 
 static void * vp8d_inport_dtor (void * ap_obj)
 {
-   return super_dtor (typeOf (ap_obj, "vp8dinport"), ap_obj);
+   return super_dtor (TIZ_TYPE_OF (ap_obj, "vp8dinport"), ap_obj);
 }
 
 /*
@@ -75,7 +75,7 @@ vp8d_inport_SetParameter (const void * ap_obj, OMX_HANDLETYPE ap_hdl,
     if (i_def->format.video.nSliceHeight == 0)
       i_def->format.video.nSliceHeight = i_def->format.video.nFrameHeight;
 
-    err = super_SetParameter (typeOf (ap_obj, "vp8dinport"), ap_obj,
+    err = super_SetParameter (TIZ_TYPE_OF (ap_obj, "vp8dinport"), ap_obj,
                               ap_hdl, a_index, ap_struct);
     if (err == OMX_ErrorNone) {
       tiz_port_t * p_obj = (tiz_port_t *) ap_obj;
@@ -102,7 +102,7 @@ static void *
 vp8d_inport_class_ctor (void * ap_obj, va_list * app)
 {
    /* NOTE: Class methods might be added in the future. None for now. */
-   return super_ctor (typeOf (ap_obj, "vp8dinport_class"), ap_obj, app);
+   return super_ctor (TIZ_TYPE_OF (ap_obj, "vp8dinport_class"), ap_obj, app);
 }
 
 /*
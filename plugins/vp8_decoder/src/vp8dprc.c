@@ -889,7 +889,8 @@ release_all_headers (vp8d_prc_t * ap_prc)
 static void *
 vp8d_prc_ctor (void * ap_obj, va_list * app)
 {
-  vp8d_prc_t * p_prc = super_ctor (typeOf (ap_obj, "vp8dprc"), ap_obj, app);
+  vp8d_prc_t * p_prc
+    = super_ctor (TIZ_TYPE_OF (ap_obj, "vp8dprc"), ap_obj, app);
   assert (p_prc);
   p_prc->in_port_disabled_ = false;
   p_prc->out_port_disabled_ = false;
@@ -902,7 +903,7 @@ vp8d_prc_dtor (void * ap_obj)
 {
   vp8d_prc_t * p_obj = ap_obj;
   free_codec_buffer (p_obj);
-  return super_dtor (typeOf (ap_obj, "vp8dprc"), ap_obj);
+  return super_dtor (TIZ_TYPE_OF (ap_obj, "vp8dprc"), ap_obj);
 }
 
 /*
@@ -1052,7 +1053,7 @@ static void *
 vp8d_prc_class_ctor (void * ap_obj, va_list * app)
 {
   /* NOTE: Class methods might be added in the future. None for now. */
-  return super_ctor (typeOf (ap_obj, "vp8dprc_class"), ap_obj, app);
+  return super_ctor (TIZ_TYPE_OF (ap_obj, "vp8dprc_class"), ap_obj, app);
 }
 
 /*
@@ -1125,7 +1125,7 @@ static void *
 webmdmuxflt_prc_ctor (void * ap_prc, va_list * app)
 {
   webmdmuxflt_prc_t * p_prc
-    = super_ctor (typeOf (ap_prc, "webmdmuxfltprc"), ap_prc, app);
+    = super_ctor (TIZ_TYPE_OF (ap_prc, "webmdmuxfltprc"), ap_prc, app);
   assert (p_prc);
   p_prc->p_webm_store_ = NULL;
   p_prc->p_aud_store_ = NULL;
@@ -1142,7 +1142,7 @@ webmdmuxflt_prc_dtor (void * ap_obj)
 {
   (void) webmdmuxflt_prc_deallocate_resources (ap_obj);
   g_handle = NULL;
-  return super_dtor (typeOf (ap_obj, "webmdmuxfltprc"), ap_obj);
+  return super_dtor (TIZ_TYPE_OF (ap_obj, "webmdmuxfltprc"), ap_obj);
 }
 
 /*
@@ -1298,7 +1298,7 @@ static void *
 webmdmuxflt_prc_class_ctor (void * ap_prc, va_list * app)
 {
   /* NOTE: Class methods might be added in the future. None for now. */
-  return super_ctor (typeOf (ap_prc, "webmdmuxfltprc_class"), ap_prc, app);
+  return super_ctor (TIZ_TYPE_OF (ap_prc, "webmdmuxfltprc_class"), ap_prc, app);
 }
 
 /*
@@ -468,7 +468,7 @@ static void *
 webmdmuxsrc_prc_ctor (void * ap_prc, va_list * app)
 {
   webmdmuxsrc_prc_t * p_prc
-    = super_ctor (typeOf (ap_prc, "webmdmuxsrcprc"), ap_prc, app);
+    = super_ctor (TIZ_TYPE_OF (ap_prc, "webmdmuxsrcprc"), ap_prc, app);
   assert (p_prc);
   p_prc->p_outhdr_ = NULL;
   p_prc->p_uri_ = NULL;
@@ -492,7 +492,7 @@ static void *
 webmdmuxsrc_prc_dtor (void * ap_obj)
 {
   (void) webmdmuxsrc_prc_deallocate_resources (ap_obj);
-  return super_dtor (typeOf (ap_obj, "webmdmuxsrcprc"), ap_obj);
+  return super_dtor (TIZ_TYPE_OF (ap_obj, "webmdmuxsrcprc"), ap_obj);
 }
 
 /* static OMX_ERRORTYPE */
@@ -697,7 +697,7 @@ static void *
 webmdmuxsrc_prc_class_ctor (void * ap_prc, va_list * app)
 {
   /* NOTE: Class methods might be added in the future. None for now. */
-  return super_ctor (typeOf (ap_prc, "webmdmuxsrcprc_class"), ap_prc, app);
+  return super_ctor (TIZ_TYPE_OF (ap_prc, "webmdmuxsrcprc_class"), ap_prc, app);
 }
 
 /*
@@ -153,7 +153,8 @@ sdlivr_prc_render_buffer (const sdlivr_prc_t * ap_prc,
 static void *
 sdlivr_prc_ctor (void * ap_obj, va_list * app)
 {
-  sdlivr_prc_t * p_prc = super_ctor (typeOf (ap_obj, "sdlivrprc"), ap_obj, app);
+  sdlivr_prc_t * p_prc
+    = super_ctor (TIZ_TYPE_OF (ap_obj, "sdlivrprc"), ap_obj, app);
   assert (p_prc);
   tiz_mem_set (&(p_prc->port_def_), 0, sizeof (OMX_VIDEO_PORTDEFINITIONTYPE));
   p_prc->p_surface = NULL;
@@ -166,7 +167,7 @@ static void *
 sdlivr_prc_dtor (void * ap_obj)
 {
   (void) sdlivr_prc_deallocate_resources (ap_obj);
-  return super_dtor (typeOf (ap_obj, "sdlivrprc"), ap_obj);
+  return super_dtor (TIZ_TYPE_OF (ap_obj, "sdlivrprc"), ap_obj);
 }
 
 /*
@@ -350,7 +351,7 @@ static void *
 sdlivr_prc_class_ctor (void * ap_obj, va_list * app)
 {
   /* NOTE: Class methods might be added in the future. None for now. */
-  return super_ctor (typeOf (ap_obj, "sdlivrprc_class"), ap_obj, app);
+  return super_ctor (TIZ_TYPE_OF (ap_obj, "sdlivrprc_class"), ap_obj, app);
 }
 
 /*